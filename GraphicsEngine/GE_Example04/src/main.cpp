@@ -175,6 +175,10 @@ GLUSboolean initGame(GLUSvoid)
 	FrameBufferCubeMapSP framebufferCubeMap = DynamicEnvironmentManager::getInstance()->createCubeMap(entity, 1024);
 	surfaceMaterial->setDynamicCubeMapTexture(framebufferCubeMap->getCubeMapTexture());
 
+	DynamicEnvironmentManager::getInstance()->setFacesPerFrame(2);
+	DynamicEnvironmentManager::getInstance()->setScheduling(CUBE_MAP_PRIORITY_BY_DISTANCE);
+	DynamicEnvironmentManager::getInstance()->setSkipUnchangedFaces(true);
+
 	//
 	//
 	//
@@ -242,16 +246,28 @@ GLUSboolean updateGame(GLUSfloat deltaTime)
 	// Render the dynamic cube maps
 	//
 
+	// Only the faces, which changed, are rendered. At most two faces per frame.
+
+	GeneralEntityManager::getInstance()->scheduleDynamicEnvironments(CameraManager::getInstance()->getDefaultPerspectiveCamera()->getEye());
+
 	auto allElements = DynamicEnvironmentManager::getInstance()->getKeyValueMap();
 
 	auto walker = allElements.begin();
 
 	while (walker != allElements.end())
 	{
+		auto currentDynamicEnvironment = walker->second;
+
+		if (currentDynamicEnvironment->getScheduledFaces() == 0)
+		{
+			walker++;
+
+			continue;
+		}
+
 		auto currentEntity = walker->first;
 		entityExcludeList->addEntity(currentEntity);
 
-		auto currentDynamicEnvironment = walker->second;
 		currentDynamicEnvironment->use(currentEntity->getBoundingSphere().getCenter());
 
 		const Viewport& dynamicEnvironmentViewport = currentDynamicEnvironment->getCamera(0)->getViewport();
@@ -259,25 +275,21 @@ GLUSboolean updateGame(GLUSfloat deltaTime)
 
 		ProgramManagerProxy::setCameraByType(ProgramManager::RENDER_TO_CUBEMAP_PROGRAM_TYPE, currentDynamicEnvironment->getCamera(0), Point4(), Quaternion());
 
-		GeneralEntity::setCurrentValues(ProgramManager::RENDER_TO_CUBEMAP_PROGRAM_TYPE, currentDynamicEnvironment->getCamera(0), deltaTime, false);
-
-		GeneralEntityManager::getInstance()->sort();
-
 		//
 
 		glClearColor(0.0f, 0.0f, 0.0f, 0.0f);
-		glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+		currentDynamicEnvironment->clearScheduledFaces(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
 
 		//
 
 		GeneralEntity::setCurrentValues(ProgramManager::RENDER_TO_CUBEMAP_PROGRAM_TYPE, currentDynamicEnvironment->getCamera(0), deltaTime, false, RENDER_OPAQUE);
-		GeneralEntityManager::getInstance()->render(true);
+		GeneralEntityManager::getInstance()->render(currentDynamicEnvironment->getScheduledEntities());
 
 		GeneralEntity::setCurrentValues(ProgramManager::RENDER_TO_CUBEMAP_PROGRAM_TYPE, currentDynamicEnvironment->getCamera(0), deltaTime, true, RENDER_TRANSPARENT);
 		glFrontFace(GL_CW);
-		GeneralEntityManager::getInstance()->render(true);
+		GeneralEntityManager::getInstance()->render(currentDynamicEnvironment->getScheduledEntities());
 		glFrontFace(GL_CCW);
-		GeneralEntityManager::getInstance()->render(true);
+		GeneralEntityManager::getInstance()->render(currentDynamicEnvironment->getScheduledEntities());
 
 		//
 
@@ -130,13 +130,26 @@ GLUSboolean updateGame(GLUSfloat deltaTime)
 
 	// Camera
 
+	// The receiver and caster bounds tighten the cameras of the sections.
+	GeneralEntityManager::getInstance()->updateShadowBounds(currentCamera, orthographicCameraCascadedShadowMap2D);
+
 	for (int32_t i = 0; i < orthographicCameraCascadedShadowMap2D->getSections(); i++)
 	{
 		GeneralEntity::setCurrentValues(ProgramManager::RENDER_TO_SHADOWMAP_PROGRAM_TYPE, orthographicCameraCascadedShadowMap2D->getOrthographicCamera(i), deltaTime, false);
 
 		modelEntity->setOrthographicCameraCascadedShadowMap("Lamp", currentCamera, orthographicCameraCascadedShadowMap2D, i);
+	}
+
+	orthographicCameraCascadedShadowMap2D->updateShadowMatrices();
 
-		orthographicCameraCascadedShadowMap2D->updateShadowMatrices();
+	// Each section only gets the casters inside of its camera.
+	GeneralEntityManager::getInstance()->cullShadowCasters(orthographicCameraCascadedShadowMap2D);
+
+	for (int32_t i = 0; i < orthographicCameraCascadedShadowMap2D->getSections(); i++)
+	{
+		GeneralEntity::setCurrentValues(ProgramManager::RENDER_TO_SHADOWMAP_PROGRAM_TYPE, orthographicCameraCascadedShadowMap2D->getOrthographicCamera(i), deltaTime, false);
+
+		ProgramManagerProxy::setCameraByType(ProgramManager::RENDER_TO_SHADOWMAP_PROGRAM_TYPE, orthographicCameraCascadedShadowMap2D->getOrthographicCamera(i), Point4(), Quaternion(), false);
 
 		// Lights, not used, so set to zero lights.
 
@@ -146,10 +159,6 @@ GLUSboolean updateGame(GLUSfloat deltaTime)
 
 		//
 
-		GeneralEntityManager::getInstance()->sort();
-
-		//
-
 		orthographicCameraCascadedShadowMap2D->use(true, i);
 
 		glClear(GL_DEPTH_BUFFER_BIT);
@@ -159,7 +168,7 @@ GLUSboolean updateGame(GLUSfloat deltaTime)
 		glEnable(GL_POLYGON_OFFSET_FILL);
 		glFrontFace(GL_CW);
 
-		GeneralEntityManager::getInstance()->render();
+		GeneralEntityManager::getInstance()->renderShadowCasters(orthographicCameraCascadedShadowMap2D, i);
 
 		glDisable(GL_POLYGON_OFFSET_FILL);
 		glFrontFace(GL_CCW);
@@ -41,6 +41,28 @@ GLUSAPI GLUSboolean GLUSAPIENTRY glusImageCreateHdr(GLUShdrimage* hdrimage, GLUS
  */
 GLUSAPI GLUSboolean GLUSAPIENTRY glusImageLoadHdr(const GLUSchar* filename, GLUShdrimage* hdrimage);
 
+/**
+ * Reads the width and height of a HDR file in memory, without decoding the pixels. The data of the structure is set to zero.
+ *
+ * @param binaryfile The content of the HDR file.
+ * @param hdrimage   The structure to fill the HDR information.
+ *
+ * @return GLUS_TRUE, if the header is valid and supported.
+ */
+GLUSAPI GLUSboolean GLUSAPIENTRY glusImageInfoHdr(const GLUSbinaryfile* binaryfile, GLUShdrimage* hdrimage);
+
+/**
+ * Decodes a HDR file in memory to RGB floats.
+ *
+ * @param binaryfile The content of the HDR file.
+ * @param hdrimage   The structure to fill the HDR data.
+ * @param data       Width * height * 3 floats to decode into, see glusImageInfoHdr(). The structure does not own this memory,
+ *                   so glusImageDestroyHdr() must not be called on success. If zero, the data is allocated.
+ *
+ * @return GLUS_TRUE, if decoding succeeded.
+ */
+GLUSAPI GLUSboolean GLUSAPIENTRY glusImageDecodeHdr(const GLUSbinaryfile* binaryfile, GLUShdrimage* hdrimage, GLUSfloat* data);
+
 /**
  * Saves a HDR file.
  *
@@ -41,6 +41,28 @@ GLUSAPI GLUSboolean GLUSAPIENTRY glusImageCreateTga(GLUStgaimage* tgaimage, GLUS
  */
 GLUSAPI GLUSboolean GLUSAPIENTRY glusImageLoadTga(const GLUSchar* filename, GLUStgaimage* tgaimage);
 
+/**
+ * Reads the width, height and format of a TGA file in memory, without decoding the pixels. The data of the structure is set to zero.
+ *
+ * @param binaryfile The content of the TGA file.
+ * @param tgaimage   The structure to fill the TGA information.
+ *
+ * @return GLUS_TRUE, if the header is valid and supported.
+ */
+GLUSAPI GLUSboolean GLUSAPIENTRY glusImageInfoTga(const GLUSbinaryfile* binaryfile, GLUStgaimage* tgaimage);
+
+/**
+ * Decodes a TGA file in memory.
+ *
+ * @param binaryfile The content of the TGA file.
+ * @param tgaimage   The structure to fill the TGA data.
+ * @param data       Width * height * channels bytes to decode into, see glusImageInfoTga(). The structure does not own this memory,
+ *                   so glusImageDestroyTga() must not be called on success. If zero, the data is allocated.
+ *
+ * @return GLUS_TRUE, if decoding succeeded.
+ */
+GLUSAPI GLUSboolean GLUSAPIENTRY glusImageDecodeTga(const GLUSbinaryfile* binaryfile, GLUStgaimage* tgaimage, GLUSubyte* data);
+
 /**
  * Saves a TGA file.
  *
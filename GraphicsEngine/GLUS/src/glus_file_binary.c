@@ -72,8 +72,6 @@ GLUSboolean GLUSAPIENTRY glusFileLoadBinary(const GLUSchar* filename, GLUSbinary
 		return GLUS_FALSE;
 	}
 
-	memset(binaryfile->binary, 0, (size_t)binaryfile->length);
-
 	rewind(f);
 
 	elementsRead = fread(binaryfile->binary, 1, (size_t)binaryfile->length, f);
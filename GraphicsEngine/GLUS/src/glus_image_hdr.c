@@ -17,19 +17,13 @@
 
 #include "GL/glus.h"
 
+#define GLUS_MAX_DIMENSION 16384
+
 extern GLUSvoid _glusImageGatherSamplePoints(GLUSint sampleIndex[4], GLUSfloat sampleWeight[2], const GLUSfloat st[2], GLUSint width, GLUSint height, GLUSint stride);
 
 extern GLUSboolean _glusFileCheckRead(FILE* f, size_t actualRead, size_t expectedRead);
 extern GLUSboolean _glusFileCheckWrite(FILE* f, size_t actualWrite, size_t expectedWrite);
 
-static GLUSvoid glusImageConvertRGBE(GLUSfloat* rgb, const GLUSubyte* rgbe)
-{
-	GLUSfloat exponent = (GLUSfloat)(rgbe[3] - 128);
-
-	rgb[0] = (GLUSfloat)rgbe[0] / 256.0f * powf(2.0f, exponent);
-	rgb[1] = (GLUSfloat)rgbe[1] / 256.0f * powf(2.0f, exponent);
-	rgb[2] = (GLUSfloat)rgbe[2] / 256.0f * powf(2.0f, exponent);
-}
 static GLUSvoid glusImageConvertRGB(GLUSubyte* rgbe, const GLUSfloat* rgb)
 {
 	GLUSfloat significant[3];
@@ -56,93 +50,6 @@ static GLUSvoid glusImageConvertRGB(GLUSubyte* rgbe, const GLUSfloat* rgb)
 	rgbe[3] = (GLUSubyte)(maxExponent + 128);
 }
 
-static GLUSint glusImageDecodeNewRLE(FILE* file, GLUSubyte* scanline, GLUSint width)
-{
-	GLUSint channel, x, scanLength, maxScanLength;
-	GLUSubyte code, channelValue;
-	size_t elementsRead;
-
-	maxScanLength = 0;
-
-	// read each component
-	for (channel = 0; channel < 4; channel++)
-	{
-		x = 0;
-
-		scanLength = 0;
-
-		while (x < width)
-		{
-			elementsRead = fread(&code, 1, 1, file);
-
-			if (!_glusFileCheckRead(file, elementsRead, 1))
-			{
-				return -1;
-			}
-
-			if (code > 128)
-			{
-				// Run
-
-				code &= 127;
-
-				scanLength += code;
-
-				if (scanLength > width)
-				{
-					fclose(file);
-
-					return -1;
-				}
-
-				elementsRead = fread(&channelValue, 1, 1, file);
-
-				if (!_glusFileCheckRead(file, elementsRead, 1))
-				{
-					return -1;
-				}
-
-				while (code--)
-				{
-					scanline[x++ * 4 + channel] = channelValue;
-				}
-			}
-			else
-			{
-				// Non-run
-
-				scanLength += code;
-
-				if (scanLength > width)
-				{
-					fclose(file);
-
-					return -1;
-				}
-
-				while (code--)
-				{
-					elementsRead = fread(&channelValue, 1, 1, file);
-
-					if (!_glusFileCheckRead(file, elementsRead, 1))
-					{
-						return -1;
-					}
-
-					scanline[x++ * 4 + channel] = channelValue;
-				}
-			}
-		}
-
-		if (scanLength > maxScanLength)
-		{
-			maxScanLength = scanLength;
-		}
-	}
-
-	return maxScanLength;
-}
-
 GLUSboolean GLUSAPIENTRY glusImageCreateHdr(GLUShdrimage* hdrimage, GLUSint width, GLUSint height, GLUSint depth, GLUSenum format)
 {
 	GLUSint stride;
@@ -190,114 +97,188 @@ GLUSboolean GLUSAPIENTRY glusImageCreateHdr(GLUShdrimage* hdrimage, GLUSint widt
 // see http://radiance-online.org/cgi-bin/viewcvs.cgi/ray/src/common/color.c?view=markup
 // see http://www.flipcode.com/archives/HDR_Image_Reader.shtml
 
-GLUSboolean GLUSAPIENTRY glusImageLoadHdr(const GLUSchar* filename, GLUShdrimage* hdrimage)
+/**
+ * Builds the factors for converting RGBE to floats. A mantissa m with exponent e is m / 256 * 2^(e - 128), so the factor
+ * of e is 2^(e - 136). All products are exact, even for small exponents.
+ */
+static GLUSvoid glusImageInitScaleHdr(GLUSfloat scale[256])
 {
-	FILE* file;
+	GLUSint i;
 
-	GLUSchar buffer[256];
-	GLUSchar currentChar, oldChar;
+	for (i = 0; i < 256; i++)
+	{
+		scale[i] = ldexpf(1.0f, i - 136);
+	}
+}
 
-	GLUSint width, height, x, y, repeat, factor, i;
+/**
+ * Decodes a new RLE scanline into four planes of width bytes, one for each component.
+ *
+ * @return The position after the scanline. Zero, if the scanline is corrupt.
+ */
+static const GLUSubyte* glusImageDecodeNewRLE(const GLUSubyte* current, const GLUSubyte* end, GLUSubyte* scanline, GLUSint width)
+{
+	GLUSint channel, x, count;
+	GLUSubyte* plane;
+	GLUSubyte code;
 
-	GLUSubyte* scanline;
-	GLUSubyte rgbe[4];
-	GLUSubyte prevRgbe[4];
+	// read each component
+	for (channel = 0; channel < 4; channel++)
+	{
+		plane = &scanline[channel * width];
 
-	GLUSfloat rgb[3];
+		x = 0;
 
-	size_t elementsRead;
+		while (x < width)
+		{
+			if (current >= end)
+			{
+				return 0;
+			}
 
-	// check, if we have a valid pointer
-	if (!filename || !hdrimage)
+			code = *current++;
+
+			if (code > 128)
+			{
+				// Run
+
+				count = code & 127;
+
+				if (x + count > width || current >= end)
+				{
+					return 0;
+				}
+
+				memset(&plane[x], *current++, count);
+			}
+			else
+			{
+				// Non-run
+
+				count = code;
+
+				if (count == 0 || x + count > width || end - current < count)
+				{
+					return 0;
+				}
+
+				memcpy(&plane[x], current, count);
+
+				current += count;
+			}
+
+			x += count;
+		}
+	}
+
+	return current;
+}
+
+/**
+ * Converts the planes of a scanline to RGB floats.
+ */
+static GLUSvoid glusImageConvertScanlineHdr(GLUSfloat* rgb, const GLUSubyte* scanline, GLUSint width, const GLUSfloat scale[256])
+{
+	const GLUSubyte* red = &scanline[0];
+	const GLUSubyte* green = &scanline[width];
+	const GLUSubyte* blue = &scanline[width * 2];
+	const GLUSubyte* exponent = &scanline[width * 3];
+
+	GLUSfloat factor;
+	GLUSint i;
+
+	for (i = 0; i < width; i++)
 	{
-		return GLUS_FALSE;
+		factor = scale[exponent[i]];
+
+		rgb[i * 3 + 0] = (GLUSfloat)red[i] * factor;
+		rgb[i * 3 + 1] = (GLUSfloat)green[i] * factor;
+		rgb[i * 3 + 2] = (GLUSfloat)blue[i] * factor;
 	}
+}
+
+static GLUSboolean glusImageParseHdr(const GLUSbinaryfile* binaryfile, GLUShdrimage* hdrimage, GLUSint* dataOffset)
+{
+	const GLUSchar* buffer;
+
+	GLUSchar resolution[256];
+
+	GLUSint length, i, k, width, height;
 
 	hdrimage->width = 0;
 	hdrimage->height = 0;
 	hdrimage->depth = 0;
 	hdrimage->data = 0;
+	hdrimage->format = 0;
 
-	// open filename in "read binary" mode
-	file = fopen(filename, "rb");
-
-	if (!file)
+	if (!binaryfile->binary)
 	{
 		return GLUS_FALSE;
 	}
 
-	elementsRead = fread(buffer, 10, 1, file);
-
-	if (!_glusFileCheckRead(file, elementsRead, 1))
-	{
-		return GLUS_FALSE;
-	}
+	buffer = (const GLUSchar*)binaryfile->binary;
+	length = binaryfile->length;
 
 	//
 	// Information header
 	//
 
 	// Identifier
-	if (strncmp(buffer, "#?RADIANCE", 10))
-	{
-		fclose(file);
-
-		return GLUS_FALSE;
-	}
-
-	// Go to variables
-	if (fseek(file, 1, SEEK_CUR))
+	if (!(length >= 10 && !strncmp(buffer, "#?RADIANCE", 10)) && !(length >= 6 && !strncmp(buffer, "#?RGBE", 6)))
 	{
-		fclose(file);
-
 		return GLUS_FALSE;
 	}
 
-	// Variables
-	currentChar = 0;
+	// Variables, an empty line indicates the end of the header
+	i = 0;
 	while (GLUS_TRUE)
 	{
-		oldChar = currentChar;
-
-		elementsRead = fread(&currentChar, 1, 1, file);
+		while (i < length && buffer[i] != '\n')
+		{
+			i++;
+		}
 
-		if (!_glusFileCheckRead(file, elementsRead, 1))
+		if (i + 1 >= length)
 		{
 			return GLUS_FALSE;
 		}
 
-		// Empty line indicates end of header
-		if (currentChar == '\n' && oldChar == '\n')
+		i++;
+
+		if (buffer[i] == '\n')
 		{
+			i++;
+
 			break;
 		}
 	}
 
 	// Resolution
-	i = 0;
+	k = 0;
 	while (GLUS_TRUE)
 	{
-		elementsRead = fread(&currentChar, 1, 1, file);
-
-		if (!_glusFileCheckRead(file, elementsRead, 1))
+		if (i >= length || k == 255)
 		{
 			return GLUS_FALSE;
 		}
 
-		buffer[i++] = currentChar;
+		resolution[k++] = buffer[i++];
 
-		if (currentChar == '\n')
+		if (buffer[i - 1] == '\n')
 		{
 			break;
 		}
 	}
+	resolution[k] = '\0';
 
-	if (!sscanf(buffer, "-Y %d +X %d", &height, &width))
+	// Only the standard orientation is supported
+	if (sscanf(resolution, "-Y %d +X %d", &height, &width) != 2)
 	{
-		fclose(file);
-
-		glusImageDestroyHdr(hdrimage);
+		return GLUS_FALSE;
+	}
 
+	if (width < 1 || width > GLUS_MAX_DIMENSION || height < 1 || height > GLUS_MAX_DIMENSION)
+	{
 		return GLUS_FALSE;
 	}
 
@@ -306,30 +287,35 @@ GLUSboolean GLUSAPIENTRY glusImageLoadHdr(const GLUSchar* filename, GLUShdrimage
 	hdrimage->depth = 1;
 	hdrimage->format = GLUS_RGB;
 
-	hdrimage->data = (GLUSfloat*)glusMemoryMalloc(width * height * 3 * sizeof(GLUSfloat));
+	*dataOffset = i;
 
-	if (!hdrimage->data)
-	{
-		fclose(file);
+	return GLUS_TRUE;
+}
 
-		glusImageDestroyHdr(hdrimage);
+static GLUSboolean glusImageDecodePixelsHdr(const GLUSbinaryfile* binaryfile, const GLUShdrimage* hdrimage, GLUSint dataOffset, GLUSfloat* data, GLUSubyte* scanline)
+{
+	const GLUSubyte* current;
+	const GLUSubyte* end;
 
-		return GLUS_FALSE;
-	}
+	GLUSfloat scale[256];
 
-	// Scanlines
-	scanline = (GLUSubyte*)glusMemoryMalloc(width * 4 * sizeof(GLUSubyte));
+	GLUSubyte prevRgbe[4];
+	const GLUSubyte* rgbe;
 
-	if (!scanline)
-	{
-		glusMemoryFree(scanline);
+	GLUSfloat rgb[3];
 
-		fclose(file);
+	GLUSint width, height, x, y, i;
+	size_t repeat, factor, remaining, numberPixels;
 
-		glusImageDestroyHdr(hdrimage);
+	glusImageInitScaleHdr(scale);
 
-		return GLUS_FALSE;
-	}
+	width = hdrimage->width;
+	height = hdrimage->height;
+
+	numberPixels = (size_t)width * height;
+
+	current = &binaryfile->binary[dataOffset];
+	end = &binaryfile->binary[binaryfile->length];
 
 	prevRgbe[0] = 0;
 	prevRgbe[1] = 0;
@@ -341,85 +327,52 @@ GLUSboolean GLUSAPIENTRY glusImageLoadHdr(const GLUSchar* filename, GLUShdrimage
 	y = height - 1;
 	while (y >= 0)
 	{
-		elementsRead = fread(buffer, 4, 1, file);
-
-		if (!_glusFileCheckRead(file, elementsRead, 1))
+		if (end - current < 4)
 		{
-			glusMemoryFree(scanline);
-
-			glusImageDestroyHdr(hdrimage);
-
 			return GLUS_FALSE;
 		}
 
-		repeat = 0;
-
 		// Examine value
-		if (width < 32768 && buffer[0] == 2 && buffer[1] == 2 && buffer[2] == ((width >> 8) & 0xFF) && buffer[3] == (width & 0xFF))
+		if (x == 0 && width >= 8 && width < 32768 && current[0] == 2 && current[1] == 2 && current[2] == ((width >> 8) & 0xFF) && current[3] == (width & 0xFF))
 		{
-			// New RLE decoding
+			// New RLE decoding, a whole scanline at once
 
-			GLUSint scanlinePixels = glusImageDecodeNewRLE(file, scanline, width);
+			current = glusImageDecodeNewRLE(current + 4, end, scanline, width);
 
-			if (scanlinePixels < 0)
+			if (!current)
 			{
-				glusMemoryFree(scanline);
-
-				// File already closed
-
-				glusImageDestroyHdr(hdrimage);
-
 				return GLUS_FALSE;
 			}
 
-			for (i = 0; i < scanlinePixels; i++)
-			{
-				if (y < 0)
-				{
-					glusMemoryFree(scanline);
-
-					fclose(file);
+			glusImageConvertScanlineHdr(&data[width * y * 3], scanline, width, scale);
 
-					glusImageDestroyHdr(hdrimage);
-
-					return GLUS_FALSE;
-				}
-
-				glusImageConvertRGBE(rgb, &scanline[i * 4]);
-
-				hdrimage->data[(width * y + x) * 3 + 0] = rgb[0];
-				hdrimage->data[(width * y + x) * 3 + 1] = rgb[1];
-				hdrimage->data[(width * y + x) * 3 + 2] = rgb[2];
-
-				x++;
-				if (x >= width)
-				{
-					y--;
-					x = 0;
-				}
-			}
+			y--;
 
 			factor = 1;
 
-			prevRgbe[0] = scanline[(scanlinePixels - 1) * 4 + 0];
-			prevRgbe[1] = scanline[(scanlinePixels - 1) * 4 + 1];
-			prevRgbe[2] = scanline[(scanlinePixels - 1) * 4 + 2];
-			prevRgbe[3] = scanline[(scanlinePixels - 1) * 4 + 3];
+			for (i = 0; i < 4; i++)
+			{
+				prevRgbe[i] = scanline[i * width + width - 1];
+			}
 
 			continue;
 		}
-		else if (buffer[0] == 1 && buffer[1] == 1 && buffer[2] == 1)
+
+		remaining = (size_t)y * width + (width - x);
+
+		if (current[0] == 1 && current[1] == 1 && current[2] == 1)
 		{
 			// Old RLE decoding
 
-			repeat = buffer[3] * factor;
+			repeat = current[3] * factor;
 
-			rgbe[0] = prevRgbe[0];
-			rgbe[1] = prevRgbe[1];
-			rgbe[2] = prevRgbe[2];
-			rgbe[3] = prevRgbe[3];
+			rgbe = prevRgbe;
 
-			factor *= 256;
+			// Once larger than the image, any further repeat is corrupt anyway
+			if (factor <= numberPixels)
+			{
+				factor *= 256;
+			}
 		}
 		else
 		{
@@ -427,32 +380,25 @@ GLUSboolean GLUSAPIENTRY glusImageLoadHdr(const GLUSchar* filename, GLUShdrimage
 
 			repeat = 1;
 
-			rgbe[0] = buffer[0];
-			rgbe[1] = buffer[1];
-			rgbe[2] = buffer[2];
-			rgbe[3] = buffer[3];
+			rgbe = current;
 
 			factor = 1;
 		}
 
-		glusImageConvertRGBE(rgb, rgbe);
-
-		while (repeat)
+		if (repeat > remaining)
 		{
-			if (y < 0)
-			{
-				glusMemoryFree(scanline);
-
-				fclose(file);
-
-				glusImageDestroyHdr(hdrimage);
+			return GLUS_FALSE;
+		}
 
-				return GLUS_FALSE;
-			}
+		rgb[0] = (GLUSfloat)rgbe[0] * scale[rgbe[3]];
+		rgb[1] = (GLUSfloat)rgbe[1] * scale[rgbe[3]];
+		rgb[2] = (GLUSfloat)rgbe[2] * scale[rgbe[3]];
 
-			hdrimage->data[(width * y + x) * 3 + 0] = rgb[0];
-			hdrimage->data[(width * y + x) * 3 + 1] = rgb[1];
-			hdrimage->data[(width * y + x) * 3 + 2] = rgb[2];
+		while (repeat)
+		{
+			data[(width * y + x) * 3 + 0] = rgb[0];
+			data[(width * y + x) * 3 + 1] = rgb[1];
+			data[(width * y + x) * 3 + 2] = rgb[2];
 
 			x++;
 			if (x >= width)
@@ -464,19 +410,123 @@ GLUSboolean GLUSAPIENTRY glusImageLoadHdr(const GLUSchar* filename, GLUShdrimage
 			repeat--;
 		}
 
-		prevRgbe[0] = rgbe[0];
-		prevRgbe[1] = rgbe[1];
-		prevRgbe[2] = rgbe[2];
-		prevRgbe[3] = rgbe[3];
+		if (rgbe != prevRgbe)
+		{
+			memcpy(prevRgbe, rgbe, 4);
+		}
+
+		current += 4;
+	}
+
+	return GLUS_TRUE;
+}
+
+GLUSboolean GLUSAPIENTRY glusImageInfoHdr(const GLUSbinaryfile* binaryfile, GLUShdrimage* hdrimage)
+{
+	GLUSint dataOffset;
+
+	// check, if we have a valid pointer
+	if (!binaryfile || !hdrimage)
+	{
+		return GLUS_FALSE;
+	}
+
+	return glusImageParseHdr(binaryfile, hdrimage, &dataOffset);
+}
+
+GLUSboolean GLUSAPIENTRY glusImageDecodeHdr(const GLUSbinaryfile* binaryfile, GLUShdrimage* hdrimage, GLUSfloat* data)
+{
+	GLUSint dataOffset;
+
+	GLUSfloat* pixels = data;
+
+	GLUSubyte* scanline;
+
+	// check, if we have a valid pointer
+	if (!binaryfile || !hdrimage)
+	{
+		return GLUS_FALSE;
+	}
+
+	if (!glusImageParseHdr(binaryfile, hdrimage, &dataOffset))
+	{
+		return GLUS_FALSE;
+	}
+
+	// Scanlines
+	scanline = (GLUSubyte*)glusMemoryMalloc((size_t)hdrimage->width * 4 * sizeof(GLUSubyte));
+
+	if (!scanline)
+	{
+		glusImageDestroyHdr(hdrimage);
+
+		return GLUS_FALSE;
+	}
+
+	if (!pixels)
+	{
+		pixels = (GLUSfloat*)glusMemoryMalloc((size_t)hdrimage->width * hdrimage->height * 3 * sizeof(GLUSfloat));
+
+		if (!pixels)
+		{
+			glusMemoryFree(scanline);
+
+			glusImageDestroyHdr(hdrimage);
+
+			return GLUS_FALSE;
+		}
+	}
+
+	if (!glusImageDecodePixelsHdr(binaryfile, hdrimage, dataOffset, pixels, scanline))
+	{
+		if (!data)
+		{
+			glusMemoryFree(pixels);
+		}
+
+		glusMemoryFree(scanline);
+
+		glusImageDestroyHdr(hdrimage);
+
+		return GLUS_FALSE;
 	}
 
 	glusMemoryFree(scanline);
 
-	fclose(file);
+	hdrimage->data = pixels;
 
 	return GLUS_TRUE;
 }
 
+GLUSboolean GLUSAPIENTRY glusImageLoadHdr(const GLUSchar* filename, GLUShdrimage* hdrimage)
+{
+	GLUSbinaryfile binaryfile;
+	GLUSboolean result;
+
+	// check, if we have a valid pointer
+	if (!filename || !hdrimage)
+	{
+		return GLUS_FALSE;
+	}
+
+	hdrimage->width = 0;
+	hdrimage->height = 0;
+	hdrimage->depth = 0;
+	hdrimage->data = 0;
+
+	// the whole file is read at once and decoded from memory
+	if (!glusFileLoadBinary(filename, &binaryfile))
+	{
+		return GLUS_FALSE;
+	}
+
+	result = glusImageDecodeHdr(&binaryfile, hdrimage, 0);
+
+	glusFileDestroyBinary(&binaryfile);
+
+	return result;
+}
+
 GLUSboolean GLUSAPIENTRY glusImageSaveHdr(const GLUSchar* filename, const GLUShdrimage* hdrimage)
 {
 	FILE* file;
@@ -88,29 +88,57 @@ GLUSboolean GLUSAPIENTRY glusImageCreateTga(GLUStgaimage* tgaimage, GLUSint widt
 	return GLUS_TRUE;
 }
 
-GLUSboolean GLUSAPIENTRY glusImageLoadTga(const GLUSchar* filename, GLUStgaimage* tgaimage)
+/**
+ * Header values of a TGA file, which are needed for decoding the pixels.
+ */
+typedef struct _GLUStgaheader
 {
-	FILE* file;
-
-	GLUSboolean hasColorMap = GLUS_FALSE;
-
 	GLUSubyte imageType;
+
 	GLUSubyte bitsPerPixel;
 
 	GLUSushort firstEntryIndex;
+
 	GLUSushort colorMapLength;
+
 	GLUSubyte colorMapEntrySize;
-	GLUSubyte* colorMap = 0;
 
-	GLUSuint i, k;
+	GLUSint colorMapOffset;
 
-	size_t elementsRead;
+	GLUSint dataOffset;
 
-	// check, if we have a valid pointer
-	if (!filename || !tgaimage)
+} GLUStgaheader;
+
+static GLUSushort glusImageReadShortTga(const GLUSubyte* buffer)
+{
+	return (GLUSushort)(buffer[0] | (buffer[1] << 8));
+}
+
+static GLUSint glusImageGetBytesPerPixelTga(GLUSenum format)
+{
+	if (format == GLUS_RGB)
 	{
-		return GLUS_FALSE;
+		return 3;
 	}
+	else if (format == GLUS_RGBA)
+	{
+		return 4;
+	}
+
+	return 1;
+}
+
+static GLUSboolean glusImageParseTga(const GLUSbinaryfile* binaryfile, GLUStgaimage* tgaimage, GLUStgaheader* header)
+{
+	const GLUSubyte* buffer;
+
+	GLUSubyte idLength;
+	GLUSubyte colorMapType;
+
+	GLUSint width;
+	GLUSint height;
+	GLUSint colorMapSize;
+	GLUSint bytesPerPixel;
 
 	tgaimage->width = 0;
 	tgaimage->height = 0;
@@ -118,392 +146,394 @@ GLUSboolean GLUSAPIENTRY glusImageLoadTga(const GLUSchar* filename, GLUStgaimage
 	tgaimage->data = 0;
 	tgaimage->format = 0;
 
-	// open filename in "read binary" mode
-	file = fopen(filename, "rb");
-
-	if (!file)
+	// the header is always 18 bytes
+	if (!binaryfile->binary || binaryfile->length < 18)
 	{
 		return GLUS_FALSE;
 	}
 
-	// seek through the tga header, up to the type:
-	if (fseek(file, 2, SEEK_CUR))
-	{
-		fclose(file);
+	buffer = binaryfile->binary;
+
+	idLength = buffer[0];
+	colorMapType = buffer[1];
+	header->imageType = buffer[2];
 
+	// check the type
+	if (header->imageType != 1 && header->imageType != 2 && header->imageType != 3 && header->imageType != 9 && header->imageType != 10 && header->imageType != 11)
+	{
 		return GLUS_FALSE;
 	}
 
-	// read the image type
-	elementsRead = fread(&imageType, 1, 1, file);
+	header->firstEntryIndex = glusImageReadShortTga(&buffer[3]);
+	header->colorMapLength = glusImageReadShortTga(&buffer[5]);
+	header->colorMapEntrySize = buffer[7];
 
-	if (!_glusFileCheckRead(file, elementsRead, 1))
+	width = (GLUSint)glusImageReadShortTga(&buffer[12]);
+	height = (GLUSint)glusImageReadShortTga(&buffer[14]);
+
+	if (width < 1 || width > GLUS_MAX_DIMENSION || height < 1 || height > GLUS_MAX_DIMENSION)
 	{
 		return GLUS_FALSE;
 	}
 
-	// check the type
-	if (imageType != 1 && imageType != 2 && imageType != 3 && imageType != 9 && imageType != 10 && imageType != 11)
-	{
-		fclose(file);
+	header->bitsPerPixel = buffer[16];
 
-		return GLUS_FALSE;
+	// the color map follows the image identification, the pixel data follows the color map
+	header->colorMapOffset = 18 + idLength;
+
+	colorMapSize = 0;
+
+	if (colorMapType == 1 || header->imageType == 1 || header->imageType == 9)
+	{
+		colorMapSize = (GLUSint)header->colorMapLength * ((header->colorMapEntrySize + 7) / 8);
 	}
 
-	if (imageType == 1 || imageType == 9)
+	header->dataOffset = header->colorMapOffset + colorMapSize;
+
+	if (header->dataOffset > binaryfile->length)
 	{
-		hasColorMap = GLUS_TRUE;
+		return GLUS_FALSE;
 	}
 
-	if (!hasColorMap)
+	if (header->imageType == 1 || header->imageType == 9)
 	{
-		// seek through the tga header, up to the width/height:
-		if (fseek(file, 9, SEEK_CUR))
+		// only 8 bit indices into 8, 24 or 32 bit colors are supported
+		if (header->bitsPerPixel != 8 || (header->colorMapEntrySize != 8 && header->colorMapEntrySize != 24 && header->colorMapEntrySize != 32))
 		{
-			fclose(file);
-
 			return GLUS_FALSE;
 		}
+
+		bytesPerPixel = header->colorMapEntrySize / 8;
 	}
 	else
 	{
-		elementsRead = fread(&firstEntryIndex, 2, 1, file);
-
-		if (!_glusFileCheckRead(file, elementsRead, 1))
+		// check the pixel depth
+		if (header->bitsPerPixel != 8 && header->bitsPerPixel != 24 && header->bitsPerPixel != 32)
 		{
-			glusImageDestroyTga(tgaimage);
-
 			return GLUS_FALSE;
 		}
 
-		elementsRead = fread(&colorMapLength, 2, 1, file);
-
-		if (!_glusFileCheckRead(file, elementsRead, 1))
-		{
-			glusImageDestroyTga(tgaimage);
+		bytesPerPixel = header->bitsPerPixel / 8;
+	}
 
-			return GLUS_FALSE;
-		}
+	tgaimage->width = (GLUSushort)width;
+	tgaimage->height = (GLUSushort)height;
+	tgaimage->depth = 1;
 
-		elementsRead = fread(&colorMapEntrySize, 1, 1, file);
+	tgaimage->format = GLUS_SINGLE_CHANNEL;
+	if (bytesPerPixel == 3)
+	{
+		tgaimage->format = GLUS_RGB;
+	}
+	else if (bytesPerPixel == 4)
+	{
+		tgaimage->format = GLUS_RGBA;
+	}
 
-		if (!_glusFileCheckRead(file, elementsRead, 1))
-		{
-			glusImageDestroyTga(tgaimage);
+	return GLUS_TRUE;
+}
 
-			return GLUS_FALSE;
-		}
+/**
+ * Converts a block of pixels, either by looking up the color of each index or by swapping BGR to RGB. Without a color map,
+ * the target may also be in front of the source in the same memory.
+ */
+static GLUSboolean glusImageCopyPixelsTga(GLUSubyte* target, const GLUSubyte* source, GLUSint numberPixels, GLUSint bytesPerPixel, const GLUSubyte* colorMap, GLUSint colorMapLength)
+{
+	GLUSint i;
 
-		// seek through the tga header, up to the width/height:
-		if (fseek(file, 4, SEEK_CUR))
+	if (colorMap)
+	{
+		for (i = 0; i < numberPixels; i++)
 		{
-			fclose(file);
+			if ((GLUSint)source[i] >= colorMapLength)
+			{
+				return GLUS_FALSE;
+			}
 
-			return GLUS_FALSE;
+			memcpy(&target[i * bytesPerPixel], &colorMap[source[i] * bytesPerPixel], bytesPerPixel);
 		}
 	}
-
-	// read the width
-	elementsRead = fread(&tgaimage->width, 2, 1, file);
-
-	if (!_glusFileCheckRead(file, elementsRead, 1))
+	else if (bytesPerPixel == 3)
 	{
-		glusImageDestroyTga(tgaimage);
-
-		return GLUS_FALSE;
+		for (i = 0; i < numberPixels * 3; i += 3)
+		{
+			target[i + 0] = source[i + 2];
+			target[i + 1] = source[i + 1];
+			target[i + 2] = source[i + 0];
+		}
 	}
-
-	if (tgaimage->width > GLUS_MAX_DIMENSION)
+	else if (bytesPerPixel == 4)
 	{
-		glusImageDestroyTga(tgaimage);
-
-		return GLUS_FALSE;
+		for (i = 0; i < numberPixels * 4; i += 4)
+		{
+			target[i + 0] = source[i + 2];
+			target[i + 1] = source[i + 1];
+			target[i + 2] = source[i + 0];
+			target[i + 3] = source[i + 3];
+		}
 	}
-
-	// read the height
-	elementsRead = fread(&tgaimage->height, 2, 1, file);
-
-	if (!_glusFileCheckRead(file, elementsRead, 1))
+	else
 	{
-		glusImageDestroyTga(tgaimage);
-
-		return GLUS_FALSE;
+		memmove(target, source, numberPixels);
 	}
 
-	if (tgaimage->height > GLUS_MAX_DIMENSION)
-	{
-		glusImageDestroyTga(tgaimage);
-
-		return GLUS_FALSE;
-	}
-
-	tgaimage->depth = 1;
+	return GLUS_TRUE;
+}
 
-	// read the bits per pixel
-	elementsRead = fread(&bitsPerPixel, 1, 1, file);
+/**
+ * Replicates one pixel for a whole run. The already filled part is copied over and over, doubling its size each time.
+ */
+static GLUSvoid glusImageFillPixelsTga(GLUSubyte* target, const GLUSubyte* pixel, GLUSint numberPixels, GLUSint bytesPerPixel)
+{
+	GLUSint filledBytes;
+	GLUSint totalBytes;
+	GLUSint copyBytes;
 
-	if (!_glusFileCheckRead(file, elementsRead, 1))
+	if (bytesPerPixel == 1)
 	{
-		glusImageDestroyTga(tgaimage);
+		memset(target, pixel[0], numberPixels);
 
-		return GLUS_FALSE;
+		return;
 	}
 
-	// check the pixel depth
-	if (bitsPerPixel != 8 && bitsPerPixel != 24 && bitsPerPixel != 32)
-	{
-		fclose(file);
+	memcpy(target, pixel, bytesPerPixel);
 
-		glusImageDestroyTga(tgaimage);
+	filledBytes = bytesPerPixel;
+	totalBytes = numberPixels * bytesPerPixel;
 
-		return GLUS_FALSE;
-	}
-	else
+	while (filledBytes < totalBytes)
 	{
-		tgaimage->format = GLUS_SINGLE_CHANNEL;
-		if (bitsPerPixel == 24)
-		{
-			tgaimage->format = GLUS_RGB;
-		}
-		else if (bitsPerPixel == 32)
+		copyBytes = filledBytes;
+		if (copyBytes > totalBytes - filledBytes)
 		{
-			tgaimage->format = GLUS_RGBA;
+			copyBytes = totalBytes - filledBytes;
 		}
-	}
 
-	// move file pointer to beginning of targa data
-	if (fseek(file, 1, SEEK_CUR))
-	{
-		fclose(file);
-
-		glusImageDestroyTga(tgaimage);
+		memcpy(&target[filledBytes], target, copyBytes);
 
-		return GLUS_FALSE;
+		filledBytes += copyBytes;
 	}
+}
 
-	if (hasColorMap)
-	{
-		// Create color map space.
+static GLUSboolean glusImageDecodePixelsTga(const GLUSbinaryfile* binaryfile, const GLUStgaimage* tgaimage, const GLUStgaheader* header, GLUSubyte* data)
+{
+	const GLUSubyte* current;
+	const GLUSubyte* end;
 
-		GLUSint bytesPerPixel = colorMapEntrySize / 8;
+	GLUSubyte colorMap[256 * 4];
+	GLUSint colorMapLength = 0;
 
-		colorMap = (GLUSubyte*)glusMemoryMalloc((size_t)colorMapLength * bytesPerPixel * sizeof(GLUSubyte));
+	GLUSubyte pixel[4];
 
-		if (!colorMap)
-		{
-			fclose(file);
+	GLUSint bytesPerPixel;
+	GLUSint sourceBytesPerPixel;
+	GLUSint numberPixels;
+	GLUSint pixelsRead;
+	GLUSint amount;
+	GLUSboolean hasColorMap;
 
-			glusImageDestroyTga(tgaimage);
-
-			return GLUS_FALSE;
-		}
+	bytesPerPixel = glusImageGetBytesPerPixelTga(tgaimage->format);
+	sourceBytesPerPixel = header->bitsPerPixel / 8;
+	numberPixels = (GLUSint)tgaimage->width * (GLUSint)tgaimage->height;
 
-		// Read in the color map.
+	hasColorMap = header->imageType == 1 || header->imageType == 9;
 
-		elementsRead = fread(colorMap, 1, (size_t)colorMapLength * bytesPerPixel * sizeof(GLUSubyte), file);
-
-		if (!_glusFileCheckRead(file, elementsRead, (size_t)colorMapLength * bytesPerPixel * sizeof(GLUSubyte)))
+	if (hasColorMap)
+	{
+		// An index of the pixel data addresses the color at first entry index plus the index.
+		colorMapLength = (GLUSint)header->colorMapLength - (GLUSint)header->firstEntryIndex;
+		if (colorMapLength < 0)
 		{
-			glusImageDestroyTga(tgaimage);
-
-			glusMemoryFree(colorMap);
-			colorMap = 0;
-
-			return GLUS_FALSE;
+			colorMapLength = 0;
 		}
-
-		// swap the color if necessary
-		if (colorMapEntrySize == 24 || colorMapEntrySize == 32)
+		else if (colorMapLength > 256)
 		{
-			glusImageSwapColorChannel(colorMapLength, 1, colorMapEntrySize == 24 ? GLUS_RGB : GLUS_RGBA, colorMap);
+			colorMapLength = 256;
 		}
+
+		glusImageCopyPixelsTga(colorMap, &binaryfile->binary[header->colorMapOffset + header->firstEntryIndex * bytesPerPixel], colorMapLength, bytesPerPixel, 0, 0);
 	}
 
-	// allocate enough memory for the targa  data
-	tgaimage->data = (GLUSubyte*)glusMemoryMalloc((size_t)tgaimage->width * tgaimage->height * bitsPerPixel / 8);
+	current = &binaryfile->binary[header->dataOffset];
+	end = &binaryfile->binary[binaryfile->length];
 
-	// verify memory allocation
-	if (!tgaimage->data)
+	if (header->imageType == 1 || header->imageType == 2 || header->imageType == 3)
 	{
-		fclose(file);
-
-		glusImageDestroyTga(tgaimage);
-
-		if (hasColorMap)
+		// raw data
+		if (end - current < (ptrdiff_t)numberPixels * sourceBytesPerPixel)
 		{
-			glusMemoryFree(colorMap);
-			colorMap = 0;
+			return GLUS_FALSE;
 		}
 
-		return GLUS_FALSE;
+		return glusImageCopyPixelsTga(data, current, numberPixels, bytesPerPixel, hasColorMap ? colorMap : 0, colorMapLength);
 	}
 
-	if (imageType == 1 || imageType == 2 || imageType == 3)
-	{
-		// read in the raw data
-		elementsRead = fread(tgaimage->data, 1, (size_t)tgaimage->width * tgaimage->height * bitsPerPixel / 8, file);
+	// RLE encoded, each packet is converted at once
+	pixelsRead = 0;
 
-		if (!_glusFileCheckRead(file, elementsRead, (size_t)tgaimage->width * tgaimage->height * bitsPerPixel / 8))
+	while (pixelsRead < numberPixels)
+	{
+		if (current >= end)
 		{
-			glusImageDestroyTga(tgaimage);
+			return GLUS_FALSE;
+		}
 
-			if (hasColorMap)
-			{
-				glusMemoryFree(colorMap);
-				colorMap = 0;
-			}
+		amount = (*current & 0x7F) + 1;
 
+		if (amount > numberPixels - pixelsRead)
+		{
 			return GLUS_FALSE;
 		}
-	}
-	else
-	{
-		// RLE encoded
-		GLUSint pixelsRead = 0;
 
-		while (pixelsRead < tgaimage->width * tgaimage->height)
+		if (*current++ & 0x80)
 		{
-			GLUSubyte amount;
-
-			elementsRead = fread(&amount, 1, 1, file);
+			if (end - current < sourceBytesPerPixel)
+			{
+				return GLUS_FALSE;
+			}
 
-			if (!_glusFileCheckRead(file, elementsRead, 1))
+			if (!glusImageCopyPixelsTga(pixel, current, 1, bytesPerPixel, hasColorMap ? colorMap : 0, colorMapLength))
 			{
-				glusImageDestroyTga(tgaimage);
+				return GLUS_FALSE;
+			}
 
-				if (hasColorMap)
-				{
-					glusMemoryFree(colorMap);
-					colorMap = 0;
-				}
+			glusImageFillPixelsTga(&data[pixelsRead * bytesPerPixel], pixel, amount, bytesPerPixel);
 
+			current += sourceBytesPerPixel;
+		}
+		else
+		{
+			if (end - current < amount * sourceBytesPerPixel)
+			{
 				return GLUS_FALSE;
 			}
 
-			if (amount & 0x80)
+			if (!glusImageCopyPixelsTga(&data[pixelsRead * bytesPerPixel], current, amount, bytesPerPixel, hasColorMap ? colorMap : 0, colorMapLength))
 			{
-				GLUSint i;
-				GLUSint k;
+				return GLUS_FALSE;
+			}
 
-				amount &= 0x7F;
+			current += amount * sourceBytesPerPixel;
+		}
 
-				amount++;
+		pixelsRead += amount;
+	}
 
-				// read in the rle data
-				elementsRead = fread(&tgaimage->data[pixelsRead * bitsPerPixel / 8], 1, bitsPerPixel / 8, file);
+	return GLUS_TRUE;
+}
 
-				if (!_glusFileCheckRead(file, elementsRead, bitsPerPixel / 8))
-				{
-					glusImageDestroyTga(tgaimage);
+GLUSboolean GLUSAPIENTRY glusImageInfoTga(const GLUSbinaryfile* binaryfile, GLUStgaimage* tgaimage)
+{
+	GLUStgaheader header;
 
-					if (hasColorMap)
-					{
-						glusMemoryFree(colorMap);
-						colorMap = 0;
-					}
+	// check, if we have a valid pointer
+	if (!binaryfile || !tgaimage)
+	{
+		return GLUS_FALSE;
+	}
 
-					return GLUS_FALSE;
-				}
+	return glusImageParseTga(binaryfile, tgaimage, &header);
+}
 
-				for (i = 1; i < amount; i++)
-				{
-					for (k = 0; k < bitsPerPixel / 8; k++)
-					{
-						tgaimage->data[(pixelsRead + i) * bitsPerPixel / 8 + k] = tgaimage->data[pixelsRead * bitsPerPixel / 8 + k];
-					}
-				}
-			}
-			else
-			{
-				amount &= 0x7F;
+GLUSboolean GLUSAPIENTRY glusImageDecodeTga(const GLUSbinaryfile* binaryfile, GLUStgaimage* tgaimage, GLUSubyte* data)
+{
+	GLUStgaheader header;
 
-				amount++;
+	GLUSubyte* pixels = data;
 
-				// read in the raw data
-				elementsRead = fread(&tgaimage->data[pixelsRead * bitsPerPixel / 8], 1, (size_t)amount * bitsPerPixel / 8, file);
+	// check, if we have a valid pointer
+	if (!binaryfile || !tgaimage)
+	{
+		return GLUS_FALSE;
+	}
 
-				if (!_glusFileCheckRead(file, elementsRead, (size_t)amount * bitsPerPixel / 8))
-				{
-					glusImageDestroyTga(tgaimage);
+	if (!glusImageParseTga(binaryfile, tgaimage, &header))
+	{
+		return GLUS_FALSE;
+	}
 
-					if (hasColorMap)
-					{
-						glusMemoryFree(colorMap);
-						colorMap = 0;
-					}
+	if (!pixels)
+	{
+		pixels = (GLUSubyte*)glusMemoryMalloc((size_t)tgaimage->width * tgaimage->height * glusImageGetBytesPerPixelTga(tgaimage->format));
 
-					return GLUS_FALSE;
-				}
-			}
+		if (!pixels)
+		{
+			glusImageDestroyTga(tgaimage);
 
-			pixelsRead += amount;
+			return GLUS_FALSE;
 		}
 	}
 
-	// swap the color if necessary
-	if (bitsPerPixel == 24 || bitsPerPixel == 32)
+	if (!glusImageDecodePixelsTga(binaryfile, tgaimage, &header, pixels))
 	{
-		glusImageSwapColorChannel(tgaimage->width, tgaimage->height, tgaimage->format, tgaimage->data);
+		if (!data)
+		{
+			glusMemoryFree(pixels);
+		}
+
+		glusImageDestroyTga(tgaimage);
+
+		return GLUS_FALSE;
 	}
 
-	// close the file
-	fclose(file);
+	tgaimage->data = pixels;
 
-	if (hasColorMap)
+	return GLUS_TRUE;
+}
+
+GLUSboolean GLUSAPIENTRY glusImageLoadTga(const GLUSchar* filename, GLUStgaimage* tgaimage)
+{
+	GLUSbinaryfile binaryfile;
+	GLUStgaheader header;
+	GLUSboolean result;
+
+	// check, if we have a valid pointer
+	if (!filename || !tgaimage)
 	{
-		GLUSubyte* data = tgaimage->data;
+		return GLUS_FALSE;
+	}
 
-		GLUSint bytesPerPixel;
+	tgaimage->width = 0;
+	tgaimage->height = 0;
+	tgaimage->depth = 0;
+	tgaimage->data = 0;
+	tgaimage->format = 0;
 
-		// Allocating new memory, as current memory is a look up table index and not a color.
+	// the whole file is read at once and decoded from memory
+	if (!glusFileLoadBinary(filename, &binaryfile))
+	{
+		return GLUS_FALSE;
+	}
 
-		bytesPerPixel = colorMapEntrySize / 8;
+	if (!glusImageParseTga(&binaryfile, tgaimage, &header))
+	{
+		glusFileDestroyBinary(&binaryfile);
 
-		tgaimage->data = (GLUSubyte*)glusMemoryMalloc((size_t)tgaimage->width * tgaimage->height * bytesPerPixel);
+		return GLUS_FALSE;
+	}
 
-		if (!tgaimage->data)
+	// Uncompressed true color or grayscale pixels have the same size as the decoded ones, so they are converted in place to the start of the file content.
+	if (header.imageType == 2 || header.imageType == 3)
+	{
+		if (!glusImageDecodePixelsTga(&binaryfile, tgaimage, &header, binaryfile.binary))
 		{
 			glusImageDestroyTga(tgaimage);
 
-			glusMemoryFree(data);
-			data = 0;
-
-			glusMemoryFree(colorMap);
-			colorMap = 0;
+			glusFileDestroyBinary(&binaryfile);
 
 			return GLUS_FALSE;
 		}
 
-		tgaimage->format = GLUS_SINGLE_CHANNEL;
-		if (colorMapEntrySize == 24)
-		{
-			tgaimage->format = GLUS_RGB;
-		}
-		else if (colorMapEntrySize == 32)
-		{
-			tgaimage->format = GLUS_RGBA;
-		}
-
-		// Copy color values from the color map into the image data.
+		tgaimage->data = binaryfile.binary;
 
-		for (i = 0; i < (GLUSuint)tgaimage->width * (GLUSuint)tgaimage->height; i++)
-		{
-			for (k = 0; k < (GLUSuint)bytesPerPixel; k++)
-			{
-				tgaimage->data[i * bytesPerPixel + k] = colorMap[(firstEntryIndex + data[i]) * bytesPerPixel + k];
-			}
-		}
-
-		// Freeing data.
+		return GLUS_TRUE;
+	}
 
-		glusMemoryFree(data);
-		data = 0;
+	result = glusImageDecodeTga(&binaryfile, tgaimage, 0);
 
-		glusMemoryFree(colorMap);
-		colorMap = 0;
-	}
+	glusFileDestroyBinary(&binaryfile);
 
-	return GLUS_TRUE;
+	return result;
 }
 
 GLUSboolean GLUSAPIENTRY glusImageSaveTga(const GLUSchar* filename, const GLUStgaimage* tgaimage)
@@ -0,0 +1,17 @@
+#version 410 core
+
+uniform mat4 u_projectionMatrix;
+uniform mat4 u_viewMatrix;
+
+// Lines are already transformed into world space.
+in vec3 a_vertex;
+in vec4 a_color;
+
+out vec4 v_color;
+
+void main(void)
+{
+	v_color = a_color;
+
+	gl_Position = u_projectionMatrix * u_viewMatrix * vec4(a_vertex, 1.0);
+}
@@ -1,13 +1,13 @@
 #version 410 core
 
 uniform sampler2D u_fontTexture;
-uniform vec4 u_fontColor;
 
 in vec2 v_texCoord;
+in vec4 v_color;
 
 layout(location = 0, index = 0) out vec4 fragColor;
 
 void main(void)
 {
-	fragColor = texture(u_fontTexture, v_texCoord) * u_fontColor;
+	fragColor = texture(u_fontTexture, v_texCoord) * v_color;
 }
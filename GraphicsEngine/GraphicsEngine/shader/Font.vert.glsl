@@ -2,21 +2,19 @@
 
 uniform mat4 u_projectionMatrix;
 uniform mat4 u_viewMatrix;
-uniform mat4 u_modelMatrix;
 
-uniform float u_fontLeft;
-uniform float u_fontTop;
-uniform float u_fontWidth;
-uniform float u_fontHeight;
-
-in vec4 a_vertex;
+// Glyph quads are already positioned in the space of the orthographic camera.
+in vec2 a_vertex;
 in vec2 a_texCoord;
+in vec4 a_color;
 
 out vec2 v_texCoord;
+out vec4 v_color;
 
 void main(void)
 {
-	v_texCoord = vec2(u_fontLeft + u_fontWidth * a_texCoord.s, u_fontTop + u_fontHeight * a_texCoord.t);
+	v_texCoord = a_texCoord;
+	v_color = a_color;
 
-	gl_Position = u_projectionMatrix * u_viewMatrix * u_modelMatrix * a_vertex;
+	gl_Position = u_projectionMatrix * u_viewMatrix * vec4(a_vertex, 0.0, 1.0);
 }
@@ -4,27 +4,7 @@ layout(triangles) in;
 
 layout(triangle_strip, max_vertices = 3) out;
 
-struct MaterialProperties
-{
-	vec4 emissiveColor;
-	vec4 ambientColor;
-	vec4 diffuseColor;
-	sampler2D diffuseTexture; 
-	vec4 specularColor;
-	sampler2D specularTexture; 
-	float shininess;
-	
-	sampler2D normalMapTexture;
-	
-	vec4 reflectionColor;
-	vec4 refractionColor;
-	
-	float transparency;
-	
-	samplerCube dynamicCubeMapTexture;
-};
-
-uniform	MaterialProperties u_material;
+uniform sampler2D u_normalMapTexture;
 
 uniform mat4 u_projectionMatrix;
 uniform mat4 u_viewMatrix;
@@ -57,7 +37,7 @@ void main(void)
 		v_normal = u_normalModelMatrix * v_g_normal[i];
 		v_texCoord = v_g_texCoord[i];
 		
-		float displacementOffset = texture(u_material.normalMapTexture, v_texCoord).a * u_displacementScale;
+		float displacementOffset = texture(u_normalMapTexture, v_texCoord).a * u_displacementScale;
 		vec4 displacement = vec4(normalize(v_g_normal[i]) * displacementOffset, 0.0);
 
 		v_vertex = u_modelMatrix * (gl_in[i].gl_Position + displacement);
@@ -4,32 +4,15 @@ layout(triangles, invocations = 6) in;
 
 layout(triangle_strip, max_vertices = 3) out;
 
-struct MaterialProperties
-{
-	vec4 emissiveColor;
-	vec4 ambientColor;
-	vec4 diffuseColor;
-	sampler2D diffuseTexture; 
-	vec4 specularColor;
-	sampler2D specularTexture; 
-	float shininess;
-	
-	sampler2D normalMapTexture;
-	
-	vec4 reflectionColor;
-	vec4 refractionColor;
-	
-	float transparency;
-	
-	samplerCube dynamicCubeMapTexture;
-};
-
 #define NUMBER_FACES 6
 
 uniform mat4 u_cubeMapProjectionMatrix;
 uniform mat4 u_cubeMapViewMatrix[NUMBER_FACES];
 
-uniform	MaterialProperties u_material;
+// Faces, which are not updated this frame, are skipped.
+uniform int u_cubeMapFaceMask;
+
+uniform sampler2D u_normalMapTexture;
 
 uniform	int u_numberLights;
 
@@ -53,6 +36,11 @@ out vec2 v_texCoord;
 
 void main(void)
 {
+	if ((u_cubeMapFaceMask & (1 << gl_InvocationID)) == 0)
+	{
+		return;
+	}
+
     gl_Layer = gl_InvocationID;
 
 	mat4 faceMatrix = u_cubeMapProjectionMatrix * u_cubeMapViewMatrix[gl_InvocationID];
@@ -126,7 +114,7 @@ void main(void)
 		v_normal = u_normalModelMatrix * v_g_normal[i];
 		v_texCoord = v_g_texCoord[i];
 		
-		float displacementOffset = texture(u_material.normalMapTexture, v_texCoord).a * u_displacementScale;
+		float displacementOffset = texture(u_normalMapTexture, v_texCoord).a * u_displacementScale;
 		vec4 displacement = vec4(normalize(v_g_normal[i]) * displacementOffset, 0.0);
 
 		v_vertex = u_modelMatrix * (gl_in[i].gl_Position + displacement);
@@ -25,25 +25,17 @@ struct LightProperties
 	float spotCosCutOffOuter;
 };
 
-struct MaterialProperties
+layout(std140) uniform MaterialBlock
 {
 	vec4 emissiveColor;
 	vec4 ambientColor;
 	vec4 diffuseColor;
-	sampler2D diffuseTexture; 
 	vec4 specularColor;
-	sampler2D specularTexture; 
-	float shininess;
-	
-	sampler2D normalMapTexture;
-	
 	vec4 reflectionColor;
 	vec4 refractionColor;
-	
+	float shininess;
 	float transparency;
-	
-	samplerCube dynamicCubeMapTexture;
-};
+} u_material;
 
 uniform mat4 u_projectionMatrix;
 uniform mat4 u_viewMatrix;
@@ -52,7 +44,18 @@ uniform	vec4 u_ambientLightColor;
 
 uniform	LightProperties u_light[MAX_LIGHTS];
 
-uniform	MaterialProperties u_material;
+uniform sampler2D u_diffuseTexture;
+uniform sampler2D u_specularTexture;
+uniform sampler2D u_normalMapTexture;
+uniform samplerCube u_dynamicCubeMapTexture;
+
+// Diffuse, specular and normal map texture packed into texture arrays. Layer is negative, if not packed.
+uniform sampler2DArray u_diffusePackedTexture;
+uniform sampler2DArray u_specularPackedTexture;
+uniform sampler2DArray u_normalMapPackedTexture;
+uniform int u_packedLayer[3];
+// Offset in xy and scale in zw of the region in the layer.
+uniform vec4 u_packedRegion[3];
 
 uniform	float u_eta;
 uniform	float u_reflectanceNormalIncidence;
@@ -90,20 +93,42 @@ in vec2 v_texCoord;
 layout(location = 0, index = 0) out vec4 fragColor;
 layout(location = 1, index = 0) out vec4 brightColor;
 
+vec4 texturePacked(sampler2DArray packedTexture, int index, vec2 texCoord)
+{
+	vec4 region = u_packedRegion[index];
+
+	// Gradients of the unwrapped coordinates avoid selecting the smallest mip level at the wrap seams.
+	return textureGrad(packedTexture, vec3(region.xy + fract(texCoord) * region.zw, float(u_packedLayer[index])), dFdx(texCoord) * region.zw, dFdy(texCoord) * region.zw);
+}
+
 void main(void)
 {
 	vec4 diffuseTexture = vec4(1.0, 1.0, 1.0, 1.0);
 
 	if (u_hasDiffuseTexture != 0)
 	{
- 		diffuseTexture = texture(u_material.diffuseTexture, v_texCoord);
+		if (u_packedLayer[0] >= 0)
+		{
+			diffuseTexture = texturePacked(u_diffusePackedTexture, 0, v_texCoord);
+		}
+		else
+		{
+			diffuseTexture = texture(u_diffuseTexture, v_texCoord);
+		}
  	}
 
 	vec4 specularTexture = vec4(1.0, 1.0, 1.0, 1.0);
 
 	if (u_hasSpecularTexture != 0)
 	{
- 		specularTexture = texture(u_material.specularTexture, v_texCoord);
+		if (u_packedLayer[1] >= 0)
+		{
+			specularTexture = texturePacked(u_specularPackedTexture, 1, v_texCoord);
+		}
+		else
+		{
+			specularTexture = texture(u_specularTexture, v_texCoord);
+		}
  	}
 
 	vec3 normal;
@@ -113,7 +138,16 @@ void main(void)
 	}
 	else
 	{
-		vec3 normalTextureSpace = normalize(texture(u_material.normalMapTexture, v_texCoord).xyz * 2.0 - 1.0);
+		vec4 normalMapTexture;
+		if (u_packedLayer[2] >= 0)
+		{
+			normalMapTexture = texturePacked(u_normalMapPackedTexture, 2, v_texCoord);
+		}
+		else
+		{
+			normalMapTexture = texture(u_normalMapTexture, v_texCoord);
+		}
+		vec3 normalTextureSpace = normalize(normalMapTexture.xyz * 2.0 - 1.0);
 		mat3 textureToWorldSpace = mat3(normalize(v_tangent), normalize(v_bitangent), normalize(v_normal));	
 		vec3 normalDX = textureToWorldSpace * normalTextureSpace;
 		if (u_convertDirectX != 0)
@@ -244,7 +278,7 @@ void main(void)
 		
 		if (u_hasDynamicCubeMapTexture != 0)
 		{
-			vec4 temp = texture(u_material.dynamicCubeMapTexture, reflection);
+			vec4 temp = texture(u_dynamicCubeMapTexture, reflection);
 		
 			if (temp.a > 0.0)
 			{
@@ -262,7 +296,7 @@ void main(void)
 
 			if (u_hasDynamicCubeMapTexture != 0)
 			{
-				vec4 temp = texture(u_material.dynamicCubeMapTexture, refraction);
+				vec4 temp = texture(u_dynamicCubeMapTexture, refraction);
 			
 				if (temp.a > 0.0)
 				{		
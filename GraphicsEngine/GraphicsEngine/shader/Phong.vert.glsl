@@ -3,8 +3,10 @@
 #define MAX_SKIN_INDICES 8
 #define MAX_MATRICES 64
 
+#ifndef RENDER_TO_CUBEMAP
 uniform mat4 u_projectionMatrix;
 uniform mat4 u_viewMatrix;
+#endif
 uniform mat4 u_modelMatrix;
 uniform mat3 u_normalModelMatrix;
 
@@ -14,6 +16,8 @@ uniform mat4 u_inverseBindMatrix[MAX_MATRICES];
 uniform mat3 u_inverseBindNormalMatrix[MAX_MATRICES];
 
 uniform int u_hasSkinning;
+uniform int u_hasInstancing;
+uniform int u_hasOctahedralNormals;
 uniform	int u_hasDiffuseTexture;
 uniform	int u_hasNormalMapTexture;
 
@@ -31,14 +35,49 @@ in vec4 a_boneWeight_0;
 in vec4 a_boneWeight_1;
 in float a_boneCounter;
 
+in mat4 a_instanceModelMatrix;
+
+#ifdef RENDER_TO_CUBEMAP
+// The geometry shader emits the primitives for all cube map faces.
+#define v_vertex v_g_vertex
+#define v_normal v_g_normal
+#define v_bitangent v_g_bitangent
+#define v_tangent v_g_tangent
+#define v_texCoord v_g_texCoord
+#endif
+
 out vec4 v_vertex;
 out vec3 v_normal;
 out vec3 v_bitangent;
 out vec3 v_tangent;
 out vec2 v_texCoord;
 
+vec3 decodeOctahedral(vec2 encoded)
+{
+	vec3 result = vec3(encoded, 1.0 - abs(encoded.x) - abs(encoded.y));
+
+	if (result.z < 0.0)
+	{
+		result.xy = (1.0 - abs(result.yx)) * vec2(result.x >= 0.0 ? 1.0 : -1.0, result.y >= 0.0 ? 1.0 : -1.0);
+	}
+
+	return normalize(result);
+}
+
 void main(void)
 {
+	vec3 inNormal = a_normal;
+	vec3 inBitangent = a_bitangent;
+	vec3 inTangent = a_tangent;
+
+	// Packed meshes deliver the octahedral encoded vectors as unscaled shorts.
+	if (u_hasOctahedralNormals != 0)
+	{
+		inNormal = decodeOctahedral(a_normal.xy / 32767.0);
+		inBitangent = decodeOctahedral(a_bitangent.xy / 32767.0);
+		inTangent = decodeOctahedral(a_tangent.xy / 32767.0);
+	}
+
 	vec4 vertex = vec4(0.0);
 	vec3 normal = vec3(0.0);
 	vec3 bitangent = vec3(0.0);
@@ -52,12 +91,12 @@ void main(void)
 	if (u_hasSkinning == 0)
 	{
 		vertex = a_vertex;
-		normal = a_normal;
+		normal = inNormal;
 		
 		if (u_hasNormalMapTexture != 0)
 		{
-			bitangent = a_bitangent;
-			tangent = a_tangent;
+			bitangent = inBitangent;
+			tangent = inTangent;
 		}
 	}
 	else
@@ -67,12 +106,12 @@ void main(void)
 		if (boneCounter == 0)
 		{
 			vertex = a_vertex;
-			normal = a_normal;
+			normal = inNormal;
 			
 			if (u_hasNormalMapTexture != 0)
 			{
-				bitangent = a_bitangent;
-				tangent = a_tangent;
+				bitangent = inBitangent;
+				tangent = inTangent;
 			}
 		}
 		else
@@ -92,25 +131,34 @@ void main(void)
 				
 				vertex += (u_bindMatrix[currentBone] * u_inverseBindMatrix[currentBone] * a_vertex) * currentWeight;
 				
-				normal += (u_bindNormalMatrix[currentBone] * u_inverseBindNormalMatrix[currentBone] * a_normal) * currentWeight;
+				normal += (u_bindNormalMatrix[currentBone] * u_inverseBindNormalMatrix[currentBone] * inNormal) * currentWeight;
 
 				if (u_hasNormalMapTexture != 0)
 				{
-					bitangent += (u_bindNormalMatrix[currentBone] * u_inverseBindNormalMatrix[currentBone] * a_bitangent) * currentWeight;
-					tangent += (u_bindNormalMatrix[currentBone] * u_inverseBindNormalMatrix[currentBone] * a_tangent) * currentWeight;
+					bitangent += (u_bindNormalMatrix[currentBone] * u_inverseBindNormalMatrix[currentBone] * inBitangent) * currentWeight;
+					tangent += (u_bindNormalMatrix[currentBone] * u_inverseBindNormalMatrix[currentBone] * inTangent) * currentWeight;
 				}
 			}
 		}
 	}
 
-	v_vertex = u_modelMatrix * vertex;
+	mat4 modelMatrix = u_modelMatrix;
+	mat3 normalModelMatrix = u_normalModelMatrix;
+
+	if (u_hasInstancing != 0)
+	{
+		modelMatrix = a_instanceModelMatrix;
+		normalModelMatrix = transpose(inverse(mat3(a_instanceModelMatrix)));
+	}
+
+	v_vertex = modelMatrix * vertex;
 
-	v_normal = u_normalModelMatrix * normal;
+	v_normal = normalModelMatrix * normal;
 	
 	if (u_hasNormalMapTexture != 0)
 	{
-		v_bitangent = u_normalModelMatrix * bitangent;
-		v_tangent = u_normalModelMatrix * tangent;
+		v_bitangent = normalModelMatrix * bitangent;
+		v_tangent = normalModelMatrix * tangent;
 	}
 	
 	if (u_hasDiffuseTexture != 0 || u_hasNormalMapTexture != 0)
@@ -118,5 +166,9 @@ void main(void)
 		v_texCoord = a_texCoord;
 	}
 	
+#ifdef RENDER_TO_CUBEMAP
+	gl_Position = v_vertex;
+#else
 	gl_Position = u_projectionMatrix * u_viewMatrix * v_vertex;	
+#endif
 }
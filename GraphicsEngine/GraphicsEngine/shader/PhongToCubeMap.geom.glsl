@@ -9,6 +9,9 @@ layout(triangle_strip, max_vertices = 3) out;
 uniform mat4 u_cubeMapProjectionMatrix;
 uniform mat4 u_cubeMapViewMatrix[NUMBER_FACES];
 
+// Faces, which are not updated this frame, are skipped.
+uniform int u_cubeMapFaceMask;
+
 uniform	int u_numberLights;
 
 in vec4 v_g_vertex[];
@@ -25,6 +28,11 @@ out vec2 v_texCoord;
 
 void main(void)
 {
+	if ((u_cubeMapFaceMask & (1 << gl_InvocationID)) == 0)
+	{
+		return;
+	}
+
     gl_Layer = gl_InvocationID;
 
 	mat4 faceMatrix = u_cubeMapProjectionMatrix * u_cubeMapViewMatrix[gl_InvocationID];
@@ -22,32 +22,35 @@ struct LightProperties
 	float spotCosCutOffOuter;
 };
 
-struct MaterialProperties
+layout(std140) uniform MaterialBlock
 {
 	vec4 emissiveColor;
 	vec4 ambientColor;
 	vec4 diffuseColor;
-	sampler2D diffuseTexture; 
 	vec4 specularColor;
-	sampler2D specularTexture; 
-	float shininess;
-	
-	sampler2D normalMapTexture;
-	
 	vec4 reflectionColor;
 	vec4 refractionColor;
-	
+	float shininess;
 	float transparency;
-	
-	samplerCube dynamicCubeMapTexture;
-};
+} u_material;
 
 uniform	vec4 u_ambientLightColor;
 
 
 uniform	LightProperties u_light[MAX_LIGHTS];
 
-uniform	MaterialProperties u_material;
+uniform sampler2D u_diffuseTexture;
+uniform sampler2D u_specularTexture;
+uniform sampler2D u_normalMapTexture;
+uniform samplerCube u_dynamicCubeMapTexture;
+
+// Diffuse, specular and normal map texture packed into texture arrays. Layer is negative, if not packed.
+uniform sampler2DArray u_diffusePackedTexture;
+uniform sampler2DArray u_specularPackedTexture;
+uniform sampler2DArray u_normalMapPackedTexture;
+uniform int u_packedLayer[3];
+// Offset in xy and scale in zw of the region in the layer.
+uniform vec4 u_packedRegion[3];
 
 uniform	float u_eta;
 uniform	float u_reflectanceNormalIncidence;
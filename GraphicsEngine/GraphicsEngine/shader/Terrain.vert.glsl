@@ -0,0 +1,55 @@
+#version 410 core
+
+uniform mat4 u_modelMatrix;
+
+uniform vec4 u_eyePosition;
+
+uniform	float u_repeat;
+
+// Offset and size of the tile in the texture space of the ground and the number of grid cells per side.
+uniform vec4 u_terrainTile;
+
+// Distances, where the tile starts and ends to morph into the next coarser level.
+uniform vec2 u_terrainMorph;
+
+in vec4 a_vertex;
+in vec3 a_tangent;
+in vec3 a_bitangent;
+in vec3 a_normal;
+in vec2 a_texCoord;
+
+out vec4 v_c_vertex;
+out vec3 v_c_tangent;
+out vec3 v_c_bitangent;
+out vec3 v_c_normal;
+out vec2 v_c_texCoord;
+
+vec4 groundVertex(in vec2 gridPosition)
+{
+	vec2 groundTexCoord = u_terrainTile.xy + gridPosition / u_terrainTile.w * u_terrainTile.z;
+
+	return vec4(groundTexCoord - 0.5, a_vertex.z, a_vertex.w);
+}
+
+void main(void)
+{
+	// The texture coordinate of the tile mesh is the normalized grid position.
+	vec2 gridPosition = floor(a_texCoord * u_terrainTile.w + 0.5);
+
+	float eyeDistance = distance(u_modelMatrix * groundVertex(gridPosition), u_eyePosition);
+
+	float morph = clamp((eyeDistance - u_terrainMorph.x) / max(u_terrainMorph.y - u_terrainMorph.x, 0.0001), 0.0, 1.0);
+
+	// Odd vertices move onto the edges of the next coarser grid.
+	gridPosition -= fract(gridPosition * 0.5) * 2.0 * morph;
+
+	vec4 vertex = groundVertex(gridPosition);
+
+	v_c_vertex = vertex;
+	v_c_tangent = a_tangent;
+	v_c_bitangent = a_bitangent;
+	v_c_normal = a_normal;
+	v_c_texCoord = (vertex.xy + 0.5) * u_repeat;
+
+	gl_Position = vertex;
+}
@@ -78,6 +78,15 @@ GLUSboolean updateEngine(GLUSfloat deltaTime)
 {
 	User::defaultUser.update(deltaTime);
 
+	// Does nothing, if the file watcher is not started.
+	HotReloadManager::getInstance()->update();
+
+	// Hands the textures decoded by the workers to the GL.
+	TextureUploadManager::getInstance()->update();
+
+	// Processes the resolutions requested while rendering the last frame.
+	TextureStreamingManager::getInstance()->update();
+
 	return GLUS_TRUE;
 }
 
@@ -102,21 +111,33 @@ GLUSvoid terminateEngine(GLUSvoid)
 	FrameBuffer2DMultisampleManager::terminate();
 	FrameBufferCubeMapManager::terminate();
 	EntityCommandManager::terminate();
+	// Rasterizes on the workers, so it has to be terminated before them.
+	OcclusionCullingManager::terminate();
+	// Owns a buffer, so it has to be terminated while the context is alive.
+	RenderQueue::terminate();
 
 	CameraManager::terminate();
 	ViewportManager::terminate();
 	LightManager::terminate();
+	DebugLineRenderer::terminate();
 	LineGeometryManager::terminate();
 	EventManager::terminate();
+	// Stops the file watcher thread and reloads no more textures.
+	HotReloadManager::terminate();
+	// Waits for the decoding textures, so it has to be terminated before the workers.
+	TextureUploadManager::terminate();
 	WorkerManager::terminate();
 
 	RenderBufferManager::terminate();
 	RenderBufferMultisampleManager::terminate();
 	Texture1DManager::terminate();
 	Texture1DArrayManager::terminate();
+	TextureStreamingManager::terminate();
 	Texture2DManager::terminate();
 	Texture2DArrayManager::terminate();
 	Texture2DMultisampleManager::terminate();
 	TextureCubeMapManager::terminate();
+	RenderStateCache::terminate();
 	ProgramManager::terminate();
+	ProgramCache::terminate();
 }
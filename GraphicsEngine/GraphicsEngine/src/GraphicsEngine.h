@@ -23,17 +23,25 @@
 #include "layer1/renderbuffer/RenderBufferMultisample.h"
 #include "layer1/renderbuffer/RenderBufferMultisampleManager.h"
 #include "layer1/shader/Program.h"
+#include "layer1/shader/ProgramCache.h"
 #include "layer1/shader/ProgramFactory.h"
 #include "layer1/shader/ProgramManager.h"
+#include "layer1/shader/RenderStateCache.h"
+#include "layer1/shader/ShaderPreprocessor.h"
 #include "layer1/texture/Texture1DManager.h"
 #include "layer1/texture/Texture1DArrayManager.h"
 #include "layer1/texture/Texture2DManager.h"
 #include "layer1/texture/Texture2DArrayManager.h"
 #include "layer1/texture/Texture2DMultisampleManager.h"
 #include "layer1/texture/TextureCubeMapManager.h"
+#include "layer1/texture/TextureCompressor.h"
+#include "layer1/texture/TextureContainer.h"
 #include "layer1/texture/TextureFactory.h"
+#include "layer1/texture/TextureStreamingManager.h"
+#include "layer1/texture/TextureUploadManager.h"
 #include "layer2/debug/DebugDraw.h"
 #include "layer2/debug/DebugDrawFactory.h"
+#include "layer2/debug/DebugLineRenderer.h"
 #include "layer2/debug/GroundPlane.h"
 #include "layer2/debug/LineGeometryManager.h"
 #include "layer2/environment/SkyDome.h"
@@ -62,6 +70,9 @@
 #include "layer3/light/LightManager.h"
 #include "layer3/light/PointLight.h"
 #include "layer3/light/SpotLight.h"
+#include "layer3/mesh/StaticBatchBuilder.h"
+#include "layer3/occlusion/OccluderFactory.h"
+#include "layer3/terrain/TerrainQuadtree.h"
 #include "layer4/entity/EntityList.h"
 #include "layer4/font/Font.h"
 #include "layer4/font/FontFactory.h"
@@ -77,8 +88,12 @@
 #include "layer5/command/EntityCommandManager.h"
 #include "layer5/debug/FpsPrinter.h"
 #include "layer5/environment/DynamicEnvironmentManager.h"
+#include "layer5/occlusion/OcclusionCullingManager.h"
+#include "layer5/render/RenderQueue.h"
+#include "layer6/bvh/BoundingVolumeHierarchyFactory.h"
 #include "layer6/octree/OctreeFactory.h"
 #include "layer6/model/ModelManager.h"
+#include "layer6/reload/HotReloadManager.h"
 #include "layer7/entity/GeneralEntityManager.h"
 #include "layer8/groundentity/GroundEntity.h"
 #include "layer8/path/CirclePath.h"
@@ -87,6 +102,7 @@
 #include "layer8/path/PathEntityManager.h"
 #include "layer8/path/OrientedCirclePath.h"
 #include "layer8/path/OrientedLinePath.h"
+#include "layer8/staticbatchentity/StaticBatchEntity.h"
 #include "layer9/camerafactory/CameraEntityFactory.h"
 #ifndef GE_NO_FBX
 #include "layer9/fbxfactory/FbxEntityFactory.h"
@@ -0,0 +1,120 @@
+/*
+ * RadixSort.h
+ *
+ *  Created on: 19.10.2026
+ *      Author: nopper
+ */
+#ifndef RADIXSORT_H_
+#define RADIXSORT_H_
+
+#include "../../UsedLibs.h"
+
+/**
+ * Stable least significant digit radix sort of 64 bit keys, which also reorders an attached index per key.
+ * Passes, where all keys have the same digit, are skipped. The scratch buffers are kept between calls.
+ */
+class RadixSort
+{
+
+private:
+
+	static const std::uint32_t RADIX_BITS = 8;
+
+	static const std::uint32_t RADIX_SIZE = 1 << RADIX_BITS;
+
+	std::vector<std::uint64_t> scratchKeys;
+
+	std::vector<std::uint32_t> scratchValues;
+
+	std::uint32_t histogram[sizeof(std::uint64_t)][RADIX_SIZE];
+
+public:
+
+	RadixSort() :
+		scratchKeys(), scratchValues()
+	{
+	}
+
+	~RadixSort()
+	{
+	}
+
+	void sort(std::vector<std::uint64_t>& keys, std::vector<std::uint32_t>& values)
+	{
+		assert(keys.size() == values.size());
+
+		std::uint32_t numberElements = static_cast<std::uint32_t>(keys.size());
+
+		if (numberElements < 2)
+		{
+			return;
+		}
+
+		scratchKeys.resize(numberElements);
+		scratchValues.resize(numberElements);
+
+		// Build all histograms with one pass over the keys.
+		for (std::uint32_t pass = 0; pass < sizeof(std::uint64_t); pass++)
+		{
+			for (std::uint32_t digit = 0; digit < RADIX_SIZE; digit++)
+			{
+				histogram[pass][digit] = 0;
+			}
+		}
+
+		for (std::uint32_t i = 0; i < numberElements; i++)
+		{
+			std::uint64_t key = keys[i];
+
+			for (std::uint32_t pass = 0; pass < sizeof(std::uint64_t); pass++)
+			{
+				histogram[pass][(key >> (pass * RADIX_BITS)) & (RADIX_SIZE - 1)]++;
+			}
+		}
+
+		std::uint64_t* sourceKeys = keys.data();
+		std::uint32_t* sourceValues = values.data();
+		std::uint64_t* targetKeys = scratchKeys.data();
+		std::uint32_t* targetValues = scratchValues.data();
+
+		for (std::uint32_t pass = 0; pass < sizeof(std::uint64_t); pass++)
+		{
+			std::uint32_t shift = pass * RADIX_BITS;
+
+			// All keys share this digit, so the pass would not change the order.
+			if (histogram[pass][(sourceKeys[0] >> shift) & (RADIX_SIZE - 1)] == numberElements)
+			{
+				continue;
+			}
+
+			std::uint32_t offset = 0;
+			for (std::uint32_t digit = 0; digit < RADIX_SIZE; digit++)
+			{
+				std::uint32_t count = histogram[pass][digit];
+				histogram[pass][digit] = offset;
+				offset += count;
+			}
+
+			for (std::uint32_t i = 0; i < numberElements; i++)
+			{
+				std::uint32_t target = histogram[pass][(sourceKeys[i] >> shift) & (RADIX_SIZE - 1)]++;
+
+				targetKeys[target] = sourceKeys[i];
+				targetValues[target] = sourceValues[i];
+			}
+
+			std::swap(sourceKeys, targetKeys);
+			std::swap(sourceValues, targetValues);
+		}
+
+		// Odd number of executed passes: result is in the scratch buffers.
+		if (sourceKeys != keys.data())
+		{
+			keys.swap(scratchKeys);
+			values.swap(scratchValues);
+		}
+	}
+
+};
+
+#endif /* RADIXSORT_H_ */
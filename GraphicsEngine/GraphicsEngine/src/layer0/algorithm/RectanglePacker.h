@@ -0,0 +1,216 @@
+/*
+ * RectanglePacker.h
+ *
+ *  Created on: 19.10.2026
+ *      Author: nopper
+ */
+#ifndef RECTANGLEPACKER_H_
+#define RECTANGLEPACKER_H_
+
+#include "../../UsedLibs.h"
+
+/**
+ * Packs rectangles into a bin using the skyline bottom left heuristic. The upper border of the used area is stored as
+ * horizontal segments, so a rectangle is placed on the segment, where its top is the lowest. Best results are achieved,
+ * if the rectangles are inserted sorted by descending height.
+ */
+class RectanglePacker
+{
+
+private:
+
+	struct SkylineSegment
+	{
+		std::int32_t x;
+		std::int32_t y;
+		std::int32_t width;
+	};
+
+	std::int32_t width;
+	std::int32_t height;
+
+	std::vector<SkylineSegment> allSegments;
+
+	std::uint64_t usedArea;
+
+	/**
+	 * @return The y coordinate, where the rectangle rests on the skyline starting at the given segment or -1, if it does not fit.
+	 */
+	std::int32_t fit(std::uint32_t index, std::int32_t rectWidth, std::int32_t rectHeight) const
+	{
+		std::int32_t x = allSegments[index].x;
+
+		if (x + rectWidth > width)
+		{
+			return -1;
+		}
+
+		std::int32_t y = 0;
+		std::int32_t remainingWidth = rectWidth;
+
+		while (remainingWidth > 0)
+		{
+			y = std::max(y, allSegments[index].y);
+
+			if (y + rectHeight > height)
+			{
+				return -1;
+			}
+
+			remainingWidth -= allSegments[index].width;
+
+			index++;
+		}
+
+		return y;
+	}
+
+	void addSegment(std::uint32_t index, std::int32_t x, std::int32_t y, std::int32_t segmentWidth)
+	{
+		SkylineSegment segment = {x, y, segmentWidth};
+
+		allSegments.insert(allSegments.begin() + index, segment);
+
+		// Shrink or remove the segments now covered by the new one.
+		std::uint32_t i = index + 1;
+
+		while (i < allSegments.size())
+		{
+			SkylineSegment& previous = allSegments[i - 1];
+			SkylineSegment& current = allSegments[i];
+
+			if (current.x >= previous.x + previous.width)
+			{
+				break;
+			}
+
+			std::int32_t shrink = previous.x + previous.width - current.x;
+
+			current.x += shrink;
+			current.width -= shrink;
+
+			if (current.width > 0)
+			{
+				break;
+			}
+
+			allSegments.erase(allSegments.begin() + i);
+		}
+
+		// Merge neighbors on the same level.
+		i = 1;
+
+		while (i < allSegments.size())
+		{
+			if (allSegments[i - 1].y == allSegments[i].y)
+			{
+				allSegments[i - 1].width += allSegments[i].width;
+
+				allSegments.erase(allSegments.begin() + i);
+			}
+			else
+			{
+				i++;
+			}
+		}
+	}
+
+public:
+
+	RectanglePacker(std::int32_t width, std::int32_t height) :
+		width(width), height(height), allSegments(), usedArea(0)
+	{
+		reset();
+	}
+
+	~RectanglePacker()
+	{
+	}
+
+	void reset()
+	{
+		allSegments.clear();
+
+		SkylineSegment segment = {0, 0, width};
+
+		allSegments.push_back(segment);
+
+		usedArea = 0;
+	}
+
+	/**
+	 * @param x Receives the left position of the placed rectangle.
+	 * @param y Receives the bottom position of the placed rectangle.
+	 *
+	 * @return False, if the rectangle does not fit anymore.
+	 */
+	bool insert(std::int32_t rectWidth, std::int32_t rectHeight, std::int32_t& x, std::int32_t& y)
+	{
+		if (rectWidth <= 0 || rectHeight <= 0)
+		{
+			return false;
+		}
+
+		std::int32_t bestIndex = -1;
+		std::int32_t bestTop = height + 1;
+		std::int32_t bestWidth = width + 1;
+
+		for (std::uint32_t index = 0; index < allSegments.size(); index++)
+		{
+			std::int32_t currentY = fit(index, rectWidth, rectHeight);
+
+			if (currentY < 0)
+			{
+				continue;
+			}
+
+			// Lowest top first, then the narrowest segment to keep wide gaps for wide rectangles.
+			if (currentY + rectHeight < bestTop || (currentY + rectHeight == bestTop && allSegments[index].width < bestWidth))
+			{
+				bestIndex = static_cast<std::int32_t>(index);
+				bestTop = currentY + rectHeight;
+				bestWidth = allSegments[index].width;
+
+				x = allSegments[index].x;
+				y = currentY;
+			}
+		}
+
+		if (bestIndex < 0)
+		{
+			return false;
+		}
+
+		addSegment(static_cast<std::uint32_t>(bestIndex), x, y + rectHeight, rectWidth);
+
+		usedArea += static_cast<std::uint64_t>(rectWidth) * static_cast<std::uint64_t>(rectHeight);
+
+		return true;
+	}
+
+	std::int32_t getWidth() const
+	{
+		return width;
+	}
+
+	std::int32_t getHeight() const
+	{
+		return height;
+	}
+
+	/**
+	 * @return Ratio of the area covered by rectangles to the area of the bin.
+	 */
+	float getOccupancy() const
+	{
+		if (width <= 0 || height <= 0)
+		{
+			return 0.0f;
+		}
+
+		return static_cast<float>(usedArea) / (static_cast<float>(width) * static_cast<float>(height));
+	}
+
+};
+
+#endif /* RECTANGLEPACKER_H_ */
@@ -20,6 +20,21 @@ public:
 
 	static bool create(const std::string& name);
 
+	/**
+	 * Lists the files and sub directories of the directory. The names are prefixed with the directory.
+	 *
+	 * @param recursive If set, the sub directories are scanned as well.
+	 */
+	static bool scan(const std::string& name, std::vector<std::string>& allFilenames, std::vector<std::string>& allDirectories, bool recursive);
+
+	/**
+	 * Absolute name of an existing file or directory with all links and relative parts resolved, so equal files can be
+	 * compared by name.
+	 *
+	 * @return Empty, if the file does not exist.
+	 */
+	static std::string getCanonicalName(const std::string& name);
+
 };
 
 #endif /* DIRECTORY_H_ */
@@ -5,6 +5,9 @@
  *      Author: nopper
  */
 
+#include <dirent.h>
+#include <limits.h>
+#include <stdlib.h>
 #include <sys/stat.h>
 
 #include "Directory.h"
@@ -23,3 +26,72 @@ bool Directory::create(const string& name)
 {
 	return mkdir(name.c_str(), 0777) == 0;
 }
+
+bool Directory::scan(const string& name, vector<string>& allFilenames, vector<string>& allDirectories, bool recursive)
+{
+	DIR* directory = opendir(name.c_str());
+
+	if (!directory)
+	{
+		return false;
+	}
+
+	vector<string> allSubDirectories;
+
+	struct dirent* entry = readdir(directory);
+	while (entry)
+	{
+		string entryName = entry->d_name;
+
+		entry = readdir(directory);
+
+		if (entryName == "." || entryName == "..")
+		{
+			continue;
+		}
+
+		string fullName = name + "/" + entryName;
+
+		struct stat entryStatus;
+
+		if (stat(fullName.c_str(), &entryStatus) != 0)
+		{
+			continue;
+		}
+
+		if (S_ISDIR(entryStatus.st_mode))
+		{
+			allDirectories.push_back(fullName);
+
+			allSubDirectories.push_back(fullName);
+		}
+		else if (S_ISREG(entryStatus.st_mode))
+		{
+			allFilenames.push_back(fullName);
+		}
+	}
+
+	closedir(directory);
+
+	if (recursive)
+	{
+		for (auto& currentSubDirectory : allSubDirectories)
+		{
+			scan(currentSubDirectory, allFilenames, allDirectories, recursive);
+		}
+	}
+
+	return true;
+}
+
+string Directory::getCanonicalName(const string& name)
+{
+	char buffer[PATH_MAX];
+
+	if (!realpath(name.c_str(), buffer))
+	{
+		return "";
+	}
+
+	return string(buffer);
+}
@@ -6,6 +6,8 @@
  */
 
 #include <direct.h>
+#include <io.h>
+#include <stdlib.h>
 
 #include "Directory.h"
 
@@ -23,3 +25,65 @@ bool Directory::create(const string& name)
 {
 	return _mkdir(name.c_str()) == 0;
 }
+
+bool Directory::scan(const string& name, vector<string>& allFilenames, vector<string>& allDirectories, bool recursive)
+{
+	struct _finddata_t entry;
+
+	intptr_t handle = _findfirst((name + "/*").c_str(), &entry);
+
+	if (handle == -1)
+	{
+		return false;
+	}
+
+	vector<string> allSubDirectories;
+
+	do
+	{
+		string entryName = entry.name;
+
+		if (entryName == "." || entryName == "..")
+		{
+			continue;
+		}
+
+		string fullName = name + "/" + entryName;
+
+		if (entry.attrib & _A_SUBDIR)
+		{
+			allDirectories.push_back(fullName);
+
+			allSubDirectories.push_back(fullName);
+		}
+		else
+		{
+			allFilenames.push_back(fullName);
+		}
+	}
+	while (_findnext(handle, &entry) == 0);
+
+	_findclose(handle);
+
+	if (recursive)
+	{
+		for (auto& currentSubDirectory : allSubDirectories)
+		{
+			scan(currentSubDirectory, allFilenames, allDirectories, recursive);
+		}
+	}
+
+	return true;
+}
+
+string Directory::getCanonicalName(const string& name)
+{
+	char buffer[_MAX_PATH];
+
+	if (!_fullpath(buffer, name.c_str(), _MAX_PATH) || _access(buffer, 0) != 0)
+	{
+		return "";
+	}
+
+	return string(buffer);
+}
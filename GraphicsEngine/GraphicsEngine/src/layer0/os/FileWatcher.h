@@ -0,0 +1,86 @@
+/*
+ * FileWatcher.h
+ *
+ *  Created on: 19.10.2026
+ *      Author: nopper
+ */
+
+#ifndef FILEWATCHER_H_
+#define FILEWATCHER_H_
+
+#include "../../UsedLibs.h"
+
+#include "../concurrency/ThreadsafeQueue.h"
+
+/**
+ * Watches directories including their sub directories on an own thread and reports the files, which have been written.
+ * A hash of the content of each file is kept, so files saved without a change or reported twice are skipped. Only
+ * supported on Linux, where inotify is used.
+ */
+class FileWatcher
+{
+
+private:
+
+	std::vector<std::string> allRootDirectories;
+
+	ThreadsafeQueue<std::string> allChangedFilenames;
+
+	std::thread* watchThread;
+
+	std::int32_t notifyDescriptor;
+
+	// Written to wake up and stop the watch thread.
+	std::int32_t wakeDescriptors[2];
+
+	// Only used by the watch thread, once it is started.
+	std::map<std::int32_t, std::string> allWatchedDirectories;
+	std::map<std::string, std::uint64_t> allContentHashes;
+
+	void run();
+
+	/**
+	 * Watches the directory and its sub directories and hashes all files.
+	 *
+	 * @param report If set, all files are reported as changed, e.g. for a directory created while watching.
+	 */
+	void watchDirectory(const std::string& name, bool report);
+
+	/**
+	 * @return True, if the content of the file differs from the last hashed one.
+	 */
+	bool updateContentHash(const std::string& filename);
+
+	static bool hashFile(const std::string& filename, std::uint64_t& value);
+
+public:
+
+	FileWatcher();
+	virtual ~FileWatcher();
+
+	/**
+	 * Has to be called before the watcher is started.
+	 */
+	void addDirectory(const std::string& name);
+
+	/**
+	 * Hashes all files of the directories and starts the watch thread.
+	 *
+	 * @return False, if watching is not supported or no directory could be watched.
+	 */
+	bool start();
+
+	void stop();
+
+	bool isRunning() const;
+
+	/**
+	 * Non blocking. The name is the watched directory followed by the path of the file.
+	 *
+	 * @return True, if a changed file was taken.
+	 */
+	bool takeChangedFilename(std::string& filename);
+
+};
+
+#endif /* FILEWATCHER_H_ */
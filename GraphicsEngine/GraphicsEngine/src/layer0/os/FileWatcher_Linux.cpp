@@ -0,0 +1,316 @@
+/*
+ * FileWatcher_Linux.cpp
+ *
+ *  Created on: 19.10.2026
+ *      Author: nopper
+ */
+
+#include <errno.h>
+#include <poll.h>
+#include <stdio.h>
+#include <sys/inotify.h>
+#include <unistd.h>
+
+#include "Directory.h"
+
+#include "FileWatcher.h"
+
+using namespace std;
+
+// Directories are watched for created sub directories, files for being written or moved in, e.g. by an editor saving to
+// a temporary file first.
+static const uint32_t WATCH_MASK = IN_CLOSE_WRITE | IN_MOVED_TO | IN_MOVED_FROM | IN_CREATE | IN_DELETE;
+
+FileWatcher::FileWatcher() :
+	allRootDirectories(), allChangedFilenames(), watchThread(nullptr), notifyDescriptor(-1), allWatchedDirectories(), allContentHashes()
+{
+	wakeDescriptors[0] = -1;
+	wakeDescriptors[1] = -1;
+}
+
+FileWatcher::~FileWatcher()
+{
+	stop();
+}
+
+void FileWatcher::run()
+{
+	glusLogPrint(GLUS_LOG_INFO, "File watcher thread started");
+
+	alignas(struct inotify_event) char buffer[4096];
+
+	struct pollfd allDescriptors[2];
+
+	allDescriptors[0].fd = notifyDescriptor;
+	allDescriptors[0].events = POLLIN;
+	allDescriptors[1].fd = wakeDescriptors[0];
+	allDescriptors[1].events = POLLIN;
+
+	while (true)
+	{
+		allDescriptors[0].revents = 0;
+		allDescriptors[1].revents = 0;
+
+		if (poll(allDescriptors, 2, -1) < 0)
+		{
+			if (errno == EINTR)
+			{
+				continue;
+			}
+
+			break;
+		}
+
+		if (allDescriptors[1].revents)
+		{
+			break;
+		}
+
+		if (!(allDescriptors[0].revents & POLLIN))
+		{
+			continue;
+		}
+
+		ssize_t length = read(notifyDescriptor, buffer, sizeof(buffer));
+
+		if (length <= 0)
+		{
+			if (length < 0 && errno == EINTR)
+			{
+				continue;
+			}
+
+			break;
+		}
+
+		const char* walker = buffer;
+		while (walker < buffer + length)
+		{
+			const struct inotify_event* event = reinterpret_cast<const struct inotify_event*>(walker);
+
+			walker += sizeof(struct inotify_event) + event->len;
+
+			if (event->mask & IN_Q_OVERFLOW)
+			{
+				glusLogPrint(GLUS_LOG_WARNING, "File watcher missed changes");
+
+				continue;
+			}
+
+			auto foundDirectory = allWatchedDirectories.find(event->wd);
+
+			if (foundDirectory == allWatchedDirectories.end())
+			{
+				continue;
+			}
+
+			if (event->mask & IN_IGNORED)
+			{
+				allWatchedDirectories.erase(foundDirectory);
+
+				continue;
+			}
+
+			if (event->len == 0)
+			{
+				continue;
+			}
+
+			string filename = foundDirectory->second + "/" + event->name;
+
+			if (event->mask & IN_ISDIR)
+			{
+				if (event->mask & (IN_CREATE | IN_MOVED_TO))
+				{
+					watchDirectory(filename, true);
+				}
+			}
+			else if (event->mask & (IN_DELETE | IN_MOVED_FROM))
+			{
+				allContentHashes.erase(filename);
+			}
+			else if ((event->mask & (IN_CLOSE_WRITE | IN_MOVED_TO)) && updateContentHash(filename))
+			{
+				allChangedFilenames.add(filename);
+			}
+		}
+	}
+
+	glusLogPrint(GLUS_LOG_INFO, "File watcher thread stopped");
+}
+
+void FileWatcher::watchDirectory(const string& name, bool report)
+{
+	int32_t watchDescriptor = inotify_add_watch(notifyDescriptor, name.c_str(), WATCH_MASK);
+
+	if (watchDescriptor < 0)
+	{
+		glusLogPrint(GLUS_LOG_WARNING, "Could not watch directory: %s", name.c_str());
+
+		return;
+	}
+
+	allWatchedDirectories[watchDescriptor] = name;
+
+	// Scanned after the watch is added, so no file written in between is missed.
+	vector<string> allFilenames;
+	vector<string> allDirectories;
+
+	Directory::scan(name, allFilenames, allDirectories, false);
+
+	for (auto& currentFilename : allFilenames)
+	{
+		if (updateContentHash(currentFilename) && report)
+		{
+			allChangedFilenames.add(currentFilename);
+		}
+	}
+
+	for (auto& currentDirectory : allDirectories)
+	{
+		watchDirectory(currentDirectory, report);
+	}
+}
+
+bool FileWatcher::updateContentHash(const string& filename)
+{
+	uint64_t value;
+
+	if (!hashFile(filename, value))
+	{
+		allContentHashes.erase(filename);
+
+		return false;
+	}
+
+	auto found = allContentHashes.find(filename);
+
+	if (found != allContentHashes.end() && found->second == value)
+	{
+		return false;
+	}
+
+	allContentHashes[filename] = value;
+
+	return true;
+}
+
+bool FileWatcher::hashFile(const string& filename, uint64_t& value)
+{
+	FILE* file = fopen(filename.c_str(), "rb");
+
+	if (!file)
+	{
+		return false;
+	}
+
+	// FNV-1a
+	value = 14695981039346656037ull;
+
+	uint8_t buffer[4096];
+
+	size_t length = fread(buffer, 1, sizeof(buffer), file);
+	while (length > 0)
+	{
+		for (size_t i = 0; i < length; i++)
+		{
+			value ^= static_cast<uint64_t>(buffer[i]);
+			value *= 1099511628211ull;
+		}
+
+		length = fread(buffer, 1, sizeof(buffer), file);
+	}
+
+	fclose(file);
+
+	return true;
+}
+
+void FileWatcher::addDirectory(const string& name)
+{
+	allRootDirectories.push_back(name);
+}
+
+bool FileWatcher::start()
+{
+	if (watchThread)
+	{
+		return true;
+	}
+
+	notifyDescriptor = inotify_init1(IN_CLOEXEC);
+
+	if (notifyDescriptor < 0)
+	{
+		glusLogPrint(GLUS_LOG_ERROR, "Could not initialize file watching");
+
+		return false;
+	}
+
+	for (auto& currentDirectory : allRootDirectories)
+	{
+		watchDirectory(currentDirectory, false);
+	}
+
+	if (allWatchedDirectories.size() == 0 || pipe(wakeDescriptors) != 0)
+	{
+		stop();
+
+		return false;
+	}
+
+	glusLogPrint(GLUS_LOG_INFO, "Watching %u directories with %u files", static_cast<uint32_t>(allWatchedDirectories.size()), static_cast<uint32_t>(allContentHashes.size()));
+
+	watchThread = new thread(&FileWatcher::run, this);
+
+	return true;
+}
+
+void FileWatcher::stop()
+{
+	if (watchThread)
+	{
+		const char wake = 0;
+
+		if (write(wakeDescriptors[1], &wake, 1) != 1)
+		{
+			glusLogPrint(GLUS_LOG_ERROR, "Could not wake up file watcher thread");
+		}
+
+		watchThread->join();
+
+		delete watchThread;
+
+		watchThread = nullptr;
+	}
+
+	for (int32_t i = 0; i < 2; i++)
+	{
+		if (wakeDescriptors[i] >= 0)
+		{
+			close(wakeDescriptors[i]);
+
+			wakeDescriptors[i] = -1;
+		}
+	}
+
+	if (notifyDescriptor >= 0)
+	{
+		close(notifyDescriptor);
+
+		notifyDescriptor = -1;
+	}
+
+	allWatchedDirectories.clear();
+	allContentHashes.clear();
+}
+
+bool FileWatcher::isRunning() const
+{
+	return watchThread != nullptr;
+}
+
+bool FileWatcher::takeChangedFilename(string& filename)
+{
+	return allChangedFilenames.take(filename);
+}
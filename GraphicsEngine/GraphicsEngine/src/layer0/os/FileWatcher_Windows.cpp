@@ -0,0 +1,66 @@
+/*
+ * FileWatcher_Windows.cpp
+ *
+ *  Created on: 19.10.2026
+ *      Author: nopper
+ */
+
+#include "FileWatcher.h"
+
+using namespace std;
+
+FileWatcher::FileWatcher() :
+	allRootDirectories(), allChangedFilenames(), watchThread(nullptr), notifyDescriptor(-1), allWatchedDirectories(), allContentHashes()
+{
+	wakeDescriptors[0] = -1;
+	wakeDescriptors[1] = -1;
+}
+
+FileWatcher::~FileWatcher()
+{
+	stop();
+}
+
+void FileWatcher::run()
+{
+}
+
+void FileWatcher::watchDirectory(const string& /*name*/, bool /*report*/)
+{
+}
+
+bool FileWatcher::updateContentHash(const string& /*filename*/)
+{
+	return false;
+}
+
+bool FileWatcher::hashFile(const string& /*filename*/, uint64_t& /*value*/)
+{
+	return false;
+}
+
+void FileWatcher::addDirectory(const string& name)
+{
+	allRootDirectories.push_back(name);
+}
+
+bool FileWatcher::start()
+{
+	glusLogPrint(GLUS_LOG_WARNING, "File watching is not supported on this platform");
+
+	return false;
+}
+
+void FileWatcher::stop()
+{
+}
+
+bool FileWatcher::isRunning() const
+{
+	return false;
+}
+
+bool FileWatcher::takeChangedFilename(string& filename)
+{
+	return allChangedFilenames.take(filename);
+}
@@ -10,7 +10,7 @@
 using namespace std;
 
 GridPlaneShape::GridPlaneShape(float horizontalExtend, float verticalExtend, uint32_t rows, uint32_t columns) :
-		Shape()
+		Shape(), rows(rows), columns(columns)
 {
 	glusShapeCreateRectangularGridPlanef(&shape, horizontalExtend, verticalExtend, rows, columns, GLUS_FALSE);
 }
@@ -19,3 +19,40 @@ GridPlaneShape::~GridPlaneShape()
 {
 }
 
+
+bool GridPlaneShape::orderIndicesByQuadrant()
+{
+	if (rows % 2 != 0 || columns % 2 != 0 || shape.numberIndices != rows * columns * 6)
+	{
+		return false;
+	}
+
+	vector<GLUSindex> allIndices(shape.indices, shape.indices + shape.numberIndices);
+
+	uint32_t halfRows = rows / 2;
+	uint32_t halfColumns = columns / 2;
+
+	uint32_t index = 0;
+
+	for (uint32_t quadrant = 0; quadrant < 4; quadrant++)
+	{
+		// The first row is at the top of the texture.
+		uint32_t firstRow = (quadrant & 2) ? 0 : halfRows;
+		uint32_t firstColumn = (quadrant & 1) ? halfColumns : 0;
+
+		for (uint32_t currentRow = firstRow; currentRow < firstRow + halfRows; currentRow++)
+		{
+			for (uint32_t currentColumn = firstColumn; currentColumn < firstColumn + halfColumns; currentColumn++)
+			{
+				uint32_t cell = currentColumn + currentRow * columns;
+
+				for (uint32_t i = 0; i < 6; i++)
+				{
+					shape.indices[index++] = allIndices[cell * 6 + i];
+				}
+			}
+		}
+	}
+
+	return true;
+}
@@ -12,9 +12,24 @@
 
 class GridPlaneShape : public Shape
 {
+
+private:
+
+	std::uint32_t rows;
+
+	std::uint32_t columns;
+
 public:
 	GridPlaneShape(float horizontalExtend, float verticalExtend, std::uint32_t rows, std::uint32_t columns);
 	virtual ~GridPlaneShape();
+
+	/**
+	 * Orders the triangles, so the ones of each quadrant are consecutive and a quadrant can be drawn with an offset
+	 * into the indices. Quadrant bit 0 is set for s >= 0.5, bit 1 for t >= 0.5. Needs an even number of rows and columns.
+	 *
+	 * @return False, if the grid can not be split into quadrants.
+	 */
+	bool orderIndicesByQuadrant();
 };
 
 #endif /* GRIDPLANESHAPE_H_ */
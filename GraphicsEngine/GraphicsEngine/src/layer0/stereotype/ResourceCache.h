@@ -0,0 +1,327 @@
+/*
+ * ResourceCache.h
+ *
+ *  Created on: 19.10.2026
+ *      Author: nopper
+ */
+
+#ifndef RESOURCECACHE_H_
+#define RESOURCECACHE_H_
+
+#include "../../UsedLibs.h"
+
+#include "KeyValueMap.h"
+
+struct ResourceCacheStatistics
+{
+	std::int32_t numberResources;
+
+	/**
+	 * Resources, which are used outside of the cache and can not be evicted.
+	 */
+	std::int32_t numberReferenced;
+
+	std::uint64_t memorySize;
+
+	std::uint64_t referencedMemorySize;
+
+	std::uint64_t budget;
+
+	std::uint64_t hits;
+
+	std::uint64_t misses;
+
+	std::uint64_t evictions;
+
+	std::uint64_t evictedMemorySize;
+};
+
+/**
+ * Key value map of shared resources, which evicts the least recently used ones, if their memory exceeds the budget.
+ * A resource is only evicted, if the cache holds the last reference to it. The memory of a resource is queried by its
+ * getMemorySize method each time it is needed, as it may change, e.g. by streaming.
+ */
+template<class K, class V>
+class ResourceCache : public KeyValueMap<K, V>
+{
+
+	protected:
+
+		mutable std::map<K, std::uint64_t> allLastUses;
+
+		mutable std::uint64_t currentUse;
+
+		std::uint64_t budget;
+
+		mutable std::uint64_t hits;
+
+		mutable std::uint64_t misses;
+
+		std::uint64_t evictions;
+
+		std::uint64_t evictedMemorySize;
+
+		void touch(const K& key) const
+		{
+			allLastUses[key] = ++currentUse;
+		}
+
+		virtual std::uint64_t getResourceSize(const V& value) const
+		{
+			return value.get() ? value->getMemorySize() : 0;
+		}
+
+		/**
+		 * @return References outside of the cache.
+		 */
+		virtual std::int32_t getReferenceCount(const K& /*key*/, const V& value) const
+		{
+			return value.get() ? static_cast<std::int32_t>(value.use_count()) - 1 : 0;
+		}
+
+		/**
+		 * Called before the resource is removed from the cache by the eviction.
+		 */
+		virtual void evicting(const K& /*key*/, const V& /*value*/)
+		{
+		}
+
+	public:
+
+		ResourceCache() :
+			KeyValueMap<K, V>(), allLastUses(), currentUse(0), budget(0), hits(0), misses(0), evictions(0), evictedMemorySize(0)
+		{
+		}
+
+		virtual ~ResourceCache()
+		{
+			clear();
+		}
+
+		virtual void clear()
+		{
+			KeyValueMap<K, V>::clear();
+
+			allLastUses.clear();
+		}
+
+		/**
+		 * Evicts unused resources, if the budget is exceeded.
+		 */
+		virtual bool add(const K& key, const V& value)
+		{
+			if (!KeyValueMap<K, V>::add(key, value))
+			{
+				return false;
+			}
+
+			touch(key);
+
+			trim();
+
+			return true;
+		}
+
+		/**
+		 * Evicts unused resources, if the budget is exceeded.
+		 */
+		virtual void replace(const K& key, const V& value)
+		{
+			KeyValueMap<K, V>::replace(key, value);
+
+			touch(key);
+
+			trim();
+		}
+
+		virtual bool remove(const K& key)
+		{
+			allLastUses.erase(key);
+
+			return KeyValueMap<K, V>::remove(key);
+		}
+
+		virtual V search(const K& key) const
+		{
+			if (!KeyValueMap<K, V>::contains(key))
+			{
+				misses++;
+
+				return V();
+			}
+
+			hits++;
+
+			touch(key);
+
+			return KeyValueMap<K, V>::at(key);
+		}
+
+		/**
+		 * Counted as a hit or a miss, but not as a use.
+		 */
+		virtual bool contains(const K& key) const
+		{
+			bool result = KeyValueMap<K, V>::contains(key);
+
+			if (result)
+			{
+				hits++;
+			}
+			else
+			{
+				misses++;
+			}
+
+			return result;
+		}
+
+		virtual V& at(const K& key)
+		{
+			V& result = KeyValueMap<K, V>::at(key);
+
+			touch(key);
+
+			return result;
+		}
+
+		virtual const V& at(const K& key) const
+		{
+			const V& result = KeyValueMap<K, V>::at(key);
+
+			touch(key);
+
+			return result;
+		}
+
+		/**
+		 * Resources assigned by the operator are only evicted by the next trim.
+		 */
+		virtual V& operator[](const K& key)
+		{
+			touch(key);
+
+			return KeyValueMap<K, V>::operator[](key);
+		}
+
+		/**
+		 * @param budget Maximum of bytes of all resources. Zero is unlimited.
+		 */
+		void setBudget(std::uint64_t budget)
+		{
+			this->budget = budget;
+
+			trim();
+		}
+
+		std::uint64_t getBudget() const
+		{
+			return budget;
+		}
+
+		std::uint64_t getMemorySize() const
+		{
+			std::uint64_t result = 0;
+
+			for (auto& currentKeyValue : this->allKeyValues)
+			{
+				result += getResourceSize(currentKeyValue.second);
+			}
+
+			return result;
+		}
+
+		/**
+		 * Evicts the least recently used resources, which are not referenced anymore, until the budget is kept. Should be
+		 * called, after resources have been released, e.g. after unloading a level.
+		 *
+		 * @return Number of evicted resources.
+		 */
+		std::int32_t trim()
+		{
+			if (budget == 0)
+			{
+				return 0;
+			}
+
+			std::uint64_t memorySize = getMemorySize();
+
+			if (memorySize <= budget)
+			{
+				return 0;
+			}
+
+			std::vector<std::pair<std::uint64_t, K> > allCandidates;
+
+			for (auto& currentKeyValue : this->allKeyValues)
+			{
+				if (getReferenceCount(currentKeyValue.first, currentKeyValue.second) <= 0)
+				{
+					allCandidates.push_back(std::make_pair(allLastUses[currentKeyValue.first], currentKeyValue.first));
+				}
+			}
+
+			std::sort(allCandidates.begin(), allCandidates.end());
+
+			std::int32_t numberEvicted = 0;
+
+			for (auto& currentCandidate : allCandidates)
+			{
+				if (memorySize <= budget)
+				{
+					break;
+				}
+
+				// Copied, as the resource is released by removing it.
+				V value = KeyValueMap<K, V>::at(currentCandidate.second);
+
+				std::uint64_t resourceSize = getResourceSize(value);
+
+				evicting(currentCandidate.second, value);
+
+				remove(currentCandidate.second);
+
+				memorySize -= resourceSize;
+
+				evictions++;
+				evictedMemorySize += resourceSize;
+
+				numberEvicted++;
+			}
+
+			return numberEvicted;
+		}
+
+		ResourceCacheStatistics getStatistics() const
+		{
+			ResourceCacheStatistics statistics;
+
+			statistics.numberResources = this->size();
+			statistics.numberReferenced = 0;
+			statistics.memorySize = 0;
+			statistics.referencedMemorySize = 0;
+			statistics.budget = budget;
+			statistics.hits = hits;
+			statistics.misses = misses;
+			statistics.evictions = evictions;
+			statistics.evictedMemorySize = evictedMemorySize;
+
+			for (auto& currentKeyValue : this->allKeyValues)
+			{
+				std::uint64_t resourceSize = getResourceSize(currentKeyValue.second);
+
+				statistics.memorySize += resourceSize;
+
+				if (getReferenceCount(currentKeyValue.first, currentKeyValue.second) > 0)
+				{
+					statistics.numberReferenced++;
+					statistics.referencedMemorySize += resourceSize;
+				}
+			}
+
+			return statistics;
+		}
+
+};
+
+#endif /* RESOURCECACHE_H_ */
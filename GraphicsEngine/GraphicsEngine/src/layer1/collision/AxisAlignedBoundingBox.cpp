@@ -93,3 +93,74 @@ bool AxisAlignedBoundingBox::inside(const BoundingSphere& boundingSphere) const
 {
 	return boundingSphere.encloses(*this);
 }
+
+bool AxisAlignedBoundingBox::intersect(const Point4& origin, const Vector3& direction, float maxDistance, float& distance) const
+{
+	float tMin = 0.0f;
+	float tMax = maxDistance;
+
+	float halfExtends[3] = {halfWidth, halfHeight, halfDepth};
+
+	for (int32_t i = 0; i < 3; i++)
+	{
+		float minimum = center.getP()[i] - halfExtends[i];
+		float maximum = center.getP()[i] + halfExtends[i];
+
+		if (fabs(direction.getV()[i]) < 1.0e-8f)
+		{
+			// Parallel to the slab, so the origin has to be inside.
+			if (origin.getP()[i] < minimum || origin.getP()[i] > maximum)
+			{
+				return false;
+			}
+
+			continue;
+		}
+
+		float inverseDirection = 1.0f / direction.getV()[i];
+
+		float t0 = (minimum - origin.getP()[i]) * inverseDirection;
+		float t1 = (maximum - origin.getP()[i]) * inverseDirection;
+
+		if (t0 > t1)
+		{
+			float temp = t0;
+			t0 = t1;
+			t1 = temp;
+		}
+
+		tMin = glusMathMaxf(tMin, t0);
+		tMax = glusMathMinf(tMax, t1);
+
+		if (tMin > tMax)
+		{
+			return false;
+		}
+	}
+
+	distance = tMin;
+
+	return true;
+}
+
+void AxisAlignedBoundingBox::merge(const AxisAlignedBoundingBox& first, const AxisAlignedBoundingBox& second)
+{
+	float minX = glusMathMinf(first.center.getX() - first.halfWidth, second.center.getX() - second.halfWidth);
+	float minY = glusMathMinf(first.center.getY() - first.halfHeight, second.center.getY() - second.halfHeight);
+	float minZ = glusMathMinf(first.center.getZ() - first.halfDepth, second.center.getZ() - second.halfDepth);
+
+	float maxX = glusMathMaxf(first.center.getX() + first.halfWidth, second.center.getX() + second.halfWidth);
+	float maxY = glusMathMaxf(first.center.getY() + first.halfHeight, second.center.getY() + second.halfHeight);
+	float maxZ = glusMathMaxf(first.center.getZ() + first.halfDepth, second.center.getZ() + second.halfDepth);
+
+	center = Point4((minX + maxX) * 0.5f, (minY + maxY) * 0.5f, (minZ + maxZ) * 0.5f);
+
+	halfWidth = (maxX - minX) * 0.5f;
+	halfHeight = (maxY - minY) * 0.5f;
+	halfDepth = (maxZ - minZ) * 0.5f;
+}
+
+float AxisAlignedBoundingBox::getSurfaceArea() const
+{
+	return 8.0f * (halfWidth * halfHeight + halfHeight * halfDepth + halfDepth * halfWidth);
+}
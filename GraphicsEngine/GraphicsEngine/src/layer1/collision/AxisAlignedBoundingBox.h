@@ -10,6 +10,7 @@
 
 #include "../../layer0/math/AxisAlignedBox.h"
 #include "../../layer0/math/Point4.h"
+#include "../../layer0/math/Vector3.h"
 #include "BoundingSphere.h"
 
 class AxisAlignedBoundingBox : public AxisAlignedBox
@@ -31,6 +32,15 @@ public:
 
 	bool inside(const BoundingSphere& boundingSphere) const;
 
+	/**
+	 * Ray test using the slab method. On a hit, distance contains the entry distance along the normalized direction.
+	 */
+	bool intersect(const Point4& origin, const Vector3& direction, float maxDistance, float& distance) const;
+
+	void merge(const AxisAlignedBoundingBox& first, const AxisAlignedBoundingBox& second);
+
+	float getSurfaceArea() const;
+
 };
 
 #endif /* AXISALIGNEDBOUNDINGBOX_H_ */
@@ -5,6 +5,8 @@
  *      Author: nopper
  */
 
+#include "../texture/Texture.h"
+
 #include "RenderBuffer.h"
 
 using namespace std;
@@ -127,3 +129,8 @@ bool RenderBuffer::isValid() const
 {
 	return valid;
 }
+
+uint64_t RenderBuffer::getMemorySize() const
+{
+	return static_cast<uint64_t>(width) * static_cast<uint64_t>(height) * static_cast<uint64_t>(Texture::getBytesPerPixel(internalFormat));
+}
@@ -33,6 +33,11 @@ public:
 
 	virtual bool isMultisample() const;
 
+	/**
+	 * @return Estimated size in bytes of the render buffer in video memory.
+	 */
+	virtual std::uint64_t getMemorySize() const;
+
 	GLenum getInternalFormat() const;
 	void setInternalFormat(GLenum internalFormat);
 
@@ -53,3 +53,8 @@ bool RenderBufferMultisample::isMultisample() const
 }
 
 
+
+uint64_t RenderBufferMultisample::getMemorySize() const
+{
+	return RenderBuffer::getMemorySize() * static_cast<uint64_t>(samples);
+}
@@ -25,6 +25,8 @@ public:
 
 	virtual bool isMultisample() const;
 
+	virtual std::uint64_t getMemorySize() const;
+
 };
 
 typedef std::shared_ptr<RenderBufferMultisample> RenderBufferMultisampleSP;
@@ -0,0 +1,101 @@
+/*
+ * InstanceBuffer.cpp
+ *
+ *  Created on: 19.10.2026
+ *      Author: nopper
+ */
+
+#include "InstanceBuffer.h"
+
+using namespace std;
+
+InstanceBuffer::InstanceBuffer() :
+	matrices(), vboMatrices(0), capacity(0)
+{
+}
+
+InstanceBuffer::~InstanceBuffer()
+{
+	if (vboMatrices)
+	{
+		glDeleteBuffers(1, &vboMatrices);
+
+		vboMatrices = 0;
+	}
+}
+
+void InstanceBuffer::clear()
+{
+	matrices.clear();
+}
+
+void InstanceBuffer::addMatrix(const Matrix4x4& matrix)
+{
+	matrices.insert(matrices.end(), matrix.getM(), matrix.getM() + 16);
+}
+
+uint32_t InstanceBuffer::getNumberInstances() const
+{
+	return static_cast<uint32_t>(matrices.size() / 16);
+}
+
+const vector<GLfloat>& InstanceBuffer::getMatrices() const
+{
+	return matrices;
+}
+
+void InstanceBuffer::upload()
+{
+	if (!vboMatrices)
+	{
+		glGenBuffers(1, &vboMatrices);
+	}
+
+	GLsizeiptr size = static_cast<GLsizeiptr>(matrices.size() * sizeof(GLfloat));
+
+	glBindBuffer(GL_ARRAY_BUFFER, vboMatrices);
+
+	if (size > capacity)
+	{
+		capacity = size * 2;
+	}
+
+	// Orphan the old storage, so the driver does not have to wait for pending draws.
+	glBufferData(GL_ARRAY_BUFFER, capacity, 0, GL_STREAM_DRAW);
+	glBufferSubData(GL_ARRAY_BUFFER, 0, size, matrices.data());
+
+	glBindBuffer(GL_ARRAY_BUFFER, 0);
+}
+
+void InstanceBuffer::enable(GLint location, uint32_t firstInstance) const
+{
+	if (location < 0)
+	{
+		return;
+	}
+
+	glBindBuffer(GL_ARRAY_BUFFER, vboMatrices);
+
+	for (int32_t column = 0; column < MATRIX_COLUMNS; column++)
+	{
+		glVertexAttribPointer(location + column, 4, GL_FLOAT, GL_FALSE, 16 * sizeof(GLfloat), reinterpret_cast<const GLvoid*>((firstInstance * 16 + column * 4) * sizeof(GLfloat)));
+		glVertexAttribDivisor(location + column, 1);
+		glEnableVertexAttribArray(location + column);
+	}
+
+	glBindBuffer(GL_ARRAY_BUFFER, 0);
+}
+
+void InstanceBuffer::disable(GLint location) const
+{
+	if (location < 0)
+	{
+		return;
+	}
+
+	for (int32_t column = 0; column < MATRIX_COLUMNS; column++)
+	{
+		glDisableVertexAttribArray(location + column);
+		glVertexAttribDivisor(location + column, 0);
+	}
+}
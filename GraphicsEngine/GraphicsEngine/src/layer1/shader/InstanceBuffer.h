@@ -0,0 +1,60 @@
+/*
+ * InstanceBuffer.h
+ *
+ *  Created on: 19.10.2026
+ *      Author: nopper
+ */
+
+#ifndef INSTANCEBUFFER_H_
+#define INSTANCEBUFFER_H_
+
+#include "../../UsedLibs.h"
+
+#include "../../layer0/math/Matrix4x4.h"
+
+/**
+ * Per instance model matrices for instanced drawing. The matrices are collected on the CPU and uploaded in one go.
+ * The buffer storage is orphaned on every upload and only grows, so it is not reallocated every frame.
+ */
+class InstanceBuffer
+{
+
+private:
+
+	static const std::int32_t MATRIX_COLUMNS = 4;
+
+	std::vector<GLfloat> matrices;
+
+	GLuint vboMatrices;
+
+	GLsizeiptr capacity;
+
+public:
+
+	InstanceBuffer();
+	virtual ~InstanceBuffer();
+
+	void clear();
+
+	void addMatrix(const Matrix4x4& matrix);
+
+	std::uint32_t getNumberInstances() const;
+
+	const std::vector<GLfloat>& getMatrices() const;
+
+	void upload();
+
+	/**
+	 * Sources the four columns of a mat4 attribute from this buffer. The currently bound vertex array is modified.
+	 *
+	 * @param firstInstance Matrix used by the first instance. Allows to select a matrix per draw without base instance support.
+	 */
+	void enable(GLint location, std::uint32_t firstInstance = 0) const;
+
+	void disable(GLint location) const;
+
+};
+
+typedef std::shared_ptr<InstanceBuffer> InstanceBufferSP;
+
+#endif /* INSTANCEBUFFER_H_ */
@@ -5,6 +5,10 @@
  *      Author: Norbert Nopper
  */
 
+#include "../../layer0/os/Directory.h"
+#include "ProgramCache.h"
+#include "ShaderPreprocessor.h"
+
 #include "Program.h"
 
 using namespace std;
@@ -18,81 +22,152 @@ void Program::off()
 	lastUsedProgram = 0;
 }
 
-Program::Program(const string& type, const string& computeFilename) :
-	type(type), computeFilename(computeFilename), vertexFilename(""), controlFilename(""), evaluationFilename(""), geometryFilename(""), fragmentFilename(), allUniforms(), allAtribbs()
+vector<string> Program::sortDefines(const vector<string>& defines)
 {
-	GLUStextfile computeSource;
+	vector<string> sortedDefines(defines);
 
-	glusLogPrint(GLUS_LOG_INFO, "Loading shader: %s", computeFilename.c_str());
+	sort(sortedDefines.begin(), sortedDefines.end());
 
-	glusFileLoadText(computeFilename.c_str(), &computeSource);
+	return sortedDefines;
+}
 
-	glusProgramBuildComputeFromSource(&shaderprogram, (const GLUSchar**) &computeSource.text);
+Program::Program(const string& type, const string& computeFilename, const vector<string>& defines) :
+	type(type), computeFilename(computeFilename), vertexFilename(""), controlFilename(""), evaluationFilename(""), geometryFilename(""), fragmentFilename(), defines(sortDefines(defines)), allUniforms(), allAtribbs(), allUniformBlocks(), allUniformBlockBindings(), allDependencies()
+{
+	glusLogPrint(GLUS_LOG_INFO, "Loading shader: %s", computeFilename.c_str());
 
-	glusFileDestroyText(&computeSource);
+	build();
 }
 
-Program::Program(const string& type, const string& vertexFilename, const string& fragmentFilename) :
-	type(type), computeFilename(""), vertexFilename(vertexFilename), controlFilename(""), evaluationFilename(""), geometryFilename(""), fragmentFilename(fragmentFilename), allUniforms(), allAtribbs()
+Program::Program(const string& type, const string& vertexFilename, const string& fragmentFilename, const vector<string>& defines) :
+	type(type), computeFilename(""), vertexFilename(vertexFilename), controlFilename(""), evaluationFilename(""), geometryFilename(""), fragmentFilename(fragmentFilename), defines(sortDefines(defines)), allUniforms(), allAtribbs(), allUniformBlocks(), allUniformBlockBindings(), allDependencies()
 {
-	GLUStextfile vertexSource;
-	GLUStextfile fragmentSource;
-
 	glusLogPrint(GLUS_LOG_INFO, "Loading shader: %s %s", vertexFilename.c_str(), fragmentFilename.c_str());
 
-	glusFileLoadText(vertexFilename.c_str(), &vertexSource);
-	glusFileLoadText(fragmentFilename.c_str(), &fragmentSource);
-
-	glusProgramBuildFromSource(&shaderprogram, (const GLUSchar**) &vertexSource.text, 0, 0, 0, (const GLUSchar**) &fragmentSource.text);
-
-	glusFileDestroyText(&vertexSource);
-	glusFileDestroyText(&fragmentSource);
+	build();
 }
 
-Program::Program(const string& type, const string& vertexFilename, const string& geometryFilename, const string& fragmentFilename) :
-	type(type), computeFilename(""), vertexFilename(vertexFilename), controlFilename(""), evaluationFilename(""), geometryFilename(geometryFilename), fragmentFilename(fragmentFilename), allUniforms(), allAtribbs()
+Program::Program(const string& type, const string& vertexFilename, const string& geometryFilename, const string& fragmentFilename, const vector<string>& defines) :
+	type(type), computeFilename(""), vertexFilename(vertexFilename), controlFilename(""), evaluationFilename(""), geometryFilename(geometryFilename), fragmentFilename(fragmentFilename), defines(sortDefines(defines)), allUniforms(), allAtribbs(), allUniformBlocks(), allUniformBlockBindings(), allDependencies()
 {
-	GLUStextfile vertexSource;
-	GLUStextfile geometrySource;
-	GLUStextfile fragmentSource;
-
 	glusLogPrint(GLUS_LOG_INFO, "Loading shader: %s %s %s", vertexFilename.c_str(), geometryFilename.c_str(), fragmentFilename.c_str());
 
-	glusFileLoadText(vertexFilename.c_str(), &vertexSource);
-	glusFileLoadText(geometryFilename.c_str(), &geometrySource);
-	glusFileLoadText(fragmentFilename.c_str(), &fragmentSource);
+	build();
+}
 
-	glusProgramBuildFromSource(&shaderprogram, (const GLUSchar**) &vertexSource.text, 0, 0, (const GLUSchar**) &geometrySource.text, (const GLUSchar**) &fragmentSource.text);
+Program::Program(const string& type, const string& vertexFilename, const string& controlFilename, const string& evaluationFilename, const string& geometryFilename, const string& fragmentFilename, const vector<string>& defines) :
+	type(type), computeFilename(""), vertexFilename(vertexFilename), controlFilename(controlFilename), evaluationFilename(evaluationFilename), geometryFilename(geometryFilename), fragmentFilename(fragmentFilename), defines(sortDefines(defines)), allUniforms(), allAtribbs(), allUniformBlocks(), allUniformBlockBindings(), allDependencies()
+{
+	glusLogPrint(GLUS_LOG_INFO, "Loading shader: %s %s %s %s %s", vertexFilename.c_str(), controlFilename.c_str(), evaluationFilename.c_str(), geometryFilename.c_str(), fragmentFilename.c_str());
 
-	glusFileDestroyText(&vertexSource);
-	glusFileDestroyText(&geometrySource);
-	glusFileDestroyText(&fragmentSource);
+	build();
 }
 
-Program::Program(const string& type, const string& vertexFilename, const string& controlFilename, const string& evaluationFilename, const string& geometryFilename, const string& fragmentFilename) :
-	type(type), computeFilename(""), vertexFilename(vertexFilename), controlFilename(controlFilename), evaluationFilename(evaluationFilename), geometryFilename(geometryFilename), fragmentFilename(fragmentFilename), allUniforms(), allAtribbs()
+bool Program::build()
 {
-	GLUStextfile vertexSource;
-	GLUStextfile controlSource;
-	GLUStextfile evaluationSource;
-	GLUStextfile geometrySource;
-	GLUStextfile fragmentSource;
+	shaderprogram.program = 0;
+	shaderprogram.compute = 0;
+	shaderprogram.vertex = 0;
+	shaderprogram.control = 0;
+	shaderprogram.evaluation = 0;
+	shaderprogram.geometry = 0;
+	shaderprogram.fragment = 0;
 
-	glusLogPrint(GLUS_LOG_INFO, "Loading shader: %s %s %s %s %s", vertexFilename.c_str(), controlFilename.c_str(), evaluationFilename.c_str(), geometryFilename.c_str(), fragmentFilename.c_str());
+	// Same order as the stages of the program cache key.
+	const string* allFilenames[6] = {&computeFilename, &vertexFilename, &controlFilename, &evaluationFilename, &geometryFilename, &fragmentFilename};
+
+	vector<string> allSources(6);
+
+	ShaderPreprocessor shaderPreprocessor;
+
+	allDependencies.clear();
+
+	for (int32_t i = 0; i < 6; i++)
+	{
+		if (allFilenames[i]->size() == 0)
+		{
+			continue;
+		}
+
+		bool processed = shaderPreprocessor.process(*allFilenames[i], defines, allSources[i]);
+
+		// Also gathered on failure, so the program is reloaded, when a missing file is added.
+		vector<string> allFilesOfStage(shaderPreprocessor.getIncludedFilenames());
+		allFilesOfStage.push_back(*allFilenames[i]);
+
+		for (auto& currentFilename : allFilesOfStage)
+		{
+			string canonicalFilename = Directory::getCanonicalName(currentFilename);
+
+			if (canonicalFilename.size() > 0 && find(allDependencies.begin(), allDependencies.end(), canonicalFilename) == allDependencies.end())
+			{
+				allDependencies.push_back(canonicalFilename);
+			}
+		}
+
+		if (!processed)
+		{
+			return false;
+		}
+	}
+
+	string key;
+
+	if (ProgramCache::getInstance()->isEnabled())
+	{
+		key = ProgramCache::createKey(allSources, ProgramCache::getInstance()->getDriver());
+
+		shaderprogram.program = glCreateProgram();
+
+		if (ProgramCache::getInstance()->loadProgram(key, shaderprogram.program))
+		{
+			return true;
+		}
+
+		glDeleteProgram(shaderprogram.program);
+
+		shaderprogram.program = 0;
+	}
+
+	const GLUSchar* allTexts[6];
+
+	for (int32_t i = 0; i < 6; i++)
+	{
+		allTexts[i] = allSources[i].c_str();
+	}
+
+	GLUSboolean created;
+
+	if (computeFilename.size() > 0)
+	{
+		created = glusProgramCreateComputeFromSource(&shaderprogram, &allTexts[0]);
+	}
+	else
+	{
+		created = glusProgramCreateFromSource(&shaderprogram, &allTexts[1], controlFilename.size() > 0 ? &allTexts[2] : 0, evaluationFilename.size() > 0 ? &allTexts[3] : 0, geometryFilename.size() > 0 ? &allTexts[4] : 0, &allTexts[5]);
+	}
+
+	if (!created)
+	{
+		return false;
+	}
 
-	glusFileLoadText(vertexFilename.c_str(), &vertexSource);
-	glusFileLoadText(controlFilename.c_str(), &controlSource);
-	glusFileLoadText(evaluationFilename.c_str(), &evaluationSource);
-	glusFileLoadText(geometryFilename.c_str(), &geometrySource);
-	glusFileLoadText(fragmentFilename.c_str(), &fragmentSource);
+	if (key.size() > 0)
+	{
+		glProgramParameteri(shaderprogram.program, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
+	}
 
-	glusProgramBuildFromSource(&shaderprogram, (const GLUSchar**) &vertexSource.text, (const GLUSchar**) &controlSource.text, (const GLUSchar**) &evaluationSource.text, (const GLUSchar**) &geometrySource.text, (const GLUSchar**) &fragmentSource.text);
+	if (!glusProgramLink(&shaderprogram))
+	{
+		return false;
+	}
 
-	glusFileDestroyText(&vertexSource);
-	glusFileDestroyText(&controlSource);
-	glusFileDestroyText(&evaluationSource);
-	glusFileDestroyText(&geometrySource);
-	glusFileDestroyText(&fragmentSource);
+	if (key.size() > 0)
+	{
+		ProgramCache::getInstance()->saveProgram(key, shaderprogram.program);
+	}
+
+	return true;
 }
 
 Program::~Program()
@@ -109,11 +184,12 @@ Program::~Program()
 
 	allUniforms.clear();
 	allAtribbs.clear();
+	allUniformBlocks.clear();
 }
 
 bool Program::operator ==(const Program& other) const
 {
-	return this->vertexFilename.compare(other.vertexFilename) == 0 && this->fragmentFilename.compare(other.fragmentFilename) == 0;
+	return this->vertexFilename.compare(other.vertexFilename) == 0 && this->fragmentFilename.compare(other.fragmentFilename) == 0 && this->defines == other.defines;
 }
 
 void Program::use()
@@ -154,11 +230,79 @@ int32_t Program::getAttribLocation(const string& name)
 	return attribLocation;
 }
 
+bool Program::setUniformBlockBinding(const string& name, GLuint binding)
+{
+	map<string, GLuint>::iterator found = allUniformBlocks.find(name);
+
+	if (found != allUniformBlocks.end())
+	{
+		return found->second != GL_INVALID_INDEX;
+	}
+	allUniformBlockBindings[name] = binding;
+
+	GLuint uniformBlockIndex = glGetUniformBlockIndex(shaderprogram.program, name.c_str());
+	allUniformBlocks[name] = uniformBlockIndex;
+
+	if (uniformBlockIndex == GL_INVALID_INDEX)
+	{
+		return false;
+	}
+	glUniformBlockBinding(shaderprogram.program, uniformBlockIndex, binding);
+
+	return true;
+}
+
+bool Program::reload()
+{
+	GLUSprogram previousProgram = shaderprogram;
+
+	if (!build())
+	{
+		glusProgramDestroy(&shaderprogram);
+
+		shaderprogram = previousProgram;
+
+		glusLogPrint(GLUS_LOG_ERROR, "Keeping previous program of shader: %s", computeFilename.size() > 0 ? computeFilename.c_str() : vertexFilename.c_str());
+
+		return false;
+	}
+
+	if (lastUsedProgram == this)
+	{
+		off();
+	}
+
+	glusProgramDestroy(&previousProgram);
+
+	allUniforms.clear();
+	allAtribbs.clear();
+	allUniformBlocks.clear();
+
+	map<string, GLuint> allBindings(allUniformBlockBindings);
+
+	for (auto& currentBinding : allBindings)
+	{
+		setUniformBlockBinding(currentBinding.first, currentBinding.second);
+	}
+
+	return true;
+}
+
+bool Program::dependsOn(const string& canonicalFilename) const
+{
+	return find(allDependencies.begin(), allDependencies.end(), canonicalFilename) != allDependencies.end();
+}
+
 const string& Program::getType() const
 {
 	return type;
 }
 
+GLuint Program::getProgramName() const
+{
+	return shaderprogram.program;
+}
+
 const string& Program::getComputeFilename() const
 {
 	return computeFilename;
@@ -185,3 +329,8 @@ const string& Program::getFragmentFilename() const
 {
 	return fragmentFilename;
 }
+
+const vector<string>& Program::getDefines() const
+{
+	return defines;
+}
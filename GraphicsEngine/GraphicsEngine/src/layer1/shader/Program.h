@@ -28,17 +28,41 @@ protected:
 	std::string geometryFilename;
 	std::string fragmentFilename;
 
+	std::vector<std::string> defines;
+
 	std::map<std::string, std::int32_t> allUniforms;
 	std::map<std::string, std::int32_t> allAtribbs;
+	std::map<std::string, GLuint> allUniformBlocks;
+
+	// Applied again after reloading.
+	std::map<std::string, GLuint> allUniformBlockBindings;
+
+	// Canonical names of the shader files and all included files.
+	std::vector<std::string> allDependencies;
+
+	/**
+	 * Preprocesses the sources of all stages and links them. The program is loaded from the program cache, if possible.
+	 *
+	 * @return False, if a file is missing or the program could not be linked.
+	 */
+	bool build();
 
 public:
 
 	static void off();
 
-	Program(const std::string& type, const std::string& computeFilename);
-	Program(const std::string& type, const std::string& vertexFilename, const std::string& fragmentFilename);
-	Program(const std::string& type, const std::string& vertexFilename, const std::string& geometryFilename, const std::string& fragmentFilename);
-	Program(const std::string& type, const std::string& vertexFilename, const std::string& controlFilename, const std::string& evaluationFilename, const std::string& geometryFilename, const std::string& fragmentFilename);
+	/**
+	 * Sorts the defines, so permutations with the same defines in a different order are equal.
+	 */
+	static std::vector<std::string> sortDefines(const std::vector<std::string>& defines);
+
+	/**
+	 * @param defines Permutation of the shaders. A define is either "NAME" or "NAME=VALUE".
+	 */
+	Program(const std::string& type, const std::string& computeFilename, const std::vector<std::string>& defines = std::vector<std::string>());
+	Program(const std::string& type, const std::string& vertexFilename, const std::string& fragmentFilename, const std::vector<std::string>& defines = std::vector<std::string>());
+	Program(const std::string& type, const std::string& vertexFilename, const std::string& geometryFilename, const std::string& fragmentFilename, const std::vector<std::string>& defines = std::vector<std::string>());
+	Program(const std::string& type, const std::string& vertexFilename, const std::string& controlFilename, const std::string& evaluationFilename, const std::string& geometryFilename, const std::string& fragmentFilename, const std::vector<std::string>& defines = std::vector<std::string>());
 	virtual ~Program();
 
 	bool operator ==(const Program& other) const;
@@ -48,8 +72,30 @@ public:
 	std::int32_t getUniformLocation(const std::string& name);
 	std::int32_t getAttribLocation(const std::string& name);
 
+	/**
+	 * Assigns the binding point to the uniform block. The GL is only called the first time for a block.
+	 *
+	 * @return False, if the program does not have this block.
+	 */
+	bool setUniformBlockBinding(const std::string& name, GLuint binding);
+
+	/**
+	 * Builds the program again from the current files. Uniform locations are queried again and the uniform block bindings
+	 * are restored, but uniform values have to be set again. On failure, the previous program is kept.
+	 */
+	bool reload();
+
+	/**
+	 * @param canonicalFilename Name as created by Directory::getCanonicalName.
+	 *
+	 * @return True, if the file is a shader or an included file of this program.
+	 */
+	bool dependsOn(const std::string& canonicalFilename) const;
+
 	const std::string& getType() const;
 
+	GLuint getProgramName() const;
+
 	const std::string& getComputeFilename() const;
 
 	const std::string& getVertexFilename() const;
@@ -61,6 +107,11 @@ public:
 	const std::string& getEvaluationFilename() const;
 
 	const std::string& getGeometryFilename() const;
+
+	/**
+	 * @return The sorted defines of the permutation.
+	 */
+	const std::vector<std::string>& getDefines() const;
 };
 
 typedef std::shared_ptr<Program> ProgramSP;
@@ -0,0 +1,249 @@
+/*
+ * ProgramCache.cpp
+ *
+ *  Created on: 19.10.2026
+ *      Author: nopper
+ */
+
+#include "ProgramCache.h"
+
+using namespace std;
+
+ProgramCache::ProgramCache() :
+	Singleton<ProgramCache>(), cacheDirectory(""), driver(""), supported(false), driverQueried(false), hits(0), misses(0)
+{
+}
+
+ProgramCache::~ProgramCache()
+{
+}
+
+uint64_t ProgramCache::hash(const string& data, uint64_t value)
+{
+	for (size_t i = 0; i < data.size(); i++)
+	{
+		value ^= static_cast<uint8_t>(data[i]);
+		value *= 0x100000001B3ULL;
+	}
+
+	return value;
+}
+
+string ProgramCache::createKey(const vector<string>& sources, const string& driver)
+{
+	uint64_t value = 0xCBF29CE484222325ULL;
+
+	// The separator keeps the stages apart, as sources do not contain a null character.
+	for (auto& currentSource : sources)
+	{
+		value = hash(currentSource, value);
+		value = hash(string(1, '\0'), value);
+	}
+
+	value = hash(driver, value);
+
+	const char* digits = "0123456789abcdef";
+
+	string key(16, '0');
+
+	for (int32_t i = 15; i >= 0; i--)
+	{
+		key[i] = digits[value & 0xF];
+
+		value >>= 4;
+	}
+
+	return key;
+}
+
+void ProgramCache::queryDriver()
+{
+	if (driverQueried)
+	{
+		return;
+	}
+
+	driverQueried = true;
+
+	const GLubyte* vendor = glGetString(GL_VENDOR);
+	const GLubyte* renderer = glGetString(GL_RENDERER);
+	const GLubyte* version = glGetString(GL_VERSION);
+
+	if (vendor && renderer && version)
+	{
+		driver = string(reinterpret_cast<const char*>(vendor)) + " " + string(reinterpret_cast<const char*>(renderer)) + " " + string(reinterpret_cast<const char*>(version));
+	}
+
+	GLint numberFormats = 0;
+
+	glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &numberFormats);
+
+	supported = numberFormats > 0 && driver.size() > 0;
+
+	if (!supported)
+	{
+		glusLogPrint(GLUS_LOG_WARNING, "Program binaries are not supported by the driver");
+	}
+}
+
+string ProgramCache::getFilename(const string& key) const
+{
+	string filename = cacheDirectory;
+
+	if (filename.size() > 0 && filename[filename.size() - 1] != '/' && filename[filename.size() - 1] != '\\')
+	{
+		filename += "/";
+	}
+
+	return filename + key + ".bin";
+}
+
+const string& ProgramCache::getCacheDirectory() const
+{
+	return cacheDirectory;
+}
+
+void ProgramCache::setCacheDirectory(const string& cacheDirectory)
+{
+	this->cacheDirectory = cacheDirectory;
+}
+
+bool ProgramCache::isEnabled()
+{
+	if (cacheDirectory.size() == 0)
+	{
+		return false;
+	}
+
+	queryDriver();
+
+	return supported;
+}
+
+const string& ProgramCache::getDriver()
+{
+	queryDriver();
+
+	return driver;
+}
+
+bool ProgramCache::loadProgram(const string& key, GLuint program)
+{
+	if (!isEnabled())
+	{
+		return false;
+	}
+
+	GLUSbinaryfile binaryfile;
+
+	if (!glusFileLoadBinary(getFilename(key).c_str(), &binaryfile))
+	{
+		misses++;
+
+		return false;
+	}
+
+	uint32_t magic = 0;
+	GLenum binaryFormat = 0;
+	int32_t length = 0;
+
+	if (binaryfile.length >= HEADER_SIZE)
+	{
+		memcpy(&magic, binaryfile.binary, 4);
+		memcpy(&binaryFormat, binaryfile.binary + 4, 4);
+		memcpy(&length, binaryfile.binary + 8, 4);
+	}
+
+	if (magic != MAGIC || length <= 0 || length != binaryfile.length - HEADER_SIZE)
+	{
+		glusLogPrint(GLUS_LOG_WARNING, "Invalid program binary: %s", getFilename(key).c_str());
+
+		glusFileDestroyBinary(&binaryfile);
+
+		misses++;
+
+		return false;
+	}
+
+	glProgramBinary(program, binaryFormat, binaryfile.binary + HEADER_SIZE, length);
+
+	glusFileDestroyBinary(&binaryfile);
+
+	GLint linked = 0;
+
+	glGetProgramiv(program, GL_LINK_STATUS, &linked);
+
+	if (!linked)
+	{
+		// For example, the driver changed without changing its version string.
+		glusLogPrint(GLUS_LOG_INFO, "Program binary rejected by the driver: %s", getFilename(key).c_str());
+
+		misses++;
+
+		return false;
+	}
+
+	hits++;
+
+	return true;
+}
+
+bool ProgramCache::saveProgram(const string& key, GLuint program)
+{
+	if (!isEnabled())
+	{
+		return false;
+	}
+
+	GLint length = 0;
+
+	glGetProgramiv(program, GL_PROGRAM_BINARY_LENGTH, &length);
+
+	if (length <= 0)
+	{
+		return false;
+	}
+
+	vector<GLubyte> data(HEADER_SIZE + length);
+
+	GLsizei written = 0;
+	GLenum binaryFormat = 0;
+
+	glGetProgramBinary(program, length, &written, &binaryFormat, &data[HEADER_SIZE]);
+
+	if (written <= 0)
+	{
+		return false;
+	}
+
+	uint32_t magic = MAGIC;
+	int32_t writtenLength = written;
+
+	memcpy(&data[0], &magic, 4);
+	memcpy(&data[4], &binaryFormat, 4);
+	memcpy(&data[8], &writtenLength, 4);
+
+	GLUSbinaryfile binaryfile;
+
+	binaryfile.binary = &data[0];
+	binaryfile.length = HEADER_SIZE + written;
+
+	if (!glusFileSaveBinary(getFilename(key).c_str(), &binaryfile))
+	{
+		glusLogPrint(GLUS_LOG_WARNING, "Could not save program binary: %s", getFilename(key).c_str());
+
+		return false;
+	}
+
+	return true;
+}
+
+uint32_t ProgramCache::getHits() const
+{
+	return hits;
+}
+
+uint32_t ProgramCache::getMisses() const
+{
+	return misses;
+}
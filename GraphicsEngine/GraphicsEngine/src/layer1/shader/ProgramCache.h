@@ -0,0 +1,97 @@
+/*
+ * ProgramCache.h
+ *
+ *  Created on: 19.10.2026
+ *      Author: nopper
+ */
+
+#ifndef PROGRAMCACHE_H_
+#define PROGRAMCACHE_H_
+
+#include "../../UsedLibs.h"
+
+#include "../../layer0/stereotype/Singleton.h"
+
+/**
+ * Stores linked programs as driver specific binaries on disk, so they do not have to be compiled again at the next
+ * start. An entry is keyed by a hash of the preprocessed sources of all stages and the driver, so changed sources or a
+ * driver update result in a new entry. The cache is disabled as long as no directory is set. The directory has to
+ * exist.
+ */
+class ProgramCache : public Singleton<ProgramCache>
+{
+
+	friend class Singleton<ProgramCache>;
+
+private:
+
+	static const std::uint32_t MAGIC = 0x42504547;
+
+	static const std::int32_t HEADER_SIZE = 12;
+
+	std::string cacheDirectory;
+
+	std::string driver;
+
+	bool supported;
+
+	bool driverQueried;
+
+	std::uint32_t hits;
+
+	std::uint32_t misses;
+
+	ProgramCache();
+	virtual ~ProgramCache();
+
+	static std::uint64_t hash(const std::string& data, std::uint64_t value);
+
+	void queryDriver();
+
+	std::string getFilename(const std::string& key) const;
+
+public:
+
+	/**
+	 * FNV-1a hash of the sources in stage order and the driver as hexadecimal string. Does not need a context.
+	 *
+	 * @param sources Preprocessed sources. Unused stages are empty.
+	 */
+	static std::string createKey(const std::vector<std::string>& sources, const std::string& driver);
+
+	const std::string& getCacheDirectory() const;
+
+	/**
+	 * @param cacheDirectory Directory of the binaries. Empty disables the cache.
+	 */
+	void setCacheDirectory(const std::string& cacheDirectory);
+
+	/**
+	 * @return True, if a directory is set and the driver supports at least one binary format.
+	 */
+	bool isEnabled();
+
+	/**
+	 * Vendor, renderer and version of the driver.
+	 */
+	const std::string& getDriver();
+
+	/**
+	 * Loads the binary into the given program.
+	 *
+	 * @return False, if there is no entry or the driver rejected the binary. The program has to be compiled then.
+	 */
+	bool loadProgram(const std::string& key, GLuint program);
+
+	/**
+	 * Saves the binary of a linked program. The program should be linked with the retrievable hint.
+	 */
+	bool saveProgram(const std::string& key, GLuint program);
+
+	std::uint32_t getHits() const;
+
+	std::uint32_t getMisses() const;
+
+};
+
+#endif /* PROGRAMCACHE_H_ */
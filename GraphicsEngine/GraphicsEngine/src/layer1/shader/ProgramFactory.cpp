@@ -34,7 +34,7 @@ ProgramSP ProgramFactory::createPhongRenderToCubeMapProgram() const
 {
 	ProgramSP program;
 
-	program = ProgramManager::getInstance()->getVertexGeometryFragmentProgramBy(path + "PhongToCubeMap.vert.glsl", path + "PhongToCubeMap.geom.glsl", path + "Phong.frag.glsl", ProgramManager::RENDER_TO_CUBEMAP_PROGRAM_TYPE);
+	program = ProgramManager::getInstance()->getVertexGeometryFragmentProgramBy(path + "Phong.vert.glsl", path + "PhongToCubeMap.geom.glsl", path + "Phong.frag.glsl", ProgramManager::RENDER_TO_CUBEMAP_PROGRAM_TYPE, vector<string>(1, "RENDER_TO_CUBEMAP"));
 
 	return program;
 }
@@ -84,6 +84,15 @@ ProgramSP ProgramFactory::createLineGeometryLinesProgram() const
 	return program;
 }
 
+ProgramSP ProgramFactory::createDebugLineProgram() const
+{
+	ProgramSP program;
+
+	program = ProgramManager::getInstance()->getVertexFragmentProgramBy(path + "DebugLine.vert.glsl", path + "DebugLine.frag.glsl");
+
+	return program;
+}
+
 ProgramSP ProgramFactory::createSkyProgram() const
 {
 	ProgramSP program;
@@ -120,6 +129,33 @@ ProgramSP ProgramFactory::createGroundRenderToShadowMapProgram() const
 	return program;
 }
 
+ProgramSP ProgramFactory::createTerrainProgram() const
+{
+	ProgramSP program;
+
+	program = ProgramManager::getInstance()->getVertexControlEvaluateGeometryFragmentProgramBy(path + "Terrain.vert.glsl", path + "Ground.cont.glsl", path + "Ground.eval.glsl", path + "Ground.geom.glsl", path + "Phong.frag.glsl");
+
+	return program;
+}
+
+ProgramSP ProgramFactory::createTerrainRenderToCubeMapProgram() const
+{
+	ProgramSP program;
+
+	program = ProgramManager::getInstance()->getVertexControlEvaluateGeometryFragmentProgramBy(path + "Terrain.vert.glsl", path + "Ground.cont.glsl", path + "Ground.eval.glsl", path + "GroundToCubeMap.geom.glsl", path + "Phong.frag.glsl", ProgramManager::RENDER_TO_CUBEMAP_PROGRAM_TYPE);
+
+	return program;
+}
+
+ProgramSP ProgramFactory::createTerrainRenderToShadowMapProgram() const
+{
+	ProgramSP program;
+
+	program = ProgramManager::getInstance()->getVertexControlEvaluateGeometryFragmentProgramBy(path + "Terrain.vert.glsl", path + "Ground.cont.glsl", path + "Ground.eval.glsl", path + "Ground.geom.glsl", path + "Red.frag.glsl", ProgramManager::RENDER_TO_SHADOWMAP_PROGRAM_TYPE);
+
+	return program;
+}
+
 const string& ProgramFactory::getPath()
 {
 	return path;
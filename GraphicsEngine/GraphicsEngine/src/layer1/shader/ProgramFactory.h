@@ -41,6 +41,8 @@ public:
 
 	ProgramSP createLineGeometryLinesProgram() const;
 
+	ProgramSP createDebugLineProgram() const;
+
 	ProgramSP createSkyProgram() const;
 
 	ProgramSP createGroundProgram() const;
@@ -49,6 +51,12 @@ public:
 
 	ProgramSP createGroundRenderToShadowMapProgram() const;
 
+	ProgramSP createTerrainProgram() const;
+
+	ProgramSP createTerrainRenderToCubeMapProgram() const;
+
+	ProgramSP createTerrainRenderToShadowMapProgram() const;
+
 };
 
 #endif /* PROGRAMFACTORY_H_ */
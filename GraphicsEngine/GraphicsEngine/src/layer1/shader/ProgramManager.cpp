@@ -53,16 +53,18 @@ void ProgramManager::removeProgram(const ProgramSP& program)
 	}
 }
 
-ProgramSP ProgramManager::getComputeProgramBy(const string& computeFilename, const string& type) const
+ProgramSP ProgramManager::getComputeProgramBy(const string& computeFilename, const string& type, const vector<string>& defines) const
 {
-	multimap<string, ProgramSP>::const_iterator walker = allPrograms.begin();
+	vector<string> sortedDefines = Program::sortDefines(defines);
+
+	multimap<string, ProgramSP>::const_iterator walker = allPrograms.find(type);
 
 	ProgramSP currentProgram;
-	while (walker != allPrograms.end())
+	while (walker != allPrograms.end() && walker->first.compare(type) == 0)
 	{
 		currentProgram = walker->second;
 
-		if (currentProgram->getComputeFilename().compare(computeFilename) == 0)
+		if (currentProgram->getComputeFilename().compare(computeFilename) == 0 && currentProgram->getDefines() == sortedDefines)
 		{
 			return walker->second;
 		}
@@ -70,23 +72,25 @@ ProgramSP ProgramManager::getComputeProgramBy(const string& computeFilename, con
 		walker++;
 	}
 
-	currentProgram = ProgramSP(new Program(type, computeFilename));
+	currentProgram = ProgramSP(new Program(type, computeFilename, sortedDefines));
 
 	ProgramManager::getInstance()->addProgram(currentProgram);
 
 	return currentProgram;
 }
 
-ProgramSP ProgramManager::getVertexFragmentProgramBy(const string& vertexFilename, const string& fragmentFilename, const string& type) const
+ProgramSP ProgramManager::getVertexFragmentProgramBy(const string& vertexFilename, const string& fragmentFilename, const string& type, const vector<string>& defines) const
 {
-	multimap<string, ProgramSP>::const_iterator walker = allPrograms.begin();
+	vector<string> sortedDefines = Program::sortDefines(defines);
+
+	multimap<string, ProgramSP>::const_iterator walker = allPrograms.find(type);
 
 	ProgramSP currentProgram;
-	while (walker != allPrograms.end())
+	while (walker != allPrograms.end() && walker->first.compare(type) == 0)
 	{
 		currentProgram = walker->second;
 
-		if (currentProgram->getVertexFilename().compare(vertexFilename) == 0 && currentProgram->getFragmentFilename().compare(fragmentFilename) == 0)
+		if (currentProgram->getVertexFilename().compare(vertexFilename) == 0 && currentProgram->getFragmentFilename().compare(fragmentFilename) == 0 && currentProgram->getDefines() == sortedDefines)
 		{
 			return walker->second;
 		}
@@ -94,23 +98,25 @@ ProgramSP ProgramManager::getVertexFragmentProgramBy(const string& vertexFilenam
 		walker++;
 	}
 
-	currentProgram = ProgramSP(new Program(type, vertexFilename, fragmentFilename));
+	currentProgram = ProgramSP(new Program(type, vertexFilename, fragmentFilename, sortedDefines));
 
 	ProgramManager::getInstance()->addProgram(currentProgram);
 
 	return currentProgram;
 }
 
-ProgramSP ProgramManager::getVertexGeometryFragmentProgramBy(const string& vertexFilename, const string& geometryFilename, const string& fragmentFilename, const string& type) const
+ProgramSP ProgramManager::getVertexGeometryFragmentProgramBy(const string& vertexFilename, const string& geometryFilename, const string& fragmentFilename, const string& type, const vector<string>& defines) const
 {
-	multimap<string, ProgramSP>::const_iterator walker = allPrograms.begin();
+	vector<string> sortedDefines = Program::sortDefines(defines);
+
+	multimap<string, ProgramSP>::const_iterator walker = allPrograms.find(type);
 
 	ProgramSP currentProgram;
-	while (walker != allPrograms.end())
+	while (walker != allPrograms.end() && walker->first.compare(type) == 0)
 	{
 		currentProgram = walker->second;
 
-		if (currentProgram->getVertexFilename().compare(vertexFilename) == 0 && currentProgram->getGeometryFilename().compare(geometryFilename) == 0 && currentProgram->getFragmentFilename().compare(fragmentFilename) == 0)
+		if (currentProgram->getVertexFilename().compare(vertexFilename) == 0 && currentProgram->getGeometryFilename().compare(geometryFilename) == 0 && currentProgram->getFragmentFilename().compare(fragmentFilename) == 0 && currentProgram->getDefines() == sortedDefines)
 		{
 			return walker->second;
 		}
@@ -118,23 +124,25 @@ ProgramSP ProgramManager::getVertexGeometryFragmentProgramBy(const string& verte
 		walker++;
 	}
 
-	currentProgram = ProgramSP(new Program(type, vertexFilename, geometryFilename, fragmentFilename));
+	currentProgram = ProgramSP(new Program(type, vertexFilename, geometryFilename, fragmentFilename, sortedDefines));
 
 	ProgramManager::getInstance()->addProgram(currentProgram);
 
 	return currentProgram;
 }
 
-ProgramSP ProgramManager::getVertexControlEvaluateGeometryFragmentProgramBy(const std::string& vertexFilename, const std::string& controlFilename, const std::string& evaluationFilename, const std::string& geometryFilename, const std::string& fragmentFilename, const string& type) const
+ProgramSP ProgramManager::getVertexControlEvaluateGeometryFragmentProgramBy(const std::string& vertexFilename, const std::string& controlFilename, const std::string& evaluationFilename, const std::string& geometryFilename, const std::string& fragmentFilename, const string& type, const vector<string>& defines) const
 {
-	multimap<string, ProgramSP>::const_iterator walker = allPrograms.begin();
+	vector<string> sortedDefines = Program::sortDefines(defines);
+
+	multimap<string, ProgramSP>::const_iterator walker = allPrograms.find(type);
 
 	ProgramSP currentProgram;
-	while (walker != allPrograms.end())
+	while (walker != allPrograms.end() && walker->first.compare(type) == 0)
 	{
 		currentProgram = walker->second;
 
-		if (currentProgram->getVertexFilename().compare(vertexFilename) == 0 && currentProgram->getControlFilename().compare(controlFilename) == 0 && currentProgram->getEvaluationFilename().compare(evaluationFilename) == 0 && currentProgram->getGeometryFilename().compare(geometryFilename) == 0 && currentProgram->getFragmentFilename().compare(fragmentFilename) == 0)
+		if (currentProgram->getVertexFilename().compare(vertexFilename) == 0 && currentProgram->getControlFilename().compare(controlFilename) == 0 && currentProgram->getEvaluationFilename().compare(evaluationFilename) == 0 && currentProgram->getGeometryFilename().compare(geometryFilename) == 0 && currentProgram->getFragmentFilename().compare(fragmentFilename) == 0 && currentProgram->getDefines() == sortedDefines)
 		{
 			return walker->second;
 		}
@@ -142,7 +150,7 @@ ProgramSP ProgramManager::getVertexControlEvaluateGeometryFragmentProgramBy(cons
 		walker++;
 	}
 
-	currentProgram = ProgramSP(new Program(type, vertexFilename, controlFilename, evaluationFilename, geometryFilename, fragmentFilename));
+	currentProgram = ProgramSP(new Program(type, vertexFilename, controlFilename, evaluationFilename, geometryFilename, fragmentFilename, sortedDefines));
 
 	ProgramManager::getInstance()->addProgram(currentProgram);
 
@@ -154,3 +162,21 @@ const multimap<string, ProgramSP>& ProgramManager::getAllPrograms() const
 	return allPrograms;
 }
 
+
+int32_t ProgramManager::reloadPrograms(const string& canonicalFilename)
+{
+	int32_t numberReloaded = 0;
+
+	multimap<string, ProgramSP>::iterator walker = allPrograms.begin();
+	while (walker != allPrograms.end())
+	{
+		if (walker->second->dependsOn(canonicalFilename) && walker->second->reload())
+		{
+			numberReloaded++;
+		}
+
+		walker++;
+	}
+
+	return numberReloaded;
+}
@@ -40,16 +40,29 @@ public:
 
 	void removeProgram(const ProgramSP& program);
 
-	ProgramSP getComputeProgramBy(const std::string& computeFilename, const std::string& type = DEFAULT_PROGRAM_TYPE) const;
+	/*
+	 * The getters return an existing program with the same files, type and defines. Otherwise, the program is created.
+	 */
 
-	ProgramSP getVertexFragmentProgramBy(const std::string& vertexFilename, const std::string& fragmentFilename, const std::string& type = DEFAULT_PROGRAM_TYPE) const;
+	ProgramSP getComputeProgramBy(const std::string& computeFilename, const std::string& type = DEFAULT_PROGRAM_TYPE, const std::vector<std::string>& defines = std::vector<std::string>()) const;
 
-	ProgramSP getVertexGeometryFragmentProgramBy(const std::string& vertexFilename, const std::string& geometryFilename, const std::string& fragmentFilename, const std::string& type = DEFAULT_PROGRAM_TYPE) const;
+	ProgramSP getVertexFragmentProgramBy(const std::string& vertexFilename, const std::string& fragmentFilename, const std::string& type = DEFAULT_PROGRAM_TYPE, const std::vector<std::string>& defines = std::vector<std::string>()) const;
 
-	ProgramSP getVertexControlEvaluateGeometryFragmentProgramBy(const std::string& vertexFilename, const std::string& controlFilename, const std::string& evaluationFilename, const std::string& geometryFilename, const std::string& fragmentFilename, const std::string& type = DEFAULT_PROGRAM_TYPE) const;
+	ProgramSP getVertexGeometryFragmentProgramBy(const std::string& vertexFilename, const std::string& geometryFilename, const std::string& fragmentFilename, const std::string& type = DEFAULT_PROGRAM_TYPE, const std::vector<std::string>& defines = std::vector<std::string>()) const;
+
+	ProgramSP getVertexControlEvaluateGeometryFragmentProgramBy(const std::string& vertexFilename, const std::string& controlFilename, const std::string& evaluationFilename, const std::string& geometryFilename, const std::string& fragmentFilename, const std::string& type = DEFAULT_PROGRAM_TYPE, const std::vector<std::string>& defines = std::vector<std::string>()) const;
 
 	const std::multimap<std::string, ProgramSP>& getAllPrograms() const;
 
+	/**
+	 * Reloads all programs using the file as a shader or as an included file.
+	 *
+	 * @param canonicalFilename Name as created by Directory::getCanonicalName.
+	 *
+	 * @return Number of reloaded programs.
+	 */
+	std::int32_t reloadPrograms(const std::string& canonicalFilename);
+
 };
 
 #endif /* PROGRAMMANAGER_H_ */
@@ -0,0 +1,278 @@
+/*
+ * RenderStateCache.cpp
+ *
+ *  Created on: 19.10.2026
+ *      Author: nopper
+ */
+
+#include "RenderStateCache.h"
+
+using namespace std;
+
+RenderStateCache::RenderStateCache() :
+	Singleton<RenderStateCache>(), issueGlCalls(true), batching(false), currentProgram(0), currentVertexArray(0), currentActiveTexture(GL_TEXTURE0), programChanges(0), vertexArrayChanges(0), textureChanges(0), uniformBufferChanges(0), skippedChanges(0), drawCalls(0), drawnInstances(0)
+{
+	invalidate();
+}
+
+RenderStateCache::~RenderStateCache()
+{
+}
+
+void RenderStateCache::invalidate()
+{
+	// Zero is a valid name, so use values never returned by GL.
+	currentProgram = static_cast<GLuint>(-1);
+	currentVertexArray = static_cast<GLuint>(-1);
+	currentActiveTexture = GL_NONE;
+
+	for (int32_t i = 0; i < MAX_TEXTURE_UNITS; i++)
+	{
+		currentTextureTargets[i] = GL_NONE;
+		currentTextures[i] = static_cast<GLuint>(-1);
+	}
+
+	for (int32_t i = 0; i < MAX_UNIFORM_BUFFER_BINDINGS; i++)
+	{
+		currentUniformBuffers[i] = static_cast<GLuint>(-1);
+	}
+}
+
+bool RenderStateCache::isIssueGlCalls() const
+{
+	return issueGlCalls;
+}
+
+void RenderStateCache::setIssueGlCalls(bool issueGlCalls)
+{
+	this->issueGlCalls = issueGlCalls;
+}
+
+bool RenderStateCache::isBatching() const
+{
+	return batching;
+}
+
+void RenderStateCache::beginBatch()
+{
+	invalidate();
+
+	batching = true;
+}
+
+void RenderStateCache::endBatch()
+{
+	batching = false;
+
+	for (int32_t i = MAX_TEXTURE_UNITS - 1; i >= 0; i--)
+	{
+		if (currentTextureTargets[i] != GL_NONE && currentTextures[i] != 0)
+		{
+			bindTexture(GL_TEXTURE0 + i, currentTextureTargets[i], 0);
+		}
+	}
+
+	if (currentActiveTexture != GL_TEXTURE0 && issueGlCalls)
+	{
+		glActiveTexture(GL_TEXTURE0);
+	}
+
+	if (currentVertexArray != 0 && currentVertexArray != static_cast<GLuint>(-1))
+	{
+		bindVertexArray(0);
+	}
+
+	invalidate();
+}
+
+bool RenderStateCache::useProgram(const ProgramSP& program)
+{
+	if (batching && currentProgram == program->getProgramName())
+	{
+		skippedChanges++;
+
+		return false;
+	}
+
+	currentProgram = program->getProgramName();
+	programChanges++;
+
+	if (issueGlCalls)
+	{
+		program->use();
+	}
+
+	return true;
+}
+
+void RenderStateCache::bindVertexArray(GLuint vertexArray)
+{
+	if (batching && currentVertexArray == vertexArray)
+	{
+		skippedChanges++;
+
+		return;
+	}
+
+	currentVertexArray = vertexArray;
+	vertexArrayChanges++;
+
+	if (issueGlCalls)
+	{
+		glBindVertexArray(vertexArray);
+	}
+}
+
+void RenderStateCache::bindTexture(GLenum unit, GLenum target, GLuint texture)
+{
+	int32_t index = static_cast<int32_t>(unit - GL_TEXTURE0);
+
+	assert(index >= 0 && index < MAX_TEXTURE_UNITS);
+
+	if (batching && currentTextureTargets[index] == target && currentTextures[index] == texture)
+	{
+		skippedChanges++;
+
+		return;
+	}
+
+	// A unit can have several targets bound, but the engine uses one target per unit, so unbind the previous one.
+	if (currentTextureTargets[index] != target && currentTextureTargets[index] != GL_NONE && currentTextures[index] != 0)
+	{
+		if (currentActiveTexture != unit && issueGlCalls)
+		{
+			glActiveTexture(unit);
+		}
+		currentActiveTexture = unit;
+
+		if (issueGlCalls)
+		{
+			glBindTexture(currentTextureTargets[index], 0);
+		}
+	}
+
+	currentTextureTargets[index] = target;
+	currentTextures[index] = texture;
+	textureChanges++;
+
+	if (issueGlCalls)
+	{
+		if (currentActiveTexture != unit || !batching)
+		{
+			glActiveTexture(unit);
+		}
+
+		glBindTexture(target, texture);
+	}
+	currentActiveTexture = unit;
+}
+
+void RenderStateCache::bindUniformBuffer(GLuint binding, GLuint buffer)
+{
+	assert(binding < static_cast<GLuint>(MAX_UNIFORM_BUFFER_BINDINGS));
+
+	if (batching && currentUniformBuffers[binding] == buffer)
+	{
+		skippedChanges++;
+
+		return;
+	}
+
+	currentUniformBuffers[binding] = buffer;
+	uniformBufferChanges++;
+
+	if (issueGlCalls)
+	{
+		glBindBufferBase(GL_UNIFORM_BUFFER, binding, buffer);
+	}
+}
+
+void RenderStateCache::drawElements(GLenum mode, GLsizei count, GLenum type, const GLvoid* indices)
+{
+	drawCalls++;
+	drawnInstances++;
+
+	if (issueGlCalls)
+	{
+		glDrawElements(mode, count, type, indices);
+	}
+}
+
+void RenderStateCache::drawElementsInstanced(GLenum mode, GLsizei count, GLenum type, const GLvoid* indices, GLsizei instanceCount)
+{
+	drawCalls++;
+	drawnInstances += static_cast<uint32_t>(instanceCount);
+
+	if (issueGlCalls)
+	{
+		glDrawElementsInstanced(mode, count, type, indices, instanceCount);
+	}
+}
+
+void RenderStateCache::drawElementsInstancedBaseVertex(GLenum mode, GLsizei count, GLenum type, const GLvoid* indices, GLsizei instanceCount, GLint baseVertex)
+{
+	drawCalls++;
+	drawnInstances += static_cast<uint32_t>(instanceCount);
+
+	if (issueGlCalls)
+	{
+		glDrawElementsInstancedBaseVertex(mode, count, type, indices, instanceCount, baseVertex);
+	}
+}
+
+void RenderStateCache::multiDrawElementsIndirect(GLenum mode, GLenum type, const GLvoid* indirect, GLsizei drawCount)
+{
+	drawCalls++;
+	drawnInstances += static_cast<uint32_t>(drawCount);
+
+	if (issueGlCalls)
+	{
+		glMultiDrawElementsIndirect(mode, type, indirect, drawCount, 0);
+	}
+}
+
+void RenderStateCache::resetStatistics()
+{
+	programChanges = 0;
+	vertexArrayChanges = 0;
+	textureChanges = 0;
+	uniformBufferChanges = 0;
+	skippedChanges = 0;
+	drawCalls = 0;
+	drawnInstances = 0;
+}
+
+uint32_t RenderStateCache::getProgramChanges() const
+{
+	return programChanges;
+}
+
+uint32_t RenderStateCache::getVertexArrayChanges() const
+{
+	return vertexArrayChanges;
+}
+
+uint32_t RenderStateCache::getTextureChanges() const
+{
+	return textureChanges;
+}
+
+uint32_t RenderStateCache::getUniformBufferChanges() const
+{
+	return uniformBufferChanges;
+}
+
+uint32_t RenderStateCache::getSkippedChanges() const
+{
+	return skippedChanges;
+}
+
+uint32_t RenderStateCache::getDrawCalls() const
+{
+	return drawCalls;
+}
+
+uint32_t RenderStateCache::getDrawnInstances() const
+{
+	return drawnInstances;
+}
@@ -0,0 +1,133 @@
+/*
+ * RenderStateCache.h
+ *
+ *  Created on: 19.10.2026
+ *      Author: nopper
+ */
+
+#ifndef RENDERSTATECACHE_H_
+#define RENDERSTATECACHE_H_
+
+#include "../../UsedLibs.h"
+
+#include "../../layer0/stereotype/Singleton.h"
+
+#include "Program.h"
+
+/**
+ * Shadows the program, vertex array and texture bindings. Inside a batch, binds which would not change the state are skipped.
+ * Outside a batch, every call is passed through. All calls are counted, so the effect of state sorting can be measured.
+ * With disabled GL calls, only the counting is done for the calls made through the cache. Uniforms, blending and other
+ * state are still set directly by the entities, so rendering still needs a context.
+ */
+class RenderStateCache : public Singleton<RenderStateCache>
+{
+
+	friend class Singleton<RenderStateCache>;
+
+private:
+
+	static const std::int32_t MAX_TEXTURE_UNITS = 16;
+
+	static const std::int32_t MAX_UNIFORM_BUFFER_BINDINGS = 8;
+
+	bool issueGlCalls;
+
+	bool batching;
+
+	GLuint currentProgram;
+
+	GLuint currentVertexArray;
+
+	GLenum currentActiveTexture;
+
+	GLenum currentTextureTargets[MAX_TEXTURE_UNITS];
+
+	GLuint currentTextures[MAX_TEXTURE_UNITS];
+
+	GLuint currentUniformBuffers[MAX_UNIFORM_BUFFER_BINDINGS];
+
+	std::uint32_t programChanges;
+
+	std::uint32_t vertexArrayChanges;
+
+	std::uint32_t textureChanges;
+
+	std::uint32_t uniformBufferChanges;
+
+	std::uint32_t skippedChanges;
+
+	std::uint32_t drawCalls;
+
+	std::uint32_t drawnInstances;
+
+	RenderStateCache();
+	virtual ~RenderStateCache();
+
+	void invalidate();
+
+public:
+
+	bool isIssueGlCalls() const;
+
+	void setIssueGlCalls(bool issueGlCalls);
+
+	bool isBatching() const;
+
+	/**
+	 * Starts to filter redundant binds. Nothing is assumed about the current GL state.
+	 */
+	void beginBatch();
+
+	/**
+	 * Unbinds all touched textures and the vertex array and stops filtering.
+	 */
+	void endBatch();
+
+	/**
+	 * @return True, if the program has been changed. Uniforms, which are constant per program, only have to be set then.
+	 */
+	bool useProgram(const ProgramSP& program);
+
+	void bindVertexArray(GLuint vertexArray);
+
+	void bindTexture(GLenum unit, GLenum target, GLuint texture);
+
+	void bindUniformBuffer(GLuint binding, GLuint buffer);
+
+	void drawElements(GLenum mode, GLsizei count, GLenum type, const GLvoid* indices);
+
+	void drawElementsInstanced(GLenum mode, GLsizei count, GLenum type, const GLvoid* indices, GLsizei instanceCount);
+
+	void drawElementsInstancedBaseVertex(GLenum mode, GLsizei count, GLenum type, const GLvoid* indices, GLsizei instanceCount, GLint baseVertex);
+
+	/**
+	 * Counted as one draw call. The commands are read from the currently bound indirect buffer.
+	 */
+	void multiDrawElementsIndirect(GLenum mode, GLenum type, const GLvoid* indirect, GLsizei drawCount);
+
+	void resetStatistics();
+
+	std::uint32_t getProgramChanges() const;
+
+	std::uint32_t getVertexArrayChanges() const;
+
+	std::uint32_t getTextureChanges() const;
+
+	std::uint32_t getUniformBufferChanges() const;
+
+	/**
+	 * @return Number of binds, which have been skipped as the state was already set.
+	 */
+	std::uint32_t getSkippedChanges() const;
+
+	std::uint32_t getDrawCalls() const;
+
+	/**
+	 * @return Number of drawn instances. Without instancing, this is the same as the draw calls.
+	 */
+	std::uint32_t getDrawnInstances() const;
+
+};
+
+#endif /* RENDERSTATECACHE_H_ */
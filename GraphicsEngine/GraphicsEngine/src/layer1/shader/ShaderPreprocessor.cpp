@@ -0,0 +1,269 @@
+/*
+ * ShaderPreprocessor.cpp
+ *
+ *  Created on: 19.10.2026
+ *      Author: nopper
+ */
+
+#include "ShaderPreprocessor.h"
+
+using namespace std;
+
+ShaderPreprocessor::ShaderPreprocessor(int32_t maxDepth) :
+	maxDepth(maxDepth), allIncludedFilenames()
+{
+}
+
+ShaderPreprocessor::~ShaderPreprocessor()
+{
+	allIncludedFilenames.clear();
+}
+
+string ShaderPreprocessor::trim(const string& line)
+{
+	size_t first = line.find_first_not_of(" \t\r");
+
+	if (first == string::npos)
+	{
+		return "";
+	}
+
+	size_t last = line.find_last_not_of(" \t\r");
+
+	return line.substr(first, last - first + 1);
+}
+
+string ShaderPreprocessor::getDirectory(const string& filename)
+{
+	size_t separator = filename.find_last_of("/\\");
+
+	if (separator == string::npos)
+	{
+		return "";
+	}
+
+	return filename.substr(0, separator + 1);
+}
+
+bool ShaderPreprocessor::parseInclude(const string& line, string& includeFilename)
+{
+	string directive = trim(line);
+
+	if (directive.size() == 0 || directive[0] != '#')
+	{
+		return false;
+	}
+
+	directive = trim(directive.substr(1));
+
+	if (directive.compare(0, 7, "include") != 0)
+	{
+		return false;
+	}
+
+	directive = trim(directive.substr(7));
+
+	if (directive.size() < 2 || (directive[0] != '"' && directive[0] != '<'))
+	{
+		return false;
+	}
+
+	size_t end = directive.find(directive[0] == '"' ? '"' : '>', 1);
+
+	if (end == string::npos || end == 1)
+	{
+		return false;
+	}
+
+	includeFilename = directive.substr(1, end - 1);
+
+	return true;
+}
+
+bool ShaderPreprocessor::isVersion(const string& line)
+{
+	string directive = trim(line);
+
+	if (directive.size() == 0 || directive[0] != '#')
+	{
+		return false;
+	}
+
+	return trim(directive.substr(1)).compare(0, 7, "version") == 0;
+}
+
+void ShaderPreprocessor::appendLine(int32_t line, int32_t sourceStringNumber, string& result)
+{
+	result += "#line " + to_string(line) + " " + to_string(sourceStringNumber) + "\n";
+}
+
+bool ShaderPreprocessor::processSource(const string& source, const string& filename, int32_t depth, const string& defines, string& result)
+{
+	int32_t sourceStringNumber = static_cast<int32_t>(find(allIncludedFilenames.begin(), allIncludedFilenames.end(), filename) - allIncludedFilenames.begin());
+
+	vector<string> allLines;
+
+	size_t start = 0;
+	while (start < source.size())
+	{
+		size_t end = source.find('\n', start);
+
+		if (end == string::npos)
+		{
+			end = source.size();
+		}
+
+		allLines.push_back(source.substr(start, end - start));
+
+		start = end + 1;
+	}
+
+	bool definesPending = defines.size() > 0;
+
+	// Without a version, the defines are the first lines.
+	if (definesPending && find_if(allLines.begin(), allLines.end(), isVersion) == allLines.end())
+	{
+		result += defines;
+
+		appendLine(1, sourceStringNumber, result);
+
+		definesPending = false;
+	}
+
+	string includeFilename;
+
+	for (int32_t i = 0; i < static_cast<int32_t>(allLines.size()); i++)
+	{
+		if (isVersion(allLines[i]))
+		{
+			// Only the version of the main file is kept.
+			if (depth == 0)
+			{
+				result += allLines[i] + "\n";
+			}
+			else
+			{
+				result += "\n";
+			}
+
+			if (definesPending)
+			{
+				result += defines;
+
+				appendLine(i + 2, sourceStringNumber, result);
+
+				definesPending = false;
+			}
+		}
+		else if (parseInclude(allLines[i], includeFilename))
+		{
+			string includePath = getDirectory(filename) + includeFilename;
+
+			if (find(allIncludedFilenames.begin(), allIncludedFilenames.end(), includePath) != allIncludedFilenames.end())
+			{
+				result += "\n";
+
+				continue;
+			}
+
+			if (depth + 1 > maxDepth)
+			{
+				glusLogPrint(GLUS_LOG_ERROR, "Shader includes nested too deep: %s", includePath.c_str());
+
+				return false;
+			}
+
+			if (!processFile(includePath, depth + 1, result))
+			{
+				glusLogPrint(GLUS_LOG_ERROR, "Included from: %s(%d)", filename.c_str(), i + 1);
+
+				return false;
+			}
+
+			appendLine(i + 2, sourceStringNumber, result);
+		}
+		else
+		{
+			result += allLines[i] + "\n";
+		}
+	}
+
+	return true;
+}
+
+bool ShaderPreprocessor::processFile(const string& filename, int32_t depth, string& result)
+{
+	GLUStextfile textfile;
+
+	if (!glusFileLoadText(filename.c_str(), &textfile))
+	{
+		glusLogPrint(GLUS_LOG_ERROR, "Could not load shader: %s", filename.c_str());
+
+		return false;
+	}
+
+	string source(textfile.text, textfile.length);
+
+	glusFileDestroyText(&textfile);
+
+	allIncludedFilenames.push_back(filename);
+
+	appendLine(1, static_cast<int32_t>(allIncludedFilenames.size()) - 1, result);
+
+	return processSource(source, filename, depth, "", result);
+}
+
+string ShaderPreprocessor::createDefines(const vector<string>& defines)
+{
+	string result;
+
+	for (auto& currentDefine : defines)
+	{
+		size_t assignment = currentDefine.find('=');
+
+		if (assignment == string::npos)
+		{
+			result += "#define " + currentDefine + "\n";
+		}
+		else
+		{
+			result += "#define " + currentDefine.substr(0, assignment) + " " + currentDefine.substr(assignment + 1) + "\n";
+		}
+	}
+
+	return result;
+}
+
+bool ShaderPreprocessor::process(const string& filename, const vector<string>& defines, string& result)
+{
+	GLUStextfile textfile;
+
+	if (!glusFileLoadText(filename.c_str(), &textfile))
+	{
+		glusLogPrint(GLUS_LOG_ERROR, "Could not load shader: %s", filename.c_str());
+
+		return false;
+	}
+
+	string source(textfile.text, textfile.length);
+
+	glusFileDestroyText(&textfile);
+
+	return process(source, filename, defines, result);
+}
+
+bool ShaderPreprocessor::process(const string& source, const string& filename, const vector<string>& defines, string& result)
+{
+	allIncludedFilenames.clear();
+
+	allIncludedFilenames.push_back(filename);
+
+	result.clear();
+
+	return processSource(source, filename, 0, createDefines(defines), result);
+}
+
+const vector<string>& ShaderPreprocessor::getIncludedFilenames() const
+{
+	return allIncludedFilenames;
+}
@@ -0,0 +1,75 @@
+/*
+ * ShaderPreprocessor.h
+ *
+ *  Created on: 19.10.2026
+ *      Author: nopper
+ */
+
+#ifndef SHADERPREPROCESSOR_H_
+#define SHADERPREPROCESSOR_H_
+
+#include "../../UsedLibs.h"
+
+/**
+ * Resolves #include "file" directives and injects permutation defines into GLSL sources. Included files are resolved
+ * relative to the including file and are only inserted once. #line directives are emitted, so compile errors refer to
+ * the original file and line. The source string number is the index in the included filenames. Does not need a context.
+ */
+class ShaderPreprocessor
+{
+
+private:
+
+	std::int32_t maxDepth;
+
+	std::vector<std::string> allIncludedFilenames;
+
+	static std::string trim(const std::string& line);
+
+	static std::string getDirectory(const std::string& filename);
+
+	/**
+	 * @return True, if the line is an include directive. The name of the included file is stored.
+	 */
+	static bool parseInclude(const std::string& line, std::string& includeFilename);
+
+	static bool isVersion(const std::string& line);
+
+	static void appendLine(std::int32_t line, std::int32_t sourceStringNumber, std::string& result);
+
+	bool processSource(const std::string& source, const std::string& filename, std::int32_t depth, const std::string& defines, std::string& result);
+
+	bool processFile(const std::string& filename, std::int32_t depth, std::string& result);
+
+public:
+
+	static const std::int32_t DEFAULT_MAX_DEPTH = 16;
+
+	ShaderPreprocessor(std::int32_t maxDepth = DEFAULT_MAX_DEPTH);
+	virtual ~ShaderPreprocessor();
+
+	/**
+	 * Creates the #define lines. A define is either "NAME" or "NAME=VALUE".
+	 */
+	static std::string createDefines(const std::vector<std::string>& defines);
+
+	/**
+	 * Loads and preprocesses a shader file.
+	 *
+	 * @return False, if a file could not be loaded or the includes are nested too deep.
+	 */
+	bool process(const std::string& filename, const std::vector<std::string>& defines, std::string& result);
+
+	/**
+	 * Preprocesses the given source. Includes are resolved relative to the given filename.
+	 */
+	bool process(const std::string& source, const std::string& filename, const std::vector<std::string>& defines, std::string& result);
+
+	/**
+	 * Files of the last processing. The index is the source string number used in the #line directives.
+	 */
+	const std::vector<std::string>& getIncludedFilenames() const;
+
+};
+
+#endif /* SHADERPREPROCESSOR_H_ */
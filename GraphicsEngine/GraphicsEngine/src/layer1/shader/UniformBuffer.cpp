@@ -0,0 +1,47 @@
+/*
+ * UniformBuffer.cpp
+ *
+ *  Created on: 19.10.2026
+ *      Author: nopper
+ */
+
+#include "UniformBuffer.h"
+
+using namespace std;
+
+UniformBuffer::UniformBuffer(GLsizeiptr size) :
+	ubo(0), size(size)
+{
+	glGenBuffers(1, &ubo);
+
+	glBindBuffer(GL_UNIFORM_BUFFER, ubo);
+	glBufferData(GL_UNIFORM_BUFFER, size, 0, GL_DYNAMIC_DRAW);
+	glBindBuffer(GL_UNIFORM_BUFFER, 0);
+}
+
+UniformBuffer::~UniformBuffer()
+{
+	if (ubo)
+	{
+		glDeleteBuffers(1, &ubo);
+
+		ubo = 0;
+	}
+}
+
+void UniformBuffer::update(const GLvoid* data) const
+{
+	glBindBuffer(GL_UNIFORM_BUFFER, ubo);
+	glBufferSubData(GL_UNIFORM_BUFFER, 0, size, data);
+	glBindBuffer(GL_UNIFORM_BUFFER, 0);
+}
+
+GLuint UniformBuffer::getUniformBufferName() const
+{
+	return ubo;
+}
+
+GLsizeiptr UniformBuffer::getSize() const
+{
+	return size;
+}
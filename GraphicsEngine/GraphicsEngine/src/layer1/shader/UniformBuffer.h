@@ -0,0 +1,40 @@
+/*
+ * UniformBuffer.h
+ *
+ *  Created on: 19.10.2026
+ *      Author: nopper
+ */
+
+#ifndef UNIFORMBUFFER_H_
+#define UNIFORMBUFFER_H_
+
+#include "../../UsedLibs.h"
+
+/**
+ * Buffer object backing a std140 uniform block.
+ */
+class UniformBuffer
+{
+
+private:
+
+	GLuint ubo;
+
+	GLsizeiptr size;
+
+public:
+
+	UniformBuffer(GLsizeiptr size);
+	virtual ~UniformBuffer();
+
+	void update(const GLvoid* data) const;
+
+	GLuint getUniformBufferName() const;
+
+	GLsizeiptr getSize() const;
+
+};
+
+typedef std::shared_ptr<UniformBuffer> UniformBufferSP;
+
+#endif /* UNIFORMBUFFER_H_ */
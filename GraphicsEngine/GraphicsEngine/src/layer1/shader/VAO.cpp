@@ -51,3 +51,8 @@ const ProgramSP& VAO::getProgram() const
 {
 	return program;
 }
+
+GLuint VAO::getVAOName() const
+{
+	return vao;
+}
@@ -40,6 +40,8 @@ public:
 
 	const ProgramSP& getProgram() const;
 
+	GLuint getVAOName() const;
+
 };
 
 typedef std::shared_ptr<VAO> VAOSP;
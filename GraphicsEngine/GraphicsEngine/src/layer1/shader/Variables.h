@@ -18,6 +18,7 @@
 
 #define u_cubeMapProjectionMatrix "u_cubeMapProjectionMatrix"
 #define u_cubeMapViewMatrix "u_cubeMapViewMatrix"
+#define u_cubeMapFaceMask "u_cubeMapFaceMask"
 
 #define u_eyePosition "u_eyePosition"
 
@@ -37,18 +38,20 @@
 #define u_lightSpotCosCutOff "].spotCosCutOff"
 #define u_lightSpotCosCutOffOuter "].spotCosCutOffOuter"
 
-#define u_emissiveColor "u_material.emissiveColor"
-#define u_ambientColor "u_material.ambientColor"
-#define u_diffuseColor "u_material.diffuseColor"
-#define u_diffuseTexture "u_material.diffuseTexture"
-#define u_specularColor "u_material.specularColor"
-#define u_specularTexture "u_material.specularTexture"
-#define u_shininess "u_material.shininess"
-#define u_normalMapTexture "u_material.normalMapTexture"
-#define u_reflectionColor "u_material.reflectionColor"
-#define u_refractionColor "u_material.refractionColor"
-#define u_transparency "u_material.transparency"
-#define u_dynamicCubeMapTexture "u_material.dynamicCubeMapTexture"
+#define u_materialBlock "MaterialBlock"
+#define MATERIAL_BLOCK_BINDING 0
+
+#define u_diffuseTexture "u_diffuseTexture"
+#define u_specularTexture "u_specularTexture"
+#define u_normalMapTexture "u_normalMapTexture"
+#define u_dynamicCubeMapTexture "u_dynamicCubeMapTexture"
+#define u_diffusePackedTexture "u_diffusePackedTexture"
+#define u_specularPackedTexture "u_specularPackedTexture"
+#define u_normalMapPackedTexture "u_normalMapPackedTexture"
+#define u_packedLayer "u_packedLayer"
+#define u_packedRegion "u_packedRegion"
+// First of the units of the diffuse, specular and normal map texture arrays, following the shadow textures.
+#define PACKED_TEXTURE_UNIT 9
 
 #define u_hasSkinning "u_hasSkinning"
 #define u_hasDiffuseTexture "u_hasDiffuseTexture"
@@ -56,6 +59,8 @@
 #define u_hasNormalMapTexture "u_hasNormalMapTexture"
 #define u_hasCubeMapTexture "u_hasCubeMapTexture"
 #define u_hasDynamicCubeMapTexture "u_hasDynamicCubeMapTexture"
+#define u_hasInstancing "u_hasInstancing"
+#define u_hasOctahedralNormals "u_hasOctahedralNormals"
 
 #define u_convertDirectX "u_convertDirectX"
 #define u_doTessellate "u_doTessellate"
@@ -64,6 +69,8 @@
 #define u_width "u_width"
 #define u_height "u_height"
 #define u_screenDistance "u_screenDistance"
+#define u_terrainTile "u_terrainTile"
+#define u_terrainMorph "u_terrainMorph"
 
 #define u_writeBrightColor "u_writeBrightColor"
 #define u_brightColorLimit "u_brightColorLimit"
@@ -73,12 +80,7 @@
 #define u_bindMatrix "u_bindMatrix"
 #define u_bindNormalMatrix "u_bindNormalMatrix"
 
-#define u_fontLeft "u_fontLeft"
-#define u_fontTop "u_fontTop"
-#define u_fontWidth "u_fontWidth"
-#define u_fontHeight "u_fontHeight"
 #define u_fontTexture "u_fontTexture"
-#define u_fontColor "u_fontColor"
 
 #define u_numberSamples "u_numberSamples"
 
@@ -127,6 +129,7 @@
 #define a_tangent "a_tangent"
 #define a_bitangent "a_bitangent"
 #define a_texCoord "a_texCoord"
+#define a_color "a_color"
 
 #define a_boneIndex_0 "a_boneIndex_0"
 #define a_boneIndex_1 "a_boneIndex_1"
@@ -134,4 +137,6 @@
 #define a_boneWeight_1 "a_boneWeight_1"
 #define a_boneCounter "a_boneCounter"
 
+#define a_instanceModelMatrix "a_instanceModelMatrix"
+
 #endif /* VARIABLES_H_ */
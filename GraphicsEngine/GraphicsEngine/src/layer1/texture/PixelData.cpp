@@ -9,6 +9,133 @@
 
 using namespace std;
 
+/**
+ * Lookup tables for sRGB encoded unsigned bytes.
+ */
+struct SRGBTables
+{
+	float toLinear[256];
+
+	float toUnit[256];
+
+	/**
+	 * Linear value at the middle between two codes.
+	 */
+	float thresholds[255];
+
+	/**
+	 * Approximated code for a quantized linear value, which is refined with the thresholds.
+	 */
+	std::uint8_t toCode[4096];
+
+	SRGBTables()
+	{
+		for (int32_t i = 0; i < 256; i++)
+		{
+			toLinear[i] = decode(static_cast<float>(i) / 255.0f);
+			toUnit[i] = static_cast<float>(i) / 255.0f;
+		}
+
+		for (int32_t i = 0; i < 255; i++)
+		{
+			thresholds[i] = decode((static_cast<float>(i) + 0.5f) / 255.0f);
+		}
+
+		for (int32_t i = 0; i < 4096; i++)
+		{
+			toCode[i] = static_cast<uint8_t>(upper_bound(thresholds, thresholds + 255, static_cast<float>(i) / 4095.0f) - thresholds);
+		}
+	}
+
+	static float decode(float value)
+	{
+		return value <= 0.04045f ? value / 12.92f : powf((value + 0.055f) / 1.055f, 2.4f);
+	}
+
+	std::uint8_t encode(float value) const
+	{
+		int32_t code = toCode[static_cast<int32_t>(glusMathClampf(value, 0.0f, 1.0f) * 4095.0f)];
+
+		// The codes are dense in the dark range, so the approximation can be off by a few codes.
+		while (code < 255 && value >= thresholds[code])
+		{
+			code++;
+		}
+		while (code > 0 && value < thresholds[code - 1])
+		{
+			code--;
+		}
+
+		return static_cast<uint8_t>(code);
+	}
+};
+
+static const SRGBTables& getSRGBTables()
+{
+	static const SRGBTables tables;
+
+	return tables;
+}
+
+static const int32_t KAISER_TAPS = 8;
+
+/**
+ * Weights of a Kaiser windowed sinc filter for halving the size.
+ */
+struct KaiserWeights
+{
+	float weights[KAISER_TAPS];
+
+	KaiserWeights()
+	{
+		const float alpha = 4.0f;
+		const float radius = static_cast<float>(KAISER_TAPS) * 0.5f;
+
+		float sum = 0.0f;
+
+		for (int32_t k = 0; k < KAISER_TAPS; k++)
+		{
+			float distance = fabsf(static_cast<float>(k) - radius + 0.5f);
+
+			float x = distance * 0.5f * GLUS_PI;
+			float sinc = sinf(x) / x;
+
+			float window = besselI0(alpha * sqrtf(1.0f - (distance / radius) * (distance / radius))) / besselI0(alpha);
+
+			weights[k] = sinc * window;
+
+			sum += weights[k];
+		}
+
+		for (int32_t k = 0; k < KAISER_TAPS; k++)
+		{
+			weights[k] /= sum;
+		}
+	}
+
+	static float besselI0(float x)
+	{
+		float sum = 1.0f;
+		float term = 1.0f;
+
+		for (int32_t k = 1; k < 16; k++)
+		{
+			term *= (x * 0.5f / static_cast<float>(k)) * (x * 0.5f / static_cast<float>(k));
+
+			sum += term;
+		}
+
+		return sum;
+	}
+};
+
+static const float* getKaiserWeights()
+{
+	static const KaiserWeights kaiserWeights;
+
+	return kaiserWeights.weights;
+}
+
 PixelData::PixelData() :
 		width(0), height(0), format(GL_RGB), type(GL_UNSIGNED_BYTE), pixels(nullptr), sizeOfData(0)
 {
@@ -30,7 +157,8 @@ PixelData::PixelData(int32_t width, int32_t height, GLenum format, GLenum type,
 	}
 }
 
-PixelData::PixelData(const PixelData& other)
+PixelData::PixelData(const PixelData& other) :
+		width(0), height(0), format(GL_RGB), type(GL_UNSIGNED_BYTE), pixels(nullptr), sizeOfData(0)
 {
 	setPixels(other);
 }
@@ -82,6 +210,32 @@ void PixelData::freePixels()
 	}
 }
 
+bool PixelData::allocatePixels(int32_t width, int32_t height, GLenum format, GLenum type, uint32_t sizeOfData)
+{
+	freePixels();
+
+	this->width = width;
+	this->height = height;
+	this->format = format;
+	this->type = type;
+
+	if (sizeOfData == 0)
+	{
+		return false;
+	}
+
+	pixels = new uint8_t[sizeOfData];
+
+	if (!pixels)
+	{
+		return false;
+	}
+
+	this->sizeOfData = sizeOfData;
+
+	return true;
+}
+
 std::int32_t PixelData::getWidth() const
 {
 	return width;
@@ -111,3 +265,387 @@ std::uint32_t PixelData::getSizeOfData() const
 {
 	return sizeOfData;
 }
+
+int32_t PixelData::getNumberChannels(GLenum format)
+{
+	switch (format)
+	{
+		case GL_RED:
+		case GL_ALPHA:
+		case GL_LUMINANCE:
+		case GL_DEPTH_COMPONENT:
+			return 1;
+		case GL_RG:
+		case GL_LUMINANCE_ALPHA:
+			return 2;
+		case GL_RGB:
+		case GL_BGR:
+			return 3;
+		case GL_RGBA:
+		case GL_BGRA:
+			return 4;
+	}
+
+	return 0;
+}
+
+bool PixelData::createMipLevel(PixelData& mipLevel) const
+{
+	int32_t channels = getNumberChannels(format);
+
+	if (!pixels || channels == 0 || (type != GL_UNSIGNED_BYTE && type != GL_FLOAT) || (width <= 1 && height <= 1))
+	{
+		return false;
+	}
+
+	int32_t mipWidth = width > 1 ? width / 2 : 1;
+	int32_t mipHeight = height > 1 ? height / 2 : 1;
+
+	uint32_t bytesPerChannel = type == GL_FLOAT ? sizeof(float) : sizeof(uint8_t);
+
+	uint32_t mipSizeOfData = static_cast<uint32_t>(mipWidth * mipHeight * channels) * bytesPerChannel;
+
+	vector<uint8_t> mipPixels(mipSizeOfData);
+
+	for (int32_t y = 0; y < mipHeight; y++)
+	{
+		// Odd sizes drop the last row or column, as the sizes of the mip levels are rounded down.
+		int32_t y0 = y * 2;
+		int32_t y1 = min(y * 2 + 1, height - 1);
+
+		for (int32_t x = 0; x < mipWidth; x++)
+		{
+			int32_t x0 = x * 2;
+			int32_t x1 = min(x * 2 + 1, width - 1);
+
+			int32_t source[4] = { (y0 * width + x0) * channels, (y0 * width + x1) * channels, (y1 * width + x0) * channels, (y1 * width + x1) * channels };
+
+			int32_t target = (y * mipWidth + x) * channels;
+
+			for (int32_t c = 0; c < channels; c++)
+			{
+				if (type == GL_FLOAT)
+				{
+					const float* sourcePixels = reinterpret_cast<const float*>(pixels);
+
+					reinterpret_cast<float*>(mipPixels.data())[target + c] = (sourcePixels[source[0] + c] + sourcePixels[source[1] + c] + sourcePixels[source[2] + c] + sourcePixels[source[3] + c]) * 0.25f;
+				}
+				else
+				{
+					mipPixels[target + c] = static_cast<uint8_t>((pixels[source[0] + c] + pixels[source[1] + c] + pixels[source[2] + c] + pixels[source[3] + c] + 2) / 4);
+				}
+			}
+		}
+	}
+
+	mipLevel = PixelData(mipWidth, mipHeight, format, type, mipPixels.data(), mipSizeOfData);
+
+	return true;
+}
+
+void PixelData::convertRowToLinear(int32_t y, bool sRGB, float* linearRow) const
+{
+	int32_t channels = getNumberChannels(format);
+
+	int32_t rowLength = width * channels;
+
+	if (type == GL_FLOAT)
+	{
+		memcpy(linearRow, reinterpret_cast<const float*>(pixels) + y * rowLength, rowLength * sizeof(float));
+
+		return;
+	}
+
+	const SRGBTables& tables = getSRGBTables();
+
+	// Only red, green and blue are encoded.
+	const float* allTables[4];
+
+	for (int32_t c = 0; c < channels; c++)
+	{
+		allTables[c] = sRGB && channels >= 3 && c < 3 ? tables.toLinear : tables.toUnit;
+	}
+
+	const uint8_t* row = pixels + y * rowLength;
+
+	for (int32_t i = 0; i < rowLength; i += channels)
+	{
+		for (int32_t c = 0; c < channels; c++)
+		{
+			linearRow[i + c] = allTables[c][row[i + c]];
+		}
+	}
+}
+
+const float* PixelData::getLinearRow(const PixelData* pixelData, const vector<float>& source, int32_t y, int32_t rowLength, bool sRGB, float* rowBuffer)
+{
+	if (!pixelData)
+	{
+		return &source[y * rowLength];
+	}
+
+	pixelData->convertRowToLinear(y, sRGB, rowBuffer);
+
+	return rowBuffer;
+}
+
+void PixelData::convertFromLinear(const vector<float>& linearPixels, int32_t width, int32_t height, GLenum format, GLenum type, bool sRGB, PixelData& pixelData)
+{
+	int32_t channels = getNumberChannels(format);
+
+	uint32_t numberValues = static_cast<uint32_t>(width * height * channels);
+
+	if (type == GL_FLOAT)
+	{
+		pixelData = PixelData(width, height, format, type, reinterpret_cast<const uint8_t*>(linearPixels.data()), numberValues * sizeof(float));
+
+		return;
+	}
+
+	const SRGBTables& tables = getSRGBTables();
+
+	int32_t colorChannels = sRGB && channels >= 3 ? 3 : 0;
+
+	vector<uint8_t> bytes(numberValues);
+
+	for (uint32_t i = 0; i < numberValues; i += channels)
+	{
+		for (int32_t c = 0; c < channels; c++)
+		{
+			if (c < colorChannels)
+			{
+				bytes[i + c] = tables.encode(linearPixels[i + c]);
+			}
+			else
+			{
+				bytes[i + c] = static_cast<uint8_t>(glusMathClampf(linearPixels[i + c], 0.0f, 1.0f) * 255.0f + 0.5f);
+			}
+		}
+	}
+
+	pixelData = PixelData(width, height, format, type, bytes.data(), numberValues);
+}
+
+void PixelData::downsampleBox(const PixelData* pixelData, const vector<float>& source, int32_t width, int32_t height, int32_t channels, bool sRGB, vector<float>& rowBuffer, vector<float>& target)
+{
+	int32_t mipWidth = width > 1 ? width / 2 : 1;
+	int32_t mipHeight = height > 1 ? height / 2 : 1;
+
+	int32_t rowLength = width * channels;
+
+	rowBuffer.resize(rowLength * 2);
+	target.resize(mipWidth * mipHeight * channels);
+
+	int32_t step = width > 1 ? channels : 0;
+
+	for (int32_t y = 0; y < mipHeight; y++)
+	{
+		// Odd sizes drop the last row or column, as in createMipLevel.
+		const float* row0 = getLinearRow(pixelData, source, y * 2, rowLength, sRGB, &rowBuffer[0]);
+		const float* row1 = getLinearRow(pixelData, source, min(y * 2 + 1, height - 1), rowLength, sRGB, &rowBuffer[rowLength]);
+
+		float* targetRow = &target[y * mipWidth * channels];
+
+		for (int32_t x = 0; x < mipWidth; x++)
+		{
+			const float* p0 = row0 + x * 2 * channels;
+			const float* p1 = row1 + x * 2 * channels;
+
+			for (int32_t c = 0; c < channels; c++)
+			{
+				targetRow[x * channels + c] = (p0[c] + p0[c + step] + p1[c] + p1[c + step]) * 0.25f;
+			}
+		}
+	}
+}
+
+void PixelData::downsampleKaiser(const PixelData* pixelData, const vector<float>& source, int32_t width, int32_t height, int32_t channels, bool sRGB, vector<float>& rowBuffer, vector<float>& temporary, vector<float>& target)
+{
+	const float* weights = getKaiserWeights();
+
+	int32_t mipWidth = width > 1 ? width / 2 : 1;
+	int32_t mipHeight = height > 1 ? height / 2 : 1;
+
+	int32_t rowLength = width * channels;
+
+	rowBuffer.resize(rowLength);
+	temporary.resize(mipWidth * height * channels);
+
+	// Horizontal pass. The taps are centered between the two source pixels of a target pixel.
+	for (int32_t y = 0; y < height; y++)
+	{
+		const float* sourceRow = getLinearRow(pixelData, source, y, rowLength, sRGB, rowBuffer.data());
+		float* targetRow = &temporary[y * mipWidth * channels];
+
+		if (width == 1)
+		{
+			memcpy(targetRow, sourceRow, channels * sizeof(float));
+
+			continue;
+		}
+
+		for (int32_t x = 0; x < mipWidth; x++)
+		{
+			int32_t firstX = x * 2 - KAISER_TAPS / 2 + 1;
+
+			float sum[4] = { 0.0f, 0.0f, 0.0f, 0.0f };
+
+			// Only the taps at the borders have to be clamped.
+			if (firstX >= 0 && firstX + KAISER_TAPS <= width)
+			{
+				const float* p = sourceRow + firstX * channels;
+
+				for (int32_t k = 0; k < KAISER_TAPS; k++)
+				{
+					for (int32_t c = 0; c < channels; c++)
+					{
+						sum[c] += p[k * channels + c] * weights[k];
+					}
+				}
+			}
+			else
+			{
+				for (int32_t k = 0; k < KAISER_TAPS; k++)
+				{
+					const float* p = sourceRow + min(max(firstX + k, 0), width - 1) * channels;
+
+					for (int32_t c = 0; c < channels; c++)
+					{
+						sum[c] += p[c] * weights[k];
+					}
+				}
+			}
+
+			for (int32_t c = 0; c < channels; c++)
+			{
+				targetRow[x * channels + c] = sum[c];
+			}
+		}
+	}
+
+	// Vertical pass over whole rows.
+	if (height > 1)
+	{
+		int32_t mipRowLength = mipWidth * channels;
+
+		target.assign(mipRowLength * mipHeight, 0.0f);
+
+		for (int32_t y = 0; y < mipHeight; y++)
+		{
+			float* targetRow = &target[y * mipRowLength];
+
+			for (int32_t k = 0; k < KAISER_TAPS; k++)
+			{
+				int32_t sourceY = min(max(y * 2 - KAISER_TAPS / 2 + 1 + k, 0), height - 1);
+
+				const float* sourceRow = &temporary[sourceY * mipRowLength];
+
+				float weight = weights[k];
+
+				for (int32_t i = 0; i < mipRowLength; i++)
+				{
+					targetRow[i] += sourceRow[i] * weight;
+				}
+			}
+		}
+	}
+	else
+	{
+		target.swap(temporary);
+	}
+}
+
+bool PixelData::createMipChain(vector<PixelData>& mipLevels, enum MipFilter mipFilter, bool sRGB) const
+{
+	int32_t channels = getNumberChannels(format);
+
+	mipLevels.clear();
+
+	if (!pixels || channels == 0 || (type != GL_UNSIGNED_BYTE && type != GL_FLOAT))
+	{
+		return false;
+	}
+
+	// Growing the vector would copy all levels again.
+	int32_t numberLevels = 1;
+
+	for (int32_t size = max(width, height); size > 1; size /= 2)
+	{
+		numberLevels++;
+	}
+
+	mipLevels.reserve(numberLevels);
+
+	mipLevels.push_back(*this);
+
+	vector<float> current;
+	vector<float> rowBuffer;
+	vector<float> temporary;
+	vector<float> next;
+
+	// The first level is read row by row from the pixels.
+	const PixelData* pixelData = this;
+
+	int32_t currentWidth = width;
+	int32_t currentHeight = height;
+
+	while (currentWidth > 1 || currentHeight > 1)
+	{
+		if (mipFilter == MipFilterKaiser)
+		{
+			downsampleKaiser(pixelData, current, currentWidth, currentHeight, channels, sRGB, rowBuffer, temporary, next);
+		}
+		else
+		{
+			downsampleBox(pixelData, current, currentWidth, currentHeight, channels, sRGB, rowBuffer, next);
+		}
+
+		currentWidth = currentWidth > 1 ? currentWidth / 2 : 1;
+		currentHeight = currentHeight > 1 ? currentHeight / 2 : 1;
+
+		mipLevels.push_back(PixelData());
+
+		convertFromLinear(next, currentWidth, currentHeight, format, type, sRGB, mipLevels.back());
+
+		current.swap(next);
+
+		pixelData = nullptr;
+	}
+
+	return true;
+}
+
+bool PixelData::copyPixels(const PixelData& source, int32_t x, int32_t y, int32_t border)
+{
+	int32_t channels = getNumberChannels(format);
+
+	if (!pixels || !source.pixels || channels == 0 || source.format != format || source.type != type || border < 0)
+	{
+		return false;
+	}
+
+	if (x - border < 0 || y - border < 0 || x + source.width + border > width || y + source.height + border > height)
+	{
+		return false;
+	}
+
+	uint32_t bytesPerPixel = static_cast<uint32_t>(channels) * (type == GL_FLOAT ? sizeof(float) : sizeof(uint8_t));
+
+	for (int32_t row = -border; row < source.height + border; row++)
+	{
+		int32_t sourceRow = (row % source.height + source.height) % source.height;
+
+		uint8_t* targetPixels = pixels + (static_cast<uint32_t>((y + row) * width + x) * bytesPerPixel);
+		const uint8_t* sourcePixels = source.pixels + static_cast<uint32_t>(sourceRow * source.width) * bytesPerPixel;
+
+		memcpy(targetPixels, sourcePixels, source.width * bytesPerPixel);
+
+		for (int32_t column = 1; column <= border; column++)
+		{
+			memcpy(targetPixels - column * bytesPerPixel, sourcePixels + ((source.width - column % source.width) % source.width) * bytesPerPixel, bytesPerPixel);
+			memcpy(targetPixels + (source.width + column - 1) * bytesPerPixel, sourcePixels + ((column - 1) % source.width) * bytesPerPixel, bytesPerPixel);
+		}
+	}
+
+	return true;
+}
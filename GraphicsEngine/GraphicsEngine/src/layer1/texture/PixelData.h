@@ -10,11 +10,33 @@
 
 #include "../../UsedLibs.h"
 
+enum MipFilter
+{
+	MipFilterBox, MipFilterKaiser
+};
+
 class PixelData
 {
 
 private:
 
+	/**
+	 * Converts a row to linear floats. Color channels of unsigned bytes are decoded from sRGB, if requested.
+	 */
+	void convertRowToLinear(std::int32_t y, bool sRGB, float* linearRow) const;
+
+	/**
+	 * Row of the level being downsampled. Either the row is converted from the given pixel data into the buffer or, if
+	 * there is no pixel data, it is taken from the linear source. This way, the first level is never stored as floats.
+	 */
+	static const float* getLinearRow(const PixelData* pixelData, const std::vector<float>& source, std::int32_t y, std::int32_t rowLength, bool sRGB, float* rowBuffer);
+
+	static void convertFromLinear(const std::vector<float>& linearPixels, std::int32_t width, std::int32_t height, GLenum format, GLenum type, bool sRGB, PixelData& pixelData);
+
+	static void downsampleBox(const PixelData* pixelData, const std::vector<float>& source, std::int32_t width, std::int32_t height, std::int32_t channels, bool sRGB, std::vector<float>& rowBuffer, std::vector<float>& target);
+
+	static void downsampleKaiser(const PixelData* pixelData, const std::vector<float>& source, std::int32_t width, std::int32_t height, std::int32_t channels, bool sRGB, std::vector<float>& rowBuffer, std::vector<float>& temporary, std::vector<float>& target);
+
 	std::int32_t width;
 	std::int32_t height;
 	GLenum format;
@@ -34,6 +56,13 @@ public:
 	void setPixels(const PixelData& other);
 	void freePixels();
 
+	/**
+	 * Replaces the pixels by uninitialized ones, e.g. for decoding directly into them.
+	 *
+	 * @return False, if the pixels could not be allocated.
+	 */
+	bool allocatePixels(std::int32_t width, std::int32_t height, GLenum format, GLenum type, std::uint32_t sizeOfData);
+
 	std::int32_t getWidth() const;
 	std::int32_t getHeight() const;
 	GLenum getFormat() const;
@@ -41,6 +70,38 @@ public:
 	std::uint8_t* getPixels() const;
 	std::uint32_t getSizeOfData() const;
 
+	/**
+	 * @return Number of channels of the format or zero, if not known.
+	 */
+	static std::int32_t getNumberChannels(GLenum format);
+
+	/**
+	 * Creates the next mip level with half the size using a box filter. Only unsigned byte and float pixels are supported.
+	 *
+	 * @return False, if the size is already one by one or the format is not supported.
+	 */
+	bool createMipLevel(PixelData& mipLevel) const;
+
+	/**
+	 * Creates all mip levels down to one by one, starting with a copy of these pixels. The levels are filtered in linear
+	 * space with float precision, so rounding errors do not accumulate. Only unsigned byte and float pixels are supported.
+	 * Does not need a context.
+	 *
+	 * @param mipFilter The Kaiser filter is sharper than the box filter, but slower.
+	 * @param sRGB If true, the color channels of unsigned byte pixels are treated as sRGB encoded. Alpha stays linear.
+	 *
+	 * @return False, if the format is not supported.
+	 */
+	bool createMipChain(std::vector<PixelData>& mipLevels, enum MipFilter mipFilter = MipFilterBox, bool sRGB = false) const;
+
+	/**
+	 * Copies the source pixels to the given position. The border around them is filled with the wrapped source pixels,
+	 * so filtering at the edges behaves as if the source is repeated. Format and type have to match.
+	 *
+	 * @return False, if the formats differ or the source including the border does not fit.
+	 */
+	bool copyPixels(const PixelData& source, std::int32_t x, std::int32_t y, std::int32_t border);
+
 };
 
 typedef std::shared_ptr<PixelData> PixelDataSP;
@@ -0,0 +1,52 @@
+/*
+ * StreamableTexture.h
+ *
+ *  Created on: 19.10.2026
+ *      Author: nopper
+ */
+
+#ifndef STREAMABLETEXTURE_H_
+#define STREAMABLETEXTURE_H_
+
+#include "../../UsedLibs.h"
+
+/**
+ * Texture, where only the mip levels from the resident level to the smallest one are in video memory.
+ */
+class StreamableTexture
+{
+
+public:
+
+	StreamableTexture()
+	{
+	}
+
+	virtual ~StreamableTexture()
+	{
+	}
+
+	virtual std::int32_t getNumberLevels() const = 0;
+
+	/**
+	 * @return Size in bytes of the given mip level.
+	 */
+	virtual std::uint32_t getLevelSize(std::int32_t level) const = 0;
+
+	/**
+	 * @return Larger value of the width and height of the given mip level.
+	 */
+	virtual std::int32_t getLevelResolution(std::int32_t level) const = 0;
+
+	virtual std::int32_t getResidentLevel() const = 0;
+
+	/**
+	 * Uploads or evicts mip levels, so all levels starting at the given one are resident.
+	 */
+	virtual bool setResidentLevel(std::int32_t level) = 0;
+
+};
+
+typedef std::shared_ptr<StreamableTexture> StreamableTextureSP;
+
+#endif /* STREAMABLETEXTURE_H_ */
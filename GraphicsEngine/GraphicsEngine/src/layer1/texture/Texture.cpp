@@ -116,3 +116,55 @@ void Texture::setInternalFormat(GLint internalFormat)
 		init();
 	}
 }
+
+uint64_t Texture::getMemorySize() const
+{
+	return static_cast<uint64_t>(width) * static_cast<uint64_t>(height) * static_cast<uint64_t>(getBytesPerPixel(internalFormat));
+}
+
+uint32_t Texture::getBytesPerPixel(GLint internalFormat)
+{
+	switch (internalFormat)
+	{
+		case GL_RED:
+		case GL_R8:
+			return 1;
+		case GL_RG:
+		case GL_RG8:
+		case GL_R16:
+		case GL_R16F:
+		case GL_DEPTH_COMPONENT16:
+			return 2;
+		case GL_RGB:
+		case GL_RGB8:
+		case GL_SRGB8:
+			return 3;
+		case GL_RGBA:
+		case GL_RGBA8:
+		case GL_SRGB8_ALPHA8:
+		case GL_RGB10_A2:
+		case GL_R11F_G11F_B10F:
+		case GL_RG16:
+		case GL_RG16F:
+		case GL_R32F:
+		case GL_DEPTH_COMPONENT:
+		case GL_DEPTH_COMPONENT24:
+		case GL_DEPTH_COMPONENT32:
+		case GL_DEPTH_COMPONENT32F:
+		case GL_DEPTH24_STENCIL8:
+			return 4;
+		case GL_RGB16F:
+			return 6;
+		case GL_RGBA16:
+		case GL_RGBA16F:
+		case GL_RG32F:
+		case GL_DEPTH32F_STENCIL8:
+			return 8;
+		case GL_RGB32F:
+			return 12;
+		case GL_RGBA32F:
+			return 16;
+	}
+
+	return 4;
+}
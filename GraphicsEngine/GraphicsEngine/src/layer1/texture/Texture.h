@@ -51,6 +51,16 @@ public:
 	GLint getInternalFormat() const;
 	void setInternalFormat(GLint internalFormat);
 
+	/**
+	 * @return Estimated size in bytes of the texture in video memory.
+	 */
+	virtual std::uint64_t getMemorySize() const;
+
+	/**
+	 * @return Bytes per pixel of an uncompressed internal format. Unknown formats are counted with four bytes.
+	 */
+	static std::uint32_t getBytesPerPixel(GLint internalFormat);
+
 };
 
 typedef std::shared_ptr<Texture> TextureSP;
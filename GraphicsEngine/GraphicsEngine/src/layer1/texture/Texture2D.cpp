@@ -5,28 +5,38 @@
  *      Author: nopper
  */
 
+#include "TextureCompressor.h"
+
 #include "Texture2D.h"
 
 using namespace std;
 
 Texture2D::Texture2D(const std::string& identifier, float red) :
-	TextureStandard(identifier, GL_TEXTURE_2D, red), pixelData(1, 1, GL_RGBA, GL_FLOAT, (const uint8_t*)&red, sizeof(float))
+	TextureStandard(identifier, GL_TEXTURE_2D, red), StreamableTexture(), pixelData(1, 1, GL_RGBA, GL_FLOAT, (const uint8_t*)&red, sizeof(float)), streamingResolution(0), allMipLevels(), residentLevel(0)
 {
 	init();
 }
 
 Texture2D::Texture2D(const string& identifier, const Color& color) :
-	TextureStandard(identifier, GL_TEXTURE_2D, color), pixelData(1, 1, GL_RGBA, GL_FLOAT, (const uint8_t*)color.getRGBA(), sizeof(Color))
+	TextureStandard(identifier, GL_TEXTURE_2D, color), StreamableTexture(), pixelData(1, 1, GL_RGBA, GL_FLOAT, (const uint8_t*)color.getRGBA(), sizeof(Color)), streamingResolution(0), allMipLevels(), residentLevel(0)
 {
 	init();
 }
 
-Texture2D::Texture2D(const string& identifier, GLint internalFormat, int32_t width, int32_t height, GLenum format, GLenum type, const uint8_t* pixels, uint32_t sizeOfData, bool mipMap, GLint minFilter, GLint magFilter, GLint wrapS, GLint wrapT, float anisotropic) :
-	TextureStandard(identifier, GL_TEXTURE_2D, internalFormat, width, height, format, type, sizeOfData, mipMap, minFilter, magFilter, wrapS, wrapT, anisotropic), pixelData(width, width, format, type, pixels, sizeOfData)
+Texture2D::Texture2D(const string& identifier, GLint internalFormat, int32_t width, int32_t height, GLenum format, GLenum type, const uint8_t* pixels, uint32_t sizeOfData, bool mipMap, GLint minFilter, GLint magFilter, GLint wrapS, GLint wrapT, float anisotropic, int32_t streamingResolution) :
+	TextureStandard(identifier, GL_TEXTURE_2D, internalFormat, width, height, format, type, sizeOfData, mipMap, minFilter, magFilter, wrapS, wrapT, anisotropic), StreamableTexture(), pixelData(width, height, format, type, pixels, sizeOfData), streamingResolution(streamingResolution), allMipLevels(), residentLevel(0)
 {
 	init();
 }
 
+Texture2D::Texture2D(const string& identifier, GLint internalFormat, vector<PixelData>& mipLevels, bool mipMap, GLint minFilter, GLint magFilter, GLint wrapS, GLint wrapT, float anisotropic, int32_t streamingResolution) :
+	TextureStandard(identifier, GL_TEXTURE_2D, internalFormat, mipLevels[0].getWidth(), mipLevels[0].getHeight(), mipLevels[0].getFormat(), mipLevels[0].getType(), mipLevels[0].getSizeOfData(), mipMap, minFilter, magFilter, wrapS, wrapT, anisotropic), StreamableTexture(), pixelData(mipLevels[0]), streamingResolution(streamingResolution), allMipLevels(), residentLevel(0)
+{
+	allMipLevels.swap(mipLevels);
+
+	init();
+}
+
 Texture2D::~Texture2D()
 {
 	freePixels();
@@ -54,11 +64,75 @@ bool Texture2D::init()
 	glPixelStorei(GL_PACK_ALIGNMENT, 1);
 	glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
 
-	glTexImage2D(target, 0, internalFormat, width, height, 0, format, type, pixelData.getPixels());
+	if (streamingResolution > 0 && mipMap && pixelData.getPixels() && allMipLevels.size() == 0)
+	{
+		pixelData.createMipChain(allMipLevels);
+	}
 
-	if (mipMap)
+	// Unsupported formats and single texels are not streamed.
+	if (allMipLevels.size() == 1)
+	{
+		allMipLevels.clear();
+	}
+
+	if (streamingResolution > 0 && allMipLevels.size() > 0 && pixelData.getPixels())
+	{
+		// The first mip level holds the pixels from now on.
+		pixelData.freePixels();
+
+		residentLevel = getNumberLevels() - 1;
+
+		while (residentLevel > 0 && getLevelResolution(residentLevel - 1) <= streamingResolution)
+		{
+			residentLevel--;
+		}
+	}
+
+	if (streamingResolution <= 0 && allMipLevels.size() > 0)
 	{
-		glGenerateMipmap(target);
+		// Mip levels created on the CPU replace the generation by the GL.
+		residentLevel = 0;
+
+		for (int32_t level = 0; level < getNumberLevels(); level++)
+		{
+			uploadLevel(level);
+		}
+
+		glTexParameteri(target, GL_TEXTURE_BASE_LEVEL, 0);
+		glTexParameteri(target, GL_TEXTURE_MAX_LEVEL, getNumberLevels() - 1);
+
+		allMipLevels.clear();
+	}
+	else if (isStreaming())
+	{
+		for (int32_t level = residentLevel; level < getNumberLevels(); level++)
+		{
+			uploadLevel(level);
+		}
+
+		glTexParameteri(target, GL_TEXTURE_BASE_LEVEL, residentLevel);
+		glTexParameteri(target, GL_TEXTURE_MAX_LEVEL, getNumberLevels() - 1);
+	}
+	else if (isCompressed())
+	{
+		glCompressedTexImage2D(target, 0, internalFormat, width, height, 0, pixelData.getSizeOfData(), pixelData.getPixels());
+
+		// Compressed levels can not be generated by the GL.
+		glTexParameteri(target, GL_TEXTURE_BASE_LEVEL, 0);
+		glTexParameteri(target, GL_TEXTURE_MAX_LEVEL, 0);
+	}
+	else
+	{
+		glTexImage2D(target, 0, internalFormat, width, height, 0, format, type, pixelData.getPixels());
+
+		// A previously streamed texture keeps its base level otherwise. The maximum level is the default of the GL.
+		glTexParameteri(target, GL_TEXTURE_BASE_LEVEL, 0);
+		glTexParameteri(target, GL_TEXTURE_MAX_LEVEL, 1000);
+
+		if (mipMap)
+		{
+			glGenerateMipmap(target);
+		}
 	}
 
 	glTexParameteri(target, GL_TEXTURE_MIN_FILTER, minFilter);
@@ -69,13 +143,183 @@ bool Texture2D::init()
 	return true;
 }
 
+bool Texture2D::setMipLevels(GLint internalFormat, vector<PixelData>& mipLevels, int32_t streamingResolution)
+{
+	if (mipLevels.size() == 0)
+	{
+		return false;
+	}
+
+	this->internalFormat = internalFormat;
+	this->width = mipLevels[0].getWidth();
+	this->height = mipLevels[0].getHeight();
+	this->format = mipLevels[0].getFormat();
+	this->type = mipLevels[0].getType();
+	this->sizeOfData = mipLevels[0].getSizeOfData();
+	this->streamingResolution = streamingResolution;
+
+	pixelData = mipLevels[0];
+
+	allMipLevels.clear();
+	allMipLevels.swap(mipLevels);
+
+	residentLevel = 0;
+
+	return init();
+}
+
 void Texture2D::freePixels()
 {
 	pixelData.freePixels();
+
+	allMipLevels.clear();
 }
 
 const PixelData& Texture2D::getPixelData() const
 {
+	if (isStreaming())
+	{
+		return allMipLevels[0];
+	}
+
 	return pixelData;
 }
 
+void Texture2D::uploadLevel(int32_t level) const
+{
+	const PixelData& mipLevel = allMipLevels[level];
+
+	if (isCompressed())
+	{
+		glCompressedTexImage2D(target, level, internalFormat, mipLevel.getWidth(), mipLevel.getHeight(), 0, mipLevel.getSizeOfData(), mipLevel.getPixels());
+
+		return;
+	}
+
+	glTexImage2D(target, level, internalFormat, mipLevel.getWidth(), mipLevel.getHeight(), 0, format, type, mipLevel.getPixels());
+}
+
+bool Texture2D::isCompressed() const
+{
+	return TextureCompressor::isCompressedFormat(internalFormat);
+}
+
+uint64_t Texture2D::getMemorySize() const
+{
+	uint64_t result = 0;
+
+	if (isStreaming())
+	{
+		for (int32_t level = residentLevel; level < getNumberLevels(); level++)
+		{
+			result += getLevelSize(level);
+		}
+
+		return result;
+	}
+
+	if (isCompressed())
+	{
+		result = TextureCompressor::getSizeOfData(internalFormat, width, height);
+	}
+	else
+	{
+		result = Texture::getMemorySize();
+	}
+
+	// A full mip chain adds a third.
+	if (mipMap)
+	{
+		result += result / 3;
+	}
+
+	return result;
+}
+
+bool Texture2D::isStreaming() const
+{
+	return allMipLevels.size() > 0;
+}
+
+int32_t Texture2D::getNumberLevels() const
+{
+	if (isStreaming())
+	{
+		return static_cast<int32_t>(allMipLevels.size());
+	}
+
+	return 1;
+}
+
+uint32_t Texture2D::getLevelSize(int32_t level) const
+{
+	if (isStreaming())
+	{
+		return allMipLevels[level].getSizeOfData();
+	}
+
+	return pixelData.getSizeOfData();
+}
+
+int32_t Texture2D::getLevelResolution(int32_t level) const
+{
+	if (isStreaming())
+	{
+		return max(allMipLevels[level].getWidth(), allMipLevels[level].getHeight());
+	}
+
+	return max(width, height);
+}
+
+int32_t Texture2D::getResidentLevel() const
+{
+	return residentLevel;
+}
+
+bool Texture2D::setResidentLevel(int32_t level)
+{
+	if (!isStreaming() || !textureName || level < 0 || level >= getNumberLevels())
+	{
+		return false;
+	}
+
+	if (level == residentLevel)
+	{
+		return true;
+	}
+
+	glBindTexture(target, textureName);
+
+	glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+
+	if (level < residentLevel)
+	{
+		for (int32_t currentLevel = residentLevel - 1; currentLevel >= level; currentLevel--)
+		{
+			uploadLevel(currentLevel);
+		}
+
+		glTexParameteri(target, GL_TEXTURE_BASE_LEVEL, level);
+	}
+	else
+	{
+		glTexParameteri(target, GL_TEXTURE_BASE_LEVEL, level);
+
+		// Levels below the base level are not used, so an empty image releases the memory.
+		for (int32_t currentLevel = residentLevel; currentLevel < level; currentLevel++)
+		{
+			if (isCompressed())
+			{
+				glCompressedTexImage2D(target, currentLevel, internalFormat, 0, 0, 0, 0, nullptr);
+			}
+			else
+			{
+				glTexImage2D(target, currentLevel, internalFormat, 0, 0, 0, format, type, nullptr);
+			}
+		}
+	}
+
+	residentLevel = level;
+
+	return true;
+}
@@ -9,28 +9,76 @@
 #define TEXTURE2D_H_
 
 #include "PixelData.h"
+#include "StreamableTexture.h"
 #include "TextureStandard.h"
 
-class Texture2D : public TextureStandard
+class Texture2D : public TextureStandard, public StreamableTexture
 {
 
 private:
 
 	PixelData pixelData;
 
+	std::int32_t streamingResolution;
+
+	std::vector<PixelData> allMipLevels;
+
+	std::int32_t residentLevel;
+
+	void uploadLevel(std::int32_t level) const;
+
 public:
 
 	Texture2D(const std::string& identifier, float red);
 	Texture2D(const std::string& identifier, const Color& color);
-	Texture2D(const std::string& identifier, GLint internalFormat, std::int32_t width, std::int32_t height, GLenum format, GLenum type, const std::uint8_t* pixels, std::uint32_t sizeOfData, bool mipMap, GLint minFilter, GLint magFilter, GLint wrapS, GLint wrapT, float anisotropic);
+	/**
+	 * @param streamingResolution If larger than zero and mip mapped, the mip levels are kept on the CPU and only the ones up
+	 *                            to this resolution are uploaded initially. The others are uploaded by streaming.
+	 */
+	Texture2D(const std::string& identifier, GLint internalFormat, std::int32_t width, std::int32_t height, GLenum format, GLenum type, const std::uint8_t* pixels, std::uint32_t sizeOfData, bool mipMap, GLint minFilter, GLint magFilter, GLint wrapS, GLint wrapT, float anisotropic, std::int32_t streamingResolution = 0);
+	/**
+	 * Creates the texture from mip levels, e.g. compressed ones. The levels are moved into the texture.
+	 *
+	 * @param mipLevels Levels starting with the largest one. Must not be empty.
+	 */
+	Texture2D(const std::string& identifier, GLint internalFormat, std::vector<PixelData>& mipLevels, bool mipMap, GLint minFilter, GLint magFilter, GLint wrapS, GLint wrapT, float anisotropic, std::int32_t streamingResolution = 0);
 	virtual ~Texture2D();
 
 	virtual bool init();
 
+	/**
+	 * Replaces the pixels by the given mip levels, e.g. created on a worker thread. The levels are moved into the texture.
+	 *
+	 * @param streamingResolution If larger than zero, the levels are streamed. Otherwise, all levels are uploaded.
+	 */
+	bool setMipLevels(GLint internalFormat, std::vector<PixelData>& mipLevels, std::int32_t streamingResolution = 0);
+
 	virtual void freePixels();
 
 	const PixelData& getPixelData() const;
 
+	bool isStreaming() const;
+
+	/**
+	 * @return True, if the internal format is block compressed. The pixel data holds the blocks then.
+	 */
+	bool isCompressed() const;
+
+	/**
+	 * @return Size in bytes of the resident mip levels in video memory.
+	 */
+	virtual std::uint64_t getMemorySize() const;
+
+	virtual std::int32_t getNumberLevels() const;
+
+	virtual std::uint32_t getLevelSize(std::int32_t level) const;
+
+	virtual std::int32_t getLevelResolution(std::int32_t level) const;
+
+	virtual std::int32_t getResidentLevel() const;
+
+	virtual bool setResidentLevel(std::int32_t level);
+
 };
 
 typedef std::shared_ptr<Texture2D> Texture2DSP;
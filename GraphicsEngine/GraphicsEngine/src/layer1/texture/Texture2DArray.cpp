@@ -10,7 +10,7 @@
 using namespace std;
 
 Texture2DArray::Texture2DArray(const string& identifier, GLint internalFormat, int32_t width, int32_t height, GLenum format, GLenum type, bool mipMap, GLint minFilter, GLint magFilter, GLint wrapS, GLint wrapT, float anisotropic) :
-	TextureStandard(identifier, GL_TEXTURE_2D_ARRAY, internalFormat, width, height, format, type, sizeOfData, mipMap, minFilter, magFilter, wrapS, wrapT, anisotropic)
+	TextureStandard(identifier, GL_TEXTURE_2D_ARRAY, internalFormat, width, height, format, type, 0, mipMap, minFilter, magFilter, wrapS, wrapT, anisotropic), allPixelData(), maxLevel(1000)
 {
 	init();
 }
@@ -64,6 +64,8 @@ bool Texture2DArray::init()
 		glGenerateMipmap(target);
 	}
 
+	glTexParameteri(target, GL_TEXTURE_MAX_LEVEL, mipMap ? maxLevel : 0);
+
 	glTexParameteri(target, GL_TEXTURE_MIN_FILTER, minFilter);
 	glTexParameteri(target, GL_TEXTURE_MAG_FILTER, magFilter);
 	glTexParameteri(target, GL_TEXTURE_WRAP_S, wrapS);
@@ -99,3 +101,20 @@ bool Texture2DArray::addPixelData(const PixelDataSP& pixelData)
 
 	return true;
 }
+
+void Texture2DArray::setMaxLevel(int32_t maxLevel)
+{
+	this->maxLevel = maxLevel > 0 ? maxLevel : 0;
+
+	if (textureName)
+	{
+		glBindTexture(target, textureName);
+
+		glTexParameteri(target, GL_TEXTURE_MAX_LEVEL, mipMap ? this->maxLevel : 0);
+	}
+}
+
+int32_t Texture2DArray::getMaxLevel() const
+{
+	return maxLevel;
+}
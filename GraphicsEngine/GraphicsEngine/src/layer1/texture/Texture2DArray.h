@@ -18,6 +18,8 @@ private:
 
 	std::vector<PixelDataSP> allPixelData;
 
+	std::int32_t maxLevel;
+
 public:
 
 	Texture2DArray(const std::string& identifier, GLint internalFormat, std::int32_t width, std::int32_t height, GLenum format, GLenum type, bool mipMap, GLint minFilter, GLint magFilter, GLint wrapS, GLint wrapT, float anisotropic);
@@ -29,6 +31,13 @@ public:
 
 	bool addPixelData(const PixelDataSP& pixelData);
 
+	/**
+	 * @param maxLevel Coarsest mip level, which is sampled. All levels are sampled by default.
+	 */
+	void setMaxLevel(std::int32_t maxLevel);
+
+	std::int32_t getMaxLevel() const;
+
 };
 
 typedef std::shared_ptr<Texture2DArray> Texture2DArraySP;
@@ -5,12 +5,21 @@
  *      Author: Norbert Nopper
  */
 
+#include "../../layer0/os/Directory.h"
+#include "TextureDecoder.h"
 #include "TextureFactory.h"
+#include "TextureStreamingManager.h"
+#include "TextureUploadManager.h"
 
 #include "Texture2DManager.h"
 
 using namespace std;
 
+void Texture2DCache::evicting(const string& /*key*/, const Texture2DSP& value)
+{
+	TextureStreamingManager::getInstance()->removeTexture(value.get());
+}
+
 Texture2DManager::Texture2DManager() :
 		Singleton<Texture2DManager>(), allTextures()
 {
@@ -30,7 +39,12 @@ Texture2DManager::~Texture2DManager()
 
 void Texture2DManager::addTexture(const string& key, const Texture2DSP& texture)
 {
-	allTextures[key] = texture;
+	allTextures.replace(key, texture);
+}
+
+Texture2DSP Texture2DManager::getTexture(const string& key) const
+{
+	return allTextures.search(key);
 }
 
 Texture2DSP Texture2DManager::createTexture(const string& filename, bool mipMap, GLint minFilter, GLint magFilter, GLint wrapS, GLint wrapT, float anisotropic)
@@ -39,9 +53,17 @@ Texture2DSP Texture2DManager::createTexture(const string& filename, bool mipMap,
 
 	if (!allTextures.contains(filename))
 	{
-		allTextures[filename] = textureFactory.loadTexture2D(filename, mipMap, minFilter, magFilter, wrapS, wrapT, anisotropic);
+		// Does not need the context, so the file is decoded by the workers.
+		if (TextureDecoder::isSupportedFilename(filename))
+		{
+			return TextureUploadManager::getInstance()->loadTexture2D(filename, false, MipFilterBox, TextureCompressionNone, mipMap, minFilter, magFilter, wrapS, wrapT, anisotropic);
+		}
 
-		return allTextures[filename];
+		Texture2DSP texture2D = textureFactory.loadTexture2D(filename, mipMap, minFilter, magFilter, wrapS, wrapT, anisotropic);
+
+		allTextures.replace(filename, texture2D);
+
+		return texture2D;
 	}
 
 	return allTextures[filename];
@@ -53,9 +75,11 @@ Texture2DSP Texture2DManager::createTexture(const string& key, int32_t width, in
 
 	if (!allTextures.contains(key))
 	{
-		allTextures[key] = textureFactory.createTexture2D(key, width, height, format, type, mipMap, minFilter, magFilter, wrapS, wrapT, anisotropic);
+		Texture2DSP texture2D = textureFactory.createTexture2D(key, width, height, format, type, mipMap, minFilter, magFilter, wrapS, wrapT, anisotropic);
+
+		allTextures.replace(key, texture2D);
 
-		return allTextures[key];
+		return texture2D;
 	}
 
 	return allTextures[key];
@@ -67,9 +91,11 @@ Texture2DSP Texture2DManager::createTexture(const string& key, GLint internalFor
 
 	if (!allTextures.contains(key))
 	{
-		allTextures[key] = textureFactory.createTexture2D(key, internalFormat, width, height, format, type, mipMap, minFilter, magFilter, wrapS, wrapT, anisotropic);
+		Texture2DSP texture2D = textureFactory.createTexture2D(key, internalFormat, width, height, format, type, mipMap, minFilter, magFilter, wrapS, wrapT, anisotropic);
 
-		return allTextures[key];
+		allTextures.replace(key, texture2D);
+
+		return texture2D;
 	}
 
 	return allTextures[key];
@@ -81,10 +107,89 @@ Texture2DSP Texture2DManager::createTexture(const string& key, GLint internalFor
 
 	if (!allTextures.contains(key))
 	{
-		allTextures[key] = textureFactory.createTexture2D(key, internalFormat, width, height, format, type, pixels, sizeOfData, mipMap, minFilter, magFilter, wrapS, wrapT, anisotropic);
+		Texture2DSP texture2D = textureFactory.createTexture2D(key, internalFormat, width, height, format, type, pixels, sizeOfData, mipMap, minFilter, magFilter, wrapS, wrapT, anisotropic);
+
+		allTextures.replace(key, texture2D);
 
-		return allTextures[key];
+		return texture2D;
 	}
 
 	return allTextures[key];
 }
+
+int32_t Texture2DManager::reloadTextures(const string& canonicalFilename)
+{
+	TextureFactory textureFactory;
+
+	int32_t numberReloaded = 0;
+
+	auto walker = allTextures.begin();
+	while (walker != allTextures.end())
+	{
+		const string& filename = walker->first;
+		Texture2DSP texture2D = walker->second;
+
+		walker++;
+
+		if (!texture2D.get() || Directory::getCanonicalName(filename) != canonicalFilename)
+		{
+			continue;
+		}
+
+		PixelData pixelData;
+
+		if (!textureFactory.loadPixelData(filename, pixelData))
+		{
+			glusLogPrint(GLUS_LOG_WARNING, "Keeping previous texture: %s", filename.c_str());
+
+			continue;
+		}
+
+		GLint internalFormat = textureFactory.gatherInternalFormat(pixelData.getFormat(), pixelData.getType());
+
+		int32_t streamingResolution = texture2D->isMipMap() ? TextureStreamingManager::getInstance()->getStreamingResolution() : 0;
+
+		vector<PixelData> mipLevels;
+
+		// Streamed levels are created on the CPU. Otherwise, the GL generates them.
+		if (streamingResolution <= 0 || !pixelData.createMipChain(mipLevels))
+		{
+			mipLevels.assign(1, pixelData);
+		}
+
+		// Registered again with its new levels, as done for uploaded textures.
+		TextureStreamingManager::getInstance()->removeTexture(texture2D.get());
+
+		if (texture2D->setMipLevels(internalFormat, mipLevels, streamingResolution))
+		{
+			numberReloaded++;
+		}
+
+		if (texture2D->isStreaming())
+		{
+			TextureStreamingManager::getInstance()->addTexture(texture2D);
+		}
+	}
+
+	return numberReloaded;
+}
+
+void Texture2DManager::setBudget(uint64_t budget)
+{
+	allTextures.setBudget(budget);
+}
+
+uint64_t Texture2DManager::getBudget() const
+{
+	return allTextures.getBudget();
+}
+
+int32_t Texture2DManager::trim()
+{
+	return allTextures.trim();
+}
+
+ResourceCacheStatistics Texture2DManager::getStatistics() const
+{
+	return allTextures.getStatistics();
+}
@@ -10,11 +10,23 @@
 
 #include "../../UsedLibs.h"
 
-#include "../../layer0/stereotype/KeyValueMap.h"
+#include "../../layer0/stereotype/ResourceCache.h"
 #include "../../layer0/stereotype/Singleton.h"
 
 #include "Texture2D.h"
 
+/**
+ * Stops streaming of evicted textures.
+ */
+class Texture2DCache : public ResourceCache<std::string, Texture2DSP>
+{
+
+protected:
+
+	virtual void evicting(const std::string& key, const Texture2DSP& value);
+
+};
+
 class Texture2DManager : public Singleton<Texture2DManager>
 {
 
@@ -22,7 +34,7 @@ class Texture2DManager : public Singleton<Texture2DManager>
 
 private:
 
-	KeyValueMap<std::string, Texture2DSP> allTextures;
+	Texture2DCache allTextures;
 
 private:
 
@@ -33,6 +45,15 @@ public:
 
 	void addTexture(const std::string& key, const Texture2DSP& texture);
 
+	/**
+	 * @return The stored texture or an empty pointer, if none is stored by the key.
+	 */
+	Texture2DSP getTexture(const std::string& key) const;
+
+	/**
+	 * TGA, HDR and KTX files are decoded by the texture upload manager, so a placeholder is returned until the pixels are
+	 * uploaded. Other files are loaded directly.
+	 */
 	Texture2DSP createTexture(const std::string& filename, bool mipMap = true, GLint minFilter = GL_LINEAR_MIPMAP_LINEAR, GLint magFilter = GL_LINEAR, GLint wrapS = GL_REPEAT, GLint wrapT = GL_REPEAT, float anisotropic = 1.0f);
 
 	Texture2DSP createTexture(const std::string& key, std::int32_t width, std::int32_t height, GLenum format, GLenum type, bool mipMap = true, GLint minFilter = GL_LINEAR_MIPMAP_LINEAR, GLint magFilter = GL_LINEAR, GLint wrapS = GL_REPEAT, GLint wrapT = GL_REPEAT, float anisotropic = 1.0f);
@@ -41,6 +62,33 @@ public:
 
 	Texture2DSP createTexture(const std::string& key, GLint internalFormat, std::int32_t width, std::int32_t height, GLenum format, GLenum type, const std::uint8_t* pixels, std::uint32_t sizeOfData, bool mipMap = true, GLint minFilter = GL_LINEAR_MIPMAP_LINEAR, GLint magFilter = GL_LINEAR, GLint wrapS = GL_REPEAT, GLint wrapT = GL_REPEAT, float anisotropic = 1.0f);
 
+	/**
+	 * Loads the textures, which are stored by the filename, again and replaces their pixels. The texture objects are kept,
+	 * so all users get the new pixels.
+	 *
+	 * @param canonicalFilename Name as created by Directory::getCanonicalName.
+	 *
+	 * @return Number of reloaded textures.
+	 */
+	std::int32_t reloadTextures(const std::string& canonicalFilename);
+
+	/**
+	 * @param budget Maximum of bytes of all textures in video memory. Textures exceeding it are evicted, if they are not
+	 *               used anymore. Zero is unlimited.
+	 */
+	void setBudget(std::uint64_t budget);
+
+	std::uint64_t getBudget() const;
+
+	/**
+	 * Evicts unused textures, until the budget is kept, e.g. after unloading a level.
+	 *
+	 * @return Number of evicted textures.
+	 */
+	std::int32_t trim();
+
+	ResourceCacheStatistics getStatistics() const;
+
 };
 
 #endif /* TEXTURE2DMANAGER_H_ */
@@ -0,0 +1,66 @@
+/*
+ * TextureBindingSet.cpp
+ *
+ *  Created on: 19.10.2026
+ *      Author: nopper
+ */
+
+#include "../shader/RenderStateCache.h"
+
+#include "TextureBindingSet.h"
+
+using namespace std;
+
+TextureBindingSet::TextureBindingSet() :
+	numberBindings(0)
+{
+}
+
+TextureBindingSet::~TextureBindingSet()
+{
+}
+
+void TextureBindingSet::clear()
+{
+	numberBindings = 0;
+}
+
+void TextureBindingSet::addBinding(GLenum unit, GLenum target, GLuint name)
+{
+	assert(numberBindings < MAX_BINDINGS);
+
+	units[numberBindings] = unit;
+	targets[numberBindings] = target;
+	names[numberBindings] = name;
+
+	numberBindings++;
+}
+
+int32_t TextureBindingSet::getNumberBindings() const
+{
+	return numberBindings;
+}
+
+GLuint TextureBindingSet::getName(int32_t index) const
+{
+	return names[index];
+}
+
+void TextureBindingSet::bind() const
+{
+	for (int32_t i = 0; i < numberBindings; i++)
+	{
+		RenderStateCache::getInstance()->bindTexture(units[i], targets[i], names[i]);
+	}
+}
+
+void TextureBindingSet::unbind() const
+{
+	for (int32_t i = 0; i < numberBindings; i++)
+	{
+		if (names[i] != 0)
+		{
+			RenderStateCache::getInstance()->bindTexture(units[i], targets[i], 0);
+		}
+	}
+}
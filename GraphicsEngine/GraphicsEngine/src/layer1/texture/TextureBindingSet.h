@@ -0,0 +1,53 @@
+/*
+ * TextureBindingSet.h
+ *
+ *  Created on: 19.10.2026
+ *      Author: nopper
+ */
+
+#ifndef TEXTUREBINDINGSET_H_
+#define TEXTUREBINDINGSET_H_
+
+#include "../../UsedLibs.h"
+
+/**
+ * Fixed set of texture unit, target and name triples, which is bound in one go through the render state cache.
+ */
+class TextureBindingSet
+{
+
+private:
+
+	static const std::int32_t MAX_BINDINGS = 8;
+
+	std::int32_t numberBindings;
+
+	GLenum units[MAX_BINDINGS];
+
+	GLenum targets[MAX_BINDINGS];
+
+	GLuint names[MAX_BINDINGS];
+
+public:
+
+	TextureBindingSet();
+	virtual ~TextureBindingSet();
+
+	void clear();
+
+	void addBinding(GLenum unit, GLenum target, GLuint name);
+
+	std::int32_t getNumberBindings() const;
+
+	GLuint getName(std::int32_t index) const;
+
+	void bind() const;
+
+	/**
+	 * Binds zero to all used units.
+	 */
+	void unbind() const;
+
+};
+
+#endif /* TEXTUREBINDINGSET_H_ */
@@ -0,0 +1,1418 @@
+/*
+ * TextureCompressor.cpp
+ *
+ *  Created on: 19.10.2026
+ *      Author: nopper
+ */
+
+#include "TextureCompressor.h"
+
+using namespace std;
+
+// Interpolation weights of the 4 bit indices of BC7.
+static const int32_t BC7_WEIGHTS[16] = { 0, 4, 9, 13, 17, 21, 26, 30, 34, 38, 43, 47, 51, 55, 60, 64 };
+
+// Modifier tables of the ETC1 compatible modes. The selectors 0 to 3 add a, b, -a and -b.
+static const int32_t ETC_MODIFIERS[8][2] = { { 2, 8 }, { 5, 17 }, { 9, 29 }, { 13, 42 }, { 18, 60 }, { 24, 80 }, { 33, 106 }, { 47, 183 } };
+
+static int32_t clampByte(int32_t value)
+{
+	return min(max(value, 0), 255);
+}
+
+static int32_t square(int32_t value)
+{
+	return value * value;
+}
+
+/**
+ * Mean and normalized direction of the largest variance of the colors. The direction is zero for a constant block.
+ */
+static void calculatePrincipalAxis(const float colors[16][4], int32_t channels, float mean[4], float axis[4])
+{
+	for (int32_t c = 0; c < 4; c++)
+	{
+		mean[c] = 0.0f;
+		axis[c] = 0.0f;
+	}
+
+	for (int32_t i = 0; i < 16; i++)
+	{
+		for (int32_t c = 0; c < channels; c++)
+		{
+			mean[c] += colors[i][c] / 16.0f;
+		}
+	}
+
+	float covariance[4][4] = { { 0.0f } };
+
+	for (int32_t i = 0; i < 16; i++)
+	{
+		for (int32_t row = 0; row < channels; row++)
+		{
+			for (int32_t column = 0; column < channels; column++)
+			{
+				covariance[row][column] += (colors[i][row] - mean[row]) * (colors[i][column] - mean[column]);
+			}
+		}
+	}
+
+	// Power iteration, starting with the row of the largest variance.
+	int32_t largest = 0;
+
+	for (int32_t c = 1; c < channels; c++)
+	{
+		if (covariance[c][c] > covariance[largest][largest])
+		{
+			largest = c;
+		}
+	}
+
+	if (covariance[largest][largest] <= 0.0f)
+	{
+		return;
+	}
+
+	for (int32_t c = 0; c < channels; c++)
+	{
+		axis[c] = covariance[largest][c];
+	}
+
+	for (int32_t iteration = 0; iteration < 8; iteration++)
+	{
+		float next[4] = { 0.0f, 0.0f, 0.0f, 0.0f };
+
+		float length = 0.0f;
+
+		for (int32_t row = 0; row < channels; row++)
+		{
+			for (int32_t column = 0; column < channels; column++)
+			{
+				next[row] += covariance[row][column] * axis[column];
+			}
+
+			length += next[row] * next[row];
+		}
+
+		if (length <= 0.0f)
+		{
+			return;
+		}
+
+		length = sqrtf(length);
+
+		for (int32_t c = 0; c < channels; c++)
+		{
+			axis[c] = next[c] / length;
+		}
+	}
+}
+
+/**
+ * End points on the principal axis, which enclose all colors.
+ */
+static void calculateEndpoints(const float colors[16][4], int32_t channels, float endpoint0[4], float endpoint1[4])
+{
+	float mean[4];
+	float axis[4];
+
+	calculatePrincipalAxis(colors, channels, mean, axis);
+
+	float minProjection = 0.0f;
+	float maxProjection = 0.0f;
+
+	for (int32_t i = 0; i < 16; i++)
+	{
+		float projection = 0.0f;
+
+		for (int32_t c = 0; c < channels; c++)
+		{
+			projection += (colors[i][c] - mean[c]) * axis[c];
+		}
+
+		minProjection = min(minProjection, projection);
+		maxProjection = max(maxProjection, projection);
+	}
+
+	for (int32_t c = 0; c < 4; c++)
+	{
+		endpoint0[c] = mean[c] + axis[c] * maxProjection;
+		endpoint1[c] = mean[c] + axis[c] * minProjection;
+	}
+}
+
+/**
+ * Least squares fit of the end points for the given interpolation weights of the first end point.
+ *
+ * @return False, if the weights do not determine the end points.
+ */
+static bool solveEndpoints(const float colors[16][4], int32_t channels, const float weights[16], float endpoint0[4], float endpoint1[4])
+{
+	float alpha2 = 0.0f;
+	float beta2 = 0.0f;
+	float alphaBeta = 0.0f;
+
+	float alphaX[4] = { 0.0f, 0.0f, 0.0f, 0.0f };
+	float betaX[4] = { 0.0f, 0.0f, 0.0f, 0.0f };
+
+	for (int32_t i = 0; i < 16; i++)
+	{
+		float alpha = weights[i];
+		float beta = 1.0f - weights[i];
+
+		alpha2 += alpha * alpha;
+		beta2 += beta * beta;
+		alphaBeta += alpha * beta;
+
+		for (int32_t c = 0; c < channels; c++)
+		{
+			alphaX[c] += alpha * colors[i][c];
+			betaX[c] += beta * colors[i][c];
+		}
+	}
+
+	float determinant = alpha2 * beta2 - alphaBeta * alphaBeta;
+
+	if (fabsf(determinant) < 1.0e-6f)
+	{
+		return false;
+	}
+
+	for (int32_t c = 0; c < channels; c++)
+	{
+		endpoint0[c] = (alphaX[c] * beta2 - betaX[c] * alphaBeta) / determinant;
+		endpoint1[c] = (betaX[c] * alpha2 - alphaX[c] * alphaBeta) / determinant;
+	}
+
+	return true;
+}
+
+//
+// BC1
+//
+
+static uint16_t pack565(const float color[4])
+{
+	int32_t red = min(max(static_cast<int32_t>(color[0] * 31.0f / 255.0f + 0.5f), 0), 31);
+	int32_t green = min(max(static_cast<int32_t>(color[1] * 63.0f / 255.0f + 0.5f), 0), 63);
+	int32_t blue = min(max(static_cast<int32_t>(color[2] * 31.0f / 255.0f + 0.5f), 0), 31);
+
+	return static_cast<uint16_t>((red << 11) | (green << 5) | blue);
+}
+
+static void unpack565(uint16_t packed, int32_t color[3])
+{
+	int32_t red = (packed >> 11) & 31;
+	int32_t green = (packed >> 5) & 63;
+	int32_t blue = packed & 31;
+
+	color[0] = (red << 3) | (red >> 2);
+	color[1] = (green << 2) | (green >> 4);
+	color[2] = (blue << 3) | (blue >> 2);
+}
+
+static void createPaletteBC1(uint16_t color0, uint16_t color1, bool fourColors, int32_t palette[4][4])
+{
+	unpack565(color0, palette[0]);
+	unpack565(color1, palette[1]);
+
+	for (int32_t c = 0; c < 3; c++)
+	{
+		if (fourColors)
+		{
+			palette[2][c] = (2 * palette[0][c] + palette[1][c]) / 3;
+			palette[3][c] = (palette[0][c] + 2 * palette[1][c]) / 3;
+		}
+		else
+		{
+			palette[2][c] = (palette[0][c] + palette[1][c]) / 2;
+			palette[3][c] = 0;
+		}
+	}
+
+	palette[0][3] = 255;
+	palette[1][3] = 255;
+	palette[2][3] = 255;
+	palette[3][3] = fourColors ? 255 : 0;
+}
+
+/**
+ * @return Squared error of the best indices for the end points. Always uses the four color mode.
+ */
+static int32_t fitBC1(const uint8_t block[64], uint16_t color0, uint16_t color1, uint32_t& indices)
+{
+	int32_t palette[4][4];
+
+	createPaletteBC1(color0, color1, true, palette);
+
+	int32_t error = 0;
+
+	indices = 0;
+
+	for (int32_t i = 0; i < 16; i++)
+	{
+		int32_t bestIndex = 0;
+		int32_t bestError = INT32_MAX;
+
+		for (int32_t index = 0; index < 4; index++)
+		{
+			int32_t currentError = square(block[i * 4 + 0] - palette[index][0]) + square(block[i * 4 + 1] - palette[index][1]) + square(block[i * 4 + 2] - palette[index][2]);
+
+			if (currentError < bestError)
+			{
+				bestError = currentError;
+				bestIndex = index;
+			}
+		}
+
+		indices |= static_cast<uint32_t>(bestIndex) << (i * 2);
+
+		error += bestError;
+	}
+
+	return error;
+}
+
+void TextureCompressor::encodeBC1(const uint8_t block[64], uint8_t* output)
+{
+	float colors[16][4];
+
+	for (int32_t i = 0; i < 16; i++)
+	{
+		for (int32_t c = 0; c < 4; c++)
+		{
+			colors[i][c] = static_cast<float>(block[i * 4 + c]);
+		}
+	}
+
+	float endpoint0[4];
+	float endpoint1[4];
+
+	calculateEndpoints(colors, 3, endpoint0, endpoint1);
+
+	uint16_t color0 = pack565(endpoint0);
+	uint16_t color1 = pack565(endpoint1);
+
+	uint32_t indices;
+
+	int32_t error = fitBC1(block, color0, color1, indices);
+
+	// Refine the end points for the chosen indices, as long as the error decreases.
+	const float weightOfIndex[4] = { 1.0f, 0.0f, 2.0f / 3.0f, 1.0f / 3.0f };
+
+	for (int32_t iteration = 0; iteration < 2 && error > 0; iteration++)
+	{
+		float weights[16];
+
+		for (int32_t i = 0; i < 16; i++)
+		{
+			weights[i] = weightOfIndex[(indices >> (i * 2)) & 3];
+		}
+
+		if (!solveEndpoints(colors, 3, weights, endpoint0, endpoint1))
+		{
+			break;
+		}
+
+		uint16_t refinedColor0 = pack565(endpoint0);
+		uint16_t refinedColor1 = pack565(endpoint1);
+
+		uint32_t refinedIndices;
+
+		int32_t refinedError = fitBC1(block, refinedColor0, refinedColor1, refinedIndices);
+
+		if (refinedError >= error)
+		{
+			break;
+		}
+
+		color0 = refinedColor0;
+		color1 = refinedColor1;
+		indices = refinedIndices;
+		error = refinedError;
+	}
+
+	// The four color mode needs the larger color first. Swapping exchanges the indices 0 and 1 as well as 2 and 3.
+	if (color0 < color1)
+	{
+		swap(color0, color1);
+
+		indices ^= 0x55555555;
+	}
+	else if (color0 == color1)
+	{
+		indices = 0;
+	}
+
+	output[0] = static_cast<uint8_t>(color0 & 0xFF);
+	output[1] = static_cast<uint8_t>(color0 >> 8);
+	output[2] = static_cast<uint8_t>(color1 & 0xFF);
+	output[3] = static_cast<uint8_t>(color1 >> 8);
+
+	for (int32_t i = 0; i < 4; i++)
+	{
+		output[4 + i] = static_cast<uint8_t>((indices >> (i * 8)) & 0xFF);
+	}
+}
+
+void TextureCompressor::decodeBC1(const uint8_t* input, bool opaque, uint8_t block[64])
+{
+	uint16_t color0 = static_cast<uint16_t>(input[0] | (input[1] << 8));
+	uint16_t color1 = static_cast<uint16_t>(input[2] | (input[3] << 8));
+
+	uint32_t indices = static_cast<uint32_t>(input[4]) | (static_cast<uint32_t>(input[5]) << 8) | (static_cast<uint32_t>(input[6]) << 16) | (static_cast<uint32_t>(input[7]) << 24);
+
+	int32_t palette[4][4];
+
+	createPaletteBC1(color0, color1, opaque || color0 > color1, palette);
+
+	for (int32_t i = 0; i < 16; i++)
+	{
+		int32_t index = (indices >> (i * 2)) & 3;
+
+		for (int32_t c = 0; c < 4; c++)
+		{
+			block[i * 4 + c] = static_cast<uint8_t>(palette[index][c]);
+		}
+	}
+}
+
+//
+// BC4
+//
+
+static void createPaletteBC4(int32_t value0, int32_t value1, int32_t palette[8])
+{
+	palette[0] = value0;
+	palette[1] = value1;
+
+	if (value0 > value1)
+	{
+		for (int32_t i = 1; i <= 6; i++)
+		{
+			palette[i + 1] = ((7 - i) * value0 + i * value1) / 7;
+		}
+	}
+	else
+	{
+		for (int32_t i = 1; i <= 4; i++)
+		{
+			palette[i + 1] = ((5 - i) * value0 + i * value1) / 5;
+		}
+
+		palette[6] = 0;
+		palette[7] = 255;
+	}
+}
+
+static int32_t fitBC4(const int32_t values[16], int32_t value0, int32_t value1, uint64_t& indices)
+{
+	int32_t palette[8];
+
+	createPaletteBC4(value0, value1, palette);
+
+	int32_t error = 0;
+
+	indices = 0;
+
+	for (int32_t i = 0; i < 16; i++)
+	{
+		int32_t bestIndex = 0;
+		int32_t bestError = INT32_MAX;
+
+		for (int32_t index = 0; index < 8; index++)
+		{
+			int32_t currentError = square(values[i] - palette[index]);
+
+			if (currentError < bestError)
+			{
+				bestError = currentError;
+				bestIndex = index;
+			}
+		}
+
+		indices |= static_cast<uint64_t>(bestIndex) << (i * 3);
+
+		error += bestError;
+	}
+
+	return error;
+}
+
+void TextureCompressor::encodeBC4(const uint8_t block[64], int32_t channel, uint8_t* output)
+{
+	int32_t values[16];
+
+	int32_t minValue = 255;
+	int32_t maxValue = 0;
+
+	// Range without the extremes, which the six value mode provides anyway.
+	int32_t minInner = 255;
+	int32_t maxInner = 0;
+
+	for (int32_t i = 0; i < 16; i++)
+	{
+		values[i] = block[i * 4 + channel];
+
+		minValue = min(minValue, values[i]);
+		maxValue = max(maxValue, values[i]);
+
+		if (values[i] > 0 && values[i] < 255)
+		{
+			minInner = min(minInner, values[i]);
+			maxInner = max(maxInner, values[i]);
+		}
+	}
+
+	// Eight value mode. Equal values select the six value mode, which still decodes the first value exactly.
+	int32_t value0 = maxValue;
+	int32_t value1 = minValue;
+
+	uint64_t indices;
+
+	int32_t error = fitBC4(values, value0, value1, indices);
+
+	if (error > 0)
+	{
+		if (minInner > maxInner)
+		{
+			minInner = maxInner = 0;
+		}
+
+		uint64_t innerIndices;
+
+		int32_t innerError = fitBC4(values, minInner, maxInner, innerIndices);
+
+		if (innerError < error)
+		{
+			value0 = minInner;
+			value1 = maxInner;
+			indices = innerIndices;
+		}
+	}
+
+	output[0] = static_cast<uint8_t>(value0);
+	output[1] = static_cast<uint8_t>(value1);
+
+	for (int32_t i = 0; i < 6; i++)
+	{
+		output[2 + i] = static_cast<uint8_t>((indices >> (i * 8)) & 0xFF);
+	}
+}
+
+void TextureCompressor::decodeBC4(const uint8_t* input, int32_t channel, uint8_t block[64])
+{
+	int32_t palette[8];
+
+	createPaletteBC4(input[0], input[1], palette);
+
+	uint64_t indices = 0;
+
+	for (int32_t i = 0; i < 6; i++)
+	{
+		indices |= static_cast<uint64_t>(input[2 + i]) << (i * 8);
+	}
+
+	for (int32_t i = 0; i < 16; i++)
+	{
+		block[i * 4 + channel] = static_cast<uint8_t>(palette[(indices >> (i * 3)) & 7]);
+	}
+}
+
+//
+// BC7
+//
+
+static void writeBits(uint8_t* output, int32_t& offset, uint32_t value, int32_t count)
+{
+	for (int32_t i = 0; i < count; i++)
+	{
+		if ((value >> i) & 1)
+		{
+			output[offset >> 3] |= static_cast<uint8_t>(1 << (offset & 7));
+		}
+
+		offset++;
+	}
+}
+
+static uint32_t readBits(const uint8_t* input, int32_t& offset, int32_t count)
+{
+	uint32_t value = 0;
+
+	for (int32_t i = 0; i < count; i++)
+	{
+		value |= static_cast<uint32_t>((input[offset >> 3] >> (offset & 7)) & 1) << i;
+
+		offset++;
+	}
+
+	return value;
+}
+
+/**
+ * Quantizes to 7 bits per channel and one shared lowest bit.
+ */
+static void quantizeBC7(const float endpoint[4], int32_t quantized[4], int32_t& pBit)
+{
+	int32_t bestError = INT32_MAX;
+
+	for (int32_t currentPBit = 0; currentPBit < 2; currentPBit++)
+	{
+		int32_t currentQuantized[4];
+
+		int32_t error = 0;
+
+		for (int32_t c = 0; c < 4; c++)
+		{
+			int32_t value = clampByte(static_cast<int32_t>(endpoint[c] + 0.5f));
+
+			currentQuantized[c] = min(max((value - currentPBit + 1) / 2, 0), 127);
+
+			error += square(((currentQuantized[c] << 1) | currentPBit) - value);
+		}
+
+		if (error < bestError)
+		{
+			bestError = error;
+
+			pBit = currentPBit;
+
+			for (int32_t c = 0; c < 4; c++)
+			{
+				quantized[c] = currentQuantized[c];
+			}
+		}
+	}
+}
+
+static int32_t fitBC7(const uint8_t block[64], const int32_t quantized0[4], int32_t pBit0, const int32_t quantized1[4], int32_t pBit1, int32_t indices[16])
+{
+	int32_t palette[16][4];
+
+	for (int32_t index = 0; index < 16; index++)
+	{
+		for (int32_t c = 0; c < 4; c++)
+		{
+			int32_t value0 = (quantized0[c] << 1) | pBit0;
+			int32_t value1 = (quantized1[c] << 1) | pBit1;
+
+			palette[index][c] = ((64 - BC7_WEIGHTS[index]) * value0 + BC7_WEIGHTS[index] * value1 + 32) >> 6;
+		}
+	}
+
+	int32_t error = 0;
+
+	for (int32_t i = 0; i < 16; i++)
+	{
+		int32_t bestError = INT32_MAX;
+
+		for (int32_t index = 0; index < 16; index++)
+		{
+			int32_t currentError = 0;
+
+			for (int32_t c = 0; c < 4; c++)
+			{
+				currentError += square(block[i * 4 + c] - palette[index][c]);
+			}
+
+			if (currentError < bestError)
+			{
+				bestError = currentError;
+				indices[i] = index;
+			}
+		}
+
+		error += bestError;
+	}
+
+	return error;
+}
+
+void TextureCompressor::encodeBC7(const uint8_t block[64], uint8_t* output)
+{
+	float colors[16][4];
+
+	for (int32_t i = 0; i < 16; i++)
+	{
+		for (int32_t c = 0; c < 4; c++)
+		{
+			colors[i][c] = static_cast<float>(block[i * 4 + c]);
+		}
+	}
+
+	float endpoint0[4];
+	float endpoint1[4];
+
+	calculateEndpoints(colors, 4, endpoint0, endpoint1);
+
+	int32_t quantized0[4];
+	int32_t quantized1[4];
+	int32_t pBit0;
+	int32_t pBit1;
+
+	quantizeBC7(endpoint0, quantized0, pBit0);
+	quantizeBC7(endpoint1, quantized1, pBit1);
+
+	int32_t indices[16];
+
+	int32_t error = fitBC7(block, quantized0, pBit0, quantized1, pBit1, indices);
+
+	for (int32_t iteration = 0; iteration < 2 && error > 0; iteration++)
+	{
+		float weights[16];
+
+		for (int32_t i = 0; i < 16; i++)
+		{
+			weights[i] = 1.0f - static_cast<float>(BC7_WEIGHTS[indices[i]]) / 64.0f;
+		}
+
+		if (!solveEndpoints(colors, 4, weights, endpoint0, endpoint1))
+		{
+			break;
+		}
+
+		int32_t refinedQuantized0[4];
+		int32_t refinedQuantized1[4];
+		int32_t refinedPBit0;
+		int32_t refinedPBit1;
+
+		quantizeBC7(endpoint0, refinedQuantized0, refinedPBit0);
+		quantizeBC7(endpoint1, refinedQuantized1, refinedPBit1);
+
+		int32_t refinedIndices[16];
+
+		int32_t refinedError = fitBC7(block, refinedQuantized0, refinedPBit0, refinedQuantized1, refinedPBit1, refinedIndices);
+
+		if (refinedError >= error)
+		{
+			break;
+		}
+
+		for (int32_t c = 0; c < 4; c++)
+		{
+			quantized0[c] = refinedQuantized0[c];
+			quantized1[c] = refinedQuantized1[c];
+		}
+		pBit0 = refinedPBit0;
+		pBit1 = refinedPBit1;
+
+		for (int32_t i = 0; i < 16; i++)
+		{
+			indices[i] = refinedIndices[i];
+		}
+
+		error = refinedError;
+	}
+
+	// The highest bit of the first index is implicitly zero, so the end points are swapped if needed.
+	if (indices[0] >= 8)
+	{
+		for (int32_t c = 0; c < 4; c++)
+		{
+			swap(quantized0[c], quantized1[c]);
+		}
+		swap(pBit0, pBit1);
+
+		for (int32_t i = 0; i < 16; i++)
+		{
+			indices[i] = 15 - indices[i];
+		}
+	}
+
+	memset(output, 0, 16);
+
+	int32_t offset = 0;
+
+	// Mode 6.
+	writeBits(output, offset, 1 << 6, 7);
+
+	for (int32_t c = 0; c < 4; c++)
+	{
+		writeBits(output, offset, quantized0[c], 7);
+		writeBits(output, offset, quantized1[c], 7);
+	}
+
+	writeBits(output, offset, pBit0, 1);
+	writeBits(output, offset, pBit1, 1);
+
+	for (int32_t i = 0; i < 16; i++)
+	{
+		writeBits(output, offset, indices[i], i == 0 ? 3 : 4);
+	}
+}
+
+bool TextureCompressor::decodeBC7(const uint8_t* input, uint8_t block[64])
+{
+	if ((input[0] & 0x7F) != 0x40)
+	{
+		return false;
+	}
+
+	int32_t offset = 7;
+
+	int32_t value0[4];
+	int32_t value1[4];
+
+	for (int32_t c = 0; c < 4; c++)
+	{
+		value0[c] = readBits(input, offset, 7) << 1;
+		value1[c] = readBits(input, offset, 7) << 1;
+	}
+
+	uint32_t pBit0 = readBits(input, offset, 1);
+	uint32_t pBit1 = readBits(input, offset, 1);
+
+	for (int32_t c = 0; c < 4; c++)
+	{
+		value0[c] |= pBit0;
+		value1[c] |= pBit1;
+	}
+
+	for (int32_t i = 0; i < 16; i++)
+	{
+		int32_t index = readBits(input, offset, i == 0 ? 3 : 4);
+
+		for (int32_t c = 0; c < 4; c++)
+		{
+			block[i * 4 + c] = static_cast<uint8_t>(((64 - BC7_WEIGHTS[index]) * value0[c] + BC7_WEIGHTS[index] * value1[c] + 32) >> 6);
+		}
+	}
+
+	return true;
+}
+
+//
+// ETC2
+//
+
+/**
+ * Pixels of a half block in row major order. Without flip, the halves are the left and right 2x4 pixels, otherwise the
+ * top and bottom 4x2 pixels.
+ */
+static void getSubBlockPixels(int32_t flip, int32_t subBlock, int32_t pixels[8])
+{
+	int32_t count = 0;
+
+	for (int32_t y = 0; y < 4; y++)
+	{
+		for (int32_t x = 0; x < 4; x++)
+		{
+			if ((flip ? y / 2 : x / 2) == subBlock)
+			{
+				pixels[count++] = y * 4 + x;
+			}
+		}
+	}
+}
+
+/**
+ * @return Squared error of the best table and selectors for the base color.
+ */
+static int32_t fitETC(const uint8_t block[64], const int32_t pixels[8], const int32_t baseColor[3], int32_t& table, int32_t selectors[16])
+{
+	int32_t bestError = INT32_MAX;
+
+	for (int32_t currentTable = 0; currentTable < 8; currentTable++)
+	{
+		const int32_t modifiers[4] = { ETC_MODIFIERS[currentTable][0], ETC_MODIFIERS[currentTable][1], -ETC_MODIFIERS[currentTable][0], -ETC_MODIFIERS[currentTable][1] };
+
+		int32_t currentSelectors[8];
+
+		int32_t error = 0;
+
+		for (int32_t i = 0; i < 8 && error < bestError; i++)
+		{
+			const uint8_t* color = &block[pixels[i] * 4];
+
+			int32_t bestPixelError = INT32_MAX;
+
+			for (int32_t selector = 0; selector < 4; selector++)
+			{
+				int32_t pixelError = 0;
+
+				for (int32_t c = 0; c < 3; c++)
+				{
+					pixelError += square(color[c] - clampByte(baseColor[c] + modifiers[selector]));
+				}
+
+				if (pixelError < bestPixelError)
+				{
+					bestPixelError = pixelError;
+					currentSelectors[i] = selector;
+				}
+			}
+
+			error += bestPixelError;
+		}
+
+		if (error < bestError)
+		{
+			bestError = error;
+
+			table = currentTable;
+
+			for (int32_t i = 0; i < 8; i++)
+			{
+				selectors[pixels[i]] = currentSelectors[i];
+			}
+		}
+	}
+
+	return bestError;
+}
+
+void TextureCompressor::encodeETC2(const uint8_t block[64], uint8_t* output)
+{
+	uint64_t bestBits = 0;
+	int32_t bestError = INT32_MAX;
+
+	for (int32_t flip = 0; flip < 2; flip++)
+	{
+		int32_t pixels[2][8];
+
+		float average[2][3] = { { 0.0f } };
+
+		for (int32_t subBlock = 0; subBlock < 2; subBlock++)
+		{
+			getSubBlockPixels(flip, subBlock, pixels[subBlock]);
+
+			for (int32_t i = 0; i < 8; i++)
+			{
+				for (int32_t c = 0; c < 3; c++)
+				{
+					average[subBlock][c] += static_cast<float>(block[pixels[subBlock][i] * 4 + c]) / 8.0f;
+				}
+			}
+		}
+
+		// The individual mode stores two 4 bit colors, the differential mode a 5 bit color and a 3 bit signed offset.
+		for (int32_t differential = 0; differential < 2; differential++)
+		{
+			int32_t quantized[2][3];
+			int32_t baseColor[2][3];
+
+			bool valid = true;
+
+			for (int32_t subBlock = 0; subBlock < 2; subBlock++)
+			{
+				for (int32_t c = 0; c < 3; c++)
+				{
+					if (differential)
+					{
+						quantized[subBlock][c] = min(max(static_cast<int32_t>(average[subBlock][c] * 31.0f / 255.0f + 0.5f), 0), 31);
+
+						baseColor[subBlock][c] = (quantized[subBlock][c] << 3) | (quantized[subBlock][c] >> 2);
+					}
+					else
+					{
+						quantized[subBlock][c] = min(max(static_cast<int32_t>(average[subBlock][c] * 15.0f / 255.0f + 0.5f), 0), 15);
+
+						baseColor[subBlock][c] = (quantized[subBlock][c] << 4) | quantized[subBlock][c];
+					}
+				}
+			}
+
+			if (differential)
+			{
+				for (int32_t c = 0; c < 3; c++)
+				{
+					int32_t difference = quantized[1][c] - quantized[0][c];
+
+					valid = valid && difference >= -4 && difference <= 3;
+				}
+			}
+
+			if (!valid)
+			{
+				continue;
+			}
+
+			int32_t table[2];
+			int32_t selectors[16];
+
+			int32_t error = fitETC(block, pixels[0], baseColor[0], table[0], selectors) + fitETC(block, pixels[1], baseColor[1], table[1], selectors);
+
+			if (error >= bestError)
+			{
+				continue;
+			}
+
+			bestError = error;
+
+			uint64_t bits = 0;
+
+			for (int32_t c = 0; c < 3; c++)
+			{
+				if (differential)
+				{
+					bits |= static_cast<uint64_t>(quantized[0][c]) << (59 - c * 8);
+					bits |= static_cast<uint64_t>((quantized[1][c] - quantized[0][c]) & 7) << (56 - c * 8);
+				}
+				else
+				{
+					bits |= static_cast<uint64_t>(quantized[0][c]) << (60 - c * 8);
+					bits |= static_cast<uint64_t>(quantized[1][c]) << (56 - c * 8);
+				}
+			}
+
+			bits |= static_cast<uint64_t>(table[0]) << 37;
+			bits |= static_cast<uint64_t>(table[1]) << 34;
+			bits |= static_cast<uint64_t>(differential) << 33;
+			bits |= static_cast<uint64_t>(flip) << 32;
+
+			// The selectors are stored column by column, the high bits before the low bits.
+			for (int32_t y = 0; y < 4; y++)
+			{
+				for (int32_t x = 0; x < 4; x++)
+				{
+					int32_t selector = selectors[y * 4 + x];
+
+					bits |= static_cast<uint64_t>(selector >> 1) << (16 + x * 4 + y);
+					bits |= static_cast<uint64_t>(selector & 1) << (x * 4 + y);
+				}
+			}
+
+			bestBits = bits;
+		}
+	}
+
+	for (int32_t i = 0; i < 8; i++)
+	{
+		output[i] = static_cast<uint8_t>((bestBits >> (56 - i * 8)) & 0xFF);
+	}
+}
+
+bool TextureCompressor::decodeETC2(const uint8_t* input, uint8_t block[64])
+{
+	uint64_t bits = 0;
+
+	for (int32_t i = 0; i < 8; i++)
+	{
+		bits = (bits << 8) | input[i];
+	}
+
+	bool differential = ((bits >> 33) & 1) != 0;
+	bool flip = ((bits >> 32) & 1) != 0;
+
+	int32_t baseColor[2][3];
+
+	for (int32_t c = 0; c < 3; c++)
+	{
+		if (differential)
+		{
+			int32_t value = static_cast<int32_t>((bits >> (59 - c * 8)) & 31);
+			int32_t difference = static_cast<int32_t>((bits >> (56 - c * 8)) & 7);
+
+			if (difference >= 4)
+			{
+				difference -= 8;
+			}
+
+			// An overflow selects one of the additional ETC2 modes, which are not written by the encoder.
+			if (value + difference < 0 || value + difference > 31)
+			{
+				return false;
+			}
+
+			baseColor[0][c] = (value << 3) | (value >> 2);
+			baseColor[1][c] = ((value + difference) << 3) | ((value + difference) >> 2);
+		}
+		else
+		{
+			int32_t value0 = static_cast<int32_t>((bits >> (60 - c * 8)) & 15);
+			int32_t value1 = static_cast<int32_t>((bits >> (56 - c * 8)) & 15);
+
+			baseColor[0][c] = (value0 << 4) | value0;
+			baseColor[1][c] = (value1 << 4) | value1;
+		}
+	}
+
+	int32_t table[2] = { static_cast<int32_t>((bits >> 37) & 7), static_cast<int32_t>((bits >> 34) & 7) };
+
+	for (int32_t y = 0; y < 4; y++)
+	{
+		for (int32_t x = 0; x < 4; x++)
+		{
+			int32_t subBlock = flip ? y / 2 : x / 2;
+
+			int32_t selector = static_cast<int32_t>((((bits >> (16 + x * 4 + y)) & 1) << 1) | ((bits >> (x * 4 + y)) & 1));
+
+			int32_t modifier = ETC_MODIFIERS[table[subBlock]][selector & 1];
+
+			if (selector >= 2)
+			{
+				modifier = -modifier;
+			}
+
+			for (int32_t c = 0; c < 3; c++)
+			{
+				block[(y * 4 + x) * 4 + c] = static_cast<uint8_t>(clampByte(baseColor[subBlock][c] + modifier));
+			}
+
+			block[(y * 4 + x) * 4 + 3] = 255;
+		}
+	}
+
+	return true;
+}
+
+//
+// Pixel data
+//
+
+void TextureCompressor::fetchBlock(const PixelData& pixelData, int32_t blockX, int32_t blockY, uint8_t block[64])
+{
+	int32_t channels = PixelData::getNumberChannels(pixelData.getFormat());
+
+	for (int32_t y = 0; y < 4; y++)
+	{
+		for (int32_t x = 0; x < 4; x++)
+		{
+			// Blocks at the border repeat the last row or column.
+			int32_t sourceX = min(blockX * 4 + x, pixelData.getWidth() - 1);
+			int32_t sourceY = min(blockY * 4 + y, pixelData.getHeight() - 1);
+
+			const uint8_t* source = pixelData.getPixels() + (sourceY * pixelData.getWidth() + sourceX) * channels;
+
+			uint8_t* target = &block[(y * 4 + x) * 4];
+
+			target[0] = 0;
+			target[1] = 0;
+			target[2] = 0;
+			target[3] = 255;
+
+			switch (pixelData.getFormat())
+			{
+				case GL_RED:
+					target[0] = source[0];
+				break;
+				case GL_ALPHA:
+					target[3] = source[0];
+				break;
+				case GL_LUMINANCE:
+				case GL_DEPTH_COMPONENT:
+					target[0] = target[1] = target[2] = source[0];
+				break;
+				case GL_RG:
+					target[0] = source[0];
+					target[1] = source[1];
+				break;
+				case GL_LUMINANCE_ALPHA:
+					target[0] = target[1] = target[2] = source[0];
+					target[3] = source[1];
+				break;
+				case GL_RGB:
+					target[0] = source[0];
+					target[1] = source[1];
+					target[2] = source[2];
+				break;
+				case GL_BGR:
+					target[0] = source[2];
+					target[1] = source[1];
+					target[2] = source[0];
+				break;
+				case GL_RGBA:
+					target[0] = source[0];
+					target[1] = source[1];
+					target[2] = source[2];
+					target[3] = source[3];
+				break;
+				case GL_BGRA:
+					target[0] = source[2];
+					target[1] = source[1];
+					target[2] = source[0];
+					target[3] = source[3];
+				break;
+			}
+		}
+	}
+}
+
+GLenum TextureCompressor::getInternalFormat(enum TextureCompression compression, bool sRGB)
+{
+	switch (compression)
+	{
+		case TextureCompressionBC1:
+			return sRGB ? GL_COMPRESSED_SRGB_S3TC_DXT1_EXT : GL_COMPRESSED_RGB_S3TC_DXT1_EXT;
+		case TextureCompressionBC3:
+			return sRGB ? GL_COMPRESSED_SRGB_ALPHA_S3TC_DXT5_EXT : GL_COMPRESSED_RGBA_S3TC_DXT5_EXT;
+		case TextureCompressionBC4:
+			return GL_COMPRESSED_RED_RGTC1;
+		case TextureCompressionBC5:
+			return GL_COMPRESSED_RG_RGTC2;
+		case TextureCompressionBC7:
+			return sRGB ? GL_COMPRESSED_SRGB_ALPHA_BPTC_UNORM : GL_COMPRESSED_RGBA_BPTC_UNORM;
+		case TextureCompressionETC2:
+			return sRGB ? GL_COMPRESSED_SRGB8_ETC2 : GL_COMPRESSED_RGB8_ETC2;
+		case TextureCompressionNone:
+		break;
+	}
+
+	return 0;
+}
+
+enum TextureCompression TextureCompressor::getCompression(GLenum internalFormat)
+{
+	switch (internalFormat)
+	{
+		case GL_COMPRESSED_RGB_S3TC_DXT1_EXT:
+		case GL_COMPRESSED_SRGB_S3TC_DXT1_EXT:
+			return TextureCompressionBC1;
+		case GL_COMPRESSED_RGBA_S3TC_DXT5_EXT:
+		case GL_COMPRESSED_SRGB_ALPHA_S3TC_DXT5_EXT:
+			return TextureCompressionBC3;
+		case GL_COMPRESSED_RED_RGTC1:
+			return TextureCompressionBC4;
+		case GL_COMPRESSED_RG_RGTC2:
+			return TextureCompressionBC5;
+		case GL_COMPRESSED_RGBA_BPTC_UNORM:
+		case GL_COMPRESSED_SRGB_ALPHA_BPTC_UNORM:
+			return TextureCompressionBC7;
+		case GL_COMPRESSED_RGB8_ETC2:
+		case GL_COMPRESSED_SRGB8_ETC2:
+			return TextureCompressionETC2;
+	}
+
+	return TextureCompressionNone;
+}
+
+bool TextureCompressor::isCompressedFormat(GLenum internalFormat)
+{
+	return getCompression(internalFormat) != TextureCompressionNone;
+}
+
+GLenum TextureCompressor::getBaseFormat(GLenum internalFormat)
+{
+	switch (getCompression(internalFormat))
+	{
+		case TextureCompressionBC1:
+		case TextureCompressionETC2:
+			return GL_RGB;
+		case TextureCompressionBC3:
+		case TextureCompressionBC7:
+			return GL_RGBA;
+		case TextureCompressionBC4:
+			return GL_RED;
+		case TextureCompressionBC5:
+			return GL_RG;
+		case TextureCompressionNone:
+		break;
+	}
+
+	return 0;
+}
+
+uint32_t TextureCompressor::getBlockSize(enum TextureCompression compression)
+{
+	switch (compression)
+	{
+		case TextureCompressionBC1:
+		case TextureCompressionBC4:
+		case TextureCompressionETC2:
+			return 8;
+		case TextureCompressionBC3:
+		case TextureCompressionBC5:
+		case TextureCompressionBC7:
+			return 16;
+		case TextureCompressionNone:
+		break;
+	}
+
+	return 0;
+}
+
+uint32_t TextureCompressor::getSizeOfData(GLenum internalFormat, int32_t width, int32_t height)
+{
+	uint32_t blocksX = static_cast<uint32_t>(max(width, 1) + 3) / 4;
+	uint32_t blocksY = static_cast<uint32_t>(max(height, 1) + 3) / 4;
+
+	return blocksX * blocksY * getBlockSize(getCompression(internalFormat));
+}
+
+bool TextureCompressor::isSupported(GLenum internalFormat)
+{
+	switch (internalFormat)
+	{
+		case GL_COMPRESSED_RGB_S3TC_DXT1_EXT:
+		case GL_COMPRESSED_RGBA_S3TC_DXT5_EXT:
+			return GLEW_EXT_texture_compression_s3tc ? true : false;
+		case GL_COMPRESSED_SRGB_S3TC_DXT1_EXT:
+		case GL_COMPRESSED_SRGB_ALPHA_S3TC_DXT5_EXT:
+			return GLEW_EXT_texture_compression_s3tc && GLEW_EXT_texture_sRGB;
+		case GL_COMPRESSED_RED_RGTC1:
+		case GL_COMPRESSED_RG_RGTC2:
+			return GLEW_VERSION_3_0 || GLEW_ARB_texture_compression_rgtc;
+		case GL_COMPRESSED_RGBA_BPTC_UNORM:
+		case GL_COMPRESSED_SRGB_ALPHA_BPTC_UNORM:
+			return GLEW_VERSION_4_2 || GLEW_ARB_texture_compression_bptc;
+		case GL_COMPRESSED_RGB8_ETC2:
+		case GL_COMPRESSED_SRGB8_ETC2:
+			return GLEW_VERSION_4_3 || GLEW_ARB_ES3_compatibility;
+	}
+
+	return false;
+}
+
+bool TextureCompressor::compress(const PixelData& pixelData, enum TextureCompression compression, bool sRGB, PixelData& compressedData)
+{
+	if (!pixelData.getPixels() || pixelData.getType() != GL_UNSIGNED_BYTE || PixelData::getNumberChannels(pixelData.getFormat()) == 0 || compression == TextureCompressionNone)
+	{
+		return false;
+	}
+
+	GLenum internalFormat = getInternalFormat(compression, sRGB);
+
+	int32_t blocksX = (pixelData.getWidth() + 3) / 4;
+	int32_t blocksY = (pixelData.getHeight() + 3) / 4;
+
+	uint32_t blockSize = getBlockSize(compression);
+
+	vector<uint8_t> blocks(getSizeOfData(internalFormat, pixelData.getWidth(), pixelData.getHeight()));
+
+	uint8_t block[64];
+
+	for (int32_t blockY = 0; blockY < blocksY; blockY++)
+	{
+		for (int32_t blockX = 0; blockX < blocksX; blockX++)
+		{
+			fetchBlock(pixelData, blockX, blockY, block);
+
+			uint8_t* output = &blocks[(blockY * blocksX + blockX) * blockSize];
+
+			switch (compression)
+			{
+				case TextureCompressionBC1:
+					encodeBC1(block, output);
+				break;
+				case TextureCompressionBC3:
+					encodeBC4(block, 3, output);
+					encodeBC1(block, output + 8);
+				break;
+				case TextureCompressionBC4:
+					encodeBC4(block, 0, output);
+				break;
+				case TextureCompressionBC5:
+					encodeBC4(block, 0, output);
+					encodeBC4(block, 1, output + 8);
+				break;
+				case TextureCompressionBC7:
+					encodeBC7(block, output);
+				break;
+				case TextureCompressionETC2:
+					encodeETC2(block, output);
+				break;
+				case TextureCompressionNone:
+				break;
+			}
+		}
+	}
+
+	compressedData = PixelData(pixelData.getWidth(), pixelData.getHeight(), internalFormat, GL_UNSIGNED_BYTE, blocks.data(), static_cast<uint32_t>(blocks.size()));
+
+	return true;
+}
+
+bool TextureCompressor::compressMipChain(const vector<PixelData>& mipLevels, enum TextureCompression compression, bool sRGB, vector<PixelData>& compressedMipLevels)
+{
+	compressedMipLevels.clear();
+
+	compressedMipLevels.resize(mipLevels.size());
+
+	for (size_t i = 0; i < mipLevels.size(); i++)
+	{
+		if (!compress(mipLevels[i], compression, sRGB, compressedMipLevels[i]))
+		{
+			compressedMipLevels.clear();
+
+			return false;
+		}
+	}
+
+	return mipLevels.size() > 0;
+}
+
+bool TextureCompressor::decompress(const PixelData& compressedData, PixelData& pixelData)
+{
+	enum TextureCompression compression = getCompression(compressedData.getFormat());
+
+	int32_t width = compressedData.getWidth();
+	int32_t height = compressedData.getHeight();
+
+	if (!compressedData.getPixels() || compression == TextureCompressionNone || compressedData.getSizeOfData() < getSizeOfData(compressedData.getFormat(), width, height))
+	{
+		return false;
+	}
+
+	int32_t blocksX = (width + 3) / 4;
+	int32_t blocksY = (height + 3) / 4;
+
+	uint32_t blockSize = getBlockSize(compression);
+
+	vector<uint8_t> pixels(width * height * 4);
+
+	uint8_t block[64];
+
+	for (int32_t blockY = 0; blockY < blocksY; blockY++)
+	{
+		for (int32_t blockX = 0; blockX < blocksX; blockX++)
+		{
+			const uint8_t* input = compressedData.getPixels() + (blockY * blocksX + blockX) * blockSize;
+
+			for (int32_t i = 0; i < 16; i++)
+			{
+				block[i * 4 + 0] = 0;
+				block[i * 4 + 1] = 0;
+				block[i * 4 + 2] = 0;
+				block[i * 4 + 3] = 255;
+			}
+
+			bool decoded = true;
+
+			switch (compression)
+			{
+				case TextureCompressionBC1:
+					decodeBC1(input, false, block);
+				break;
+				case TextureCompressionBC3:
+					decodeBC1(input + 8, true, block);
+					decodeBC4(input, 3, block);
+				break;
+				case TextureCompressionBC4:
+					decodeBC4(input, 0, block);
+				break;
+				case TextureCompressionBC5:
+					decodeBC4(input, 0, block);
+					decodeBC4(input + 8, 1, block);
+				break;
+				case TextureCompressionBC7:
+					decoded = decodeBC7(input, block);
+				break;
+				case TextureCompressionETC2:
+					decoded = decodeETC2(input, block);
+				break;
+				case TextureCompressionNone:
+				break;
+			}
+
+			if (!decoded)
+			{
+				glusLogPrint(GLUS_LOG_ERROR, "Unsupported block mode in compressed texture");
+
+				return false;
+			}
+
+			for (int32_t y = 0; y < 4 && blockY * 4 + y < height; y++)
+			{
+				for (int32_t x = 0; x < 4 && blockX * 4 + x < width; x++)
+				{
+					memcpy(&pixels[((blockY * 4 + y) * width + blockX * 4 + x) * 4], &block[(y * 4 + x) * 4], 4);
+				}
+			}
+		}
+	}
+
+	pixelData = PixelData(width, height, GL_RGBA, GL_UNSIGNED_BYTE, pixels.data(), static_cast<uint32_t>(pixels.size()));
+
+	return true;
+}
@@ -0,0 +1,102 @@
+/*
+ * TextureCompressor.h
+ *
+ *  Created on: 19.10.2026
+ *      Author: nopper
+ */
+
+#ifndef TEXTURECOMPRESSOR_H_
+#define TEXTURECOMPRESSOR_H_
+
+#include "../../UsedLibs.h"
+
+#include "PixelData.h"
+
+enum TextureCompression
+{
+	TextureCompressionNone, TextureCompressionBC1, TextureCompressionBC3, TextureCompressionBC4, TextureCompressionBC5, TextureCompressionBC7, TextureCompressionETC2
+};
+
+/**
+ * Encodes unsigned byte pixel data into block compressed formats on the CPU. Compressed pixel data stores the compressed
+ * internal format as format, unsigned byte as type and the blocks as pixels. Does not need a context, except for
+ * isSupported().
+ *
+ * BC1: RGB, 8 bytes per block. Alpha is ignored.
+ * BC3: RGBA, 16 bytes per block.
+ * BC4: Red, 8 bytes per block.
+ * BC5: Red and green, 16 bytes per block, e.g. for normal maps.
+ * BC7: RGBA, 16 bytes per block. Only mode 6 is written.
+ * ETC2: RGB, 8 bytes per block. Only the modes compatible to ETC1 are written.
+ */
+class TextureCompressor
+{
+
+private:
+
+	static void fetchBlock(const PixelData& pixelData, std::int32_t blockX, std::int32_t blockY, std::uint8_t block[64]);
+
+	static void encodeBC1(const std::uint8_t block[64], std::uint8_t* output);
+
+	static void encodeBC4(const std::uint8_t block[64], std::int32_t channel, std::uint8_t* output);
+
+	static void encodeBC7(const std::uint8_t block[64], std::uint8_t* output);
+
+	static void encodeETC2(const std::uint8_t block[64], std::uint8_t* output);
+
+	/**
+	 * @param opaque True for the color block of BC3, which has no transparent mode.
+	 */
+	static void decodeBC1(const std::uint8_t* input, bool opaque, std::uint8_t block[64]);
+
+	static void decodeBC4(const std::uint8_t* input, std::int32_t channel, std::uint8_t block[64]);
+
+	static bool decodeBC7(const std::uint8_t* input, std::uint8_t block[64]);
+
+	static bool decodeETC2(const std::uint8_t* input, std::uint8_t block[64]);
+
+public:
+
+	/**
+	 * @return Compressed internal format. Zero, if not compressed.
+	 */
+	static GLenum getInternalFormat(enum TextureCompression compression, bool sRGB);
+
+	/**
+	 * @return Compression of the internal format. None, if not a format of this compressor.
+	 */
+	static enum TextureCompression getCompression(GLenum internalFormat);
+
+	static bool isCompressedFormat(GLenum internalFormat);
+
+	/**
+	 * @return Uncompressed format, e.g. GL_RGB for BC1.
+	 */
+	static GLenum getBaseFormat(GLenum internalFormat);
+
+	static std::uint32_t getBlockSize(enum TextureCompression compression);
+
+	static std::uint32_t getSizeOfData(GLenum internalFormat, std::int32_t width, std::int32_t height);
+
+	/**
+	 * Checks the version and extensions of the current context.
+	 */
+	static bool isSupported(GLenum internalFormat);
+
+	/**
+	 * @param sRGB Only selects the internal format. The blocks are encoded in the space of the pixels.
+	 *
+	 * @return False, if the pixels are not unsigned bytes.
+	 */
+	static bool compress(const PixelData& pixelData, enum TextureCompression compression, bool sRGB, PixelData& compressedData);
+
+	static bool compressMipChain(const std::vector<PixelData>& mipLevels, enum TextureCompression compression, bool sRGB, std::vector<PixelData>& compressedMipLevels);
+
+	/**
+	 * Decodes into RGBA unsigned bytes, e.g. for saving or measuring the quality.
+	 */
+	static bool decompress(const PixelData& compressedData, PixelData& pixelData);
+
+};
+
+#endif /* TEXTURECOMPRESSOR_H_ */
@@ -0,0 +1,173 @@
+/*
+ * TextureContainer.cpp
+ *
+ *  Created on: 19.10.2026
+ *      Author: nopper
+ */
+
+#include "TextureCompressor.h"
+
+#include "TextureContainer.h"
+
+using namespace std;
+
+const uint8_t TextureContainer::IDENTIFIER[12] = { 0xAB, 'K', 'T', 'X', ' ', '1', '1', 0xBB, '\r', '\n', 0x1A, '\n' };
+
+void TextureContainer::writeValue(vector<uint8_t>& data, uint32_t value)
+{
+	for (int32_t i = 0; i < 4; i++)
+	{
+		data.push_back(static_cast<uint8_t>((value >> (i * 8)) & 0xFF));
+	}
+}
+
+uint32_t TextureContainer::readValue(const uint8_t* data, bool swapBytes)
+{
+	uint32_t value = static_cast<uint32_t>(data[0]) | (static_cast<uint32_t>(data[1]) << 8) | (static_cast<uint32_t>(data[2]) << 16) | (static_cast<uint32_t>(data[3]) << 24);
+
+	if (swapBytes)
+	{
+		value = ((value & 0xFF) << 24) | ((value & 0xFF00) << 8) | ((value >> 8) & 0xFF00) | (value >> 24);
+	}
+
+	return value;
+}
+
+bool TextureContainer::save(const string& filename, const vector<PixelData>& mipLevels)
+{
+	if (mipLevels.size() == 0 || !TextureCompressor::isCompressedFormat(mipLevels[0].getFormat()))
+	{
+		return false;
+	}
+
+	const PixelData& baseLevel = mipLevels[0];
+
+	vector<uint8_t> data(IDENTIFIER, IDENTIFIER + 12);
+
+	writeValue(data, ENDIANNESS);
+	// Type, size of the type and format are zero for compressed formats.
+	writeValue(data, 0);
+	writeValue(data, 1);
+	writeValue(data, 0);
+	writeValue(data, baseLevel.getFormat());
+	writeValue(data, TextureCompressor::getBaseFormat(baseLevel.getFormat()));
+	writeValue(data, static_cast<uint32_t>(baseLevel.getWidth()));
+	writeValue(data, static_cast<uint32_t>(baseLevel.getHeight()));
+	writeValue(data, 0);
+	writeValue(data, 0);
+	writeValue(data, 1);
+	writeValue(data, static_cast<uint32_t>(mipLevels.size()));
+	writeValue(data, 0);
+
+	for (auto& currentLevel : mipLevels)
+	{
+		if (currentLevel.getFormat() != baseLevel.getFormat() || !currentLevel.getPixels())
+		{
+			return false;
+		}
+
+		writeValue(data, currentLevel.getSizeOfData());
+
+		data.insert(data.end(), currentLevel.getPixels(), currentLevel.getPixels() + currentLevel.getSizeOfData());
+
+		// Blocks are multiples of four bytes, so no mip padding is needed.
+	}
+
+	GLUSbinaryfile binaryfile;
+
+	binaryfile.binary = data.data();
+	binaryfile.length = static_cast<GLUSint>(data.size());
+
+	if (!glusFileSaveBinary(filename.c_str(), &binaryfile))
+	{
+		glusLogPrint(GLUS_LOG_ERROR, "Could not save texture container: %s", filename.c_str());
+
+		return false;
+	}
+
+	return true;
+}
+
+bool TextureContainer::load(const string& filename, vector<PixelData>& mipLevels)
+{
+	mipLevels.clear();
+
+	GLUSbinaryfile binaryfile;
+
+	if (!glusFileLoadBinary(filename.c_str(), &binaryfile))
+	{
+		return false;
+	}
+
+	const uint8_t* data = binaryfile.binary;
+	uint32_t length = static_cast<uint32_t>(binaryfile.length);
+
+	if (length < HEADER_SIZE || memcmp(data, IDENTIFIER, 12) != 0)
+	{
+		glusLogPrint(GLUS_LOG_ERROR, "Not a KTX file: %s", filename.c_str());
+
+		glusFileDestroyBinary(&binaryfile);
+
+		return false;
+	}
+
+	bool swapBytes = readValue(data + 12, false) != ENDIANNESS;
+
+	uint32_t type = readValue(data + 16, swapBytes);
+	GLenum internalFormat = readValue(data + 28, swapBytes);
+	int32_t width = static_cast<int32_t>(readValue(data + 36, swapBytes));
+	int32_t height = static_cast<int32_t>(readValue(data + 40, swapBytes));
+	uint32_t depth = readValue(data + 44, swapBytes);
+	uint32_t arrayElements = readValue(data + 48, swapBytes);
+	uint32_t faces = readValue(data + 52, swapBytes);
+	uint32_t levels = max(readValue(data + 56, swapBytes), 1u);
+	uint32_t keyValueBytes = readValue(data + 60, swapBytes);
+
+	if (type != 0 || !TextureCompressor::isCompressedFormat(internalFormat) || width < 1 || height < 1 || depth > 1 || arrayElements > 0 || faces != 1)
+	{
+		glusLogPrint(GLUS_LOG_ERROR, "Unsupported KTX file: %s", filename.c_str());
+
+		glusFileDestroyBinary(&binaryfile);
+
+		return false;
+	}
+
+	uint32_t offset = HEADER_SIZE + keyValueBytes;
+
+	for (uint32_t level = 0; level < levels; level++)
+	{
+		int32_t levelWidth = max(width >> level, 1);
+		int32_t levelHeight = max(height >> level, 1);
+
+		if (offset + 4 > length)
+		{
+			break;
+		}
+
+		uint32_t imageSize = readValue(data + offset, swapBytes);
+
+		offset += 4;
+
+		if (imageSize < TextureCompressor::getSizeOfData(internalFormat, levelWidth, levelHeight) || offset + imageSize > length)
+		{
+			break;
+		}
+
+		mipLevels.push_back(PixelData(levelWidth, levelHeight, internalFormat, GL_UNSIGNED_BYTE, data + offset, imageSize));
+
+		offset += (imageSize + 3) & ~3u;
+	}
+
+	glusFileDestroyBinary(&binaryfile);
+
+	if (mipLevels.size() != levels)
+	{
+		glusLogPrint(GLUS_LOG_ERROR, "Truncated KTX file: %s", filename.c_str());
+
+		mipLevels.clear();
+
+		return false;
+	}
+
+	return true;
+}
@@ -0,0 +1,45 @@
+/*
+ * TextureContainer.h
+ *
+ *  Created on: 19.10.2026
+ *      Author: nopper
+ */
+
+#ifndef TEXTURECONTAINER_H_
+#define TEXTURECONTAINER_H_
+
+#include "../../UsedLibs.h"
+
+#include "PixelData.h"
+
+/**
+ * Reads and writes compressed mip chains as KTX 1.1 files. Only 2D textures with one face and block compressed formats of
+ * the texture compressor are supported. Does not need a context.
+ */
+class TextureContainer
+{
+
+private:
+
+	static const std::uint32_t HEADER_SIZE = 64;
+
+	static const std::uint32_t ENDIANNESS = 0x04030201;
+
+	static const std::uint8_t IDENTIFIER[12];
+
+	static void writeValue(std::vector<std::uint8_t>& data, std::uint32_t value);
+
+	static std::uint32_t readValue(const std::uint8_t* data, bool swapBytes);
+
+public:
+
+	/**
+	 * @param mipLevels Compressed levels, starting with the largest one.
+	 */
+	static bool save(const std::string& filename, const std::vector<PixelData>& mipLevels);
+
+	static bool load(const std::string& filename, std::vector<PixelData>& mipLevels);
+
+};
+
+#endif /* TEXTURECONTAINER_H_ */
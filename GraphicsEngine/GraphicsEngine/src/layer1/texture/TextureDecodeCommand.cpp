@@ -0,0 +1,54 @@
+/*
+ * TextureDecodeCommand.cpp
+ *
+ *  Created on: 19.10.2026
+ *      Author: nopper
+ */
+
+#include "TextureDecodeCommand.h"
+
+using namespace std;
+
+TextureDecodeCommand::TextureDecodeCommand(const TextureDecodeCommandRecycleQueueSP& textureDecodeCommandRecycleQueue, const TextureUploadQueueSP& uploadQueue, const ThreadSafeCounterSP& taskCounter) :
+	Command(), textureDecodeCommandRecycleQueue(textureDecodeCommandRecycleQueue), uploadQueue(uploadQueue), taskCounter(taskCounter), task()
+{
+}
+
+TextureDecodeCommand::~TextureDecodeCommand()
+{
+}
+
+bool TextureDecodeCommand::execute()
+{
+	assert(this->taskCounter.get() != nullptr);
+	assert(this->task.get() != nullptr);
+
+	TextureDecoder textureDecoder;
+
+	textureDecoder.decode(*task);
+
+	uploadQueue->add(task);
+
+	task.reset();
+
+	taskCounter->decrement();
+
+	return true;
+}
+
+void TextureDecodeCommand::recycle()
+{
+	task.reset();
+
+	textureDecodeCommandRecycleQueue->add(this);
+}
+
+void TextureDecodeCommand::init(const TextureDecodeTaskSP& task)
+{
+	assert(this->taskCounter.get() != nullptr);
+	assert(this->task.get() == nullptr);
+
+	taskCounter->increment();
+
+	this->task = task;
+}
@@ -0,0 +1,51 @@
+/*
+ * TextureDecodeCommand.h
+ *
+ *  Created on: 19.10.2026
+ *      Author: nopper
+ */
+
+#ifndef TEXTUREDECODECOMMAND_H_
+#define TEXTUREDECODECOMMAND_H_
+
+#include "../../layer0/concurrency/ThreadSafeCounter.h"
+#include "../command/Command.h"
+
+#include "TextureDecoder.h"
+
+/**
+ * Decodes one texture on a worker thread and hands the finished mip levels to the upload queue.
+ */
+class TextureDecodeCommand: public Command
+{
+
+	friend class TextureUploadManager;
+
+private:
+
+	std::shared_ptr<ThreadsafeQueue<TextureDecodeCommand*> > textureDecodeCommandRecycleQueue;
+
+	std::shared_ptr<ThreadsafeQueue<TextureDecodeTaskSP> > uploadQueue;
+
+	ThreadSafeCounterSP taskCounter;
+
+	TextureDecodeTaskSP task;
+
+	TextureDecodeCommand(const std::shared_ptr<ThreadsafeQueue<TextureDecodeCommand*> >& textureDecodeCommandRecycleQueue, const std::shared_ptr<ThreadsafeQueue<TextureDecodeTaskSP> >& uploadQueue, const ThreadSafeCounterSP& taskCounter);
+	virtual ~TextureDecodeCommand();
+
+public:
+
+	virtual bool execute();
+
+	virtual void recycle();
+
+	void init(const TextureDecodeTaskSP& task);
+
+};
+
+typedef std::shared_ptr<ThreadsafeQueue<TextureDecodeCommand*> > TextureDecodeCommandRecycleQueueSP;
+
+typedef std::shared_ptr<ThreadsafeQueue<TextureDecodeTaskSP> > TextureUploadQueueSP;
+
+#endif /* TEXTUREDECODECOMMAND_H_ */
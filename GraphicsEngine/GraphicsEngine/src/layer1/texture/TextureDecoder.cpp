@@ -0,0 +1,228 @@
+/*
+ * TextureDecoder.cpp
+ *
+ *  Created on: 19.10.2026
+ *      Author: nopper
+ */
+
+#include "TextureContainer.h"
+
+#include "TextureDecoder.h"
+
+using namespace std;
+
+TextureDecoder::TextureDecoder()
+{
+}
+
+TextureDecoder::~TextureDecoder()
+{
+}
+
+bool TextureDecoder::loadFile(const string& filename, PixelData& pixelData) const
+{
+	string extension = filename.length() > 4 ? filename.substr(filename.length() - 4, 4) : "";
+
+	transform(extension.begin(), extension.end(), extension.begin(), ::tolower);
+
+	if (extension.compare(".tga") != 0 && extension.compare(".hdr") != 0)
+	{
+		return false;
+	}
+
+	GLUSbinaryfile binaryfile;
+
+	if (!glusFileLoadBinary(filename.c_str(), &binaryfile))
+	{
+		return false;
+	}
+
+	// The pixels are decoded directly into the pixel data, without an intermediate image.
+	bool success = false;
+
+	if (extension.compare(".tga") == 0)
+	{
+		GLUStgaimage tgaimage;
+
+		if (glusImageInfoTga(&binaryfile, &tgaimage))
+		{
+			success = pixelData.allocatePixels(tgaimage.width, tgaimage.height, tgaimage.format, GL_UNSIGNED_BYTE, static_cast<uint32_t>(PixelData::getNumberChannels(tgaimage.format) * tgaimage.width * tgaimage.height)) && glusImageDecodeTga(&binaryfile, &tgaimage, pixelData.getPixels());
+		}
+	}
+	else
+	{
+		GLUShdrimage hdrimage;
+
+		if (glusImageInfoHdr(&binaryfile, &hdrimage))
+		{
+			success = pixelData.allocatePixels(hdrimage.width, hdrimage.height, hdrimage.format, GL_FLOAT, static_cast<uint32_t>(sizeof(float) * PixelData::getNumberChannels(hdrimage.format) * hdrimage.width * hdrimage.height)) && glusImageDecodeHdr(&binaryfile, &hdrimage, reinterpret_cast<GLUSfloat*>(pixelData.getPixels()));
+		}
+	}
+
+	glusFileDestroyBinary(&binaryfile);
+
+	if (!success)
+	{
+		pixelData.freePixels();
+	}
+
+	return success;
+}
+
+bool TextureDecoder::loadImage(const string& filename, PixelData& pixelData) const
+{
+	if (loadFile(filename, pixelData))
+	{
+		return true;
+	}
+
+	size_t found = filename.find_last_of("/\\");
+
+	if (found != string::npos && loadFile(filename.substr(found + 1), pixelData))
+	{
+		return true;
+	}
+
+	glusLogPrint(GLUS_LOG_ERROR, "Texture not found %s", filename.c_str());
+
+	return false;
+}
+
+bool TextureDecoder::isKtxFilename(const string& filename)
+{
+	string extension = filename.length() > 4 ? filename.substr(filename.length() - 4, 4) : "";
+
+	transform(extension.begin(), extension.end(), extension.begin(), ::tolower);
+
+	return extension.compare(".ktx") == 0;
+}
+
+bool TextureDecoder::isSupportedFilename(const string& filename)
+{
+	string extension = filename.length() > 4 ? filename.substr(filename.length() - 4, 4) : "";
+
+	transform(extension.begin(), extension.end(), extension.begin(), ::tolower);
+
+	return extension.compare(".tga") == 0 || extension.compare(".hdr") == 0 || extension.compare(".ktx") == 0;
+}
+
+string TextureDecoder::getCacheFilename(const TextureDecodeTask& task)
+{
+	GLUSbinaryfile binaryfile;
+
+	if (!glusFileLoadBinary(task.filename.c_str(), &binaryfile))
+	{
+		size_t found = task.filename.find_last_of("/\\");
+
+		if (found == string::npos || !glusFileLoadBinary(task.filename.substr(found + 1).c_str(), &binaryfile))
+		{
+			return "";
+		}
+	}
+
+	// FNV-1a of the content and the parameters.
+	uint64_t value = 0xCBF29CE484222325ULL;
+
+	for (GLUSint i = 0; i < binaryfile.length; i++)
+	{
+		value ^= binaryfile.binary[i];
+		value *= 0x100000001B3ULL;
+	}
+
+	glusFileDestroyBinary(&binaryfile);
+
+	const uint8_t parameters[4] = { static_cast<uint8_t>(task.compression), static_cast<uint8_t>(task.sRGB), static_cast<uint8_t>(task.mipMap), static_cast<uint8_t>(task.mipFilter) };
+
+	for (int32_t i = 0; i < 4; i++)
+	{
+		value ^= parameters[i];
+		value *= 0x100000001B3ULL;
+	}
+
+	const char* digits = "0123456789abcdef";
+
+	string key(16, '0');
+
+	for (int32_t i = 15; i >= 0; i--)
+	{
+		key[i] = digits[value & 0xF];
+
+		value >>= 4;
+	}
+
+	string filename = task.cacheDirectory;
+
+	if (filename[filename.size() - 1] != '/' && filename[filename.size() - 1] != '\\')
+	{
+		filename += "/";
+	}
+
+	return filename + key + ".ktx";
+}
+
+bool TextureDecoder::decode(TextureDecodeTask& task) const
+{
+	task.allMipLevels.clear();
+
+	// Already compressed, so the levels are taken as they are.
+	if (isKtxFilename(task.filename))
+	{
+		task.success = TextureContainer::load(task.filename, task.allMipLevels);
+
+		if (!task.success)
+		{
+			glusLogPrint(GLUS_LOG_ERROR, "Texture not found %s", task.filename.c_str());
+		}
+
+		return task.success;
+	}
+
+	string cacheFilename;
+
+	if (task.compression != TextureCompressionNone && task.cacheDirectory.size() > 0)
+	{
+		cacheFilename = getCacheFilename(task);
+
+		if (cacheFilename.size() > 0 && TextureContainer::load(cacheFilename, task.allMipLevels))
+		{
+			task.success = true;
+
+			return true;
+		}
+	}
+
+	PixelData pixelData;
+
+	task.success = loadImage(task.filename, pixelData);
+
+	if (!task.success)
+	{
+		return false;
+	}
+
+	if (!task.mipMap || !pixelData.createMipChain(task.allMipLevels, task.mipFilter, task.sRGB))
+	{
+		task.allMipLevels.push_back(pixelData);
+	}
+
+	if (task.compression != TextureCompressionNone)
+	{
+		vector<PixelData> compressedMipLevels;
+
+		if (!TextureCompressor::compressMipChain(task.allMipLevels, task.compression, task.sRGB, compressedMipLevels))
+		{
+			glusLogPrint(GLUS_LOG_WARNING, "Texture can not be compressed: %s", task.filename.c_str());
+
+			return true;
+		}
+
+		task.allMipLevels.swap(compressedMipLevels);
+
+		if (cacheFilename.size() > 0)
+		{
+			TextureContainer::save(cacheFilename, task.allMipLevels);
+		}
+	}
+
+	return true;
+}
@@ -0,0 +1,88 @@
+/*
+ * TextureDecoder.h
+ *
+ *  Created on: 19.10.2026
+ *      Author: nopper
+ */
+
+#ifndef TEXTUREDECODER_H_
+#define TEXTUREDECODER_H_
+
+#include "../../UsedLibs.h"
+
+#include "PixelData.h"
+#include "TextureCompressor.h"
+
+/**
+ * Request to decode a texture file and to create its mip levels.
+ */
+struct TextureDecodeTask
+{
+	std::uint32_t ticket;
+
+	std::string filename;
+
+	bool mipMap;
+
+	enum MipFilter mipFilter;
+
+	bool sRGB;
+
+	enum TextureCompression compression;
+
+	// Compressed mip levels are cached in this directory. Empty disables the cache.
+	std::string cacheDirectory;
+
+	// Filled by the decoder.
+
+	bool success;
+
+	std::vector<PixelData> allMipLevels;
+};
+
+typedef std::shared_ptr<TextureDecodeTask> TextureDecodeTaskSP;
+
+/**
+ * Decodes TGA and HDR files into pixel data and loads KTX files. Does not need a context, so it can be used on worker
+ * threads.
+ */
+class TextureDecoder
+{
+
+private:
+
+	bool loadFile(const std::string& filename, PixelData& pixelData) const;
+
+	static bool isKtxFilename(const std::string& filename);
+
+	/**
+	 * The name is a hash of the file content and the parameters of the task, so a changed file is compressed again.
+	 *
+	 * @return Empty, if the file does not exist.
+	 */
+	static std::string getCacheFilename(const TextureDecodeTask& task);
+
+public:
+
+	TextureDecoder();
+	virtual ~TextureDecoder();
+
+	/**
+	 * @return True, if the file is a TGA, HDR or KTX file, which can be decoded by the workers.
+	 */
+	static bool isSupportedFilename(const std::string& filename);
+
+	/**
+	 * Loads the image. If the file is not found, it is searched without the path.
+	 */
+	bool loadImage(const std::string& filename, PixelData& pixelData) const;
+
+	/**
+	 * Loads the image of the task and creates the mip levels, if requested. If compression is requested, the levels are
+	 * compressed or taken from the cache. Images, which can not be compressed, e.g. HDR ones, stay uncompressed.
+	 */
+	bool decode(TextureDecodeTask& task) const;
+
+};
+
+#endif /* TEXTUREDECODER_H_ */
@@ -5,6 +5,10 @@
  *      Author: Norbert Nopper
  */
 
+#include "TextureCompressor.h"
+#include "TextureContainer.h"
+#include "TextureStreamingManager.h"
+
 #include "TextureFactoryBase.h"
 
 using namespace std;
@@ -157,6 +161,63 @@ Texture2DSP TextureFactoryBase::createTexture2D(const string& identifier, GLint
 	return Texture2DSP(new Texture2D(identifier, internalFormat, width, height, format, type, pixels, sizeOfData, mipMap, minFilter, magFilter, wrapS, wrapT, anisotropic));
 }
 
+Texture2DSP TextureFactoryBase::createTexture2D(const string& identifier, GLint internalFormat, vector<PixelData>& mipLevels, GLint minFilter, GLint magFilter, GLint wrapS, GLint wrapT, float anisotropic) const
+{
+	Texture2DSP texture2D;
+
+	if (mipLevels.size() == 0)
+	{
+		return texture2D;
+	}
+
+	bool mipMap = mipLevels.size() > 1;
+
+	texture2D = Texture2DSP(new Texture2D(identifier, internalFormat, mipLevels, mipMap, minFilter, magFilter, wrapS, wrapT, anisotropic, mipMap ? TextureStreamingManager::getInstance()->getStreamingResolution() : 0));
+
+	if (texture2D->isStreaming())
+	{
+		TextureStreamingManager::getInstance()->addTexture(texture2D);
+	}
+
+	return texture2D;
+}
+
+Texture2DSP TextureFactoryBase::loadCompressedTexture2D(const string& filename, GLint minFilter, GLint magFilter, GLint wrapS, GLint wrapT, float anisotropic) const
+{
+	Texture2DSP texture2D;
+
+	vector<PixelData> mipLevels;
+
+	if (!TextureContainer::load(filename, mipLevels))
+	{
+		glusLogPrint(GLUS_LOG_ERROR, "Texture not found %s", filename.c_str());
+
+		return texture2D;
+	}
+
+	if (!TextureCompressor::isSupported(mipLevels[0].getFormat()))
+	{
+		glusLogPrint(GLUS_LOG_ERROR, "Compressed format not supported by the driver %s", filename.c_str());
+
+		return texture2D;
+	}
+
+	size_t found = filename.find_last_of("/\\");
+
+	string identifier = found != string::npos ? filename.substr(found + 1) : filename;
+
+	found = identifier.find_last_of(".");
+
+	if (found != string::npos)
+	{
+		identifier = identifier.substr(0, found);
+	}
+
+	glusLogPrint(GLUS_LOG_DEBUG, "Creating compressed texture: %s", filename.c_str());
+
+	return createTexture2D(identifier, mipLevels[0].getFormat(), mipLevels, minFilter, magFilter, wrapS, wrapT, anisotropic);
+}
+
 Texture2DArraySP TextureFactoryBase::createTexture2DArray(const string& identifier, int32_t width, int32_t height, GLenum format, GLenum type, bool mipMap, GLint minFilter, GLint magFilter, GLint wrapS, GLint wrapT, float anisotropic) const
 {
 	return Texture2DArraySP(new Texture2DArray(identifier, gatherInternalFormat(format, type), width, height, format, type, mipMap, minFilter, magFilter, wrapS, wrapT, anisotropic));
@@ -238,6 +299,18 @@ bool TextureFactoryBase::saveTextureCubeMap(const TextureCubeMapSP textureCubeMa
 
 bool TextureFactoryBase::saveTexture2D(const Texture2DSP texture2D, const string& path) const
 {
+	if (texture2D->isCompressed())
+	{
+		PixelData pixelData;
+
+		if (!TextureCompressor::decompress(texture2D->getPixelData(), pixelData))
+		{
+			return false;
+		}
+
+		return saveImage(path + texture2D->getIdentifier(), pixelData);
+	}
+
 	return saveImage(path + texture2D->getIdentifier(), texture2D->getPixelData());
 }
 
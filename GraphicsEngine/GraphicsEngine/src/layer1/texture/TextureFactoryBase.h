@@ -34,8 +34,6 @@ protected:
 	enum FormatDepth floatBitsPerPixel;
 	enum FormatDepth integerBitsPerPixel;
 
-	GLenum gatherInternalFormat(GLenum format, GLenum type) const;
-
 	virtual bool saveImage(const std::string& identifier, const PixelData& pixelData) const = 0;
 
 public:
@@ -43,6 +41,11 @@ public:
 	TextureFactoryBase();
 	virtual ~TextureFactoryBase();
 
+	/**
+	 * @return Internal format for the given format and type, depending on the configured bits per pixel.
+	 */
+	GLenum gatherInternalFormat(GLenum format, GLenum type) const;
+
 	Texture1DSP createTexture1D(const std::string& identifier, std::int32_t width, GLenum format, GLenum type, const std::uint8_t* pixels = nullptr, std::uint32_t sizeOfData = 0, bool mipMap = true, GLint minFilter = GL_LINEAR_MIPMAP_LINEAR, GLint magFilter = GL_LINEAR, GLint wrapS = GL_REPEAT, GLint wrapT = GL_REPEAT, float anisotropic = 1.0f) const;
 
 	Texture1DSP createTexture1D(const std::string& identifier, GLint internalFormat, std::int32_t width, GLenum format, GLenum type, const std::uint8_t* pixels = nullptr, std::uint32_t sizeOfData = 0, bool mipMap = true, GLint minFilter = GL_LINEAR_MIPMAP_LINEAR, GLint magFilter = GL_LINEAR, GLint wrapS = GL_REPEAT, GLint wrapT = GL_REPEAT, float anisotropic = 1.0f) const;
@@ -63,6 +66,16 @@ public:
 
 	Texture2DSP createTexture2D(const std::string& identifier, GLint internalFormat, std::int32_t width, std::int32_t height, GLenum format, GLenum type, const std::uint8_t* pixels, std::uint32_t sizeOfData, bool mipMap = true, GLint minFilter = GL_LINEAR_MIPMAP_LINEAR, GLint magFilter = GL_LINEAR, GLint wrapS = GL_REPEAT, GLint wrapT = GL_REPEAT, float anisotropic = 1.0f) const;
 
+	/**
+	 * Creates a texture from the given mip levels, e.g. compressed ones. The levels are moved into the texture.
+	 */
+	Texture2DSP createTexture2D(const std::string& identifier, GLint internalFormat, std::vector<PixelData>& mipLevels, GLint minFilter = GL_LINEAR_MIPMAP_LINEAR, GLint magFilter = GL_LINEAR, GLint wrapS = GL_REPEAT, GLint wrapT = GL_REPEAT, float anisotropic = 1.0f) const;
+
+	/**
+	 * Loads a block compressed texture including its mip levels from a KTX file. The levels are uploaded as they are.
+	 */
+	Texture2DSP loadCompressedTexture2D(const std::string& filename, GLint minFilter = GL_LINEAR_MIPMAP_LINEAR, GLint magFilter = GL_LINEAR, GLint wrapS = GL_REPEAT, GLint wrapT = GL_REPEAT, float anisotropic = 1.0f) const;
+
 	//
 
 	Texture2DArraySP createTexture2DArray(const std::string& identifier, std::int32_t width, std::int32_t height, GLenum format, GLenum type, bool mipMap = true, GLint minFilter = GL_LINEAR_MIPMAP_LINEAR, GLint magFilter = GL_LINEAR, GLint wrapS = GL_REPEAT, GLint wrapT = GL_REPEAT, float anisotropic = 1.0f) const;
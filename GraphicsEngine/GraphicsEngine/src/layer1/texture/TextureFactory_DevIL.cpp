@@ -5,6 +5,8 @@
  *      Author: Norbert Nopper
  */
 
+#include "TextureStreamingManager.h"
+
 #include "TextureFactory_DevIL.h"
 
 using namespace std;
@@ -127,7 +129,12 @@ Texture2DSP TextureFactory::loadTexture2D(const string& filename, bool mipMap, G
 
 		glusLogPrint(GLUS_LOG_DEBUG, "Creating texture: %s", filename.c_str());
 
-		texture2D = Texture2DSP(new Texture2D(identifier, gatherInternalFormat(imageInfo.Format, imageInfo.Type), imageInfo.Width, imageInfo.Height, imageInfo.Format, imageInfo.Type, imageInfo.Data, imageInfo.SizeOfData, mipMap, minFilter, magFilter, wrapS, wrapT, anisotropic));
+		texture2D = Texture2DSP(new Texture2D(identifier, gatherInternalFormat(imageInfo.Format, imageInfo.Type), imageInfo.Width, imageInfo.Height, imageInfo.Format, imageInfo.Type, imageInfo.Data, imageInfo.SizeOfData, mipMap, minFilter, magFilter, wrapS, wrapT, anisotropic, mipMap ? TextureStreamingManager::getInstance()->getStreamingResolution() : 0));
+
+		if (texture2D->isStreaming())
+		{
+			TextureStreamingManager::getInstance()->addTexture(texture2D);
+		}
 
 		ilBindImage(0);
 		ilDeleteImages(1, &imageName);
@@ -136,6 +143,29 @@ Texture2DSP TextureFactory::loadTexture2D(const string& filename, bool mipMap, G
 	return texture2D;
 }
 
+bool TextureFactory::loadPixelData(const string& filename, PixelData& pixelData) const
+{
+	string identifier;
+
+	ILuint imageName = loadImage(filename, identifier);
+
+	if (!imageName)
+	{
+		return false;
+	}
+
+	ILinfo imageInfo;
+
+	iluGetImageInfo(&imageInfo);
+
+	pixelData = PixelData(imageInfo.Width, imageInfo.Height, imageInfo.Format, imageInfo.Type, imageInfo.Data, imageInfo.SizeOfData);
+
+	ilBindImage(0);
+	ilDeleteImages(1, &imageName);
+
+	return pixelData.getPixels() != nullptr;
+}
+
 TextureCubeMapSP TextureFactory::loadTextureCubeMap(const string& identifier, const string& posX, const string& negX, const string& posY, const string& negY, const string& posZ, const string& negZ, bool mipMap, GLint minFilter, GLint magFilter, GLint wrapS, GLint wrapT, float anisotropic) const
 {
 	TextureCubeMapSP textureCubeMap;
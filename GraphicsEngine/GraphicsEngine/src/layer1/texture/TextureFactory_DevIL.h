@@ -29,6 +29,11 @@ public:
 
 	virtual Texture2DSP loadTexture2D(const std::string& filename, bool mipMap = true, GLint minFilter = GL_LINEAR_MIPMAP_LINEAR, GLint magFilter = GL_LINEAR, GLint wrapS = GL_REPEAT, GLint wrapT = GL_REPEAT, float anisotropic = 1.0f) const;
 
+	/**
+	 * Loads the pixels of the image without creating a texture, e.g. for replacing the pixels of an existing one.
+	 */
+	virtual bool loadPixelData(const std::string& filename, PixelData& pixelData) const;
+
 	/**
 	 * If you have DirectX images, convert the following way before usage:
 	 *
@@ -5,6 +5,8 @@
  *      Author: Norbert Nopper
  */
 
+#include "TextureStreamingManager.h"
+
 #include "TextureFactory_GLUS.h"
 
 using namespace std;
@@ -202,7 +204,12 @@ Texture2DSP TextureFactory::loadTexture2D(const string& filename, bool mipMap, G
 
 		glusLogPrint(GLUS_LOG_DEBUG, "Creating texture: %s", filename.c_str());
 
-		texture2D = Texture2DSP(new Texture2D(identifier, gatherInternalFormat(tgaimage.format, GL_UNSIGNED_BYTE), tgaimage.width, image_tgaeight, tgaimage.format, GL_UNSIGNED_BYTE, tgaimage.data, sizeof(uint8_t) * getNumberChannels(tgaimage.format) * tgaimage.width * image_tgaeight, mipMap, minFilter, magFilter, wrapS, wrapT, anisotropic));
+		texture2D = Texture2DSP(new Texture2D(identifier, gatherInternalFormat(tgaimage.format, GL_UNSIGNED_BYTE), tgaimage.width, tgaimage.height, tgaimage.format, GL_UNSIGNED_BYTE, tgaimage.data, sizeof(uint8_t) * getNumberChannels(tgaimage.format) * tgaimage.width * tgaimage.height, mipMap, minFilter, magFilter, wrapS, wrapT, anisotropic, mipMap ? TextureStreamingManager::getInstance()->getStreamingResolution() : 0));
+
+		if (texture2D->isStreaming())
+		{
+			TextureStreamingManager::getInstance()->addTexture(texture2D);
+		}
 
 		glusImageDestroyTga(&tgaimage);
 	}
@@ -215,7 +222,12 @@ Texture2DSP TextureFactory::loadTexture2D(const string& filename, bool mipMap, G
 
 		glusLogPrint(GLUS_LOG_DEBUG, "Creating texture: %s", filename.c_str());
 
-		texture2D = Texture2DSP(new Texture2D(identifier, gatherInternalFormat(hdrimage.format, GL_FLOAT), hdrimage.width, image_hdreight, hdrimage.format, GL_FLOAT, (uint8_t*)hdrimage.data, sizeof(float) * getNumberChannels(hdrimage.format) * hdrimage.width * image_hdreight, mipMap, minFilter, magFilter, wrapS, wrapT, anisotropic));
+		texture2D = Texture2DSP(new Texture2D(identifier, gatherInternalFormat(hdrimage.format, GL_FLOAT), hdrimage.width, hdrimage.height, hdrimage.format, GL_FLOAT, (uint8_t*)hdrimage.data, sizeof(float) * getNumberChannels(hdrimage.format) * hdrimage.width * hdrimage.height, mipMap, minFilter, magFilter, wrapS, wrapT, anisotropic, mipMap ? TextureStreamingManager::getInstance()->getStreamingResolution() : 0));
+
+		if (texture2D->isStreaming())
+		{
+			TextureStreamingManager::getInstance()->addTexture(texture2D);
+		}
 
 		glusImageDestroyHdr(&hdrimage);
 	}
@@ -229,6 +241,46 @@ Texture2DSP TextureFactory::loadTexture2D(const string& filename, bool mipMap, G
 	return texture2D;
 }
 
+bool TextureFactory::loadPixelData(const string& filename, PixelData& pixelData) const
+{
+	string identifier;
+
+	if (isTgaFilename(filename))
+	{
+		GLUStgaimage tgaimage;
+
+		if (!loadTgaImage(filename, identifier, tgaimage))
+		{
+			return false;
+		}
+
+		pixelData = PixelData(tgaimage.width, tgaimage.height, tgaimage.format, GL_UNSIGNED_BYTE, tgaimage.data, sizeof(uint8_t) * getNumberChannels(tgaimage.format) * tgaimage.width * tgaimage.height);
+
+		glusImageDestroyTga(&tgaimage);
+	}
+	else if (isHdrFilename(filename))
+	{
+		GLUShdrimage hdrimage;
+
+		if (!loadHdrImage(filename, identifier, hdrimage))
+		{
+			return false;
+		}
+
+		pixelData = PixelData(hdrimage.width, hdrimage.height, hdrimage.format, GL_FLOAT, (uint8_t*)hdrimage.data, sizeof(float) * getNumberChannels(hdrimage.format) * hdrimage.width * hdrimage.height);
+
+		glusImageDestroyHdr(&hdrimage);
+	}
+	else
+	{
+		glusLogPrint(GLUS_LOG_ERROR, "Unsupported Texture format %s", filename.c_str());
+
+		return false;
+	}
+
+	return pixelData.getPixels() != nullptr;
+}
+
 TextureCubeMapSP TextureFactory::loadTextureCubeMap(const string& identifier, const string& posX, const string& negX, const string& posY, const string& negY, const string& posZ, const string& negZ, bool mipMap, GLint minFilter, GLint magFilter, GLint wrapS, GLint wrapT, float anisotropic) const
 {
 	TextureCubeMapSP textureCubeMap;
@@ -507,7 +559,7 @@ bool TextureFactory::saveImage(const string& identifier, const PixelData& pixelD
 		string filename = identifier + ".hdr";
 
 		hdrimage.width = pixelData.getWidth();
-		image_hdreight = pixelData.getHeight();
+		hdrimage.height = pixelData.getHeight();
 		hdrimage.depth= 1;
 		hdrimage.format = pixelData.getFormat();
 		hdrimage.data = (float*)pixelData.getPixels();
@@ -523,7 +575,7 @@ bool TextureFactory::saveImage(const string& identifier, const PixelData& pixelD
 		string filename = identifier + ".tga";
 
 		tgaimage.width = pixelData.getWidth();
-		image_tgaeight = pixelData.getHeight();
+		tgaimage.height = pixelData.getHeight();
 		tgaimage.depth= 1;
 		tgaimage.format = pixelData.getFormat();
 		tgaimage.data = pixelData.getPixels();
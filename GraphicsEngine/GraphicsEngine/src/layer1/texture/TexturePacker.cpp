@@ -0,0 +1,264 @@
+/*
+ * TexturePacker.cpp
+ *
+ *  Created on: 19.10.2026
+ *      Author: nopper
+ */
+
+#include "../../layer0/algorithm/RectanglePacker.h"
+#include "Texture2DArrayManager.h"
+
+#include "TexturePacker.h"
+
+using namespace std;
+
+TexturePacker::TexturePacker(int32_t layerSize, int32_t maxTextureSize, int32_t border) :
+	layerSize(layerSize), maxTextureSize(maxTextureSize), border(border > 0 ? border : 0), allTextures(), allRegions(), allTextureArrays()
+{
+}
+
+TexturePacker::~TexturePacker()
+{
+	allTextures.clear();
+	allRegions.clear();
+	allTextureArrays.clear();
+}
+
+bool TexturePacker::isPackable(const Texture2DSP& texture) const
+{
+	if (!texture.get() || texture->isStreaming())
+	{
+		return false;
+	}
+
+	const PixelData& pixelData = texture->getPixelData();
+
+	if (!pixelData.getPixels() || pixelData.getWidth() != texture->getWidth() || pixelData.getHeight() != texture->getHeight())
+	{
+		return false;
+	}
+
+	if (PixelData::getNumberChannels(pixelData.getFormat()) == 0 || (pixelData.getType() != GL_UNSIGNED_BYTE && pixelData.getType() != GL_FLOAT))
+	{
+		return false;
+	}
+
+	if (texture->getWrapS() != GL_REPEAT || texture->getWrapT() != GL_REPEAT)
+	{
+		return false;
+	}
+
+	int32_t size = max(texture->getWidth(), texture->getHeight());
+
+	return size <= maxTextureSize && size + 2 * border <= layerSize;
+}
+
+bool TexturePacker::addTexture(const Texture2DSP& texture)
+{
+	if (!isPackable(texture) || find(allTextures.begin(), allTextures.end(), texture) != allTextures.end())
+	{
+		return false;
+	}
+
+	allTextures.push_back(texture);
+
+	return true;
+}
+
+void TexturePacker::packGroup(const string& identifier, const vector<Texture2DSP>& allGroupTextures)
+{
+	vector<Texture2DSP> allSortedTextures(allGroupTextures);
+
+	stable_sort(allSortedTextures.begin(), allSortedTextures.end(), [](const Texture2DSP& a, const Texture2DSP& b)
+	{
+		return a->getHeight() > b->getHeight() || (a->getHeight() == b->getHeight() && a->getWidth() > b->getWidth());
+	});
+
+	int32_t maxPaddedSize = 0;
+	uint64_t totalArea = 0;
+
+	auto walker = allSortedTextures.begin();
+	while (walker != allSortedTextures.end())
+	{
+		int32_t paddedWidth = (*walker)->getWidth() + 2 * border;
+		int32_t paddedHeight = (*walker)->getHeight() + 2 * border;
+
+		maxPaddedSize = max(maxPaddedSize, max(paddedWidth, paddedHeight));
+		totalArea += static_cast<uint64_t>(paddedWidth) * static_cast<uint64_t>(paddedHeight);
+
+		walker++;
+	}
+
+	// Smaller layers for few textures, but leave enough space for the packing to succeed in most cases.
+	int32_t size = layerSize;
+
+	while (size / 2 >= maxPaddedSize && totalArea * 2 <= static_cast<uint64_t>(size / 2) * static_cast<uint64_t>(size / 2))
+	{
+		size /= 2;
+	}
+
+	vector<RectanglePacker> allLayers;
+
+	map<const Texture2D*, pair<int32_t, pair<int32_t, int32_t> > > allPlacements;
+
+	walker = allSortedTextures.begin();
+	while (walker != allSortedTextures.end())
+	{
+		int32_t paddedWidth = (*walker)->getWidth() + 2 * border;
+		int32_t paddedHeight = (*walker)->getHeight() + 2 * border;
+
+		int32_t x = 0;
+		int32_t y = 0;
+
+		int32_t layer = 0;
+
+		while (layer < static_cast<int32_t>(allLayers.size()) && !allLayers[layer].insert(paddedWidth, paddedHeight, x, y))
+		{
+			layer++;
+		}
+
+		if (layer == static_cast<int32_t>(allLayers.size()))
+		{
+			allLayers.push_back(RectanglePacker(size, size));
+
+			allLayers.back().insert(paddedWidth, paddedHeight, x, y);
+		}
+
+		allPlacements[walker->get()] = make_pair(layer, make_pair(x + border, y + border));
+
+		walker++;
+	}
+
+	const Texture2DSP& firstTexture = allSortedTextures.front();
+
+	GLenum format = firstTexture->getFormat();
+	GLenum type = firstTexture->getType();
+
+	uint32_t sizeOfLayer = static_cast<uint32_t>(size * size * PixelData::getNumberChannels(format)) * (type == GL_FLOAT ? sizeof(float) : sizeof(uint8_t));
+
+	vector<uint8_t> emptyPixels(sizeOfLayer, 0);
+
+	vector<PixelDataSP> allLayerPixels;
+
+	for (uint32_t layer = 0; layer < allLayers.size(); layer++)
+	{
+		allLayerPixels.push_back(PixelDataSP(new PixelData(size, size, format, type, emptyPixels.data(), sizeOfLayer)));
+	}
+
+	walker = allSortedTextures.begin();
+	while (walker != allSortedTextures.end())
+	{
+		const pair<int32_t, pair<int32_t, int32_t> >& placement = allPlacements[walker->get()];
+
+		allLayerPixels[placement.first]->copyPixels((*walker)->getPixelData(), placement.second.first, placement.second.second, border);
+
+		walker++;
+	}
+
+	string key = identifier + "_" + to_string(allTextureArrays.size());
+
+	Texture2DArraySP texture2DArray = Texture2DArraySP(new Texture2DArray(key, firstTexture->getInternalFormat(), size, size, format, type, firstTexture->isMipMap(), firstTexture->getMinFilter(), firstTexture->getMagFilter(), GL_CLAMP_TO_EDGE, GL_CLAMP_TO_EDGE, firstTexture->getAnisotropic()));
+
+	for (uint32_t layer = 0; layer < allLayerPixels.size(); layer++)
+	{
+		texture2DArray->addPixelData(allLayerPixels[layer]);
+	}
+
+	// A texel of level n covers 2^n pixels, so coarser levels than log2 of the border would filter in the neighbors.
+	int32_t maxLevel = 0;
+
+	while ((2 << maxLevel) <= border)
+	{
+		maxLevel++;
+	}
+
+	texture2DArray->setMaxLevel(maxLevel);
+
+	if (!texture2DArray->init())
+	{
+		glusLogPrint(GLUS_LOG_ERROR, "Could not create packed texture: %s", key.c_str());
+
+		return;
+	}
+
+	texture2DArray->setAnisotropic(firstTexture->getAnisotropic());
+
+	// The layers are only needed for uploading.
+	texture2DArray->freePixels();
+
+	Texture2DArrayManager::getInstance()->addTexture(key, texture2DArray);
+
+	allTextureArrays.push_back(texture2DArray);
+
+	walker = allSortedTextures.begin();
+	while (walker != allSortedTextures.end())
+	{
+		const pair<int32_t, pair<int32_t, int32_t> >& placement = allPlacements[walker->get()];
+
+		TextureRegion region;
+
+		region.texture2DArray = texture2DArray;
+		region.layer = placement.first;
+		region.offset[0] = static_cast<float>(placement.second.first) / static_cast<float>(size);
+		region.offset[1] = static_cast<float>(placement.second.second) / static_cast<float>(size);
+		region.scale[0] = static_cast<float>((*walker)->getWidth()) / static_cast<float>(size);
+		region.scale[1] = static_cast<float>((*walker)->getHeight()) / static_cast<float>(size);
+
+		allRegions[walker->get()] = region;
+
+		walker++;
+	}
+
+	glusLogPrint(GLUS_LOG_DEBUG, "Packed %d textures into %s with %d layers of %dx%d", static_cast<int32_t>(allSortedTextures.size()), key.c_str(), static_cast<int32_t>(allLayers.size()), size, size);
+}
+
+int32_t TexturePacker::pack(const string& identifier)
+{
+	map<pair<pair<GLint, GLenum>, pair<GLenum, bool> >, vector<Texture2DSP> > allGroups;
+
+	auto walker = allTextures.begin();
+	while (walker != allTextures.end())
+	{
+		if (allRegions.find(walker->get()) == allRegions.end())
+		{
+			allGroups[make_pair(make_pair((*walker)->getInternalFormat(), (*walker)->getFormat()), make_pair((*walker)->getType(), (*walker)->isMipMap()))].push_back(*walker);
+		}
+
+		walker++;
+	}
+
+	int32_t result = 0;
+
+	auto groupWalker = allGroups.begin();
+	while (groupWalker != allGroups.end())
+	{
+		// A single texture would only be moved into an array, without saving any binds.
+		if (groupWalker->second.size() > 1)
+		{
+			size_t before = allRegions.size();
+
+			packGroup(identifier, groupWalker->second);
+
+			result += static_cast<int32_t>(allRegions.size() - before);
+		}
+
+		groupWalker++;
+	}
+
+	return result;
+}
+
+bool TexturePacker::containsRegion(const Texture2D* texture) const
+{
+	return allRegions.find(texture) != allRegions.end();
+}
+
+const TextureRegion& TexturePacker::getRegion(const Texture2D* texture) const
+{
+	return allRegions.at(texture);
+}
+
+const vector<Texture2DArraySP>& TexturePacker::getTextureArrays() const
+{
+	return allTextureArrays;
+}
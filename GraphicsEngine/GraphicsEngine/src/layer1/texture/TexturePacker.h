@@ -0,0 +1,87 @@
+/*
+ * TexturePacker.h
+ *
+ *  Created on: 19.10.2026
+ *      Author: nopper
+ */
+
+#ifndef TEXTUREPACKER_H_
+#define TEXTUREPACKER_H_
+
+#include "../../UsedLibs.h"
+
+#include "Texture2D.h"
+#include "Texture2DArray.h"
+
+/**
+ * Location of a packed texture. Texture coordinates are transformed by offset + fract(texCoord) * scale.
+ */
+struct TextureRegion
+{
+	Texture2DArraySP texture2DArray;
+
+	std::int32_t layer;
+
+	float offset[2];
+
+	float scale[2];
+};
+
+/**
+ * Packs small 2D textures of the same format into the layers of 2D texture arrays. Repeating is emulated by the
+ * region transform, so only textures with repeat wrapping and their pixels still on the CPU are packed. A border of
+ * wrapped pixels around each texture avoids bleeding of the neighbors, when filtering. The mip levels are limited to
+ * log2 of the border, as coarser levels would mix the neighbors.
+ */
+class TexturePacker
+{
+
+private:
+
+	std::int32_t layerSize;
+
+	std::int32_t maxTextureSize;
+
+	std::int32_t border;
+
+	std::vector<Texture2DSP> allTextures;
+
+	std::map<const Texture2D*, TextureRegion> allRegions;
+
+	std::vector<Texture2DArraySP> allTextureArrays;
+
+	void packGroup(const std::string& identifier, const std::vector<Texture2DSP>& allGroupTextures);
+
+public:
+
+	/**
+	 * @param layerSize Maximum width and height of a layer.
+	 * @param maxTextureSize Larger textures are not packed.
+	 * @param border Pixels around each texture. Also limits the used mip levels, e.g. 4 pixels allow the levels up to 2.
+	 */
+	TexturePacker(std::int32_t layerSize = 1024, std::int32_t maxTextureSize = 256, std::int32_t border = 4);
+	virtual ~TexturePacker();
+
+	bool isPackable(const Texture2DSP& texture) const;
+
+	/**
+	 * @return False, if the texture can not be packed or has already been added.
+	 */
+	bool addTexture(const Texture2DSP& texture);
+
+	/**
+	 * Packs all added textures and uploads the texture arrays. Groups of the same format, type and mip mapping share arrays.
+	 *
+	 * @return Number of packed textures.
+	 */
+	std::int32_t pack(const std::string& identifier);
+
+	bool containsRegion(const Texture2D* texture) const;
+
+	const TextureRegion& getRegion(const Texture2D* texture) const;
+
+	const std::vector<Texture2DArraySP>& getTextureArrays() const;
+
+};
+
+#endif /* TEXTUREPACKER_H_ */
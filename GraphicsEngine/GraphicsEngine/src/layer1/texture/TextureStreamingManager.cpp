@@ -0,0 +1,360 @@
+/*
+ * TextureStreamingManager.cpp
+ *
+ *  Created on: 19.10.2026
+ *      Author: nopper
+ */
+
+#include "TextureStreamingManager.h"
+
+using namespace std;
+
+TextureStreamingManager::TextureStreamingManager() :
+	Singleton<TextureStreamingManager>(), allEntries(), streamingResolution(0), budget(0), maxUploadsPerFrame(4), requestFrames(30), frame(0), residentBytes(0)
+{
+}
+
+TextureStreamingManager::~TextureStreamingManager()
+{
+	allEntries.clear();
+}
+
+int32_t TextureStreamingManager::calculateWantedLevel(const TextureStreamingEntry& entry) const
+{
+	int32_t wantedLevel = entry.minimumLevel;
+
+	if (entry.requestedResolution <= 0.0f || frame - entry.lastRequestFrame > requestFrames)
+	{
+		return wantedLevel;
+	}
+
+	StreamableTextureSP texture = entry.texture.lock();
+
+	while (wantedLevel > 0 && static_cast<float>(texture->getLevelResolution(wantedLevel)) < entry.requestedResolution)
+	{
+		wantedLevel--;
+	}
+
+	return wantedLevel;
+}
+
+uint64_t TextureStreamingManager::calculateResidentBytes(const TextureStreamingEntry& entry) const
+{
+	uint64_t result = 0;
+
+	StreamableTextureSP texture = entry.texture.lock();
+
+	if (!texture.get())
+	{
+		return result;
+	}
+
+	for (int32_t level = texture->getResidentLevel(); level < texture->getNumberLevels(); level++)
+	{
+		result += texture->getLevelSize(level);
+	}
+
+	return result;
+}
+
+void TextureStreamingManager::setResidentLevel(TextureStreamingEntry& entry, int32_t level)
+{
+	StreamableTextureSP texture = entry.texture.lock();
+
+	if (texture.get() && texture->setResidentLevel(level))
+	{
+		uint64_t bytes = calculateResidentBytes(entry);
+
+		residentBytes = residentBytes - entry.residentBytes + bytes;
+
+		entry.residentBytes = bytes;
+	}
+}
+
+void TextureStreamingManager::removeExpired()
+{
+	auto walker = allEntries.begin();
+	while (walker != allEntries.end())
+	{
+		if (walker->second.texture.expired())
+		{
+			residentBytes -= walker->second.residentBytes;
+
+			walker = allEntries.erase(walker);
+
+			continue;
+		}
+
+		walker++;
+	}
+}
+
+bool TextureStreamingManager::evictUnwanted(uint64_t additionalBytes, const StreamableTexture* keep)
+{
+	if (budget == 0)
+	{
+		return true;
+	}
+
+	while (residentBytes + additionalBytes > budget)
+	{
+		TextureStreamingEntry* oldestEntry = nullptr;
+
+		auto walker = allEntries.begin();
+		while (walker != allEntries.end())
+		{
+			TextureStreamingEntry& entry = walker->second;
+
+			if (walker->first != keep && walker->first->getResidentLevel() < calculateWantedLevel(entry))
+			{
+				if (!oldestEntry || entry.lastRequestFrame < oldestEntry->lastRequestFrame || (entry.lastRequestFrame == oldestEntry->lastRequestFrame && entry.requestedResolution < oldestEntry->requestedResolution))
+				{
+					oldestEntry = &entry;
+				}
+			}
+
+			walker++;
+		}
+
+		if (!oldestEntry)
+		{
+			return false;
+		}
+
+		setResidentLevel(*oldestEntry, oldestEntry->texture.lock()->getResidentLevel() + 1);
+	}
+
+	return true;
+}
+
+void TextureStreamingManager::evictWanted()
+{
+	if (budget == 0)
+	{
+		return;
+	}
+
+	while (residentBytes > budget)
+	{
+		TextureStreamingEntry* smallestEntry = nullptr;
+		float smallestSharpness = 0.0f;
+
+		auto walker = allEntries.begin();
+		while (walker != allEntries.end())
+		{
+			TextureStreamingEntry& entry = walker->second;
+
+			const StreamableTexture* texture = walker->first;
+
+			if (texture->getResidentLevel() < entry.minimumLevel)
+			{
+				float sharpness = entry.requestedResolution / static_cast<float>(texture->getLevelResolution(texture->getResidentLevel()));
+
+				// Prefer the texture, which is the sharpest compared to its resolution on screen.
+				if (!smallestEntry || sharpness < smallestSharpness)
+				{
+					smallestEntry = &entry;
+					smallestSharpness = sharpness;
+				}
+			}
+
+			walker++;
+		}
+
+		if (!smallestEntry)
+		{
+			return;
+		}
+
+		setResidentLevel(*smallestEntry, smallestEntry->texture.lock()->getResidentLevel() + 1);
+	}
+}
+
+void TextureStreamingManager::setStreamingResolution(int32_t streamingResolution)
+{
+	this->streamingResolution = streamingResolution > 0 ? streamingResolution : 0;
+}
+
+int32_t TextureStreamingManager::getStreamingResolution() const
+{
+	return streamingResolution;
+}
+
+void TextureStreamingManager::setBudget(uint64_t budget)
+{
+	this->budget = budget;
+}
+
+uint64_t TextureStreamingManager::getBudget() const
+{
+	return budget;
+}
+
+void TextureStreamingManager::setMaxUploadsPerFrame(int32_t maxUploadsPerFrame)
+{
+	this->maxUploadsPerFrame = maxUploadsPerFrame > 0 ? maxUploadsPerFrame : 0;
+}
+
+int32_t TextureStreamingManager::getMaxUploadsPerFrame() const
+{
+	return maxUploadsPerFrame;
+}
+
+void TextureStreamingManager::setRequestFrames(uint32_t requestFrames)
+{
+	this->requestFrames = requestFrames;
+}
+
+uint32_t TextureStreamingManager::getRequestFrames() const
+{
+	return requestFrames;
+}
+
+void TextureStreamingManager::addTexture(const StreamableTextureSP& texture)
+{
+	if (!texture.get() || containsTexture(texture.get()))
+	{
+		return;
+	}
+
+	// A released texture may have had the same address.
+	removeTexture(texture.get());
+
+	TextureStreamingEntry entry;
+
+	entry.texture = texture;
+	entry.minimumLevel = texture->getResidentLevel();
+	entry.requestedResolution = 0.0f;
+	entry.lastRequestFrame = frame;
+	entry.residentBytes = calculateResidentBytes(entry);
+
+	residentBytes += entry.residentBytes;
+
+	allEntries[texture.get()] = entry;
+}
+
+void TextureStreamingManager::removeTexture(const StreamableTexture* texture)
+{
+	auto walker = allEntries.find(texture);
+
+	if (walker == allEntries.end())
+	{
+		return;
+	}
+
+	residentBytes -= walker->second.residentBytes;
+
+	allEntries.erase(walker);
+}
+
+bool TextureStreamingManager::containsTexture(const StreamableTexture* texture) const
+{
+	auto walker = allEntries.find(texture);
+
+	return walker != allEntries.end() && !walker->second.texture.expired();
+}
+
+int32_t TextureStreamingManager::getNumberTextures() const
+{
+	int32_t result = 0;
+
+	for (auto& currentEntry : allEntries)
+	{
+		if (!currentEntry.second.texture.expired())
+		{
+			result++;
+		}
+	}
+
+	return result;
+}
+
+void TextureStreamingManager::requestResolution(const StreamableTexture* texture, float resolution)
+{
+	auto walker = allEntries.find(texture);
+
+	if (walker == allEntries.end())
+	{
+		return;
+	}
+
+	TextureStreamingEntry& entry = walker->second;
+
+	// Requests of older frames are replaced, the ones of the current frame are merged.
+	if (entry.lastRequestFrame != frame)
+	{
+		entry.requestedResolution = resolution;
+		entry.lastRequestFrame = frame;
+	}
+	else
+	{
+		entry.requestedResolution = glusMathMaxf(entry.requestedResolution, resolution);
+	}
+}
+
+void TextureStreamingManager::update()
+{
+	removeExpired();
+
+	// The requests of the last frame are evaluated.
+	evictWanted();
+
+	int32_t uploads = 0;
+
+	vector<const StreamableTexture*> allSkipped;
+
+	while (uploads < maxUploadsPerFrame)
+	{
+		TextureStreamingEntry* neediestEntry = nullptr;
+		float neediestDeficit = 0.0f;
+
+		auto walker = allEntries.begin();
+		while (walker != allEntries.end())
+		{
+			TextureStreamingEntry& entry = walker->second;
+
+			const StreamableTexture* texture = walker->first;
+
+			if (texture->getResidentLevel() > calculateWantedLevel(entry) && find(allSkipped.begin(), allSkipped.end(), texture) == allSkipped.end())
+			{
+				float deficit = entry.requestedResolution / static_cast<float>(texture->getLevelResolution(texture->getResidentLevel()));
+
+				if (!neediestEntry || deficit > neediestDeficit)
+				{
+					neediestEntry = &entry;
+					neediestDeficit = deficit;
+				}
+			}
+
+			walker++;
+		}
+
+		if (!neediestEntry)
+		{
+			break;
+		}
+
+		StreamableTextureSP texture = neediestEntry->texture.lock();
+
+		int32_t level = texture->getResidentLevel() - 1;
+
+		if (!evictUnwanted(texture->getLevelSize(level), texture.get()))
+		{
+			// Smaller levels of other textures may still fit.
+			allSkipped.push_back(texture.get());
+
+			continue;
+		}
+
+		setResidentLevel(*neediestEntry, level);
+
+		uploads++;
+	}
+
+	frame++;
+}
+
+uint64_t TextureStreamingManager::getResidentBytes() const
+{
+	return residentBytes;
+}
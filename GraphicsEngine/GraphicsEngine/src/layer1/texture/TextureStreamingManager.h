@@ -0,0 +1,157 @@
+/*
+ * TextureStreamingManager.h
+ *
+ *  Created on: 19.10.2026
+ *      Author: nopper
+ */
+
+#ifndef TEXTURESTREAMINGMANAGER_H_
+#define TEXTURESTREAMINGMANAGER_H_
+
+#include "../../UsedLibs.h"
+
+#include "../../layer0/stereotype/Singleton.h"
+
+#include "StreamableTexture.h"
+
+/**
+ * Streaming state of one texture.
+ */
+struct TextureStreamingEntry
+{
+	/**
+	 * Not owned, so the texture is released by its users. The entry is removed at the next update.
+	 */
+	std::weak_ptr<StreamableTexture> texture;
+
+	/**
+	 * Coarsest level, which always stays resident.
+	 */
+	std::int32_t minimumLevel;
+
+	/**
+	 * Largest resolution in pixels requested by the renderer within the current frame.
+	 */
+	float requestedResolution;
+
+	std::uint32_t lastRequestFrame;
+
+	/**
+	 * Bytes of the resident levels, which are counted for this texture.
+	 */
+	std::uint64_t residentBytes;
+};
+
+/**
+ * Keeps the mip levels in video memory, which are needed for the resolution the textures appear with on the screen.
+ * Missing levels are uploaded with the largest deficit first. If the budget is exceeded, the levels of textures,
+ * which were not visible for the longest time, are evicted first.
+ */
+class TextureStreamingManager : public Singleton<TextureStreamingManager>
+{
+
+	friend class Singleton<TextureStreamingManager>;
+
+private:
+
+	std::map<const StreamableTexture*, TextureStreamingEntry> allEntries;
+
+	std::int32_t streamingResolution;
+
+	std::uint64_t budget;
+
+	std::int32_t maxUploadsPerFrame;
+
+	std::uint32_t requestFrames;
+
+	std::uint32_t frame;
+
+	std::uint64_t residentBytes;
+
+	std::int32_t calculateWantedLevel(const TextureStreamingEntry& entry) const;
+
+	std::uint64_t calculateResidentBytes(const TextureStreamingEntry& entry) const;
+
+	/**
+	 * Evicts levels above the wanted ones, until the additional bytes fit into the budget.
+	 */
+	bool evictUnwanted(std::uint64_t additionalBytes, const StreamableTexture* keep);
+
+	/**
+	 * Evicts wanted levels of the textures requested with the lowest resolution, until the budget is kept.
+	 */
+	void evictWanted();
+
+	void setResidentLevel(TextureStreamingEntry& entry, std::int32_t level);
+
+	/**
+	 * Removes the entries of released textures, so the textures of the remaining entries are alive.
+	 */
+	void removeExpired();
+
+protected:
+
+	TextureStreamingManager();
+	virtual ~TextureStreamingManager();
+
+public:
+
+	/**
+	 * @param streamingResolution Resolution of the mip levels loaded initially. Zero disables streaming for new textures.
+	 */
+	void setStreamingResolution(std::int32_t streamingResolution);
+
+	std::int32_t getStreamingResolution() const;
+
+	/**
+	 * @param budget Maximum of bytes for all streamed textures. Zero is unlimited.
+	 */
+	void setBudget(std::uint64_t budget);
+
+	std::uint64_t getBudget() const;
+
+	/**
+	 * @param maxUploadsPerFrame Maximum of mip levels uploaded per frame.
+	 */
+	void setMaxUploadsPerFrame(std::int32_t maxUploadsPerFrame);
+
+	std::int32_t getMaxUploadsPerFrame() const;
+
+	/**
+	 * @param requestFrames Frames a request of a resolution is kept, before the levels are not wanted anymore.
+	 */
+	void setRequestFrames(std::uint32_t requestFrames);
+
+	std::uint32_t getRequestFrames() const;
+
+	/**
+	 * The currently resident level becomes the coarsest one, which is always kept.
+	 */
+	void addTexture(const StreamableTextureSP& texture);
+
+	void removeTexture(const StreamableTexture* texture);
+
+	/**
+	 * @return False, if the texture is not streamed or already released.
+	 */
+	bool containsTexture(const StreamableTexture* texture) const;
+
+	std::int32_t getNumberTextures() const;
+
+	/**
+	 * Feedback of the renderer. Textures, which are not streamed, are ignored.
+	 *
+	 * @param resolution Approximated size in pixels, the texture covers on the screen.
+	 */
+	void requestResolution(const StreamableTexture* texture, float resolution);
+
+	/**
+	 * Uploads and evicts levels based on the requests. Has to be called once per frame outside of a render batch.
+	 */
+	void update();
+
+	std::uint64_t getResidentBytes() const;
+
+};
+
+#endif /* TEXTURESTREAMINGMANAGER_H_ */
@@ -0,0 +1,277 @@
+/*
+ * TextureUploadManager.cpp
+ *
+ *  Created on: 19.10.2026
+ *      Author: nopper
+ */
+
+#include "../../layer0/os/Directory.h"
+#include "../command/WorkerManager.h"
+#include "Texture2DManager.h"
+#include "TextureFactory.h"
+#include "TextureStreamingManager.h"
+
+#include "TextureUploadManager.h"
+
+using namespace std;
+
+TextureUploadManager::TextureUploadManager() :
+	Singleton<TextureUploadManager>(), allPendingTextures(), allReloadEntries(), nextTicket(0), maxUploadsPerFrame(4), cacheDirectory("")
+{
+	textureDecodeCommandRecycleQueue = TextureDecodeCommandRecycleQueueSP(new ThreadsafeQueue<TextureDecodeCommand*>());
+	uploadQueue = TextureUploadQueueSP(new ThreadsafeQueue<TextureDecodeTaskSP>());
+	decodeTaskCounter = ThreadSafeCounterSP(new ThreadSafeCounter());
+}
+
+TextureUploadManager::~TextureUploadManager()
+{
+	// The workers still hold the tasks in progress.
+	decodeTaskCounter->waitUntilZero();
+
+	TextureDecodeCommand* currentCommand = nullptr;
+	bool available = textureDecodeCommandRecycleQueue->take(currentCommand);
+	while (available)
+	{
+		delete currentCommand;
+
+		available = textureDecodeCommandRecycleQueue->take(currentCommand);
+	}
+
+	TextureDecodeTaskSP currentTask;
+	available = uploadQueue->take(currentTask);
+	while (available)
+	{
+		currentTask.reset();
+
+		available = uploadQueue->take(currentTask);
+	}
+
+	allPendingTextures.clear();
+
+	allReloadEntries.clear();
+}
+
+void TextureUploadManager::upload(const TextureDecodeTaskSP& task)
+{
+	auto found = allPendingTextures.find(task->ticket);
+
+	if (found == allPendingTextures.end())
+	{
+		return;
+	}
+
+	Texture2DSP texture2D = found->second;
+
+	allPendingTextures.erase(found);
+
+	if (!task->success || task->allMipLevels.size() == 0)
+	{
+		glusLogPrint(GLUS_LOG_WARNING, "Keeping placeholder for texture: %s", task->filename.c_str());
+
+		return;
+	}
+
+	GLint internalFormat;
+
+	if (TextureCompressor::isCompressedFormat(task->allMipLevels[0].getFormat()))
+	{
+		internalFormat = task->allMipLevels[0].getFormat();
+
+		// KTX files are not checked before.
+		if (!TextureCompressor::isSupported(internalFormat))
+		{
+			glusLogPrint(GLUS_LOG_WARNING, "Compressed format not supported, keeping placeholder for texture: %s", task->filename.c_str());
+
+			return;
+		}
+	}
+	else
+	{
+		TextureFactory textureFactory;
+
+		internalFormat = textureFactory.gatherInternalFormat(task->allMipLevels[0].getFormat(), task->allMipLevels[0].getType());
+	}
+
+	glusLogPrint(GLUS_LOG_DEBUG, "Uploading texture: %s", task->filename.c_str());
+
+	int32_t streamingResolution = task->mipMap ? TextureStreamingManager::getInstance()->getStreamingResolution() : 0;
+
+	// A reloaded texture is registered again with its new levels.
+	TextureStreamingManager::getInstance()->removeTexture(texture2D.get());
+
+	texture2D->setMipLevels(internalFormat, task->allMipLevels, streamingResolution);
+
+	if (texture2D->isStreaming())
+	{
+		TextureStreamingManager::getInstance()->addTexture(texture2D);
+	}
+}
+
+Texture2DSP TextureUploadManager::loadTexture2D(const string& filename, bool sRGB, enum MipFilter mipFilter, enum TextureCompression compression, bool mipMap, GLint minFilter, GLint magFilter, GLint wrapS, GLint wrapT, float anisotropic)
+{
+	Texture2DSP texture2D = Texture2DManager::getInstance()->getTexture(filename);
+
+	// Already loaded or still decoding, e.g. for another material.
+	if (texture2D.get())
+	{
+		return texture2D;
+	}
+
+	// Mid grey, until the texture is decoded.
+	const float placeholder[4] = {0.5f, 0.5f, 0.5f, 1.0f};
+
+	texture2D = Texture2DSP(new Texture2D(filename, GL_RGBA8, 1, 1, GL_RGBA, GL_FLOAT, reinterpret_cast<const uint8_t*>(placeholder), sizeof(placeholder), mipMap, minFilter, magFilter, wrapS, wrapT, anisotropic));
+
+	Texture2DManager::getInstance()->addTexture(filename, texture2D);
+
+	if (compression != TextureCompressionNone && !TextureCompressor::isSupported(TextureCompressor::getInternalFormat(compression, sRGB)))
+	{
+		glusLogPrint(GLUS_LOG_WARNING, "Compressed format not supported, loading uncompressed texture: %s", filename.c_str());
+
+		compression = TextureCompressionNone;
+	}
+
+	TextureReloadEntry reloadEntry;
+
+	reloadEntry.texture2D = texture2D;
+	reloadEntry.canonicalFilename = Directory::getCanonicalName(filename);
+	reloadEntry.sRGB = sRGB;
+	reloadEntry.mipFilter = mipFilter;
+	reloadEntry.compression = compression;
+	reloadEntry.mipMap = mipMap;
+
+	allReloadEntries[filename] = reloadEntry;
+
+	decode(texture2D, filename, sRGB, mipFilter, compression, mipMap);
+
+	return texture2D;
+}
+
+void TextureUploadManager::decode(const Texture2DSP& texture2D, const string& filename, bool sRGB, enum MipFilter mipFilter, enum TextureCompression compression, bool mipMap)
+{
+	TextureDecodeTaskSP task = TextureDecodeTaskSP(new TextureDecodeTask());
+
+	task->ticket = nextTicket++;
+	task->filename = filename;
+	task->mipMap = mipMap;
+	task->mipFilter = mipFilter;
+	task->sRGB = sRGB;
+	task->compression = compression;
+	task->cacheDirectory = cacheDirectory;
+	task->success = false;
+
+	allPendingTextures[task->ticket] = texture2D;
+
+	if (WorkerManager::getInstance()->getNumberWorkers() == 0)
+	{
+		TextureDecoder textureDecoder;
+
+		textureDecoder.decode(*task);
+
+		upload(task);
+
+		return;
+	}
+
+	TextureDecodeCommand* currentCommand = nullptr;
+	bool available = textureDecodeCommandRecycleQueue->take(currentCommand);
+
+	if (!available)
+	{
+		currentCommand = new TextureDecodeCommand(textureDecodeCommandRecycleQueue, uploadQueue, decodeTaskCounter);
+	}
+
+	currentCommand->init(task);
+
+	WorkerManager::getInstance()->sendCommand(currentCommand);
+}
+
+int32_t TextureUploadManager::reloadTextures(const string& canonicalFilename)
+{
+	int32_t numberReloaded = 0;
+
+	auto walker = allReloadEntries.begin();
+	while (walker != allReloadEntries.end())
+	{
+		const TextureReloadEntry& reloadEntry = walker->second;
+
+		Texture2DSP texture2D = reloadEntry.texture2D.lock();
+
+		if (!texture2D.get())
+		{
+			walker = allReloadEntries.erase(walker);
+
+			continue;
+		}
+
+		if (reloadEntry.canonicalFilename.size() > 0 && reloadEntry.canonicalFilename == canonicalFilename)
+		{
+			glusLogPrint(GLUS_LOG_INFO, "Reloading texture: %s", walker->first.c_str());
+
+			decode(texture2D, walker->first, reloadEntry.sRGB, reloadEntry.mipFilter, reloadEntry.compression, reloadEntry.mipMap);
+
+			numberReloaded++;
+		}
+
+		walker++;
+	}
+
+	return numberReloaded;
+}
+
+void TextureUploadManager::update()
+{
+	TextureDecodeTaskSP currentTask;
+
+	int32_t uploads = 0;
+
+	while ((maxUploadsPerFrame <= 0 || uploads < maxUploadsPerFrame) && uploadQueue->take(currentTask))
+	{
+		upload(currentTask);
+
+		uploads++;
+	}
+
+	// The decoded textures are larger than their placeholders.
+	if (uploads > 0)
+	{
+		Texture2DManager::getInstance()->trim();
+	}
+}
+
+void TextureUploadManager::finish()
+{
+	decodeTaskCounter->waitUntilZero();
+
+	TextureDecodeTaskSP currentTask;
+
+	while (uploadQueue->take(currentTask))
+	{
+		upload(currentTask);
+	}
+}
+
+void TextureUploadManager::setMaxUploadsPerFrame(int32_t maxUploadsPerFrame)
+{
+	this->maxUploadsPerFrame = maxUploadsPerFrame;
+}
+
+int32_t TextureUploadManager::getMaxUploadsPerFrame() const
+{
+	return maxUploadsPerFrame;
+}
+
+int32_t TextureUploadManager::getNumberPending() const
+{
+	return static_cast<int32_t>(allPendingTextures.size());
+}
+
+const string& TextureUploadManager::getCacheDirectory() const
+{
+	return cacheDirectory;
+}
+
+void TextureUploadManager::setCacheDirectory(const string& cacheDirectory)
+{
+	this->cacheDirectory = cacheDirectory;
+}
@@ -0,0 +1,127 @@
+/*
+ * TextureUploadManager.h
+ *
+ *  Created on: 19.10.2026
+ *      Author: nopper
+ */
+
+#ifndef TEXTUREUPLOADMANAGER_H_
+#define TEXTUREUPLOADMANAGER_H_
+
+#include "../../UsedLibs.h"
+
+#include "../../layer0/stereotype/Singleton.h"
+
+#include "Texture2D.h"
+#include "TextureDecodeCommand.h"
+
+/**
+ * Parameters of a loaded texture, so it can be decoded again.
+ */
+struct TextureReloadEntry
+{
+	// Not owned, so the texture manager can evict the texture.
+	std::weak_ptr<Texture2D> texture2D;
+
+	std::string canonicalFilename;
+
+	bool sRGB;
+
+	enum MipFilter mipFilter;
+
+	enum TextureCompression compression;
+
+	bool mipMap;
+};
+
+/**
+ * Loads textures asynchronously. Decoding and the creation of the mip levels is done by the workers. A placeholder texture
+ * is returned at once, which receives the mip levels on the render thread, so loading does not stall the frame.
+ * Without workers, textures are loaded immediately.
+ */
+class TextureUploadManager : public Singleton<TextureUploadManager>
+{
+
+	friend class Singleton<TextureUploadManager>;
+
+private:
+
+	TextureDecodeCommandRecycleQueueSP textureDecodeCommandRecycleQueue;
+
+	TextureUploadQueueSP uploadQueue;
+
+	ThreadSafeCounterSP decodeTaskCounter;
+
+	std::map<std::uint32_t, Texture2DSP> allPendingTextures;
+
+	std::map<std::string, TextureReloadEntry> allReloadEntries;
+
+	std::uint32_t nextTicket;
+
+	std::int32_t maxUploadsPerFrame;
+
+	std::string cacheDirectory;
+
+	void upload(const TextureDecodeTaskSP& task);
+
+	/**
+	 * Decodes the file on a worker. The result is stored in the given texture at the next update.
+	 */
+	void decode(const Texture2DSP& texture2D, const std::string& filename, bool sRGB, enum MipFilter mipFilter, enum TextureCompression compression, bool mipMap);
+
+	TextureUploadManager();
+	virtual ~TextureUploadManager();
+
+public:
+
+	/**
+	 * @param sRGB True for color textures, so the mip levels are filtered in linear space.
+	 * @param compression Block compression done by the workers. Ignored, if the driver does not support the format.
+	 *
+	 * @return Placeholder texture, which is filled, when decoding is finished. If the texture manager already stores a
+	 *         texture by the filename, this one is returned and the parameters are ignored.
+	 */
+	Texture2DSP loadTexture2D(const std::string& filename, bool sRGB = false, enum MipFilter mipFilter = MipFilterBox, enum TextureCompression compression = TextureCompressionNone, bool mipMap = true, GLint minFilter = GL_LINEAR_MIPMAP_LINEAR, GLint magFilter = GL_LINEAR, GLint wrapS = GL_REPEAT, GLint wrapT = GL_REPEAT, float anisotropic = 1.0f);
+
+	/**
+	 * Decodes the textures loaded from the file again. The textures keep their pixels until the new ones are uploaded.
+	 *
+	 * @param canonicalFilename Name as created by Directory::getCanonicalName.
+	 *
+	 * @return Number of textures, which are decoded again.
+	 */
+	std::int32_t reloadTextures(const std::string& canonicalFilename);
+
+	/**
+	 * Uploads the decoded textures. Has to be called once per frame on the render thread.
+	 */
+	void update();
+
+	/**
+	 * Waits for all decoding textures and uploads them, e.g. at the end of a loading screen.
+	 */
+	void finish();
+
+	/**
+	 * @param maxUploadsPerFrame Maximum of textures uploaded per frame. Zero is unlimited.
+	 */
+	void setMaxUploadsPerFrame(std::int32_t maxUploadsPerFrame);
+
+	std::int32_t getMaxUploadsPerFrame() const;
+
+	const std::string& getCacheDirectory() const;
+
+	/**
+	 * @param cacheDirectory Directory, where compressed textures are cached as KTX files. Empty disables the cache. The
+	 *                       directory has to exist.
+	 */
+	void setCacheDirectory(const std::string& cacheDirectory);
+
+	/**
+	 * @return Number of textures, which are not uploaded yet.
+	 */
+	std::int32_t getNumberPending() const;
+
+};
+
+#endif /* TEXTUREUPLOADMANAGER_H_ */
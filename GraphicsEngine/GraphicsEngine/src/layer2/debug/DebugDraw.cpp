@@ -8,6 +8,7 @@
 #include "../../UsedLibs.h"
 
 #include "../../layer0/math/Matrix4x4.h"
+#include "DebugLineRenderer.h"
 #include "LineGeometry.h"
 #include "LineGeometryManager.h"
 
@@ -25,6 +26,13 @@ DebugDraw::~DebugDraw()
 
 void DebugDraw::draw(const Point4& start, const Point4& end, const Color& color) const
 {
+	if (DebugLineRenderer::getInstance()->isBatching())
+	{
+		DebugLineRenderer::getInstance()->getRecorder().recordLine(start, end, color);
+
+		return;
+	}
+
 	if (!LineGeometryManager::getInstance()->getLineGeometry("SingleLine").get())
 	{
 		return;
@@ -37,8 +45,20 @@ void DebugDraw::draw(const Sphere& sphere, const Color& color, bool mesh) const
 {
 	Matrix4x4 modelMatrix;
 
+	bool batching = DebugLineRenderer::getInstance()->isBatching();
+
 	if (mesh)
 	{
+		if (batching)
+		{
+			modelMatrix.identity();
+			modelMatrix.translate(sphere.getCenter().getX(), sphere.getCenter().getY(), sphere.getCenter().getZ());
+			modelMatrix.scale(sphere.getRadius(), sphere.getRadius(), sphere.getRadius());
+			DebugLineRenderer::getInstance()->getRecorder().recordSphere(modelMatrix, color);
+
+			return;
+		}
+
 		if (!LineGeometryManager::getInstance()->getLineGeometry("Sphere").get())
 		{
 			return;
@@ -53,33 +73,45 @@ void DebugDraw::draw(const Sphere& sphere, const Color& color, bool mesh) const
 	}
 	else
 	{
-		if (!LineGeometryManager::getInstance()->getLineGeometry("Circle").get())
+		if (!batching && !LineGeometryManager::getInstance()->getLineGeometry("Circle").get())
 		{
 			return;
 		}
 
-		modelMatrix.identity();
-		modelMatrix.translate(sphere.getCenter().getX(), sphere.getCenter().getY(), sphere.getCenter().getZ());
-		modelMatrix.rotateRzRyRx(0.0f, 0.0f, 0.0f);
-		modelMatrix.scale(sphere.getRadius(), sphere.getRadius(), sphere.getRadius());
-		LineGeometryManager::getInstance()->getLineGeometry("Circle")->draw(modelMatrix, color);
-
-		modelMatrix.identity();
-		modelMatrix.translate(sphere.getCenter().getX(), sphere.getCenter().getY(), sphere.getCenter().getZ());
-		modelMatrix.rotateRzRyRx(0.0f, 90.0f, 0.0f);
-		modelMatrix.scale(sphere.getRadius(), sphere.getRadius(), sphere.getRadius());
-		LineGeometryManager::getInstance()->getLineGeometry("Circle")->draw(modelMatrix, color);
+		const float rotations[3][3] = {{0.0f, 0.0f, 0.0f}, {0.0f, 90.0f, 0.0f}, {0.0f, 0.0f, 90.0f}};
 
-		modelMatrix.identity();
-		modelMatrix.translate(sphere.getCenter().getX(), sphere.getCenter().getY(), sphere.getCenter().getZ());
-		modelMatrix.rotateRzRyRx(0.0f, 0.0f, 90.0f);
-		modelMatrix.scale(sphere.getRadius(), sphere.getRadius(), sphere.getRadius());
-		LineGeometryManager::getInstance()->getLineGeometry("Circle")->draw(modelMatrix, color);
+		for (int32_t i = 0; i < 3; i++)
+		{
+			modelMatrix.identity();
+			modelMatrix.translate(sphere.getCenter().getX(), sphere.getCenter().getY(), sphere.getCenter().getZ());
+			modelMatrix.rotateRzRyRx(rotations[i][0], rotations[i][1], rotations[i][2]);
+			modelMatrix.scale(sphere.getRadius(), sphere.getRadius(), sphere.getRadius());
+
+			if (batching)
+			{
+				DebugLineRenderer::getInstance()->getRecorder().recordCircle(modelMatrix, color);
+			}
+			else
+			{
+				LineGeometryManager::getInstance()->getLineGeometry("Circle")->draw(modelMatrix, color);
+			}
+		}
 	}
 }
 
 void DebugDraw::draw(const AxisAlignedBox& axisAlignedBox, const Color& color) const
 {
+	if (DebugLineRenderer::getInstance()->isBatching())
+	{
+		Matrix4x4 modelMatrix;
+
+		modelMatrix.translate(axisAlignedBox.getCenter().getX(), axisAlignedBox.getCenter().getY(), axisAlignedBox.getCenter().getZ());
+		modelMatrix.scale(axisAlignedBox.getHalfWidth(), axisAlignedBox.getHalfHeight(), axisAlignedBox.getHalfDepth());
+		DebugLineRenderer::getInstance()->getRecorder().recordBox(modelMatrix, color);
+
+		return;
+	}
+
 	if (!LineGeometryManager::getInstance()->getLineGeometry("Square").get())
 	{
 		return;
@@ -126,7 +158,9 @@ void DebugDraw::draw(const Plane& plane, const Point4& origin, const Color& colo
 {
 	Matrix4x4 modelMatrix;
 
-	if (!LineGeometryManager::getInstance()->getLineGeometry("GridPlane").get())
+	bool batching = DebugLineRenderer::getInstance()->isBatching();
+
+	if (!batching && !LineGeometryManager::getInstance()->getLineGeometry("GridPlane").get())
 	{
 		return;
 	}
@@ -139,6 +173,13 @@ void DebugDraw::draw(const Plane& plane, const Point4& origin, const Color& colo
 	modelMatrix.translate(x, y, z);
 	modelMatrix.rotateRzRyRx(0.0f, plane.getPlane()[0] * 90.0f, plane.getPlane()[1] * -90.0f);
 
+	if (batching)
+	{
+		DebugLineRenderer::getInstance()->getRecorder().recordGrid(modelMatrix, color);
+
+		return;
+	}
+
 	glDisable(GL_CULL_FACE);
 	LineGeometryManager::getInstance()->getLineGeometry("GridPlane")->draw(modelMatrix, color);
 	glEnable(GL_CULL_FACE);
@@ -148,7 +189,9 @@ void DebugDraw::drawSphere(const Point4& position, const Vector3& offset, float
 {
 	Matrix4x4 modelMatrix;
 
-	if (!LineGeometryManager::getInstance()->getLineGeometry("Sphere").get())
+	bool batching = DebugLineRenderer::getInstance()->isBatching();
+
+	if (!batching && !LineGeometryManager::getInstance()->getLineGeometry("Sphere").get())
 	{
 		return;
 	}
@@ -156,6 +199,14 @@ void DebugDraw::drawSphere(const Point4& position, const Vector3& offset, float
 	modelMatrix.identity();
 	modelMatrix.translate(position.getX() + offset.getX(), position.getY() + offset.getY(), position.getZ() + offset.getZ());
 	modelMatrix.scale(radius * 2.0f, radius * 2.0f, radius * 2.0f);
+
+	if (batching)
+	{
+		DebugLineRenderer::getInstance()->getRecorder().recordSphere(modelMatrix, color);
+
+		return;
+	}
+
 	glEnable(GL_CULL_FACE);
 	LineGeometryManager::getInstance()->getLineGeometry("Sphere")->draw(modelMatrix, color);
 }
@@ -164,7 +215,9 @@ void DebugDraw::drawCone(const Point4& position, const Vector3& offset, const Qu
 {
 	Matrix4x4 modelMatrix;
 
-	if (!LineGeometryManager::getInstance()->getLineGeometry("Cone").get())
+	bool batching = DebugLineRenderer::getInstance()->isBatching();
+
+	if (!batching && !LineGeometryManager::getInstance()->getLineGeometry("Cone").get())
 	{
 		return;
 	}
@@ -174,6 +227,14 @@ void DebugDraw::drawCone(const Point4& position, const Vector3& offset, const Qu
 	modelMatrix.multiply(rotation.getRotationMatrix4x4());
 	modelMatrix.translate(offset.getX(), offset.getY(), offset.getZ());
 	modelMatrix.scale(radius * 2.0f, halfExtend * 2.0f, radius * 2.0f);
+
+	if (batching)
+	{
+		DebugLineRenderer::getInstance()->getRecorder().recordCone(modelMatrix, color);
+
+		return;
+	}
+
 	glEnable(GL_CULL_FACE);
 	LineGeometryManager::getInstance()->getLineGeometry("Cone")->draw(modelMatrix, color);
 }
@@ -182,7 +243,9 @@ void DebugDraw::drawCylinder(const Point4& position, const Vector3& offset, cons
 {
 	Matrix4x4 modelMatrix;
 
-	if (!LineGeometryManager::getInstance()->getLineGeometry("Cylinder").get())
+	bool batching = DebugLineRenderer::getInstance()->isBatching();
+
+	if (!batching && !LineGeometryManager::getInstance()->getLineGeometry("Cylinder").get())
 	{
 		return;
 	}
@@ -192,6 +255,14 @@ void DebugDraw::drawCylinder(const Point4& position, const Vector3& offset, cons
 	modelMatrix.multiply(rotation.getRotationMatrix4x4());
 	modelMatrix.translate(offset.getX(), offset.getY(), offset.getZ());
 	modelMatrix.scale(radius * 2.0f, halfExtend * 2.0f, radius * 2.0f);
+
+	if (batching)
+	{
+		DebugLineRenderer::getInstance()->getRecorder().recordCylinder(modelMatrix, color);
+
+		return;
+	}
+
 	glEnable(GL_CULL_FACE);
 	LineGeometryManager::getInstance()->getLineGeometry("Cylinder")->draw(modelMatrix, color);
 }
@@ -206,7 +277,9 @@ void DebugDraw::drawPyramid(const Point4& position, const Vector3& offset, const
 {
 	Matrix4x4 modelMatrix;
 
-	if (!LineGeometryManager::getInstance()->getLineGeometry("Pyramid").get())
+	bool batching = DebugLineRenderer::getInstance()->isBatching();
+
+	if (!batching && !LineGeometryManager::getInstance()->getLineGeometry("Pyramid").get())
 	{
 		return;
 	}
@@ -216,6 +289,14 @@ void DebugDraw::drawPyramid(const Point4& position, const Vector3& offset, const
 	modelMatrix.multiply(rotation.getRotationMatrix4x4());
 	modelMatrix.translate(offset.getX(), offset.getY(), offset.getZ());
 	modelMatrix.scale(halfWidth * 2.0f, halfHeight * 2.0f, halfDepth * 2.0f);
+
+	if (batching)
+	{
+		DebugLineRenderer::getInstance()->getRecorder().recordPyramid(modelMatrix, color);
+
+		return;
+	}
+
 	glEnable(GL_CULL_FACE);
 	LineGeometryManager::getInstance()->getLineGeometry("Pyramid")->draw(modelMatrix, color);
 }
@@ -7,6 +7,7 @@
 
 #include "../../UsedLibs.h"
 
+#include "DebugLineRenderer.h"
 #include "LineGeometry.h"
 #include "LineGeometryManager.h"
 
@@ -84,4 +85,7 @@ void DebugDrawFactory::createDefaultDebugGeometry() const
 	lineGeometry = LineGeometrySP(new LineGeometry(singleLine));
 	glusLineDestroyf(&singleLine);
 	LineGeometryManager::getInstance()->setLineGeometry("SingleLine", lineGeometry);
+
+	// Creates the buffers for batched debug drawing on the rendering thread.
+	DebugLineRenderer::getInstance();
 }
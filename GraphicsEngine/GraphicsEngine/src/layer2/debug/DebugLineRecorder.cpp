@@ -0,0 +1,230 @@
+/*
+ * DebugLineRecorder.cpp
+ *
+ *  Created on: 19.10.2026
+ *      Author: nopper
+ */
+
+#include "DebugLineRecorder.h"
+
+using namespace std;
+
+DebugLineRecorder::DebugLineRecorder() :
+	recordMutex(), allVertices(), unitCircle(), unitSquare(), unitBox(), unitGrid(), unitSphere(), unitCone(), unitCylinder(), unitPyramid()
+{
+	// Same dimensions as the line geometries created by the debug draw factory.
+
+	float singleStep = 2.0f * GLUS_PI / 32.0f;
+	for (int32_t i = 0; i < 32; i++)
+	{
+		addLine(unitCircle, cosf(singleStep * i), sinf(singleStep * i), 0.0f, cosf(singleStep * (i + 1)), sinf(singleStep * (i + 1)), 0.0f);
+	}
+
+	addLine(unitSquare, 1.0f, -1.0f, 0.0f, 1.0f, 1.0f, 0.0f);
+	addLine(unitSquare, 1.0f, 1.0f, 0.0f, -1.0f, 1.0f, 0.0f);
+	addLine(unitSquare, -1.0f, 1.0f, 0.0f, -1.0f, -1.0f, 0.0f);
+	addLine(unitSquare, -1.0f, -1.0f, 0.0f, 1.0f, -1.0f, 0.0f);
+
+	// Corners of the bottom and top face in circular order.
+	const float cornersX[4] = {1.0f, -1.0f, -1.0f, 1.0f};
+	const float cornersZ[4] = {1.0f, 1.0f, -1.0f, -1.0f};
+
+	for (int32_t i = 0; i < 4; i++)
+	{
+		int32_t next = (i + 1) % 4;
+
+		addLine(unitBox, cornersX[i], -1.0f, cornersZ[i], cornersX[next], -1.0f, cornersZ[next]);
+		addLine(unitBox, cornersX[i], 1.0f, cornersZ[i], cornersX[next], 1.0f, cornersZ[next]);
+		addLine(unitBox, cornersX[i], -1.0f, cornersZ[i], cornersX[i], 1.0f, cornersZ[i]);
+	}
+
+	for (int32_t i = 0; i <= 50; i++)
+	{
+		float current = -25.0f + static_cast<float>(i);
+
+		addLine(unitGrid, -25.0f, current, 0.0f, 25.0f, current, 0.0f);
+		addLine(unitGrid, current, -25.0f, 0.0f, current, 25.0f, 0.0f);
+	}
+
+	// Parallels and meridians.
+	for (int32_t stack = 1; stack < 8; stack++)
+	{
+		float angle = GLUS_PI * static_cast<float>(stack) / 8.0f;
+
+		addRing(unitSphere, cosf(angle), sinf(angle), 16);
+	}
+
+	singleStep = 2.0f * GLUS_PI / 16.0f;
+	for (int32_t slice = 0; slice < 8; slice++)
+	{
+		float c = cosf(singleStep * slice);
+		float s = sinf(singleStep * slice);
+
+		for (int32_t i = 0; i < 16; i++)
+		{
+			float x0 = cosf(singleStep * i);
+			float y0 = sinf(singleStep * i);
+			float x1 = cosf(singleStep * (i + 1));
+			float y1 = sinf(singleStep * (i + 1));
+
+			addLine(unitSphere, x0 * c, y0, -x0 * s, x1 * c, y1, -x1 * s);
+		}
+	}
+
+	addRing(unitCone, -0.5f, 0.5f, 16);
+	addRing(unitCylinder, -0.5f, 0.5f, 16);
+	addRing(unitCylinder, 0.5f, 0.5f, 16);
+
+	for (int32_t i = 0; i < 16; i++)
+	{
+		float x = cosf(singleStep * i) * 0.5f;
+		float z = -sinf(singleStep * i) * 0.5f;
+
+		addLine(unitCone, x, -0.5f, z, 0.0f, 0.5f, 0.0f);
+		addLine(unitCylinder, x, -0.5f, z, x, 0.5f, z);
+	}
+
+	addLine(unitPyramid, 0.5f, -0.5f, 0.5f, -0.5f, -0.5f, 0.5f);
+	addLine(unitPyramid, -0.5f, -0.5f, 0.5f, -0.5f, -0.5f, -0.5f);
+	addLine(unitPyramid, -0.5f, -0.5f, -0.5f, 0.5f, -0.5f, -0.5f);
+	addLine(unitPyramid, 0.5f, -0.5f, -0.5f, 0.5f, -0.5f, 0.5f);
+
+	addLine(unitPyramid, 0.5f, -0.5f, 0.5f, 0.0f, 0.5f, 0.0f);
+	addLine(unitPyramid, -0.5f, -0.5f, 0.5f, 0.0f, 0.5f, 0.0f);
+	addLine(unitPyramid, -0.5f, -0.5f, -0.5f, 0.0f, 0.5f, 0.0f);
+	addLine(unitPyramid, 0.5f, -0.5f, -0.5f, 0.0f, 0.5f, 0.0f);
+}
+
+DebugLineRecorder::~DebugLineRecorder()
+{
+	allVertices.clear();
+}
+
+void DebugLineRecorder::addLine(vector<float>& lines, float x0, float y0, float z0, float x1, float y1, float z1)
+{
+	lines.push_back(x0);
+	lines.push_back(y0);
+	lines.push_back(z0);
+
+	lines.push_back(x1);
+	lines.push_back(y1);
+	lines.push_back(z1);
+}
+
+void DebugLineRecorder::addRing(vector<float>& lines, float y, float radius, int32_t numberSectors)
+{
+	float singleStep = 2.0f * GLUS_PI / static_cast<float>(numberSectors);
+
+	for (int32_t i = 0; i < numberSectors; i++)
+	{
+		addLine(lines, cosf(singleStep * i) * radius, y, -sinf(singleStep * i) * radius, cosf(singleStep * (i + 1)) * radius, y, -sinf(singleStep * (i + 1)) * radius);
+	}
+}
+
+void DebugLineRecorder::record(const vector<float>& lines, const Matrix4x4& modelMatrix, const Color& color)
+{
+	const float* m = modelMatrix.getM();
+	const float* rgba = color.getRGBA();
+
+	uint32_t numberVertices = static_cast<uint32_t>(lines.size()) / 3;
+
+	lock_guard<mutex> recordLock(recordMutex);
+
+	size_t first = allVertices.size();
+
+	allVertices.resize(first + numberVertices * FLOATS_PER_VERTEX);
+
+	float* current = &allVertices[first];
+
+	for (uint32_t i = 0; i < numberVertices; i++)
+	{
+		const float* v = &lines[i * 3];
+
+		// Column major, the w coordinate is always one.
+		current[0] = m[0] * v[0] + m[4] * v[1] + m[8] * v[2] + m[12];
+		current[1] = m[1] * v[0] + m[5] * v[1] + m[9] * v[2] + m[13];
+		current[2] = m[2] * v[0] + m[6] * v[1] + m[10] * v[2] + m[14];
+		current[3] = rgba[0];
+		current[4] = rgba[1];
+		current[5] = rgba[2];
+		current[6] = rgba[3];
+
+		current += FLOATS_PER_VERTEX;
+	}
+}
+
+void DebugLineRecorder::recordLine(const Point4& start, const Point4& end, const Color& color)
+{
+	const float* rgba = color.getRGBA();
+
+	lock_guard<mutex> recordLock(recordMutex);
+
+	allVertices.insert(allVertices.end(), start.getP(), start.getP() + 3);
+	allVertices.insert(allVertices.end(), rgba, rgba + 4);
+
+	allVertices.insert(allVertices.end(), end.getP(), end.getP() + 3);
+	allVertices.insert(allVertices.end(), rgba, rgba + 4);
+}
+
+void DebugLineRecorder::recordCircle(const Matrix4x4& modelMatrix, const Color& color)
+{
+	record(unitCircle, modelMatrix, color);
+}
+
+void DebugLineRecorder::recordSquare(const Matrix4x4& modelMatrix, const Color& color)
+{
+	record(unitSquare, modelMatrix, color);
+}
+
+void DebugLineRecorder::recordBox(const Matrix4x4& modelMatrix, const Color& color)
+{
+	record(unitBox, modelMatrix, color);
+}
+
+void DebugLineRecorder::recordGrid(const Matrix4x4& modelMatrix, const Color& color)
+{
+	record(unitGrid, modelMatrix, color);
+}
+
+void DebugLineRecorder::recordSphere(const Matrix4x4& modelMatrix, const Color& color)
+{
+	record(unitSphere, modelMatrix, color);
+}
+
+void DebugLineRecorder::recordCone(const Matrix4x4& modelMatrix, const Color& color)
+{
+	record(unitCone, modelMatrix, color);
+}
+
+void DebugLineRecorder::recordCylinder(const Matrix4x4& modelMatrix, const Color& color)
+{
+	record(unitCylinder, modelMatrix, color);
+}
+
+void DebugLineRecorder::recordPyramid(const Matrix4x4& modelMatrix, const Color& color)
+{
+	record(unitPyramid, modelMatrix, color);
+}
+
+uint32_t DebugLineRecorder::getNumberVertices() const
+{
+	lock_guard<mutex> recordLock(recordMutex);
+
+	return static_cast<uint32_t>(allVertices.size()) / FLOATS_PER_VERTEX;
+}
+
+void DebugLineRecorder::swapVertices(vector<float>& vertices)
+{
+	vertices.clear();
+
+	lock_guard<mutex> recordLock(recordMutex);
+
+	allVertices.swap(vertices);
+}
+
+void DebugLineRecorder::clear()
+{
+	lock_guard<mutex> recordLock(recordMutex);
+
+	allVertices.clear();
+}
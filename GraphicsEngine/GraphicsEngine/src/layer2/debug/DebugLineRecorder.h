@@ -0,0 +1,113 @@
+/*
+ * DebugLineRecorder.h
+ *
+ *  Created on: 19.10.2026
+ *      Author: nopper
+ */
+
+#ifndef DEBUGLINERECORDER_H_
+#define DEBUGLINERECORDER_H_
+
+#include "../../UsedLibs.h"
+
+#include "../../layer0/color/Color.h"
+#include "../../layer0/math/Matrix4x4.h"
+#include "../../layer0/math/Point4.h"
+
+/**
+ * Collects debug primitives as pre-transformed, colored line vertices. The primitives are tessellated once into unit
+ * shapes, which are transformed on the CPU, so all primitives of a frame can be drawn with one draw call.
+ * Recording is thread safe. Does not need a context.
+ */
+class DebugLineRecorder
+{
+
+private:
+
+	mutable std::mutex recordMutex;
+
+	std::vector<float> allVertices;
+
+	std::vector<float> unitCircle;
+	std::vector<float> unitSquare;
+	std::vector<float> unitBox;
+	std::vector<float> unitGrid;
+	std::vector<float> unitSphere;
+	std::vector<float> unitCone;
+	std::vector<float> unitCylinder;
+	std::vector<float> unitPyramid;
+
+	static void addLine(std::vector<float>& lines, float x0, float y0, float z0, float x1, float y1, float z1);
+
+	/**
+	 * Adds a closed ring around the y axis.
+	 */
+	static void addRing(std::vector<float>& lines, float y, float radius, std::int32_t numberSectors);
+
+	void record(const std::vector<float>& lines, const Matrix4x4& modelMatrix, const Color& color);
+
+public:
+
+	/**
+	 * Position and color.
+	 */
+	static const std::int32_t FLOATS_PER_VERTEX = 7;
+
+	DebugLineRecorder();
+	virtual ~DebugLineRecorder();
+
+	void recordLine(const Point4& start, const Point4& end, const Color& color);
+
+	/**
+	 * Circle with radius one in the xy plane.
+	 */
+	void recordCircle(const Matrix4x4& modelMatrix, const Color& color);
+
+	/**
+	 * Square with a half extend of one in the xy plane.
+	 */
+	void recordSquare(const Matrix4x4& modelMatrix, const Color& color);
+
+	/**
+	 * Box with a half extend of one.
+	 */
+	void recordBox(const Matrix4x4& modelMatrix, const Color& color);
+
+	/**
+	 * Grid of 50 x 50 cells with an extend of 50 in the xy plane.
+	 */
+	void recordGrid(const Matrix4x4& modelMatrix, const Color& color);
+
+	/**
+	 * Sphere with radius one.
+	 */
+	void recordSphere(const Matrix4x4& modelMatrix, const Color& color);
+
+	/**
+	 * Cone along the y axis with a half extend and radius of 0.5. The tip is pointing up.
+	 */
+	void recordCone(const Matrix4x4& modelMatrix, const Color& color);
+
+	/**
+	 * Cylinder along the y axis with a half extend and radius of 0.5.
+	 */
+	void recordCylinder(const Matrix4x4& modelMatrix, const Color& color);
+
+	/**
+	 * Pyramid along the y axis with a half extend of 0.5. The tip is pointing up.
+	 */
+	void recordPyramid(const Matrix4x4& modelMatrix, const Color& color);
+
+	std::uint32_t getNumberVertices() const;
+
+	/**
+	 * Moves the recorded vertices into the given vector and starts a new frame. The storage of the given vector is kept
+	 * for recording, so no allocations are needed in the following frames.
+	 */
+	void swapVertices(std::vector<float>& vertices);
+
+	void clear();
+
+};
+
+#endif /* DEBUGLINERECORDER_H_ */
@@ -0,0 +1,85 @@
+/*
+ * DebugLineRenderer.cpp
+ *
+ *  Created on: 19.10.2026
+ *      Author: nopper
+ */
+
+#include "../../layer1/shader/ProgramFactory.h"
+
+#include "DebugLineRenderer.h"
+
+using namespace std;
+
+DebugLineRenderer::DebugLineRenderer() :
+	Singleton<DebugLineRenderer>(), recorder(), vertexCapacity(0), batching(false), allDrawVertices()
+{
+	ProgramFactory programFactory;
+	program = programFactory.createDebugLineProgram();
+
+	// The buffer grows on demand. The vertices are streamed every frame.
+	glGenBuffers(1, &vboVertices);
+
+	debugLineVAO = DebugLineVAOSP(new DebugLineVAO(program, vboVertices));
+}
+
+DebugLineRenderer::~DebugLineRenderer()
+{
+	glDeleteBuffers(1, &vboVertices);
+
+	debugLineVAO.reset();
+
+	program.reset();
+}
+
+DebugLineRecorder& DebugLineRenderer::getRecorder()
+{
+	return recorder;
+}
+
+bool DebugLineRenderer::isBatching() const
+{
+	return batching;
+}
+
+void DebugLineRenderer::setBatching(bool batching)
+{
+	if (this->batching && !batching)
+	{
+		flush();
+	}
+
+	this->batching = batching;
+}
+
+void DebugLineRenderer::flush()
+{
+	recorder.swapVertices(allDrawVertices);
+
+	if (allDrawVertices.size() == 0)
+	{
+		return;
+	}
+
+	uint32_t numberVertices = static_cast<uint32_t>(allDrawVertices.size()) / DebugLineRecorder::FLOATS_PER_VERTEX;
+
+	uint32_t vertexBytes = static_cast<uint32_t>(allDrawVertices.size() * sizeof(GLfloat));
+
+	glBindBuffer(GL_ARRAY_BUFFER, vboVertices);
+
+	// Orphaning the storage avoids waiting for the draw of the last frame.
+	vertexCapacity = max(vertexBytes, vertexCapacity);
+
+	glBufferData(GL_ARRAY_BUFFER, vertexCapacity, nullptr, GL_STREAM_DRAW);
+	glBufferSubData(GL_ARRAY_BUFFER, 0, vertexBytes, allDrawVertices.data());
+
+	glBindBuffer(GL_ARRAY_BUFFER, 0);
+
+	program->use();
+
+	debugLineVAO->bind();
+
+	glDrawArrays(GL_LINES, 0, numberVertices);
+
+	debugLineVAO->unbind();
+}
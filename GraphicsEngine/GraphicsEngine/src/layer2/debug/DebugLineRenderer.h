@@ -0,0 +1,64 @@
+/*
+ * DebugLineRenderer.h
+ *
+ *  Created on: 19.10.2026
+ *      Author: nopper
+ */
+
+#ifndef DEBUGLINERENDERER_H_
+#define DEBUGLINERENDERER_H_
+
+#include "../../UsedLibs.h"
+
+#include "../../layer0/stereotype/Singleton.h"
+#include "../../layer1/shader/Program.h"
+#include "DebugLineRecorder.h"
+#include "DebugLineVAO.h"
+
+/**
+ * Draws the debug primitives recorded during a frame with one draw call. Has to be created on the rendering thread.
+ */
+class DebugLineRenderer : public Singleton<DebugLineRenderer>
+{
+
+	friend class Singleton<DebugLineRenderer>;
+
+private:
+
+	DebugLineRecorder recorder;
+
+	GLuint vboVertices;
+
+	std::uint32_t vertexCapacity;
+
+	ProgramSP program;
+
+	DebugLineVAOSP debugLineVAO;
+
+	bool batching;
+
+	std::vector<float> allDrawVertices;
+
+	DebugLineRenderer();
+	virtual ~DebugLineRenderer();
+
+public:
+
+	DebugLineRecorder& getRecorder();
+
+	bool isBatching() const;
+
+	/**
+	 * If batching, debug draws are recorded and drawn by flush. Otherwise, each debug draw is drawn at once.
+	 * Should only be changed between frames.
+	 */
+	void setBatching(bool batching);
+
+	/**
+	 * Draws all recorded lines with the current camera. Has to be called once per frame, if batching.
+	 */
+	void flush();
+
+};
+
+#endif /* DEBUGLINERENDERER_H_ */
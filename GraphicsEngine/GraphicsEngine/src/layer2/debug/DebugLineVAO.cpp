@@ -0,0 +1,35 @@
+/*
+ * DebugLineVAO.cpp
+ *
+ *  Created on: 19.10.2026
+ *      Author: nopper
+ */
+
+#include "../../layer1/shader/Variables.h"
+#include "DebugLineRecorder.h"
+
+#include "DebugLineVAO.h"
+
+DebugLineVAO::DebugLineVAO(const ProgramSP& program, GLuint vboVertices) :
+		VAO(program)
+{
+	generateVAO();
+
+	GLsizei stride = DebugLineRecorder::FLOATS_PER_VERTEX * sizeof(GLfloat);
+
+	glBindBuffer(GL_ARRAY_BUFFER, vboVertices);
+	glVertexAttribPointer(program->getAttribLocation(a_vertex), 3, GL_FLOAT, GL_FALSE, stride, 0);
+	glEnableVertexAttribArray(program->getAttribLocation(a_vertex));
+
+	glVertexAttribPointer(program->getAttribLocation(a_color), 4, GL_FLOAT, GL_FALSE, stride, reinterpret_cast<const GLvoid*>(3 * sizeof(GLfloat)));
+	glEnableVertexAttribArray(program->getAttribLocation(a_color));
+
+	glEnableVertexAttribArray(0);
+
+	unbind();
+}
+
+DebugLineVAO::~DebugLineVAO()
+{
+	deleteVAO();
+}
@@ -0,0 +1,24 @@
+/*
+ * DebugLineVAO.h
+ *
+ *  Created on: 19.10.2026
+ *      Author: nopper
+ */
+
+#ifndef DEBUGLINEVAO_H_
+#define DEBUGLINEVAO_H_
+
+#include "../../UsedLibs.h"
+
+#include "../../layer1/shader/Program.h"
+#include "../../layer1/shader/VAO.h"
+
+class DebugLineVAO : public VAO {
+public:
+	DebugLineVAO(const ProgramSP& program, GLuint vboVertices);
+	virtual ~DebugLineVAO();
+};
+
+typedef std::shared_ptr<DebugLineVAO> DebugLineVAOSP;
+
+#endif /* DEBUGLINEVAO_H_ */
@@ -260,3 +260,30 @@ void FrameBuffer::setDepthStencilAttachment(const RenderBufferSP& renderBuffer)
 	init();
 }
 
+
+uint64_t FrameBuffer::getMemorySize() const
+{
+	uint64_t result = 0;
+
+	const TextureSP* allTextures[] = {&color0Texture, &color1Texture, &depthTexture, &depthStencilTexture};
+
+	for (auto currentTexture : allTextures)
+	{
+		if (currentTexture->get())
+		{
+			result += (*currentTexture)->getMemorySize();
+		}
+	}
+
+	const RenderBufferSP* allRenderBuffers[] = {&color0RenderBuffer, &color1RenderBuffer, &depthRenderBuffer, &depthStencilRenderBuffer};
+
+	for (auto currentRenderBuffer : allRenderBuffers)
+	{
+		if (currentRenderBuffer->get())
+		{
+			result += (*currentRenderBuffer)->getMemorySize();
+		}
+	}
+
+	return result;
+}
@@ -65,6 +65,11 @@ public:
 	const RenderBufferSP& getDepthStencilRenderBuffer() const;
 	const TextureSP& getDepthStencilTexture() const;
 
+	/**
+	 * @return Estimated size in bytes of the attachments. Attachments shared with other frame buffers are counted as well.
+	 */
+	std::uint64_t getMemorySize() const;
+
 };
 
 typedef std::shared_ptr<FrameBuffer> FrameBufferSP;
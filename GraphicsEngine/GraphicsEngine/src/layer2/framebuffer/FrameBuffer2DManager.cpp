@@ -38,7 +38,7 @@ const FrameBuffer2DSP& FrameBuffer2DManager::getFrameBuffer(const string& key) c
 
 void FrameBuffer2DManager::addFrameBuffer(const string& key, const FrameBuffer2DSP& framBuffer2D, bool windowFrameBuffer)
 {
-	allFrameBuffers[key] = framBuffer2D;
+	allFrameBuffers.replace(key, framBuffer2D);
 
 	if (windowFrameBuffer)
 	{
@@ -50,14 +50,16 @@ FrameBuffer2DSP FrameBuffer2DManager::createFrameBuffer(const string& key, int32
 {
 	if (!allFrameBuffers.contains(key))
 	{
-		allFrameBuffers[key] = FrameBuffer2DSP(new FrameBuffer2D(width, height));
+		FrameBuffer2DSP frameBuffer2D = FrameBuffer2DSP(new FrameBuffer2D(width, height));
+
+		allFrameBuffers.replace(key, frameBuffer2D);
 
 		if (windowFrameBuffer)
 		{
-			allWindowFrameBuffers[key] = allFrameBuffers[key];
+			allWindowFrameBuffers[key] = frameBuffer2D;
 		}
 
-		return allFrameBuffers[key];
+		return frameBuffer2D;
 	}
 
 	return allFrameBuffers[key];
@@ -74,3 +76,23 @@ void FrameBuffer2DManager::updateWidthHeight(int32_t width, int32_t height)
 		walker++;
 	}
 }
+
+void FrameBuffer2DManager::setBudget(uint64_t budget)
+{
+	allFrameBuffers.setBudget(budget);
+}
+
+uint64_t FrameBuffer2DManager::getBudget() const
+{
+	return allFrameBuffers.getBudget();
+}
+
+int32_t FrameBuffer2DManager::trim()
+{
+	return allFrameBuffers.trim();
+}
+
+ResourceCacheStatistics FrameBuffer2DManager::getStatistics() const
+{
+	return allFrameBuffers.getStatistics();
+}
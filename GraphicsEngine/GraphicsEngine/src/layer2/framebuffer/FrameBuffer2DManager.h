@@ -11,6 +11,7 @@
 #include "../../UsedLibs.h"
 
 #include "../../layer0/stereotype/KeyValueMap.h"
+#include "../../layer0/stereotype/ResourceCache.h"
 #include "../../layer0/stereotype/Singleton.h"
 
 #include "FrameBuffer2D.h"
@@ -22,8 +23,9 @@ class FrameBuffer2DManager : public Singleton<FrameBuffer2DManager>
 
 private:
 
-	KeyValueMap<std::string, FrameBuffer2DSP> allFrameBuffers;
+	ResourceCache<std::string, FrameBuffer2DSP> allFrameBuffers;
 
+	// Keeps the frame buffers resized with the window, so they are never evicted.
 	KeyValueMap<std::string, FrameBuffer2DSP> allWindowFrameBuffers;
 
 	FrameBuffer2DManager();
@@ -41,6 +43,23 @@ public:
 
 	void updateWidthHeight(std::int32_t width, std::int32_t height);
 
+	/**
+	 * @param budget Maximum of bytes of all frame buffers in video memory. Frame buffers exceeding it are evicted, if they
+	 *               are not used anymore. Zero is unlimited.
+	 */
+	void setBudget(std::uint64_t budget);
+
+	std::uint64_t getBudget() const;
+
+	/**
+	 * Evicts unused frame buffers, until the budget is kept, e.g. after unloading a level.
+	 *
+	 * @return Number of evicted frame buffers.
+	 */
+	std::int32_t trim();
+
+	ResourceCacheStatistics getStatistics() const;
+
 };
 
 
@@ -130,6 +130,63 @@ bool FrameBufferCubeMap::renderAtOnce() const
 	return depthCubeMapTexture.get() != nullptr || depthStencilCubeMapTexture.get() != nullptr;
 }
 
+void FrameBufferCubeMap::clearFaces(int32_t faceMask, GLbitfield buffers)
+{
+	if (!enabled || !isValid() || !cubeMapTexture.get())
+	{
+		return;
+	}
+
+	if ((faceMask & 0x3F) == 0x3F || (!renderAtOnce() && (buffers & GL_COLOR_BUFFER_BIT) == 0))
+	{
+		glClear(buffers);
+
+		return;
+	}
+
+	// A clear of a layered attachment affects all layers, so each face is attached on its own.
+	for (int32_t face = 0; face < 6; face++)
+	{
+		if ((faceMask & (1 << face)) == 0)
+		{
+			continue;
+		}
+
+		GLenum side = GL_TEXTURE_CUBE_MAP_POSITIVE_X + face;
+
+		glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, side, cubeMapTexture->getTextureName(), 0);
+
+		if (depthCubeMapTexture.get())
+		{
+			glFramebufferTexture2D(GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, side, depthCubeMapTexture->getTextureName(), 0);
+		}
+		else if (depthStencilCubeMapTexture.get())
+		{
+			glFramebufferTexture2D(GL_FRAMEBUFFER, GL_DEPTH_STENCIL_ATTACHMENT, side, depthStencilCubeMapTexture->getTextureName(), 0);
+		}
+
+		glClear(buffers);
+	}
+
+	if (renderAtOnce())
+	{
+		glFramebufferTexture(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, cubeMapTexture->getTextureName(), 0);
+
+		if (depthCubeMapTexture.get())
+		{
+			glFramebufferTexture(GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, depthCubeMapTexture->getTextureName(), 0);
+		}
+		else if (depthStencilCubeMapTexture.get())
+		{
+			glFramebufferTexture(GL_FRAMEBUFFER, GL_DEPTH_STENCIL_ATTACHMENT, depthStencilCubeMapTexture->getTextureName(), 0);
+		}
+	}
+	else
+	{
+		glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, activeSide, cubeMapTexture->getTextureName(), 0);
+	}
+}
+
 const TextureCubeMapSP& FrameBufferCubeMap::getCubeMapTexture() const
 {
 	return cubeMapTexture;
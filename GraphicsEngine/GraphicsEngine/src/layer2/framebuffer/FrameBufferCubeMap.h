@@ -43,6 +43,12 @@ public:
 
 	bool renderAtOnce() const;
 
+	/**
+	 * Clears only the given faces. Bit i of the face mask stands for GL_TEXTURE_CUBE_MAP_POSITIVE_X + i.
+	 * The frame buffer has to be in use.
+	 */
+	void clearFaces(std::int32_t faceMask, GLbitfield buffers);
+
 	void setCubeMapAttachment(const TextureCubeMapSP& cubeMapTexture);
 
 	void setDepthAttachment(const TextureCubeMapSP& cubeMapTexture);
@@ -12,8 +12,8 @@
 
 using namespace std;
 
-Ground::Ground(const BoundingSphere& boundingSphere, const GridPlaneShape& gridPlaneShape) :
-		boundingSphere(boundingSphere), numberVertices(gridPlaneShape.getShape().numberVertices), numberIndices(gridPlaneShape.getShape().numberIndices), allVAOs()
+Ground::Ground(const BoundingSphere& boundingSphere, const GridPlaneShape& gridPlaneShape, bool terrainTile) :
+		boundingSphere(boundingSphere), terrainTile(terrainTile), numberVertices(gridPlaneShape.getShape().numberVertices), numberIndices(gridPlaneShape.getShape().numberIndices), allVAOs()
 {
 	glGenBuffers(1, &vboVertices);
 	glBindBuffer(GL_ARRAY_BUFFER, vboVertices);
@@ -43,17 +43,17 @@ Ground::Ground(const BoundingSphere& boundingSphere, const GridPlaneShape& gridP
 
 	ProgramFactory programFactory;
 
-	ProgramSP shaderprogram = programFactory.createGroundProgram();
+	ProgramSP shaderprogram = terrainTile ? programFactory.createTerrainProgram() : programFactory.createGroundProgram();
 
 	GroundVAOSP vao = GroundVAOSP(new GroundVAO(shaderprogram, *this));
 	addVAO(vao);
 
-	shaderprogram = programFactory.createGroundRenderToCubeMapProgram();
+	shaderprogram = terrainTile ? programFactory.createTerrainRenderToCubeMapProgram() : programFactory.createGroundRenderToCubeMapProgram();
 
 	vao = GroundVAOSP(new GroundVAO(shaderprogram, *this));
 	addVAO(vao);
 
-	shaderprogram = programFactory.createGroundRenderToShadowMapProgram();
+	shaderprogram = terrainTile ? programFactory.createTerrainRenderToShadowMapProgram() : programFactory.createGroundRenderToShadowMapProgram();
 
 	vao = GroundVAOSP(new GroundVAO(shaderprogram, *this));
 	addVAO(vao);
@@ -91,6 +91,11 @@ const BoundingSphere& Ground::getBoundingSphere() const
 	return boundingSphere;
 }
 
+bool Ground::isTerrainTile() const
+{
+	return terrainTile;
+}
+
 uint32_t Ground::getNumberVertices() const
 {
 	return numberVertices;
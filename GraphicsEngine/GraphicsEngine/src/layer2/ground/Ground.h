@@ -22,6 +22,8 @@ private:
 
 	BoundingSphere boundingSphere;
 
+	bool terrainTile;
+
 	std::uint32_t numberVertices;
 
 	std::uint32_t numberIndices;
@@ -40,11 +42,16 @@ private:
 
 public:
 
-	Ground(const BoundingSphere& boundingSphere, const GridPlaneShape& gridPlaneShape);
+	/**
+	 * @param terrainTile If true, the grid is a tile of a terrain and the terrain programs are used, which place the tile.
+	 */
+	Ground(const BoundingSphere& boundingSphere, const GridPlaneShape& gridPlaneShape, bool terrainTile = false);
 	virtual ~Ground();
 
 	const BoundingSphere& getBoundingSphere() const;
 
+	bool isTerrainTile() const;
+
     std::uint32_t getNumberVertices() const;
 
     GLuint getVboVertices() const;
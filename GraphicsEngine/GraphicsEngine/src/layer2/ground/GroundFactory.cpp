@@ -31,3 +31,23 @@ GroundSP GroundFactory::createGround(float horizontalExtend, float verticalExten
 
 	return GroundSP(new Ground(boundingSphere, gridPlaneShape));
 }
+
+GroundSP GroundFactory::createTerrainTile(uint32_t gridSize) const
+{
+	if (gridSize < 2 || gridSize % 2 != 0)
+	{
+		glusLogPrint(GLUS_LOG_ERROR, "Terrain tile grid size has to be even: %u", gridSize);
+
+		return GroundSP();
+	}
+
+	float radius = glusMathLengthf(0.5f, 0.5f, 0.0f);
+
+	BoundingSphere boundingSphere(Point4(), radius);
+
+	GridPlaneShape gridPlaneShape(1.0f, 1.0f, gridSize, gridSize);
+
+	gridPlaneShape.orderIndicesByQuadrant();
+
+	return GroundSP(new Ground(boundingSphere, gridPlaneShape, true));
+}
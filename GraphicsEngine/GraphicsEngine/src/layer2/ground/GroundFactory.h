@@ -22,6 +22,13 @@ public:
 
 	GroundSP createGround(float horizontalExtend, float verticalExtend, std::uint32_t rows, std::uint32_t columns) const;
 
+	/**
+	 * Creates the unit grid, which is shared by all tiles of all terrains with the same grid size.
+	 *
+	 * @param gridSize Number of cells per side. Has to be even, as tiles can also be drawn by quadrant.
+	 */
+	GroundSP createTerrainTile(std::uint32_t gridSize) const;
+
 };
 
 #endif /* GROUNDFACTORY_H_ */
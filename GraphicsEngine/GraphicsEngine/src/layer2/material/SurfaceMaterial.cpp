@@ -5,13 +5,22 @@
  *      Author: Norbert Nopper
  */
 
+#include "../../layer1/shader/Variables.h"
+#include "../../layer1/texture/TextureStreamingManager.h"
+
 #include "SurfaceMaterial.h"
 
 using namespace std;
 
 SurfaceMaterial::SurfaceMaterial(const string& name) :
-	name(name), reflectionCoefficient(0.0f), reflectionCoefficientTexture(), roughness(0.0f), roughnessTexture(), emissive(Color::DEFAULT_EMISSIVE), emissiveTexture(), diffuse(Color::DEFAULT_DIFFUSE), diffuseTexture(), ambient(Color::DEFAULT_AMBIENT), ambientTexture(), specular(Color::DEFAULT_SPECULAR), specularTexture(), shininess(0.0f), shininessTexture(), reflection(Color::DEFAULT_REFLECTION), reflectionTexture(), refraction(Color::DEFAULT_REFRACTION), refractionTexture(), refractiveIndex(0.0f), refractiveIndexTexture(), transparency(1.0f), normalMapTexture(), displacementMapTexture(), dynamicCubeMapTexture(), convertDirectX(true), programPipeline()
+	name(name), reflectionCoefficient(0.0f), reflectionCoefficientTexture(), roughness(0.0f), roughnessTexture(), emissive(Color::DEFAULT_EMISSIVE), emissiveTexture(), diffuse(Color::DEFAULT_DIFFUSE), diffuseTexture(), ambient(Color::DEFAULT_AMBIENT), ambientTexture(), specular(Color::DEFAULT_SPECULAR), specularTexture(), shininess(0.0f), shininessTexture(), reflection(Color::DEFAULT_REFLECTION), reflectionTexture(), refraction(Color::DEFAULT_REFRACTION), refractionTexture(), refractiveIndex(0.0f), refractiveIndexTexture(), transparency(1.0f), normalMapTexture(), displacementMapTexture(), dynamicCubeMapTexture(), convertDirectX(true), programPipeline(), uniformBuffer(), textureBindingSet(), dirty(true)
 {
+	for (int32_t i = 0; i < UNIFORM_BLOCK_FLOATS; i++)
+	{
+		uniformBlock[i] = 0.0f;
+	}
+
+	unpackTextures();
 }
 
 SurfaceMaterial::~SurfaceMaterial()
@@ -296,126 +305,185 @@ GLuint SurfaceMaterial::getDynamicCubeMapTextureName() const
 void SurfaceMaterial::setReflectionCoefficient(float reflectionCoefficient)
 {
 	this->reflectionCoefficient = reflectionCoefficient;
+
+	dirty = true;
 }
 
 void SurfaceMaterial::setReflectionCoefficientTexture(const Texture2DSP& reflectionCoefficientTexture)
 {
 	this->reflectionCoefficientTexture = reflectionCoefficientTexture;
+
+	dirty = true;
 }
 
 void SurfaceMaterial::setRoughness(float roughness)
 {
 	this->roughness = roughness;
+
+	dirty = true;
 }
 
 void SurfaceMaterial::setRoughnessTexture(const Texture2DSP& roughnessTexture)
 {
 	this->roughnessTexture = roughnessTexture;
+
+	dirty = true;
 }
 
 void SurfaceMaterial::setEmissive(const Color& emissive)
 {
 	this->emissive = emissive;
+
+	dirty = true;
 }
 
 void SurfaceMaterial::setEmissiveTexture(const Texture2DSP& emissiveTexture)
 {
 	this->emissiveTexture = emissiveTexture;
+
+	dirty = true;
 }
 
 void SurfaceMaterial::setAmbient(const Color& ambient)
 {
 	this->ambient = ambient;
+
+	dirty = true;
 }
 
 void SurfaceMaterial::setAmbientTexture(const Texture2DSP& ambientTexture)
 {
 	this->ambientTexture = ambientTexture;
+
+	dirty = true;
 }
 
 void SurfaceMaterial::setDiffuse(const Color& diffuse)
 {
 	this->diffuse = diffuse;
+
+	dirty = true;
 }
 
 void SurfaceMaterial::setDiffuseTexture(const Texture2DSP& diffuseTexture)
 {
 	this->diffuseTexture = diffuseTexture;
+
+	packedTextures[PACKED_DIFFUSE] = TextureRegion();
+	packedTextures[PACKED_DIFFUSE].layer = -1;
+
+	dirty = true;
 }
 
 void SurfaceMaterial::setSpecular(const Color& specular)
 {
 	this->specular = specular;
+
+	dirty = true;
 }
 
 void SurfaceMaterial::setSpecularTexture(const Texture2DSP& specularTexture)
 {
 	this->specularTexture = specularTexture;
+
+	packedTextures[PACKED_SPECULAR] = TextureRegion();
+	packedTextures[PACKED_SPECULAR].layer = -1;
+
+	dirty = true;
 }
 
 void SurfaceMaterial::setShininess(float shininess)
 {
 	this->shininess = shininess;
+
+	dirty = true;
 }
 
 void SurfaceMaterial::setShininessTexture(const Texture2DSP& shininessTexture)
 {
 	this->shininessTexture = shininessTexture;
+
+	dirty = true;
 }
 
 void SurfaceMaterial::setReflection(const Color& reflection)
 {
 	this->reflection = reflection;
+
+	dirty = true;
 }
 
 void SurfaceMaterial::setReflectionTexture(const Texture2DSP& reflectionTexture)
 {
 	this->reflectionTexture = reflectionTexture;
+
+	dirty = true;
 }
 
 void SurfaceMaterial::setRefraction(const Color& refraction)
 {
 	this->refraction = refraction;
+
+	dirty = true;
 }
 
 void SurfaceMaterial::setRefractionTexture(const Texture2DSP& refractionTexture)
 {
 	this->refractionTexture = refractionTexture;
+
+	dirty = true;
 }
 
 void SurfaceMaterial::setRefractiveIndex(float refractiveIndex)
 {
 	this->refractiveIndex = refractiveIndex;
+
+	dirty = true;
 }
 
 void SurfaceMaterial::setRefractiveIndexTexture(const Texture2DSP& refractiveIndexTexture)
 {
 	this->refractiveIndexTexture = refractiveIndexTexture;
+
+	dirty = true;
 }
 
 void SurfaceMaterial::setTransparency(float transparency)
 {
 	this->transparency = transparency;
+
+	dirty = true;
 }
 
 void SurfaceMaterial::setTransparencyTexture(const Texture2DSP& transparencyTexture)
 {
 	this->transparencyTexture = transparencyTexture;
+
+	dirty = true;
 }
 
 void SurfaceMaterial::setNormalMapTexture(const Texture2DSP& normalMapTexture)
 {
 	this->normalMapTexture = normalMapTexture;
+
+	packedTextures[PACKED_NORMAL_MAP] = TextureRegion();
+	packedTextures[PACKED_NORMAL_MAP].layer = -1;
+
+	dirty = true;
 }
 
 void SurfaceMaterial::setDisplacementMapTexture(const Texture2DSP& displacementMapTexture)
 {
 	this->displacementMapTexture = displacementMapTexture;
+
+	dirty = true;
 }
 
 void SurfaceMaterial::setDynamicCubeMapTexture(const TextureCubeMapSP& dynamicCubeMapTexture)
 {
 	this->dynamicCubeMapTexture = dynamicCubeMapTexture;
+
+	dirty = true;
 }
 
 //
@@ -428,6 +496,8 @@ bool SurfaceMaterial::isConvertDirectX() const
 void SurfaceMaterial::setConvertDirectX(bool convertDirectX)
 {
 	this->convertDirectX = convertDirectX;
+
+	dirty = true;
 }
 
 const ProgramPipelineSP& SurfaceMaterial::getProgramPipeline() const
@@ -439,3 +509,162 @@ void SurfaceMaterial::setProgramPipeline(const ProgramPipelineSP& programPipelin
 {
 	this->programPipeline = programPipeline;
 }
+
+int32_t SurfaceMaterial::packTextures(const TexturePacker& texturePacker)
+{
+	const Texture2DSP* allTextures[PACKED_TEXTURES] = {&diffuseTexture, &specularTexture, &normalMapTexture};
+
+	int32_t result = 0;
+
+	for (int32_t slot = 0; slot < PACKED_TEXTURES; slot++)
+	{
+		if (allTextures[slot]->get() && texturePacker.containsRegion(allTextures[slot]->get()))
+		{
+			packedTextures[slot] = texturePacker.getRegion(allTextures[slot]->get());
+
+			result++;
+		}
+	}
+
+	dirty = true;
+
+	return result;
+}
+
+void SurfaceMaterial::unpackTextures()
+{
+	for (int32_t slot = 0; slot < PACKED_TEXTURES; slot++)
+	{
+		packedTextures[slot] = TextureRegion();
+		packedTextures[slot].layer = -1;
+	}
+
+	dirty = true;
+}
+
+bool SurfaceMaterial::isPackedTexture(int32_t slot) const
+{
+	return packedTextures[slot].texture2DArray.get() != nullptr;
+}
+
+const TextureRegion& SurfaceMaterial::getPackedTexture(int32_t slot) const
+{
+	return packedTextures[slot];
+}
+
+GLuint SurfaceMaterial::getDiffuseTextureBindingName() const
+{
+	if (isPackedTexture(PACKED_DIFFUSE))
+	{
+		return packedTextures[PACKED_DIFFUSE].texture2DArray->getTextureName();
+	}
+
+	return getDiffuseTextureName();
+}
+
+const GLint* SurfaceMaterial::getPackedLayers() const
+{
+	return packedLayers;
+}
+
+const GLfloat* SurfaceMaterial::getPackedRegions() const
+{
+	return packedRegions;
+}
+
+void SurfaceMaterial::requestResolution(float resolution) const
+{
+	TextureStreamingManager* textureStreamingManager = TextureStreamingManager::getInstance();
+
+	if (textureStreamingManager->getNumberTextures() == 0)
+	{
+		return;
+	}
+
+	const Texture2DSP* allTextures[] = {&reflectionCoefficientTexture, &roughnessTexture, &emissiveTexture, &diffuseTexture, &ambientTexture, &specularTexture, &shininessTexture, &reflectionTexture, &refractionTexture, &refractiveIndexTexture, &transparencyTexture, &normalMapTexture, &displacementMapTexture};
+
+	for (uint32_t i = 0; i < sizeof(allTextures) / sizeof(allTextures[0]); i++)
+	{
+		if (allTextures[i]->get())
+		{
+			textureStreamingManager->requestResolution(allTextures[i]->get(), resolution);
+		}
+	}
+}
+
+void SurfaceMaterial::updateUniformBlock()
+{
+	if (!dirty)
+	{
+		return;
+	}
+
+	for (int32_t i = 0; i < 4; i++)
+	{
+		uniformBlock[EMISSIVE_OFFSET + i] = emissive.getRGBA()[i];
+		uniformBlock[AMBIENT_OFFSET + i] = ambient.getRGBA()[i];
+		uniformBlock[DIFFUSE_OFFSET + i] = diffuse.getRGBA()[i];
+		uniformBlock[SPECULAR_OFFSET + i] = specular.getRGBA()[i];
+		uniformBlock[REFLECTION_OFFSET + i] = reflection.getRGBA()[i];
+		uniformBlock[REFRACTION_OFFSET + i] = refraction.getRGBA()[i];
+	}
+	uniformBlock[SHININESS_OFFSET] = shininess;
+	uniformBlock[TRANSPARENCY_OFFSET] = transparency;
+
+	if (!uniformBuffer.get())
+	{
+		uniformBuffer = UniformBufferSP(new UniformBuffer(UNIFORM_BLOCK_FLOATS * sizeof(GLfloat)));
+	}
+	uniformBuffer->update(uniformBlock);
+
+	GLuint textureNames[PACKED_TEXTURES] = {getDiffuseTextureName(), getSpecularTextureName(), getNormalMapTextureName()};
+
+	textureBindingSet.clear();
+
+	// Packed textures are bound as arrays on their own units, as sampler types must not share a unit.
+	for (int32_t slot = 0; slot < PACKED_TEXTURES; slot++)
+	{
+		GLuint arrayName = 0;
+
+		if (isPackedTexture(slot))
+		{
+			arrayName = packedTextures[slot].texture2DArray->getTextureName();
+
+			textureNames[slot] = 0;
+
+			packedLayers[slot] = packedTextures[slot].layer;
+			packedRegions[slot * 4 + 0] = packedTextures[slot].offset[0];
+			packedRegions[slot * 4 + 1] = packedTextures[slot].offset[1];
+			packedRegions[slot * 4 + 2] = packedTextures[slot].scale[0];
+			packedRegions[slot * 4 + 3] = packedTextures[slot].scale[1];
+		}
+		else
+		{
+			packedLayers[slot] = -1;
+			packedRegions[slot * 4 + 0] = 0.0f;
+			packedRegions[slot * 4 + 1] = 0.0f;
+			packedRegions[slot * 4 + 2] = 1.0f;
+			packedRegions[slot * 4 + 3] = 1.0f;
+		}
+
+		textureBindingSet.addBinding(GL_TEXTURE0 + slot, GL_TEXTURE_2D, textureNames[slot]);
+		textureBindingSet.addBinding(GL_TEXTURE0 + PACKED_TEXTURE_UNIT + slot, GL_TEXTURE_2D_ARRAY, arrayName);
+	}
+
+	dirty = false;
+}
+
+const GLfloat* SurfaceMaterial::getUniformBlock() const
+{
+	return uniformBlock;
+}
+
+const UniformBufferSP& SurfaceMaterial::getUniformBuffer() const
+{
+	return uniformBuffer;
+}
+
+const TextureBindingSet& SurfaceMaterial::getTextureBindingSet() const
+{
+	return textureBindingSet;
+}
@@ -12,7 +12,10 @@
 
 #include "../../layer0/color/Color.h"
 #include "../../layer1/shader/ProgramPipeline.h"
+#include "../../layer1/shader/UniformBuffer.h"
+#include "../../layer1/texture/TextureBindingSet.h"
 #include "../../layer1/texture/Texture2D.h"
+#include "../../layer1/texture/TexturePacker.h"
 #include "../../layer1/texture/TextureCubeMap.h"
 
 class SurfaceMaterial
@@ -85,8 +88,48 @@ private:
 
 	ProgramPipelineSP programPipeline;
 
+	//
+
+	TextureRegion packedTextures[3];
+
+	GLint packedLayers[3];
+
+	GLfloat packedRegions[3 * 4];
+
+	//
+
+	GLfloat uniformBlock[28];
+
+	UniformBufferSP uniformBuffer;
+
+	TextureBindingSet textureBindingSet;
+
+	bool dirty;
+
 public:
 
+	/**
+	 * Layout of the std140 MaterialBlock in floats: emissive, ambient, diffuse, specular, reflection and refraction color as vec4,
+	 * followed by shininess and transparency.
+	 */
+	static const std::int32_t EMISSIVE_OFFSET = 0;
+	static const std::int32_t AMBIENT_OFFSET = 4;
+	static const std::int32_t DIFFUSE_OFFSET = 8;
+	static const std::int32_t SPECULAR_OFFSET = 12;
+	static const std::int32_t REFLECTION_OFFSET = 16;
+	static const std::int32_t REFRACTION_OFFSET = 20;
+	static const std::int32_t SHININESS_OFFSET = 24;
+	static const std::int32_t TRANSPARENCY_OFFSET = 25;
+	static const std::int32_t UNIFORM_BLOCK_FLOATS = 28;
+
+	/**
+	 * Slots of the textures, which can be replaced by a region of a packed texture array.
+	 */
+	static const std::int32_t PACKED_DIFFUSE = 0;
+	static const std::int32_t PACKED_SPECULAR = 1;
+	static const std::int32_t PACKED_NORMAL_MAP = 2;
+	static const std::int32_t PACKED_TEXTURES = 3;
+
 	SurfaceMaterial(const std::string& name);
 	virtual ~SurfaceMaterial();
 
@@ -203,6 +246,61 @@ public:
 	const ProgramPipelineSP& getProgramPipeline() const;
 	void setProgramPipeline(const ProgramPipelineSP& programPipeline);
 
+	//
+
+	/**
+	 * Samples the diffuse, specular and normal map texture from their packed regions, if the packer contains them.
+	 * The 2D textures stay referenced, but are not bound anymore. Setting one of these textures again unpacks it.
+	 *
+	 * @return Number of textures now sampled from packed regions.
+	 */
+	std::int32_t packTextures(const TexturePacker& texturePacker);
+
+	void unpackTextures();
+
+	bool isPackedTexture(std::int32_t slot) const;
+
+	const TextureRegion& getPackedTexture(std::int32_t slot) const;
+
+	/**
+	 * @return Name of the texture bound for the diffuse color, which is the texture array, if packed.
+	 */
+	GLuint getDiffuseTextureBindingName() const;
+
+	/**
+	 * @return Layer per slot or -1, if not packed. Valid after updating the uniform block.
+	 */
+	const GLint* getPackedLayers() const;
+
+	/**
+	 * @return Offset and scale per slot. Valid after updating the uniform block.
+	 */
+	const GLfloat* getPackedRegions() const;
+
+	//
+
+	/**
+	 * Forwards the resolution in pixels, the material covers on the screen, to the streamed textures.
+	 */
+	void requestResolution(float resolution) const;
+
+	//
+
+	/**
+	 * Rebuilds the uniform block, its buffer and the texture binding set, if the material has been changed since the last call.
+	 * Needs a current context.
+	 */
+	void updateUniformBlock();
+
+	const GLfloat* getUniformBlock() const;
+
+	const UniformBufferSP& getUniformBuffer() const;
+
+	/**
+	 * Diffuse, specular and normal map texture on the units zero to two.
+	 */
+	const TextureBindingSet& getTextureBindingSet() const;
+
 };
 
 typedef std::shared_ptr<SurfaceMaterial> SurfaceMaterialSP;
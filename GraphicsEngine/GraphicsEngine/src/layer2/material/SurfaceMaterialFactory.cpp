@@ -28,6 +28,8 @@ SurfaceMaterialSP SurfaceMaterialFactory::createSurfaceMaterial(const string& na
 
 	surfaceMaterial->setConvertDirectX(false);
 
+	surfaceMaterial->updateUniformBlock();
+
 	return surfaceMaterial;
 }
 
@@ -37,6 +39,8 @@ SurfaceMaterialSP SurfaceMaterialFactory::createSurfaceMaterial(const string& na
 
 	surfaceMaterial->setDiffuse(diffuse);
 
+	surfaceMaterial->updateUniformBlock();
+
 	return surfaceMaterial;
 }
 
@@ -50,6 +54,8 @@ SurfaceMaterialSP SurfaceMaterialFactory::createSurfaceMaterial(const string& na
 	surfaceMaterial->setSpecular(specular);
 	surfaceMaterial->setShininess(shininess);
 
+	surfaceMaterial->updateUniformBlock();
+
 	return surfaceMaterial;
 }
 
@@ -63,6 +69,8 @@ SurfaceMaterialSP SurfaceMaterialFactory::createSurfaceMaterial(const string& na
 	surfaceMaterial->setSpecular(specular);
 	surfaceMaterial->setShininess(shininess);
 
+	surfaceMaterial->updateUniformBlock();
+
 	return surfaceMaterial;
 }
 
@@ -77,6 +85,8 @@ SurfaceMaterialSP SurfaceMaterialFactory::createSurfaceMaterial(const string& na
 	surfaceMaterial->setSpecular(specular);
 	surfaceMaterial->setShininess(shininess);
 
+	surfaceMaterial->updateUniformBlock();
+
 	return surfaceMaterial;
 }
 
@@ -94,6 +104,8 @@ SurfaceMaterialSP SurfaceMaterialFactory::createSurfaceMaterial(const string& na
 	surfaceMaterial->setRefractiveIndex(refractiveIndex);
 	surfaceMaterial->setTransparency(transparency);
 
+	surfaceMaterial->updateUniformBlock();
+
 	return surfaceMaterial;
 }
 
@@ -111,6 +123,8 @@ SurfaceMaterialSP SurfaceMaterialFactory::createSurfaceMaterial(const string& na
 	surfaceMaterial->setRefractiveIndex(refractiveIndex);
 	surfaceMaterial->setTransparency(transparency);
 
+	surfaceMaterial->updateUniformBlock();
+
 	return surfaceMaterial;
 }
 
@@ -129,6 +143,8 @@ SurfaceMaterialSP SurfaceMaterialFactory::createSurfaceMaterial(const string& na
 	surfaceMaterial->setRefractiveIndex(refractiveIndex);
 	surfaceMaterial->setTransparency(transparency);
 
+	surfaceMaterial->updateUniformBlock();
+
 	return surfaceMaterial;
 }
 
@@ -147,6 +163,8 @@ SurfaceMaterialSP SurfaceMaterialFactory::createSurfaceMaterial(const string& na
 	surfaceMaterial->setTransparency(transparency);
 	surfaceMaterial->setDynamicCubeMapTexture(dynamicCubeMapTexture);
 
+	surfaceMaterial->updateUniformBlock();
+
 	return surfaceMaterial;
 }
 
@@ -166,5 +184,7 @@ SurfaceMaterialSP SurfaceMaterialFactory::createSurfaceMaterial(const string& na
 	surfaceMaterial->setTransparency(transparency);
 	surfaceMaterial->setDynamicCubeMapTexture(dynamicCubeMapTexture);
 
+	surfaceMaterial->updateUniformBlock();
+
 	return surfaceMaterial;
 }
@@ -55,7 +55,7 @@ void Camera::updateViewFrustum()
 	float zNDC, zCurrent;
 	for (int32_t i = 0; i <= viewFrustum.getNumberSections(); i++)
 	{
-		zCurrent = -(zNear + (zFar - zNear) * static_cast<float>(i) / static_cast<float>(viewFrustum.getNumberSections()));
+		zCurrent = -ViewFrustum::calculateSplitDistance(i, viewFrustum.getNumberSections(), zNear, zFar, viewFrustum.getSplitLambda());
 
 		// see http://www.songho.ca/opengl/gl_projectionmatrix.html
 		zNDC = (-(zFar + zNear) / (zFar - zNear) * zCurrent + (-2.0f * zFar * zNear) / (zFar - zNear)) / -zCurrent;
@@ -168,6 +168,13 @@ void Camera::setNumberSections(int32_t sections)
 	viewFrustum.setNumberSections(sections);
 }
 
+void Camera::setSplitLambda(float splitLambda)
+{
+	viewFrustum.setSplitLambda(splitLambda);
+
+	updateViewFrustum();
+}
+
 float Camera::distanceToCamera(const BoundingSphere& boundingSphere) const
 {
 	return (boundingSphere.getCenter() - eye).length();
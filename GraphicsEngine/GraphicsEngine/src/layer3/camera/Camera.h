@@ -115,6 +115,11 @@ public:
 
 	void setNumberSections(std::int32_t sections);
 
+	/**
+	 * @see ViewFrustum::setSplitLambda
+	 */
+	void setSplitLambda(float splitLambda);
+
 	float distanceToCamera(const BoundingSphere& boundingSphere) const;
 
 	void setCameraProperties(const ProgramSP& program, const Point4& position, const Quaternion& rotation, bool useLocation = false);
@@ -165,3 +165,149 @@ void OrthographicCamera::adjustToFrustum(const ViewFrustum& viewFrustum, int32_t
 	lastPosition = lightPosition + offset;
 	lastRotation = lightRotation;
 }
+
+void OrthographicCamera::adjustToFrustum(const ViewFrustum& viewFrustum, int32_t section, const Quaternion& lightRotation, int32_t resolution, const AxisAlignedBoundingBox* receiverBounds, const AxisAlignedBoundingBox* casterBounds)
+{
+	const vector<Point4>& frustumPoints = viewFrustum.getFrustumPoints();
+
+	Vector3 lightForward = lightRotation * Vector3(1.0f, 0.0f, 0.0f);
+	Vector3 lightRight = lightRotation * Vector3(0.0f, 0.0f, -1.0f);
+	Vector3 lightUp = lightRotation * Vector3(0.0f, -1.0f, 0.0f);
+
+	// Light space bounds and bounding sphere of the section. The sphere does not change, when the viewer rotates.
+	Vector3 min;
+	Vector3 max;
+	Vector3 sphereCenter(0.0f, 0.0f, 0.0f);
+
+	for (int32_t i = section * 4; i < section * 4 + 8; i++)
+	{
+		Vector3 v = frustumPoints[i] - Point4();
+
+		Vector3 temp(lightRight.dot(v), lightUp.dot(v), lightForward.dot(v));
+
+		sphereCenter += temp * (1.0f / 8.0f);
+
+		for (int32_t k = 0; k < 3; k++)
+		{
+			if (i == section * 4 || temp[k] < min[k])
+			{
+				min[k] = temp[k];
+			}
+			if (i == section * 4 || temp[k] > max[k])
+			{
+				max[k] = temp[k];
+			}
+		}
+	}
+
+	float radius = 0.0f;
+
+	for (int32_t i = section * 4; i < section * 4 + 8; i++)
+	{
+		Vector3 v = frustumPoints[i] - Point4();
+
+		Vector3 temp(lightRight.dot(v), lightUp.dot(v), lightForward.dot(v));
+
+		radius = glusMathMaxf(radius, (temp - sphereCenter).length());
+	}
+
+	// Avoid changes of the size caused by rounding errors.
+	radius = ceilf(radius * 16.0f) / 16.0f;
+
+	float extent = glusMathMaxf(2.0f * radius, 0.0001f);
+
+	float centerX = sphereCenter[0];
+	float centerY = sphereCenter[1];
+
+	if (receiverBounds)
+	{
+		Vector3 receiverMin;
+		Vector3 receiverMax;
+
+		for (int32_t i = 0; i < 8; i++)
+		{
+			Vector3 v = receiverBounds->getCenter() - Point4();
+
+			v[0] += (i & 1) ? receiverBounds->getHalfWidth() : -receiverBounds->getHalfWidth();
+			v[1] += (i & 2) ? receiverBounds->getHalfHeight() : -receiverBounds->getHalfHeight();
+			v[2] += (i & 4) ? receiverBounds->getHalfDepth() : -receiverBounds->getHalfDepth();
+
+			Vector3 temp(lightRight.dot(v), lightUp.dot(v), lightForward.dot(v));
+
+			for (int32_t k = 0; k < 3; k++)
+			{
+				if (i == 0 || temp[k] < receiverMin[k])
+				{
+					receiverMin[k] = temp[k];
+				}
+				if (i == 0 || temp[k] > receiverMax[k])
+				{
+					receiverMax[k] = temp[k];
+				}
+			}
+		}
+
+		float clippedMinX = glusMathMaxf(min[0], receiverMin[0]);
+		float clippedMaxX = glusMathMinf(max[0], receiverMax[0]);
+		float clippedMinY = glusMathMaxf(min[1], receiverMin[1]);
+		float clippedMaxY = glusMathMinf(max[1], receiverMax[1]);
+
+		if (clippedMinX <= clippedMaxX && clippedMinY <= clippedMaxY)
+		{
+			float tightExtent = glusMathMaxf(clippedMaxX - clippedMinX, clippedMaxY - clippedMinY);
+
+			// Only power of two steps, so the size stays stable while the receivers move slightly.
+			for (int32_t i = 0; i < 8 && extent * 0.5f >= tightExtent; i++)
+			{
+				extent *= 0.5f;
+			}
+
+			centerX = (clippedMinX + clippedMaxX) / 2.0f;
+			centerY = (clippedMinY + clippedMaxY) / 2.0f;
+
+			max[2] = glusMathMinf(max[2], receiverMax[2]);
+		}
+	}
+
+	// Snap to whole texels of the shadow map.
+	float texelSize = extent / static_cast<float>(resolution);
+
+	centerX = floorf(centerX / texelSize + 0.5f) * texelSize;
+	centerY = floorf(centerY / texelSize + 0.5f) * texelSize;
+
+	float nearDepth = min[2];
+
+	if (casterBounds)
+	{
+		float casterRadius = Vector3(casterBounds->getHalfWidth(), casterBounds->getHalfHeight(), casterBounds->getHalfDepth()).length();
+
+		nearDepth = glusMathMinf(nearDepth, lightForward.dot(casterBounds->getCenter() - Point4()) - casterRadius);
+	}
+	else
+	{
+		nearDepth -= extent;
+	}
+
+	nearDepth -= texelSize;
+
+	orthographic(extent, extent, 0.0f, glusMathMaxf(max[2] - nearDepth, texelSize));
+
+	//
+
+	Vector3 offset = lightRight * centerX + lightUp * centerY + lightForward * nearDepth;
+
+	transitionMatrix.identity();
+
+	transitionMatrix.translate(offset.getX(), offset.getY(), offset.getZ());
+
+	transitionMatrix *= lightRotation.getRotationMatrix4x4();
+
+	Point4 eye = transitionMatrix * Point4();
+	Point4 center = transitionMatrix * Point4(1.0f, 0.0f, 0.0f);
+	Vector3 up = transitionMatrix * Vector3(0.0f, 1.0f, 0.0f);
+
+	lookAt(eye, center, up);
+
+	lastPosition = eye;
+	lastRotation = lightRotation;
+}
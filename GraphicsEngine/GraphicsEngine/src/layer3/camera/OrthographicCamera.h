@@ -33,6 +33,16 @@ public:
 
 	void adjustToFrustum(const ViewFrustum& viewFrustum, std::int32_t section, const Point4& lightPosition, const Quaternion& lightRotation);
 
+	/**
+	 * Fits the camera around one section of the view frustum as seen by a directional light. The size only changes in powers
+	 * of two and the position is snapped to whole texels, so the shadow does not shimmer while the viewer moves.
+	 * The near plane is moved towards the light until all casters are enclosed, so the view frustum can cull the casters.
+	 *
+	 * @param receiverBounds If not null, the section is clipped to the bounds of the visible receivers.
+	 * @param casterBounds If not null, the bounds of all casters. Otherwise, the near plane is moved by the size of the section.
+	 */
+	void adjustToFrustum(const ViewFrustum& viewFrustum, std::int32_t section, const Quaternion& lightRotation, std::int32_t resolution, const AxisAlignedBoundingBox* receiverBounds, const AxisAlignedBoundingBox* casterBounds);
+
 };
 
 typedef std::shared_ptr<OrthographicCamera> OrthographicCameraSP;
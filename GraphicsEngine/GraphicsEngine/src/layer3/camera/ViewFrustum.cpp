@@ -13,7 +13,8 @@ using namespace std;
 
 Plane ViewFrustum::SIDES_NDC[6] = { Plane(Vector3(0.0f, 0.0f, 1.0f), 1.0f), Plane(Vector3(0.0f, 0.0f, -1.0f), 1.0f), Plane(Vector3(1.0f, 0.0f, 0.0f), 1.0f), Plane(Vector3(-1.0f, 0.0f, .0f), 1.0f), Plane(Vector3(0.0f, 1.0f, 0.0f), 1.0f), Plane(Vector3(0.0f, -1.0f, 0.0f), 1.0f) };
 
-ViewFrustum::ViewFrustum()
+ViewFrustum::ViewFrustum() :
+	splitLambda(0.0f)
 {
 	setNumberSections(1);
 }
@@ -30,6 +31,8 @@ ViewFrustum::ViewFrustum(const ViewFrustum& other)
 	frustumPoints = other.frustumPoints;
 
 	sections = other.sections;
+
+	splitLambda = other.splitLambda;
 }
 
 ViewFrustum::~ViewFrustum()
@@ -70,12 +73,11 @@ void ViewFrustum::transformToWorldSpace(const Camera& camera)
 	Point4 farBottomLeft = farCenter - farUp - farRight;
 	Point4 farBottomRight = farCenter - farUp + farRight;
 
-	float sectionsDepth = 1.0f / static_cast<float>(sections);
 	float currentSectionsDepth;
 
 	for (int32_t i = 0; i <= getNumberSections(); i++)
 	{
-		currentSectionsDepth = sectionsDepth * static_cast<float>(i);
+		currentSectionsDepth = (calculateSplitDistance(i, sections, camera.getNearZ(), camera.getFarZ(), splitLambda) - camera.getNearZ()) / (camera.getFarZ() - camera.getNearZ());
 
 		frustumPoints[i * 4 + 0] = nearTopLeft + (farTopLeft - nearTopLeft) * currentSectionsDepth;
 		frustumPoints[i * 4 + 1] = nearTopRight + (farTopRight - nearTopRight) * currentSectionsDepth;
@@ -101,6 +103,27 @@ bool ViewFrustum::isVisible(const BoundingSphere& boundingSphere) const
 	return true;
 }
 
+bool ViewFrustum::isVisible(const AxisAlignedBoundingBox& axisAlignedBoundingBox) const
+{
+	float distance;
+	float radius;
+
+	for (int32_t i = 0; i < 6; i++)
+	{
+		// Projected extent of the box onto the plane normal.
+		radius = axisAlignedBoundingBox.getHalfWidth() * fabsf(sides[i].getPlane()[0]) + axisAlignedBoundingBox.getHalfHeight() * fabsf(sides[i].getPlane()[1]) + axisAlignedBoundingBox.getHalfDepth() * fabsf(sides[i].getPlane()[2]);
+
+		distance = sides[i].distance(axisAlignedBoundingBox.getCenter());
+
+		if (distance + radius < 0.0f)
+		{
+			return false;
+		}
+	}
+
+	return true;
+}
+
 void ViewFrustum::setNumberSections(int32_t sections)
 {
 	if (sections <= 0)
@@ -127,3 +150,30 @@ const vector<Point4>& ViewFrustum::getFrustumPoints() const
 {
 	return frustumPoints;
 }
+
+void ViewFrustum::setSplitLambda(float splitLambda)
+{
+	this->splitLambda = glusMathClampf(splitLambda, 0.0f, 1.0f);
+}
+
+float ViewFrustum::getSplitLambda() const
+{
+	return splitLambda;
+}
+
+float ViewFrustum::calculateSplitDistance(int32_t index, int32_t sections, float zNear, float zFar, float splitLambda)
+{
+	float fraction = static_cast<float>(index) / static_cast<float>(sections);
+
+	float uniformDistance = zNear + (zFar - zNear) * fraction;
+
+	// Logarithmic splits are undefined for a near plane at the eye, as used by orthographic cameras.
+	if (zNear <= 0.0f || splitLambda <= 0.0f)
+	{
+		return uniformDistance;
+	}
+
+	float logarithmicDistance = zNear * powf(zFar / zNear, fraction);
+
+	return uniformDistance + (logarithmicDistance - uniformDistance) * splitLambda;
+}
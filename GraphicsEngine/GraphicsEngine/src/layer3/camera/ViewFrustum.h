@@ -14,6 +14,7 @@
 #include "../../layer0/math/Point4.h"
 #include "../../layer0/math/Matrix4x4.h"
 #include "../../layer0/math/Vector3.h"
+#include "../../layer1/collision/AxisAlignedBoundingBox.h"
 #include "../../layer1/collision/BoundingSphere.h"
 
 class Camera;
@@ -41,6 +42,8 @@ private:
 
 	std::int32_t sections;
 
+	float splitLambda;
+
 public:
 
 	ViewFrustum();
@@ -51,10 +54,24 @@ public:
 
 	bool isVisible(const BoundingSphere& boundingSphere) const;
 
+	bool isVisible(const AxisAlignedBoundingBox& axisAlignedBoundingBox) const;
+
 	void setNumberSections(std::int32_t sections);
 
 	std::int32_t getNumberSections() const;
 
+	/**
+	 * Blends the section splits between uniform at zero and logarithmic at one.
+	 */
+	void setSplitLambda(float splitLambda);
+
+	float getSplitLambda() const;
+
+	/**
+	 * @return Distance from the eye to the start of the given section. The last index returns the far distance.
+	 */
+	static float calculateSplitDistance(std::int32_t index, std::int32_t sections, float zNear, float zFar, float splitLambda);
+
 	const std::vector<Point4>& getFrustumPoints() const;
 
 };
@@ -0,0 +1,93 @@
+/*
+ * ImportAnimation.h
+ *
+ *  Created on: 19.10.2026
+ *      Author: nopper
+ */
+
+#ifndef IMPORTANIMATION_H_
+#define IMPORTANIMATION_H_
+
+#include "../../UsedLibs.h"
+
+#include "../../layer2/interpolation/Interpolator.h"
+#include "../animation/AnimationStack.h"
+
+/**
+ * Keys of one channel. Keys without an interpolator are skipped.
+ */
+struct ImportAnimationCurve
+{
+	std::vector<float> times;
+
+	std::vector<float> values;
+
+	std::vector<const Interpolator*> interpolators;
+};
+
+struct ImportAnimationLayer
+{
+	ImportAnimationCurve translation[3];
+
+	ImportAnimationCurve rotation[3];
+
+	ImportAnimationCurve scaling[3];
+};
+
+/**
+ * Clamps the values of each channel, if the limit is active.
+ */
+struct ImportAnimationLimits
+{
+	bool minActive[3];
+
+	bool maxActive[3];
+
+	float minimum[3];
+
+	float maximum[3];
+
+	ImportAnimationLimits()
+	{
+		for (std::int32_t i = 0; i < 3; i++)
+		{
+			minActive[i] = false;
+			maxActive[i] = false;
+			minimum[i] = 0.0f;
+			maximum[i] = 0.0f;
+		}
+	}
+};
+
+/**
+ * Animation curves of one node in one animation stack.
+ */
+struct ImportAnimationStack
+{
+	std::string name;
+
+	float startTime;
+
+	float stopTime;
+
+	std::vector<ImportAnimationLayer> layers;
+
+	ImportAnimationLimits translationLimits;
+
+	ImportAnimationLimits rotationLimits;
+
+	ImportAnimationLimits scalingLimits;
+
+	// Filled by the converter.
+
+	AnimationStackSP animationStack;
+
+	ImportAnimationStack() :
+		name(), startTime(0.0f), stopTime(0.0f), layers(), translationLimits(), rotationLimits(), scalingLimits(), animationStack()
+	{
+	}
+};
+
+typedef std::shared_ptr<ImportAnimationStack> ImportAnimationStackSP;
+
+#endif /* IMPORTANIMATION_H_ */
@@ -0,0 +1,73 @@
+/*
+ * ImportConvertCommand.cpp
+ *
+ *  Created on: 19.10.2026
+ *      Author: nopper
+ */
+
+#include "ImportConverter.h"
+
+#include "ImportConvertCommand.h"
+
+using namespace std;
+
+ImportConvertCommand::ImportConvertCommand(const ImportConvertCommandRecycleQueueSP& importConvertCommandRecycleQueue, const ThreadSafeCounterSP& jobCounter) :
+	Command(), importConvertCommandRecycleQueue(importConvertCommandRecycleQueue), jobCounter(jobCounter), importMesh(nullptr), importAnimationStack(nullptr)
+{
+}
+
+ImportConvertCommand::~ImportConvertCommand()
+{
+}
+
+bool ImportConvertCommand::execute()
+{
+	assert(this->jobCounter.get() != nullptr);
+	assert(this->importMesh != nullptr || this->importAnimationStack != nullptr);
+
+	ImportConverter importConverter;
+
+	if (importMesh)
+	{
+		importConverter.convertMesh(*importMesh);
+	}
+	else
+	{
+		importConverter.convertAnimationStack(*importAnimationStack);
+	}
+
+	importMesh = nullptr;
+	importAnimationStack = nullptr;
+
+	jobCounter->decrement();
+
+	return true;
+}
+
+void ImportConvertCommand::recycle()
+{
+	importMesh = nullptr;
+	importAnimationStack = nullptr;
+
+	importConvertCommandRecycleQueue->add(this);
+}
+
+void ImportConvertCommand::init(ImportMesh* importMesh)
+{
+	assert(this->jobCounter.get() != nullptr);
+	assert(this->importMesh == nullptr && this->importAnimationStack == nullptr);
+
+	jobCounter->increment();
+
+	this->importMesh = importMesh;
+}
+
+void ImportConvertCommand::init(ImportAnimationStack* importAnimationStack)
+{
+	assert(this->jobCounter.get() != nullptr);
+	assert(this->importMesh == nullptr && this->importAnimationStack == nullptr);
+
+	jobCounter->increment();
+
+	this->importAnimationStack = importAnimationStack;
+}
@@ -0,0 +1,52 @@
+/*
+ * ImportConvertCommand.h
+ *
+ *  Created on: 19.10.2026
+ *      Author: nopper
+ */
+
+#ifndef IMPORTCONVERTCOMMAND_H_
+#define IMPORTCONVERTCOMMAND_H_
+
+#include "../../layer0/concurrency/ThreadSafeCounter.h"
+#include "../../layer1/command/Command.h"
+
+#include "ImportAnimation.h"
+#include "ImportMesh.h"
+
+/**
+ * Converts one mesh or one animation stack on a worker thread. The result is stored in the job itself.
+ */
+class ImportConvertCommand: public Command
+{
+
+	friend class ImportConverter;
+
+private:
+
+	std::shared_ptr<ThreadsafeQueue<ImportConvertCommand*> > importConvertCommandRecycleQueue;
+
+	ThreadSafeCounterSP jobCounter;
+
+	ImportMesh* importMesh;
+
+	ImportAnimationStack* importAnimationStack;
+
+	ImportConvertCommand(const std::shared_ptr<ThreadsafeQueue<ImportConvertCommand*> >& importConvertCommandRecycleQueue, const ThreadSafeCounterSP& jobCounter);
+	virtual ~ImportConvertCommand();
+
+public:
+
+	virtual bool execute();
+
+	virtual void recycle();
+
+	void init(ImportMesh* importMesh);
+
+	void init(ImportAnimationStack* importAnimationStack);
+
+};
+
+typedef std::shared_ptr<ThreadsafeQueue<ImportConvertCommand*> > ImportConvertCommandRecycleQueueSP;
+
+#endif /* IMPORTCONVERTCOMMAND_H_ */
@@ -0,0 +1,771 @@
+/*
+ * ImportConverter.cpp
+ *
+ *  Created on: 19.10.2026
+ *      Author: nopper
+ */
+
+#include "../../layer1/command/WorkerManager.h"
+#include "../animation/AnimationLayer.h"
+#include "../mesh/MeshFactory.h"
+
+#include "ImportConverter.h"
+
+using namespace std;
+
+static bool compareImportMeshSize(const ImportMesh* first, const ImportMesh* second)
+{
+	return first->polygonVertices.size() > second->polygonVertices.size();
+}
+
+static bool compareInfluence(const pair<float, int32_t>& first, const pair<float, int32_t>& second)
+{
+	if (first.first != second.first)
+	{
+		return first.first > second.first;
+	}
+
+	return first.second < second.second;
+}
+
+ImportConverter::ImportConverter() :
+	importConvertCommandRecycleQueue(), jobCounter()
+{
+}
+
+ImportConverter::~ImportConverter()
+{
+	if (!jobCounter.get())
+	{
+		return;
+	}
+
+	jobCounter->waitUntilZero();
+
+	ImportConvertCommand* currentCommand = nullptr;
+	bool available = importConvertCommandRecycleQueue->take(currentCommand);
+	while (available)
+	{
+		delete currentCommand;
+
+		available = importConvertCommandRecycleQueue->take(currentCommand);
+	}
+}
+
+void ImportConverter::triangulatePolygon(const float* controlPoints, const int32_t* corners, int32_t numberCorners, vector<int32_t>& triangles) const
+{
+	triangles.clear();
+
+	if (numberCorners < 3)
+	{
+		return;
+	}
+
+	vector<int32_t> remaining;
+
+	for (int32_t i = 0; i < numberCorners; i++)
+	{
+		remaining.push_back(i);
+	}
+
+	if (numberCorners > 3)
+	{
+		float normal[3] = { 0.0f, 0.0f, 0.0f };
+
+		for (int32_t i = 0; i < numberCorners; i++)
+		{
+			const float* a = &controlPoints[3 * corners[i]];
+			const float* b = &controlPoints[3 * corners[(i + 1) % numberCorners]];
+
+			normal[0] += (a[1] - b[1]) * (a[2] + b[2]);
+			normal[1] += (a[2] - b[2]) * (a[0] + b[0]);
+			normal[2] += (a[0] - b[0]) * (a[1] + b[1]);
+		}
+
+		// Project by dropping the largest axis of the normal. The sign of the normal keeps the winding.
+		int32_t axis = fabsf(normal[0]) > fabsf(normal[1]) ? (fabsf(normal[0]) > fabsf(normal[2]) ? 0 : 2) : (fabsf(normal[1]) > fabsf(normal[2]) ? 1 : 2);
+		int32_t u = (axis + 1) % 3;
+		int32_t v = (axis + 2) % 3;
+		float orientation = normal[axis] >= 0.0f ? 1.0f : -1.0f;
+
+		vector<float> points(2 * numberCorners);
+
+		for (int32_t i = 0; i < numberCorners; i++)
+		{
+			points[2 * i + 0] = controlPoints[3 * corners[i] + u];
+			points[2 * i + 1] = controlPoints[3 * corners[i] + v];
+		}
+
+		int32_t current = 1;
+		int32_t failedAttempts = 0;
+
+		while (normal[axis] != 0.0f && remaining.size() > 3)
+		{
+			int32_t size = static_cast<int32_t>(remaining.size());
+
+			if (failedAttempts >= size)
+			{
+				break;
+			}
+
+			current = current % size;
+
+			int32_t previous = remaining[(current + size - 1) % size];
+			int32_t middle = remaining[current];
+			int32_t next = remaining[(current + 1) % size];
+
+			const float* a = &points[2 * previous];
+			const float* b = &points[2 * middle];
+			const float* c = &points[2 * next];
+
+			bool ear = orientation * ((b[0] - a[0]) * (c[1] - a[1]) - (b[1] - a[1]) * (c[0] - a[0])) > 0.0f;
+
+			for (int32_t i = 0; ear && i < size; i++)
+			{
+				int32_t other = remaining[i];
+
+				if (other == previous || other == middle || other == next)
+				{
+					continue;
+				}
+
+				const float* p = &points[2 * other];
+
+				if (orientation * ((b[0] - a[0]) * (p[1] - a[1]) - (b[1] - a[1]) * (p[0] - a[0])) > 0.0f && orientation * ((c[0] - b[0]) * (p[1] - b[1]) - (c[1] - b[1]) * (p[0] - b[0])) > 0.0f && orientation * ((a[0] - c[0]) * (p[1] - c[1]) - (a[1] - c[1]) * (p[0] - c[0])) > 0.0f)
+				{
+					ear = false;
+				}
+			}
+
+			if (!ear)
+			{
+				current++;
+				failedAttempts++;
+
+				continue;
+			}
+
+			triangles.push_back(previous);
+			triangles.push_back(middle);
+			triangles.push_back(next);
+
+			remaining.erase(remaining.begin() + current);
+
+			failedAttempts = 0;
+		}
+	}
+
+	// Either a triangle is left or the polygon is degenerated.
+	for (uint32_t i = 1; i + 1 < remaining.size(); i++)
+	{
+		triangles.push_back(remaining[0]);
+		triangles.push_back(remaining[i]);
+		triangles.push_back(remaining[i + 1]);
+	}
+}
+
+bool ImportConverter::calculateTangents(ImportMesh& importMesh) const
+{
+	if (!importMesh.texCoords)
+	{
+		return false;
+	}
+
+	if (!importMesh.tangents)
+	{
+		importMesh.tangents = new float[importMesh.numberVertices * 3];
+	}
+	if (!importMesh.bitangents)
+	{
+		importMesh.bitangents = new float[importMesh.numberVertices * 3];
+	}
+
+	GLUSshape meshShape;
+	meshShape.mode = GL_TRIANGLES;
+	meshShape.numberVertices = importMesh.numberVertices;
+	meshShape.vertices = importMesh.vertices;
+	meshShape.normals = importMesh.normals;
+	meshShape.bitangents = importMesh.bitangents;
+	meshShape.tangents = importMesh.tangents;
+	meshShape.texCoords = importMesh.texCoords;
+	meshShape.numberIndices = importMesh.numberIndices;
+	meshShape.indices = importMesh.indices;
+	meshShape.allAttributes = 0;
+
+	return glusShapeCalculateTangentBitangentf(&meshShape) == GLUS_TRUE;
+}
+
+bool ImportConverter::calculateSkinning(ImportMesh& importMesh, const vector<int32_t>& vertexToControlPoint) const
+{
+	uint32_t numberControlPoints = static_cast<uint32_t>(importMesh.controlPoints.size() / 3);
+
+	// Gather the influences of each control point.
+	vector<uint32_t> influenceStarts(numberControlPoints + 1, 0);
+
+	for (auto& currentCluster : importMesh.skinClusters)
+	{
+		uint32_t count = static_cast<uint32_t>(min(currentCluster.controlPointIndices.size(), currentCluster.weights.size()));
+
+		for (uint32_t i = 0; i < count; i++)
+		{
+			int32_t controlPointIndex = currentCluster.controlPointIndices[i];
+
+			if (controlPointIndex >= 0 && static_cast<uint32_t>(controlPointIndex) < numberControlPoints && currentCluster.weights[i] > 0.0f)
+			{
+				influenceStarts[controlPointIndex + 1]++;
+			}
+		}
+	}
+
+	for (uint32_t i = 0; i < numberControlPoints; i++)
+	{
+		influenceStarts[i + 1] += influenceStarts[i];
+	}
+
+	vector<pair<float, int32_t> > allInfluences(influenceStarts[numberControlPoints]);
+	vector<uint32_t> influenceEnds(influenceStarts.begin(), influenceStarts.end() - 1);
+
+	for (uint32_t slot = 0; slot < importMesh.skinClusters.size(); slot++)
+	{
+		const ImportSkinCluster& currentCluster = importMesh.skinClusters[slot];
+
+		uint32_t count = static_cast<uint32_t>(min(currentCluster.controlPointIndices.size(), currentCluster.weights.size()));
+
+		for (uint32_t i = 0; i < count; i++)
+		{
+			int32_t controlPointIndex = currentCluster.controlPointIndices[i];
+
+			if (controlPointIndex >= 0 && static_cast<uint32_t>(controlPointIndex) < numberControlPoints && currentCluster.weights[i] > 0.0f)
+			{
+				allInfluences[influenceEnds[controlPointIndex]++] = make_pair(currentCluster.weights[i], static_cast<int32_t>(slot));
+			}
+		}
+	}
+
+	// Keep the strongest influences and let their weights sum up to one.
+	uint32_t numberDropped = 0;
+
+	for (uint32_t i = 0; i < numberControlPoints; i++)
+	{
+		uint32_t count = influenceStarts[i + 1] - influenceStarts[i];
+
+		if (count == 0)
+		{
+			continue;
+		}
+
+		sort(allInfluences.begin() + influenceStarts[i], allInfluences.begin() + influenceStarts[i + 1], compareInfluence);
+
+		if (count > MAX_SKIN_INDICES)
+		{
+			numberDropped++;
+
+			count = MAX_SKIN_INDICES;
+		}
+
+		float sum = 0.0f;
+
+		for (uint32_t k = 0; k < count; k++)
+		{
+			sum += allInfluences[influenceStarts[i] + k].first;
+		}
+
+		for (uint32_t k = 0; k < count; k++)
+		{
+			allInfluences[influenceStarts[i] + k].first /= sum;
+		}
+
+		influenceEnds[i] = influenceStarts[i] + count;
+	}
+
+	if (numberDropped > 0)
+	{
+		glusLogPrint(GLUS_LOG_WARNING, "Mesh %s has %u control points with more than %d influences", importMesh.name.c_str(), numberDropped, MAX_SKIN_INDICES);
+	}
+
+	uint32_t numberVertices = importMesh.numberVertices;
+
+	importMesh.boneIndices0 = new float[4 * numberVertices];
+	importMesh.boneIndices1 = new float[4 * numberVertices];
+	importMesh.boneWeights0 = new float[4 * numberVertices];
+	importMesh.boneWeights1 = new float[4 * numberVertices];
+	importMesh.boneCounters = new float[numberVertices];
+
+	memset(importMesh.boneIndices0, 0, 4 * numberVertices * sizeof(float));
+	memset(importMesh.boneIndices1, 0, 4 * numberVertices * sizeof(float));
+	memset(importMesh.boneWeights0, 0, 4 * numberVertices * sizeof(float));
+	memset(importMesh.boneWeights1, 0, 4 * numberVertices * sizeof(float));
+
+	for (uint32_t i = 0; i < numberVertices; i++)
+	{
+		int32_t controlPointIndex = vertexToControlPoint[i];
+
+		uint32_t count = influenceEnds[controlPointIndex] - influenceStarts[controlPointIndex];
+
+		for (uint32_t k = 0; k < count; k++)
+		{
+			const pair<float, int32_t>& currentInfluence = allInfluences[influenceStarts[controlPointIndex] + k];
+
+			if (k < 4)
+			{
+				importMesh.boneIndices0[4 * i + k] = static_cast<float>(currentInfluence.second);
+				importMesh.boneWeights0[4 * i + k] = currentInfluence.first;
+			}
+			else
+			{
+				importMesh.boneIndices1[4 * i + k - 4] = static_cast<float>(currentInfluence.second);
+				importMesh.boneWeights1[4 * i + k - 4] = currentInfluence.first;
+			}
+		}
+
+		importMesh.boneCounters[i] = static_cast<float>(count);
+	}
+
+	return true;
+}
+
+float ImportConverter::applyLimits(const ImportAnimationLimits& limits, int32_t channel, float value)
+{
+	if (limits.minActive[channel] && value < limits.minimum[channel])
+	{
+		value = limits.minimum[channel];
+	}
+
+	if (limits.maxActive[channel] && value > limits.maximum[channel])
+	{
+		value = limits.maximum[channel];
+	}
+
+	return value;
+}
+
+void ImportConverter::sendCommand(ImportConvertCommand* currentCommand) const
+{
+	WorkerManager::getInstance()->sendCommand(currentCommand);
+}
+
+bool ImportConverter::convertMesh(ImportMesh& importMesh) const
+{
+	importMesh.success = false;
+
+	uint32_t numberControlPoints = static_cast<uint32_t>(importMesh.controlPoints.size() / 3);
+	uint32_t numberPolygons = static_cast<uint32_t>(importMesh.polygonSizes.size());
+	uint32_t numberCorners = 0;
+
+	bool valid = importMesh.controlPoints.size() % 3 == 0 && (importMesh.polygonMaterials.size() == 0 || importMesh.polygonMaterials.size() == numberPolygons);
+
+	for (uint32_t i = 0; valid && i < numberPolygons; i++)
+	{
+		valid = importMesh.polygonSizes[i] >= 0;
+
+		numberCorners += static_cast<uint32_t>(importMesh.polygonSizes[i]);
+	}
+
+	valid = valid && numberCorners == importMesh.polygonVertices.size();
+
+	for (uint32_t i = 0; valid && i < numberCorners; i++)
+	{
+		valid = importMesh.polygonVertices[i] >= 0 && static_cast<uint32_t>(importMesh.polygonVertices[i]) < numberControlPoints;
+	}
+
+	if (importMesh.inputNormals.size() > 0)
+	{
+		valid = valid && importMesh.inputNormals.size() == 3 * (importMesh.normalsByControlPoint ? numberControlPoints : numberCorners);
+	}
+	if (importMesh.inputTexCoords.size() > 0)
+	{
+		valid = valid && importMesh.inputTexCoords.size() == 2 * (importMesh.texCoordsByControlPoint ? numberControlPoints : numberCorners);
+	}
+	if (importMesh.inputTangents.size() > 0)
+	{
+		valid = valid && importMesh.inputTangents.size() == 3 * numberControlPoints;
+	}
+	if (importMesh.inputBitangents.size() > 0)
+	{
+		valid = valid && importMesh.inputBitangents.size() == 3 * numberControlPoints;
+	}
+
+	if (!valid)
+	{
+		glusLogPrint(GLUS_LOG_ERROR, "Invalid mesh data: %s", importMesh.name.c_str());
+
+		return false;
+	}
+
+	// Triangulation
+
+	vector<int32_t> allTriangles;
+	vector<int32_t> allTriangleMaterials;
+	vector<int32_t> polygonTriangles;
+
+	map<int32_t, uint32_t> triangleCounts;
+
+	uint32_t cornerOffset = 0;
+
+	for (uint32_t i = 0; i < numberPolygons; i++)
+	{
+		int32_t materialIndex = importMesh.polygonMaterials.size() > 0 ? max(importMesh.polygonMaterials[i], 0) : 0;
+
+		triangulatePolygon(importMesh.controlPoints.data(), importMesh.polygonVertices.data() + cornerOffset, importMesh.polygonSizes[i], polygonTriangles);
+
+		for (uint32_t k = 0; k < polygonTriangles.size(); k += 3)
+		{
+			allTriangles.push_back(static_cast<int32_t>(cornerOffset) + polygonTriangles[k + 0]);
+			allTriangles.push_back(static_cast<int32_t>(cornerOffset) + polygonTriangles[k + 1]);
+			allTriangles.push_back(static_cast<int32_t>(cornerOffset) + polygonTriangles[k + 2]);
+
+			allTriangleMaterials.push_back(materialIndex);
+
+			triangleCounts[materialIndex]++;
+		}
+
+		cornerOffset += static_cast<uint32_t>(importMesh.polygonSizes[i]);
+	}
+
+	if (allTriangles.size() == 0)
+	{
+		glusLogPrint(GLUS_LOG_WARNING, "Mesh %s has no triangles", importMesh.name.c_str());
+
+		return false;
+	}
+
+	// Sub meshes, ordered by the material index.
+
+	map<int32_t, uint32_t> storedIndices;
+
+	uint32_t indexOffset = 0;
+
+	for (auto& currentTriangleCount : triangleCounts)
+	{
+		importMesh.subMeshes[currentTriangleCount.first] = SubMeshSP(new SubMesh(indexOffset, currentTriangleCount.second));
+
+		storedIndices[currentTriangleCount.first] = indexOffset;
+
+		indexOffset += currentTriangleCount.second * 3;
+	}
+
+	// Vertices. Control points can only be shared, if no attribute differs per polygon corner.
+
+	bool allByControlPoint = (importMesh.inputNormals.size() == 0 || importMesh.normalsByControlPoint) && (importMesh.inputTexCoords.size() == 0 || importMesh.texCoordsByControlPoint);
+
+	importMesh.numberVertices = allByControlPoint ? numberControlPoints : numberCorners;
+
+	vector<int32_t> vertexToControlPoint(importMesh.numberVertices);
+
+	for (uint32_t i = 0; i < importMesh.numberVertices; i++)
+	{
+		vertexToControlPoint[i] = allByControlPoint ? static_cast<int32_t>(i) : importMesh.polygonVertices[i];
+	}
+
+	importMesh.vertices = new float[importMesh.numberVertices * 4];
+
+	for (uint32_t i = 0; i < importMesh.numberVertices; i++)
+	{
+		const float* controlPoint = &importMesh.controlPoints[3 * vertexToControlPoint[i]];
+
+		importMesh.vertices[i * 4 + 0] = controlPoint[0];
+		importMesh.vertices[i * 4 + 1] = controlPoint[1];
+		importMesh.vertices[i * 4 + 2] = controlPoint[2];
+		importMesh.vertices[i * 4 + 3] = 1.0f;
+	}
+
+	if (importMesh.inputNormals.size() > 0)
+	{
+		importMesh.normals = new float[importMesh.numberVertices * 3];
+
+		for (uint32_t i = 0; i < importMesh.numberVertices; i++)
+		{
+			uint32_t sourceIndex = importMesh.normalsByControlPoint ? static_cast<uint32_t>(vertexToControlPoint[i]) : i;
+
+			importMesh.normals[i * 3 + 0] = importMesh.inputNormals[sourceIndex * 3 + 0];
+			importMesh.normals[i * 3 + 1] = importMesh.inputNormals[sourceIndex * 3 + 1];
+			importMesh.normals[i * 3 + 2] = importMesh.inputNormals[sourceIndex * 3 + 2];
+		}
+	}
+
+	if (importMesh.inputTexCoords.size() > 0)
+	{
+		importMesh.texCoords = new float[importMesh.numberVertices * 2];
+
+		for (uint32_t i = 0; i < importMesh.numberVertices; i++)
+		{
+			uint32_t sourceIndex = importMesh.texCoordsByControlPoint ? static_cast<uint32_t>(vertexToControlPoint[i]) : i;
+
+			importMesh.texCoords[i * 2 + 0] = importMesh.inputTexCoords[sourceIndex * 2 + 0];
+			importMesh.texCoords[i * 2 + 1] = importMesh.inputTexCoords[sourceIndex * 2 + 1];
+		}
+	}
+
+	if (allByControlPoint && importMesh.inputTangents.size() > 0)
+	{
+		importMesh.tangents = new float[importMesh.numberVertices * 3];
+
+		memcpy(importMesh.tangents, &importMesh.inputTangents[0], importMesh.numberVertices * 3 * sizeof(float));
+
+		if (importMesh.inputBitangents.size() > 0)
+		{
+			importMesh.bitangents = new float[importMesh.numberVertices * 3];
+
+			memcpy(importMesh.bitangents, &importMesh.inputBitangents[0], importMesh.numberVertices * 3 * sizeof(float));
+		}
+	}
+
+	// Indices, with the triangles of the same material stored together.
+
+	importMesh.numberIndices = static_cast<uint32_t>(allTriangles.size());
+	importMesh.indices = new uint32_t[importMesh.numberIndices];
+
+	for (uint32_t i = 0; i < allTriangleMaterials.size(); i++)
+	{
+		uint32_t& currentOffset = storedIndices[allTriangleMaterials[i]];
+
+		for (uint32_t k = 0; k < 3; k++)
+		{
+			int32_t corner = allTriangles[i * 3 + k];
+
+			importMesh.indices[currentOffset + k] = allByControlPoint ? static_cast<uint32_t>(importMesh.polygonVertices[corner]) : static_cast<uint32_t>(corner);
+		}
+
+		currentOffset += 3;
+	}
+
+	if (importMesh.skinClusters.size() > 0)
+	{
+		calculateSkinning(importMesh, vertexToControlPoint);
+	}
+
+	MeshFactory meshFactory;
+
+	// Corners with equal attributes become one vertex again. Done before the tangents, so these are averaged over the merged corners.
+	if (importMesh.weldEpsilon >= 0.0f)
+	{
+		importMesh.numberVertices = meshFactory.weldVertices(importMesh.name, importMesh.numberVertices, importMesh.vertices, importMesh.normals, importMesh.bitangents, importMesh.tangents, importMesh.texCoords, importMesh.boneIndices0, importMesh.boneIndices1, importMesh.boneWeights0, importMesh.boneWeights1, importMesh.boneCounters, importMesh.numberIndices, importMesh.indices, importMesh.weldEpsilon);
+	}
+
+	// Create tangents and bitangents when not already created
+	if (!importMesh.tangents && !calculateTangents(importMesh))
+	{
+		delete[] importMesh.tangents;
+		importMesh.tangents = nullptr;
+
+		delete[] importMesh.bitangents;
+		importMesh.bitangents = nullptr;
+	}
+
+	meshFactory.optimizeMesh(importMesh.name, importMesh.numberVertices, importMesh.vertices, importMesh.normals, importMesh.bitangents, importMesh.tangents, importMesh.texCoords, importMesh.boneIndices0, importMesh.boneIndices1, importMesh.boneWeights0, importMesh.boneWeights1, importMesh.boneCounters, importMesh.numberIndices, importMesh.indices, importMesh.subMeshes, true, true);
+
+	if (importMesh.numberLods > 1)
+	{
+		vector<uint32_t> allIndices;
+
+		if (meshFactory.createLods(importMesh.name, importMesh.numberVertices, importMesh.vertices, importMesh.normals, importMesh.texCoords, importMesh.numberIndices, importMesh.indices, importMesh.subMeshes, importMesh.numberLods, importMesh.lodReduction, allIndices) && allIndices.size() != importMesh.numberIndices)
+		{
+			delete[] importMesh.indices;
+
+			importMesh.numberIndices = static_cast<uint32_t>(allIndices.size());
+			importMesh.indices = new uint32_t[importMesh.numberIndices];
+			memcpy(importMesh.indices, &allIndices[0], importMesh.numberIndices * sizeof(uint32_t));
+		}
+	}
+
+	importMesh.success = true;
+
+	return true;
+}
+
+bool ImportConverter::convertAnimationStack(ImportAnimationStack& importAnimationStack) const
+{
+	AnimationStack* newAnimationStack = new AnimationStack(importAnimationStack.name, importAnimationStack.startTime, importAnimationStack.stopTime);
+
+	for (auto& currentLayer : importAnimationStack.layers)
+	{
+		AnimationLayerSP newAnimationLayer = AnimationLayerSP(new AnimationLayer());
+
+		for (int32_t k = 0; k < 3; k++)
+		{
+			enum AnimationLayer::eCHANNELS_XYZ currentChannel = static_cast<enum AnimationLayer::eCHANNELS_XYZ>(k);
+
+			// Translation
+			const ImportAnimationCurve& translationCurve = currentLayer.translation[k];
+
+			for (uint32_t m = 0; m < translationCurve.interpolators.size() && m < translationCurve.times.size() && m < translationCurve.values.size(); m++)
+			{
+				if (translationCurve.interpolators[m])
+				{
+					newAnimationLayer->addTranslationValue(currentChannel, translationCurve.times[m], applyLimits(importAnimationStack.translationLimits, k, translationCurve.values[m]), *translationCurve.interpolators[m]);
+				}
+			}
+
+			// Rotation
+			const ImportAnimationCurve& rotationCurve = currentLayer.rotation[k];
+
+			for (uint32_t m = 0; m < rotationCurve.interpolators.size() && m < rotationCurve.times.size() && m < rotationCurve.values.size(); m++)
+			{
+				if (rotationCurve.interpolators[m])
+				{
+					newAnimationLayer->addRotationValue(currentChannel, rotationCurve.times[m], applyLimits(importAnimationStack.rotationLimits, k, rotationCurve.values[m]), *rotationCurve.interpolators[m]);
+				}
+			}
+
+			// Scaling
+			const ImportAnimationCurve& scalingCurve = currentLayer.scaling[k];
+
+			for (uint32_t m = 0; m < scalingCurve.interpolators.size() && m < scalingCurve.times.size() && m < scalingCurve.values.size(); m++)
+			{
+				if (scalingCurve.interpolators[m])
+				{
+					newAnimationLayer->addScalingValue(currentChannel, scalingCurve.times[m], applyLimits(importAnimationStack.scalingLimits, k, scalingCurve.values[m]), *scalingCurve.interpolators[m]);
+				}
+			}
+		}
+
+		newAnimationStack->addAnimationLayer(newAnimationLayer);
+	}
+
+	importAnimationStack.animationStack = AnimationStackSP(newAnimationStack);
+
+	return true;
+}
+
+void ImportConverter::convert(const vector<ImportMeshSP>& allImportMeshes, const vector<ImportAnimationStackSP>& allImportAnimationStacks)
+{
+	// The largest meshes are started first, so they do not end up last on a single worker.
+	vector<ImportMesh*> sortedImportMeshes;
+
+	for (auto& currentImportMesh : allImportMeshes)
+	{
+		sortedImportMeshes.push_back(currentImportMesh.get());
+	}
+
+	stable_sort(sortedImportMeshes.begin(), sortedImportMeshes.end(), compareImportMeshSize);
+
+	if (WorkerManager::getInstance()->getNumberWorkers() == 0)
+	{
+		for (auto currentImportMesh : sortedImportMeshes)
+		{
+			convertMesh(*currentImportMesh);
+		}
+
+		for (auto& currentImportAnimationStack : allImportAnimationStacks)
+		{
+			convertAnimationStack(*currentImportAnimationStack);
+		}
+
+		return;
+	}
+
+	if (!jobCounter.get())
+	{
+		importConvertCommandRecycleQueue = ImportConvertCommandRecycleQueueSP(new ThreadsafeQueue<ImportConvertCommand*>());
+		jobCounter = ThreadSafeCounterSP(new ThreadSafeCounter());
+	}
+
+	ImportConvertCommand* currentCommand = nullptr;
+
+	for (auto currentImportMesh : sortedImportMeshes)
+	{
+		if (!importConvertCommandRecycleQueue->take(currentCommand))
+		{
+			currentCommand = new ImportConvertCommand(importConvertCommandRecycleQueue, jobCounter);
+		}
+
+		currentCommand->init(currentImportMesh);
+
+		sendCommand(currentCommand);
+	}
+
+	for (auto& currentImportAnimationStack : allImportAnimationStacks)
+	{
+		if (!importConvertCommandRecycleQueue->take(currentCommand))
+		{
+			currentCommand = new ImportConvertCommand(importConvertCommandRecycleQueue, jobCounter);
+		}
+
+		currentCommand->init(currentImportAnimationStack.get());
+
+		sendCommand(currentCommand);
+	}
+
+	jobCounter->waitUntilZero();
+}
+
+MeshSP ImportConverter::createMesh(ImportMesh& importMesh) const
+{
+	if (!importMesh.success)
+	{
+		return MeshSP();
+	}
+
+	MeshSP mesh = MeshSP(new Mesh(importMesh.name, importMesh.numberVertices, importMesh.vertices, importMesh.normals, importMesh.bitangents, importMesh.tangents, importMesh.texCoords, importMesh.numberIndices, importMesh.indices, importMesh.subMeshes, importMesh.surfaceMaterials));
+
+	// Now owned by the mesh.
+	importMesh.vertices = nullptr;
+	importMesh.normals = nullptr;
+	importMesh.bitangents = nullptr;
+	importMesh.tangents = nullptr;
+	importMesh.texCoords = nullptr;
+	importMesh.indices = nullptr;
+
+	glusLogPrint(GLUS_LOG_INFO, "Created mesh: %s", importMesh.name.c_str());
+
+	return mesh;
+}
+
+bool ImportConverter::addSkinningData(ImportMesh& importMesh, const vector<int32_t>& jointIndices, const MeshSP& mesh) const
+{
+	if (!mesh.get() || !importMesh.boneCounters || jointIndices.size() != importMesh.skinClusters.size())
+	{
+		return false;
+	}
+
+	for (uint32_t i = 0; i < importMesh.numberVertices; i++)
+	{
+		int32_t count = static_cast<int32_t>(importMesh.boneCounters[i]);
+
+		bool removed = false;
+		float sum = 0.0f;
+
+		for (int32_t k = 0; k < count; k++)
+		{
+			float& boneIndex = k < 4 ? importMesh.boneIndices0[4 * i + k] : importMesh.boneIndices1[4 * i + k - 4];
+			float& boneWeight = k < 4 ? importMesh.boneWeights0[4 * i + k] : importMesh.boneWeights1[4 * i + k - 4];
+
+			int32_t jointIndex = jointIndices[static_cast<int32_t>(boneIndex)];
+
+			if (jointIndex < 0)
+			{
+				boneIndex = 0.0f;
+				boneWeight = 0.0f;
+
+				removed = true;
+			}
+			else
+			{
+				boneIndex = static_cast<float>(jointIndex);
+
+				sum += boneWeight;
+			}
+		}
+
+		if (removed && sum > 0.0f)
+		{
+			for (int32_t k = 0; k < count; k++)
+			{
+				float& boneWeight = k < 4 ? importMesh.boneWeights0[4 * i + k] : importMesh.boneWeights1[4 * i + k - 4];
+
+				boneWeight /= sum;
+			}
+		}
+	}
+
+	mesh->addSkinningData(importMesh.boneIndices0, importMesh.boneIndices1, importMesh.boneWeights0, importMesh.boneWeights1, importMesh.boneCounters);
+
+	// Now owned by the mesh.
+	importMesh.boneIndices0 = nullptr;
+	importMesh.boneIndices1 = nullptr;
+	importMesh.boneWeights0 = nullptr;
+	importMesh.boneWeights1 = nullptr;
+	importMesh.boneCounters = nullptr;
+
+	return true;
+}
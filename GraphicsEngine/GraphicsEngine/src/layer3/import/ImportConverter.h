@@ -0,0 +1,88 @@
+/*
+ * ImportConverter.h
+ *
+ *  Created on: 19.10.2026
+ *      Author: nopper
+ */
+
+#ifndef IMPORTCONVERTER_H_
+#define IMPORTCONVERTER_H_
+
+#include "../../UsedLibs.h"
+
+#include "../mesh/Mesh.h"
+#include "ImportConvertCommand.h"
+
+/**
+ * Second phase of an import. The file is read serially into mesh and animation jobs, which are converted here in parallel
+ * on the worker threads. As each result stays in its job, the merge into the node tree does not depend on the order the
+ * workers finish in.
+ */
+class ImportConverter
+{
+
+private:
+
+	ImportConvertCommandRecycleQueueSP importConvertCommandRecycleQueue;
+
+	ThreadSafeCounterSP jobCounter;
+
+	/**
+	 * Ear clipping in the plane of the Newell normal. Falls back to a fan for degenerated polygons.
+	 *
+	 * @param corners Control point index of each corner.
+	 * @param triangles Receives the triangles as positions in the corners.
+	 */
+	void triangulatePolygon(const float* controlPoints, const std::int32_t* corners, std::int32_t numberCorners, std::vector<std::int32_t>& triangles) const;
+
+	bool calculateTangents(ImportMesh& importMesh) const;
+
+	/**
+	 * Keeps the strongest influences of each control point and normalizes their weights.
+	 */
+	bool calculateSkinning(ImportMesh& importMesh, const std::vector<std::int32_t>& vertexToControlPoint) const;
+
+	static float applyLimits(const ImportAnimationLimits& limits, std::int32_t channel, float value);
+
+	void sendCommand(ImportConvertCommand* currentCommand) const;
+
+public:
+
+	ImportConverter();
+	virtual ~ImportConverter();
+
+	/**
+	 * Triangulates the polygons, creates the vertices, sub meshes and skinning data, welds the vertices and creates the
+	 * tangents and levels of detail. Does not need a context.
+	 */
+	bool convertMesh(ImportMesh& importMesh) const;
+
+	/**
+	 * Creates the animation stack with the limits applied. Does not need a context.
+	 */
+	bool convertAnimationStack(ImportAnimationStack& importAnimationStack) const;
+
+	/**
+	 * Converts all jobs, the largest meshes first, and waits until all are done. Without workers, the jobs are converted
+	 * on the calling thread.
+	 */
+	void convert(const std::vector<ImportMeshSP>& allImportMeshes, const std::vector<ImportAnimationStackSP>& allImportAnimationStacks);
+
+	/**
+	 * Hands the converted data over to a new mesh. Needs a context.
+	 *
+	 * @return Empty, if the conversion failed.
+	 */
+	MeshSP createMesh(ImportMesh& importMesh) const;
+
+	/**
+	 * Replaces the cluster positions by the joint indices and hands the skinning data over to the mesh. Influences of
+	 * joints with a negative index are removed. Needs a context.
+	 *
+	 * @param jointIndices Joint index of each skin cluster.
+	 */
+	bool addSkinningData(ImportMesh& importMesh, const std::vector<std::int32_t>& jointIndices, const MeshSP& mesh) const;
+
+};
+
+#endif /* IMPORTCONVERTER_H_ */
@@ -0,0 +1,135 @@
+/*
+ * ImportMesh.h
+ *
+ *  Created on: 19.10.2026
+ *      Author: nopper
+ */
+
+#ifndef IMPORTMESH_H_
+#define IMPORTMESH_H_
+
+#include "../../UsedLibs.h"
+
+#include "../../layer0/math/Matrix4x4.h"
+#include "../../layer2/material/SurfaceMaterial.h"
+#include "../mesh/SubMesh.h"
+
+/**
+ * Influence of one joint on a set of control points.
+ */
+struct ImportSkinCluster
+{
+	std::string jointName;
+
+	Matrix4x4 inverseBindMatrix;
+
+	std::vector<std::int32_t> controlPointIndices;
+
+	std::vector<float> weights;
+};
+
+/**
+ * Mesh as read from a file, with polygons of any size. The converter triangulates it and creates the vertex attributes,
+ * the tangents and the skinning data without a context.
+ */
+struct ImportMesh
+{
+	std::string name;
+
+	// Three floats per control point.
+	std::vector<float> controlPoints;
+
+	// Number of corners of each polygon.
+	std::vector<std::int32_t> polygonSizes;
+
+	// Control point index of each polygon corner.
+	std::vector<std::int32_t> polygonVertices;
+
+	// Material index of each polygon. Empty, if all polygons use the material zero.
+	std::vector<std::int32_t> polygonMaterials;
+
+	// Three floats per control point or per polygon corner.
+	std::vector<float> inputNormals;
+
+	bool normalsByControlPoint;
+
+	// Three floats per control point. Only used, if all attributes are given by control point.
+	std::vector<float> inputTangents;
+
+	std::vector<float> inputBitangents;
+
+	// Two floats per control point or per polygon corner.
+	std::vector<float> inputTexCoords;
+
+	bool texCoordsByControlPoint;
+
+	std::vector<ImportSkinCluster> skinClusters;
+
+	std::uint32_t numberLods;
+
+	float lodReduction;
+
+	// Largest difference of the attribute values of two vertices, which are merged. Negative disables the welding.
+	float weldEpsilon;
+
+	std::map<std::int32_t, SurfaceMaterialSP> surfaceMaterials;
+
+	// Filled by the converter.
+
+	bool success;
+
+	std::uint32_t numberVertices;
+
+	float* vertices;
+	float* normals;
+	float* bitangents;
+	float* tangents;
+	float* texCoords;
+
+	std::uint32_t numberIndices;
+
+	std::uint32_t* indices;
+
+	std::map<std::int32_t, SubMeshSP> subMeshes;
+
+	// The bone indices are the positions in the skin clusters until the joints are known.
+	float* boneIndices0;
+	float* boneIndices1;
+	float* boneWeights0;
+	float* boneWeights1;
+	float* boneCounters;
+
+	ImportMesh() :
+		name(), controlPoints(), polygonSizes(), polygonVertices(), polygonMaterials(), inputNormals(), normalsByControlPoint(true), inputTangents(), inputBitangents(), inputTexCoords(), texCoordsByControlPoint(true), skinClusters(), numberLods(1), lodReduction(0.5f), weldEpsilon(0.0f), surfaceMaterials(), success(false), numberVertices(0), vertices(nullptr), normals(nullptr), bitangents(nullptr), tangents(nullptr), texCoords(nullptr), numberIndices(0), indices(nullptr), subMeshes(), boneIndices0(nullptr), boneIndices1(nullptr), boneWeights0(nullptr), boneWeights1(nullptr), boneCounters(nullptr)
+	{
+	}
+
+	/**
+	 * Deletes the converted data, which has not been handed over to a mesh.
+	 */
+	~ImportMesh()
+	{
+		delete[] vertices;
+		delete[] normals;
+		delete[] bitangents;
+		delete[] tangents;
+		delete[] texCoords;
+		delete[] indices;
+		delete[] boneIndices0;
+		delete[] boneIndices1;
+		delete[] boneWeights0;
+		delete[] boneWeights1;
+		delete[] boneCounters;
+	}
+
+private:
+
+	ImportMesh(const ImportMesh& other);
+
+	ImportMesh& operator=(const ImportMesh& other);
+
+};
+
+typedef std::shared_ptr<ImportMesh> ImportMeshSP;
+
+#endif /* IMPORTMESH_H_ */
@@ -6,6 +6,7 @@
  */
 
 #include "../../layer1/shader/ProgramFactory.h"
+#include "MeshFactory.h"
 #include "SubMeshVAO.h"
 
 #include "Mesh.h"
@@ -14,7 +15,7 @@ using namespace std;
 
 Mesh::Mesh(const string& name, uint32_t numberVertices, float* vertices, float* normals, float* bitangents, float* tangents, float* texCoords, uint32_t numberIndices, uint32_t* indices, const map<int32_t, SubMeshSP>& subMeshes, const map<int32_t, SurfaceMaterialSP>& surfaceMaterials) :
 	name(name), numberVertices(numberVertices), vertices(vertices), normals(normals), bitangents(bitangents), tangents(tangents), texCoords(texCoords), numberIndices(numberIndices), indices(indices), vboVertices(0),
-			vboNormals(0), vboTexCoords(0), vboIndices(0), boneIndices0(0), boneIndices1(0), boneWeights0(0), boneWeights1(0), boneCounters(0), subMeshes(subMeshes), surfaceMaterials(surfaceMaterials)
+			vboNormals(0), vboTexCoords(0), vboIndices(0), boneIndices0(0), boneIndices1(0), boneWeights0(0), boneWeights1(0), boneCounters(0), packed(false), packedVertexLayout(), vboPackedVertices(0), indexType(GL_UNSIGNED_INT), subMeshes(subMeshes), surfaceMaterials(surfaceMaterials)
 {
 	vboBoneIndices[0] = 0;
 	vboBoneIndices[1] = 0;
@@ -91,6 +92,8 @@ Mesh::~Mesh()
 	glDeleteBuffers(2, vboBoneWeights);
 	glDeleteBuffers(1, &vboBoneCounters);
 
+	glDeleteBuffers(1, &vboPackedVertices);
+
 	glDeleteBuffers(1, &vboIndices);
 }
 
@@ -124,6 +127,31 @@ void Mesh::updateVAO()
 	}
 }
 
+void Mesh::uploadIndices() const
+{
+	// The vertex array objects keep the buffer name, so only the content has to be replaced.
+	glBindVertexArray(0);
+
+	glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, vboIndices);
+
+	if (indexType == GL_UNSIGNED_SHORT)
+	{
+		MeshFactory meshFactory;
+
+		vector<uint16_t> shortIndices;
+
+		meshFactory.encodeShortIndices(indices, numberIndices, numberVertices, shortIndices);
+
+		glBufferData(GL_ELEMENT_ARRAY_BUFFER, numberIndices * sizeof(GLushort), shortIndices.data(), GL_STATIC_DRAW);
+	}
+	else
+	{
+		glBufferData(GL_ELEMENT_ARRAY_BUFFER, numberIndices * sizeof(GLuint), (GLuint*) indices, GL_STATIC_DRAW);
+	}
+
+	glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
+}
+
 void Mesh::cleanCpuData()
 {
 	if (vertices)
@@ -189,6 +217,157 @@ void Mesh::cleanCpuData()
 	}
 }
 
+bool Mesh::generateLods(uint32_t numberLods, float reduction)
+{
+	if (!vertices || !indices)
+	{
+		glusLogPrint(GLUS_LOG_WARNING, "Mesh %s has no CPU data for creating levels of detail", name.c_str());
+
+		return false;
+	}
+
+	MeshFactory meshFactory;
+
+	vector<uint32_t> allIndices;
+
+	if (!meshFactory.createLods(name, numberVertices, vertices, normals, texCoords, numberIndices, indices, subMeshes, numberLods, reduction, allIndices))
+	{
+		return false;
+	}
+
+	if (allIndices.size() == numberIndices)
+	{
+		return true;
+	}
+
+	delete[] indices;
+
+	numberIndices = static_cast<uint32_t>(allIndices.size());
+	indices = new uint32_t[numberIndices];
+	memcpy(indices, &allIndices[0], numberIndices * sizeof(uint32_t));
+
+	uploadIndices();
+
+	return true;
+}
+
+bool Mesh::packVertices()
+{
+	if (packed)
+	{
+		return true;
+	}
+
+	if (!vertices || !indices)
+	{
+		glusLogPrint(GLUS_LOG_WARNING, "Mesh %s has no CPU data for packing the vertices", name.c_str());
+
+		return false;
+	}
+
+	MeshFactory meshFactory;
+
+	packedVertexLayout = PackedVertexLayout(hasTangents(), hasTexCoords(), hasSkinning());
+
+	vector<uint8_t> packedVertices;
+
+	meshFactory.encodePackedVertices(packedVertexLayout, numberVertices, vertices, normals, bitangents, tangents, texCoords, boneIndices0, boneIndices1, boneWeights0, boneWeights1, boneCounters, packedVertices);
+
+	glBindVertexArray(0);
+
+	glGenBuffers(1, &vboPackedVertices);
+	glBindBuffer(GL_ARRAY_BUFFER, vboPackedVertices);
+	glBufferData(GL_ARRAY_BUFFER, packedVertices.size(), packedVertices.data(), GL_STATIC_DRAW);
+	glBindBuffer(GL_ARRAY_BUFFER, 0);
+
+	if (numberVertices <= 65536)
+	{
+		indexType = GL_UNSIGNED_SHORT;
+
+		uploadIndices();
+	}
+
+	glDeleteBuffers(1, &vboVertices);
+	glDeleteBuffers(1, &vboNormals);
+	glDeleteBuffers(1, &vboBitangents);
+	glDeleteBuffers(1, &vboTangents);
+	glDeleteBuffers(1, &vboTexCoords);
+
+	glDeleteBuffers(2, vboBoneIndices);
+	glDeleteBuffers(2, vboBoneWeights);
+	glDeleteBuffers(1, &vboBoneCounters);
+
+	vboVertices = 0;
+	vboNormals = 0;
+	vboBitangents = 0;
+	vboTangents = 0;
+	vboTexCoords = 0;
+
+	vboBoneIndices[0] = 0;
+	vboBoneIndices[1] = 0;
+	vboBoneWeights[0] = 0;
+	vboBoneWeights[1] = 0;
+	vboBoneCounters = 0;
+
+	packed = true;
+
+	updateVAO();
+
+	glusLogPrint(GLUS_LOG_DEBUG, "Mesh %s packed with %d bytes per vertex", name.c_str(), packedVertexLayout.getStride());
+
+	return true;
+}
+
+bool Mesh::isPacked() const
+{
+	return packed;
+}
+
+const PackedVertexLayout& Mesh::getPackedVertexLayout() const
+{
+	return packedVertexLayout;
+}
+
+GLuint Mesh::getVboPackedVertices() const
+{
+	return vboPackedVertices;
+}
+
+GLenum Mesh::getIndexType() const
+{
+	return indexType;
+}
+
+uint32_t Mesh::getIndexSize() const
+{
+	return indexType == GL_UNSIGNED_SHORT ? sizeof(GLushort) : sizeof(GLuint);
+}
+
+uint64_t Mesh::getMemorySize() const
+{
+	uint64_t result = static_cast<uint64_t>(numberIndices) * static_cast<uint64_t>(getIndexSize());
+
+	if (packed)
+	{
+		return result + static_cast<uint64_t>(numberVertices) * static_cast<uint64_t>(packedVertexLayout.getStride());
+	}
+
+	uint64_t componentsPerVertex = 0;
+
+	componentsPerVertex += vboVertices ? 4 : 0;
+	componentsPerVertex += vboNormals ? 3 : 0;
+	componentsPerVertex += vboBitangents ? 3 : 0;
+	componentsPerVertex += vboTangents ? 3 : 0;
+	componentsPerVertex += vboTexCoords ? 2 : 0;
+	componentsPerVertex += vboBoneIndices[0] ? 4 : 0;
+	componentsPerVertex += vboBoneIndices[1] ? 4 : 0;
+	componentsPerVertex += vboBoneWeights[0] ? 4 : 0;
+	componentsPerVertex += vboBoneWeights[1] ? 4 : 0;
+	componentsPerVertex += vboBoneCounters ? 1 : 0;
+
+	return result + static_cast<uint64_t>(numberVertices) * componentsPerVertex * sizeof(GLfloat);
+}
+
 const string& Mesh::getName() const
 {
 	return name;
@@ -355,16 +534,31 @@ void Mesh::addSkinningData(float* boneIndices0, float* boneIndices1, float* bone
 
 bool Mesh::hasSkinning() const
 {
+	if (packed)
+	{
+		return packedVertexLayout.hasSkinning();
+	}
+
 	return vboBoneIndices[0] != 0 && vboBoneIndices[1] != 0;
 }
 
 bool Mesh::hasTexCoords() const
 {
+	if (packed)
+	{
+		return packedVertexLayout.hasTexCoords();
+	}
+
 	return vboTexCoords != 0;
 }
 
 bool Mesh::hasTangents() const
 {
+	if (packed)
+	{
+		return packedVertexLayout.hasTangents();
+	}
+
 	return vboTangents != 0 && vboBitangents != 0;
 }
 
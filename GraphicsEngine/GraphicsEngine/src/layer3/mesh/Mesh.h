@@ -13,6 +13,7 @@
 #include "../../UsedLibs.h"
 
 #include "../../layer2/material/SurfaceMaterial.h"
+#include "PackedVertexLayout.h"
 #include "SubMesh.h"
 
 class Mesh
@@ -52,12 +53,20 @@ private:
 	GLuint vboBoneWeights[2];
 	GLuint vboBoneCounters;
 
+	bool packed;
+	PackedVertexLayout packedVertexLayout;
+	GLuint vboPackedVertices;
+
+	GLenum indexType;
+
 	std::map<std::int32_t, SubMeshSP> subMeshes;
 
 	std::map<std::int32_t, SurfaceMaterialSP> surfaceMaterials;
 
 	void updateVAO();
 
+	void uploadIndices() const;
+
 public:
 
 	Mesh(const std::string& name, std::uint32_t numberVertices, float* vertices, float* normals, float* bitangents, float* tangents, float* texCoords, std::uint32_t numberIndices, std::uint32_t* indices, const std::map<std::int32_t, SubMeshSP>& subMeshes, const std::map<std::int32_t, SurfaceMaterialSP>& surfaceMaterials);
@@ -65,6 +74,40 @@ public:
 
 	void cleanCpuData();
 
+	/**
+	 * Creates coarser levels of detail for each sub mesh by simplifying the triangles. The levels are appended to the index buffer
+	 * and share the vertices of the mesh. Needs the CPU data of the mesh.
+	 *
+	 * @param numberLods Total number of levels including the full resolution.
+	 * @param reduction Triangle count of a level relative to the previous one.
+	 */
+	bool generateLods(std::uint32_t numberLods, float reduction);
+
+	/**
+	 * Replaces the separate float buffers by one interleaved and quantized buffer. If possible, the indices are uploaded with 16 bit.
+	 * Needs the CPU data of the mesh, which is kept in full precision. Skinning data has to be added before.
+	 * Imported models are packed, if enabled with setPackVertices of the entity factories.
+	 */
+	bool packVertices();
+
+	bool isPacked() const;
+
+	const PackedVertexLayout& getPackedVertexLayout() const;
+
+	GLuint getVboPackedVertices() const;
+
+	/**
+	 * @return Either GL_UNSIGNED_INT or GL_UNSIGNED_SHORT for packed meshes.
+	 */
+	GLenum getIndexType() const;
+
+	std::uint32_t getIndexSize() const;
+
+	/**
+	 * @return Size in bytes of the vertex and index buffers in video memory.
+	 */
+	std::uint64_t getMemorySize() const;
+
 	const std::string& getName() const;
 
 	std::uint32_t getNumberVertices() const;
@@ -5,9 +5,11 @@
  *      Author: nopper
  */
 
+#include "../../layer0/math/Matrix3x3.h"
 #include "../../layer1/shader/Program.h"
 #include "../../layer1/shader/ProgramManager.h"
 #include "../../layer2/material/SurfaceMaterialFactory.h"
+#include "MeshSimplifier.h"
 #include "SubMeshVAO.h"
 
 #include "MeshFactory.h"
@@ -22,7 +24,23 @@ MeshFactory::~MeshFactory()
 {
 }
 
-MeshSP MeshFactory::createMesh(const string& name, const GLUSshape& shape, const SurfaceMaterialSP& surfaceMaterial) const
+void MeshFactory::compactVertices(const VertexWelder& vertexWelder, float*& data, uint32_t numberVertices, uint32_t numberWeldedVertices, uint32_t components, const vector<uint32_t>& remap) const
+{
+	if (!data)
+	{
+		return;
+	}
+
+	vertexWelder.compactVertices(data, numberVertices, components, remap);
+
+	float* weldedData = new float[numberWeldedVertices * components];
+	memcpy(weldedData, data, numberWeldedVertices * components * sizeof(float));
+
+	delete[] data;
+	data = weldedData;
+}
+
+MeshSP MeshFactory::createMesh(const string& name, GLUSshape& shape, const SurfaceMaterialSP& surfaceMaterial) const
 {
 	SurfaceMaterialFactory surfaceMaterialFactory;
 
@@ -32,7 +50,700 @@ MeshSP MeshFactory::createMesh(const string& name, const GLUSshape& shape, const
 	std::map<int32_t, SurfaceMaterialSP> surfaceMaterials;
 	surfaceMaterials[0] = surfaceMaterial;
 
+	optimizeMesh(name, shape.numberVertices, shape.vertices, shape.normals, shape.bitangents, shape.tangents, shape.texCoords, nullptr, nullptr, nullptr, nullptr, nullptr, shape.numberIndices, shape.indices, subMeshes, true, true);
+
 	MeshSP mesh = MeshSP(new Mesh(name, shape.numberVertices, shape.vertices, shape.normals, shape.bitangents, shape.tangents, shape.texCoords, shape.numberIndices, shape.indices, subMeshes, surfaceMaterials));
 
 	return mesh;
 }
+
+MeshSP MeshFactory::mergeMeshes(const string& name, const vector<pair<MeshSP, Matrix4x4> >& allParts, Point4& minimum, Point4& maximum) const
+{
+	uint32_t numberVertices = 0;
+
+	bool hasNormals = false;
+	bool hasTangents = false;
+	bool hasTexCoords = false;
+
+	vector<pair<MeshSP, Matrix4x4> >::const_iterator walker = allParts.begin();
+	while (walker != allParts.end())
+	{
+		const MeshSP& mesh = walker->first;
+
+		if (!mesh.get() || !mesh->getVertices() || !mesh->getIndices() || mesh->hasSkinning() || mesh->isPacked())
+		{
+			return MeshSP();
+		}
+
+		numberVertices += mesh->getNumberVertices();
+
+		hasNormals = hasNormals || mesh->getNormals();
+		hasTangents = hasTangents || (mesh->getBitangents() && mesh->getTangents());
+		hasTexCoords = hasTexCoords || mesh->getTexCoords();
+
+		walker++;
+	}
+
+	if (numberVertices == 0)
+	{
+		return MeshSP();
+	}
+
+	float* vertices = new float[numberVertices * 4];
+	float* normals = hasNormals ? new float[numberVertices * 3]() : nullptr;
+	float* bitangents = hasTangents ? new float[numberVertices * 3]() : nullptr;
+	float* tangents = hasTangents ? new float[numberVertices * 3]() : nullptr;
+	float* texCoords = hasTexCoords ? new float[numberVertices * 2]() : nullptr;
+
+	// Indices are gathered per surface material, in the order the materials are found.
+	vector<SurfaceMaterialSP> allSurfaceMaterials;
+	vector<vector<uint32_t> > allGroupIndices;
+
+	uint32_t baseVertex = 0;
+
+	walker = allParts.begin();
+	while (walker != allParts.end())
+	{
+		const Mesh& mesh = *walker->first;
+		const Matrix4x4& matrix = walker->second;
+
+		Matrix3x3 vectorMatrix = matrix.extractMatrix3x3();
+
+		Matrix3x3 normalMatrix = vectorMatrix;
+		normalMatrix.inverse();
+		normalMatrix.transpose();
+
+		const float* m = vectorMatrix.getM();
+
+		// Mirroring flips the winding of the triangles.
+		float determinant = m[0] * (m[4] * m[8] - m[7] * m[5]) - m[3] * (m[1] * m[8] - m[7] * m[2]) + m[6] * (m[1] * m[5] - m[4] * m[2]);
+
+		bool flip = determinant < 0.0f;
+
+		for (uint32_t i = 0; i < mesh.getNumberVertices(); i++)
+		{
+			uint32_t target = baseVertex + i;
+
+			Point4 vertex = matrix * Point4(mesh.getVertices() + i * 4);
+
+			for (int32_t k = 0; k < 4; k++)
+			{
+				vertices[target * 4 + k] = vertex.getP()[k];
+			}
+
+			if (mesh.getNormals())
+			{
+				Vector3 normal = (normalMatrix * Vector3(mesh.getNormals() + i * 3)).normalize();
+
+				memcpy(&normals[target * 3], normal.getV(), 3 * sizeof(float));
+			}
+
+			if (mesh.getBitangents() && mesh.getTangents() && hasTangents)
+			{
+				Vector3 bitangent = (vectorMatrix * Vector3(mesh.getBitangents() + i * 3)).normalize();
+				Vector3 tangent = (vectorMatrix * Vector3(mesh.getTangents() + i * 3)).normalize();
+
+				memcpy(&bitangents[target * 3], bitangent.getV(), 3 * sizeof(float));
+				memcpy(&tangents[target * 3], tangent.getV(), 3 * sizeof(float));
+			}
+
+			if (mesh.getTexCoords())
+			{
+				memcpy(&texCoords[target * 2], mesh.getTexCoords() + i * 2, 2 * sizeof(float));
+			}
+
+			if (target == 0)
+			{
+				minimum = vertex;
+				maximum = vertex;
+			}
+			else
+			{
+				for (int32_t k = 0; k < 3; k++)
+				{
+					minimum[k] = glusMathMinf(minimum[k], vertex[k]);
+					maximum[k] = glusMathMaxf(maximum[k], vertex[k]);
+				}
+			}
+		}
+
+		for (int32_t subMeshIndex = 0; subMeshIndex < static_cast<int32_t>(mesh.getSubMeshesCount()); subMeshIndex++)
+		{
+			if (!mesh.containsSubMeshAt(subMeshIndex))
+			{
+				continue;
+			}
+
+			SurfaceMaterialSP surfaceMaterial;
+
+			if (mesh.containsSurfaceMaterialAt(subMeshIndex))
+			{
+				surfaceMaterial = mesh.getSurfaceMaterialAt(subMeshIndex);
+			}
+
+			uint32_t group = static_cast<uint32_t>(find(allSurfaceMaterials.begin(), allSurfaceMaterials.end(), surfaceMaterial) - allSurfaceMaterials.begin());
+
+			if (group == allSurfaceMaterials.size())
+			{
+				allSurfaceMaterials.push_back(surfaceMaterial);
+				allGroupIndices.push_back(vector<uint32_t>());
+			}
+
+			const SubMeshSP& subMesh = mesh.getSubMeshAt(subMeshIndex);
+
+			const uint32_t* source = mesh.getIndices() + subMesh->getIndicesOffset();
+
+			for (uint32_t triangle = 0; triangle < subMesh->getTriangleCount(); triangle++)
+			{
+				allGroupIndices[group].push_back(baseVertex + source[triangle * 3 + 0]);
+				allGroupIndices[group].push_back(baseVertex + source[triangle * 3 + (flip ? 2 : 1)]);
+				allGroupIndices[group].push_back(baseVertex + source[triangle * 3 + (flip ? 1 : 2)]);
+			}
+		}
+
+		baseVertex += mesh.getNumberVertices();
+
+		walker++;
+	}
+
+	uint32_t numberIndices = 0;
+
+	for (uint32_t group = 0; group < allGroupIndices.size(); group++)
+	{
+		numberIndices += static_cast<uint32_t>(allGroupIndices[group].size());
+	}
+
+	uint32_t* indices = new uint32_t[numberIndices];
+
+	map<int32_t, SubMeshSP> subMeshes;
+	map<int32_t, SurfaceMaterialSP> surfaceMaterials;
+
+	uint32_t indicesOffset = 0;
+
+	for (uint32_t group = 0; group < allGroupIndices.size(); group++)
+	{
+		memcpy(indices + indicesOffset, allGroupIndices[group].data(), allGroupIndices[group].size() * sizeof(uint32_t));
+
+		subMeshes[group] = SubMeshSP(new SubMesh(indicesOffset, static_cast<uint32_t>(allGroupIndices[group].size() / 3)));
+		surfaceMaterials[group] = allSurfaceMaterials[group];
+
+		indicesOffset += static_cast<uint32_t>(allGroupIndices[group].size());
+	}
+
+	return MeshSP(new Mesh(name, numberVertices, vertices, normals, bitangents, tangents, texCoords, numberIndices, indices, subMeshes, surfaceMaterials));
+}
+
+void MeshFactory::optimizeMesh(const string& name, uint32_t numberVertices, float* vertices, float* normals, float* bitangents, float* tangents, float* texCoords, float* boneIndices0, float* boneIndices1, float* boneWeights0, float* boneWeights1, float* boneCounters, uint32_t numberIndices, uint32_t* indices, const map<int32_t, SubMeshSP>& subMeshes, bool vertexFetch, bool overdraw) const
+{
+	if (!vertices || !indices || numberVertices == 0 || numberIndices < 3)
+	{
+		return;
+	}
+
+	VertexCacheOptimizer vertexCacheOptimizer;
+
+	float acmrBefore;
+	float atvrBefore;
+
+	analyzeVertexCache(numberVertices, numberIndices, indices, vertexCacheOptimizer.getCacheSize(), acmrBefore, atvrBefore);
+
+	// Sub meshes are reordered in their own range, so ranges sharing triangles are left untouched.
+	vector<pair<uint32_t, uint32_t> > allRanges;
+
+	map<int32_t, SubMeshSP>::const_iterator walker = subMeshes.begin();
+	while (walker != subMeshes.end())
+	{
+		uint32_t indicesOffset = walker->second->getIndicesOffset();
+
+		if (indicesOffset < numberIndices)
+		{
+			uint32_t count = min(walker->second->getTriangleCount() * 3, numberIndices - indicesOffset);
+
+			allRanges.push_back(make_pair(indicesOffset, count - count % 3));
+		}
+
+		walker++;
+	}
+
+	sort(allRanges.begin(), allRanges.end());
+
+	vector<uint32_t> reordered;
+	vector<uint32_t> clusters;
+
+	uint32_t rangeEnd = 0;
+
+	for (uint32_t i = 0; i < allRanges.size(); i++)
+	{
+		uint32_t first = allRanges[i].first;
+		uint32_t count = allRanges[i].second;
+
+		bool overlapping = first < rangeEnd || (i + 1 < allRanges.size() && allRanges[i + 1].first < first + count);
+
+		rangeEnd = max(rangeEnd, first + count);
+
+		if (overlapping || count == 0)
+		{
+			continue;
+		}
+
+		vertexCacheOptimizer.optimizeVertexCache(indices + first, count, numberVertices, reordered, overdraw ? &clusters : nullptr);
+
+		if (overdraw)
+		{
+			vector<uint32_t> cacheOrdered;
+			cacheOrdered.swap(reordered);
+
+			vertexCacheOptimizer.optimizeOverdraw(vertices, cacheOrdered.data(), count, clusters, reordered);
+		}
+
+		memcpy(indices + first, reordered.data(), count * sizeof(uint32_t));
+	}
+
+	if (vertexFetch)
+	{
+		vector<uint32_t> remap;
+
+		vertexCacheOptimizer.optimizeVertexFetch(indices, numberIndices, numberVertices, remap);
+
+		vertexCacheOptimizer.remapVertices(vertices, numberVertices, 4, remap);
+		vertexCacheOptimizer.remapVertices(normals, numberVertices, 3, remap);
+		vertexCacheOptimizer.remapVertices(bitangents, numberVertices, 3, remap);
+		vertexCacheOptimizer.remapVertices(tangents, numberVertices, 3, remap);
+		vertexCacheOptimizer.remapVertices(texCoords, numberVertices, 2, remap);
+		vertexCacheOptimizer.remapVertices(boneIndices0, numberVertices, 4, remap);
+		vertexCacheOptimizer.remapVertices(boneIndices1, numberVertices, 4, remap);
+		vertexCacheOptimizer.remapVertices(boneWeights0, numberVertices, 4, remap);
+		vertexCacheOptimizer.remapVertices(boneWeights1, numberVertices, 4, remap);
+		vertexCacheOptimizer.remapVertices(boneCounters, numberVertices, 1, remap);
+	}
+
+	float acmrAfter;
+	float atvrAfter;
+
+	analyzeVertexCache(numberVertices, numberIndices, indices, vertexCacheOptimizer.getCacheSize(), acmrAfter, atvrAfter);
+
+	glusLogPrint(GLUS_LOG_DEBUG, "Optimized mesh %s: ACMR %.3f -> %.3f, ATVR %.3f -> %.3f", name.c_str(), acmrBefore, acmrAfter, atvrBefore, atvrAfter);
+}
+
+uint32_t MeshFactory::weldVertices(const string& name, uint32_t numberVertices, float*& vertices, float*& normals, float*& bitangents, float*& tangents, float*& texCoords, float*& boneIndices0, float*& boneIndices1, float*& boneWeights0, float*& boneWeights1, float*& boneCounters, uint32_t numberIndices, uint32_t* indices, float epsilon) const
+{
+	if (!vertices || !indices || numberVertices == 0)
+	{
+		return numberVertices;
+	}
+
+	VertexWelder vertexWelder(epsilon);
+
+	vertexWelder.addAttribute(vertices, 4);
+	vertexWelder.addAttribute(normals, 3);
+	vertexWelder.addAttribute(bitangents, 3);
+	vertexWelder.addAttribute(tangents, 3);
+	vertexWelder.addAttribute(texCoords, 2);
+	vertexWelder.addAttribute(boneIndices0, 4, true);
+	vertexWelder.addAttribute(boneIndices1, 4, true);
+	vertexWelder.addAttribute(boneWeights0, 4);
+	vertexWelder.addAttribute(boneWeights1, 4);
+	vertexWelder.addAttribute(boneCounters, 1, true);
+
+	vector<uint32_t> remap;
+
+	uint32_t numberWeldedVertices = vertexWelder.weldVertices(numberVertices, remap);
+
+	glusLogPrint(GLUS_LOG_DEBUG, "Welded mesh %s: %u -> %u vertices", name.c_str(), numberVertices, numberWeldedVertices);
+
+	if (numberWeldedVertices == numberVertices)
+	{
+		return numberVertices;
+	}
+
+	vertexWelder.remapIndices(indices, numberIndices, remap);
+
+	compactVertices(vertexWelder, vertices, numberVertices, numberWeldedVertices, 4, remap);
+	compactVertices(vertexWelder, normals, numberVertices, numberWeldedVertices, 3, remap);
+	compactVertices(vertexWelder, bitangents, numberVertices, numberWeldedVertices, 3, remap);
+	compactVertices(vertexWelder, tangents, numberVertices, numberWeldedVertices, 3, remap);
+	compactVertices(vertexWelder, texCoords, numberVertices, numberWeldedVertices, 2, remap);
+	compactVertices(vertexWelder, boneIndices0, numberVertices, numberWeldedVertices, 4, remap);
+	compactVertices(vertexWelder, boneIndices1, numberVertices, numberWeldedVertices, 4, remap);
+	compactVertices(vertexWelder, boneWeights0, numberVertices, numberWeldedVertices, 4, remap);
+	compactVertices(vertexWelder, boneWeights1, numberVertices, numberWeldedVertices, 4, remap);
+	compactVertices(vertexWelder, boneCounters, numberVertices, numberWeldedVertices, 1, remap);
+
+	return numberWeldedVertices;
+}
+
+bool MeshFactory::createLods(const string& name, uint32_t numberVertices, const float* vertices, const float* normals, const float* texCoords, uint32_t numberIndices, const uint32_t* indices, const map<int32_t, SubMeshSP>& subMeshes, uint32_t numberLods, float reduction, vector<uint32_t>& allIndices) const
+{
+	if (reduction <= 0.0f || reduction >= 1.0f)
+	{
+		return false;
+	}
+
+	MeshSimplifier meshSimplifier;
+
+	allIndices.assign(indices, indices + numberIndices);
+	vector<uint32_t> simplifiedIndices;
+	float error;
+
+	map<int32_t, SubMeshSP>::const_iterator walker = subMeshes.begin();
+	while (walker != subMeshes.end())
+	{
+		SubMeshSP currentSubMesh = walker->second;
+
+		walker++;
+
+		// Already done.
+		if (currentSubMesh->getNumberLods() > 1)
+		{
+			continue;
+		}
+
+		uint32_t offset = currentSubMesh->getIndicesOffset();
+
+		if (offset >= numberIndices)
+		{
+			continue;
+		}
+
+		uint32_t count = currentSubMesh->getTriangleCount() * 3;
+		count = count < numberIndices - offset ? count : numberIndices - offset;
+
+		uint32_t previousTriangleCount = count / 3;
+
+		for (uint32_t lod = 1; lod < numberLods; lod++)
+		{
+			uint32_t targetTriangleCount = static_cast<uint32_t>(static_cast<float>(previousTriangleCount) * reduction);
+
+			if (targetTriangleCount == 0)
+			{
+				break;
+			}
+
+			meshSimplifier.simplify(vertices, normals, texCoords, numberVertices, &indices[offset], count, targetTriangleCount, -1.0f, simplifiedIndices, error);
+
+			uint32_t triangleCount = static_cast<uint32_t>(simplifiedIndices.size() / 3);
+
+			// Stop, if the mesh can not be reduced anymore.
+			if (triangleCount == 0 || static_cast<float>(triangleCount) > static_cast<float>(previousTriangleCount) * 0.95f)
+			{
+				break;
+			}
+
+			currentSubMesh->addLod(static_cast<uint32_t>(allIndices.size()), triangleCount, error);
+
+			allIndices.insert(allIndices.end(), simplifiedIndices.begin(), simplifiedIndices.end());
+
+			previousTriangleCount = triangleCount;
+		}
+
+		glusLogPrint(GLUS_LOG_DEBUG, "Mesh %s has %u levels of detail with %u triangles at the coarsest level", name.c_str(), currentSubMesh->getNumberLods(), previousTriangleCount);
+	}
+
+	return true;
+}
+
+void MeshFactory::analyzeVertexCache(uint32_t numberVertices, uint32_t numberIndices, const uint32_t* indices, uint32_t cacheSize, float& acmr, float& atvr) const
+{
+	VertexCacheOptimizer vertexCacheOptimizer(cacheSize);
+
+	vertexCacheOptimizer.analyzeVertexCache(indices, numberIndices, numberVertices, cacheSize, acmr, atvr);
+}
+
+void MeshFactory::encodePackedVertices(const PackedVertexLayout& layout, uint32_t numberVertices, const float* vertices, const float* normals, const float* bitangents, const float* tangents, const float* texCoords, const float* boneIndices0, const float* boneIndices1, const float* boneWeights0, const float* boneWeights1, const float* boneCounters, vector<uint8_t>& result) const
+{
+	static const float zero[3] = { 0.0f, 0.0f, 0.0f };
+
+	GLsizei stride = layout.getStride();
+
+	result.assign(numberVertices * stride, 0);
+
+	int16_t octahedral[2];
+	uint16_t half[2];
+	uint8_t boneIndices[PackedVertexLayout::MAX_BONES];
+	uint8_t boneWeights[PackedVertexLayout::MAX_BONES];
+
+	for (uint32_t i = 0; i < numberVertices; i++)
+	{
+		uint8_t* target = &result[i * stride];
+
+		memcpy(target + layout.getVertexOffset(), &vertices[i * 4], 3 * sizeof(float));
+
+		encodeOctahedral(normals ? &normals[i * 3] : zero, octahedral);
+		memcpy(target + layout.getNormalOffset(), octahedral, sizeof(octahedral));
+
+		if (layout.hasTangents())
+		{
+			encodeOctahedral(bitangents ? &bitangents[i * 3] : zero, octahedral);
+			memcpy(target + layout.getBitangentOffset(), octahedral, sizeof(octahedral));
+
+			encodeOctahedral(tangents ? &tangents[i * 3] : zero, octahedral);
+			memcpy(target + layout.getTangentOffset(), octahedral, sizeof(octahedral));
+		}
+
+		if (layout.hasTexCoords() && texCoords)
+		{
+			half[0] = encodeHalf(texCoords[i * 2 + 0]);
+			half[1] = encodeHalf(texCoords[i * 2 + 1]);
+			memcpy(target + layout.getTexCoordOffset(), half, sizeof(half));
+		}
+
+		if (layout.hasSkinning() && boneIndices0 && boneIndices1 && boneWeights0 && boneWeights1 && boneCounters)
+		{
+			float totalWeight = 0.0f;
+			int32_t totalQuantized = 0;
+			int32_t largest = 0;
+
+			for (int32_t k = 0; k < PackedVertexLayout::MAX_BONES; k++)
+			{
+				float boneIndex = k < 4 ? boneIndices0[i * 4 + k] : boneIndices1[i * 4 + k - 4];
+				float boneWeight = k < 4 ? boneWeights0[i * 4 + k] : boneWeights1[i * 4 + k - 4];
+
+				boneIndices[k] = static_cast<uint8_t>(glusMathClampf(roundf(boneIndex), 0.0f, 255.0f));
+				boneWeights[k] = static_cast<uint8_t>(glusMathClampf(roundf(boneWeight * 255.0f), 0.0f, 255.0f));
+
+				totalWeight += boneWeight;
+				totalQuantized += boneWeights[k];
+
+				if (boneWeights[k] > boneWeights[largest])
+				{
+					largest = k;
+				}
+			}
+
+			// Rounding errors go to the largest weight, so the weights still sum up to the original total.
+			int32_t difference = static_cast<int32_t>(glusMathClampf(roundf(totalWeight * 255.0f), 0.0f, 255.0f)) - totalQuantized;
+
+			if (totalQuantized > 0)
+			{
+				boneWeights[largest] = static_cast<uint8_t>(glusMathClampf(static_cast<float>(boneWeights[largest] + difference), 0.0f, 255.0f));
+			}
+
+			memcpy(target + layout.getBoneIndicesOffset(), boneIndices, sizeof(boneIndices));
+			memcpy(target + layout.getBoneWeightsOffset(), boneWeights, sizeof(boneWeights));
+
+			target[layout.getBoneCounterOffset()] = static_cast<uint8_t>(glusMathClampf(boneCounters[i], 0.0f, static_cast<float>(PackedVertexLayout::MAX_BONES)));
+		}
+	}
+}
+
+void MeshFactory::decodePackedVertices(const PackedVertexLayout& layout, uint32_t numberVertices, const uint8_t* packedVertices, float* vertices, float* normals, float* bitangents, float* tangents, float* texCoords, float* boneIndices0, float* boneIndices1, float* boneWeights0, float* boneWeights1, float* boneCounters) const
+{
+	GLsizei stride = layout.getStride();
+
+	int16_t octahedral[2];
+	uint16_t half[2];
+
+	for (uint32_t i = 0; i < numberVertices; i++)
+	{
+		const uint8_t* source = &packedVertices[i * stride];
+
+		if (vertices)
+		{
+			memcpy(&vertices[i * 4], source + layout.getVertexOffset(), 3 * sizeof(float));
+			vertices[i * 4 + 3] = 1.0f;
+		}
+
+		if (normals)
+		{
+			memcpy(octahedral, source + layout.getNormalOffset(), sizeof(octahedral));
+			decodeOctahedral(octahedral, &normals[i * 3]);
+		}
+
+		if (layout.hasTangents())
+		{
+			if (bitangents)
+			{
+				memcpy(octahedral, source + layout.getBitangentOffset(), sizeof(octahedral));
+				decodeOctahedral(octahedral, &bitangents[i * 3]);
+			}
+
+			if (tangents)
+			{
+				memcpy(octahedral, source + layout.getTangentOffset(), sizeof(octahedral));
+				decodeOctahedral(octahedral, &tangents[i * 3]);
+			}
+		}
+
+		if (layout.hasTexCoords() && texCoords)
+		{
+			memcpy(half, source + layout.getTexCoordOffset(), sizeof(half));
+			texCoords[i * 2 + 0] = decodeHalf(half[0]);
+			texCoords[i * 2 + 1] = decodeHalf(half[1]);
+		}
+
+		if (layout.hasSkinning())
+		{
+			for (int32_t k = 0; k < PackedVertexLayout::MAX_BONES; k++)
+			{
+				float* boneIndices = k < 4 ? boneIndices0 : boneIndices1;
+				float* boneWeights = k < 4 ? boneWeights0 : boneWeights1;
+
+				if (boneIndices)
+				{
+					boneIndices[i * 4 + k % 4] = static_cast<float>(source[layout.getBoneIndicesOffset() + k]);
+				}
+				if (boneWeights)
+				{
+					boneWeights[i * 4 + k % 4] = static_cast<float>(source[layout.getBoneWeightsOffset() + k]) / 255.0f;
+				}
+			}
+
+			if (boneCounters)
+			{
+				boneCounters[i] = static_cast<float>(source[layout.getBoneCounterOffset()]);
+			}
+		}
+	}
+}
+
+bool MeshFactory::encodeShortIndices(const uint32_t* indices, uint32_t numberIndices, uint32_t numberVertices, vector<uint16_t>& result) const
+{
+	if (numberVertices > 65536)
+	{
+		return false;
+	}
+
+	result.resize(numberIndices);
+
+	for (uint32_t i = 0; i < numberIndices; i++)
+	{
+		result[i] = static_cast<uint16_t>(indices[i]);
+	}
+
+	return true;
+}
+
+void MeshFactory::encodeOctahedral(const float* vector, int16_t* result) const
+{
+	float length = fabsf(vector[0]) + fabsf(vector[1]) + fabsf(vector[2]);
+
+	if (length == 0.0f)
+	{
+		result[0] = 0;
+		result[1] = 0;
+
+		return;
+	}
+
+	float x = vector[0] / length;
+	float y = vector[1] / length;
+
+	// Lower hemisphere is folded over the diagonals.
+	if (vector[2] < 0.0f)
+	{
+		float foldedX = (1.0f - fabsf(y)) * (x >= 0.0f ? 1.0f : -1.0f);
+		float foldedY = (1.0f - fabsf(x)) * (y >= 0.0f ? 1.0f : -1.0f);
+
+		x = foldedX;
+		y = foldedY;
+	}
+
+	result[0] = static_cast<int16_t>(roundf(glusMathClampf(x, -1.0f, 1.0f) * 32767.0f));
+	result[1] = static_cast<int16_t>(roundf(glusMathClampf(y, -1.0f, 1.0f) * 32767.0f));
+}
+
+void MeshFactory::decodeOctahedral(const int16_t* packed, float* result) const
+{
+	float x = static_cast<float>(packed[0]) / 32767.0f;
+	float y = static_cast<float>(packed[1]) / 32767.0f;
+	float z = 1.0f - fabsf(x) - fabsf(y);
+
+	if (z < 0.0f)
+	{
+		float unfoldedX = (1.0f - fabsf(y)) * (x >= 0.0f ? 1.0f : -1.0f);
+		float unfoldedY = (1.0f - fabsf(x)) * (y >= 0.0f ? 1.0f : -1.0f);
+
+		x = unfoldedX;
+		y = unfoldedY;
+	}
+
+	float length = sqrtf(x * x + y * y + z * z);
+
+	result[0] = x / length;
+	result[1] = y / length;
+	result[2] = z / length;
+}
+
+uint16_t MeshFactory::encodeHalf(float value) const
+{
+	uint32_t bits;
+	memcpy(&bits, &value, sizeof(bits));
+
+	uint32_t sign = (bits >> 16) & 0x8000;
+	uint32_t floatExponent = (bits >> 23) & 0xFF;
+	uint32_t mantissa = bits & 0x7FFFFF;
+
+	// Infinity and not a number
+	if (floatExponent == 0xFF)
+	{
+		return static_cast<uint16_t>(sign | 0x7C00 | (mantissa ? 0x200 : 0));
+	}
+
+	int32_t exponent = static_cast<int32_t>(floatExponent) - 127 + 15;
+
+	if (exponent >= 31)
+	{
+		return static_cast<uint16_t>(sign | 0x7C00);
+	}
+
+	if (exponent <= 0)
+	{
+		if (exponent < -10)
+		{
+			return static_cast<uint16_t>(sign);
+		}
+
+		// Denormalized half, the implicit one becomes explicit.
+		mantissa |= 0x800000;
+
+		uint32_t shift = static_cast<uint32_t>(14 - exponent);
+
+		uint32_t half = mantissa >> shift;
+
+		if ((mantissa >> (shift - 1)) & 1)
+		{
+			half++;
+		}
+
+		return static_cast<uint16_t>(sign | half);
+	}
+
+	uint32_t half = sign | (static_cast<uint32_t>(exponent) << 10) | (mantissa >> 13);
+
+	// Round to nearest. A carry into the exponent is still the correct result.
+	if (mantissa & 0x1000)
+	{
+		half++;
+	}
+
+	return static_cast<uint16_t>(half);
+}
+
+float MeshFactory::decodeHalf(uint16_t value) const
+{
+	uint32_t sign = static_cast<uint32_t>(value & 0x8000) << 16;
+	uint32_t exponent = (value >> 10) & 0x1F;
+	uint32_t mantissa = value & 0x3FF;
+
+	uint32_t bits;
+
+	if (exponent == 0)
+	{
+		float result = ldexpf(static_cast<float>(mantissa), -24);
+
+		return sign ? -result : result;
+	}
+	else if (exponent == 31)
+	{
+		bits = sign | 0x7F800000 | (mantissa << 13);
+	}
+	else
+	{
+		bits = sign | ((exponent - 15 + 127) << 23) | (mantissa << 13);
+	}
+
+	float result;
+	memcpy(&result, &bits, sizeof(result));
+
+	return result;
+}
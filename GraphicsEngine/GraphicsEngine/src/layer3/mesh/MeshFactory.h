@@ -11,19 +11,101 @@
 #include "../../UsedLibs.h"
 
 #include "../../layer0/color/Color.h"
+#include "../../layer0/math/Matrix4x4.h"
+#include "../../layer0/math/Point4.h"
 #include "../../layer2/material/SurfaceMaterial.h"
 #include "Mesh.h"
+#include "PackedVertexLayout.h"
 #include "SubMesh.h"
+#include "VertexCacheOptimizer.h"
+#include "VertexWelder.h"
 
 class MeshFactory
 {
 
+private:
+
+	/**
+	 * Moves the remaining vertices to the front and reallocates the array to their number.
+	 */
+	void compactVertices(const VertexWelder& vertexWelder, float*& data, std::uint32_t numberVertices, std::uint32_t numberWeldedVertices, std::uint32_t components, const std::vector<std::uint32_t>& remap) const;
+
 public:
 
 	MeshFactory();
 	virtual ~MeshFactory();
 
-	MeshSP createMesh(const std::string& name, const GLUSshape& shape, const SurfaceMaterialSP& surfaceMaterial) const;
+	/**
+	 * The mesh takes over the arrays of the shape, which are reordered for the vertex cache before.
+	 */
+	MeshSP createMesh(const std::string& name, GLUSshape& shape, const SurfaceMaterialSP& surfaceMaterial) const;
+
+	/**
+	 * Transforms the full resolution sub meshes of all parts by their matrix and merges them into one mesh. Sub meshes sharing
+	 * a surface material are combined into one sub mesh. Attributes missing in some parts are filled with zeros.
+	 * Needs the CPU data of the parts, which must neither be skinned nor packed.
+	 *
+	 * @param minimum Receives the lower corner of the bounds of the merged vertices.
+	 * @param maximum Receives the upper corner of the bounds of the merged vertices.
+	 */
+	MeshSP mergeMeshes(const std::string& name, const std::vector<std::pair<MeshSP, Matrix4x4> >& allParts, Point4& minimum, Point4& maximum) const;
+
+	/**
+	 * Reorders the triangles of each sub mesh for the post transform vertex cache and optionally for less overdraw.
+	 * If vertexFetch is set, the vertices are renumbered by first use and all given attribute arrays are moved accordingly.
+	 * Only the vertices and indices are mandatory. Has to be called before the mesh is created.
+	 */
+	void optimizeMesh(const std::string& name, std::uint32_t numberVertices, float* vertices, float* normals, float* bitangents, float* tangents, float* texCoords, float* boneIndices0, float* boneIndices1, float* boneWeights0, float* boneWeights1, float* boneCounters, std::uint32_t numberIndices, std::uint32_t* indices, const std::map<std::int32_t, SubMeshSP>& subMeshes, bool vertexFetch, bool overdraw) const;
+
+	/**
+	 * Merges vertices, whose attributes all differ by at most the epsilon, and updates the indices. Bone indices and
+	 * counters have to be identical. All given attribute arrays are reallocated to the remaining number of vertices.
+	 * Has to be called before the mesh is created.
+	 *
+	 * @return The number of remaining vertices.
+	 */
+	std::uint32_t weldVertices(const std::string& name, std::uint32_t numberVertices, float*& vertices, float*& normals, float*& bitangents, float*& tangents, float*& texCoords, float*& boneIndices0, float*& boneIndices1, float*& boneWeights0, float*& boneWeights1, float*& boneCounters, std::uint32_t numberIndices, std::uint32_t* indices, float epsilon) const;
+
+	/**
+	 * Simplifies each sub mesh, which has no levels of detail yet, and registers the levels at the sub mesh. The result
+	 * contains the given indices followed by the indices of all levels. Does not need a context. The normals and texture
+	 * coordinates can be null and are used to detect seams.
+	 *
+	 * @return False, if the reduction is not between zero and one.
+	 */
+	bool createLods(const std::string& name, std::uint32_t numberVertices, const float* vertices, const float* normals, const float* texCoords, std::uint32_t numberIndices, const std::uint32_t* indices, const std::map<std::int32_t, SubMeshSP>& subMeshes, std::uint32_t numberLods, float reduction, std::vector<std::uint32_t>& allIndices) const;
+
+	/**
+	 * Simulates a FIFO vertex cache of the given size over all indices.
+	 */
+	void analyzeVertexCache(std::uint32_t numberVertices, std::uint32_t numberIndices, const std::uint32_t* indices, std::uint32_t cacheSize, float& acmr, float& atvr) const;
+
+	/**
+	 * Interleaves and quantizes the vertex attributes as described by the layout. Attributes not in the layout are ignored.
+	 * Missing normals, bitangents and tangents are encoded as the positive z axis.
+	 */
+	void encodePackedVertices(const PackedVertexLayout& layout, std::uint32_t numberVertices, const float* vertices, const float* normals, const float* bitangents, const float* tangents, const float* texCoords, const float* boneIndices0, const float* boneIndices1, const float* boneWeights0, const float* boneWeights1, const float* boneCounters, std::vector<std::uint8_t>& result) const;
+
+	/**
+	 * Reverts encodePackedVertices. Each output may be null. The vertices get four components with w set to one.
+	 */
+	void decodePackedVertices(const PackedVertexLayout& layout, std::uint32_t numberVertices, const std::uint8_t* packedVertices, float* vertices, float* normals, float* bitangents, float* tangents, float* texCoords, float* boneIndices0, float* boneIndices1, float* boneWeights0, float* boneWeights1, float* boneCounters) const;
+
+	/**
+	 * @return False, if not all vertices can be addressed with 16 bit.
+	 */
+	bool encodeShortIndices(const std::uint32_t* indices, std::uint32_t numberIndices, std::uint32_t numberVertices, std::vector<std::uint16_t>& result) const;
+
+	/**
+	 * Maps the unit vector onto the octahedron and unfolds it into the plane. The result is scaled to the range of a short.
+	 */
+	void encodeOctahedral(const float* vector, std::int16_t* result) const;
+
+	void decodeOctahedral(const std::int16_t* packed, float* result) const;
+
+	std::uint16_t encodeHalf(float value) const;
+
+	float decodeHalf(std::uint16_t value) const;
 
 };
 
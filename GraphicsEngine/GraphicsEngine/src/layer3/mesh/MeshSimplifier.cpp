@@ -0,0 +1,518 @@
+/*
+ * MeshSimplifier.cpp
+ *
+ *  Created on: 19.10.2026
+ *      Author: nopper
+ */
+
+#include "MeshSimplifier.h"
+
+using namespace std;
+
+MeshSimplifier::MeshSimplifier()
+{
+}
+
+MeshSimplifier::~MeshSimplifier()
+{
+}
+
+void MeshSimplifier::addPlaneQuadric(double* quadric, const float* p0, const float* p1, const float* p2) const
+{
+	double edge0[3] = {p1[0] - p0[0], p1[1] - p0[1], p1[2] - p0[2]};
+	double edge1[3] = {p2[0] - p0[0], p2[1] - p0[1], p2[2] - p0[2]};
+
+	double normal[3] = {edge0[1] * edge1[2] - edge0[2] * edge1[1], edge0[2] * edge1[0] - edge0[0] * edge1[2], edge0[0] * edge1[1] - edge0[1] * edge1[0]};
+
+	double length = sqrt(normal[0] * normal[0] + normal[1] * normal[1] + normal[2] * normal[2]);
+
+	if (length == 0.0)
+	{
+		return;
+	}
+
+	double a = normal[0] / length;
+	double b = normal[1] / length;
+	double c = normal[2] / length;
+	double d = -(a * p0[0] + b * p0[1] + c * p0[2]);
+
+	// Upper triangle of the symmetric 4x4 matrix (a, b, c, d)^T * (a, b, c, d).
+	quadric[0] += a * a;
+	quadric[1] += a * b;
+	quadric[2] += a * c;
+	quadric[3] += a * d;
+	quadric[4] += b * b;
+	quadric[5] += b * c;
+	quadric[6] += b * d;
+	quadric[7] += c * c;
+	quadric[8] += c * d;
+	quadric[9] += d * d;
+}
+
+double MeshSimplifier::evaluateQuadric(const double* quadric, const float* position) const
+{
+	double x = position[0];
+	double y = position[1];
+	double z = position[2];
+
+	return quadric[0] * x * x + 2.0 * quadric[1] * x * y + 2.0 * quadric[2] * x * z + 2.0 * quadric[3] * x + quadric[4] * y * y + 2.0 * quadric[5] * y * z + 2.0 * quadric[6] * y + quadric[7] * z * z + 2.0 * quadric[8] * z + quadric[9];
+}
+
+bool MeshSimplifier::hasEqualAttributes(uint32_t first, uint32_t second, const float* normals, const float* texCoords) const
+{
+	const float epsilon = 1.0e-5f;
+
+	if (normals)
+	{
+		for (uint32_t i = 0; i < 3; i++)
+		{
+			if (fabsf(normals[first * 3 + i] - normals[second * 3 + i]) > epsilon)
+			{
+				return false;
+			}
+		}
+	}
+
+	if (texCoords)
+	{
+		for (uint32_t i = 0; i < 2; i++)
+		{
+			if (fabsf(texCoords[first * 2 + i] - texCoords[second * 2 + i]) > epsilon)
+			{
+				return false;
+			}
+		}
+	}
+
+	return true;
+}
+
+bool MeshSimplifier::isCollapseValid(uint32_t from, uint32_t to, const vector<uint32_t>& triangles, const vector<bool>& triangleRemoved, const vector<vector<uint32_t> >& vertexTriangles, const vector<uint32_t>& localToGlobal, const float* vertices) const
+{
+	auto walker = vertexTriangles[from].begin();
+	while (walker != vertexTriangles[from].end())
+	{
+		uint32_t triangle = *walker;
+
+		walker++;
+
+		if (triangleRemoved[triangle])
+		{
+			continue;
+		}
+
+		const uint32_t* corners = &triangles[triangle * 3];
+
+		// This triangle will be removed by the collapse.
+		if (corners[0] == to || corners[1] == to || corners[2] == to)
+		{
+			continue;
+		}
+
+		const float* before[3];
+		const float* after[3];
+
+		for (int32_t i = 0; i < 3; i++)
+		{
+			before[i] = &vertices[localToGlobal[corners[i]] * 4];
+			after[i] = corners[i] == from ? &vertices[localToGlobal[to] * 4] : before[i];
+		}
+
+		float edgeBefore0[3];
+		float edgeBefore1[3];
+		float edgeAfter0[3];
+		float edgeAfter1[3];
+
+		glusVector3SubtractVector3f(edgeBefore0, before[1], before[0]);
+		glusVector3SubtractVector3f(edgeBefore1, before[2], before[0]);
+		glusVector3SubtractVector3f(edgeAfter0, after[1], after[0]);
+		glusVector3SubtractVector3f(edgeAfter1, after[2], after[0]);
+
+		float normalBefore[3];
+		float normalAfter[3];
+
+		glusVector3Crossf(normalBefore, edgeBefore0, edgeBefore1);
+		glusVector3Crossf(normalAfter, edgeAfter0, edgeAfter1);
+
+		// Do not allow degenerated or flipped triangles.
+		if (glusVector3Dotf(normalAfter, normalAfter) == 0.0f || glusVector3Dotf(normalBefore, normalAfter) <= 0.0f)
+		{
+			return false;
+		}
+	}
+
+	return true;
+}
+
+void MeshSimplifier::simplify(const float* vertices, const float* normals, const float* texCoords, uint32_t numberVertices, const uint32_t* indices, uint32_t numberIndices, uint32_t targetTriangleCount, float maxError, vector<uint32_t>& result, float& resultError) const
+{
+	result.clear();
+	resultError = 0.0f;
+
+	// Work on a compact set of the used vertices.
+	vector<int32_t> globalToLocal(numberVertices, -1);
+	vector<uint32_t> localToGlobal;
+	vector<uint32_t> triangles;
+
+	for (uint32_t i = 0; i + 2 < numberIndices; i += 3)
+	{
+		if (indices[i] == indices[i + 1] || indices[i + 1] == indices[i + 2] || indices[i + 2] == indices[i] || indices[i] >= numberVertices || indices[i + 1] >= numberVertices || indices[i + 2] >= numberVertices)
+		{
+			continue;
+		}
+
+		for (uint32_t k = 0; k < 3; k++)
+		{
+			uint32_t index = indices[i + k];
+
+			if (globalToLocal[index] < 0)
+			{
+				globalToLocal[index] = static_cast<int32_t>(localToGlobal.size());
+				localToGlobal.push_back(index);
+			}
+
+			triangles.push_back(static_cast<uint32_t>(globalToLocal[index]));
+		}
+	}
+
+	uint32_t numberLocalVertices = static_cast<uint32_t>(localToGlobal.size());
+
+	vector<bool> vertexLocked(numberLocalVertices, false);
+
+	auto isSamePosition = [&](uint32_t a, uint32_t b)
+	{
+		const float* pa = &vertices[localToGlobal[a] * 4];
+		const float* pb = &vertices[localToGlobal[b] * 4];
+
+		return pa[0] == pb[0] && pa[1] == pb[1] && pa[2] == pb[2];
+	};
+
+	vector<uint32_t> sortedVertices(numberLocalVertices);
+	for (uint32_t i = 0; i < numberLocalVertices; i++)
+	{
+		sortedVertices[i] = i;
+	}
+
+	std::sort(sortedVertices.begin(), sortedVertices.end(), [&](uint32_t a, uint32_t b)
+	{
+		const float* pa = &vertices[localToGlobal[a] * 4];
+		const float* pb = &vertices[localToGlobal[b] * 4];
+
+		if (pa[0] != pb[0])
+		{
+			return pa[0] < pb[0];
+		}
+		if (pa[1] != pb[1])
+		{
+			return pa[1] < pb[1];
+		}
+		return pa[2] < pb[2];
+	});
+
+	// Vertices sharing a position and the attributes are replaced by the first of them. If the attributes differ, the
+	// vertices are on a normal or texture coordinate seam and are kept.
+	vector<uint32_t> canonicalVertices(numberLocalVertices);
+
+	uint32_t first = 0;
+	while (first < numberLocalVertices)
+	{
+		uint32_t last = first + 1;
+		while (last < numberLocalVertices && isSamePosition(sortedVertices[first], sortedVertices[last]))
+		{
+			last++;
+		}
+
+		bool seam = false;
+
+		for (uint32_t i = first; i < last; i++)
+		{
+			uint32_t vertex = sortedVertices[i];
+
+			canonicalVertices[vertex] = vertex;
+
+			for (uint32_t k = first; k < i; k++)
+			{
+				if (canonicalVertices[sortedVertices[k]] == sortedVertices[k] && hasEqualAttributes(localToGlobal[sortedVertices[k]], localToGlobal[vertex], normals, texCoords))
+				{
+					canonicalVertices[vertex] = sortedVertices[k];
+
+					break;
+				}
+			}
+
+			if (canonicalVertices[vertex] != sortedVertices[first])
+			{
+				seam = true;
+			}
+		}
+
+		if (seam)
+		{
+			for (uint32_t i = first; i < last; i++)
+			{
+				vertexLocked[canonicalVertices[sortedVertices[i]]] = true;
+			}
+		}
+
+		first = last;
+	}
+
+	// Triangles, which became degenerated by the replacement, do not have an area anyway.
+	vector<uint32_t> canonicalTriangles;
+	canonicalTriangles.reserve(triangles.size());
+
+	for (uint32_t i = 0; i + 2 < static_cast<uint32_t>(triangles.size()); i += 3)
+	{
+		uint32_t corners[3] = {canonicalVertices[triangles[i]], canonicalVertices[triangles[i + 1]], canonicalVertices[triangles[i + 2]]};
+
+		if (corners[0] == corners[1] || corners[1] == corners[2] || corners[2] == corners[0])
+		{
+			continue;
+		}
+
+		canonicalTriangles.insert(canonicalTriangles.end(), corners, corners + 3);
+	}
+
+	triangles.swap(canonicalTriangles);
+
+	uint32_t numberTriangles = static_cast<uint32_t>(triangles.size() / 3);
+	uint32_t liveTriangles = numberTriangles;
+
+	vector<double> quadrics(numberLocalVertices * 10, 0.0);
+	vector<vector<uint32_t> > vertexTriangles(numberLocalVertices);
+	vector<bool> triangleRemoved(numberTriangles, false);
+	vector<bool> vertexRemoved(numberLocalVertices, false);
+
+	map<uint64_t, int32_t> edgeUsage;
+
+	for (uint32_t t = 0; t < numberTriangles; t++)
+	{
+		const uint32_t* corners = &triangles[t * 3];
+
+		double quadric[10] = {0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0};
+		addPlaneQuadric(quadric, &vertices[localToGlobal[corners[0]] * 4], &vertices[localToGlobal[corners[1]] * 4], &vertices[localToGlobal[corners[2]] * 4]);
+
+		for (uint32_t k = 0; k < 3; k++)
+		{
+			for (int32_t q = 0; q < 10; q++)
+			{
+				quadrics[corners[k] * 10 + q] += quadric[q];
+			}
+
+			vertexTriangles[corners[k]].push_back(t);
+
+			uint32_t first = corners[k] < corners[(k + 1) % 3] ? corners[k] : corners[(k + 1) % 3];
+			uint32_t second = corners[k] < corners[(k + 1) % 3] ? corners[(k + 1) % 3] : corners[k];
+
+			edgeUsage[(static_cast<uint64_t>(first) << 32) | second]++;
+		}
+	}
+
+	// Border edges are only used by one triangle. Keep these vertices, so the outline does not shrink.
+	auto walkerEdges = edgeUsage.begin();
+	while (walkerEdges != edgeUsage.end())
+	{
+		if (walkerEdges->second == 1)
+		{
+			vertexLocked[static_cast<uint32_t>(walkerEdges->first >> 32)] = true;
+			vertexLocked[static_cast<uint32_t>(walkerEdges->first & 0xFFFFFFFF)] = true;
+		}
+
+		walkerEdges++;
+	}
+
+	// Marks an edge, which must not be collapsed.
+	const double noCollapse = -1.0;
+
+	// Cost of the cheaper direction of collapsing the edge.
+	auto computeCollapse = [&](uint32_t u, uint32_t v, uint32_t& from, uint32_t& to)
+	{
+		double quadric[10];
+		for (int32_t q = 0; q < 10; q++)
+		{
+			quadric[q] = quadrics[u * 10 + q] + quadrics[v * 10 + q];
+		}
+
+		double costUV = vertexLocked[u] ? noCollapse : fabs(evaluateQuadric(quadric, &vertices[localToGlobal[v] * 4]));
+		double costVU = vertexLocked[v] ? noCollapse : fabs(evaluateQuadric(quadric, &vertices[localToGlobal[u] * 4]));
+
+		if (costVU == noCollapse || (costUV != noCollapse && costUV <= costVU))
+		{
+			from = u;
+			to = v;
+
+			return costUV;
+		}
+
+		from = v;
+		to = u;
+
+		return costVU;
+	};
+
+	typedef pair<double, pair<uint32_t, uint32_t> > Candidate;
+
+	priority_queue<Candidate, vector<Candidate>, greater<Candidate> > candidates;
+
+	uint32_t from;
+	uint32_t to;
+
+	walkerEdges = edgeUsage.begin();
+	while (walkerEdges != edgeUsage.end())
+	{
+		double cost = computeCollapse(static_cast<uint32_t>(walkerEdges->first >> 32), static_cast<uint32_t>(walkerEdges->first & 0xFFFFFFFF), from, to);
+
+		if (cost != noCollapse)
+		{
+			candidates.push(Candidate(cost, pair<uint32_t, uint32_t>(from, to)));
+		}
+
+		walkerEdges++;
+	}
+
+	double maxCost = maxError >= 0.0f ? static_cast<double>(maxError) * static_cast<double>(maxError) : -1.0;
+
+	while (liveTriangles > targetTriangleCount && !candidates.empty())
+	{
+		Candidate candidate = candidates.top();
+		candidates.pop();
+
+		// Quadrics only grow, so stored costs are lower bounds and all remaining candidates are too expensive.
+		if (maxCost >= 0.0 && candidate.first > maxCost)
+		{
+			break;
+		}
+
+		uint32_t u = candidate.second.first;
+		uint32_t v = candidate.second.second;
+
+		if (vertexRemoved[u] || vertexRemoved[v])
+		{
+			continue;
+		}
+
+		double cost = computeCollapse(u, v, from, to);
+
+		if (cost == noCollapse)
+		{
+			continue;
+		}
+
+		// Outdated candidate, so sort it in again.
+		if (cost > candidate.first * 1.0001 + 1.0e-12)
+		{
+			candidates.push(Candidate(cost, pair<uint32_t, uint32_t>(from, to)));
+
+			continue;
+		}
+
+		// Check, that the edge still exists.
+		bool adjacent = false;
+		auto walker = vertexTriangles[from].begin();
+		while (walker != vertexTriangles[from].end() && !adjacent)
+		{
+			if (!triangleRemoved[*walker])
+			{
+				const uint32_t* corners = &triangles[*walker * 3];
+
+				adjacent = corners[0] == to || corners[1] == to || corners[2] == to;
+			}
+
+			walker++;
+		}
+
+		if (!adjacent || !isCollapseValid(from, to, triangles, triangleRemoved, vertexTriangles, localToGlobal, vertices))
+		{
+			continue;
+		}
+
+		// Collapse the edge.
+		walker = vertexTriangles[from].begin();
+		while (walker != vertexTriangles[from].end())
+		{
+			uint32_t triangle = *walker;
+
+			walker++;
+
+			if (triangleRemoved[triangle])
+			{
+				continue;
+			}
+
+			uint32_t* corners = &triangles[triangle * 3];
+
+			if (corners[0] == to || corners[1] == to || corners[2] == to)
+			{
+				triangleRemoved[triangle] = true;
+				liveTriangles--;
+
+				continue;
+			}
+
+			for (int32_t k = 0; k < 3; k++)
+			{
+				if (corners[k] == from)
+				{
+					corners[k] = to;
+				}
+			}
+
+			vertexTriangles[to].push_back(triangle);
+		}
+		vertexTriangles[from].clear();
+
+		vertexRemoved[from] = true;
+
+		for (int32_t q = 0; q < 10; q++)
+		{
+			quadrics[to * 10 + q] += quadrics[from * 10 + q];
+		}
+
+		resultError = glusMathMaxf(resultError, static_cast<float>(sqrt(cost)));
+
+		// Update the costs of all edges around the remaining vertex.
+		walker = vertexTriangles[to].begin();
+		while (walker != vertexTriangles[to].end())
+		{
+			if (!triangleRemoved[*walker])
+			{
+				const uint32_t* corners = &triangles[*walker * 3];
+
+				for (int32_t k = 0; k < 3; k++)
+				{
+					if (corners[k] == to)
+					{
+						continue;
+					}
+
+					uint32_t newFrom;
+					uint32_t newTo;
+
+					double newCost = computeCollapse(to, corners[k], newFrom, newTo);
+
+					if (newCost != noCollapse)
+					{
+						candidates.push(Candidate(newCost, pair<uint32_t, uint32_t>(newFrom, newTo)));
+					}
+				}
+			}
+
+			walker++;
+		}
+	}
+
+	result.reserve(liveTriangles * 3);
+
+	for (uint32_t t = 0; t < numberTriangles; t++)
+	{
+		if (triangleRemoved[t])
+		{
+			continue;
+		}
+
+		for (int32_t k = 0; k < 3; k++)
+		{
+			result.push_back(localToGlobal[triangles[t * 3 + k]]);
+		}
+	}
+}
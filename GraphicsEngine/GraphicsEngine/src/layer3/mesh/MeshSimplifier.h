@@ -0,0 +1,51 @@
+/*
+ * MeshSimplifier.h
+ *
+ *  Created on: 19.10.2026
+ *      Author: nopper
+ */
+
+#ifndef MESHSIMPLIFIER_H_
+#define MESHSIMPLIFIER_H_
+
+#include "../../UsedLibs.h"
+
+/**
+ * Quadric error metric simplification by edge collapses. A vertex is always collapsed onto one of its neighbors,
+ * so the result is a new index list referencing the original vertices. Vertices sharing the position and the attributes,
+ * e.g. of a mesh stored per corner, are treated as one. Vertices on borders and on seams, where the attributes differ, are
+ * kept.
+ */
+class MeshSimplifier
+{
+
+private:
+
+	void addPlaneQuadric(double* quadric, const float* p0, const float* p1, const float* p2) const;
+
+	double evaluateQuadric(const double* quadric, const float* position) const;
+
+	bool hasEqualAttributes(std::uint32_t first, std::uint32_t second, const float* normals, const float* texCoords) const;
+
+	bool isCollapseValid(std::uint32_t from, std::uint32_t to, const std::vector<std::uint32_t>& triangles, const std::vector<bool>& triangleRemoved, const std::vector<std::vector<std::uint32_t> >& vertexTriangles, const std::vector<std::uint32_t>& localToGlobal, const float* vertices) const;
+
+public:
+
+	MeshSimplifier();
+	virtual ~MeshSimplifier();
+
+	/**
+	 * @param vertices All vertices of the mesh with four components per vertex.
+	 * @param normals Normals with three components per vertex. Can be null.
+	 * @param texCoords Texture coordinates with two components per vertex. Can be null.
+	 * @param indices Triangle list to simplify.
+	 * @param targetTriangleCount Simplification stops, when this amount of triangles is reached.
+	 * @param maxError Simplification stops, before a collapse exceeds this geometric error. Negative for no limit.
+	 * @param result The simplified triangle list.
+	 * @param resultError The largest geometric error of all performed collapses.
+	 */
+	void simplify(const float* vertices, const float* normals, const float* texCoords, std::uint32_t numberVertices, const std::uint32_t* indices, std::uint32_t numberIndices, std::uint32_t targetTriangleCount, float maxError, std::vector<std::uint32_t>& result, float& resultError) const;
+
+};
+
+#endif /* MESHSIMPLIFIER_H_ */
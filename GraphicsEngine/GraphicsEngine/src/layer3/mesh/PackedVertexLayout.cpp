@@ -0,0 +1,118 @@
+/*
+ * PackedVertexLayout.cpp
+ *
+ *  Created on: 19.10.2026
+ *      Author: nopper
+ */
+
+#include "PackedVertexLayout.h"
+
+using namespace std;
+
+PackedVertexLayout::PackedVertexLayout() :
+	tangents(false), texCoords(false), skinning(false), stride(0), normalOffset(0), bitangentOffset(0), tangentOffset(0), texCoordOffset(0), boneIndicesOffset(0), boneWeightsOffset(0), boneCounterOffset(0)
+{
+}
+
+PackedVertexLayout::PackedVertexLayout(bool tangents, bool texCoords, bool skinning) :
+	tangents(tangents), texCoords(texCoords), skinning(skinning), stride(0), normalOffset(0), bitangentOffset(0), tangentOffset(0), texCoordOffset(0), boneIndicesOffset(0), boneWeightsOffset(0), boneCounterOffset(0)
+{
+	stride = 3 * sizeof(GLfloat);
+
+	normalOffset = stride;
+	stride += 2 * sizeof(GLshort);
+
+	if (tangents)
+	{
+		bitangentOffset = stride;
+		stride += 2 * sizeof(GLshort);
+
+		tangentOffset = stride;
+		stride += 2 * sizeof(GLshort);
+	}
+
+	if (texCoords)
+	{
+		texCoordOffset = stride;
+		stride += 2 * sizeof(GLushort);
+	}
+
+	if (skinning)
+	{
+		boneIndicesOffset = stride;
+		stride += MAX_BONES * sizeof(GLubyte);
+
+		boneWeightsOffset = stride;
+		stride += MAX_BONES * sizeof(GLubyte);
+
+		boneCounterOffset = stride;
+		stride += sizeof(GLubyte);
+	}
+
+	// Keep every vertex four byte aligned.
+	stride = (stride + 3) & ~3;
+}
+
+PackedVertexLayout::~PackedVertexLayout()
+{
+}
+
+bool PackedVertexLayout::hasTangents() const
+{
+	return tangents;
+}
+
+bool PackedVertexLayout::hasTexCoords() const
+{
+	return texCoords;
+}
+
+bool PackedVertexLayout::hasSkinning() const
+{
+	return skinning;
+}
+
+GLsizei PackedVertexLayout::getStride() const
+{
+	return stride;
+}
+
+GLsizei PackedVertexLayout::getVertexOffset() const
+{
+	return 0;
+}
+
+GLsizei PackedVertexLayout::getNormalOffset() const
+{
+	return normalOffset;
+}
+
+GLsizei PackedVertexLayout::getBitangentOffset() const
+{
+	return bitangentOffset;
+}
+
+GLsizei PackedVertexLayout::getTangentOffset() const
+{
+	return tangentOffset;
+}
+
+GLsizei PackedVertexLayout::getTexCoordOffset() const
+{
+	return texCoordOffset;
+}
+
+GLsizei PackedVertexLayout::getBoneIndicesOffset() const
+{
+	return boneIndicesOffset;
+}
+
+GLsizei PackedVertexLayout::getBoneWeightsOffset() const
+{
+	return boneWeightsOffset;
+}
+
+GLsizei PackedVertexLayout::getBoneCounterOffset() const
+{
+	return boneCounterOffset;
+}
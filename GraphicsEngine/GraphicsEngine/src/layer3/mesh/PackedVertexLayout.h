@@ -0,0 +1,66 @@
+/*
+ * PackedVertexLayout.h
+ *
+ *  Created on: 19.10.2026
+ *      Author: nopper
+ */
+
+#ifndef PACKEDVERTEXLAYOUT_H_
+#define PACKEDVERTEXLAYOUT_H_
+
+#include "../../UsedLibs.h"
+
+/**
+ * Byte offsets of an interleaved, quantized vertex:
+ *
+ * Position as three floats, normal, bitangent and tangent each octahedral encoded as two shorts, texture coordinate as two half floats,
+ * eight bone indices as unsigned bytes, eight bone weights as normalized unsigned bytes and the bone counter as one unsigned byte.
+ * Attributes, which are not available, are left out. The stride is a multiple of four bytes.
+ */
+class PackedVertexLayout
+{
+
+private:
+
+	bool tangents;
+	bool texCoords;
+	bool skinning;
+
+	GLsizei stride;
+
+	GLsizei normalOffset;
+	GLsizei bitangentOffset;
+	GLsizei tangentOffset;
+	GLsizei texCoordOffset;
+	GLsizei boneIndicesOffset;
+	GLsizei boneWeightsOffset;
+	GLsizei boneCounterOffset;
+
+public:
+
+	static const std::int32_t MAX_BONES = 8;
+
+	PackedVertexLayout();
+	PackedVertexLayout(bool tangents, bool texCoords, bool skinning);
+	virtual ~PackedVertexLayout();
+
+	bool hasTangents() const;
+
+	bool hasTexCoords() const;
+
+	bool hasSkinning() const;
+
+	GLsizei getStride() const;
+
+	GLsizei getVertexOffset() const;
+	GLsizei getNormalOffset() const;
+	GLsizei getBitangentOffset() const;
+	GLsizei getTangentOffset() const;
+	GLsizei getTexCoordOffset() const;
+	GLsizei getBoneIndicesOffset() const;
+	GLsizei getBoneWeightsOffset() const;
+	GLsizei getBoneCounterOffset() const;
+
+};
+
+#endif /* PACKEDVERTEXLAYOUT_H_ */
@@ -0,0 +1,377 @@
+/*
+ * StaticBatch.cpp
+ *
+ *  Created on: 19.10.2026
+ *      Author: nopper
+ */
+
+#include "../../layer1/shader/ProgramFactory.h"
+#include "../../layer1/shader/RenderStateCache.h"
+#include "../../layer1/shader/Variables.h"
+#include "Mesh.h"
+
+#include "StaticBatch.h"
+
+using namespace std;
+
+StaticBatch::StaticBatch(const SurfaceMaterialSP& surfaceMaterial, bool tangents, bool texCoords) :
+	surfaceMaterial(surfaceMaterial), tangents(tangents), texCoords(texCoords), allVertices(), allNormals(), allBitangents(), allTangents(), allTexCoords(), allIndices(), allBaseVertices(), allFirstIndices(), allCommands(), modelMatrices(), minimum(), maximum(), vboVertices(0), vboNormals(0), vboBitangents(0), vboTangents(0), vboTexCoords(0), vboIndices(0), vboIndirect(0), allVAOs()
+{
+}
+
+StaticBatch::~StaticBatch()
+{
+	map<string, StaticBatchVAOSP>::iterator walker = allVAOs.begin();
+	while (walker != allVAOs.end())
+	{
+		walker->second.reset();
+
+		walker++;
+	}
+	allVAOs.clear();
+
+	if (isUploaded())
+	{
+		glDeleteBuffers(1, &vboVertices);
+		glDeleteBuffers(1, &vboNormals);
+		glDeleteBuffers(1, &vboBitangents);
+		glDeleteBuffers(1, &vboTangents);
+		glDeleteBuffers(1, &vboTexCoords);
+
+		glDeleteBuffers(1, &vboIndices);
+
+		glDeleteBuffers(1, &vboIndirect);
+	}
+}
+
+void StaticBatch::appendAttribute(vector<float>& target, const float* source, uint32_t numberVertices, uint32_t components) const
+{
+	if (source)
+	{
+		target.insert(target.end(), source, source + numberVertices * components);
+	}
+	else
+	{
+		target.resize(target.size() + numberVertices * components, 0.0f);
+	}
+}
+
+GLuint StaticBatch::createBuffer(GLenum target, const GLvoid* data, GLsizeiptr size) const
+{
+	GLuint buffer = 0;
+
+	glGenBuffers(1, &buffer);
+	glBindBuffer(target, buffer);
+	glBufferData(target, size, data, GL_STATIC_DRAW);
+	glBindBuffer(target, 0);
+
+	return buffer;
+}
+
+bool StaticBatch::isMultiDrawIndirectSupported()
+{
+	return GLEW_VERSION_4_3 || GLEW_ARB_multi_draw_indirect;
+}
+
+bool StaticBatch::isCompatible(const Mesh& mesh, int32_t subMeshIndex) const
+{
+	if (!mesh.containsSubMeshAt(subMeshIndex) || !mesh.containsSurfaceMaterialAt(subMeshIndex))
+	{
+		return false;
+	}
+
+	return !mesh.hasSkinning() && mesh.hasTangents() == tangents && mesh.hasTexCoords() == texCoords && mesh.getSurfaceMaterialAt(subMeshIndex) == surfaceMaterial;
+}
+
+bool StaticBatch::addSubMesh(const Mesh& mesh, int32_t subMeshIndex, const Matrix4x4& modelMatrix)
+{
+	if (isUploaded() || !isCompatible(mesh, subMeshIndex) || !mesh.getVertices() || !mesh.getIndices())
+	{
+		return false;
+	}
+
+	// Vertices of a mesh are shared by all its sub meshes and occurrences.
+	map<const Mesh*, GLint>::const_iterator baseVertexWalker = allBaseVertices.find(&mesh);
+
+	GLint baseVertex;
+
+	if (baseVertexWalker == allBaseVertices.end())
+	{
+		baseVertex = static_cast<GLint>(getNumberVertices());
+
+		appendAttribute(allVertices, mesh.getVertices(), mesh.getNumberVertices(), 4);
+		appendAttribute(allNormals, mesh.getNormals(), mesh.getNumberVertices(), 3);
+
+		if (tangents)
+		{
+			appendAttribute(allBitangents, mesh.getBitangents(), mesh.getNumberVertices(), 3);
+			appendAttribute(allTangents, mesh.getTangents(), mesh.getNumberVertices(), 3);
+		}
+
+		if (texCoords)
+		{
+			appendAttribute(allTexCoords, mesh.getTexCoords(), mesh.getNumberVertices(), 2);
+		}
+
+		allBaseVertices[&mesh] = baseVertex;
+	}
+	else
+	{
+		baseVertex = baseVertexWalker->second;
+	}
+
+	const SubMeshSP& subMesh = mesh.getSubMeshAt(subMeshIndex);
+
+	GLuint count = subMesh->getTriangleCount() * 3;
+
+	map<pair<const Mesh*, int32_t>, GLuint>::const_iterator firstIndexWalker = allFirstIndices.find(make_pair(&mesh, subMeshIndex));
+
+	GLuint firstIndex;
+
+	if (firstIndexWalker == allFirstIndices.end())
+	{
+		firstIndex = static_cast<GLuint>(allIndices.size());
+
+		// Indices stay relative to the mesh, the base vertex moves them to the packed vertices.
+		allIndices.insert(allIndices.end(), mesh.getIndices() + subMesh->getIndicesOffset(), mesh.getIndices() + subMesh->getIndicesOffset() + count);
+
+		allFirstIndices[make_pair(&mesh, subMeshIndex)] = firstIndex;
+	}
+	else
+	{
+		firstIndex = firstIndexWalker->second;
+	}
+
+	DrawElementsIndirectCommand command;
+
+	command.count = count;
+	command.instanceCount = 1;
+	command.firstIndex = firstIndex;
+	command.baseVertex = baseVertex;
+	command.baseInstance = static_cast<GLuint>(allCommands.size());
+
+	allCommands.push_back(command);
+
+	modelMatrices.addMatrix(modelMatrix);
+
+	// Bounds of the transformed vertices, which are actually referenced.
+	for (GLuint i = 0; i < count; i++)
+	{
+		Point4 vertex = modelMatrix * Point4(mesh.getVertices() + mesh.getIndices()[subMesh->getIndicesOffset() + i] * 4);
+
+		if (allCommands.size() == 1 && i == 0)
+		{
+			minimum = vertex;
+			maximum = vertex;
+
+			continue;
+		}
+
+		for (int32_t k = 0; k < 3; k++)
+		{
+			minimum[k] = glusMathMinf(minimum[k], vertex[k]);
+			maximum[k] = glusMathMaxf(maximum[k], vertex[k]);
+		}
+	}
+
+	return true;
+}
+
+void StaticBatch::upload()
+{
+	if (isUploaded() || allCommands.size() == 0)
+	{
+		return;
+	}
+
+	vboVertices = createBuffer(GL_ARRAY_BUFFER, allVertices.data(), allVertices.size() * sizeof(GLfloat));
+	vboNormals = createBuffer(GL_ARRAY_BUFFER, allNormals.data(), allNormals.size() * sizeof(GLfloat));
+
+	if (tangents)
+	{
+		vboBitangents = createBuffer(GL_ARRAY_BUFFER, allBitangents.data(), allBitangents.size() * sizeof(GLfloat));
+		vboTangents = createBuffer(GL_ARRAY_BUFFER, allTangents.data(), allTangents.size() * sizeof(GLfloat));
+	}
+
+	if (texCoords)
+	{
+		vboTexCoords = createBuffer(GL_ARRAY_BUFFER, allTexCoords.data(), allTexCoords.size() * sizeof(GLfloat));
+	}
+
+	vboIndices = createBuffer(GL_ELEMENT_ARRAY_BUFFER, allIndices.data(), allIndices.size() * sizeof(GLuint));
+
+	if (isMultiDrawIndirectSupported())
+	{
+		vboIndirect = createBuffer(GL_DRAW_INDIRECT_BUFFER, allCommands.data(), allCommands.size() * sizeof(DrawElementsIndirectCommand));
+	}
+
+	modelMatrices.upload();
+
+	ProgramFactory programFactory;
+
+	ProgramSP shaderprogram;
+
+	shaderprogram = programFactory.createPhongProgram();
+	allVAOs[shaderprogram->getType()] = StaticBatchVAOSP(new StaticBatchVAO(shaderprogram, *this));
+
+	shaderprogram = programFactory.createPhongRenderToCubeMapProgram();
+	allVAOs[shaderprogram->getType()] = StaticBatchVAOSP(new StaticBatchVAO(shaderprogram, *this));
+
+	shaderprogram = programFactory.createPhongRenderToShadowMapProgram();
+	allVAOs[shaderprogram->getType()] = StaticBatchVAOSP(new StaticBatchVAO(shaderprogram, *this));
+}
+
+bool StaticBatch::isUploaded() const
+{
+	return vboVertices != 0;
+}
+
+bool StaticBatch::containsVAOByProgramType(const string& type) const
+{
+	return allVAOs.find(type) != allVAOs.end();
+}
+
+const StaticBatchVAOSP& StaticBatch::getVAOByProgramType(const string& type) const
+{
+	return allVAOs.at(type);
+}
+
+void StaticBatch::draw(const string& programType) const
+{
+	map<string, StaticBatchVAOSP>::const_iterator walker = allVAOs.find(programType);
+
+	if (walker == allVAOs.end())
+	{
+		return;
+	}
+
+	const StaticBatchVAOSP& currentVAO = walker->second;
+
+	RenderStateCache::getInstance()->bindVertexArray(currentVAO->getVAOName());
+
+	if (vboIndirect)
+	{
+		glBindBuffer(GL_DRAW_INDIRECT_BUFFER, vboIndirect);
+
+		RenderStateCache::getInstance()->multiDrawElementsIndirect(GL_TRIANGLES, GL_UNSIGNED_INT, 0, static_cast<GLsizei>(allCommands.size()));
+
+		glBindBuffer(GL_DRAW_INDIRECT_BUFFER, 0);
+	}
+	else
+	{
+		// Without base instance support, the matrix attribute is moved to the matrix of each draw.
+		GLint location = currentVAO->getProgram()->getAttribLocation(a_instanceModelMatrix);
+
+		vector<DrawElementsIndirectCommand>::const_iterator commandWalker = allCommands.begin();
+		while (commandWalker != allCommands.end())
+		{
+			modelMatrices.enable(location, commandWalker->baseInstance);
+
+			RenderStateCache::getInstance()->drawElementsInstancedBaseVertex(GL_TRIANGLES, commandWalker->count, GL_UNSIGNED_INT, reinterpret_cast<const GLvoid*>(commandWalker->firstIndex * sizeof(GLuint)), 1, commandWalker->baseVertex);
+
+			commandWalker++;
+		}
+
+		modelMatrices.enable(location);
+	}
+}
+
+const SurfaceMaterialSP& StaticBatch::getSurfaceMaterial() const
+{
+	return surfaceMaterial;
+}
+
+bool StaticBatch::hasTangents() const
+{
+	return tangents;
+}
+
+bool StaticBatch::hasTexCoords() const
+{
+	return texCoords;
+}
+
+uint32_t StaticBatch::getNumberVertices() const
+{
+	return static_cast<uint32_t>(allVertices.size() / 4);
+}
+
+const vector<float>& StaticBatch::getVertices() const
+{
+	return allVertices;
+}
+
+const vector<float>& StaticBatch::getNormals() const
+{
+	return allNormals;
+}
+
+const vector<float>& StaticBatch::getBitangents() const
+{
+	return allBitangents;
+}
+
+const vector<float>& StaticBatch::getTangents() const
+{
+	return allTangents;
+}
+
+const vector<float>& StaticBatch::getTexCoords() const
+{
+	return allTexCoords;
+}
+
+const vector<uint32_t>& StaticBatch::getIndices() const
+{
+	return allIndices;
+}
+
+const vector<DrawElementsIndirectCommand>& StaticBatch::getCommands() const
+{
+	return allCommands;
+}
+
+const InstanceBuffer& StaticBatch::getModelMatrices() const
+{
+	return modelMatrices;
+}
+
+GLuint StaticBatch::getVboVertices() const
+{
+	return vboVertices;
+}
+
+GLuint StaticBatch::getVboNormals() const
+{
+	return vboNormals;
+}
+
+GLuint StaticBatch::getVboBitangents() const
+{
+	return vboBitangents;
+}
+
+GLuint StaticBatch::getVboTangents() const
+{
+	return vboTangents;
+}
+
+GLuint StaticBatch::getVboTexCoords() const
+{
+	return vboTexCoords;
+}
+
+GLuint StaticBatch::getVboIndices() const
+{
+	return vboIndices;
+}
+
+const Point4& StaticBatch::getMinimum() const
+{
+	return minimum;
+}
+
+const Point4& StaticBatch::getMaximum() const
+{
+	return maximum;
+}
@@ -0,0 +1,153 @@
+/*
+ * StaticBatch.h
+ *
+ *  Created on: 19.10.2026
+ *      Author: nopper
+ */
+
+#ifndef STATICBATCH_H_
+#define STATICBATCH_H_
+
+#include "../../UsedLibs.h"
+
+#include "../../layer0/math/Matrix4x4.h"
+#include "../../layer0/math/Point4.h"
+#include "../../layer1/shader/InstanceBuffer.h"
+#include "../../layer2/material/SurfaceMaterial.h"
+#include "StaticBatchVAO.h"
+
+class Mesh;
+
+/**
+ * Layout as expected by glMultiDrawElementsIndirect.
+ */
+struct DrawElementsIndirectCommand
+{
+	GLuint count;
+	GLuint instanceCount;
+	GLuint firstIndex;
+	GLint baseVertex;
+	GLuint baseInstance;
+};
+
+/**
+ * Vertices and indices of static sub meshes sharing one surface material and vertex layout, packed into shared buffers.
+ * Every added sub mesh results in one indirect draw command. A mesh, which is added several times, is only packed once.
+ * The base instance of a command selects its model matrix, which is sourced as an instanced attribute.
+ */
+class StaticBatch
+{
+
+private:
+
+	SurfaceMaterialSP surfaceMaterial;
+
+	bool tangents;
+	bool texCoords;
+
+	std::vector<float> allVertices;
+	std::vector<float> allNormals;
+	std::vector<float> allBitangents;
+	std::vector<float> allTangents;
+	std::vector<float> allTexCoords;
+
+	std::vector<std::uint32_t> allIndices;
+
+	std::map<const Mesh*, GLint> allBaseVertices;
+
+	std::map<std::pair<const Mesh*, std::int32_t>, GLuint> allFirstIndices;
+
+	std::vector<DrawElementsIndirectCommand> allCommands;
+
+	InstanceBuffer modelMatrices;
+
+	Point4 minimum;
+	Point4 maximum;
+
+	GLuint vboVertices;
+	GLuint vboNormals;
+	GLuint vboBitangents;
+	GLuint vboTangents;
+	GLuint vboTexCoords;
+
+	GLuint vboIndices;
+
+	GLuint vboIndirect;
+
+	std::map<std::string, StaticBatchVAOSP> allVAOs;
+
+	void appendAttribute(std::vector<float>& target, const float* source, std::uint32_t numberVertices, std::uint32_t components) const;
+
+	GLuint createBuffer(GLenum target, const GLvoid* data, GLsizeiptr size) const;
+
+public:
+
+	StaticBatch(const SurfaceMaterialSP& surfaceMaterial, bool tangents, bool texCoords);
+	virtual ~StaticBatch();
+
+	static bool isMultiDrawIndirectSupported();
+
+	/**
+	 * @return True, if the sub mesh can be packed into this batch.
+	 */
+	bool isCompatible(const Mesh& mesh, std::int32_t subMeshIndex) const;
+
+	/**
+	 * Packs the sub mesh at full resolution. Needs the CPU data of the mesh.
+	 */
+	bool addSubMesh(const Mesh& mesh, std::int32_t subMeshIndex, const Matrix4x4& modelMatrix);
+
+	/**
+	 * Creates the buffers and vertex arrays. Afterwards, no sub meshes can be added anymore.
+	 */
+	void upload();
+
+	bool isUploaded() const;
+
+	bool containsVAOByProgramType(const std::string& type) const;
+
+	const StaticBatchVAOSP& getVAOByProgramType(const std::string& type) const;
+
+	/**
+	 * Draws all commands with the vertex array of the given program type. Uniforms have to be set by the caller.
+	 */
+	void draw(const std::string& programType) const;
+
+	const SurfaceMaterialSP& getSurfaceMaterial() const;
+
+	bool hasTangents() const;
+
+	bool hasTexCoords() const;
+
+	std::uint32_t getNumberVertices() const;
+
+	const std::vector<float>& getVertices() const;
+	const std::vector<float>& getNormals() const;
+	const std::vector<float>& getBitangents() const;
+	const std::vector<float>& getTangents() const;
+	const std::vector<float>& getTexCoords() const;
+
+	const std::vector<std::uint32_t>& getIndices() const;
+
+	const std::vector<DrawElementsIndirectCommand>& getCommands() const;
+
+	const InstanceBuffer& getModelMatrices() const;
+
+	GLuint getVboVertices() const;
+	GLuint getVboNormals() const;
+	GLuint getVboBitangents() const;
+	GLuint getVboTangents() const;
+	GLuint getVboTexCoords() const;
+	GLuint getVboIndices() const;
+
+	/**
+	 * @return World space bounds of all packed sub meshes.
+	 */
+	const Point4& getMinimum() const;
+	const Point4& getMaximum() const;
+
+};
+
+typedef std::shared_ptr<StaticBatch> StaticBatchSP;
+
+#endif /* STATICBATCH_H_ */
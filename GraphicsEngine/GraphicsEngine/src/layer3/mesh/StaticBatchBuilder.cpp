@@ -0,0 +1,103 @@
+/*
+ * StaticBatchBuilder.cpp
+ *
+ *  Created on: 19.10.2026
+ *      Author: nopper
+ */
+
+#include "StaticBatchBuilder.h"
+
+using namespace std;
+
+StaticBatchBuilder::StaticBatchBuilder() :
+	allStaticBatches()
+{
+}
+
+StaticBatchBuilder::~StaticBatchBuilder()
+{
+	clear();
+}
+
+bool StaticBatchBuilder::addSubMesh(const Mesh& mesh, int32_t subMeshIndex, const Matrix4x4& modelMatrix)
+{
+	if (!mesh.containsSubMeshAt(subMeshIndex) || !mesh.containsSurfaceMaterialAt(subMeshIndex) || mesh.hasSkinning())
+	{
+		return false;
+	}
+
+	vector<StaticBatchSP>::iterator walker = allStaticBatches.begin();
+	while (walker != allStaticBatches.end())
+	{
+		if (!(*walker)->isUploaded() && (*walker)->isCompatible(mesh, subMeshIndex))
+		{
+			return (*walker)->addSubMesh(mesh, subMeshIndex, modelMatrix);
+		}
+
+		walker++;
+	}
+
+	StaticBatchSP staticBatch = StaticBatchSP(new StaticBatch(mesh.getSurfaceMaterialAt(subMeshIndex), mesh.hasTangents(), mesh.hasTexCoords()));
+
+	if (!staticBatch->addSubMesh(mesh, subMeshIndex, modelMatrix))
+	{
+		return false;
+	}
+
+	allStaticBatches.push_back(staticBatch);
+
+	return true;
+}
+
+bool StaticBatchBuilder::addMesh(const Mesh& mesh, const Matrix4x4& modelMatrix)
+{
+	bool result = true;
+
+	for (uint32_t subMeshIndex = 0; subMeshIndex < mesh.getSubMeshesCount(); subMeshIndex++)
+	{
+		if (!addSubMesh(mesh, static_cast<int32_t>(subMeshIndex), modelMatrix))
+		{
+			result = false;
+		}
+	}
+
+	return result;
+}
+
+const vector<StaticBatchSP>& StaticBatchBuilder::build()
+{
+	vector<StaticBatchSP>::iterator walker = allStaticBatches.begin();
+	while (walker != allStaticBatches.end())
+	{
+		(*walker)->upload();
+
+		walker++;
+	}
+
+	return allStaticBatches;
+}
+
+const vector<StaticBatchSP>& StaticBatchBuilder::getStaticBatches() const
+{
+	return allStaticBatches;
+}
+
+uint32_t StaticBatchBuilder::getNumberCommands() const
+{
+	uint32_t numberCommands = 0;
+
+	vector<StaticBatchSP>::const_iterator walker = allStaticBatches.begin();
+	while (walker != allStaticBatches.end())
+	{
+		numberCommands += static_cast<uint32_t>((*walker)->getCommands().size());
+
+		walker++;
+	}
+
+	return numberCommands;
+}
+
+void StaticBatchBuilder::clear()
+{
+	allStaticBatches.clear();
+}
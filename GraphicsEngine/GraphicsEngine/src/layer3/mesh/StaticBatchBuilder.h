@@ -0,0 +1,61 @@
+/*
+ * StaticBatchBuilder.h
+ *
+ *  Created on: 19.10.2026
+ *      Author: nopper
+ */
+
+#ifndef STATICBATCHBUILDER_H_
+#define STATICBATCHBUILDER_H_
+
+#include "../../UsedLibs.h"
+
+#include "../../layer0/math/Matrix4x4.h"
+#include "Mesh.h"
+#include "StaticBatch.h"
+
+/**
+ * Distributes static sub meshes to batches. Sub meshes with the same surface material and vertex layout end up in the same batch,
+ * so each batch can be drawn with one multi draw indirect call.
+ */
+class StaticBatchBuilder
+{
+
+private:
+
+	std::vector<StaticBatchSP> allStaticBatches;
+
+public:
+
+	StaticBatchBuilder();
+	virtual ~StaticBatchBuilder();
+
+	/**
+	 * @return False, if the sub mesh can not be batched e.g. because of skinning or missing CPU data.
+	 */
+	bool addSubMesh(const Mesh& mesh, std::int32_t subMeshIndex, const Matrix4x4& modelMatrix);
+
+	/**
+	 * Adds all sub meshes of the mesh.
+	 *
+	 * @return False, if at least one sub mesh could not be batched.
+	 */
+	bool addMesh(const Mesh& mesh, const Matrix4x4& modelMatrix);
+
+	/**
+	 * Uploads all batches. No sub meshes can be added to the returned batches anymore.
+	 */
+	const std::vector<StaticBatchSP>& build();
+
+	const std::vector<StaticBatchSP>& getStaticBatches() const;
+
+	/**
+	 * @return Total number of indirect draw commands of all batches.
+	 */
+	std::uint32_t getNumberCommands() const;
+
+	void clear();
+
+};
+
+#endif /* STATICBATCHBUILDER_H_ */
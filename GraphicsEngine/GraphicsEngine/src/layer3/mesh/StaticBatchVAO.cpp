@@ -0,0 +1,62 @@
+/*
+ * StaticBatchVAO.cpp
+ *
+ *  Created on: 19.10.2026
+ *      Author: nopper
+ */
+
+#include "../../layer1/shader/Variables.h"
+#include "StaticBatch.h"
+
+#include "StaticBatchVAO.h"
+
+StaticBatchVAO::StaticBatchVAO(const ProgramSP& program, const StaticBatch& staticBatch) :
+	VAO(program)
+{
+	generateVAO();
+
+	update(staticBatch);
+}
+
+StaticBatchVAO::~StaticBatchVAO()
+{
+	deleteVAO();
+}
+
+void StaticBatchVAO::update(const StaticBatch& staticBatch) const
+{
+	glBindBuffer(GL_ARRAY_BUFFER, staticBatch.getVboVertices());
+	glVertexAttribPointer(program->getAttribLocation(a_vertex), 4, GL_FLOAT, GL_FALSE, 0, 0);
+	glEnableVertexAttribArray(program->getAttribLocation(a_vertex));
+
+	glBindBuffer(GL_ARRAY_BUFFER, staticBatch.getVboNormals());
+	glVertexAttribPointer(program->getAttribLocation(a_normal), 3, GL_FLOAT, GL_FALSE, 0, 0);
+	glEnableVertexAttribArray(program->getAttribLocation(a_normal));
+
+	if (staticBatch.hasTangents())
+	{
+		glBindBuffer(GL_ARRAY_BUFFER, staticBatch.getVboBitangents());
+		glVertexAttribPointer(program->getAttribLocation(a_bitangent), 3, GL_FLOAT, GL_FALSE, 0, 0);
+		glEnableVertexAttribArray(program->getAttribLocation(a_bitangent));
+
+		glBindBuffer(GL_ARRAY_BUFFER, staticBatch.getVboTangents());
+		glVertexAttribPointer(program->getAttribLocation(a_tangent), 3, GL_FLOAT, GL_FALSE, 0, 0);
+		glEnableVertexAttribArray(program->getAttribLocation(a_tangent));
+	}
+
+	if (staticBatch.hasTexCoords())
+	{
+		glBindBuffer(GL_ARRAY_BUFFER, staticBatch.getVboTexCoords());
+		glVertexAttribPointer(program->getAttribLocation(a_texCoord), 2, GL_FLOAT, GL_FALSE, 0, 0);
+		glEnableVertexAttribArray(program->getAttribLocation(a_texCoord));
+	}
+
+	// The vertex array is owned by the batch, so the per draw matrices stay enabled.
+	staticBatch.getModelMatrices().enable(program->getAttribLocation(a_instanceModelMatrix));
+
+	glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, staticBatch.getVboIndices());
+
+	glEnableVertexAttribArray(0);
+
+	unbind();
+}
@@ -0,0 +1,28 @@
+/*
+ * StaticBatchVAO.h
+ *
+ *  Created on: 19.10.2026
+ *      Author: nopper
+ */
+
+#ifndef STATICBATCHVAO_H_
+#define STATICBATCHVAO_H_
+
+#include "../../layer1/shader/Program.h"
+#include "../../layer1/shader/VAO.h"
+
+class StaticBatch;
+
+class StaticBatchVAO : public VAO
+{
+public:
+	StaticBatchVAO(const ProgramSP& program, const StaticBatch& staticBatch);
+	virtual ~StaticBatchVAO();
+
+	void update(const StaticBatch& staticBatch) const;
+
+};
+
+typedef std::shared_ptr<StaticBatchVAO> StaticBatchVAOSP;
+
+#endif /* STATICBATCHVAO_H_ */
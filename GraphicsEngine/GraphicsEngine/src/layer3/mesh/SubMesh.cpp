@@ -10,8 +10,9 @@
 using namespace std;
 
 SubMesh::SubMesh(uint32_t indicesOffset, uint32_t triangleCount) :
-	indicesOffset(indicesOffset), triangleCount(triangleCount), allVAOs()
+	indicesOffset(indicesOffset), triangleCount(triangleCount), allVAOs(), lodIndicesOffsets(), lodTriangleCounts(), lodErrors()
 {
+	addLod(indicesOffset, triangleCount, 0.0f);
 }
 
 SubMesh::~SubMesh()
@@ -41,6 +42,45 @@ void SubMesh::addVAO(const SubMeshVAOSP& vao)
 	allVAOs[vao->getProgramType()] = vao;
 }
 
+void SubMesh::addLod(uint32_t indicesOffset, uint32_t triangleCount, float error)
+{
+	lodIndicesOffsets.push_back(indicesOffset);
+	lodTriangleCounts.push_back(triangleCount);
+	lodErrors.push_back(error);
+}
+
+uint32_t SubMesh::getNumberLods() const
+{
+	return static_cast<uint32_t>(lodErrors.size());
+}
+
+uint32_t SubMesh::getIndicesOffset(uint32_t lod) const
+{
+	return lodIndicesOffsets[lod];
+}
+
+uint32_t SubMesh::getTriangleCount(uint32_t lod) const
+{
+	return lodTriangleCounts[lod];
+}
+
+float SubMesh::getLodError(uint32_t lod) const
+{
+	return lodErrors[lod];
+}
+
+uint32_t SubMesh::selectLod(float allowedError) const
+{
+	uint32_t lod = 0;
+
+	while (lod + 1 < lodErrors.size() && lodErrors[lod + 1] <= allowedError)
+	{
+		lod++;
+	}
+
+	return lod;
+}
+
 bool SubMesh::containsVAOByProgramType(const string& type) const
 {
 	return allVAOs.find(type) != allVAOs.end();
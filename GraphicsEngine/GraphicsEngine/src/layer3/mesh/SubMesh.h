@@ -25,8 +25,14 @@ private:
 
 	std::map<std::string, SubMeshVAOSP> allVAOs;
 
+	std::vector<std::uint32_t> lodIndicesOffsets;
+	std::vector<std::uint32_t> lodTriangleCounts;
+	std::vector<float> lodErrors;
+
 	void addVAO(const SubMeshVAOSP& vao);
 
+	void addLod(std::uint32_t indicesOffset, std::uint32_t triangleCount, float error);
+
 public:
 
 	SubMesh(std::uint32_t indicesOffset, std::uint32_t triangleCount);
@@ -37,6 +43,25 @@ public:
 
 	std::uint32_t getTriangleCount() const;
 
+	/**
+	 * @return Number of levels of detail including the full resolution level zero.
+	 */
+	std::uint32_t getNumberLods() const;
+
+	std::uint32_t getIndicesOffset(std::uint32_t lod) const;
+
+	std::uint32_t getTriangleCount(std::uint32_t lod) const;
+
+	/**
+	 * @return Geometric error of the given level in object space.
+	 */
+	float getLodError(std::uint32_t lod) const;
+
+	/**
+	 * @return The coarsest level, which does not exceed the given error.
+	 */
+	std::uint32_t selectLod(float allowedError) const;
+
 	bool containsVAOByProgramType(const std::string& type) const;
 
 	const SubMeshVAOSP& getVAOByProgramType(const std::string& type) const;
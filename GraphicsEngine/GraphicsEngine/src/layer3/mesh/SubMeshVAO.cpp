@@ -25,6 +25,13 @@ SubMeshVAO::~SubMeshVAO()
 
 void SubMeshVAO::update(const Mesh& mesh) const
 {
+	if (mesh.isPacked())
+	{
+		updatePacked(mesh);
+
+		return;
+	}
+
 	glBindBuffer(GL_ARRAY_BUFFER, mesh.getVboVertices());
 	glVertexAttribPointer(program->getAttribLocation(a_vertex), 4, GL_FLOAT, GL_FALSE, 0, 0);
 	glEnableVertexAttribArray(program->getAttribLocation(a_vertex));
@@ -78,3 +85,56 @@ void SubMeshVAO::update(const Mesh& mesh) const
 
 	unbind();
 }
+
+void SubMeshVAO::updatePacked(const Mesh& mesh) const
+{
+	const PackedVertexLayout& layout = mesh.getPackedVertexLayout();
+
+	GLsizei stride = layout.getStride();
+
+	glBindBuffer(GL_ARRAY_BUFFER, mesh.getVboPackedVertices());
+
+	glVertexAttribPointer(program->getAttribLocation(a_vertex), 3, GL_FLOAT, GL_FALSE, stride, reinterpret_cast<const GLvoid*>(layout.getVertexOffset()));
+	glEnableVertexAttribArray(program->getAttribLocation(a_vertex));
+
+	// Not normalized by GL, as the conversion of signed values differs between versions. The shader scales and decodes.
+	glVertexAttribPointer(program->getAttribLocation(a_normal), 2, GL_SHORT, GL_FALSE, stride, reinterpret_cast<const GLvoid*>(layout.getNormalOffset()));
+	glEnableVertexAttribArray(program->getAttribLocation(a_normal));
+
+	if (layout.hasTangents())
+	{
+		glVertexAttribPointer(program->getAttribLocation(a_bitangent), 2, GL_SHORT, GL_FALSE, stride, reinterpret_cast<const GLvoid*>(layout.getBitangentOffset()));
+		glEnableVertexAttribArray(program->getAttribLocation(a_bitangent));
+
+		glVertexAttribPointer(program->getAttribLocation(a_tangent), 2, GL_SHORT, GL_FALSE, stride, reinterpret_cast<const GLvoid*>(layout.getTangentOffset()));
+		glEnableVertexAttribArray(program->getAttribLocation(a_tangent));
+	}
+
+	if (layout.hasTexCoords())
+	{
+		glVertexAttribPointer(program->getAttribLocation(a_texCoord), 2, GL_HALF_FLOAT, GL_FALSE, stride, reinterpret_cast<const GLvoid*>(layout.getTexCoordOffset()));
+		glEnableVertexAttribArray(program->getAttribLocation(a_texCoord));
+	}
+
+	if (layout.hasSkinning())
+	{
+		glVertexAttribPointer(program->getAttribLocation(a_boneIndex_0), 4, GL_UNSIGNED_BYTE, GL_FALSE, stride, reinterpret_cast<const GLvoid*>(layout.getBoneIndicesOffset()));
+		glEnableVertexAttribArray(program->getAttribLocation(a_boneIndex_0));
+		glVertexAttribPointer(program->getAttribLocation(a_boneIndex_1), 4, GL_UNSIGNED_BYTE, GL_FALSE, stride, reinterpret_cast<const GLvoid*>(layout.getBoneIndicesOffset() + 4));
+		glEnableVertexAttribArray(program->getAttribLocation(a_boneIndex_1));
+
+		glVertexAttribPointer(program->getAttribLocation(a_boneWeight_0), 4, GL_UNSIGNED_BYTE, GL_TRUE, stride, reinterpret_cast<const GLvoid*>(layout.getBoneWeightsOffset()));
+		glEnableVertexAttribArray(program->getAttribLocation(a_boneWeight_0));
+		glVertexAttribPointer(program->getAttribLocation(a_boneWeight_1), 4, GL_UNSIGNED_BYTE, GL_TRUE, stride, reinterpret_cast<const GLvoid*>(layout.getBoneWeightsOffset() + 4));
+		glEnableVertexAttribArray(program->getAttribLocation(a_boneWeight_1));
+
+		glVertexAttribPointer(program->getAttribLocation(a_boneCounter), 1, GL_UNSIGNED_BYTE, GL_FALSE, stride, reinterpret_cast<const GLvoid*>(layout.getBoneCounterOffset()));
+		glEnableVertexAttribArray(program->getAttribLocation(a_boneCounter));
+	}
+
+	glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, mesh.getVboIndices());
+
+	glEnableVertexAttribArray(0);
+
+	unbind();
+}
@@ -15,6 +15,10 @@ class Mesh;
 
 class SubMeshVAO : public VAO
 {
+private:
+
+	void updatePacked(const Mesh& mesh) const;
+
 public:
 	SubMeshVAO(const ProgramSP& program, const Mesh& mesh);
 	virtual ~SubMeshVAO();
@@ -0,0 +1,357 @@
+/*
+ * VertexCacheOptimizer.cpp
+ *
+ *  Created on: 19.10.2026
+ *      Author: nopper
+ */
+
+#include "VertexCacheOptimizer.h"
+
+using namespace std;
+
+VertexCacheOptimizer::VertexCacheOptimizer(uint32_t cacheSize) :
+	cacheSize(cacheSize)
+{
+}
+
+VertexCacheOptimizer::~VertexCacheOptimizer()
+{
+}
+
+uint32_t VertexCacheOptimizer::getCacheSize() const
+{
+	return cacheSize;
+}
+
+int32_t VertexCacheOptimizer::getNextVertex(uint32_t numberVertices, uint32_t& cursor, const vector<uint32_t>& candidates, const vector<uint32_t>& cacheTimeStamps, uint32_t timeStamp, const vector<uint32_t>& liveTriangles, vector<uint32_t>& deadEnds, bool& jumped) const
+{
+	int32_t bestVertex = -1;
+	int32_t bestPriority = -1;
+
+	// Prefer the oldest vertex, which still stays in the cache while its remaining triangles are emitted.
+	vector<uint32_t>::const_iterator walker = candidates.begin();
+	while (walker != candidates.end())
+	{
+		uint32_t vertex = *walker;
+
+		if (liveTriangles[vertex] > 0)
+		{
+			int32_t priority = 0;
+
+			if (timeStamp - cacheTimeStamps[vertex] + 2 * liveTriangles[vertex] <= cacheSize)
+			{
+				priority = static_cast<int32_t>(timeStamp - cacheTimeStamps[vertex]);
+			}
+
+			if (priority > bestPriority)
+			{
+				bestPriority = priority;
+				bestVertex = static_cast<int32_t>(vertex);
+			}
+		}
+
+		walker++;
+	}
+
+	if (bestVertex >= 0)
+	{
+		jumped = false;
+
+		return bestVertex;
+	}
+
+	jumped = true;
+
+	// Dead end, so try recently used vertices first.
+	while (deadEnds.size() > 0)
+	{
+		uint32_t vertex = deadEnds.back();
+		deadEnds.pop_back();
+
+		if (liveTriangles[vertex] > 0)
+		{
+			return static_cast<int32_t>(vertex);
+		}
+	}
+
+	while (cursor < numberVertices)
+	{
+		if (liveTriangles[cursor] > 0)
+		{
+			return static_cast<int32_t>(cursor);
+		}
+
+		cursor++;
+	}
+
+	return -1;
+}
+
+void VertexCacheOptimizer::optimizeVertexCache(const uint32_t* indices, uint32_t numberIndices, uint32_t numberVertices, vector<uint32_t>& result, vector<uint32_t>* clusters) const
+{
+	uint32_t numberTriangles = numberIndices / 3;
+
+	result.clear();
+	result.reserve(numberTriangles * 3);
+
+	if (clusters)
+	{
+		clusters->clear();
+	}
+
+	if (numberTriangles == 0)
+	{
+		return;
+	}
+
+	// Triangles adjacent to each vertex, stored as offsets into one array.
+	vector<uint32_t> liveTriangles(numberVertices, 0);
+
+	for (uint32_t i = 0; i < numberTriangles * 3; i++)
+	{
+		liveTriangles[indices[i]]++;
+	}
+
+	vector<uint32_t> adjacencyOffsets(numberVertices + 1, 0);
+
+	for (uint32_t vertex = 0; vertex < numberVertices; vertex++)
+	{
+		adjacencyOffsets[vertex + 1] = adjacencyOffsets[vertex] + liveTriangles[vertex];
+	}
+
+	vector<uint32_t> adjacency(adjacencyOffsets[numberVertices]);
+	vector<uint32_t> fill(adjacencyOffsets.begin(), adjacencyOffsets.end() - 1);
+
+	for (uint32_t i = 0; i < numberTriangles * 3; i++)
+	{
+		adjacency[fill[indices[i]]++] = i / 3;
+	}
+
+	vector<uint32_t> cacheTimeStamps(numberVertices, 0);
+	vector<bool> emitted(numberTriangles, false);
+	vector<uint32_t> deadEnds;
+	vector<uint32_t> candidates;
+
+	uint32_t timeStamp = cacheSize + 1;
+	uint32_t cursor = 0;
+	bool jumped = true;
+
+	int32_t fanningVertex = getNextVertex(numberVertices, cursor, candidates, cacheTimeStamps, timeStamp, liveTriangles, deadEnds, jumped);
+
+	while (fanningVertex >= 0)
+	{
+		if (jumped && clusters)
+		{
+			clusters->push_back(static_cast<uint32_t>(result.size() / 3));
+		}
+
+		candidates.clear();
+
+		for (uint32_t k = adjacencyOffsets[fanningVertex]; k < adjacencyOffsets[fanningVertex + 1]; k++)
+		{
+			uint32_t triangle = adjacency[k];
+
+			if (emitted[triangle])
+			{
+				continue;
+			}
+
+			for (uint32_t corner = 0; corner < 3; corner++)
+			{
+				uint32_t vertex = indices[triangle * 3 + corner];
+
+				result.push_back(vertex);
+
+				deadEnds.push_back(vertex);
+				candidates.push_back(vertex);
+
+				liveTriangles[vertex]--;
+
+				if (timeStamp - cacheTimeStamps[vertex] > cacheSize)
+				{
+					cacheTimeStamps[vertex] = timeStamp;
+					timeStamp++;
+				}
+			}
+
+			emitted[triangle] = true;
+		}
+
+		fanningVertex = getNextVertex(numberVertices, cursor, candidates, cacheTimeStamps, timeStamp, liveTriangles, deadEnds, jumped);
+	}
+}
+
+void VertexCacheOptimizer::optimizeOverdraw(const float* vertices, const uint32_t* indices, uint32_t numberIndices, const vector<uint32_t>& clusters, vector<uint32_t>& result) const
+{
+	uint32_t numberTriangles = numberIndices / 3;
+
+	result.assign(indices, indices + numberTriangles * 3);
+
+	if (clusters.size() < 2)
+	{
+		return;
+	}
+
+	float meshCenter[3] = { 0.0f, 0.0f, 0.0f };
+
+	for (uint32_t i = 0; i < numberTriangles * 3; i++)
+	{
+		for (int32_t k = 0; k < 3; k++)
+		{
+			meshCenter[k] += vertices[indices[i] * 4 + k];
+		}
+	}
+
+	for (int32_t k = 0; k < 3; k++)
+	{
+		meshCenter[k] /= static_cast<float>(numberTriangles * 3);
+	}
+
+	vector<pair<float, uint32_t> > sortKeys(clusters.size());
+
+	for (uint32_t cluster = 0; cluster < clusters.size(); cluster++)
+	{
+		uint32_t begin = clusters[cluster];
+		uint32_t end = cluster + 1 < clusters.size() ? clusters[cluster + 1] : numberTriangles;
+
+		float center[3] = { 0.0f, 0.0f, 0.0f };
+		float normal[3] = { 0.0f, 0.0f, 0.0f };
+
+		for (uint32_t triangle = begin; triangle < end; triangle++)
+		{
+			const float* p0 = &vertices[indices[triangle * 3 + 0] * 4];
+			const float* p1 = &vertices[indices[triangle * 3 + 1] * 4];
+			const float* p2 = &vertices[indices[triangle * 3 + 2] * 4];
+
+			float edge0[3] = { p1[0] - p0[0], p1[1] - p0[1], p1[2] - p0[2] };
+			float edge1[3] = { p2[0] - p0[0], p2[1] - p0[1], p2[2] - p0[2] };
+
+			// Area weighted normal
+			normal[0] += edge0[1] * edge1[2] - edge0[2] * edge1[1];
+			normal[1] += edge0[2] * edge1[0] - edge0[0] * edge1[2];
+			normal[2] += edge0[0] * edge1[1] - edge0[1] * edge1[0];
+
+			for (int32_t k = 0; k < 3; k++)
+			{
+				center[k] += (p0[k] + p1[k] + p2[k]) / 3.0f;
+			}
+		}
+
+		float dot = 0.0f;
+
+		for (int32_t k = 0; k < 3; k++)
+		{
+			center[k] /= static_cast<float>(end - begin);
+
+			dot += (center[k] - meshCenter[k]) * normal[k];
+		}
+
+		// Descending order by sorting the negated value.
+		sortKeys[cluster] = make_pair(-dot, cluster);
+	}
+
+	stable_sort(sortKeys.begin(), sortKeys.end());
+
+	uint32_t target = 0;
+
+	vector<pair<float, uint32_t> >::const_iterator walker = sortKeys.begin();
+	while (walker != sortKeys.end())
+	{
+		uint32_t cluster = walker->second;
+
+		uint32_t begin = clusters[cluster];
+		uint32_t end = cluster + 1 < clusters.size() ? clusters[cluster + 1] : numberTriangles;
+
+		for (uint32_t i = begin * 3; i < end * 3; i++)
+		{
+			result[target++] = indices[i];
+		}
+
+		walker++;
+	}
+}
+
+void VertexCacheOptimizer::optimizeVertexFetch(uint32_t* indices, uint32_t numberIndices, uint32_t numberVertices, vector<uint32_t>& remap) const
+{
+	static const uint32_t UNUSED = static_cast<uint32_t>(-1);
+
+	remap.assign(numberVertices, UNUSED);
+
+	uint32_t nextVertex = 0;
+
+	for (uint32_t i = 0; i < numberIndices; i++)
+	{
+		uint32_t& vertex = remap[indices[i]];
+
+		if (vertex == UNUSED)
+		{
+			vertex = nextVertex++;
+		}
+
+		indices[i] = vertex;
+	}
+
+	for (uint32_t vertex = 0; vertex < numberVertices; vertex++)
+	{
+		if (remap[vertex] == UNUSED)
+		{
+			remap[vertex] = nextVertex++;
+		}
+	}
+}
+
+void VertexCacheOptimizer::remapVertices(float* data, uint32_t numberVertices, uint32_t components, const vector<uint32_t>& remap) const
+{
+	if (!data)
+	{
+		return;
+	}
+
+	vector<float> copy(data, data + numberVertices * components);
+
+	for (uint32_t vertex = 0; vertex < numberVertices; vertex++)
+	{
+		memcpy(&data[remap[vertex] * components], &copy[vertex * components], components * sizeof(float));
+	}
+}
+
+void VertexCacheOptimizer::analyzeVertexCache(const uint32_t* indices, uint32_t numberIndices, uint32_t numberVertices, uint32_t simulatedCacheSize, float& acmr, float& atvr) const
+{
+	acmr = 0.0f;
+	atvr = 0.0f;
+
+	uint32_t numberTriangles = numberIndices / 3;
+
+	if (numberTriangles == 0)
+	{
+		return;
+	}
+
+	// A vertex is in the cache, if it has been inserted within the last cache size misses.
+	vector<uint32_t> insertedAt(numberVertices, 0);
+	vector<bool> used(numberVertices, false);
+
+	uint32_t misses = 0;
+	uint32_t usedVertices = 0;
+
+	for (uint32_t i = 0; i < numberTriangles * 3; i++)
+	{
+		uint32_t vertex = indices[i];
+
+		if (!used[vertex])
+		{
+			used[vertex] = true;
+			usedVertices++;
+		}
+		else if (misses - insertedAt[vertex] < simulatedCacheSize)
+		{
+			continue;
+		}
+
+		insertedAt[vertex] = misses;
+		misses++;
+	}
+
+	acmr = static_cast<float>(misses) / static_cast<float>(numberTriangles);
+	atvr = static_cast<float>(misses) / static_cast<float>(usedVertices);
+}
@@ -0,0 +1,67 @@
+/*
+ * VertexCacheOptimizer.h
+ *
+ *  Created on: 19.10.2026
+ *      Author: nopper
+ */
+
+#ifndef VERTEXCACHEOPTIMIZER_H_
+#define VERTEXCACHEOPTIMIZER_H_
+
+#include "../../UsedLibs.h"
+
+/**
+ * Reorders triangles for the post transform vertex cache using Tipsify, optionally followed by an overdraw aware ordering of the
+ * resulting clusters. Vertices can be reordered by first use, so fetching them is sequential. All passes only work on the CPU.
+ */
+class VertexCacheOptimizer
+{
+
+private:
+
+	std::uint32_t cacheSize;
+
+	std::int32_t getNextVertex(std::uint32_t numberVertices, std::uint32_t& cursor, const std::vector<std::uint32_t>& candidates, const std::vector<std::uint32_t>& cacheTimeStamps, std::uint32_t timeStamp, const std::vector<std::uint32_t>& liveTriangles, std::vector<std::uint32_t>& deadEnds, bool& jumped) const;
+
+public:
+
+	VertexCacheOptimizer(std::uint32_t cacheSize = 16);
+	virtual ~VertexCacheOptimizer();
+
+	std::uint32_t getCacheSize() const;
+
+	/**
+	 * @param clusters If not null, receives the first triangle of each cluster. A cluster ends, where the cache had to be left.
+	 */
+	void optimizeVertexCache(const std::uint32_t* indices, std::uint32_t numberIndices, std::uint32_t numberVertices, std::vector<std::uint32_t>& result, std::vector<std::uint32_t>* clusters = nullptr) const;
+
+	/**
+	 * Sorts the clusters, so the ones facing outwards of the mesh are drawn first. This occludes the inner ones in most views.
+	 *
+	 * @param vertices All vertices of the mesh with four components per vertex.
+	 */
+	void optimizeOverdraw(const float* vertices, const std::uint32_t* indices, std::uint32_t numberIndices, const std::vector<std::uint32_t>& clusters, std::vector<std::uint32_t>& result) const;
+
+	/**
+	 * Renumbers the vertices in order of their first use. Vertices, which are not used, are moved to the end.
+	 *
+	 * @param remap Receives the new position of each old vertex.
+	 */
+	void optimizeVertexFetch(std::uint32_t* indices, std::uint32_t numberIndices, std::uint32_t numberVertices, std::vector<std::uint32_t>& remap) const;
+
+	/**
+	 * Moves the vertex attributes to the positions given by the remap table.
+	 */
+	void remapVertices(float* data, std::uint32_t numberVertices, std::uint32_t components, const std::vector<std::uint32_t>& remap) const;
+
+	/**
+	 * Simulates a FIFO cache of the given size.
+	 *
+	 * @param acmr Average cache miss ratio, which are the transformed vertices per triangle.
+	 * @param atvr Average transform to vertex ratio, which is one at best.
+	 */
+	void analyzeVertexCache(const std::uint32_t* indices, std::uint32_t numberIndices, std::uint32_t numberVertices, std::uint32_t simulatedCacheSize, float& acmr, float& atvr) const;
+
+};
+
+#endif /* VERTEXCACHEOPTIMIZER_H_ */
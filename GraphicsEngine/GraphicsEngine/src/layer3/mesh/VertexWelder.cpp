@@ -0,0 +1,213 @@
+/*
+ * VertexWelder.cpp
+ *
+ *  Created on: 19.10.2026
+ *      Author: nopper
+ */
+
+#include "VertexWelder.h"
+
+using namespace std;
+
+static const uint32_t NO_VERTEX = static_cast<uint32_t>(-1);
+
+static uint32_t hashCell(int64_t x, int64_t y, int64_t z)
+{
+	uint64_t hash = static_cast<uint64_t>(x) * 73856093u;
+	hash ^= static_cast<uint64_t>(y) * 19349663u;
+	hash ^= static_cast<uint64_t>(z) * 83492791u;
+
+	return static_cast<uint32_t>(hash ^ (hash >> 32));
+}
+
+VertexWelder::VertexWelder(float epsilon) :
+	epsilon(epsilon), allAttributes()
+{
+}
+
+VertexWelder::~VertexWelder()
+{
+}
+
+float VertexWelder::getEpsilon() const
+{
+	return epsilon;
+}
+
+bool VertexWelder::isEqual(uint32_t first, uint32_t second) const
+{
+	for (auto& currentAttribute : allAttributes)
+	{
+		const float* firstValues = &currentAttribute.data[first * currentAttribute.components];
+		const float* secondValues = &currentAttribute.data[second * currentAttribute.components];
+
+		for (uint32_t k = 0; k < currentAttribute.components; k++)
+		{
+			// Written negated, so not a number never matches.
+			if (currentAttribute.exact ? !(firstValues[k] == secondValues[k]) : !(fabs(firstValues[k] - secondValues[k]) <= epsilon))
+			{
+				return false;
+			}
+		}
+	}
+
+	return true;
+}
+
+void VertexWelder::getCells(float value, int64_t& cell, int64_t& neighborCell) const
+{
+	if (epsilon <= 0.0f)
+	{
+		// Identical values share the cell. Adding zero turns a negative zero into a positive one.
+		float normalized = value + 0.0f;
+
+		int32_t bits;
+		memcpy(&bits, &normalized, sizeof(bits));
+
+		cell = static_cast<int64_t>(bits);
+		neighborCell = cell;
+
+		return;
+	}
+
+	double scaled = static_cast<double>(value) / (2.0 * static_cast<double>(epsilon));
+	double lower = floor(scaled);
+
+	// Huge values and not a number share one cell. They are still compared one by one.
+	if (!(lower > -4.0e18 && lower < 4.0e18))
+	{
+		cell = 0;
+		neighborCell = 0;
+
+		return;
+	}
+
+	cell = static_cast<int64_t>(lower);
+
+	// A cell is two epsilon wide, so a value within the epsilon is either in this cell or in the nearer neighbor.
+	neighborCell = scaled - lower >= 0.5 ? cell + 1 : cell - 1;
+}
+
+void VertexWelder::addAttribute(const float* data, uint32_t components, bool exact)
+{
+	if (!data || components == 0)
+	{
+		return;
+	}
+
+	VertexAttribute vertexAttribute;
+	vertexAttribute.data = data;
+	vertexAttribute.components = components;
+	vertexAttribute.exact = exact;
+
+	allAttributes.push_back(vertexAttribute);
+}
+
+uint32_t VertexWelder::weldVertices(uint32_t numberVertices, vector<uint32_t>& remap) const
+{
+	remap.resize(numberVertices);
+
+	if (allAttributes.size() == 0 || allAttributes[0].components < 3)
+	{
+		for (uint32_t vertex = 0; vertex < numberVertices; vertex++)
+		{
+			remap[vertex] = vertex;
+		}
+
+		return numberVertices;
+	}
+
+	const float* positions = allAttributes[0].data;
+	uint32_t positionComponents = allAttributes[0].components;
+
+	// Buckets are chained through the remaining vertices. Cells sharing a bucket only cost additional compares.
+	uint32_t numberBuckets = 1;
+	while (numberBuckets < numberVertices)
+	{
+		numberBuckets <<= 1;
+	}
+
+	vector<uint32_t> firstInBucket(numberBuckets, NO_VERTEX);
+	vector<uint32_t> nextInBucket(numberVertices, NO_VERTEX);
+
+	uint32_t numberSearchedCells = epsilon > 0.0f ? 8 : 1;
+
+	int64_t cells[3][2];
+
+	uint32_t nextVertex = 0;
+
+	for (uint32_t vertex = 0; vertex < numberVertices; vertex++)
+	{
+		for (uint32_t c = 0; c < 3; c++)
+		{
+			getCells(positions[vertex * positionComponents + c], cells[c][0], cells[c][1]);
+		}
+
+		uint32_t match = NO_VERTEX;
+
+		for (uint32_t k = 0; k < numberSearchedCells && match == NO_VERTEX; k++)
+		{
+			uint32_t bucket = hashCell(cells[0][k & 1], cells[1][(k >> 1) & 1], cells[2][(k >> 2) & 1]) & (numberBuckets - 1);
+
+			for (uint32_t candidate = firstInBucket[bucket]; candidate != NO_VERTEX; candidate = nextInBucket[candidate])
+			{
+				if (isEqual(candidate, vertex))
+				{
+					match = candidate;
+
+					break;
+				}
+			}
+		}
+
+		if (match != NO_VERTEX)
+		{
+			remap[vertex] = remap[match];
+
+			continue;
+		}
+
+		remap[vertex] = nextVertex++;
+
+		uint32_t bucket = hashCell(cells[0][0], cells[1][0], cells[2][0]) & (numberBuckets - 1);
+
+		nextInBucket[vertex] = firstInBucket[bucket];
+		firstInBucket[bucket] = vertex;
+	}
+
+	return nextVertex;
+}
+
+void VertexWelder::compactVertices(float* data, uint32_t numberVertices, uint32_t components, const vector<uint32_t>& remap) const
+{
+	if (!data)
+	{
+		return;
+	}
+
+	// Remaining vertices are numbered in order, so they are never moved backwards over an unread one.
+	uint32_t nextVertex = 0;
+
+	for (uint32_t vertex = 0; vertex < numberVertices; vertex++)
+	{
+		if (remap[vertex] != nextVertex)
+		{
+			continue;
+		}
+
+		if (vertex != nextVertex)
+		{
+			memcpy(&data[nextVertex * components], &data[vertex * components], components * sizeof(float));
+		}
+
+		nextVertex++;
+	}
+}
+
+void VertexWelder::remapIndices(uint32_t* indices, uint32_t numberIndices, const vector<uint32_t>& remap) const
+{
+	for (uint32_t i = 0; i < numberIndices; i++)
+	{
+		indices[i] = remap[indices[i]];
+	}
+}
@@ -0,0 +1,82 @@
+/*
+ * VertexWelder.h
+ *
+ *  Created on: 19.10.2026
+ *      Author: nopper
+ */
+
+#ifndef VERTEXWELDER_H_
+#define VERTEXWELDER_H_
+
+#include "../../UsedLibs.h"
+
+/**
+ * Merges vertices, whose attributes are all equal within an epsilon. Vertices are hashed into a grid of cells twice the
+ * size of the epsilon, so only the eight cells around a vertex have to be searched. Each vertex is compared against the
+ * first vertex of its group, so merging does not drift. Only works on the CPU.
+ */
+class VertexWelder
+{
+
+private:
+
+	struct VertexAttribute
+	{
+		const float* data;
+
+		std::uint32_t components;
+
+		bool exact;
+	};
+
+	float epsilon;
+
+	std::vector<VertexAttribute> allAttributes;
+
+	bool isEqual(std::uint32_t first, std::uint32_t second) const;
+
+	/**
+	 * @param neighborCell Receives the next cell on the side of the value, where a matching value can be found.
+	 */
+	void getCells(float value, std::int64_t& cell, std::int64_t& neighborCell) const;
+
+public:
+
+	/**
+	 * @param epsilon Largest difference of two attribute values to be merged. Zero only merges identical vertices.
+	 */
+	VertexWelder(float epsilon = 0.0f);
+	virtual ~VertexWelder();
+
+	float getEpsilon() const;
+
+	/**
+	 * Adds an attribute, which has to match for merging. The positions have to be added first. Null data is ignored.
+	 *
+	 * @param exact If set, the values have to be identical, e.g. for bone indices.
+	 */
+	void addAttribute(const float* data, std::uint32_t components, bool exact = false);
+
+	/**
+	 * Finds the vertices to merge and renumbers them in order of their first occurrence. Each merged vertex gets the
+	 * position of the first vertex of its group.
+	 *
+	 * @param remap Receives the new position of each old vertex.
+	 *
+	 * @return The number of remaining vertices.
+	 */
+	std::uint32_t weldVertices(std::uint32_t numberVertices, std::vector<std::uint32_t>& remap) const;
+
+	/**
+	 * Moves the attributes of the remaining vertices in place to the front. Merged vertices are dropped.
+	 */
+	void compactVertices(float* data, std::uint32_t numberVertices, std::uint32_t components, const std::vector<std::uint32_t>& remap) const;
+
+	/**
+	 * Replaces each index by the new position of its vertex.
+	 */
+	void remapIndices(std::uint32_t* indices, std::uint32_t numberIndices, const std::vector<std::uint32_t>& remap) const;
+
+};
+
+#endif /* VERTEXWELDER_H_ */
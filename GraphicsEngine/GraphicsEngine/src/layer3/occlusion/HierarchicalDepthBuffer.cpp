@@ -0,0 +1,309 @@
+/*
+ * HierarchicalDepthBuffer.cpp
+ *
+ *  Created on: 19.10.2026
+ *      Author: nopper
+ */
+
+#include "HierarchicalDepthBuffer.h"
+
+using namespace std;
+
+HierarchicalDepthBuffer::HierarchicalDepthBuffer(int32_t width, int32_t height) :
+	width(0), height(0), tilesX(0), tilesY(0), depth(), tileMaxDepth()
+{
+	tilesX = (width > 0 ? width + TILE_SIZE - 1 : TILE_SIZE) / TILE_SIZE;
+	tilesY = (height > 0 ? height + TILE_SIZE - 1 : TILE_SIZE) / TILE_SIZE;
+
+	this->width = tilesX * TILE_SIZE;
+	this->height = tilesY * TILE_SIZE;
+
+	depth.resize(this->width * this->height, 1.0f);
+	tileMaxDepth.resize(tilesX * tilesY, 1.0f);
+}
+
+HierarchicalDepthBuffer::~HierarchicalDepthBuffer()
+{
+}
+
+void HierarchicalDepthBuffer::transformVertices(const Matrix4x4& modelViewProjection, const float* vertices, uint32_t numberVertices, vector<float>& screenVertices) const
+{
+	screenVertices.resize(numberVertices * 4);
+
+	float clip[4];
+
+	for (uint32_t i = 0; i < numberVertices; i++)
+	{
+		glusMatrix4x4MultiplyPoint4f(clip, modelViewProjection.getM(), &vertices[i * 4]);
+
+		float* screen = &screenVertices[i * 4];
+
+		// Behind the near plane.
+		if (clip[3] <= 0.0f || clip[2] < -clip[3])
+		{
+			screen[0] = 0.0f;
+			screen[1] = 0.0f;
+			screen[2] = 0.0f;
+			screen[3] = 0.0f;
+
+			continue;
+		}
+
+		screen[0] = (clip[0] / clip[3] * 0.5f + 0.5f) * static_cast<float>(width);
+		screen[1] = (clip[1] / clip[3] * 0.5f + 0.5f) * static_cast<float>(height);
+		screen[2] = clip[2] / clip[3] * 0.5f + 0.5f;
+		screen[3] = clip[3];
+	}
+}
+
+void HierarchicalDepthBuffer::clear(int32_t rowStart, int32_t rowEnd)
+{
+	rowStart = rowStart < 0 ? 0 : rowStart;
+	rowEnd = rowEnd > height ? height : rowEnd;
+
+	if (rowStart >= rowEnd)
+	{
+		return;
+	}
+
+	fill(depth.begin() + rowStart * width, depth.begin() + rowEnd * width, 1.0f);
+
+	fill(tileMaxDepth.begin() + (rowStart / TILE_SIZE) * tilesX, tileMaxDepth.begin() + ((rowEnd + TILE_SIZE - 1) / TILE_SIZE) * tilesX, 1.0f);
+}
+
+void HierarchicalDepthBuffer::rasterizeTriangles(const vector<float>& screenVertices, const vector<uint32_t>& indices, int32_t rowStart, int32_t rowEnd)
+{
+	rowStart = rowStart < 0 ? 0 : rowStart;
+	rowEnd = rowEnd > height ? height : rowEnd;
+
+	for (uint32_t i = 0; i + 2 < indices.size(); i += 3)
+	{
+		const float* v0 = &screenVertices[indices[i] * 4];
+		const float* v1 = &screenVertices[indices[i + 1] * 4];
+		const float* v2 = &screenVertices[indices[i + 2] * 4];
+
+		if (v0[3] == 0.0f || v1[3] == 0.0f || v2[3] == 0.0f)
+		{
+			continue;
+		}
+
+		rasterizeTriangle(v0, v1, v2, rowStart, rowEnd);
+	}
+}
+
+void HierarchicalDepthBuffer::rasterizeTriangle(const float* v0, const float* v1, const float* v2, int32_t rowStart, int32_t rowEnd)
+{
+	int32_t minX = static_cast<int32_t>(floorf(glusMathMinf(v0[0], glusMathMinf(v1[0], v2[0]))));
+	int32_t maxX = static_cast<int32_t>(ceilf(glusMathMaxf(v0[0], glusMathMaxf(v1[0], v2[0]))));
+	int32_t minY = static_cast<int32_t>(floorf(glusMathMinf(v0[1], glusMathMinf(v1[1], v2[1]))));
+	int32_t maxY = static_cast<int32_t>(ceilf(glusMathMaxf(v0[1], glusMathMaxf(v1[1], v2[1]))));
+
+	minX = minX < 0 ? 0 : minX;
+	maxX = maxX > width - 1 ? width - 1 : maxX;
+	minY = minY < rowStart ? rowStart : minY;
+	maxY = maxY > rowEnd - 1 ? rowEnd - 1 : maxY;
+
+	if (minX > maxX || minY > maxY)
+	{
+		return;
+	}
+
+	float area = (v1[0] - v0[0]) * (v2[1] - v0[1]) - (v2[0] - v0[0]) * (v1[1] - v0[1]);
+
+	if (fabsf(area) < 1.0e-8f)
+	{
+		return;
+	}
+
+	// Both sides are rasterized, so bring the triangle into counter clockwise order.
+	if (area < 0.0f)
+	{
+		const float* temp = v1;
+		v1 = v2;
+		v2 = temp;
+
+		area = -area;
+	}
+
+	float inverseArea = 1.0f / area;
+
+	// Edge function steps in x and y direction.
+	float stepX0 = -(v2[1] - v1[1]);
+	float stepY0 = v2[0] - v1[0];
+	float stepX1 = -(v0[1] - v2[1]);
+	float stepY1 = v0[0] - v2[0];
+	float stepX2 = -(v1[1] - v0[1]);
+	float stepY2 = v1[0] - v0[0];
+
+	// Evaluate at the pixel center.
+	float startX = static_cast<float>(minX) + 0.5f;
+	float startY = static_cast<float>(minY) + 0.5f;
+
+	float rowEdge0 = (v2[0] - v1[0]) * (startY - v1[1]) - (v2[1] - v1[1]) * (startX - v1[0]);
+	float rowEdge1 = (v0[0] - v2[0]) * (startY - v2[1]) - (v0[1] - v2[1]) * (startX - v2[0]);
+	float rowEdge2 = (v1[0] - v0[0]) * (startY - v0[1]) - (v1[1] - v0[1]) * (startX - v0[0]);
+
+	// Depth is linear in screen space.
+	float depthStepX = (stepX0 * v0[2] + stepX1 * v1[2] + stepX2 * v2[2]) * inverseArea;
+
+	for (int32_t y = minY; y <= maxY; y++)
+	{
+		float edge0 = rowEdge0;
+		float edge1 = rowEdge1;
+		float edge2 = rowEdge2;
+
+		float currentDepth = (edge0 * v0[2] + edge1 * v1[2] + edge2 * v2[2]) * inverseArea;
+
+		float* row = &depth[y * width];
+
+		for (int32_t x = minX; x <= maxX; x++)
+		{
+			if (edge0 >= 0.0f && edge1 >= 0.0f && edge2 >= 0.0f)
+			{
+				float clampedDepth = glusMathClampf(currentDepth, 0.0f, 1.0f);
+
+				if (clampedDepth < row[x])
+				{
+					row[x] = clampedDepth;
+				}
+			}
+
+			edge0 += stepX0;
+			edge1 += stepX1;
+			edge2 += stepX2;
+
+			currentDepth += depthStepX;
+		}
+
+		rowEdge0 += stepY0;
+		rowEdge1 += stepY1;
+		rowEdge2 += stepY2;
+	}
+}
+
+void HierarchicalDepthBuffer::updateTiles(int32_t rowStart, int32_t rowEnd)
+{
+	rowStart = rowStart < 0 ? 0 : rowStart;
+	rowEnd = rowEnd > height ? height : rowEnd;
+
+	int32_t tileStart = rowStart / TILE_SIZE;
+	int32_t tileEnd = (rowEnd + TILE_SIZE - 1) / TILE_SIZE;
+
+	for (int32_t tileY = tileStart; tileY < tileEnd; tileY++)
+	{
+		for (int32_t tileX = 0; tileX < tilesX; tileX++)
+		{
+			float maxDepth = 0.0f;
+
+			for (int32_t y = tileY * TILE_SIZE; y < (tileY + 1) * TILE_SIZE; y++)
+			{
+				const float* row = &depth[y * width + tileX * TILE_SIZE];
+
+				for (int32_t x = 0; x < TILE_SIZE; x++)
+				{
+					maxDepth = row[x] > maxDepth ? row[x] : maxDepth;
+				}
+			}
+
+			tileMaxDepth[tileY * tilesX + tileX] = maxDepth;
+		}
+	}
+}
+
+bool HierarchicalDepthBuffer::isVisible(const AxisAlignedBoundingBox& axisAlignedBoundingBox, const Matrix4x4& viewProjection) const
+{
+	const Point4& center = axisAlignedBoundingBox.getCenter();
+
+	float corner[4];
+	float clip[4];
+
+	float minX = 0.0f;
+	float minY = 0.0f;
+	float maxX = 0.0f;
+	float maxY = 0.0f;
+	float minDepth = 0.0f;
+
+	for (int32_t i = 0; i < 8; i++)
+	{
+		corner[0] = center.getX() + (i & 1 ? axisAlignedBoundingBox.getHalfWidth() : -axisAlignedBoundingBox.getHalfWidth());
+		corner[1] = center.getY() + (i & 2 ? axisAlignedBoundingBox.getHalfHeight() : -axisAlignedBoundingBox.getHalfHeight());
+		corner[2] = center.getZ() + (i & 4 ? axisAlignedBoundingBox.getHalfDepth() : -axisAlignedBoundingBox.getHalfDepth());
+		corner[3] = 1.0f;
+
+		glusMatrix4x4MultiplyPoint4f(clip, viewProjection.getM(), corner);
+
+		// Box intersects the near plane, so it can not be rejected.
+		if (clip[3] <= 0.0f || clip[2] < -clip[3])
+		{
+			return true;
+		}
+
+		float x = (clip[0] / clip[3] * 0.5f + 0.5f) * static_cast<float>(width);
+		float y = (clip[1] / clip[3] * 0.5f + 0.5f) * static_cast<float>(height);
+		float z = clip[2] / clip[3] * 0.5f + 0.5f;
+
+		if (i == 0)
+		{
+			minX = maxX = x;
+			minY = maxY = y;
+			minDepth = z;
+		}
+		else
+		{
+			minX = glusMathMinf(minX, x);
+			maxX = glusMathMaxf(maxX, x);
+			minY = glusMathMinf(minY, y);
+			maxY = glusMathMaxf(maxY, y);
+			minDepth = glusMathMinf(minDepth, z);
+		}
+	}
+
+	return isVisible(minX, minY, maxX, maxY, minDepth);
+}
+
+bool HierarchicalDepthBuffer::isVisible(float minX, float minY, float maxX, float maxY, float minDepth) const
+{
+	// Outside of the buffer is handled by the frustum culling.
+	if (maxX < 0.0f || maxY < 0.0f || minX >= static_cast<float>(width) || minY >= static_cast<float>(height))
+	{
+		return true;
+	}
+
+	int32_t tileStartX = static_cast<int32_t>(glusMathMaxf(minX, 0.0f)) / TILE_SIZE;
+	int32_t tileStartY = static_cast<int32_t>(glusMathMaxf(minY, 0.0f)) / TILE_SIZE;
+	int32_t tileEndX = static_cast<int32_t>(glusMathMinf(maxX, static_cast<float>(width - 1))) / TILE_SIZE;
+	int32_t tileEndY = static_cast<int32_t>(glusMathMinf(maxY, static_cast<float>(height - 1))) / TILE_SIZE;
+
+	for (int32_t tileY = tileStartY; tileY <= tileEndY; tileY++)
+	{
+		for (int32_t tileX = tileStartX; tileX <= tileEndX; tileX++)
+		{
+			if (minDepth <= tileMaxDepth[tileY * tilesX + tileX])
+			{
+				return true;
+			}
+		}
+	}
+
+	return false;
+}
+
+float HierarchicalDepthBuffer::getDepth(int32_t x, int32_t y) const
+{
+	if (x < 0 || y < 0 || x >= width || y >= height)
+	{
+		return 1.0f;
+	}
+
+	return depth[y * width + x];
+}
+
+int32_t HierarchicalDepthBuffer::getWidth() const
+{
+	return width;
+}
+
+int32_t HierarchicalDepthBuffer::getHeight() const
+{
+	return height;
+}
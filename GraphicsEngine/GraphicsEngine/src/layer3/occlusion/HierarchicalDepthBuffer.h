@@ -0,0 +1,79 @@
+/*
+ * HierarchicalDepthBuffer.h
+ *
+ *  Created on: 19.10.2026
+ *      Author: nopper
+ */
+
+#ifndef HIERARCHICALDEPTHBUFFER_H_
+#define HIERARCHICALDEPTHBUFFER_H_
+
+#include "../../UsedLibs.h"
+
+#include "../../layer0/math/Matrix4x4.h"
+#include "../../layer1/collision/AxisAlignedBoundingBox.h"
+
+/**
+ * Small CPU depth buffer for occlusion culling. Depth is stored in the range [0, 1], one being the far plane.
+ * On top of the pixels, the maximum depth of each tile is kept, so a box can be rejected by only looking at a few tiles.
+ * Rows can be processed in independent bands, which are a multiple of the tile size, to allow rasterizing on several threads.
+ */
+class HierarchicalDepthBuffer
+{
+
+public:
+
+	static const std::int32_t TILE_SIZE = 8;
+
+private:
+
+	std::int32_t width;
+	std::int32_t height;
+
+	std::int32_t tilesX;
+	std::int32_t tilesY;
+
+	std::vector<float> depth;
+
+	std::vector<float> tileMaxDepth;
+
+	void rasterizeTriangle(const float* v0, const float* v1, const float* v2, std::int32_t rowStart, std::int32_t rowEnd);
+
+public:
+
+	HierarchicalDepthBuffer(std::int32_t width, std::int32_t height);
+	virtual ~HierarchicalDepthBuffer();
+
+	/**
+	 * Transforms the object space vertices (x, y, z, w) to screen space (x, y, depth, w). Vertices behind the near plane get a w of zero.
+	 */
+	void transformVertices(const Matrix4x4& modelViewProjection, const float* vertices, std::uint32_t numberVertices, std::vector<float>& screenVertices) const;
+
+	void clear(std::int32_t rowStart, std::int32_t rowEnd);
+
+	/**
+	 * Rasterizes all triangles, which are in screen space. Only rows in the given band are written.
+	 * Triangles touching the near plane are skipped, which keeps the result conservative.
+	 */
+	void rasterizeTriangles(const std::vector<float>& screenVertices, const std::vector<std::uint32_t>& indices, std::int32_t rowStart, std::int32_t rowEnd);
+
+	void updateTiles(std::int32_t rowStart, std::int32_t rowEnd);
+
+	/**
+	 * @return False, if the box is completely behind the already rasterized occluders.
+	 */
+	bool isVisible(const AxisAlignedBoundingBox& axisAlignedBoundingBox, const Matrix4x4& viewProjection) const;
+
+	bool isVisible(float minX, float minY, float maxX, float maxY, float minDepth) const;
+
+	float getDepth(std::int32_t x, std::int32_t y) const;
+
+	std::int32_t getWidth() const;
+
+	std::int32_t getHeight() const;
+
+};
+
+typedef std::shared_ptr<HierarchicalDepthBuffer> HierarchicalDepthBufferSP;
+
+#endif /* HIERARCHICALDEPTHBUFFER_H_ */
@@ -0,0 +1,44 @@
+/*
+ * Occluder.cpp
+ *
+ *  Created on: 19.10.2026
+ *      Author: nopper
+ */
+
+#include "Occluder.h"
+
+using namespace std;
+
+Occluder::Occluder(uint32_t numberVertices, const float* vertices, uint32_t numberIndices, const uint32_t* indices) :
+	numberVertices(numberVertices), vertices(vertices, vertices + numberVertices * 4), indices(indices, indices + numberIndices), modelMatrix()
+{
+}
+
+Occluder::~Occluder()
+{
+}
+
+uint32_t Occluder::getNumberVertices() const
+{
+	return numberVertices;
+}
+
+const float* Occluder::getVertices() const
+{
+	return &vertices[0];
+}
+
+const vector<uint32_t>& Occluder::getIndices() const
+{
+	return indices;
+}
+
+const Matrix4x4& Occluder::getModelMatrix() const
+{
+	return modelMatrix;
+}
+
+void Occluder::setModelMatrix(const Matrix4x4& modelMatrix)
+{
+	this->modelMatrix = modelMatrix;
+}
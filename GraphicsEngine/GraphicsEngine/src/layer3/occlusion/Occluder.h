@@ -0,0 +1,50 @@
+/*
+ * Occluder.h
+ *
+ *  Created on: 19.10.2026
+ *      Author: nopper
+ */
+
+#ifndef OCCLUDER_H_
+#define OCCLUDER_H_
+
+#include "../../UsedLibs.h"
+
+#include "../../layer0/math/Matrix4x4.h"
+
+/**
+ * Low poly, closed geometry, which is rasterized into the hierarchical depth buffer. The geometry has to be inside the visible object.
+ */
+class Occluder
+{
+
+private:
+
+	std::uint32_t numberVertices;
+
+	std::vector<float> vertices;
+
+	std::vector<std::uint32_t> indices;
+
+	Matrix4x4 modelMatrix;
+
+public:
+
+	Occluder(std::uint32_t numberVertices, const float* vertices, std::uint32_t numberIndices, const std::uint32_t* indices);
+	virtual ~Occluder();
+
+	std::uint32_t getNumberVertices() const;
+
+	const float* getVertices() const;
+
+	const std::vector<std::uint32_t>& getIndices() const;
+
+	const Matrix4x4& getModelMatrix() const;
+
+	void setModelMatrix(const Matrix4x4& modelMatrix);
+
+};
+
+typedef std::shared_ptr<Occluder> OccluderSP;
+
+#endif /* OCCLUDER_H_ */
@@ -0,0 +1,54 @@
+/*
+ * OccluderFactory.cpp
+ *
+ *  Created on: 19.10.2026
+ *      Author: nopper
+ */
+
+#include "OccluderFactory.h"
+
+using namespace std;
+
+OccluderFactory::OccluderFactory()
+{
+}
+
+OccluderFactory::~OccluderFactory()
+{
+}
+
+OccluderSP OccluderFactory::createOccluder(const MeshSP& mesh) const
+{
+	if (!mesh.get() || !mesh->getVertices() || !mesh->getIndices())
+	{
+		glusLogPrint(GLUS_LOG_WARNING, "Occluder needs the CPU data of the mesh");
+
+		return OccluderSP();
+	}
+
+	return OccluderSP(new Occluder(mesh->getNumberVertices(), mesh->getVertices(), mesh->getNumberIndices(), mesh->getIndices()));
+}
+
+OccluderSP OccluderFactory::createBoxOccluder(const Point4& center, float halfWidth, float halfHeight, float halfDepth) const
+{
+	float vertices[8 * 4];
+
+	for (int32_t i = 0; i < 8; i++)
+	{
+		vertices[i * 4 + 0] = center.getX() + (i & 1 ? halfWidth : -halfWidth);
+		vertices[i * 4 + 1] = center.getY() + (i & 2 ? halfHeight : -halfHeight);
+		vertices[i * 4 + 2] = center.getZ() + (i & 4 ? halfDepth : -halfDepth);
+		vertices[i * 4 + 3] = 1.0f;
+	}
+
+	uint32_t indices[36] = {
+		0, 2, 3, 0, 3, 1,
+		4, 5, 7, 4, 7, 6,
+		0, 1, 5, 0, 5, 4,
+		2, 6, 7, 2, 7, 3,
+		0, 4, 6, 0, 6, 2,
+		1, 3, 7, 1, 7, 5
+	};
+
+	return OccluderSP(new Occluder(8, vertices, 36, indices));
+}
@@ -0,0 +1,37 @@
+/*
+ * OccluderFactory.h
+ *
+ *  Created on: 19.10.2026
+ *      Author: nopper
+ */
+
+#ifndef OCCLUDERFACTORY_H_
+#define OCCLUDERFACTORY_H_
+
+#include "../../UsedLibs.h"
+
+#include "../../layer0/math/Point4.h"
+#include "../mesh/Mesh.h"
+#include "Occluder.h"
+
+class OccluderFactory
+{
+
+public:
+
+	OccluderFactory();
+	virtual ~OccluderFactory();
+
+	/**
+	 * Uses the triangles of the given mesh. The CPU data of the mesh must still be available.
+	 */
+	OccluderSP createOccluder(const MeshSP& mesh) const;
+
+	/**
+	 * Box occluder, e.g. for tagging the solid inner part of a building.
+	 */
+	OccluderSP createBoxOccluder(const Point4& center, float halfWidth, float halfHeight, float halfDepth) const;
+
+};
+
+#endif /* OCCLUDERFACTORY_H_ */
@@ -0,0 +1,182 @@
+/*
+ * TerrainQuadtree.cpp
+ *
+ *  Created on: 19.10.2026
+ *      Author: nopper
+ */
+
+#include "TerrainQuadtree.h"
+
+using namespace std;
+
+const float TerrainQuadtree::NO_MORPH = 1.0e30f;
+
+TerrainQuadtree::TerrainQuadtree(int32_t levels, uint32_t gridSize, float lodRange, float morphStartRatio) :
+	levels(levels > 0 ? levels : 1), gridSize(gridSize), lodRange(lodRange), morphStartRatio(glusMathClampf(morphStartRatio, 0.0f, 1.0f)), allRanges()
+{
+	updateRanges();
+}
+
+TerrainQuadtree::~TerrainQuadtree()
+{
+	allRanges.clear();
+}
+
+void TerrainQuadtree::updateRanges()
+{
+	allRanges.clear();
+
+	float range = lodRange;
+
+	for (int32_t level = 0; level < levels; level++)
+	{
+		allRanges.push_back(range);
+
+		range *= 2.0f;
+	}
+}
+
+AxisAlignedBoundingBox TerrainQuadtree::calculateBoundingBox(float offsetS, float offsetT, float size, const Matrix4x4& modelMatrix, float minHeight, float maxHeight) const
+{
+	// The unit grid of the ground is centered around the origin.
+	Point4 center(offsetS + size * 0.5f - 0.5f, offsetT + size * 0.5f - 0.5f, (minHeight + maxHeight) * 0.5f);
+
+	float halfSize = size * 0.5f;
+	float halfHeight = (maxHeight - minHeight) * 0.5f;
+
+	const float* m = modelMatrix.getM();
+
+	// Box in world space enclosing the transformed box.
+	float halfWidth = fabsf(m[0]) * halfSize + fabsf(m[4]) * halfSize + fabsf(m[8]) * halfHeight;
+	float halfHeightWorld = fabsf(m[1]) * halfSize + fabsf(m[5]) * halfSize + fabsf(m[9]) * halfHeight;
+	float halfDepth = fabsf(m[2]) * halfSize + fabsf(m[6]) * halfSize + fabsf(m[10]) * halfHeight;
+
+	return AxisAlignedBoundingBox(modelMatrix * center, halfWidth, halfHeightWorld, halfDepth);
+}
+
+bool TerrainQuadtree::inRange(const AxisAlignedBoundingBox& axisAlignedBoundingBox, const Point4& eye, float range)
+{
+	const Point4& center = axisAlignedBoundingBox.getCenter();
+
+	float dx = glusMathMaxf(fabsf(eye.getX() - center.getX()) - axisAlignedBoundingBox.getHalfWidth(), 0.0f);
+	float dy = glusMathMaxf(fabsf(eye.getY() - center.getY()) - axisAlignedBoundingBox.getHalfHeight(), 0.0f);
+	float dz = glusMathMaxf(fabsf(eye.getZ() - center.getZ()) - axisAlignedBoundingBox.getHalfDepth(), 0.0f);
+
+	return dx * dx + dy * dy + dz * dz <= range * range;
+}
+
+void TerrainQuadtree::addTile(float offsetS, float offsetT, float size, int32_t level, int32_t quadrant, vector<TerrainTile>& tiles) const
+{
+	TerrainTile tile;
+
+	tile.offset[0] = offsetS;
+	tile.offset[1] = offsetT;
+	tile.size = size;
+	tile.level = level;
+	tile.quadrant = quadrant;
+
+	if (level == levels - 1)
+	{
+		// There is no coarser level to morph into.
+		tile.morphStart = NO_MORPH;
+		tile.morphEnd = NO_MORPH;
+	}
+	else
+	{
+		float previousRange = level > 0 ? allRanges[level - 1] : 0.0f;
+
+		tile.morphStart = previousRange + (allRanges[level] - previousRange) * morphStartRatio;
+		tile.morphEnd = allRanges[level];
+	}
+
+	tiles.push_back(tile);
+}
+
+bool TerrainQuadtree::selectTile(float offsetS, float offsetT, float size, int32_t level, const Matrix4x4& modelMatrix, const Point4& eye, const ViewFrustum* viewFrustum, float minHeight, float maxHeight, vector<TerrainTile>& tiles) const
+{
+	AxisAlignedBoundingBox boundingBox = calculateBoundingBox(offsetS, offsetT, size, modelMatrix, minHeight, maxHeight);
+
+	// The root is always in range, so the whole terrain is covered.
+	if (level < levels - 1 && !inRange(boundingBox, eye, allRanges[level]))
+	{
+		return false;
+	}
+
+	if (viewFrustum && !viewFrustum->isVisible(boundingBox))
+	{
+		// Handled, as nothing has to be drawn.
+		return true;
+	}
+
+	if (level == 0 || !inRange(boundingBox, eye, allRanges[level - 1]))
+	{
+		addTile(offsetS, offsetT, size, level, -1, tiles);
+
+		return true;
+	}
+
+	float halfSize = size * 0.5f;
+
+	for (int32_t quadrant = 0; quadrant < 4; quadrant++)
+	{
+		float childS = offsetS + ((quadrant & 1) ? halfSize : 0.0f);
+		float childT = offsetT + ((quadrant & 2) ? halfSize : 0.0f);
+
+		if (!selectTile(childS, childT, halfSize, level - 1, modelMatrix, eye, viewFrustum, minHeight, maxHeight, tiles))
+		{
+			// The child is too far away, so this level covers its area.
+			if (!viewFrustum || viewFrustum->isVisible(calculateBoundingBox(childS, childT, halfSize, modelMatrix, minHeight, maxHeight)))
+			{
+				addTile(offsetS, offsetT, size, level, quadrant, tiles);
+			}
+		}
+	}
+
+	return true;
+}
+
+int32_t TerrainQuadtree::getLevels() const
+{
+	return levels;
+}
+
+uint32_t TerrainQuadtree::getGridSize() const
+{
+	return gridSize;
+}
+
+float TerrainQuadtree::getLodRange() const
+{
+	return lodRange;
+}
+
+void TerrainQuadtree::setLodRange(float lodRange)
+{
+	this->lodRange = lodRange;
+
+	updateRanges();
+}
+
+float TerrainQuadtree::getMorphStartRatio() const
+{
+	return morphStartRatio;
+}
+
+void TerrainQuadtree::setMorphStartRatio(float morphStartRatio)
+{
+	this->morphStartRatio = glusMathClampf(morphStartRatio, 0.0f, 1.0f);
+}
+
+float TerrainQuadtree::getRange(int32_t level) const
+{
+	return allRanges[level];
+}
+
+int32_t TerrainQuadtree::select(const Matrix4x4& modelMatrix, const Point4& eye, const ViewFrustum* viewFrustum, float minHeight, float maxHeight, vector<TerrainTile>& tiles) const
+{
+	tiles.clear();
+
+	selectTile(0.0f, 0.0f, 1.0f, levels - 1, modelMatrix, eye, viewFrustum, glusMathMinf(minHeight, maxHeight), glusMathMaxf(minHeight, maxHeight), tiles);
+
+	return static_cast<int32_t>(tiles.size());
+}
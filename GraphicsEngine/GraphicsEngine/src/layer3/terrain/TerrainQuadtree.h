@@ -0,0 +1,117 @@
+/*
+ * TerrainQuadtree.h
+ *
+ *  Created on: 19.10.2026
+ *      Author: nopper
+ */
+
+#ifndef TERRAINQUADTREE_H_
+#define TERRAINQUADTREE_H_
+
+#include "../../UsedLibs.h"
+
+#include "../../layer0/math/Matrix4x4.h"
+#include "../../layer0/math/Point4.h"
+#include "../../layer1/collision/AxisAlignedBoundingBox.h"
+#include "../camera/ViewFrustum.h"
+
+/**
+ * A selected tile of a terrain.
+ */
+struct TerrainTile
+{
+	/**
+	 * Lower left corner in the texture space of the ground.
+	 */
+	float offset[2];
+
+	float size;
+
+	std::int32_t level;
+
+	/**
+	 * -1, if the whole tile is drawn. Otherwise, the quadrant of the tile, which replaces a child out of its range.
+	 */
+	std::int32_t quadrant;
+
+	float morphStart;
+
+	float morphEnd;
+};
+
+/**
+ * Selects the tiles of a terrain by continuous distance dependent level of detail. Level zero contains the smallest
+ * tiles, the root is at the highest level. Every level has a range twice as far as the next finer one. A tile is
+ * split, as long as its children are in their range, and morphs into the next coarser level at the end of its range.
+ * The tiles are culled against the view frustum. The ground is the unit grid of the ground entity, displaced up to
+ * the given heights along z. Does not need a context.
+ */
+class TerrainQuadtree
+{
+
+private:
+
+	std::int32_t levels;
+
+	std::uint32_t gridSize;
+
+	float lodRange;
+
+	float morphStartRatio;
+
+	std::vector<float> allRanges;
+
+	void updateRanges();
+
+	AxisAlignedBoundingBox calculateBoundingBox(float offsetS, float offsetT, float size, const Matrix4x4& modelMatrix, float minHeight, float maxHeight) const;
+
+	static bool inRange(const AxisAlignedBoundingBox& axisAlignedBoundingBox, const Point4& eye, float range);
+
+	void addTile(float offsetS, float offsetT, float size, std::int32_t level, std::int32_t quadrant, std::vector<TerrainTile>& tiles) const;
+
+	bool selectTile(float offsetS, float offsetT, float size, std::int32_t level, const Matrix4x4& modelMatrix, const Point4& eye, const ViewFrustum* viewFrustum, float minHeight, float maxHeight, std::vector<TerrainTile>& tiles) const;
+
+public:
+
+	/**
+	 * Morph distances of tiles, which never morph.
+	 */
+	static const float NO_MORPH;
+
+	/**
+	 * @param levels Number of levels including the root.
+	 * @param gridSize Number of grid cells per side of a tile.
+	 * @param lodRange Range of the finest level in world space.
+	 * @param morphStartRatio Part of the range between the previous and the own range, where morphing starts.
+	 */
+	TerrainQuadtree(std::int32_t levels, std::uint32_t gridSize, float lodRange, float morphStartRatio = 0.66f);
+	virtual ~TerrainQuadtree();
+
+	std::int32_t getLevels() const;
+
+	std::uint32_t getGridSize() const;
+
+	float getLodRange() const;
+
+	void setLodRange(float lodRange);
+
+	float getMorphStartRatio() const;
+
+	void setMorphStartRatio(float morphStartRatio);
+
+	float getRange(std::int32_t level) const;
+
+	/**
+	 * Selects the tiles to draw from the given eye.
+	 *
+	 * @param viewFrustum World space frustum to cull the tiles. No culling, if null.
+	 *
+	 * @return Number of selected tiles.
+	 */
+	std::int32_t select(const Matrix4x4& modelMatrix, const Point4& eye, const ViewFrustum* viewFrustum, float minHeight, float maxHeight, std::vector<TerrainTile>& tiles) const;
+
+};
+
+typedef std::shared_ptr<TerrainQuadtree> TerrainQuadtreeSP;
+
+#endif /* TERRAINQUADTREE_H_ */
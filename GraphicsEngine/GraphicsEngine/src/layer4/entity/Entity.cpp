@@ -14,6 +14,7 @@ bool Entity::dynamicCubeMaps = false;
 
 Matrix4x4 Entity::viewMatrix[6];
 Matrix4x4 Entity::projectionMatrix;
+int32_t Entity::faceMask = 0x3F;
 
 Entity::Entity() :
 		distanceToCamera(0.0f)
@@ -91,4 +92,12 @@ const Matrix4x4& Entity::getCubeMapProjectionMatrix()
 	return projectionMatrix;
 }
 
+void Entity::setCubeMapFaceMask(int32_t faceMask)
+{
+	Entity::faceMask = faceMask & 0x3F;
+}
 
+int32_t Entity::getCubeMapFaceMask()
+{
+	return faceMask;
+}
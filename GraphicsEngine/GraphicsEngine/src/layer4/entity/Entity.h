@@ -31,6 +31,7 @@ protected:
 	 */
 	static Matrix4x4 viewMatrix[6];
 	static Matrix4x4 projectionMatrix;
+	static std::int32_t faceMask;
 
 	Entity();
 	virtual ~Entity();
@@ -56,8 +57,22 @@ public:
     static const Matrix4x4* getCubeMapViewMatrices();
     static const Matrix4x4& getCubeMapProjectionMatrix();
 
+    /**
+     * Bit i set, if face i of the cube map is rendered. Default are all faces.
+     */
+    static void setCubeMapFaceMask(std::int32_t faceMask);
+
+    static std::int32_t getCubeMapFaceMask();
+
 	virtual const BoundingSphere& getBoundingSphere() const = 0;
 
+	virtual const Matrix4x4& getModelMatrix() const = 0;
+
+	/**
+	 * @return True, if the entity is updated each frame, e.g. by an animation, so it may look different without moving.
+	 */
+	virtual bool isUpdateable() const = 0;
+
 	virtual void updateBoundingSphereCenter(bool initial = false) = 0;
 	virtual void updateDistanceToCamera() = 0;
 
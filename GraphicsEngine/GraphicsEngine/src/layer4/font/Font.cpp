@@ -5,7 +5,6 @@
  *      Author: nopper
  */
 
-#include "../../layer0/math/Matrix4x4.h"
 #include "../../layer1/shader/ProgramFactory.h"
 #include "../../layer1/shader/Variables.h"
 #include "../../layer1/texture/Texture2DManager.h"
@@ -17,44 +16,25 @@
 using namespace std;
 
 Font::Font(const string& filename, float width, float height, int32_t columns, int32_t rows, float cellWidth, float cellHeight, float fontWidth, float fontHeight) :
-		width(width), height(height), columns(columns), rows(rows), cellWidth(cellWidth), cellHeight(cellHeight), fontWidth(fontWidth), fontHeight(fontHeight)
+		fontTexture(), vertexCapacity(0), glyphCapacity(0), fontLayout(width, height, columns, rows, cellWidth, cellHeight, fontWidth, fontHeight), batching(false), allVertices(), numberGlyphs(0)
 {
-	cellWidthNormalized = cellWidth / width;
-	cellHeightNormalized = cellHeight / height;
-
-	fontTextureName = Texture2DManager::getInstance()->createTexture(filename, false, GL_LINEAR, GL_LINEAR)->getTextureName();
+	fontTexture = Texture2DManager::getInstance()->createTexture(filename, false, GL_LINEAR, GL_LINEAR);
 
 	camera = CameraManager::getInstance()->getDefaultOrthographicCamera();
 
 	ProgramFactory programFactory;
 	program = programFactory.createFontProgram();
 
-	GLUSshape rectangularPlane;
-	glusShapeCreateRectangularPlanef(&rectangularPlane, cellWidth / 2.0f, cellHeight / 2.0f);
-
-	numberIndices = rectangularPlane.numberIndices;
-
+	// Both buffers grow on demand. The vertices are streamed every frame.
 	glGenBuffers(1, &vboVertices);
-	glBindBuffer(GL_ARRAY_BUFFER, vboVertices);
-	glBufferData(GL_ARRAY_BUFFER, rectangularPlane.numberVertices * 4 * sizeof(GLfloat), (GLfloat*) rectangularPlane.vertices, GL_STATIC_DRAW);
-
-	glGenBuffers(1, &vboTexCoords);
-	glBindBuffer(GL_ARRAY_BUFFER, vboTexCoords);
-	glBufferData(GL_ARRAY_BUFFER, rectangularPlane.numberVertices * 2 * sizeof(GLfloat), (GLfloat*) rectangularPlane.texCoords, GL_STATIC_DRAW);
-
 	glGenBuffers(1, &vboIndices);
-	glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, vboIndices);
-	glBufferData(GL_ELEMENT_ARRAY_BUFFER, rectangularPlane.numberIndices * sizeof(GLuint), (GLuint*) rectangularPlane.indices, GL_STATIC_DRAW);
 
 	fontVAO = FontVAOSP(new FontVAO(program, *this));
-
-	glusShapeDestroyf(&rectangularPlane);
 }
 
 Font::~Font()
 {
 	glDeleteBuffers(1, &vboVertices);
-	glDeleteBuffers(1, &vboTexCoords);
 
 	glDeleteBuffers(1, &vboIndices);
 
@@ -63,6 +43,8 @@ Font::~Font()
 	program.reset();
 
 	camera.reset();
+
+	fontTexture.reset();
 }
 
 GLuint Font::getVboVertices() const
@@ -70,29 +52,50 @@ GLuint Font::getVboVertices() const
     return vboVertices;
 }
 
-GLuint Font::getVboTexCoords() const
+GLuint Font::getVboIndices() const
 {
-    return vboTexCoords;
+    return vboIndices;
 }
 
-GLuint Font::getVboIndices() const
+bool Font::isBatching() const
 {
-    return vboIndices;
+	return batching;
+}
+
+void Font::setBatching(bool batching)
+{
+	if (this->batching && !batching)
+	{
+		flush();
+	}
+
+	this->batching = batching;
+}
+
+void Font::internalPrint(float x, float y, const Color& color, const char* output)
+{
+	ViewportSP currentViewport = ViewportManager::getInstance()->getDefaultViewport();
+
+	// The orthographic camera has its origin in the center of the viewport.
+	float originX = x - static_cast<float>(currentViewport->getWidth()) / 2.0f;
+	float originY = static_cast<float>(currentViewport->getHeight()) / 2.0f - y;
+
+	numberGlyphs += fontLayout.appendQuads(output, originX, originY, color, allVertices);
+
+	if (!batching)
+	{
+		flush();
+	}
 }
 
-void Font::internalPrint(float x, float y, const Color& color, const char* output) const
+void Font::draw()
 {
 	program->use();
 
 	glUniformMatrix4fv(program->getUniformLocation(u_projectionMatrix), 1, GL_FALSE, camera->getProjectionMatrix().getM());
 	glUniformMatrix4fv(program->getUniformLocation(u_viewMatrix), 1, GL_FALSE, camera->getViewMatrix().getM());
 
-	glUniform1f(program->getUniformLocation(u_fontWidth), cellWidthNormalized);
-	glUniform1f(program->getUniformLocation(u_fontHeight), cellHeightNormalized);
-
-	glUniform4fv(program->getUniformLocation(u_fontColor), 1, color.getRGBA());
-
-	glBindTexture(GL_TEXTURE_2D, fontTextureName);
+	glBindTexture(GL_TEXTURE_2D, fontTexture->getTextureName());
 	glUniform1i(program->getUniformLocation(u_fontTexture), 0);
 
 	glEnable(GL_BLEND);
@@ -101,48 +104,33 @@ void Font::internalPrint(float x, float y, const Color& color, const char* outpu
 	glDepthMask(GL_FALSE);
 	glDisable(GL_DEPTH_TEST);
 
-	ViewportSP currentViewport = ViewportManager::getInstance()->getDefaultViewport();
-
-	Matrix4x4 modelMatrix;
-	Matrix4x4 toScreenMatrix;
-	toScreenMatrix.translate(-static_cast<float>(currentViewport->getWidth()) / 2.0f + cellWidth / 2.0f, static_cast<float>(currentViewport->getHeight()) / 2.0f - cellHeight / 2.0f, 0.0f);
-
 	fontVAO->bind();
 
-	char c;
-	float currentColumnNormalized;
-	float currentRowNormalized;
-	float currentX = x;
-	float currentY = y;
-	int32_t stringLength = strlen(output);
-	for (int32_t i = 0; i < stringLength; i++)
+	// The index buffer is part of the vertex array, so it is only changed while bound.
+	if (numberGlyphs > glyphCapacity)
 	{
-		c = output[i];
+		glyphCapacity = max(numberGlyphs, glyphCapacity * 2);
+
+		vector<GLuint> indices;
 
-		if (c != '\n')
-		{
-			currentColumnNormalized = static_cast<float>(c % columns) * cellWidth / width;
-			currentRowNormalized = 1.0f - static_cast<float>(c / rows) * cellHeight / height - cellHeightNormalized;
+		FontLayout::createIndices(glyphCapacity, indices);
 
-			glUniform1f(program->getUniformLocation(u_fontLeft), currentColumnNormalized);
-			glUniform1f(program->getUniformLocation(u_fontTop), currentRowNormalized);
+		glBufferData(GL_ELEMENT_ARRAY_BUFFER, indices.size() * sizeof(GLuint), indices.data(), GL_STATIC_DRAW);
+	}
 
-			modelMatrix.identity();
-			modelMatrix.translate(currentX, -currentY, 0.0f);
-			modelMatrix.multiply(toScreenMatrix);
+	uint32_t vertexBytes = static_cast<uint32_t>(allVertices.size() * sizeof(GLfloat));
 
-			glUniformMatrix4fv(program->getUniformLocation(u_modelMatrix), 1, GL_FALSE, modelMatrix.getM());
+	glBindBuffer(GL_ARRAY_BUFFER, vboVertices);
 
-			glDrawElements(GL_TRIANGLES, numberIndices, GL_UNSIGNED_INT, 0);
+	// Orphaning the storage avoids waiting for the draw of the last frame.
+	vertexCapacity = max(vertexBytes, vertexCapacity);
 
-			currentX += fontWidth;
-		}
-		else
-		{
-			currentX = x;
-			currentY += fontHeight;
-		}
-	}
+	glBufferData(GL_ARRAY_BUFFER, vertexCapacity, nullptr, GL_STREAM_DRAW);
+	glBufferSubData(GL_ARRAY_BUFFER, 0, vertexBytes, allVertices.data());
+
+	glBindBuffer(GL_ARRAY_BUFFER, 0);
+
+	glDrawElements(GL_TRIANGLES, numberGlyphs * FontLayout::INDICES_PER_GLYPH, GL_UNSIGNED_INT, 0);
 
 	fontVAO->unbind();
 
@@ -154,7 +142,7 @@ void Font::internalPrint(float x, float y, const Color& color, const char* outpu
 	glBindTexture(GL_TEXTURE_2D, 0);
 }
 
-void Font::print(float x, float y, const Color& color, const char* output, ...) const
+void Font::print(float x, float y, const Color& color, const char* output, ...)
 {
 	const uint32_t MAXCHARS = 2047;
 	char buffer[MAXCHARS + 1];
@@ -170,7 +158,25 @@ void Font::print(float x, float y, const Color& color, const char* output, ...)
 	internalPrint(x, y, color, buffer);
 }
 
-void Font::print(float x, float y, const Color& color, const string& output) const
+void Font::print(float x, float y, const Color& color, const string& output)
 {
 	internalPrint(x, y, color, output.c_str());
 }
+
+void Font::flush()
+{
+	if (numberGlyphs > 0)
+	{
+		draw();
+	}
+
+	allVertices.clear();
+	numberGlyphs = 0;
+
+	fontLayout.nextFrame();
+}
+
+const FontLayout& Font::getFontLayout() const
+{
+	return fontLayout;
+}
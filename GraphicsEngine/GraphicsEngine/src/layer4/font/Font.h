@@ -12,7 +12,9 @@
 
 #include "../../layer0/color/Color.h"
 #include "../../layer1/shader/Program.h"
+#include "../../layer1/texture/Texture2D.h"
 #include "../../layer3/camera/Camera.h"
+#include "FontLayout.h"
 #include "FontVAO.h"
 
 class Font
@@ -20,25 +22,16 @@ class Font
 
 private:
 
-	float width;
-	float height;
-	std::int32_t columns;
-	std::int32_t rows;
-	float cellWidth;
-	float cellWidthNormalized;
-	float cellHeight;
-	float cellHeightNormalized;
-	float fontWidth;
-	float fontHeight;
-
-	GLuint fontTextureName;
+	// Kept, so the texture cache does not evict it.
+	Texture2DSP fontTexture;
 
 	GLuint vboVertices;
-	GLuint vboTexCoords;
 
 	GLuint vboIndices;
 
-	std::uint32_t numberIndices;
+	std::uint32_t vertexCapacity;
+
+	std::uint32_t glyphCapacity;
 
 	CameraSP camera;
 
@@ -46,7 +39,17 @@ private:
 
 	FontVAOSP fontVAO;
 
-	void internalPrint(float x, float y, const Color& color, const char* output) const;
+	FontLayout fontLayout;
+
+	bool batching;
+
+	std::vector<float> allVertices;
+
+	std::uint32_t numberGlyphs;
+
+	void internalPrint(float x, float y, const Color& color, const char* output);
+
+	void draw();
 
 public:
 
@@ -54,13 +57,26 @@ public:
 	virtual ~Font();
 
 	GLuint getVboVertices() const;
-	GLuint getVboTexCoords() const;
 
 	GLuint getVboIndices() const;
 
-	void print(float x, float y, const Color& color, const char* output, ...) const;
+	bool isBatching() const;
+
+	/**
+	 * If batching, printed text is collected and drawn by flush with one draw call. Otherwise, each print is drawn at once.
+	 */
+	void setBatching(bool batching);
+
+	void print(float x, float y, const Color& color, const char* output, ...);
+
+	void print(float x, float y, const Color& color, const std::string& output);
+
+	/**
+	 * Draws all collected text and ages the cached layouts. Has to be called once per frame, if batching.
+	 */
+	void flush();
 
-	void print(float x, float y, const Color& color, const std::string& output) const;
+	const FontLayout& getFontLayout() const;
 
 };
 
@@ -0,0 +1,173 @@
+/*
+ * FontLayout.cpp
+ *
+ *  Created on: 19.10.2026
+ *      Author: nopper
+ */
+
+#include "FontLayout.h"
+
+using namespace std;
+
+FontLayout::FontLayout(float width, float height, int32_t columns, int32_t rows, float cellWidth, float cellHeight, float fontWidth, float fontHeight) :
+	width(width), height(height), columns(columns), rows(rows), cellWidth(cellWidth), cellHeight(cellHeight), fontWidth(fontWidth), fontHeight(fontHeight), allLayouts(), frame(0), maxUnusedFrames(60)
+{
+}
+
+FontLayout::~FontLayout()
+{
+	allLayouts.clear();
+}
+
+void FontLayout::createLayout(const string& text, vector<float>& allGlyphs) const
+{
+	float cellWidthNormalized = cellWidth / width;
+	float cellHeightNormalized = cellHeight / height;
+
+	allGlyphs.clear();
+	allGlyphs.reserve(text.size() * FLOATS_PER_GLYPH);
+
+	float currentX = 0.0f;
+	float currentY = 0.0f;
+
+	for (uint32_t i = 0; i < text.size(); i++)
+	{
+		uint8_t c = static_cast<uint8_t>(text[i]);
+
+		if (c == '\n')
+		{
+			currentX = 0.0f;
+			currentY += fontHeight;
+
+			continue;
+		}
+
+		float left = static_cast<float>(c % columns) * cellWidthNormalized;
+		float top = 1.0f - static_cast<float>(c / rows) * cellHeightNormalized;
+
+		allGlyphs.push_back(currentX);
+		allGlyphs.push_back(-currentY - cellHeight);
+		allGlyphs.push_back(currentX + cellWidth);
+		allGlyphs.push_back(-currentY);
+
+		allGlyphs.push_back(left);
+		allGlyphs.push_back(top - cellHeightNormalized);
+		allGlyphs.push_back(left + cellWidthNormalized);
+		allGlyphs.push_back(top);
+
+		currentX += fontWidth;
+	}
+}
+
+const vector<float>& FontLayout::getLayout(const string& text)
+{
+	auto walker = allLayouts.find(text);
+
+	if (walker == allLayouts.end())
+	{
+		walker = allLayouts.insert(make_pair(text, CachedLayout())).first;
+
+		createLayout(text, walker->second.allGlyphs);
+	}
+
+	walker->second.lastUsedFrame = frame;
+
+	return walker->second.allGlyphs;
+}
+
+uint32_t FontLayout::appendQuads(const string& text, float originX, float originY, const Color& color, vector<float>& vertices)
+{
+	const vector<float>& allGlyphs = getLayout(text);
+
+	uint32_t numberGlyphs = static_cast<uint32_t>(allGlyphs.size()) / FLOATS_PER_GLYPH;
+
+	if (numberGlyphs == 0)
+	{
+		return 0;
+	}
+
+	const float* rgba = color.getRGBA();
+
+	size_t first = vertices.size();
+
+	vertices.resize(first + numberGlyphs * VERTICES_PER_GLYPH * FLOATS_PER_VERTEX);
+
+	float* current = &vertices[first];
+
+	for (uint32_t glyph = 0; glyph < numberGlyphs; glyph++)
+	{
+		const float* quad = &allGlyphs[glyph * FLOATS_PER_GLYPH];
+
+		// Corners in the order left bottom, right bottom, left top and right top.
+		for (int32_t corner = 0; corner < VERTICES_PER_GLYPH; corner++)
+		{
+			int32_t horizontal = corner & 1 ? 2 : 0;
+			int32_t vertical = corner & 2 ? 3 : 1;
+
+			current[0] = originX + quad[horizontal];
+			current[1] = originY + quad[vertical];
+			current[2] = quad[4 + horizontal];
+			current[3] = quad[4 + vertical];
+			current[4] = rgba[0];
+			current[5] = rgba[1];
+			current[6] = rgba[2];
+			current[7] = rgba[3];
+
+			current += FLOATS_PER_VERTEX;
+		}
+	}
+
+	return numberGlyphs;
+}
+
+void FontLayout::createIndices(uint32_t numberGlyphs, vector<GLuint>& indices)
+{
+	indices.resize(numberGlyphs * INDICES_PER_GLYPH);
+
+	for (uint32_t glyph = 0; glyph < numberGlyphs; glyph++)
+	{
+		GLuint first = glyph * VERTICES_PER_GLYPH;
+
+		GLuint* current = &indices[glyph * INDICES_PER_GLYPH];
+
+		current[0] = first;
+		current[1] = first + 1;
+		current[2] = first + 2;
+		current[3] = first + 1;
+		current[4] = first + 3;
+		current[5] = first + 2;
+	}
+}
+
+void FontLayout::nextFrame()
+{
+	auto walker = allLayouts.begin();
+	while (walker != allLayouts.end())
+	{
+		if (frame - walker->second.lastUsedFrame >= maxUnusedFrames)
+		{
+			walker = allLayouts.erase(walker);
+		}
+		else
+		{
+			walker++;
+		}
+	}
+
+	frame++;
+}
+
+int32_t FontLayout::getNumberCachedLayouts() const
+{
+	return static_cast<int32_t>(allLayouts.size());
+}
+
+uint32_t FontLayout::getMaxUnusedFrames() const
+{
+	return maxUnusedFrames;
+}
+
+void FontLayout::setMaxUnusedFrames(uint32_t maxUnusedFrames)
+{
+	this->maxUnusedFrames = maxUnusedFrames;
+}
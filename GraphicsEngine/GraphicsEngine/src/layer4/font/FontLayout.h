@@ -0,0 +1,97 @@
+/*
+ * FontLayout.h
+ *
+ *  Created on: 19.10.2026
+ *      Author: nopper
+ */
+
+#ifndef FONTLAYOUT_H_
+#define FONTLAYOUT_H_
+
+#include "../../UsedLibs.h"
+
+#include "../../layer0/color/Color.h"
+
+/**
+ * Creates the glyph quads of strings for a monospaced bitmap font, where the characters are arranged in a grid.
+ * The layout of a string is cached, until it has not been used for a number of frames. Does not need a context.
+ */
+class FontLayout
+{
+
+private:
+
+	struct CachedLayout
+	{
+		std::vector<float> allGlyphs;
+
+		std::uint32_t lastUsedFrame;
+	};
+
+	float width;
+	float height;
+	std::int32_t columns;
+	std::int32_t rows;
+	float cellWidth;
+	float cellHeight;
+	float fontWidth;
+	float fontHeight;
+
+	std::map<std::string, CachedLayout> allLayouts;
+
+	std::uint32_t frame;
+
+	std::uint32_t maxUnusedFrames;
+
+	void createLayout(const std::string& text, std::vector<float>& allGlyphs) const;
+
+public:
+
+	/**
+	 * Position, texture coordinate and color.
+	 */
+	static const std::int32_t FLOATS_PER_VERTEX = 8;
+
+	static const std::int32_t VERTICES_PER_GLYPH = 4;
+
+	static const std::int32_t INDICES_PER_GLYPH = 6;
+
+	/**
+	 * Left, bottom, right and top of the quad relative to the origin, followed by the same for the texture coordinates.
+	 */
+	static const std::int32_t FLOATS_PER_GLYPH = 8;
+
+	FontLayout(float width, float height, std::int32_t columns, std::int32_t rows, float cellWidth, float cellHeight, float fontWidth, float fontHeight);
+	virtual ~FontLayout();
+
+	/**
+	 * @return The glyphs of the text. The origin is the upper left corner, y is pointing up.
+	 */
+	const std::vector<float>& getLayout(const std::string& text);
+
+	/**
+	 * Appends the quads of the text moved to the origin.
+	 *
+	 * @return Number of appended glyphs.
+	 */
+	std::uint32_t appendQuads(const std::string& text, float originX, float originY, const Color& color, std::vector<float>& vertices);
+
+	/**
+	 * Creates the indices of two triangles per glyph quad.
+	 */
+	static void createIndices(std::uint32_t numberGlyphs, std::vector<GLuint>& indices);
+
+	/**
+	 * Removes layouts, which have not been used for the maximum number of unused frames.
+	 */
+	void nextFrame();
+
+	std::int32_t getNumberCachedLayouts() const;
+
+	std::uint32_t getMaxUnusedFrames() const;
+
+	void setMaxUnusedFrames(std::uint32_t maxUnusedFrames);
+
+};
+
+#endif /* FONTLAYOUT_H_ */
@@ -34,3 +34,23 @@ void FontManager::setFont(const string& key, const FontSP& font)
 {
 	allFonts[key] = font;
 }
+
+void FontManager::setBatching(bool batching)
+{
+	auto walker = allFonts.begin();
+	while (walker != allFonts.end())
+	{
+		walker->second->setBatching(batching);
+		walker++;
+	}
+}
+
+void FontManager::flush()
+{
+	auto walker = allFonts.begin();
+	while (walker != allFonts.end())
+	{
+		walker->second->flush();
+		walker++;
+	}
+}
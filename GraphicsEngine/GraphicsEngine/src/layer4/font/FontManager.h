@@ -33,6 +33,16 @@ public:
 
 	void setFont(const std::string& key, const FontSP& font);
 
+	/**
+	 * Enables or disables batching for all fonts.
+	 */
+	void setBatching(bool batching);
+
+	/**
+	 * Draws the collected text of all fonts, so each font needs one draw call per frame.
+	 */
+	void flush();
+
 };
 
 #endif /* FONTMANAGER_H_ */
@@ -15,14 +15,18 @@ FontVAO::FontVAO(const ProgramSP& program, const Font& font) :
 {
 	generateVAO();
 
+	GLsizei stride = FontLayout::FLOATS_PER_VERTEX * sizeof(GLfloat);
+
 	glBindBuffer(GL_ARRAY_BUFFER, font.getVboVertices());
-	glVertexAttribPointer(program->getAttribLocation(a_vertex), 4, GL_FLOAT, GL_FALSE, 0, 0);
+	glVertexAttribPointer(program->getAttribLocation(a_vertex), 2, GL_FLOAT, GL_FALSE, stride, 0);
 	glEnableVertexAttribArray(program->getAttribLocation(a_vertex));
 
-	glBindBuffer(GL_ARRAY_BUFFER, font.getVboTexCoords());
-	glVertexAttribPointer(program->getAttribLocation(a_texCoord), 2, GL_FLOAT, GL_FALSE, 0, 0);
+	glVertexAttribPointer(program->getAttribLocation(a_texCoord), 2, GL_FLOAT, GL_FALSE, stride, reinterpret_cast<const GLvoid*>(2 * sizeof(GLfloat)));
 	glEnableVertexAttribArray(program->getAttribLocation(a_texCoord));
 
+	glVertexAttribPointer(program->getAttribLocation(a_color), 4, GL_FLOAT, GL_FALSE, stride, reinterpret_cast<const GLvoid*>(4 * sizeof(GLfloat)));
+	glEnableVertexAttribArray(program->getAttribLocation(a_color));
+
 	glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, font.getVboIndices());
 
 	glEnableVertexAttribArray(0);
@@ -12,7 +12,7 @@
 using namespace std;
 
 OrthographicCameraCascadedShadowMap2D::OrthographicCameraCascadedShadowMap2D(int32_t size, int32_t sections) :
-		size(size), sections(sections)
+		size(size), sections(sections), receiverBoundsValid(false), receiverBounds(), casterBoundsValid(false), casterBounds(), allShadowCasters(sections)
 {
 	char buffer[256];
 	sprintf(buffer, "%p", this);
@@ -41,6 +41,7 @@ OrthographicCameraCascadedShadowMap2D::~OrthographicCameraCascadedShadowMap2D()
 {
 	allOrthographicCameras.clear();
 	allShadowMatrices.clear();
+	allShadowCasters.clear();
 }
 
 void OrthographicCameraCascadedShadowMap2D::use(bool enable, int32_t section) const
@@ -65,6 +66,51 @@ void OrthographicCameraCascadedShadowMap2D::updateShadowMatrices()
 	}
 }
 
+void OrthographicCameraCascadedShadowMap2D::adjustToFrustum(const ViewFrustum& viewFrustum, int32_t section, const Quaternion& lightRotation)
+{
+	allOrthographicCameras[section]->adjustToFrustum(viewFrustum, section, lightRotation, size, getReceiverBounds(), getCasterBounds());
+}
+
+void OrthographicCameraCascadedShadowMap2D::setReceiverBounds(const AxisAlignedBoundingBox& receiverBounds)
+{
+	this->receiverBounds = receiverBounds;
+
+	receiverBoundsValid = true;
+}
+
+void OrthographicCameraCascadedShadowMap2D::setCasterBounds(const AxisAlignedBoundingBox& casterBounds)
+{
+	this->casterBounds = casterBounds;
+
+	casterBoundsValid = true;
+}
+
+void OrthographicCameraCascadedShadowMap2D::resetBounds()
+{
+	receiverBoundsValid = false;
+	casterBoundsValid = false;
+}
+
+const AxisAlignedBoundingBox* OrthographicCameraCascadedShadowMap2D::getReceiverBounds() const
+{
+	return receiverBoundsValid ? &receiverBounds : nullptr;
+}
+
+const AxisAlignedBoundingBox* OrthographicCameraCascadedShadowMap2D::getCasterBounds() const
+{
+	return casterBoundsValid ? &casterBounds : nullptr;
+}
+
+vector<Entity*>& OrthographicCameraCascadedShadowMap2D::getShadowCasters(int32_t section)
+{
+	return allShadowCasters[section];
+}
+
+const vector<Entity*>& OrthographicCameraCascadedShadowMap2D::getShadowCasters(int32_t section) const
+{
+	return allShadowCasters[section];
+}
+
 const OrthographicCameraSP& OrthographicCameraCascadedShadowMap2D::getOrthographicCamera(int32_t section) const
 {
 	return allOrthographicCameras[section];
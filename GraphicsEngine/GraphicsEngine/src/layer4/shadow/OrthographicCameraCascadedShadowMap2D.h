@@ -11,8 +11,10 @@
 #include "../../UsedLibs.h"
 
 #include "../../layer0/math/Matrix4x4.h"
+#include "../../layer1/collision/AxisAlignedBoundingBox.h"
 #include "../../layer3/camera/OrthographicCamera.h"
 #include "../../layer3/shadow/ShadowMap2D.h"
+#include "../entity/Entity.h"
 
 class OrthographicCameraCascadedShadowMap2D
 {
@@ -30,6 +32,14 @@ private:
 	std::vector<OrthographicCameraSP> allOrthographicCameras;
 	std::vector<Matrix4x4> allShadowMatrices;
 
+	bool receiverBoundsValid;
+	AxisAlignedBoundingBox receiverBounds;
+
+	bool casterBoundsValid;
+	AxisAlignedBoundingBox casterBounds;
+
+	std::vector<std::vector<Entity*> > allShadowCasters;
+
 public:
 
 	OrthographicCameraCascadedShadowMap2D(std::int32_t size, std::int32_t sections);
@@ -39,6 +49,36 @@ public:
 
 	void updateShadowMatrices();
 
+	/**
+	 * Fits the camera of the section around the section of the view frustum, using the receiver and caster bounds if set.
+	 *
+	 * @see OrthographicCamera::adjustToFrustum
+	 */
+	void adjustToFrustum(const ViewFrustum& viewFrustum, std::int32_t section, const Quaternion& lightRotation);
+
+	void setReceiverBounds(const AxisAlignedBoundingBox& receiverBounds);
+
+	void setCasterBounds(const AxisAlignedBoundingBox& casterBounds);
+
+	void resetBounds();
+
+	/**
+	 * @return Null, if no bounds are set.
+	 */
+	const AxisAlignedBoundingBox* getReceiverBounds() const;
+
+	/**
+	 * @return Null, if no bounds are set.
+	 */
+	const AxisAlignedBoundingBox* getCasterBounds() const;
+
+	/**
+	 * Casters, which are inside the camera of the section. Filled by the culling.
+	 */
+	std::vector<Entity*>& getShadowCasters(std::int32_t section);
+
+	const std::vector<Entity*>& getShadowCasters(std::int32_t section) const;
+
 	const OrthographicCameraSP& getOrthographicCamera(std::int32_t section) const;
 
 	const Matrix4x4& getShadowMatrix(std::int32_t section) const;
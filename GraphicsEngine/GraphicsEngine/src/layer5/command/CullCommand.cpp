@@ -0,0 +1,63 @@
+/*
+ * CullCommand.cpp
+ *
+ *  Created on: 19.10.2026
+ *      Author: nopper
+ */
+
+#include "CullCommand.h"
+
+using namespace std;
+
+CullCommand::CullCommand(const CullCommandRecycleQueueSP& cullCommandRecycleQueue, const ThreadSafeCounterSP& taskCounter) : Command(), cullCommandRecycleQueue(cullCommandRecycleQueue), taskCounter(taskCounter), viewFrustum(nullptr), allEntities(nullptr), visibleEntities(nullptr)
+{
+}
+
+CullCommand::~CullCommand()
+{
+}
+
+bool CullCommand::execute()
+{
+	assert(this->taskCounter.get() != nullptr);
+	assert(this->viewFrustum != nullptr);
+	assert(this->allEntities != nullptr);
+	assert(this->visibleEntities != nullptr);
+
+	visibleEntities->clear();
+
+	auto walker = allEntities->begin();
+	while (walker != allEntities->end())
+	{
+		if (viewFrustum->isVisible((*walker)->getBoundingSphere()))
+		{
+			visibleEntities->push_back(*walker);
+		}
+
+		walker++;
+	}
+
+	taskCounter->decrement();
+
+	return true;
+}
+
+void CullCommand::recycle()
+{
+	viewFrustum = nullptr;
+	allEntities = nullptr;
+	visibleEntities = nullptr;
+	cullCommandRecycleQueue->add(this);
+}
+
+void CullCommand::init(const ViewFrustum* viewFrustum, const vector<Entity*>* allEntities, vector<Entity*>* visibleEntities)
+{
+	assert(this->taskCounter.get() != nullptr);
+	assert(this->viewFrustum == nullptr);
+
+	taskCounter->increment();
+
+	this->viewFrustum = viewFrustum;
+	this->allEntities = allEntities;
+	this->visibleEntities = visibleEntities;
+}
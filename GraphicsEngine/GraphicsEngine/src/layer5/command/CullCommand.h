@@ -0,0 +1,53 @@
+/*
+ * CullCommand.h
+ *
+ *  Created on: 19.10.2026
+ *      Author: nopper
+ */
+
+#ifndef CULLCOMMAND_H_
+#define CULLCOMMAND_H_
+
+#include "../../layer0/concurrency/ThreadSafeCounter.h"
+#include "../../layer1/command/Command.h"
+#include "../../layer3/camera/ViewFrustum.h"
+#include "../../layer4/entity/Entity.h"
+
+/**
+ * Collects the entities, whose bounding sphere is inside the view frustum. The input is only read, so several commands
+ * can share it, as long as each command writes to its own result.
+ */
+class CullCommand: public Command
+{
+
+	friend class EntityCommandManager;
+
+private:
+
+	std::shared_ptr<ThreadsafeQueue<CullCommand*> > cullCommandRecycleQueue;
+
+	ThreadSafeCounterSP taskCounter;
+
+	const ViewFrustum* viewFrustum;
+
+	const std::vector<Entity*>* allEntities;
+
+	std::vector<Entity*>* visibleEntities;
+
+	CullCommand(const std::shared_ptr<ThreadsafeQueue<CullCommand*> >& cullCommandRecycleQueue, const ThreadSafeCounterSP& taskCounter);
+
+	virtual ~CullCommand();
+
+public:
+
+	virtual bool execute();
+
+	virtual void recycle();
+
+	void init(const ViewFrustum* viewFrustum, const std::vector<Entity*>* allEntities, std::vector<Entity*>* visibleEntities);
+
+};
+
+typedef std::shared_ptr<ThreadsafeQueue<CullCommand*> > CullCommandRecycleQueueSP;
+
+#endif /* CULLCOMMAND_H_ */
@@ -15,6 +15,10 @@ EntityCommandManager::EntityCommandManager() :
 	updateTaskCounter = ThreadSafeCounterSP(new ThreadSafeCounter());
 
 	updateCommandRecycleQueue = UpdateCommandRecycleQueueSP(new ThreadsafeQueue<UpdateCommand*>());
+
+	cullTaskCounter = ThreadSafeCounterSP(new ThreadSafeCounter());
+
+	cullCommandRecycleQueue = CullCommandRecycleQueueSP(new ThreadsafeQueue<CullCommand*>());
 }
 
 EntityCommandManager::~EntityCommandManager()
@@ -30,6 +34,18 @@ EntityCommandManager::~EntityCommandManager()
 	updateCommandRecycleQueue.reset();
 
 	updateTaskCounter.reset();
+
+	CullCommand* currentCullCommand = nullptr;
+	available = cullCommandRecycleQueue->take(currentCullCommand);
+	while(available)
+	{
+		delete currentCullCommand;
+
+		available = cullCommandRecycleQueue->take(currentCullCommand);
+	}
+	cullCommandRecycleQueue.reset();
+
+	cullTaskCounter.reset();
 }
 
 void EntityCommandManager::publishUpdateCommand(Entity* entity)
@@ -51,3 +67,23 @@ void EntityCommandManager::waitUpdateAllFinished()
 {
 	updateTaskCounter->waitUntilZero();
 }
+
+void EntityCommandManager::publishCullCommand(const ViewFrustum* viewFrustum, const std::vector<Entity*>* allEntities, std::vector<Entity*>* visibleEntities)
+{
+	CullCommand* currentCullCommand = nullptr;
+	bool available = cullCommandRecycleQueue->take(currentCullCommand);
+
+	if (!available)
+	{
+		currentCullCommand = new CullCommand(cullCommandRecycleQueue, cullTaskCounter);
+	}
+
+	currentCullCommand->init(viewFrustum, allEntities, visibleEntities);
+
+	WorkerManager::getInstance()->sendCommand(currentCullCommand);
+}
+
+void EntityCommandManager::waitCullAllFinished()
+{
+	cullTaskCounter->waitUntilZero();
+}
@@ -12,6 +12,7 @@
 #include "../../layer0/stereotype/Singleton.h"
 #include "../../layer4/entity/Entity.h"
 
+#include "CullCommand.h"
 #include "UpdateCommand.h"
 
 class EntityCommandManager : public Singleton<EntityCommandManager>
@@ -25,6 +26,10 @@ private:
 
 	ThreadSafeCounterSP updateTaskCounter;
 
+	CullCommandRecycleQueueSP cullCommandRecycleQueue;
+
+	ThreadSafeCounterSP cullTaskCounter;
+
 	EntityCommandManager();
 	~EntityCommandManager();
 
@@ -34,6 +39,13 @@ public:
 
 	void waitUpdateAllFinished();
 
+	/**
+	 * The frustum, the entities and the result have to stay valid until waitCullAllFinished returns.
+	 */
+	void publishCullCommand(const ViewFrustum* viewFrustum, const std::vector<Entity*>* allEntities, std::vector<Entity*>* visibleEntities);
+
+	void waitCullAllFinished();
+
 };
 
 #endif /* ENTITYCOMMANDMANAGER_H_ */
@@ -13,7 +13,7 @@
 using namespace std;
 
 DynamicEnvironment::DynamicEnvironment(const Point4& position, const FrameBufferCubeMapSP& frameBufferCubeMap) :
-		frameBufferCubeMap(frameBufferCubeMap), lastPosition(position)
+		frameBufferCubeMap(frameBufferCubeMap), lastPosition(position), scheduledFaces(0x3F), allScheduledEntities()
 {
 	char buffer[256];
 	sprintf(buffer, "%p", this);
@@ -25,6 +25,11 @@ DynamicEnvironment::DynamicEnvironment(const Point4& position, const FrameBuffer
 	for (int32_t face = 0; face < 6; face++)
 	{
 		camera[face] = PerspectiveCameraSP(new PerspectiveCamera("DynamicEnvironment" + to_string(face)));
+
+		faceValid[face] = false;
+		faceSignature[face] = 0;
+		currentFaceSignature[face] = 0;
+		faceAge[face] = 0;
 	}
 
 	init(position);
@@ -98,12 +103,7 @@ bool DynamicEnvironment::use(const Point4& position)
 
 	frameBufferCubeMap->use(true);
 
-	if (lastPosition != position)
-	{
-		lastPosition = position;
-
-		init(position);
-	}
+	updatePosition(position);
 
 	Matrix4x4 mirrorMatrix;
 	mirrorMatrix.scale(-1.0f, -1.0f, 1.0f);
@@ -113,6 +113,7 @@ bool DynamicEnvironment::use(const Point4& position)
 		Entity::setCubeMapViewMatrix(face, mirrorMatrix * camera[face]->getViewMatrix());
 	}
 	Entity::setCubeMapProjectionMatrix(camera[0]->getProjectionMatrix());
+	Entity::setCubeMapFaceMask(scheduledFaces);
 
 	return true;
 }
@@ -126,5 +127,177 @@ bool DynamicEnvironment::unuse()
 
 	frameBufferCubeMap->use(false);
 
+	for (int32_t face = 0; face < 6; face++)
+	{
+		if (scheduledFaces & (1 << face))
+		{
+			faceValid[face] = true;
+			faceSignature[face] = currentFaceSignature[face];
+			faceAge[face] = 0;
+		}
+	}
+
+	// Without scheduling, all faces are rendered.
+	scheduledFaces = 0x3F;
+
+	Entity::setCubeMapFaceMask(0x3F);
+
+	return true;
+}
+
+bool DynamicEnvironment::updatePosition(const Point4& position)
+{
+	if (lastPosition == position)
+	{
+		return false;
+	}
+
+	lastPosition = position;
+
+	init(position);
+
+	invalidate();
+
 	return true;
 }
+
+void DynamicEnvironment::invalidate()
+{
+	for (int32_t face = 0; face < 6; face++)
+	{
+		faceValid[face] = false;
+	}
+}
+
+vector<Entity*>& DynamicEnvironment::getVisibleEntities(int32_t face)
+{
+	return allVisibleEntities[face];
+}
+
+size_t DynamicEnvironment::calculateSignature(int32_t face) const
+{
+	hash<const Entity*> entityHash;
+	hash<float> floatHash;
+
+	size_t result = allVisibleEntities[face].size();
+
+	auto walker = allVisibleEntities[face].begin();
+	while (walker != allVisibleEntities[face].end())
+	{
+		const BoundingSphere& boundingSphere = (*walker)->getBoundingSphere();
+
+		size_t values[5] = { entityHash(*walker), floatHash(boundingSphere.getCenter().getX()), floatHash(boundingSphere.getCenter().getY()), floatHash(boundingSphere.getCenter().getZ()), floatHash(boundingSphere.getRadius()) };
+
+		for (int32_t i = 0; i < 5; i++)
+		{
+			result ^= values[i] + 0x9e3779b9 + (result << 6) + (result >> 2);
+		}
+
+		// Rotating or scaling in place keeps the bounding sphere.
+		const float* modelMatrix = (*walker)->getModelMatrix().getM();
+
+		for (int32_t i = 0; i < 16; i++)
+		{
+			result ^= floatHash(modelMatrix[i]) + 0x9e3779b9 + (result << 6) + (result >> 2);
+		}
+
+		walker++;
+	}
+
+	return result;
+}
+
+bool DynamicEnvironment::isFaceChanged(int32_t face)
+{
+	currentFaceSignature[face] = calculateSignature(face);
+
+	if (!faceValid[face] || faceSignature[face] != currentFaceSignature[face])
+	{
+		return true;
+	}
+
+	// Animated entities may change their look without changing the signature.
+	auto walker = allVisibleEntities[face].begin();
+	while (walker != allVisibleEntities[face].end())
+	{
+		if ((*walker)->isUpdateable())
+		{
+			return true;
+		}
+
+		walker++;
+	}
+
+	return false;
+}
+
+uint32_t DynamicEnvironment::getFaceAge(int32_t face) const
+{
+	return faceAge[face];
+}
+
+void DynamicEnvironment::setScheduledFaces(int32_t faceMask)
+{
+	scheduledFaces = faceMask & 0x3F;
+
+	allScheduledEntities.clear();
+
+	for (int32_t face = 0; face < 6; face++)
+	{
+		if ((scheduledFaces & (1 << face)) == 0)
+		{
+			faceAge[face]++;
+
+			continue;
+		}
+
+		auto walker = allVisibleEntities[face].begin();
+		while (walker != allVisibleEntities[face].end())
+		{
+			if (find(allScheduledEntities.begin(), allScheduledEntities.end(), *walker) == allScheduledEntities.end())
+			{
+				allScheduledEntities.push_back(*walker);
+			}
+
+			walker++;
+		}
+	}
+
+	vector<pair<float, Entity*> > sortKeys;
+	sortKeys.reserve(allScheduledEntities.size());
+
+	auto walker = allScheduledEntities.begin();
+	while (walker != allScheduledEntities.end())
+	{
+		sortKeys.push_back(make_pair(((*walker)->getBoundingSphere().getCenter() - lastPosition).length(), *walker));
+
+		walker++;
+	}
+
+	stable_sort(sortKeys.begin(), sortKeys.end());
+
+	for (uint32_t i = 0; i < sortKeys.size(); i++)
+	{
+		allScheduledEntities[i] = sortKeys[i].second;
+	}
+}
+
+int32_t DynamicEnvironment::getScheduledFaces() const
+{
+	return scheduledFaces;
+}
+
+const vector<Entity*>& DynamicEnvironment::getScheduledEntities() const
+{
+	return allScheduledEntities;
+}
+
+void DynamicEnvironment::clearScheduledFaces(GLbitfield buffers) const
+{
+	if (!frameBufferCubeMap.get())
+	{
+		return;
+	}
+
+	frameBufferCubeMap->clearFaces(scheduledFaces, buffers);
+}
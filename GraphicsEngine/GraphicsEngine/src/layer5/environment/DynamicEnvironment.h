@@ -13,6 +13,7 @@
 #include "../../layer2/framebuffer/FrameBufferCubeMap.h"
 #include "../../layer3/camera/PerspectiveCamera.h"
 #include "../../layer3/camera/Viewport.h"
+#include "../../layer4/entity/Entity.h"
 
 class DynamicEnvironment
 {
@@ -26,8 +27,21 @@ private:
 
 	Point4 lastPosition;
 
+	std::vector<Entity*> allVisibleEntities[6];
+
+	bool faceValid[6];
+	std::size_t faceSignature[6];
+	std::size_t currentFaceSignature[6];
+	std::uint32_t faceAge[6];
+
+	std::int32_t scheduledFaces;
+
+	std::vector<Entity*> allScheduledEntities;
+
 	void init(const Point4& position);
 
+	std::size_t calculateSignature(std::int32_t face) const;
+
 public:
 	DynamicEnvironment(const Point4& position, const FrameBufferCubeMapSP& frameBufferCubeMap);
 	virtual ~DynamicEnvironment();
@@ -40,6 +54,49 @@ public:
 
 	bool unuse();
 
+	/**
+	 * Moves the cameras to the new position. All faces have to be rendered again afterwards.
+	 *
+	 * @return True, if the position did change.
+	 */
+	bool updatePosition(const Point4& position);
+
+	/**
+	 * Forces all faces to be rendered again e.g. if the sky did change.
+	 */
+	void invalidate();
+
+	/**
+	 * Entities inside the frustum of the face, filled by the culling.
+	 */
+	std::vector<Entity*>& getVisibleEntities(std::int32_t face);
+
+	/**
+	 * Compares the visible entities, their bounding spheres and model matrices with the ones of the last rendering of the
+	 * face. A face with an updateable, e.g. animated, entity is always changed.
+	 */
+	bool isFaceChanged(std::int32_t face);
+
+	/**
+	 * Frames since the face was rendered.
+	 */
+	std::uint32_t getFaceAge(std::int32_t face) const;
+
+	/**
+	 * Sets the faces to be rendered with the next use. The visible entities of these faces are collected sorted by
+	 * the distance to the center of the cube map. All other faces get older by one frame.
+	 */
+	void setScheduledFaces(std::int32_t faceMask);
+
+	std::int32_t getScheduledFaces() const;
+
+	const std::vector<Entity*>& getScheduledEntities() const;
+
+	/**
+	 * Clears the scheduled faces. The frame buffer has to be in use.
+	 */
+	void clearScheduledFaces(GLbitfield buffers) const;
+
 };
 
 typedef std::shared_ptr<DynamicEnvironment> DynamicEnvironmentSP;
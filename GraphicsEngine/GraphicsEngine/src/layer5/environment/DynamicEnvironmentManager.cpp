@@ -7,14 +7,16 @@
 
 #include "../../layer1/texture/TextureCubeMap.h"
 #include "../../layer1/texture/TextureFactory.h"
+#include "../../layer1/command/WorkerManager.h"
 #include "../../layer2/framebuffer/FrameBufferCubeMapManager.h"
+#include "../command/EntityCommandManager.h"
 
 #include "DynamicEnvironmentManager.h"
 
 using namespace std;
 
 DynamicEnvironmentManager::DynamicEnvironmentManager() :
-		Singleton<DynamicEnvironmentManager>(), allDynamicEnvironments()
+		Singleton<DynamicEnvironmentManager>(), allDynamicEnvironments(), facesPerFrame(0), scheduling(CUBE_MAP_ROUND_ROBIN), skipUnchangedFaces(false)
 {
 }
 
@@ -56,3 +58,129 @@ const KeyValueMap<EntitySP, DynamicEnvironmentSP>& DynamicEnvironmentManager::ge
 {
 	return allDynamicEnvironments;
 }
+
+void DynamicEnvironmentManager::setFacesPerFrame(int32_t facesPerFrame)
+{
+	this->facesPerFrame = facesPerFrame > 0 ? facesPerFrame : 0;
+}
+
+int32_t DynamicEnvironmentManager::getFacesPerFrame() const
+{
+	return facesPerFrame;
+}
+
+void DynamicEnvironmentManager::setScheduling(enum CubeMapScheduling scheduling)
+{
+	this->scheduling = scheduling;
+}
+
+enum CubeMapScheduling DynamicEnvironmentManager::getScheduling() const
+{
+	return scheduling;
+}
+
+void DynamicEnvironmentManager::setSkipUnchangedFaces(bool skipUnchangedFaces)
+{
+	this->skipUnchangedFaces = skipUnchangedFaces;
+}
+
+bool DynamicEnvironmentManager::isSkipUnchangedFaces() const
+{
+	return skipUnchangedFaces;
+}
+
+void DynamicEnvironmentManager::schedule(const Point4& viewerPosition, const vector<Entity*>& allEntities)
+{
+	auto walker = allDynamicEnvironments.begin();
+	while (walker != allDynamicEnvironments.end())
+	{
+		walker->second->updatePosition(walker->first->getBoundingSphere().getCenter());
+
+		for (int32_t face = 0; face < 6; face++)
+		{
+			const ViewFrustum* viewFrustum = &walker->second->getCamera(face)->getViewFrustum();
+
+			vector<Entity*>* visibleEntities = &walker->second->getVisibleEntities(face);
+
+			if (WorkerManager::getInstance()->getNumberWorkers() == 0)
+			{
+				visibleEntities->clear();
+
+				auto entityWalker = allEntities.begin();
+				while (entityWalker != allEntities.end())
+				{
+					if (viewFrustum->isVisible((*entityWalker)->getBoundingSphere()))
+					{
+						visibleEntities->push_back(*entityWalker);
+					}
+
+					entityWalker++;
+				}
+			}
+			else
+			{
+				EntityCommandManager::getInstance()->publishCullCommand(viewFrustum, &allEntities, visibleEntities);
+			}
+		}
+
+		walker++;
+	}
+
+	if (WorkerManager::getInstance()->getNumberWorkers() > 0)
+	{
+		EntityCommandManager::getInstance()->waitCullAllFinished();
+	}
+
+	// Sorted by priority, where the largest value comes first.
+	vector<pair<float, pair<DynamicEnvironment*, int32_t> > > allCandidates;
+
+	walker = allDynamicEnvironments.begin();
+	while (walker != allDynamicEnvironments.end())
+	{
+		float distance = (walker->first->getBoundingSphere().getCenter() - viewerPosition).length();
+
+		for (int32_t face = 0; face < 6; face++)
+		{
+			vector<Entity*>& visibleEntities = walker->second->getVisibleEntities(face);
+
+			auto ownEntity = find(visibleEntities.begin(), visibleEntities.end(), walker->first.get());
+			if (ownEntity != visibleEntities.end())
+			{
+				visibleEntities.erase(ownEntity);
+			}
+
+			if (!walker->second->isFaceChanged(face) && skipUnchangedFaces)
+			{
+				continue;
+			}
+
+			float priority = static_cast<float>(walker->second->getFaceAge(face) + 1);
+
+			if (scheduling == CUBE_MAP_PRIORITY_BY_DISTANCE)
+			{
+				priority /= 1.0f + distance;
+			}
+
+			allCandidates.push_back(make_pair(-priority, make_pair(walker->second.get(), face)));
+		}
+
+		walker++;
+	}
+
+	stable_sort(allCandidates.begin(), allCandidates.end());
+
+	map<DynamicEnvironment*, int32_t> allFaceMasks;
+
+	for (uint32_t i = 0; i < allCandidates.size() && (facesPerFrame == 0 || static_cast<int32_t>(i) < facesPerFrame); i++)
+	{
+		allFaceMasks[allCandidates[i].second.first] |= 1 << allCandidates[i].second.second;
+	}
+
+	walker = allDynamicEnvironments.begin();
+	while (walker != allDynamicEnvironments.end())
+	{
+		walker->second->setScheduledFaces(allFaceMasks[walker->second.get()]);
+
+		walker++;
+	}
+}
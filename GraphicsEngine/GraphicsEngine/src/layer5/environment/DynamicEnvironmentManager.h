@@ -18,6 +18,8 @@
 
 #include "DynamicEnvironment.h"
 
+enum CubeMapScheduling {CUBE_MAP_ROUND_ROBIN, CUBE_MAP_PRIORITY_BY_DISTANCE};
+
 class DynamicEnvironmentManager : public Singleton<DynamicEnvironmentManager>
 {
 
@@ -27,6 +29,12 @@ protected:
 
 	KeyValueMap<EntitySP, DynamicEnvironmentSP> allDynamicEnvironments;
 
+	std::int32_t facesPerFrame;
+
+	enum CubeMapScheduling scheduling;
+
+	bool skipUnchangedFaces;
+
 	DynamicEnvironmentManager();
 	virtual ~DynamicEnvironmentManager();
 
@@ -36,6 +44,33 @@ public:
 
 	const KeyValueMap<EntitySP, DynamicEnvironmentSP>& getKeyValueMap() const;
 
+	/**
+	 * @param facesPerFrame Maximum of cube map faces rendered per frame over all dynamic environments. Zero renders all faces.
+	 */
+	void setFacesPerFrame(std::int32_t facesPerFrame);
+
+	std::int32_t getFacesPerFrame() const;
+
+	/**
+	 * Round robin renders the oldest faces first. By distance, older faces of environments closer to the viewer are preferred.
+	 */
+	void setScheduling(enum CubeMapScheduling scheduling);
+
+	enum CubeMapScheduling getScheduling() const;
+
+	/**
+	 * If set, faces are only rendered, if the entities inside of them did change.
+	 */
+	void setSkipUnchangedFaces(bool skipUnchangedFaces);
+
+	bool isSkipUnchangedFaces() const;
+
+	/**
+	 * Culls the given entities against each face, one job per face, and selects the faces to be rendered this frame.
+	 * The entity of a dynamic environment is never part of its own cube map.
+	 */
+	void schedule(const Point4& viewerPosition, const std::vector<Entity*>& allEntities);
+
 };
 
 #endif /* DYNAMICENVIRONMENTMANAGER_H_ */
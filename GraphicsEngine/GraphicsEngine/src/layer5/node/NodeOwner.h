@@ -16,6 +16,8 @@
 
 class InstanceNode;
 class Node;
+class InstanceBuffer;
+class RenderPacket;
 
 class NodeOwner {
 public:
@@ -29,6 +31,10 @@ public:
 
     virtual void renderNode(const Node& node, const InstanceNode& instanceNode, float time, std::int32_t animStackIndex, std::int32_t animLayerIndex) const = 0;
 
+    virtual void renderPacket(const RenderPacket& renderPacket) const = 0;
+
+    virtual void renderPacketInstanced(const RenderPacket& renderPacket, InstanceBuffer& instanceBuffer) const = 0;
+
     virtual void addLightNode(const InstanceNodeSP& lightNode) = 0;
 
     virtual void addCameraNode(const InstanceNodeSP& cameraNode) = 0;
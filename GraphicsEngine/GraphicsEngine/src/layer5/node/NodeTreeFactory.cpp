@@ -5,6 +5,9 @@
  *      Author: nopper
  */
 
+#include "../../layer3/animation/AnimationLayer.h"
+#include "../../layer3/mesh/MeshFactory.h"
+
 #include "NodeTreeFactory.h"
 
 using namespace std;
@@ -175,3 +178,269 @@ bool NodeTreeFactory::setJoint(const string& jointName) const
 	return true;
 }
 
+bool NodeTreeFactory::hasTransformAnimationValues(const NodeSP& node) const
+{
+	// Animation stacks are often added to every node, so check for actual values.
+	for (uint32_t animStackIndex = 0; animStackIndex < node->allAnimStacks.size(); animStackIndex++)
+	{
+		const AnimationStackSP& animStack = node->allAnimStacks[animStackIndex];
+
+		for (int32_t animLayerIndex = 0; animLayerIndex < animStack->getAnimationLayersCount(); animLayerIndex++)
+		{
+			const AnimationLayerSP& animLayer = animStack->getAnimationLayer(animLayerIndex);
+
+			for (enum AnimationLayer::eCHANNELS_XYZ i = AnimationLayer::X; i <= AnimationLayer::Z; i = static_cast<enum AnimationLayer::eCHANNELS_XYZ>(i + 1))
+			{
+				if (animLayer->hasTranslationValue(i) || animLayer->hasRotationValue(i) || animLayer->hasScalingValue(i))
+				{
+					return true;
+				}
+			}
+		}
+	}
+
+	return false;
+}
+
+bool NodeTreeFactory::hasMaterialAnimationValues(const NodeSP& node) const
+{
+	for (uint32_t animStackIndex = 0; animStackIndex < node->allAnimStacks.size(); animStackIndex++)
+	{
+		const AnimationStackSP& animStack = node->allAnimStacks[animStackIndex];
+
+		for (int32_t animLayerIndex = 0; animLayerIndex < animStack->getAnimationLayersCount(); animLayerIndex++)
+		{
+			const AnimationLayerSP& animLayer = animStack->getAnimationLayer(animLayerIndex);
+
+			for (enum AnimationLayer::eCHANNELS_RGBA i = AnimationLayer::R; i <= AnimationLayer::A; i = static_cast<enum AnimationLayer::eCHANNELS_RGBA>(i + 1))
+			{
+				if (animLayer->hasEmissiveColorValue(i) || animLayer->hasAmbientColorValue(i) || animLayer->hasDiffuseColorValue(i) || animLayer->hasSpecularColorValue(i) || animLayer->hasReflectionColorValue(i) || animLayer->hasRefractionColorValue(i))
+				{
+					return true;
+				}
+			}
+
+			if (animLayer->hasShininessValue(AnimationLayer::S) || animLayer->hasTransparencyValue(AnimationLayer::S))
+			{
+				return true;
+			}
+		}
+	}
+
+	return false;
+}
+
+bool NodeTreeFactory::isStaticSubtree(const NodeSP& node, bool transparent) const
+{
+	if (node->joint || node->camera.get() || node->light.get() || !node->visible || node->transparent != transparent || hasTransformAnimationValues(node) || hasMaterialAnimationValues(node))
+	{
+		return false;
+	}
+
+	if (node->mesh.get() && (node->mesh->hasSkinning() || node->mesh->isPacked() || !node->mesh->getVertices() || !node->mesh->getIndices()))
+	{
+		return false;
+	}
+
+	auto walker = node->allChilds.begin();
+
+	while (walker != node->allChilds.end())
+	{
+		if (!isStaticSubtree(*walker, transparent))
+		{
+			return false;
+		}
+
+		walker++;
+	}
+
+	return true;
+}
+
+void NodeTreeFactory::collectStaticMeshes(const NodeSP& node, const Matrix4x4& parentMatrix, vector<pair<MeshSP, Matrix4x4> >& allParts) const
+{
+	Matrix4x4 localMatrix;
+
+	node->calculateLocalMatrix(localMatrix);
+
+	Matrix4x4 newParentMatrix = parentMatrix * localMatrix;
+
+	if (node->mesh.get())
+	{
+		allParts.push_back(make_pair(node->mesh, newParentMatrix * node->geometricTransformMatrix));
+	}
+
+	auto walker = node->allChilds.begin();
+
+	while (walker != node->allChilds.end())
+	{
+		collectStaticMeshes(*walker, newParentMatrix, allParts);
+
+		walker++;
+	}
+}
+
+int32_t NodeTreeFactory::releaseSubtree(const NodeSP& node) const
+{
+	int32_t count = 1;
+
+	// Children reference their parent, so break the cycles to free the nodes.
+	auto walker = node->allChilds.begin();
+
+	while (walker != node->allChilds.end())
+	{
+		count += releaseSubtree(*walker);
+
+		walker++;
+	}
+
+	node->allChilds.clear();
+	node->parentNode.reset();
+
+	return count;
+}
+
+int32_t NodeTreeFactory::mergeStaticNodes(const NodeSP& node, uint32_t numberLods, float lodReduction) const
+{
+	int32_t result = 0;
+
+	// The geometric transform is baked into the merged mesh, so it must not be used by a camera or light. Animated material
+	// values are applied to the whole mesh of the node, so they would also change the merged children. An animated
+	// transform is kept, as the children follow it anyway.
+	bool mergeable = !node->joint && !node->camera.get() && !node->light.get() && !hasMaterialAnimationValues(node);
+
+	if (mergeable && node->mesh.get())
+	{
+		mergeable = !node->mesh->hasSkinning() && !node->mesh->isPacked() && node->mesh->getVertices() && node->mesh->getIndices();
+	}
+
+	if (mergeable)
+	{
+		vector<pair<MeshSP, Matrix4x4> > allParts;
+		vector<NodeSP> allStaticChilds;
+
+		if (node->mesh.get())
+		{
+			allParts.push_back(make_pair(node->mesh, node->geometricTransformMatrix));
+		}
+
+		auto walker = node->allChilds.begin();
+
+		while (walker != node->allChilds.end())
+		{
+			if (isStaticSubtree(*walker, node->transparent))
+			{
+				allStaticChilds.push_back(*walker);
+
+				collectStaticMeshes(*walker, Matrix4x4(), allParts);
+			}
+
+			walker++;
+		}
+
+		if (allStaticChilds.size() > 0 && allParts.size() > 1)
+		{
+			MeshFactory meshFactory;
+
+			Point4 minimum;
+			Point4 maximum;
+
+			MeshSP mergedMesh = meshFactory.mergeMeshes(node->name, allParts, minimum, maximum);
+
+			if (mergedMesh.get())
+			{
+				if (numberLods > 1)
+				{
+					mergedMesh->generateLods(numberLods, lodReduction);
+				}
+
+				node->mesh = mergedMesh;
+				node->geometricTransformMatrix.identity();
+
+				int32_t removedNodes = 0;
+
+				auto staticWalker = allStaticChilds.begin();
+
+				while (staticWalker != allStaticChilds.end())
+				{
+					node->allChilds.erase(find(node->allChilds.begin(), node->allChilds.end(), *staticWalker));
+
+					removedNodes += releaseSubtree(*staticWalker);
+
+					staticWalker++;
+				}
+
+				glusLogPrint(GLUS_LOG_DEBUG, "Merged %d meshes of %d nodes into %s with bounds (%f %f %f) (%f %f %f)", static_cast<int32_t>(allParts.size()), removedNodes, node->name.c_str(), minimum.getX(), minimum.getY(), minimum.getZ(), maximum.getX(), maximum.getY(), maximum.getZ());
+
+				result += removedNodes;
+			}
+		}
+	}
+
+	auto walker = node->allChilds.begin();
+
+	while (walker != node->allChilds.end())
+	{
+		result += mergeStaticNodes(*walker, numberLods, lodReduction);
+
+		walker++;
+	}
+
+	return result;
+}
+
+int32_t NodeTreeFactory::mergeStaticNodes(uint32_t numberLods, float lodReduction)
+{
+	if (!rootNode.get())
+	{
+		return 0;
+	}
+
+	int32_t result = mergeStaticNodes(rootNode, numberLods, lodReduction);
+
+	if (result > 0)
+	{
+		glusLogPrint(GLUS_LOG_INFO, "Merged %d static nodes", result);
+	}
+
+	return result;
+}
+
+int32_t NodeTreeFactory::packVertices(const NodeSP& node) const
+{
+	int32_t result = 0;
+
+	// Meshes can be shared by several nodes, so only count the ones packed now.
+	if (node->mesh.get() && !node->mesh->isPacked() && node->mesh->packVertices())
+	{
+		result++;
+	}
+
+	auto walker = node->allChilds.begin();
+
+	while (walker != node->allChilds.end())
+	{
+		result += packVertices(*walker);
+
+		walker++;
+	}
+
+	return result;
+}
+
+int32_t NodeTreeFactory::packVertices() const
+{
+	if (!rootNode.get())
+	{
+		return 0;
+	}
+
+	int32_t result = packVertices(rootNode);
+
+	if (result > 0)
+	{
+		glusLogPrint(GLUS_LOG_INFO, "Packed the vertices of %d meshes", result);
+	}
+
+	return result;
+}
@@ -27,6 +27,26 @@ private:
 
 	bool addChild(const std::shared_ptr<Node>& parentNode, const std::shared_ptr<Node>& child) const;
 
+	/**
+	 * @return True, if the node has animated translation, rotation or scaling values.
+	 */
+	bool hasTransformAnimationValues(const NodeSP& node) const;
+
+	/**
+	 * @return True, if the node has animated color, shininess or transparency values.
+	 */
+	bool hasMaterialAnimationValues(const NodeSP& node) const;
+
+	bool isStaticSubtree(const NodeSP& node, bool transparent) const;
+
+	void collectStaticMeshes(const NodeSP& node, const Matrix4x4& parentMatrix, std::vector<std::pair<MeshSP, Matrix4x4> >& allParts) const;
+
+	std::int32_t releaseSubtree(const NodeSP& node) const;
+
+	std::int32_t mergeStaticNodes(const NodeSP& node, std::uint32_t numberLods, float lodReduction) const;
+
+	std::int32_t packVertices(const NodeSP& node) const;
+
 public:
 	NodeTreeFactory();
 	virtual ~NodeTreeFactory();
@@ -49,6 +69,23 @@ public:
 
 	bool setJoint(const std::string& jointName) const;
 
+	/**
+	 * Flattens child trees, which are neither animated nor skinned and contain no cameras, lights or joints, into the mesh of
+	 * their parent node. The meshes are transformed into the space of the parent node. Merged nodes can not be found by name
+	 * anymore, so this has to be done before the model is created.
+	 *
+	 * @return Number of removed nodes.
+	 */
+	std::int32_t mergeStaticNodes(std::uint32_t numberLods = 1, float lodReduction = 0.5f);
+
+	/**
+	 * Packs the vertices of all meshes in the tree. Packed meshes can not be merged anymore, so this has to be done after
+	 * the merging and after the skinning data has been added.
+	 *
+	 * @return Number of packed meshes.
+	 */
+	std::int32_t packVertices() const;
+
 };
 
 #endif /* NODETREEFACTORY_H_ */
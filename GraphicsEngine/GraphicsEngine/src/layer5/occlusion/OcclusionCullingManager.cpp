@@ -0,0 +1,168 @@
+/*
+ * OcclusionCullingManager.cpp
+ *
+ *  Created on: 19.10.2026
+ *      Author: nopper
+ */
+
+#include "../../layer1/collision/AxisAlignedBoundingBox.h"
+#include "../../layer1/command/WorkerManager.h"
+#include "../../layer4/entity/Entity.h"
+
+#include "OcclusionCullingManager.h"
+
+using namespace std;
+
+OcclusionCullingManager::OcclusionCullingManager() :
+	Singleton<OcclusionCullingManager>(), enabled(false), depthBuffer(new HierarchicalDepthBuffer(256, 128)), allOccluders(), screenVertices(), occluderScreenVertices(), indices(), camera(nullptr), viewProjectionMatrix()
+{
+	rasterizeTaskCounter = ThreadSafeCounterSP(new ThreadSafeCounter());
+
+	rasterizeCommandRecycleQueue = RasterizeCommandRecycleQueueSP(new ThreadsafeQueue<RasterizeCommand*>());
+}
+
+OcclusionCullingManager::~OcclusionCullingManager()
+{
+	RasterizeCommand* currentRasterizeCommand = nullptr;
+	bool available = rasterizeCommandRecycleQueue->take(currentRasterizeCommand);
+	while (available)
+	{
+		delete currentRasterizeCommand;
+
+		available = rasterizeCommandRecycleQueue->take(currentRasterizeCommand);
+	}
+	rasterizeCommandRecycleQueue.reset();
+
+	rasterizeTaskCounter.reset();
+
+	allOccluders.clear();
+}
+
+bool OcclusionCullingManager::isEnabled() const
+{
+	return enabled;
+}
+
+void OcclusionCullingManager::setEnabled(bool enabled)
+{
+	this->enabled = enabled;
+
+	camera = nullptr;
+}
+
+void OcclusionCullingManager::setResolution(int32_t width, int32_t height)
+{
+	depthBuffer = HierarchicalDepthBufferSP(new HierarchicalDepthBuffer(width, height));
+
+	camera = nullptr;
+}
+
+const HierarchicalDepthBufferSP& OcclusionCullingManager::getDepthBuffer() const
+{
+	return depthBuffer;
+}
+
+void OcclusionCullingManager::addOccluder(const OccluderSP& occluder)
+{
+	if (occluder.get() && find(allOccluders.begin(), allOccluders.end(), occluder) == allOccluders.end())
+	{
+		allOccluders.push_back(occluder);
+	}
+}
+
+void OcclusionCullingManager::removeOccluder(const OccluderSP& occluder)
+{
+	auto walker = find(allOccluders.begin(), allOccluders.end(), occluder);
+	if (walker != allOccluders.end())
+	{
+		allOccluders.erase(walker);
+	}
+}
+
+void OcclusionCullingManager::removeAllOccluders()
+{
+	allOccluders.clear();
+}
+
+void OcclusionCullingManager::rasterizeOccluders(const CameraSP& camera)
+{
+	if (!enabled || !camera.get())
+	{
+		return;
+	}
+
+	this->camera = camera.get();
+
+	viewProjectionMatrix = camera->getProjectionMatrix() * camera->getViewMatrix();
+
+	// Gather all occluders in screen space, so the bands only have to rasterize.
+	screenVertices.clear();
+	indices.clear();
+
+	auto walker = allOccluders.begin();
+	while (walker != allOccluders.end())
+	{
+		uint32_t indexOffset = static_cast<uint32_t>(screenVertices.size() / 4);
+
+		depthBuffer->transformVertices(viewProjectionMatrix * (*walker)->getModelMatrix(), (*walker)->getVertices(), (*walker)->getNumberVertices(), occluderScreenVertices);
+
+		screenVertices.insert(screenVertices.end(), occluderScreenVertices.begin(), occluderScreenVertices.end());
+
+		auto walkerIndices = (*walker)->getIndices().begin();
+		while (walkerIndices != (*walker)->getIndices().end())
+		{
+			indices.push_back(*walkerIndices + indexOffset);
+
+			walkerIndices++;
+		}
+
+		walker++;
+	}
+
+	uint32_t numberWorkers = WorkerManager::getInstance()->getNumberWorkers();
+
+	if (numberWorkers == 0)
+	{
+		depthBuffer->clear(0, depthBuffer->getHeight());
+		depthBuffer->rasterizeTriangles(screenVertices, indices, 0, depthBuffer->getHeight());
+		depthBuffer->updateTiles(0, depthBuffer->getHeight());
+
+		return;
+	}
+
+	// Bands have to start at a tile border, as each band updates its own tiles.
+	int32_t numberTileRows = depthBuffer->getHeight() / HierarchicalDepthBuffer::TILE_SIZE;
+	int32_t numberBands = static_cast<int32_t>(numberWorkers) * 2;
+	numberBands = numberBands > numberTileRows ? numberTileRows : numberBands;
+
+	int32_t bandHeight = ((numberTileRows + numberBands - 1) / numberBands) * HierarchicalDepthBuffer::TILE_SIZE;
+
+	for (int32_t rowStart = 0; rowStart < depthBuffer->getHeight(); rowStart += bandHeight)
+	{
+		RasterizeCommand* currentRasterizeCommand = nullptr;
+		bool available = rasterizeCommandRecycleQueue->take(currentRasterizeCommand);
+
+		if (!available)
+		{
+			currentRasterizeCommand = new RasterizeCommand(rasterizeCommandRecycleQueue, rasterizeTaskCounter);
+		}
+
+		currentRasterizeCommand->init(depthBuffer.get(), &screenVertices, &indices, rowStart, rowStart + bandHeight);
+
+		WorkerManager::getInstance()->sendCommand(currentRasterizeCommand);
+	}
+
+	rasterizeTaskCounter->waitUntilZero();
+}
+
+bool OcclusionCullingManager::isVisible(const BoundingSphere& boundingSphere) const
+{
+	if (!enabled || !camera || Entity::getCurrentCamera().get() != camera || Entity::getDynamicCubeMaps())
+	{
+		return true;
+	}
+
+	AxisAlignedBoundingBox axisAlignedBoundingBox(boundingSphere.getCenter(), boundingSphere.getRadius(), boundingSphere.getRadius(), boundingSphere.getRadius());
+
+	return depthBuffer->isVisible(axisAlignedBoundingBox, viewProjectionMatrix);
+}
@@ -0,0 +1,86 @@
+/*
+ * OcclusionCullingManager.h
+ *
+ *  Created on: 19.10.2026
+ *      Author: nopper
+ */
+
+#ifndef OCCLUSIONCULLINGMANAGER_H_
+#define OCCLUSIONCULLINGMANAGER_H_
+
+#include "../../UsedLibs.h"
+
+#include "../../layer0/concurrency/ThreadSafeCounter.h"
+#include "../../layer0/math/Matrix4x4.h"
+#include "../../layer0/stereotype/Singleton.h"
+#include "../../layer1/collision/BoundingSphere.h"
+#include "../../layer3/camera/Camera.h"
+#include "../../layer3/occlusion/HierarchicalDepthBuffer.h"
+#include "../../layer3/occlusion/Occluder.h"
+
+#include "RasterizeCommand.h"
+
+/**
+ * Software occlusion culling. Once per frame, the occluders are rasterized for the main camera into a small hierarchical depth buffer,
+ * using the worker threads if available. Afterwards, entities rendered with the same camera are tested against this buffer.
+ * Rendering with any other camera e.g. for shadows is not affected.
+ */
+class OcclusionCullingManager : public Singleton<OcclusionCullingManager>
+{
+
+	friend class Singleton<OcclusionCullingManager>;
+
+private:
+
+	bool enabled;
+
+	HierarchicalDepthBufferSP depthBuffer;
+
+	std::vector<OccluderSP> allOccluders;
+
+	std::vector<float> screenVertices;
+
+	std::vector<float> occluderScreenVertices;
+
+	std::vector<std::uint32_t> indices;
+
+	const Camera* camera;
+
+	Matrix4x4 viewProjectionMatrix;
+
+	RasterizeCommandRecycleQueueSP rasterizeCommandRecycleQueue;
+
+	ThreadSafeCounterSP rasterizeTaskCounter;
+
+	OcclusionCullingManager();
+	virtual ~OcclusionCullingManager();
+
+public:
+
+	bool isEnabled() const;
+
+	void setEnabled(bool enabled);
+
+	void setResolution(std::int32_t width, std::int32_t height);
+
+	const HierarchicalDepthBufferSP& getDepthBuffer() const;
+
+	void addOccluder(const OccluderSP& occluder);
+
+	void removeOccluder(const OccluderSP& occluder);
+
+	void removeAllOccluders();
+
+	/**
+	 * Has to be called after the camera has been updated and before the entities are rendered.
+	 */
+	void rasterizeOccluders(const CameraSP& camera);
+
+	/**
+	 * @return False, if the bounding sphere is hidden by the occluders for the current camera.
+	 */
+	bool isVisible(const BoundingSphere& boundingSphere) const;
+
+};
+
+#endif /* OCCLUSIONCULLINGMANAGER_H_ */
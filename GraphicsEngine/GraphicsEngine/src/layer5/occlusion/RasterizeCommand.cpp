@@ -0,0 +1,55 @@
+/*
+ * RasterizeCommand.cpp
+ *
+ *  Created on: 19.10.2026
+ *      Author: nopper
+ */
+
+#include "RasterizeCommand.h"
+
+using namespace std;
+
+RasterizeCommand::RasterizeCommand(const RasterizeCommandRecycleQueueSP& rasterizeCommandRecycleQueue, const ThreadSafeCounterSP& taskCounter) :
+	Command(), rasterizeCommandRecycleQueue(rasterizeCommandRecycleQueue), taskCounter(taskCounter), depthBuffer(nullptr), screenVertices(nullptr), indices(nullptr), rowStart(0), rowEnd(0)
+{
+}
+
+RasterizeCommand::~RasterizeCommand()
+{
+}
+
+bool RasterizeCommand::execute()
+{
+	assert(this->taskCounter.get() != nullptr);
+	assert(this->depthBuffer != nullptr);
+
+	depthBuffer->clear(rowStart, rowEnd);
+	depthBuffer->rasterizeTriangles(*screenVertices, *indices, rowStart, rowEnd);
+	depthBuffer->updateTiles(rowStart, rowEnd);
+
+	taskCounter->decrement();
+
+	return true;
+}
+
+void RasterizeCommand::recycle()
+{
+	depthBuffer = nullptr;
+	screenVertices = nullptr;
+	indices = nullptr;
+	rasterizeCommandRecycleQueue->add(this);
+}
+
+void RasterizeCommand::init(HierarchicalDepthBuffer* depthBuffer, const vector<float>* screenVertices, const vector<uint32_t>* indices, int32_t rowStart, int32_t rowEnd)
+{
+	assert(this->taskCounter.get() != nullptr);
+	assert(this->depthBuffer == nullptr);
+
+	taskCounter->increment();
+
+	this->depthBuffer = depthBuffer;
+	this->screenVertices = screenVertices;
+	this->indices = indices;
+	this->rowStart = rowStart;
+	this->rowEnd = rowEnd;
+}
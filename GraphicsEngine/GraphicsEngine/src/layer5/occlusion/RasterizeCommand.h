@@ -0,0 +1,54 @@
+/*
+ * RasterizeCommand.h
+ *
+ *  Created on: 19.10.2026
+ *      Author: nopper
+ */
+
+#ifndef RASTERIZECOMMAND_H_
+#define RASTERIZECOMMAND_H_
+
+#include "../../layer0/concurrency/ThreadSafeCounter.h"
+#include "../../layer1/command/Command.h"
+#include "../../layer3/occlusion/HierarchicalDepthBuffer.h"
+
+/**
+ * Clears, rasterizes and updates the tiles of one band of rows of the hierarchical depth buffer.
+ */
+class RasterizeCommand: public Command
+{
+
+	friend class OcclusionCullingManager;
+
+private:
+
+	std::shared_ptr<ThreadsafeQueue<RasterizeCommand*> > rasterizeCommandRecycleQueue;
+
+	ThreadSafeCounterSP taskCounter;
+
+	HierarchicalDepthBuffer* depthBuffer;
+
+	const std::vector<float>* screenVertices;
+
+	const std::vector<std::uint32_t>* indices;
+
+	std::int32_t rowStart;
+	std::int32_t rowEnd;
+
+	RasterizeCommand(const std::shared_ptr<ThreadsafeQueue<RasterizeCommand*> >& rasterizeCommandRecycleQueue, const ThreadSafeCounterSP& taskCounter);
+
+	virtual ~RasterizeCommand();
+
+public:
+
+	virtual bool execute();
+
+	virtual void recycle();
+
+	void init(HierarchicalDepthBuffer* depthBuffer, const std::vector<float>* screenVertices, const std::vector<std::uint32_t>* indices, std::int32_t rowStart, std::int32_t rowEnd);
+
+};
+
+typedef std::shared_ptr<ThreadsafeQueue<RasterizeCommand*> > RasterizeCommandRecycleQueueSP;
+
+#endif /* RASTERIZECOMMAND_H_ */
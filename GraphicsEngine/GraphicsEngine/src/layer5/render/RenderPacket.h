@@ -0,0 +1,116 @@
+/*
+ * RenderPacket.h
+ *
+ *  Created on: 19.10.2026
+ *      Author: nopper
+ */
+
+#ifndef RENDERPACKET_H_
+#define RENDERPACKET_H_
+
+#include "../../UsedLibs.h"
+
+class InstanceNode;
+class Node;
+class NodeOwner;
+
+/**
+ * One deferred draw of a sub mesh. Everything needed to issue the draw later is captured, the nodes are owned by the model.
+ */
+class RenderPacket
+{
+
+private:
+
+	const NodeOwner* nodeOwner;
+
+	const Node* node;
+
+	const InstanceNode* instanceNode;
+
+	std::uint32_t subMeshIndex;
+
+	std::uint32_t lod;
+
+	float time;
+
+	std::int32_t animStackIndex;
+
+	std::int32_t animLayerIndex;
+
+	bool transparent;
+
+	std::uint64_t instanceGroup;
+
+public:
+
+	RenderPacket(const NodeOwner* nodeOwner, const Node* node, const InstanceNode* instanceNode, std::uint32_t subMeshIndex, std::uint32_t lod, float time, std::int32_t animStackIndex, std::int32_t animLayerIndex, bool transparent, std::uint64_t instanceGroup) :
+		nodeOwner(nodeOwner), node(node), instanceNode(instanceNode), subMeshIndex(subMeshIndex), lod(lod), time(time), animStackIndex(animStackIndex), animLayerIndex(animLayerIndex), transparent(transparent), instanceGroup(instanceGroup)
+	{
+	}
+
+	~RenderPacket()
+	{
+	}
+
+	const NodeOwner& getNodeOwner() const
+	{
+		return *nodeOwner;
+	}
+
+	const Node& getNode() const
+	{
+		return *node;
+	}
+
+	const InstanceNode& getInstanceNode() const
+	{
+		return *instanceNode;
+	}
+
+	std::uint32_t getSubMeshIndex() const
+	{
+		return subMeshIndex;
+	}
+
+	std::uint32_t getLod() const
+	{
+		return lod;
+	}
+
+	float getTime() const
+	{
+		return time;
+	}
+
+	std::int32_t getAnimStackIndex() const
+	{
+		return animStackIndex;
+	}
+
+	std::int32_t getAnimLayerIndex() const
+	{
+		return animLayerIndex;
+	}
+
+	bool isTransparent() const
+	{
+		return transparent;
+	}
+
+	/**
+	 * Packets of the same node, sub mesh and level of detail with the same non zero group can be drawn instanced.
+	 */
+	std::uint64_t getInstanceGroup() const
+	{
+		return instanceGroup;
+	}
+
+	bool isInstanceCompatible(const RenderPacket& other) const
+	{
+		return instanceGroup != 0 && instanceGroup == other.instanceGroup && node == other.node && subMeshIndex == other.subMeshIndex && lod == other.lod && !transparent && !other.transparent;
+	}
+
+};
+
+#endif /* RENDERPACKET_H_ */
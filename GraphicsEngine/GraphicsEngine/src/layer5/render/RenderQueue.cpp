@@ -0,0 +1,167 @@
+/*
+ * RenderQueue.cpp
+ *
+ *  Created on: 19.10.2026
+ *      Author: nopper
+ */
+
+#include "../../layer1/shader/RenderStateCache.h"
+#include "../node/InstanceNode.h"
+#include "../node/NodeOwner.h"
+
+#include "RenderQueue.h"
+
+using namespace std;
+
+RenderQueue::RenderQueue() :
+	Singleton<RenderQueue>(), enabled(false), recording(false), instancing(true), minimumInstances(2), allPackets(), allKeys(), allIndices(), radixSort(), instanceBuffer(), lastNumberPackets(0)
+{
+}
+
+RenderQueue::~RenderQueue()
+{
+}
+
+uint64_t RenderQueue::fold(uint32_t value, uint32_t bits)
+{
+	uint32_t mask = (1u << bits) - 1;
+
+	uint32_t result = 0;
+	while (value)
+	{
+		result ^= value & mask;
+		value >>= bits;
+	}
+
+	return static_cast<uint64_t>(result);
+}
+
+uint64_t RenderQueue::createKey(bool transparent, GLuint program, GLuint texture, GLuint vertexArray, uint32_t lod, float depth)
+{
+	uint64_t state = (fold(program, 12) << 27) | (fold(texture, 16) << 11) | fold(vertexArray, 11);
+
+	if (transparent)
+	{
+		uint64_t quantizedDepth = static_cast<uint64_t>(glusMathClampf(depth, 0.0f, 1.0f) * static_cast<float>((1 << 24) - 1));
+
+		return (1ull << 63) | ((((1ull << 24) - 1) - quantizedDepth) << 39) | state;
+	}
+
+	uint64_t quantizedDepth = static_cast<uint64_t>(glusMathClampf(depth, 0.0f, 1.0f) * static_cast<float>((1 << 20) - 1));
+
+	return (state << 24) | (static_cast<uint64_t>(lod < 15 ? lod : 15) << 20) | quantizedDepth;
+}
+
+bool RenderQueue::isEnabled() const
+{
+	return enabled;
+}
+
+void RenderQueue::setEnabled(bool enabled)
+{
+	this->enabled = enabled;
+}
+
+bool RenderQueue::isRecording() const
+{
+	return recording;
+}
+
+bool RenderQueue::isInstancing() const
+{
+	return instancing;
+}
+
+void RenderQueue::setInstancing(bool instancing)
+{
+	this->instancing = instancing;
+}
+
+uint32_t RenderQueue::getMinimumInstances() const
+{
+	return minimumInstances;
+}
+
+void RenderQueue::setMinimumInstances(uint32_t minimumInstances)
+{
+	this->minimumInstances = minimumInstances > 2 ? minimumInstances : 2;
+}
+
+void RenderQueue::begin()
+{
+	allPackets.clear();
+	allKeys.clear();
+	allIndices.clear();
+
+	recording = true;
+}
+
+void RenderQueue::addPacket(uint64_t key, const RenderPacket& renderPacket)
+{
+	allIndices.push_back(static_cast<uint32_t>(allPackets.size()));
+	allKeys.push_back(key);
+	allPackets.push_back(renderPacket);
+}
+
+void RenderQueue::flush()
+{
+	recording = false;
+
+	lastNumberPackets = static_cast<uint32_t>(allPackets.size());
+
+	if (allPackets.size() == 0)
+	{
+		return;
+	}
+
+	radixSort.sort(allKeys, allIndices);
+
+	RenderStateCache::getInstance()->beginBatch();
+
+	uint32_t current = 0;
+	while (current < allIndices.size())
+	{
+		const RenderPacket& renderPacket = allPackets[allIndices[current]];
+
+		// Find the run of packets, which can share one draw call.
+		uint32_t next = current + 1;
+		if (instancing)
+		{
+			while (next < allIndices.size() && renderPacket.isInstanceCompatible(allPackets[allIndices[next]]))
+			{
+				next++;
+			}
+		}
+
+		if (next - current >= minimumInstances)
+		{
+			instanceBuffer.clear();
+			for (uint32_t i = current; i < next; i++)
+			{
+				instanceBuffer.addMatrix(allPackets[allIndices[i]].getInstanceNode().getModelMatrix());
+			}
+
+			renderPacket.getNodeOwner().renderPacketInstanced(renderPacket, instanceBuffer);
+		}
+		else
+		{
+			for (uint32_t i = current; i < next; i++)
+			{
+				allPackets[allIndices[i]].getNodeOwner().renderPacket(allPackets[allIndices[i]]);
+			}
+		}
+
+		current = next;
+	}
+
+	RenderStateCache::getInstance()->endBatch();
+
+	allPackets.clear();
+	allKeys.clear();
+	allIndices.clear();
+}
+
+uint32_t RenderQueue::getLastNumberPackets() const
+{
+	return lastNumberPackets;
+}
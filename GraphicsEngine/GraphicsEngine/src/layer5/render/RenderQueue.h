@@ -0,0 +1,100 @@
+/*
+ * RenderQueue.h
+ *
+ *  Created on: 19.10.2026
+ *      Author: nopper
+ */
+
+#ifndef RENDERQUEUE_H_
+#define RENDERQUEUE_H_
+
+#include "../../UsedLibs.h"
+
+#include "../../layer0/algorithm/RadixSort.h"
+#include "../../layer0/stereotype/Singleton.h"
+#include "../../layer1/shader/InstanceBuffer.h"
+
+#include "RenderPacket.h"
+
+/**
+ * Collects the sub mesh draws of all visible entities and issues them sorted by a 64 bit key to minimize state changes.
+ *
+ * Opaque:      1 bit pass | 12 bit program | 16 bit texture | 11 bit vertex array | 4 bit lod | 20 bit depth front to back
+ * Transparent: 1 bit pass | 24 bit depth back to front | 12 bit program | 16 bit texture | 11 bit vertex array
+ *
+ * Names wider than their field are folded, which only affects the order, not the result.
+ * Consecutive opaque packets of the same sub mesh are drawn with one instanced draw call.
+ */
+class RenderQueue : public Singleton<RenderQueue>
+{
+
+	friend class Singleton<RenderQueue>;
+
+private:
+
+	bool enabled;
+
+	bool recording;
+
+	bool instancing;
+
+	std::uint32_t minimumInstances;
+
+	std::vector<RenderPacket> allPackets;
+
+	std::vector<std::uint64_t> allKeys;
+
+	std::vector<std::uint32_t> allIndices;
+
+	RadixSort radixSort;
+
+	InstanceBuffer instanceBuffer;
+
+	std::uint32_t lastNumberPackets;
+
+	RenderQueue();
+	virtual ~RenderQueue();
+
+	static std::uint64_t fold(std::uint32_t value, std::uint32_t bits);
+
+public:
+
+	/**
+	 * @param depth Normalized distance to the camera in the range [0.0, 1.0].
+	 */
+	static std::uint64_t createKey(bool transparent, GLuint program, GLuint texture, GLuint vertexArray, std::uint32_t lod, float depth);
+
+	bool isEnabled() const;
+
+	void setEnabled(bool enabled);
+
+	bool isRecording() const;
+
+	bool isInstancing() const;
+
+	void setInstancing(bool instancing);
+
+	std::uint32_t getMinimumInstances() const;
+
+	/**
+	 * Runs of compatible packets shorter than this are drawn one by one.
+	 */
+	void setMinimumInstances(std::uint32_t minimumInstances);
+
+	/**
+	 * Starts collecting packets. Nested calls are ignored by the caller checking isRecording().
+	 */
+	void begin();
+
+	void addPacket(std::uint64_t key, const RenderPacket& renderPacket);
+
+	/**
+	 * Sorts and renders all collected packets and stops recording.
+	 */
+	void flush();
+
+	std::uint32_t getLastNumberPackets() const;
+
+};
+
+#endif /* RENDERQUEUE_H_ */
@@ -0,0 +1,733 @@
+/*
+ * BoundingVolumeHierarchy.cpp
+ *
+ *  Created on: 19.10.2026
+ *      Author: nopper
+ */
+
+#include "../../layer0/color/Color.h"
+#include "../../layer1/command/WorkerManager.h"
+#include "../../layer2/debug/DebugDraw.h"
+#include "../../layer3/camera/Camera.h"
+#include "../../layer5/command/EntityCommandManager.h"
+#include "../../layer5/occlusion/OcclusionCullingManager.h"
+
+#include "BoundingVolumeHierarchy.h"
+
+using namespace std;
+
+BoundingVolumeHierarchy::BoundingVolumeHierarchy(float fatMargin) :
+	SpatialIndex(), pool(0), root(0), allLeafs(), fatMargin(fatMargin), debug(false), entityExcludeList()
+{
+}
+
+BoundingVolumeHierarchy::~BoundingVolumeHierarchy()
+{
+	removeAllEntities();
+
+	BvhNode* walker = pool;
+	while (walker)
+	{
+		pool = pool->parent;
+
+		delete walker;
+
+		walker = pool;
+	}
+}
+
+BvhNode* BoundingVolumeHierarchy::createNode(BvhNode* parent)
+{
+	BvhNode* node = pool;
+
+	if (node)
+	{
+		pool = node->parent;
+	}
+	else
+	{
+		node = new BvhNode();
+	}
+
+	node->init(parent);
+
+	return node;
+}
+
+void BoundingVolumeHierarchy::recycleNode(BvhNode* node)
+{
+	if (node)
+	{
+		node->octreeEntity.reset();
+		node->left = 0;
+		node->right = 0;
+
+		node->parent = pool;
+
+		pool = node;
+	}
+}
+
+void BoundingVolumeHierarchy::recycleInnerNodes(BvhNode* node)
+{
+	if (!node || node->isLeaf())
+	{
+		return;
+	}
+
+	recycleInnerNodes(node->left);
+	recycleInnerNodes(node->right);
+
+	recycleNode(node);
+}
+
+void BoundingVolumeHierarchy::setLeafBox(BvhNode* leaf, const BoundingSphere& boundingSphere) const
+{
+	float halfExtend = boundingSphere.getRadius() + fatMargin;
+
+	leaf->setBox(boundingSphere.getCenter(), halfExtend, halfExtend, halfExtend);
+
+	leaf->height = 0;
+}
+
+void BoundingVolumeHierarchy::insertLeaf(BvhNode* leaf)
+{
+	if (!root)
+	{
+		root = leaf;
+		root->parent = 0;
+
+		return;
+	}
+
+	AxisAlignedBoundingBox combined;
+
+	// Descend along the cheapest path regarding the surface area heuristic.
+	BvhNode* sibling = root;
+	while (!sibling->isLeaf())
+	{
+		float area = sibling->getSurfaceArea();
+
+		combined.merge(*sibling, *leaf);
+		float combinedArea = combined.getSurfaceArea();
+
+		// Cost of creating a new parent for this node and the new leaf.
+		float cost = 2.0f * combinedArea;
+
+		// Minimum cost of pushing the leaf further down the tree.
+		float inheritanceCost = 2.0f * (combinedArea - area);
+
+		combined.merge(*sibling->left, *leaf);
+		float costLeft = combined.getSurfaceArea() + inheritanceCost;
+		if (!sibling->left->isLeaf())
+		{
+			costLeft -= sibling->left->getSurfaceArea();
+		}
+
+		combined.merge(*sibling->right, *leaf);
+		float costRight = combined.getSurfaceArea() + inheritanceCost;
+		if (!sibling->right->isLeaf())
+		{
+			costRight -= sibling->right->getSurfaceArea();
+		}
+
+		if (cost < costLeft && cost < costRight)
+		{
+			break;
+		}
+
+		sibling = costLeft < costRight ? sibling->left : sibling->right;
+	}
+
+	BvhNode* oldParent = sibling->parent;
+
+	BvhNode* newParent = createNode(oldParent);
+	newParent->left = sibling;
+	newParent->right = leaf;
+
+	if (oldParent)
+	{
+		oldParent->replaceChild(sibling, newParent);
+	}
+	else
+	{
+		root = newParent;
+	}
+
+	sibling->parent = newParent;
+	leaf->parent = newParent;
+
+	refit(newParent);
+}
+
+void BoundingVolumeHierarchy::removeLeaf(BvhNode* leaf)
+{
+	if (leaf == root)
+	{
+		root = 0;
+
+		return;
+	}
+
+	BvhNode* parent = leaf->parent;
+	BvhNode* grandParent = parent->parent;
+	BvhNode* sibling = parent->getSibling(leaf);
+
+	if (grandParent)
+	{
+		grandParent->replaceChild(parent, sibling);
+
+		recycleNode(parent);
+
+		refit(grandParent);
+	}
+	else
+	{
+		root = sibling;
+		root->parent = 0;
+
+		recycleNode(parent);
+	}
+
+	leaf->parent = 0;
+}
+
+void BoundingVolumeHierarchy::refit(BvhNode* node)
+{
+	while (node)
+	{
+		rotate(node);
+
+		node->refit();
+
+		node = node->parent;
+	}
+}
+
+void BoundingVolumeHierarchy::rotate(BvhNode* node)
+{
+	BvhNode* children[2] = {node->left, node->right};
+
+	AxisAlignedBoundingBox combined;
+
+	float bestBenefit = 0.0f;
+	BvhNode* bestChild = 0;
+	BvhNode* bestGrandChild = 0;
+
+	// Try to swap a child with one of the grandchildren of the other side, if this shrinks the other side.
+	for (int32_t i = 0; i < 2; i++)
+	{
+		BvhNode* child = children[i];
+		BvhNode* other = children[1 - i];
+
+		if (other->isLeaf())
+		{
+			continue;
+		}
+
+		float otherArea = other->getSurfaceArea();
+
+		combined.merge(*child, *other->right);
+		float benefit = otherArea - combined.getSurfaceArea();
+		if (benefit > bestBenefit)
+		{
+			bestBenefit = benefit;
+			bestChild = child;
+			bestGrandChild = other->left;
+		}
+
+		combined.merge(*child, *other->left);
+		benefit = otherArea - combined.getSurfaceArea();
+		if (benefit > bestBenefit)
+		{
+			bestBenefit = benefit;
+			bestChild = child;
+			bestGrandChild = other->right;
+		}
+	}
+
+	if (!bestChild)
+	{
+		return;
+	}
+
+	BvhNode* other = bestGrandChild->parent;
+
+	node->replaceChild(bestChild, bestGrandChild);
+	other->replaceChild(bestGrandChild, bestChild);
+
+	other->refit();
+}
+
+BvhNode* BoundingVolumeHierarchy::build(vector<BvhNode*>& leafs, int32_t start, int32_t end)
+{
+	int32_t count = end - start;
+
+	if (count == 1)
+	{
+		return leafs[start];
+	}
+
+	// Bounds of the centroids.
+	float minimum[3] = {leafs[start]->getCenter().getX(), leafs[start]->getCenter().getY(), leafs[start]->getCenter().getZ()};
+	float maximum[3] = {minimum[0], minimum[1], minimum[2]};
+
+	for (int32_t i = start + 1; i < end; i++)
+	{
+		for (int32_t k = 0; k < 3; k++)
+		{
+			minimum[k] = glusMathMinf(minimum[k], leafs[i]->getCenter().getP()[k]);
+			maximum[k] = glusMathMaxf(maximum[k], leafs[i]->getCenter().getP()[k]);
+		}
+	}
+
+	int32_t axis = 0;
+	for (int32_t k = 1; k < 3; k++)
+	{
+		if (maximum[k] - minimum[k] > maximum[axis] - minimum[axis])
+		{
+			axis = k;
+		}
+	}
+
+	float extent = maximum[axis] - minimum[axis];
+	float axisMinimum = minimum[axis];
+
+	int32_t middle = start + count / 2;
+
+	if (extent > 1.0e-6f)
+	{
+		auto binIndex = [axis, axisMinimum, extent](const BvhNode* leaf)
+		{
+			int32_t index = static_cast<int32_t>(static_cast<float>(NUMBER_BINS) * (leaf->getCenter().getP()[axis] - axisMinimum) / extent);
+
+			return index < NUMBER_BINS ? index : NUMBER_BINS - 1;
+		};
+
+		int32_t binCount[NUMBER_BINS] = {0};
+		AxisAlignedBoundingBox binBox[NUMBER_BINS];
+
+		for (int32_t i = start; i < end; i++)
+		{
+			int32_t index = binIndex(leafs[i]);
+
+			if (binCount[index] == 0)
+			{
+				binBox[index] = *leafs[i];
+			}
+			else
+			{
+				binBox[index].merge(binBox[index], *leafs[i]);
+			}
+
+			binCount[index]++;
+		}
+
+		// Sweep from the left and gather the area and count for each split plane.
+		float leftArea[NUMBER_BINS - 1];
+		int32_t leftCount[NUMBER_BINS - 1];
+
+		AxisAlignedBoundingBox accumulated;
+		int32_t accumulatedCount = 0;
+
+		for (int32_t i = 0; i < NUMBER_BINS - 1; i++)
+		{
+			if (binCount[i] > 0)
+			{
+				if (accumulatedCount == 0)
+				{
+					accumulated = binBox[i];
+				}
+				else
+				{
+					accumulated.merge(accumulated, binBox[i]);
+				}
+				accumulatedCount += binCount[i];
+			}
+
+			leftArea[i] = accumulatedCount > 0 ? accumulated.getSurfaceArea() : 0.0f;
+			leftCount[i] = accumulatedCount;
+		}
+
+		// Sweep from the right and evaluate the cost of each split plane.
+		float bestCost = 0.0f;
+		int32_t bestSplit = -1;
+
+		accumulatedCount = 0;
+
+		for (int32_t i = NUMBER_BINS - 1; i > 0; i--)
+		{
+			if (binCount[i] > 0)
+			{
+				if (accumulatedCount == 0)
+				{
+					accumulated = binBox[i];
+				}
+				else
+				{
+					accumulated.merge(accumulated, binBox[i]);
+				}
+				accumulatedCount += binCount[i];
+			}
+
+			if (leftCount[i - 1] == 0 || accumulatedCount == 0)
+			{
+				continue;
+			}
+
+			float cost = static_cast<float>(leftCount[i - 1]) * leftArea[i - 1] + static_cast<float>(accumulatedCount) * accumulated.getSurfaceArea();
+
+			if (bestSplit < 0 || cost < bestCost)
+			{
+				bestCost = cost;
+				bestSplit = i - 1;
+			}
+		}
+
+		if (bestSplit >= 0)
+		{
+			auto walker = partition(leafs.begin() + start, leafs.begin() + end, [&binIndex, bestSplit](const BvhNode* leaf) {return binIndex(leaf) <= bestSplit;});
+
+			middle = static_cast<int32_t>(walker - leafs.begin());
+
+			if (middle == start || middle == end)
+			{
+				middle = start + count / 2;
+			}
+		}
+	}
+
+	BvhNode* node = createNode(0);
+
+	node->left = build(leafs, start, middle);
+	node->right = build(leafs, middle, end);
+
+	node->left->parent = node;
+	node->right->parent = node;
+
+	node->refit();
+
+	return node;
+}
+
+void BoundingVolumeHierarchy::sortNode(BvhNode* node)
+{
+	if (!OctreeEntity::getCurrentCamera()->getViewFrustum().isVisible(static_cast<const AxisAlignedBoundingBox&>(*node)))
+	{
+		return;
+	}
+
+	node->updateDistanceToCamera();
+
+	if (node->isLeaf())
+	{
+		node->octreeEntity->updateDistanceToCamera();
+
+		return;
+	}
+
+	sortNode(node->left);
+	sortNode(node->right);
+}
+
+void BoundingVolumeHierarchy::renderNode(const BvhNode* node, bool force) const
+{
+	if (!force && !OctreeEntity::getCurrentCamera()->getViewFrustum().isVisible(static_cast<const AxisAlignedBoundingBox&>(*node)))
+	{
+		return;
+	}
+
+	if (node->isLeaf())
+	{
+		if ((force || (OctreeEntity::getCurrentCamera()->getViewFrustum().isVisible(node->octreeEntity->getBoundingSphere()) && OcclusionCullingManager::getInstance()->isVisible(node->octreeEntity->getBoundingSphere()))) && !isEntityExcluded(node->octreeEntity))
+		{
+			node->octreeEntity->render();
+		}
+	}
+	else
+	{
+		const BvhNode* first = node->left;
+		const BvhNode* second = node->right;
+
+		// Front to back for ascending, back to front for descending sort order.
+		if ((OctreeEntity::isAscendingSortOrder() && first->distanceToCamera > second->distanceToCamera) || (!OctreeEntity::isAscendingSortOrder() && first->distanceToCamera < second->distanceToCamera))
+		{
+			first = node->right;
+			second = node->left;
+		}
+
+		renderNode(first, force);
+		renderNode(second, force);
+	}
+
+	if (debug)
+	{
+		DebugDraw::drawer.draw(*node, Color::BLUE);
+	}
+}
+
+void BoundingVolumeHierarchy::queryRayNode(const BvhNode* node, const Point4& origin, const Vector3& direction, float maxDistance, vector<OctreeEntitySP>& result) const
+{
+	float distance;
+
+	if (!node->intersect(origin, direction, maxDistance, distance))
+	{
+		return;
+	}
+
+	if (!node->isLeaf())
+	{
+		queryRayNode(node->left, origin, direction, maxDistance, result);
+		queryRayNode(node->right, origin, direction, maxDistance, result);
+
+		return;
+	}
+
+	const BoundingSphere& boundingSphere = node->octreeEntity->getBoundingSphere();
+
+	float toCenter[3];
+	float projection = 0.0f;
+	float squareLength = 0.0f;
+
+	for (int32_t i = 0; i < 3; i++)
+	{
+		toCenter[i] = boundingSphere.getCenter().getP()[i] - origin.getP()[i];
+
+		projection += toCenter[i] * direction.getV()[i];
+		squareLength += toCenter[i] * toCenter[i];
+	}
+
+	float squareRadius = boundingSphere.getRadius() * boundingSphere.getRadius();
+	float squareDistance = squareLength - projection * projection;
+
+	if (squareDistance > squareRadius)
+	{
+		return;
+	}
+
+	float halfChord = sqrtf(squareRadius - squareDistance);
+
+	float hitDistance = projection - halfChord;
+	if (hitDistance < 0.0f)
+	{
+		hitDistance = projection + halfChord;
+	}
+
+	if (hitDistance < 0.0f || hitDistance > maxDistance)
+	{
+		return;
+	}
+
+	result.push_back(node->octreeEntity);
+}
+
+int32_t BoundingVolumeHierarchy::countNodes(const BvhNode* node) const
+{
+	if (!node)
+	{
+		return 0;
+	}
+
+	if (node->isLeaf())
+	{
+		return 1;
+	}
+
+	return 1 + countNodes(node->left) + countNodes(node->right);
+}
+
+float BoundingVolumeHierarchy::sumInnerSurfaceArea(const BvhNode* node) const
+{
+	if (!node || node->isLeaf())
+	{
+		return 0.0f;
+	}
+
+	return node->getSurfaceArea() + sumInnerSurfaceArea(node->left) + sumInnerSurfaceArea(node->right);
+}
+
+bool BoundingVolumeHierarchy::updateEntity(const OctreeEntitySP& octreeEntity)
+{
+	assert(octreeEntity.get() != nullptr);
+
+	BvhNode* leaf = 0;
+
+	auto found = allLeafs.find(octreeEntity.get());
+	if (found != allLeafs.end())
+	{
+		leaf = found->second;
+
+		// Nothing to do, as long as the entity stays inside its fat box.
+		if (leaf->encloses(octreeEntity->getBoundingSphere()))
+		{
+			return true;
+		}
+
+		removeLeaf(leaf);
+	}
+	else
+	{
+		leaf = createNode(0);
+		leaf->octreeEntity = octreeEntity;
+
+		allLeafs[octreeEntity.get()] = leaf;
+	}
+
+	setLeafBox(leaf, octreeEntity->getBoundingSphere());
+
+	insertLeaf(leaf);
+
+	return true;
+}
+
+bool BoundingVolumeHierarchy::isEntityEnclosed(const OctreeEntitySP& octreeEntity) const
+{
+	auto found = allLeafs.find(octreeEntity.get());
+	if (found == allLeafs.end())
+	{
+		return false;
+	}
+
+	return found->second->encloses(octreeEntity->getBoundingSphere());
+}
+
+void BoundingVolumeHierarchy::removeEntity(const OctreeEntitySP& octreeEntity)
+{
+	auto found = allLeafs.find(octreeEntity.get());
+	if (found == allLeafs.end())
+	{
+		return;
+	}
+
+	BvhNode* leaf = found->second;
+
+	allLeafs.erase(found);
+
+	removeLeaf(leaf);
+
+	recycleNode(leaf);
+}
+
+void BoundingVolumeHierarchy::removeAllEntities()
+{
+	recycleInnerNodes(root);
+
+	auto walker = allLeafs.begin();
+	while (walker != allLeafs.end())
+	{
+		recycleNode(walker->second);
+
+		walker++;
+	}
+	allLeafs.clear();
+
+	root = 0;
+}
+
+void BoundingVolumeHierarchy::sort()
+{
+	if (root)
+	{
+		sortNode(root);
+	}
+}
+
+void BoundingVolumeHierarchy::update() const
+{
+	auto walker = allLeafs.begin();
+	while (walker != allLeafs.end())
+	{
+		if (WorkerManager::getInstance()->getNumberWorkers() == 0)
+		{
+			walker->second->octreeEntity->update();
+		}
+		else
+		{
+			EntityCommandManager::getInstance()->publishUpdateCommand(walker->second->octreeEntity.get());
+		}
+
+		walker++;
+	}
+}
+
+void BoundingVolumeHierarchy::render(bool force) const
+{
+	if (root)
+	{
+		renderNode(root, force);
+	}
+}
+
+void BoundingVolumeHierarchy::setDebug(bool debug)
+{
+	this->debug = debug;
+}
+
+void BoundingVolumeHierarchy::setEntityExcludeList(const EntityListSP& entityExcludeList)
+{
+	this->entityExcludeList = entityExcludeList;
+}
+
+bool BoundingVolumeHierarchy::isEntityExcluded(const OctreeEntitySP& octreeEntity) const
+{
+	if (!entityExcludeList.get())
+	{
+		return false;
+	}
+
+	return entityExcludeList->containsEntity(octreeEntity);
+}
+
+void BoundingVolumeHierarchy::rebuild()
+{
+	if (!root)
+	{
+		return;
+	}
+
+	recycleInnerNodes(root);
+
+	vector<BvhNode*> leafs;
+	leafs.reserve(allLeafs.size());
+
+	auto walker = allLeafs.begin();
+	while (walker != allLeafs.end())
+	{
+		leafs.push_back(walker->second);
+
+		walker++;
+	}
+
+	root = build(leafs, 0, static_cast<int32_t>(leafs.size()));
+	root->parent = 0;
+
+	glusLogPrint(GLUS_LOG_DEBUG, "Rebuilt bounding volume hierarchy with %d nodes and height %d", getNumberNodes(), getHeight());
+}
+
+void BoundingVolumeHierarchy::queryRay(const Point4& origin, const Vector3& direction, float maxDistance, vector<OctreeEntitySP>& result) const
+{
+	if (root)
+	{
+		queryRayNode(root, origin, direction, maxDistance, result);
+	}
+}
+
+int32_t BoundingVolumeHierarchy::getNumberNodes() const
+{
+	return countNodes(root);
+}
+
+int32_t BoundingVolumeHierarchy::getHeight() const
+{
+	return root ? root->height : 0;
+}
+
+float BoundingVolumeHierarchy::getSurfaceAreaCost() const
+{
+	if (!root || root->isLeaf())
+	{
+		return 0.0f;
+	}
+
+	return sumInnerSurfaceArea(root) / root->getSurfaceArea();
+}
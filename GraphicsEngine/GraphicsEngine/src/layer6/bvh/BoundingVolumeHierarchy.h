@@ -0,0 +1,126 @@
+/*
+ * BoundingVolumeHierarchy.h
+ *
+ *  Created on: 19.10.2026
+ *      Author: nopper
+ */
+
+#ifndef BOUNDINGVOLUMEHIERARCHY_H_
+#define BOUNDINGVOLUMEHIERARCHY_H_
+
+#include "../../UsedLibs.h"
+
+#include "../../layer0/math/Point4.h"
+#include "../../layer0/math/Vector3.h"
+#include "../../layer4/entity/EntityList.h"
+#include "../spatial/SpatialIndex.h"
+
+#include "BvhNode.h"
+
+/**
+ * Dynamic AABB tree. Entities are inserted incrementally using the surface area heuristic, the tree is kept balanced by rotations
+ * and can be completely rebuilt with a binned SAH build. In contrast to the octree, the scene extent does not have to be known in advance.
+ */
+class BoundingVolumeHierarchy : public SpatialIndex
+{
+
+	friend class BoundingVolumeHierarchyFactory;
+
+	friend struct std::default_delete<BoundingVolumeHierarchy>;
+
+private:
+
+	static const std::int32_t NUMBER_BINS = 12;
+
+	BvhNode* pool;
+
+	BvhNode* root;
+
+	std::map<OctreeEntity*, BvhNode*> allLeafs;
+
+	float fatMargin;
+
+	bool debug;
+
+	EntityListSP entityExcludeList;
+
+	BoundingVolumeHierarchy(float fatMargin);
+
+	virtual ~BoundingVolumeHierarchy();
+
+	BvhNode* createNode(BvhNode* parent);
+
+	void recycleNode(BvhNode* node);
+
+	void recycleInnerNodes(BvhNode* node);
+
+	void setLeafBox(BvhNode* leaf, const BoundingSphere& boundingSphere) const;
+
+	void insertLeaf(BvhNode* leaf);
+
+	void removeLeaf(BvhNode* leaf);
+
+	void refit(BvhNode* node);
+
+	void rotate(BvhNode* node);
+
+	BvhNode* build(std::vector<BvhNode*>& leafs, std::int32_t start, std::int32_t end);
+
+	void sortNode(BvhNode* node);
+
+	void updateNode(const BvhNode* node) const;
+
+	void renderNode(const BvhNode* node, bool force) const;
+
+	void queryRayNode(const BvhNode* node, const Point4& origin, const Vector3& direction, float maxDistance, std::vector<OctreeEntitySP>& result) const;
+
+	std::int32_t countNodes(const BvhNode* node) const;
+
+	float sumInnerSurfaceArea(const BvhNode* node) const;
+
+public:
+
+	virtual bool updateEntity(const OctreeEntitySP& octreeEntity);
+
+	virtual bool isEntityEnclosed(const OctreeEntitySP& octreeEntity) const;
+
+	virtual void removeEntity(const OctreeEntitySP& octreeEntity);
+
+	virtual void removeAllEntities();
+
+	virtual void sort();
+
+	virtual void update() const;
+
+	virtual void render(bool force = false) const;
+
+	virtual void setDebug(bool debug);
+
+	virtual void setEntityExcludeList(const EntityListSP& entityExcludeList);
+
+	virtual bool isEntityExcluded(const OctreeEntitySP& octreeEntity) const;
+
+	/**
+	 * Rebuilds the whole tree top down with a binned SAH build. Useful after loading a mostly static scene.
+	 */
+	void rebuild();
+
+	/**
+	 * Collects all entities, whose bounding sphere is hit by the ray. The direction has to be normalized.
+	 */
+	void queryRay(const Point4& origin, const Vector3& direction, float maxDistance, std::vector<OctreeEntitySP>& result) const;
+
+	std::int32_t getNumberNodes() const;
+
+	std::int32_t getHeight() const;
+
+	/**
+	 * @return Sum of the inner node surface areas relative to the root surface area. The lower, the better is the tree quality.
+	 */
+	float getSurfaceAreaCost() const;
+
+};
+
+typedef std::shared_ptr<BoundingVolumeHierarchy> BoundingVolumeHierarchySP;
+
+#endif /* BOUNDINGVOLUMEHIERARCHY_H_ */
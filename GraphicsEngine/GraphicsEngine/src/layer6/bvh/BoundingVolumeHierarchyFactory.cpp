@@ -0,0 +1,25 @@
+/*
+ * BoundingVolumeHierarchyFactory.cpp
+ *
+ *  Created on: 19.10.2026
+ *      Author: nopper
+ */
+
+#include "../../UsedLibs.h"
+
+#include "BoundingVolumeHierarchyFactory.h"
+
+using namespace std;
+
+BoundingVolumeHierarchyFactory::BoundingVolumeHierarchyFactory()
+{
+}
+
+BoundingVolumeHierarchyFactory::~BoundingVolumeHierarchyFactory()
+{
+}
+
+BoundingVolumeHierarchySP BoundingVolumeHierarchyFactory::createBoundingVolumeHierarchy(float fatMargin) const
+{
+	return BoundingVolumeHierarchySP(new BoundingVolumeHierarchy(glusMathMaxf(fatMargin, 0.0f)), std::default_delete<BoundingVolumeHierarchy>());
+}
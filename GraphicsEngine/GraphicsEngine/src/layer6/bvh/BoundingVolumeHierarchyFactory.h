@@ -0,0 +1,30 @@
+/*
+ * BoundingVolumeHierarchyFactory.h
+ *
+ *  Created on: 19.10.2026
+ *      Author: nopper
+ */
+
+#ifndef BOUNDINGVOLUMEHIERARCHYFACTORY_H_
+#define BOUNDINGVOLUMEHIERARCHYFACTORY_H_
+
+#include "../../UsedLibs.h"
+
+#include "BoundingVolumeHierarchy.h"
+
+class BoundingVolumeHierarchyFactory
+{
+
+public:
+
+	BoundingVolumeHierarchyFactory();
+	virtual ~BoundingVolumeHierarchyFactory();
+
+	/**
+	 * @param fatMargin Enlargement of each leaf box. Entities moving less than this margin do not cause a tree update.
+	 */
+	BoundingVolumeHierarchySP createBoundingVolumeHierarchy(float fatMargin) const;
+
+};
+
+#endif /* BOUNDINGVOLUMEHIERARCHYFACTORY_H_ */
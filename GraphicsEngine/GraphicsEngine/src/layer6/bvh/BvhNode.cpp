@@ -0,0 +1,85 @@
+/*
+ * BvhNode.cpp
+ *
+ *  Created on: 19.10.2026
+ *      Author: nopper
+ */
+
+#include "../../layer3/camera/Camera.h"
+
+#include "BvhNode.h"
+
+using namespace std;
+
+BvhNode::BvhNode() :
+	AxisAlignedBoundingBox(Point4(), 0.0f, 0.0f, 0.0f), parent(0), left(0), right(0), octreeEntity(), height(0), boundingSphere(), distanceToCamera(0.0f)
+{
+}
+
+BvhNode::~BvhNode()
+{
+	// Do not delete entities, as handled by the entity manager
+	octreeEntity.reset();
+}
+
+void BvhNode::init(BvhNode* parent)
+{
+	this->parent = parent;
+	this->left = 0;
+	this->right = 0;
+	this->octreeEntity.reset();
+	this->height = 0;
+	this->distanceToCamera = 0.0f;
+}
+
+void BvhNode::setBox(const Point4& center, float halfWidth, float halfHeight, float halfDepth)
+{
+	this->center = center;
+	this->halfWidth = halfWidth;
+	this->halfHeight = halfHeight;
+	this->halfDepth = halfDepth;
+
+	boundingSphere.setCenter(center);
+	boundingSphere.setRadius(Vector3(halfWidth, halfHeight, halfDepth).length());
+}
+
+void BvhNode::refit()
+{
+	assert(left != nullptr && right != nullptr);
+
+	merge(*left, *right);
+
+	boundingSphere.setCenter(center);
+	boundingSphere.setRadius(Vector3(halfWidth, halfHeight, halfDepth).length());
+
+	height = 1 + (left->height > right->height ? left->height : right->height);
+}
+
+bool BvhNode::isLeaf() const
+{
+	return left == 0;
+}
+
+BvhNode* BvhNode::getSibling(const BvhNode* child) const
+{
+	return left == child ? right : left;
+}
+
+void BvhNode::replaceChild(BvhNode* oldChild, BvhNode* newChild)
+{
+	if (left == oldChild)
+	{
+		left = newChild;
+	}
+	else
+	{
+		right = newChild;
+	}
+
+	newChild->parent = this;
+}
+
+void BvhNode::updateDistanceToCamera()
+{
+	distanceToCamera = OctreeEntity::getCurrentCamera()->distanceToCamera(boundingSphere);
+}
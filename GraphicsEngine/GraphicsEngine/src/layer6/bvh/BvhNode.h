@@ -0,0 +1,64 @@
+/*
+ * BvhNode.h
+ *
+ *  Created on: 19.10.2026
+ *      Author: nopper
+ */
+
+#ifndef BVHNODE_H_
+#define BVHNODE_H_
+
+#include "../../UsedLibs.h"
+
+#include "../../layer0/math/Point4.h"
+#include "../../layer1/collision/AxisAlignedBoundingBox.h"
+#include "../../layer1/collision/BoundingSphere.h"
+#include "../octree/OctreeEntity.h"
+
+class BoundingVolumeHierarchy;
+
+/**
+ * Node of the bounding volume hierarchy. A leaf holds exactly one entity and its box is enlarged by the fat margin.
+ */
+class BvhNode : public AxisAlignedBoundingBox
+{
+
+	friend class BoundingVolumeHierarchy;
+
+private:
+
+	BvhNode* parent;
+
+	BvhNode* left;
+	BvhNode* right;
+
+	OctreeEntitySP octreeEntity;
+
+	std::int32_t height;
+
+	BoundingSphere boundingSphere;
+
+	float distanceToCamera;
+
+private:
+
+	BvhNode();
+	virtual ~BvhNode();
+
+	void init(BvhNode* parent);
+
+	void setBox(const Point4& center, float halfWidth, float halfHeight, float halfDepth);
+
+	void refit();
+
+	bool isLeaf() const;
+
+	BvhNode* getSibling(const BvhNode* child) const;
+
+	void replaceChild(BvhNode* oldChild, BvhNode* newChild);
+
+	void updateDistanceToCamera();
+
+};
+
+#endif /* BVHNODE_H_ */
@@ -137,3 +137,24 @@ SurfaceMaterialSP Model::getSurfaceMaterialAt(int32_t index) const
 
 	return SurfaceMaterialSP();
 }
+
+uint64_t Model::getMemorySize() const
+{
+	uint64_t result = 0;
+
+	vector<const Mesh*> allMeshes;
+
+	for (auto& currentNode : allNodesByName)
+	{
+		const Mesh* mesh = currentNode.second->getMesh().get();
+
+		if (mesh && find(allMeshes.begin(), allMeshes.end(), mesh) == allMeshes.end())
+		{
+			allMeshes.push_back(mesh);
+
+			result += mesh->getMemorySize();
+		}
+	}
+
+	return result;
+}
@@ -58,6 +58,12 @@ public:
 
 	SurfaceMaterialSP getSurfaceMaterialAt(std::int32_t index) const;
 
+	/**
+	 * @return Size in bytes of the meshes in video memory. Meshes shared by several nodes are counted once. Textures are
+	 *         counted by the texture manager.
+	 */
+	std::uint64_t getMemorySize() const;
+
 };
 
 typedef std::shared_ptr<Model> ModelSP;
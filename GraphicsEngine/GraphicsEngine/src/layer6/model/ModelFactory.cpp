@@ -63,7 +63,7 @@ ModelSP ModelFactory::createModel(const std::string& name, const BoundingSphere&
 	return ModelSP(new Model(boundingSphere, node, 0, true, false));
 }
 
-ModelSP ModelFactory::createModel(const string& name, const BoundingSphere& boundingSphere, const GLUSshape& shape, const SurfaceMaterialSP& surfaceMaterial) const
+ModelSP ModelFactory::createModel(const string& name, const BoundingSphere& boundingSphere, GLUSshape& shape, const SurfaceMaterialSP& surfaceMaterial) const
 {
 	vector<AnimationStackSP> allAnimStacks;
 	MeshFactory meshFactory;
@@ -77,7 +77,7 @@ ModelSP ModelFactory::createModel(const string& name, const BoundingSphere& boun
 	return ModelSP(new Model(boundingSphere, node, 0, false, false));
 }
 
-ModelSP ModelFactory::createModel(const string& name, const BoundingSphere& boundingSphere, const GLUSshape& shape, const SurfaceMaterialSP& surfaceMaterial, const vector<AnimationStackSP>& allAnimStacks) const
+ModelSP ModelFactory::createModel(const string& name, const BoundingSphere& boundingSphere, GLUSshape& shape, const SurfaceMaterialSP& surfaceMaterial, const vector<AnimationStackSP>& allAnimStacks) const
 {
 	MeshFactory meshFactory;
 
@@ -34,9 +34,9 @@ public:
 
 	ModelSP createModel(const std::string& name, const BoundingSphere& boundingSphere, const LightSP& light, const std::vector<AnimationStackSP>& allAnimStacks) const;
 
-	ModelSP createModel(const std::string& name, const BoundingSphere& boundingSphere, const GLUSshape& shape, const SurfaceMaterialSP& surfaceMaterial) const;
+	ModelSP createModel(const std::string& name, const BoundingSphere& boundingSphere, GLUSshape& shape, const SurfaceMaterialSP& surfaceMaterial) const;
 
-	ModelSP createModel(const std::string& name, const BoundingSphere& boundingSphere, const GLUSshape& shape, const SurfaceMaterialSP& surfaceMaterial, const std::vector<AnimationStackSP>& allAnimStacks) const;
+	ModelSP createModel(const std::string& name, const BoundingSphere& boundingSphere, GLUSshape& shape, const SurfaceMaterialSP& surfaceMaterial, const std::vector<AnimationStackSP>& allAnimStacks) const;
 
 };
 
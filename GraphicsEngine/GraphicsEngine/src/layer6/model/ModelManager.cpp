@@ -5,12 +5,16 @@
  *      Author: Norbert Nopper
  */
 
+#include "../../layer0/os/Directory.h"
+#include "../../layer1/texture/TexturePacker.h"
+#include "../../layer1/texture/TextureUploadManager.h"
+
 #include "ModelManager.h"
 
 using namespace std;
 
 ModelManager::ModelManager() :
-	Singleton<ModelManager>(), allModels()
+	Singleton<ModelManager>(), allModels(), allDependencies()
 {
 }
 
@@ -37,5 +41,131 @@ const ModelSP& ModelManager::getModelByKey(const string& key) const
 
 void ModelManager::setModel(const string& key, const ModelSP& model)
 {
-	allModels[key] = model;
+	allDependencies.erase(key);
+
+	allModels.replace(key, model);
+}
+
+void ModelManager::setModel(const string& key, const ModelSP& model, const vector<string>& allDependencyFilenames)
+{
+	setModel(key, model);
+
+	for (auto& currentFilename : allDependencyFilenames)
+	{
+		allDependencies.insert(make_pair(key, currentFilename));
+	}
+}
+
+int32_t ModelManager::removeModelsByFilename(const string& canonicalFilename)
+{
+	vector<string> allKeys;
+
+	map<string, ModelSP>::const_iterator walker = allModels.begin();
+	while (walker != allModels.end())
+	{
+		if (Directory::getCanonicalName(walker->first) == canonicalFilename)
+		{
+			allKeys.push_back(walker->first);
+		}
+		else
+		{
+			auto range = allDependencies.equal_range(walker->first);
+
+			for (auto dependency = range.first; dependency != range.second; dependency++)
+			{
+				if (Directory::getCanonicalName(dependency->second) == canonicalFilename)
+				{
+					allKeys.push_back(walker->first);
+
+					break;
+				}
+			}
+		}
+		walker++;
+	}
+
+	for (auto& currentKey : allKeys)
+	{
+		allDependencies.erase(currentKey);
+
+		allModels.remove(currentKey);
+	}
+
+	return static_cast<int32_t>(allKeys.size());
+}
+
+int32_t ModelManager::packTextures(int32_t layerSize, int32_t maxTextureSize, int32_t border)
+{
+	// Textures, which are still decoded, only have their placeholder pixels.
+	TextureUploadManager::getInstance()->finish();
+
+	TexturePacker texturePacker(layerSize, maxTextureSize, border);
+
+	vector<SurfaceMaterialSP> allSurfaceMaterials;
+
+	map<string, ModelSP>::const_iterator walker = allModels.begin();
+	while (walker != allModels.end())
+	{
+		for (int32_t i = 0; i < walker->second->getSurfaceMaterialCount(); i++)
+		{
+			SurfaceMaterialSP surfaceMaterial = walker->second->getSurfaceMaterialAt(i);
+
+			if (find(allSurfaceMaterials.begin(), allSurfaceMaterials.end(), surfaceMaterial) != allSurfaceMaterials.end())
+			{
+				continue;
+			}
+
+			allSurfaceMaterials.push_back(surfaceMaterial);
+
+			texturePacker.addTexture(surfaceMaterial->getDiffuseTexture());
+			texturePacker.addTexture(surfaceMaterial->getSpecularTexture());
+			texturePacker.addTexture(surfaceMaterial->getNormalMapTexture());
+		}
+
+		walker++;
+	}
+
+	int32_t result = texturePacker.pack("packed");
+
+	if (result == 0)
+	{
+		return 0;
+	}
+
+	int32_t packedMaterials = 0;
+
+	vector<SurfaceMaterialSP>::iterator materialWalker = allSurfaceMaterials.begin();
+	while (materialWalker != allSurfaceMaterials.end())
+	{
+		if ((*materialWalker)->packTextures(texturePacker) > 0)
+		{
+			packedMaterials++;
+		}
+
+		materialWalker++;
+	}
+
+	glusLogPrint(GLUS_LOG_INFO, "Packed %d textures of %d surface materials into %d texture arrays", result, packedMaterials, static_cast<int32_t>(texturePacker.getTextureArrays().size()));
+
+	return result;
+}
+
+void ModelManager::setBudget(uint64_t budget)
+{
+	allModels.setBudget(budget);
+}
+
+uint64_t ModelManager::getBudget() const
+{
+	return allModels.getBudget();
+}
+
+int32_t ModelManager::trim()
+{
+	return allModels.trim();
+}
+
+ResourceCacheStatistics ModelManager::getStatistics() const
+{
+	return allModels.getStatistics();
 }
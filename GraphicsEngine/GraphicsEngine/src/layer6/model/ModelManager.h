@@ -10,7 +10,7 @@
 
 #include "../../UsedLibs.h"
 
-#include "../../layer0/stereotype/KeyValueMap.h"
+#include "../../layer0/stereotype/ResourceCache.h"
 #include "../../layer0/stereotype/Singleton.h"
 
 #include "Model.h"
@@ -22,7 +22,9 @@ class ModelManager : public Singleton<ModelManager>
 
 protected:
 
-	KeyValueMap<std::string, ModelSP> allModels;
+	ResourceCache<std::string, ModelSP> allModels;
+
+	std::multimap<std::string, std::string> allDependencies;
 
 	ModelManager();
 	virtual ~ModelManager();
@@ -35,6 +37,46 @@ public:
 
 	void setModel(const std::string& key, const ModelSP& model);
 
+	/**
+	 * @param allDependencyFilenames Further files the model is loaded from, e.g. buffers and images of a glTF file.
+	 */
+	void setModel(const std::string& key, const ModelSP& model, const std::vector<std::string>& allDependencyFilenames);
+
+	/**
+	 * Removes the models loaded from the file or depending on it, so the next load imports the model again.
+	 *
+	 * @param canonicalFilename Name as created by Directory::getCanonicalName.
+	 *
+	 * @return Number of removed models.
+	 */
+	std::int32_t removeModelsByFilename(const std::string& canonicalFilename);
+
+	/**
+	 * @param budget Maximum of bytes of all models in video memory. Models exceeding it are evicted, if they are not used
+	 *               anymore. Zero is unlimited.
+	 */
+	void setBudget(std::uint64_t budget);
+
+	std::uint64_t getBudget() const;
+
+	/**
+	 * Evicts unused models, until the budget is kept, e.g. after unloading a level.
+	 *
+	 * @return Number of evicted models.
+	 */
+	std::int32_t trim();
+
+	ResourceCacheStatistics getStatistics() const;
+
+	/**
+	 * Packs the small diffuse, specular and normal map textures of all models into texture arrays and lets the
+	 * surface materials sample them from there. Needs the pixels of the textures on the CPU. A larger border allows
+	 * coarser mip levels of the packed textures.
+	 *
+	 * @return Number of packed textures.
+	 */
+	std::int32_t packTextures(std::int32_t layerSize = 1024, std::int32_t maxTextureSize = 256, std::int32_t border = 4);
+
 };
 
 #endif /* MODELMANAGER_H_ */
@@ -9,6 +9,7 @@
 #include "../../layer1/command/WorkerManager.h"
 #include "../../layer2/debug/DebugDraw.h"
 #include "../../layer5/command/EntityCommandManager.h"
+#include "../../layer5/occlusion/OcclusionCullingManager.h"
 
 #include "Octree.h"
 
@@ -187,7 +188,7 @@ void Octant::renderEntities(bool ascending, bool force) const
 		auto walkerEntities = allOctreeEntities.begin();
 		while (walkerEntities != allOctreeEntities.end())
 		{
-			if ((force || OctreeEntity::getCurrentCamera()->getViewFrustum().isVisible((*walkerEntities)->getBoundingSphere())) && !octree->isEntityExcluded(*walkerEntities))
+			if ((force || (OctreeEntity::getCurrentCamera()->getViewFrustum().isVisible((*walkerEntities)->getBoundingSphere()) && OcclusionCullingManager::getInstance()->isVisible((*walkerEntities)->getBoundingSphere()))) && !octree->isEntityExcluded(*walkerEntities))
 			{
 				(*walkerEntities)->render();
 			}
@@ -200,7 +201,7 @@ void Octant::renderEntities(bool ascending, bool force) const
 		auto walkerEntities = allOctreeEntities.rbegin();
 		while (walkerEntities != allOctreeEntities.rend())
 		{
-			if ((force || OctreeEntity::getCurrentCamera()->getViewFrustum().isVisible((*walkerEntities)->getBoundingSphere())) && !octree->isEntityExcluded(*walkerEntities))
+			if ((force || (OctreeEntity::getCurrentCamera()->getViewFrustum().isVisible((*walkerEntities)->getBoundingSphere()) && OcclusionCullingManager::getInstance()->isVisible((*walkerEntities)->getBoundingSphere()))) && !octree->isEntityExcluded(*walkerEntities))
 			{
 				(*walkerEntities)->render();
 			}
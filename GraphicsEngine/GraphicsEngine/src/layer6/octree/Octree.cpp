@@ -10,7 +10,7 @@
 using namespace std;
 
 Octree::Octree(uint32_t maxLevels, uint32_t maxElements, const Point4& center, float halfWidth, float halfHeight, float halfDepth):
-	entityExcludeList()
+	SpatialIndex(), entityExcludeList()
 {
 	assert(maxElements > 0);
 
@@ -71,7 +71,7 @@ void Octree::recycleOctant(Octant* octant)
 	}
 }
 
-bool Octree::updateEntity(const OctreeEntitySP& octreeEntity) const
+bool Octree::updateEntity(const OctreeEntitySP& octreeEntity)
 {
 	bool result = root->updateEntity(octreeEntity);
 
@@ -85,17 +85,22 @@ bool Octree::updateEntity(const OctreeEntitySP& octreeEntity) const
 	return result;
 }
 
-void Octree::removeEntity(const OctreeEntitySP& octreeEntity) const
+bool Octree::isEntityEnclosed(const OctreeEntitySP& octreeEntity) const
+{
+	return octreeEntity->insideVisitingOctant();
+}
+
+void Octree::removeEntity(const OctreeEntitySP& octreeEntity)
 {
 	root->removeEntity(octreeEntity);
 }
 
-void Octree::removeAllEntities() const
+void Octree::removeAllEntities()
 {
 	root->removeAllEntities();
 }
 
-void Octree::sort() const
+void Octree::sort()
 {
 	root->sort();
 }
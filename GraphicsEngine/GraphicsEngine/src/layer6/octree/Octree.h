@@ -11,11 +11,12 @@
 #include "../../UsedLibs.h"
 
 #include "../../layer4/entity/EntityList.h"
+#include "../spatial/SpatialIndex.h"
 
 #include "Octant.h"
 #include "OctreeEntity.h"
 
-class Octree
+class Octree : public SpatialIndex
 {
 
 	friend class Octant;
@@ -41,23 +42,25 @@ private:
 
 public:
 
-	bool updateEntity(const OctreeEntitySP& octreeEntity) const;
+	virtual bool updateEntity(const OctreeEntitySP& octreeEntity);
 
-	void removeEntity(const OctreeEntitySP& octreeEntity) const;
+	virtual bool isEntityEnclosed(const OctreeEntitySP& octreeEntity) const;
 
-	void removeAllEntities() const;
+	virtual void removeEntity(const OctreeEntitySP& octreeEntity);
 
-	void sort() const;
+	virtual void removeAllEntities();
 
-	void update() const;
+	virtual void sort();
 
-	void render(bool force = false) const;
+	virtual void update() const;
 
-	void setDebug(bool debug);
+	virtual void render(bool force = false) const;
 
-	void setEntityExcludeList(const EntityListSP& entityExcludeList);
+	virtual void setDebug(bool debug);
 
-	bool isEntityExcluded(const OctreeEntitySP& octreeEntity) const;
+	virtual void setEntityExcludeList(const EntityListSP& entityExcludeList);
+
+	virtual bool isEntityExcluded(const OctreeEntitySP& octreeEntity) const;
 
 };
 
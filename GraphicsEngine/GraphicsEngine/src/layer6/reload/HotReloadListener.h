@@ -0,0 +1,42 @@
+/*
+ * HotReloadListener.h
+ *
+ *  Created on: 19.10.2026
+ *      Author: nopper
+ */
+
+#ifndef HOTRELOADLISTENER_H_
+#define HOTRELOADLISTENER_H_
+
+#include "../../UsedLibs.h"
+
+/**
+ * Notified about changed files, which are not reloaded in place, e.g. models, which have to be imported again.
+ */
+class HotReloadListener
+{
+
+public:
+
+	HotReloadListener()
+	{
+	}
+
+	virtual ~HotReloadListener()
+	{
+	}
+
+	/**
+	 * Called on the thread updating the hot reload manager.
+	 *
+	 * @param canonicalFilename Name as created by Directory::getCanonicalName.
+	 *
+	 * @return True, if the file has been reloaded.
+	 */
+	virtual bool fileChanged(const std::string& canonicalFilename) = 0;
+
+};
+
+typedef std::shared_ptr<HotReloadListener> HotReloadListenerSP;
+
+#endif /* HOTRELOADLISTENER_H_ */
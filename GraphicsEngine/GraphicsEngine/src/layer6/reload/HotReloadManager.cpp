@@ -0,0 +1,123 @@
+/*
+ * HotReloadManager.cpp
+ *
+ *  Created on: 19.10.2026
+ *      Author: nopper
+ */
+
+#include "../../layer0/os/Directory.h"
+#include "../../layer1/shader/ProgramManager.h"
+#include "../../layer1/texture/Texture2DManager.h"
+#include "../../layer1/texture/TextureUploadManager.h"
+#include "../model/ModelManager.h"
+
+#include "HotReloadManager.h"
+
+using namespace std;
+
+HotReloadManager::HotReloadManager() :
+	Singleton<HotReloadManager>(), fileWatcher(), allListeners()
+{
+}
+
+HotReloadManager::~HotReloadManager()
+{
+	fileWatcher.stop();
+
+	allListeners.clear();
+}
+
+void HotReloadManager::addDirectory(const string& name)
+{
+	fileWatcher.addDirectory(name);
+}
+
+bool HotReloadManager::start()
+{
+	return fileWatcher.start();
+}
+
+void HotReloadManager::stop()
+{
+	fileWatcher.stop();
+}
+
+bool HotReloadManager::isRunning() const
+{
+	return fileWatcher.isRunning();
+}
+
+void HotReloadManager::addListener(const HotReloadListenerSP& listener)
+{
+	if (find(allListeners.begin(), allListeners.end(), listener) == allListeners.end())
+	{
+		allListeners.push_back(listener);
+	}
+}
+
+void HotReloadManager::removeListener(const HotReloadListenerSP& listener)
+{
+	auto walker = find(allListeners.begin(), allListeners.end(), listener);
+
+	if (walker != allListeners.end())
+	{
+		allListeners.erase(walker);
+	}
+}
+
+int32_t HotReloadManager::update()
+{
+	if (!fileWatcher.isRunning())
+	{
+		return 0;
+	}
+
+	// An editor may write a file several times, so each file is only reloaded once per frame.
+	vector<string> allChangedFilenames;
+
+	string filename;
+	while (fileWatcher.takeChangedFilename(filename))
+	{
+		string canonicalFilename = Directory::getCanonicalName(filename);
+
+		if (canonicalFilename.size() > 0 && find(allChangedFilenames.begin(), allChangedFilenames.end(), canonicalFilename) == allChangedFilenames.end())
+		{
+			allChangedFilenames.push_back(canonicalFilename);
+		}
+	}
+
+	for (auto& currentFilename : allChangedFilenames)
+	{
+		int32_t numberReloaded = ProgramManager::getInstance()->reloadPrograms(currentFilename);
+
+		// Textures loaded asynchronously are also stored in the texture manager, so they are only decoded again.
+		int32_t numberTextures = TextureUploadManager::getInstance()->reloadTextures(currentFilename);
+
+		if (numberTextures == 0)
+		{
+			numberTextures = Texture2DManager::getInstance()->reloadTextures(currentFilename);
+		}
+
+		numberReloaded += numberTextures;
+
+		numberReloaded += ModelManager::getInstance()->removeModelsByFilename(currentFilename);
+
+		// Copied, as a listener may remove itself.
+		vector<HotReloadListenerSP> allCurrentListeners = allListeners;
+
+		for (auto& currentListener : allCurrentListeners)
+		{
+			if (currentListener->fileChanged(currentFilename))
+			{
+				numberReloaded++;
+			}
+		}
+
+		if (numberReloaded > 0)
+		{
+			glusLogPrint(GLUS_LOG_INFO, "Reloaded %d resources of file: %s", numberReloaded, currentFilename.c_str());
+		}
+	}
+
+	return static_cast<int32_t>(allChangedFilenames.size());
+}
@@ -0,0 +1,67 @@
+/*
+ * HotReloadManager.h
+ *
+ *  Created on: 19.10.2026
+ *      Author: nopper
+ */
+
+#ifndef HOTRELOADMANAGER_H_
+#define HOTRELOADMANAGER_H_
+
+#include "../../UsedLibs.h"
+
+#include "../../layer0/os/FileWatcher.h"
+#include "../../layer0/stereotype/Singleton.h"
+
+#include "HotReloadListener.h"
+
+/**
+ * Reloads shaders and textures, when their files change on disk. Changes are detected by a file watcher on an own thread
+ * and applied in update, so resources are only swapped between frames. Programs failing to compile keep their previous
+ * version. Models are removed from the model manager and the listeners are notified, as the entities using them have
+ * to be created again.
+ */
+class HotReloadManager : public Singleton<HotReloadManager>
+{
+
+	friend class Singleton<HotReloadManager>;
+
+private:
+
+	FileWatcher fileWatcher;
+
+	std::vector<HotReloadListenerSP> allListeners;
+
+	HotReloadManager();
+	virtual ~HotReloadManager();
+
+public:
+
+	/**
+	 * Watches the directory and its sub directories. Has to be called before starting.
+	 */
+	void addDirectory(const std::string& name);
+
+	/**
+	 * @return False, if watching files is not supported or no directory could be watched.
+	 */
+	bool start();
+
+	void stop();
+
+	bool isRunning() const;
+
+	void addListener(const HotReloadListenerSP& listener);
+
+	void removeListener(const HotReloadListenerSP& listener);
+
+	/**
+	 * Reloads the resources of all changed files. Called once per frame by the engine update on the rendering thread.
+	 *
+	 * @return Number of changed files.
+	 */
+	std::int32_t update();
+
+};
+
+#endif /* HOTRELOADMANAGER_H_ */
@@ -0,0 +1,59 @@
+/*
+ * SpatialIndex.h
+ *
+ *  Created on: 19.10.2026
+ *      Author: nopper
+ */
+
+#ifndef SPATIALINDEX_H_
+#define SPATIALINDEX_H_
+
+#include "../../UsedLibs.h"
+
+#include "../../layer4/entity/EntityList.h"
+#include "../octree/OctreeEntity.h"
+
+/**
+ * Common interface of the spatial structures, which are used by the entity manager for updating, culling and sorting.
+ */
+class SpatialIndex
+{
+
+public:
+
+	SpatialIndex()
+	{
+	}
+
+	virtual ~SpatialIndex()
+	{
+	}
+
+	virtual bool updateEntity(const OctreeEntitySP& octreeEntity) = 0;
+
+	/**
+	 * @return True, if the entity is still enclosed by its current cell and does not have to be updated.
+	 */
+	virtual bool isEntityEnclosed(const OctreeEntitySP& octreeEntity) const = 0;
+
+	virtual void removeEntity(const OctreeEntitySP& octreeEntity) = 0;
+
+	virtual void removeAllEntities() = 0;
+
+	virtual void sort() = 0;
+
+	virtual void update() const = 0;
+
+	virtual void render(bool force = false) const = 0;
+
+	virtual void setDebug(bool debug) = 0;
+
+	virtual void setEntityExcludeList(const EntityListSP& entityExcludeList) = 0;
+
+	virtual bool isEntityExcluded(const OctreeEntitySP& octreeEntity) const = 0;
+
+};
+
+typedef std::shared_ptr<SpatialIndex> SpatialIndexSP;
+
+#endif /* SPATIALINDEX_H_ */
@@ -89,7 +89,7 @@ public:
     virtual bool isUpdateable() const;
     virtual void setUpdateable(bool updateable);
 
-	const Matrix4x4& getModelMatrix() const;
+    virtual const Matrix4x4& getModelMatrix() const;
 
 	const Matrix3x3& getNormalModelMatrix() const;
 
@@ -7,13 +7,16 @@
 
 #include "../../layer1/command/WorkerManager.h"
 #include "../../layer5/command/EntityCommandManager.h"
+#include "../../layer5/environment/DynamicEnvironmentManager.h"
+#include "../../layer5/occlusion/OcclusionCullingManager.h"
+#include "../../layer5/render/RenderQueue.h"
 
 #include "GeneralEntityManager.h"
 
 using namespace std;
 
 GeneralEntityManager::GeneralEntityManager() :
-	Singleton<GeneralEntityManager>(), allEntities(), allUpdatableEntities(), octree(), quicksort(), entityExcludeList()
+	Singleton<GeneralEntityManager>(), allEntities(), allUpdatableEntities(), spatialIndex(), quicksort(), entityExcludeList(), allShadowCasterCandidates(), allDynamicEnvironmentCandidates()
 {
 }
 
@@ -36,28 +39,33 @@ GeneralEntityManager::~GeneralEntityManager()
 
 void GeneralEntityManager::setOctree(const OctreeSP& octree)
 {
-	if (this->octree.get())
+	setSpatialIndex(octree);
+}
+
+void GeneralEntityManager::setSpatialIndex(const SpatialIndexSP& spatialIndex)
+{
+	if (this->spatialIndex.get())
 	{
-		this->octree->removeAllEntities();
+		this->spatialIndex->removeAllEntities();
 	}
 
-	this->octree = octree;
-	this->octree->removeAllEntities();
-	this->octree->setEntityExcludeList(entityExcludeList);
+	this->spatialIndex = spatialIndex;
+	this->spatialIndex->removeAllEntities();
+	this->spatialIndex->setEntityExcludeList(entityExcludeList);
 
 	vector<GeneralEntitySP>::iterator walker = allEntities.begin();
 	while (walker != allEntities.end())
 	{
-		octree->updateEntity(*walker);
+		spatialIndex->updateEntity(*walker);
 		walker++;
 	}
 }
 
 void GeneralEntityManager::update() const
 {
-	if (octree.get())
+	if (spatialIndex.get())
 	{
-		octree->update();
+		spatialIndex->update();
 	}
 	else
 	{
@@ -91,14 +99,14 @@ void GeneralEntityManager::update() const
 		walker++;
 	}
 
-	if (octree.get())
+	if (spatialIndex.get())
 	{
 		walker = allUpdatableEntities.begin();
 		while (walker != allUpdatableEntities.end())
 		{
-			if (!(*walker)->insideVisitingOctant())
+			if (!spatialIndex->isEntityEnclosed(*walker))
 			{
-				octree->updateEntity(*walker);
+				spatialIndex->updateEntity(*walker);
 			}
 
 			walker++;
@@ -108,9 +116,9 @@ void GeneralEntityManager::update() const
 
 void GeneralEntityManager::sort()
 {
-	if (octree.get())
+	if (spatialIndex.get())
 	{
-		octree->sort();
+		spatialIndex->sort();
 	}
 	else
 	{
@@ -128,9 +136,17 @@ void GeneralEntityManager::sort()
 
 void GeneralEntityManager::render(bool force) const
 {
-	if (octree.get())
+	// Collect the draws of all entities and issue them sorted by state.
+	bool flushRenderQueue = RenderQueue::getInstance()->isEnabled() && !RenderQueue::getInstance()->isRecording();
+
+	if (flushRenderQueue)
 	{
-		octree->render(force);
+		RenderQueue::getInstance()->begin();
+	}
+
+	if (spatialIndex.get())
+	{
+		spatialIndex->render(force);
 	}
 	else
 	{
@@ -139,7 +155,7 @@ void GeneralEntityManager::render(bool force) const
 			auto walker = allEntities.begin();
 			while (walker != allEntities.end())
 			{
-				if ((force || GeneralEntity::getCurrentCamera()->getViewFrustum().isVisible((*walker)->getBoundingSphere())) && !isEntityExcluded(*walker))
+				if ((force || (GeneralEntity::getCurrentCamera()->getViewFrustum().isVisible((*walker)->getBoundingSphere()) && OcclusionCullingManager::getInstance()->isVisible((*walker)->getBoundingSphere()))) && !isEntityExcluded(*walker))
 				{
 					(*walker)->render();
 				}
@@ -152,7 +168,7 @@ void GeneralEntityManager::render(bool force) const
 			auto walker = allEntities.rbegin();
 			while (walker != allEntities.rend())
 			{
-				if ((force || GeneralEntity::getCurrentCamera()->getViewFrustum().isVisible((*walker)->getBoundingSphere())) && !isEntityExcluded(*walker))
+				if ((force || (GeneralEntity::getCurrentCamera()->getViewFrustum().isVisible((*walker)->getBoundingSphere()) && OcclusionCullingManager::getInstance()->isVisible((*walker)->getBoundingSphere()))) && !isEntityExcluded(*walker))
 				{
 					(*walker)->render();
 				}
@@ -161,6 +177,188 @@ void GeneralEntityManager::render(bool force) const
 			}
 		}
 	}
+
+	if (flushRenderQueue)
+	{
+		RenderQueue::getInstance()->flush();
+	}
+}
+
+void GeneralEntityManager::render(const vector<Entity*>& entities) const
+{
+	bool flushRenderQueue = RenderQueue::getInstance()->isEnabled() && !RenderQueue::getInstance()->isRecording();
+
+	if (flushRenderQueue)
+	{
+		RenderQueue::getInstance()->begin();
+	}
+
+	if (GeneralEntity::isAscendingSortOrder())
+	{
+		auto walker = entities.begin();
+		while (walker != entities.end())
+		{
+			(*walker)->render();
+
+			walker++;
+		}
+	}
+	else
+	{
+		auto walker = entities.rbegin();
+		while (walker != entities.rend())
+		{
+			(*walker)->render();
+
+			walker++;
+		}
+	}
+
+	if (flushRenderQueue)
+	{
+		RenderQueue::getInstance()->flush();
+	}
+}
+
+void GeneralEntityManager::scheduleDynamicEnvironments(const Point4& viewerPosition)
+{
+	allDynamicEnvironmentCandidates.clear();
+
+	auto walker = allEntities.begin();
+	while (walker != allEntities.end())
+	{
+		if (!isEntityExcluded(*walker))
+		{
+			allDynamicEnvironmentCandidates.push_back(walker->get());
+		}
+
+		walker++;
+	}
+
+	DynamicEnvironmentManager::getInstance()->schedule(viewerPosition, allDynamicEnvironmentCandidates);
+}
+
+void GeneralEntityManager::updateShadowBounds(const CameraSP& camera, const OrthographicCameraCascadedShadowMap2DSP& orthographicCameraCascadedShadowMap2D)
+{
+	orthographicCameraCascadedShadowMap2D->resetBounds();
+
+	allShadowCasterCandidates.clear();
+
+	bool receiversFound = false;
+	AxisAlignedBoundingBox receiverBounds;
+
+	bool castersFound = false;
+	AxisAlignedBoundingBox casterBounds;
+
+	auto walker = allEntities.begin();
+	while (walker != allEntities.end())
+	{
+		if (!isEntityExcluded(*walker))
+		{
+			const BoundingSphere& boundingSphere = (*walker)->getBoundingSphere();
+
+			AxisAlignedBoundingBox currentBounds(boundingSphere.getCenter(), boundingSphere.getRadius(), boundingSphere.getRadius(), boundingSphere.getRadius());
+
+			if (castersFound)
+			{
+				casterBounds.merge(casterBounds, currentBounds);
+			}
+			else
+			{
+				casterBounds = currentBounds;
+
+				castersFound = true;
+			}
+
+			if (camera->getViewFrustum().isVisible(boundingSphere))
+			{
+				if (receiversFound)
+				{
+					receiverBounds.merge(receiverBounds, currentBounds);
+				}
+				else
+				{
+					receiverBounds = currentBounds;
+
+					receiversFound = true;
+				}
+			}
+
+			allShadowCasterCandidates.push_back(walker->get());
+		}
+
+		walker++;
+	}
+
+	if (receiversFound)
+	{
+		orthographicCameraCascadedShadowMap2D->setReceiverBounds(receiverBounds);
+	}
+
+	if (castersFound)
+	{
+		orthographicCameraCascadedShadowMap2D->setCasterBounds(casterBounds);
+	}
+}
+
+void GeneralEntityManager::cullShadowCasters(const OrthographicCameraCascadedShadowMap2DSP& orthographicCameraCascadedShadowMap2D)
+{
+	for (int32_t section = 0; section < orthographicCameraCascadedShadowMap2D->getSections(); section++)
+	{
+		const ViewFrustum* viewFrustum = &orthographicCameraCascadedShadowMap2D->getOrthographicCamera(section)->getViewFrustum();
+
+		vector<Entity*>* shadowCasters = &orthographicCameraCascadedShadowMap2D->getShadowCasters(section);
+
+		if (WorkerManager::getInstance()->getNumberWorkers() == 0)
+		{
+			shadowCasters->clear();
+
+			auto walker = allShadowCasterCandidates.begin();
+			while (walker != allShadowCasterCandidates.end())
+			{
+				if (viewFrustum->isVisible((*walker)->getBoundingSphere()))
+				{
+					shadowCasters->push_back(*walker);
+				}
+
+				walker++;
+			}
+		}
+		else
+		{
+			EntityCommandManager::getInstance()->publishCullCommand(viewFrustum, &allShadowCasterCandidates, shadowCasters);
+		}
+	}
+
+	if (WorkerManager::getInstance()->getNumberWorkers() > 0)
+	{
+		EntityCommandManager::getInstance()->waitCullAllFinished();
+	}
+}
+
+void GeneralEntityManager::renderShadowCasters(const OrthographicCameraCascadedShadowMap2DSP& orthographicCameraCascadedShadowMap2D, int32_t section) const
+{
+	bool flushRenderQueue = RenderQueue::getInstance()->isEnabled() && !RenderQueue::getInstance()->isRecording();
+
+	if (flushRenderQueue)
+	{
+		RenderQueue::getInstance()->begin();
+	}
+
+	const vector<Entity*>& shadowCasters = orthographicCameraCascadedShadowMap2D->getShadowCasters(section);
+
+	auto walker = shadowCasters.begin();
+	while (walker != shadowCasters.end())
+	{
+		(*walker)->render();
+
+		walker++;
+	}
+
+	if (flushRenderQueue)
+	{
+		RenderQueue::getInstance()->flush();
+	}
 }
 
 void GeneralEntityManager::updateEntity(const GeneralEntitySP& entity)
@@ -169,9 +367,9 @@ void GeneralEntityManager::updateEntity(const GeneralEntitySP& entity)
 	if (walker == allEntities.end())
 	{
 		allEntities.push_back(entity);
-		if (octree.get())
+		if (spatialIndex.get())
 		{
-			octree->updateEntity(entity);
+			spatialIndex->updateEntity(entity);
 		}
 		entity->update();
 	}
@@ -192,9 +390,9 @@ void GeneralEntityManager::removeEntity(const GeneralEntitySP& entity)
 	vector<GeneralEntitySP>::iterator walker = find(allEntities.begin(), allEntities.end(), entity);
 	if (walker != allEntities.end())
 	{
-		if (octree.get())
+		if (spatialIndex.get())
 		{
-			octree->removeEntity(entity);
+			spatialIndex->removeEntity(entity);
 		}
 		allEntities.erase(walker);
 	}
@@ -237,9 +435,9 @@ void GeneralEntityManager::setEntityExcludeList(const EntityListSP& entityExclud
 {
 	this->entityExcludeList = entityExcludeList;
 
-	if (octree)
+	if (spatialIndex)
 	{
-		octree->setEntityExcludeList(entityExcludeList);
+		spatialIndex->setEntityExcludeList(entityExcludeList);
 	}
 }
 
@@ -14,7 +14,9 @@
 #include "../../layer0/stereotype/Singleton.h"
 #include "../../layer0/stereotype/ValueVector.h"
 #include "../../layer4/entity/EntityList.h"
+#include "../../layer4/shadow/OrthographicCameraCascadedShadowMap2D.h"
 #include "../../layer6/octree/Octree.h"
+#include "../../layer6/spatial/SpatialIndex.h"
 #include "GeneralEntity.h"
 
 class GeneralEntityManager : public Singleton<GeneralEntityManager>
@@ -27,12 +29,16 @@ private:
 	std::vector<GeneralEntitySP> allEntities;
 	std::vector<GeneralEntitySP> allUpdatableEntities;
 
-	OctreeSP octree;
+	SpatialIndexSP spatialIndex;
 
 	Quicksort<GeneralEntitySP> quicksort;
 
 	EntityListSP entityExcludeList;
 
+	std::vector<Entity*> allShadowCasterCandidates;
+
+	std::vector<Entity*> allDynamicEnvironmentCandidates;
+
 protected:
 
 	GeneralEntityManager();
@@ -42,6 +48,11 @@ public:
 
 	void setOctree(const OctreeSP& octree);
 
+	/**
+	 * Sets the spatial structure used for updating, culling and sorting e.g. an octree or a bounding volume hierarchy.
+	 */
+	void setSpatialIndex(const SpatialIndexSP& spatialIndex);
+
 	void update() const;
 
 	void sort();
@@ -51,6 +62,36 @@ public:
 	 */
 	void render(bool force = false) const;
 
+	/**
+	 * Renders the given entities without culling. The list is expected to be sorted by ascending distance.
+	 */
+	void render(const std::vector<Entity*>& entities) const;
+
+	/**
+	 * Culls all entities, which are not excluded, against the faces of the dynamic environments and selects
+	 * the faces to be rendered this frame.
+	 *
+	 * @see DynamicEnvironmentManager::schedule
+	 */
+	void scheduleDynamicEnvironments(const Point4& viewerPosition);
+
+	/**
+	 * Sets the receiver bounds of the cascaded shadow map to the visible entities and the caster bounds to all entities.
+	 * Has to be called before the cameras of the sections are adjusted.
+	 */
+	void updateShadowBounds(const CameraSP& camera, const OrthographicCameraCascadedShadowMap2DSP& orthographicCameraCascadedShadowMap2D);
+
+	/**
+	 * Culls the shadow casters against the camera of each section, one job per section. Has to be called after the cameras
+	 * of the sections are adjusted.
+	 */
+	void cullShadowCasters(const OrthographicCameraCascadedShadowMap2DSP& orthographicCameraCascadedShadowMap2D);
+
+	/**
+	 * Renders the culled shadow casters of the section.
+	 */
+	void renderShadowCasters(const OrthographicCameraCascadedShadowMap2DSP& orthographicCameraCascadedShadowMap2D, std::int32_t section) const;
+
 	void updateEntity(const GeneralEntitySP& entity);
 
 	void removeEntity(const GeneralEntitySP& entity);
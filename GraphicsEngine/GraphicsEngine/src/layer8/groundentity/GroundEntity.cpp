@@ -5,6 +5,8 @@
  *      Author: nopper
  */
 
+#include "../../layer1/shader/ProgramManager.h"
+#include "../../layer1/shader/RenderStateCache.h"
 #include "../../layer1/shader/Variables.h"
 #include "../../layer2/debug/DebugDraw.h"
 #include "../../layer2/environment/Sky.h"
@@ -15,7 +17,7 @@
 using namespace std;
 
 GroundEntity::GroundEntity(const string& name, const GroundSP& ground, const SurfaceMaterialSP& surfaceMaterial, float scaleX, float scaleY, float scaleZ) :
-		GeneralEntity(name, scaleX, scaleY, scaleZ), repeat(1.0f), displacementScale(1.0f), transparent(false), tessellate(true), screenDistance(8.0f), ground(ground), surfaceMaterial(surfaceMaterial)
+		GeneralEntity(name, scaleX, scaleY, scaleZ), repeat(1.0f), displacementScale(1.0f), transparent(false), tessellate(true), screenDistance(8.0f), ground(ground), surfaceMaterial(surfaceMaterial), terrainQuadtree(), allTerrainTiles()
 {
 	float maxScale = glusMathMaxf(scaleX, scaleY);
 	maxScale = glusMathMaxf(maxScale, scaleZ);
@@ -55,83 +57,70 @@ void GroundEntity::render() const
 	// We process triangle patches
 	glPatchParameteri(GL_PATCH_VERTICES, 3);
 
-	currentProgram->use();
+	RenderStateCache::getInstance()->useProgram(currentProgram);
 
-	currentVAO->bind();
+	RenderStateCache::getInstance()->bindVertexArray(currentVAO->getVAOName());
 
 	glUniformMatrix4fv(currentProgram->getUniformLocation(u_modelMatrix), 1, GL_FALSE, getModelMatrix().getM());
 
 	// We have the inverse and transpose by setting the matrix
 	glUniformMatrix3fv(currentProgram->getUniformLocation(u_normalModelMatrix), 1, GL_TRUE, getNormalModelMatrix().getM());
 
-	glUniform4fv(currentProgram->getUniformLocation(u_emissiveColor), 1, surfaceMaterial->getEmissive().getRGBA());
-	glUniform4fv(currentProgram->getUniformLocation(u_ambientColor), 1, surfaceMaterial->getAmbient().getRGBA());
+	surfaceMaterial->updateUniformBlock();
+
+	currentProgram->setUniformBlockBinding(u_materialBlock, MATERIAL_BLOCK_BINDING);
+
+	RenderStateCache::getInstance()->bindUniformBuffer(MATERIAL_BLOCK_BINDING, surfaceMaterial->getUniformBuffer()->getUniformBufferName());
 
 	if (surfaceMaterial->getDiffuseTextureName() != 0)
 	{
 		glUniform1i(currentProgram->getUniformLocation(u_hasDiffuseTexture), 1);
 
-		glActiveTexture(GL_TEXTURE0);
-		glBindTexture(GL_TEXTURE_2D, surfaceMaterial->getDiffuseTextureName());
+		RenderStateCache::getInstance()->bindTexture(GL_TEXTURE0, GL_TEXTURE_2D, surfaceMaterial->getDiffuseTextureName());
 		glUniform1i(currentProgram->getUniformLocation(u_diffuseTexture), 0);
 	}
 	else
 	{
 		glUniform1i(currentProgram->getUniformLocation(u_hasDiffuseTexture), 0);
 
-		glActiveTexture(GL_TEXTURE0);
-		glBindTexture(GL_TEXTURE_2D, 0);
+		RenderStateCache::getInstance()->bindTexture(GL_TEXTURE0, GL_TEXTURE_2D, 0);
 		glUniform1i(currentProgram->getUniformLocation(u_diffuseTexture), 0);
 	}
-	glUniform4fv(currentProgram->getUniformLocation(u_diffuseColor), 1, surfaceMaterial->getDiffuse().getRGBA());
 
 	if (surfaceMaterial->getSpecularTextureName() != 0)
 	{
 		glUniform1i(currentProgram->getUniformLocation(u_hasSpecularTexture), 1);
 
-		glActiveTexture(GL_TEXTURE1);
-		glBindTexture(GL_TEXTURE_2D, surfaceMaterial->getSpecularTextureName());
+		RenderStateCache::getInstance()->bindTexture(GL_TEXTURE1, GL_TEXTURE_2D, surfaceMaterial->getSpecularTextureName());
 		glUniform1i(currentProgram->getUniformLocation(u_specularTexture), 1);
 	}
 	else
 	{
 		glUniform1i(currentProgram->getUniformLocation(u_hasSpecularTexture), 0);
 
-		glActiveTexture(GL_TEXTURE1);
-		glBindTexture(GL_TEXTURE_2D, 0);
+		RenderStateCache::getInstance()->bindTexture(GL_TEXTURE1, GL_TEXTURE_2D, 0);
 		glUniform1i(currentProgram->getUniformLocation(u_specularTexture), 0);
 	}
-	glUniform4fv(currentProgram->getUniformLocation(u_specularColor), 1, surfaceMaterial->getSpecular().getRGBA());
-	glUniform1f(currentProgram->getUniformLocation(u_shininess), surfaceMaterial->getShininess());
-
-	glUniform1f(currentProgram->getUniformLocation(u_transparency), surfaceMaterial->getTransparency());
-
 	if (surfaceMaterial->getDisplacementMapTextureName() != 0)
 	{
 		glUniform1i(currentProgram->getUniformLocation(u_hasNormalMapTexture), 1);
 
-		glActiveTexture(GL_TEXTURE2);
-		glBindTexture(GL_TEXTURE_2D, surfaceMaterial->getDisplacementMapTextureName());
+		RenderStateCache::getInstance()->bindTexture(GL_TEXTURE2, GL_TEXTURE_2D, surfaceMaterial->getDisplacementMapTextureName());
 		glUniform1i(currentProgram->getUniformLocation(u_normalMapTexture), 2);
-		glActiveTexture(GL_TEXTURE0);
 	}
 	else if (surfaceMaterial->getNormalMapTextureName() != 0)
 	{
 		glUniform1i(currentProgram->getUniformLocation(u_hasNormalMapTexture), 1);
 
-		glActiveTexture(GL_TEXTURE2);
-		glBindTexture(GL_TEXTURE_2D, surfaceMaterial->getNormalMapTextureName());
+		RenderStateCache::getInstance()->bindTexture(GL_TEXTURE2, GL_TEXTURE_2D, surfaceMaterial->getNormalMapTextureName());
 		glUniform1i(currentProgram->getUniformLocation(u_normalMapTexture), 2);
-		glActiveTexture(GL_TEXTURE0);
 	}
 	else
 	{
 		glUniform1i(currentProgram->getUniformLocation(u_hasNormalMapTexture), 0);
 
-		glActiveTexture(GL_TEXTURE2);
-		glBindTexture(GL_TEXTURE_2D, 0);
+		RenderStateCache::getInstance()->bindTexture(GL_TEXTURE2, GL_TEXTURE_2D, 0);
 		glUniform1i(currentProgram->getUniformLocation(u_normalMapTexture), 2);
-		glActiveTexture(GL_TEXTURE0);
 	}
 
 	//
@@ -152,9 +141,6 @@ void GroundEntity::render() const
 
 	//
 
-	glUniform4fv(currentProgram->getUniformLocation(u_reflectionColor), 1, surfaceMaterial->getReflection().getRGBA());
-	glUniform4fv(currentProgram->getUniformLocation(u_refractionColor), 1, surfaceMaterial->getRefraction().getRGBA());
-
 	float environmentRefractiveIndex = refractiveIndex;
 
 	if (environmentRefractiveIndex != RI_NOTHING)
@@ -180,43 +166,36 @@ void GroundEntity::render() const
 
 		SkySP activeSky = SkyManager::getInstance()->getActiveSky();
 
-		glActiveTexture(GL_TEXTURE3);
-		glBindTexture(GL_TEXTURE_CUBE_MAP, activeSky->getSkyTextureName());
+		RenderStateCache::getInstance()->bindTexture(GL_TEXTURE3, GL_TEXTURE_CUBE_MAP, activeSky->getSkyTextureName());
 	    glUniform1i(currentProgram->getUniformLocation(u_cubemap), 3);
-		glActiveTexture(GL_TEXTURE0);
 	}
 	else
 	{
 		glUniform1i(currentProgram->getUniformLocation(u_hasCubeMapTexture), 0);
 
-		glActiveTexture(GL_TEXTURE3);
-		glBindTexture(GL_TEXTURE_CUBE_MAP, 0);
+		RenderStateCache::getInstance()->bindTexture(GL_TEXTURE3, GL_TEXTURE_CUBE_MAP, 0);
 	    glUniform1i(currentProgram->getUniformLocation(u_cubemap), 3);
-		glActiveTexture(GL_TEXTURE0);
 	}
 
 	// Only allow dynamic cube map, if also a sky cube map is available
 	if (Entity::getDynamicCubeMaps() && surfaceMaterial->getDynamicCubeMapTextureName() != 0 && SkyManager::getInstance()->hasActiveSky())
 	{
 		glUniform1i(currentProgram->getUniformLocation(u_hasDynamicCubeMapTexture), 1);
-		glActiveTexture(GL_TEXTURE4);
-		glBindTexture(GL_TEXTURE_CUBE_MAP, surfaceMaterial->getDynamicCubeMapTextureName());
+		RenderStateCache::getInstance()->bindTexture(GL_TEXTURE4, GL_TEXTURE_CUBE_MAP, surfaceMaterial->getDynamicCubeMapTextureName());
 	    glUniform1i(currentProgram->getUniformLocation(u_dynamicCubeMapTexture), 4);
-		glActiveTexture(GL_TEXTURE0);
 	}
 	else
 	{
 		glUniform1i(currentProgram->getUniformLocation(u_hasDynamicCubeMapTexture), 0);
-		glActiveTexture(GL_TEXTURE4);
-		glBindTexture(GL_TEXTURE_CUBE_MAP, 0);
+		RenderStateCache::getInstance()->bindTexture(GL_TEXTURE4, GL_TEXTURE_CUBE_MAP, 0);
 	    glUniform1i(currentProgram->getUniformLocation(u_dynamicCubeMapTexture), 4);
-		glActiveTexture(GL_TEXTURE0);
 	}
 
 	if (!Entity::getDynamicCubeMaps())
 	{
 		glUniformMatrix4fv(currentProgram->getUniformLocation(u_cubeMapViewMatrix), 6, GL_FALSE, Entity::getCubeMapViewMatrices()[0].getM());
 		glUniformMatrix4fv(currentProgram->getUniformLocation(u_cubeMapProjectionMatrix), 1, GL_FALSE, Entity::getCubeMapProjectionMatrix().getM());
+		glUniform1i(currentProgram->getUniformLocation(u_cubeMapFaceMask), Entity::getCubeMapFaceMask());
 	}
 
 	// No Skinning
@@ -238,7 +217,14 @@ void GroundEntity::render() const
 		glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
 	}
 
-	glDrawElements(GL_PATCHES, ground->getNumberIndices(), GL_UNSIGNED_INT, 0);
+	if (terrainQuadtree.get() && ground->isTerrainTile())
+	{
+		renderTerrainTiles(currentProgram);
+	}
+	else
+	{
+		RenderStateCache::getInstance()->drawElements(GL_PATCHES, ground->getNumberIndices(), GL_UNSIGNED_INT, 0);
+	}
 
 	if (transparent)
 	{
@@ -247,37 +233,32 @@ void GroundEntity::render() const
 
 	if (surfaceMaterial->getDiffuseTextureName() != 0)
 	{
-		glActiveTexture(GL_TEXTURE0);
-		glBindTexture(GL_TEXTURE_2D, 0);
+		RenderStateCache::getInstance()->bindTexture(GL_TEXTURE0, GL_TEXTURE_2D, 0);
 	}
 
 	if (surfaceMaterial->getSpecularTextureName() != 0)
 	{
-		glActiveTexture(GL_TEXTURE1);
-		glBindTexture(GL_TEXTURE_2D, 0);
+		RenderStateCache::getInstance()->bindTexture(GL_TEXTURE1, GL_TEXTURE_2D, 0);
 	}
 
 	if (surfaceMaterial->getDisplacementMapTextureName() != 0 || surfaceMaterial->getNormalMapTextureName() != 0)
 	{
-		glActiveTexture(GL_TEXTURE2);
-		glBindTexture(GL_TEXTURE_2D, 0);
+		RenderStateCache::getInstance()->bindTexture(GL_TEXTURE2, GL_TEXTURE_2D, 0);
 	}
 
 	if (SkyManager::getInstance()->hasActiveSky())
 	{
-		glActiveTexture(GL_TEXTURE3);
-		glBindTexture(GL_TEXTURE_CUBE_MAP, 0);
+		RenderStateCache::getInstance()->bindTexture(GL_TEXTURE3, GL_TEXTURE_CUBE_MAP, 0);
 	}
 
 	if (surfaceMaterial->getDynamicCubeMapTexture() != 0)
 	{
-		glActiveTexture(GL_TEXTURE4);
-		glBindTexture(GL_TEXTURE_CUBE_MAP, 0);
+		RenderStateCache::getInstance()->bindTexture(GL_TEXTURE4, GL_TEXTURE_CUBE_MAP, 0);
 	}
 
 	glActiveTexture(GL_TEXTURE0);
 
-	currentVAO->unbind();
+	RenderStateCache::getInstance()->bindVertexArray(0);
 
 	//
 
@@ -294,6 +275,41 @@ void GroundEntity::render() const
 	}
 }
 
+void GroundEntity::renderTerrainTiles(const ProgramSP& currentProgram) const
+{
+	// All six faces of a cube map are rendered at once, so only the frustum of a regular camera can be used for culling.
+	const ViewFrustum* viewFrustum = GeneralEntity::currentProgramType != ProgramManager::RENDER_TO_CUBEMAP_PROGRAM_TYPE ? &currentCamera->getViewFrustum() : nullptr;
+
+	// The displacement along the normal is the alpha channel of the normal map scaled.
+	terrainQuadtree->select(getModelMatrix(), currentCamera->getEye(), viewFrustum, 0.0f, displacementScale, allTerrainTiles);
+
+	GLint terrainTileLocation = currentProgram->getUniformLocation(u_terrainTile);
+	GLint terrainMorphLocation = currentProgram->getUniformLocation(u_terrainMorph);
+
+	float gridSize = static_cast<float>(terrainQuadtree->getGridSize());
+
+	uint32_t numberQuadrantIndices = ground->getNumberIndices() / 4;
+
+	auto walker = allTerrainTiles.begin();
+	while (walker != allTerrainTiles.end())
+	{
+		glUniform4f(terrainTileLocation, walker->offset[0], walker->offset[1], walker->size, gridSize);
+		glUniform2f(terrainMorphLocation, walker->morphStart, walker->morphEnd);
+
+		if (walker->quadrant < 0)
+		{
+			RenderStateCache::getInstance()->drawElements(GL_PATCHES, ground->getNumberIndices(), GL_UNSIGNED_INT, 0);
+		}
+		else
+		{
+			// The indices of the tile are ordered by quadrant.
+			RenderStateCache::getInstance()->drawElements(GL_PATCHES, numberQuadrantIndices, GL_UNSIGNED_INT, reinterpret_cast<const GLvoid*>(walker->quadrant * numberQuadrantIndices * sizeof(GLuint)));
+		}
+
+		walker++;
+	}
+}
+
 const SurfaceMaterialSP& GroundEntity::getSurfaceMaterial() const
 {
 	return surfaceMaterial;
@@ -353,3 +369,20 @@ void GroundEntity::setScreenDistance(float screenDistance)
 {
 	this->screenDistance = screenDistance;
 }
+
+const TerrainQuadtreeSP& GroundEntity::getTerrainQuadtree() const
+{
+	return terrainQuadtree;
+}
+
+void GroundEntity::setTerrainQuadtree(const TerrainQuadtreeSP& terrainQuadtree)
+{
+	this->terrainQuadtree = terrainQuadtree;
+
+	allTerrainTiles.clear();
+}
+
+int32_t GroundEntity::getNumberTerrainTiles() const
+{
+	return static_cast<int32_t>(allTerrainTiles.size());
+}
@@ -12,6 +12,7 @@
 
 #include "../../layer2/ground/Ground.h"
 #include "../../layer2/material/SurfaceMaterial.h"
+#include "../../layer3/terrain/TerrainQuadtree.h"
 #include "../../layer7/entity/GeneralEntity.h"
 
 class GroundEntity : public GeneralEntity
@@ -33,6 +34,12 @@ private:
 
 	SurfaceMaterialSP surfaceMaterial;
 
+	TerrainQuadtreeSP terrainQuadtree;
+
+	mutable std::vector<TerrainTile> allTerrainTiles;
+
+	void renderTerrainTiles(const ProgramSP& currentProgram) const;
+
 public:
 
 	GroundEntity(const std::string& name, const GroundSP& ground, const SurfaceMaterialSP& surfaceMaterial, float scaleX, float scaleY, float scaleZ);
@@ -66,6 +73,18 @@ public:
 
 	void setScreenDistance(float screenDistance);
 
+	const TerrainQuadtreeSP& getTerrainQuadtree() const;
+
+	/**
+	 * The ground has to be a terrain tile. Then the tiles selected by the quadtree are drawn instead of the whole grid.
+	 */
+	void setTerrainQuadtree(const TerrainQuadtreeSP& terrainQuadtree);
+
+	/**
+	 * @return Number of tiles drawn by the last render.
+	 */
+	std::int32_t getNumberTerrainTiles() const;
+
 };
 
 typedef std::shared_ptr<GroundEntity> GroundEntitySP;
@@ -8,12 +8,15 @@
 
 #include "../../layer1/shader/ProgramManager.h"
 #include "../../layer1/event/EventManager.h"
+#include "../../layer1/shader/RenderStateCache.h"
+#include "../../layer1/texture/TextureStreamingManager.h"
 #include "../../layer2/debug/DebugDraw.h"
 #include "../../layer2/environment/SkyManager.h"
 #include "../../layer2/material/RefractiveIndices.h"
 #include "../../layer3/camera/CameraManager.h"
 #include "../../layer3/light/LightManager.h"
 #include "../../layer4/shader/ProgramManagerProxy.h"
+#include "../../layer5/render/RenderQueue.h"
 
 #include "ModelEntity.h"
 
@@ -30,7 +33,7 @@ int32_t ModelEntity::getNumberJoints() const
 }
 
 ModelEntity::ModelEntity(const string& name, const ModelSP& model, float scaleX, float scaleY, float scaleZ) :
-		GeneralEntity(name, scaleX, scaleY, scaleZ), NodeOwner(), model(model), time(0.0f), animStackIndex(-1), animLayerIndex(-1), rootInstanceNode(), jointIndex(-1), dirty(true), ambientLightColor()
+		GeneralEntity(name, scaleX, scaleY, scaleZ), NodeOwner(), model(model), time(0.0f), animStackIndex(-1), animLayerIndex(-1), rootInstanceNode(), jointIndex(-1), dirty(true), ambientLightColor(), lodThreshold(0.0f), animatedMaterialBuffer()
 {
 	float maxScale = glusMathMaxf(scaleX, scaleY);
 	maxScale = glusMathMaxf(maxScale, scaleZ);
@@ -144,7 +147,11 @@ InstanceNodeSP ModelEntity::findInstanceNodeRecursive(const string& name) const
 
 ModelEntitySP ModelEntity::getNewInstance(const string& name) const
 {
-	return ModelEntitySP(new ModelEntity(name, model, getScaleX(), getScaleY(), getScaleZ()));
+	ModelEntitySP modelEntity = ModelEntitySP(new ModelEntity(name, model, getScaleX(), getScaleY(), getScaleZ()));
+
+	modelEntity->setLodThreshold(lodThreshold);
+
+	return modelEntity;
 }
 
 void ModelEntity::renderNode(const Node& node, const InstanceNode& instanceNode, float time, int32_t animStackIndex, int32_t animLayerIndex) const
@@ -166,7 +173,9 @@ void ModelEntity::renderNode(const Node& node, const InstanceNode& instanceNode,
 		}
 	}
 
-	if (isWireframe())
+	bool queued = RenderQueue::getInstance()->isRecording();
+
+	if (isWireframe() && !queued)
 	{
 		glPolygonMode(GL_FRONT_AND_BACK, GL_LINE);
 	}
@@ -174,12 +183,51 @@ void ModelEntity::renderNode(const Node& node, const InstanceNode& instanceNode,
 	if (node.getMesh().get() && renderMesh)
 	{
 		VAOSP currentVAO;
-		ProgramSP currentProgram;
 		SubMeshSP currentSubMesh;
 		SurfaceMaterialSP currentSurfaceMaterial;
 
+		// Screen size based selection: the allowed error grows with the distance to the camera.
+		float allowedLodError = 0.0f;
+
+		if (lodThreshold > 0.0f && Entity::getCurrentCamera().get())
+		{
+			float maxScale = glusMathMaxf(glusMathMaxf(getScaleX(), getScaleY()), getScaleZ());
+
+			allowedLodError = lodThreshold * Entity::getCurrentCamera()->distanceToCamera(getBoundingSphere()) / maxScale;
+		}
+
+		// Approximated diameter in pixels on the screen as the feedback for the texture streaming.
+		float screenResolution = 0.0f;
+
+		if (TextureStreamingManager::getInstance()->getNumberTextures() > 0 && Entity::getCurrentCamera().get())
+		{
+			const CameraSP& currentCamera = Entity::getCurrentCamera();
+
+			float radius = getBoundingSphere().getRadius();
+
+			screenResolution = radius * currentCamera->getProjectionMatrix().getM()[5] * static_cast<float>(currentCamera->getViewport().getHeight()) / glusMathMaxf(currentCamera->distanceToCamera(getBoundingSphere()), radius);
+		}
+
+		// Normalized distance for the sort key of the render queue.
+		float depth = 0.0f;
+
+		if (queued && Entity::getCurrentCamera().get() && Entity::getCurrentCamera()->getFarZ() > 0.0f)
+		{
+			depth = Entity::getCurrentCamera()->distanceToCamera(getBoundingSphere()) / Entity::getCurrentCamera()->getFarZ();
+		}
+
+		// Skinned meshes and animated materials depend on per entity data, which can not be passed per instance.
+		uint64_t instanceGroup = 0;
+
 		const std::vector<std::shared_ptr<AnimationStack> >& allAnimStacks = node.getAllAnimStacks();
 
+		bool animatedMaterial = animStackIndex >= 0 && animLayerIndex >= 0 && static_cast<decltype(allAnimStacks.size())>(animStackIndex) < allAnimStacks.size();
+
+		if (queued && !node.getMesh()->hasSkinning() && !animatedMaterial && !isWireframe())
+		{
+			instanceGroup = getInstanceGroup();
+		}
+
 		for (uint32_t subMeshIndex = 0; subMeshIndex < node.getMesh()->getSubMeshesCount(); subMeshIndex++)
 		{
 			currentSubMesh = node.getMesh()->getSubMeshAt(subMeshIndex);
@@ -191,292 +239,319 @@ void ModelEntity::renderNode(const Node& node, const InstanceNode& instanceNode,
 
 			currentSurfaceMaterial = node.getMesh()->getSurfaceMaterialAt(subMeshIndex);
 
-			float currentEmissive[4] = { 0.0f, 0.0f, 0.0f, 1.0f };
-			float currentAmbient[4] = { 0.0f, 0.0f, 0.0f, 1.0f };
-			float currentDiffuse[4] = { 0.0f, 0.0f, 0.0f, 1.0f };
-			float currentSpecular[4] = { 0.0f, 0.0f, 0.0f, 1.0f };
-			float currentReflection[4] = { 0.0f, 0.0f, 0.0f, 1.0f };
-			float currentRefraction[4] = { 0.0f, 0.0f, 0.0f, 1.0f };
-			float currentShininess = 0.0f;
-			float currentTransparency = 0.0f;
+			uint32_t lod = currentSubMesh->selectLod(allowedLodError);
 
-			for (int32_t i = 0; i < 4; i++)
+			if (screenResolution > 0.0f)
 			{
-				currentEmissive[i] = currentSurfaceMaterial->getEmissive().getRGBA()[i];
-				currentAmbient[i] = currentSurfaceMaterial->getAmbient().getRGBA()[i];
-				currentDiffuse[i] = currentSurfaceMaterial->getDiffuse().getRGBA()[i];
-				currentSpecular[i] = currentSurfaceMaterial->getSpecular().getRGBA()[i];
-				currentReflection[i] = currentSurfaceMaterial->getReflection().getRGBA()[i];
-				currentRefraction[i] = currentSurfaceMaterial->getRefraction().getRGBA()[i];
+				currentSurfaceMaterial->requestResolution(screenResolution);
 			}
-			currentShininess = currentSurfaceMaterial->getShininess();
-			currentTransparency = currentSurfaceMaterial->getTransparency();
 
-			if (animStackIndex >= 0 && animLayerIndex >= 0 && static_cast<decltype(allAnimStacks.size())>(animStackIndex) < allAnimStacks.size() && animLayerIndex < allAnimStacks[animStackIndex]->getAnimationLayersCount())
+			if (queued)
 			{
-				// Animate values depending on time
-				const AnimationLayerSP& animLayer = allAnimStacks[animStackIndex]->getAnimationLayer(animLayerIndex);
-
-				for (enum AnimationLayer::eCHANNELS_RGBA i = AnimationLayer::R; i <= AnimationLayer::A;
-						i = static_cast<enum AnimationLayer::eCHANNELS_RGBA>(i + 1))
-				{
-					if (animLayer->hasEmissiveColorValue(i))
-					{
-						currentEmissive[i] = animLayer->getEmissiveColorValue(i, time);
-					}
-					if (animLayer->hasAmbientColorValue(i))
-					{
-						currentAmbient[i] = animLayer->getAmbientColorValue(i, time);
-					}
-					if (animLayer->hasDiffuseColorValue(i))
-					{
-						currentDiffuse[i] = animLayer->getDiffuseColorValue(i, time);
-					}
-					if (animLayer->hasSpecularColorValue(i))
-					{
-						currentSpecular[i] = animLayer->getSpecularColorValue(i, time);
-					}
-					if (animLayer->hasReflectionColorValue(i))
-					{
-						currentReflection[i] = animLayer->getReflectionColorValue(i, time);
-					}
-					if (animLayer->hasRefractionColorValue(i))
-					{
-						currentRefraction[i] = animLayer->getRefractionColorValue(i, time);
-					}
-				}
-
-				if (animLayer->hasShininessValue(AnimationLayer::S))
-				{
-					currentShininess = animLayer->getShininessValue(AnimationLayer::S, time);
-				}
-				if (animLayer->hasTransparencyValue(AnimationLayer::S))
-				{
-					currentTransparency = animLayer->getTransparencyValue(AnimationLayer::S, time);
-				}
+				currentVAO = currentSubMesh->getVAOByProgramType(getCurrentProgramType());
+
+				uint64_t key = RenderQueue::createKey(finalTransparent, currentVAO->getProgram()->getProgramName(), currentSurfaceMaterial->getDiffuseTextureBindingName(), currentVAO->getVAOName(), lod, depth);
+
+				RenderQueue::getInstance()->addPacket(key, RenderPacket(this, &node, &instanceNode, subMeshIndex, lod, time, animStackIndex, animLayerIndex, finalTransparent, instanceGroup));
+
+				continue;
 			}
 
-			currentVAO = currentSubMesh->getVAOByProgramType(getCurrentProgramType());
+			renderSubMesh(node, instanceNode, subMeshIndex, lod, time, animStackIndex, animLayerIndex, finalTransparent);
 
-			currentProgram = currentVAO->getProgram();
+			currentSurfaceMaterial->getTextureBindingSet().unbind();
 
-			currentProgram->use();
+			if (SkyManager::getInstance()->hasActiveSky())
+			{
+				RenderStateCache::getInstance()->bindTexture(GL_TEXTURE3, GL_TEXTURE_CUBE_MAP, 0);
+			}
 
-			glUniformMatrix4fv(currentProgram->getUniformLocation(u_modelMatrix), 1, GL_FALSE, instanceNode.getModelMatrix().getM());
+			if (currentSurfaceMaterial->getDynamicCubeMapTexture() != 0)
+			{
+				RenderStateCache::getInstance()->bindTexture(GL_TEXTURE4, GL_TEXTURE_CUBE_MAP, 0);
+			}
 
-			// We have the inverse and transpose by setting the matrix
-			glUniformMatrix3fv(currentProgram->getUniformLocation(u_normalModelMatrix), 1, GL_TRUE, instanceNode.getNormalModelMatrix().getM());
+			glActiveTexture(GL_TEXTURE0);
 
-			currentVAO->bind();
+			RenderStateCache::getInstance()->bindVertexArray(0);
+		}
+	}
 
-			glUniform4fv(currentProgram->getUniformLocation(u_emissiveColor), 1, currentEmissive);
-			glUniform4fv(currentProgram->getUniformLocation(u_ambientColor), 1, currentAmbient);
+	if (isWireframe() && !queued)
+	{
+		glPolygonMode(GL_FRONT_AND_BACK, GL_FILL);
+	}
+}
 
-			if (currentSurfaceMaterial->getDiffuseTextureName() != 0)
-			{
-				glUniform1i(currentProgram->getUniformLocation(u_hasDiffuseTexture), 1);
+void ModelEntity::renderPacket(const RenderPacket& renderPacket) const
+{
+	if (isWireframe())
+	{
+		glPolygonMode(GL_FRONT_AND_BACK, GL_LINE);
+	}
 
-				glActiveTexture(GL_TEXTURE0);
-				glBindTexture(GL_TEXTURE_2D, currentSurfaceMaterial->getDiffuseTextureName());
-				glUniform1i(currentProgram->getUniformLocation(u_diffuseTexture), 0);
-			}
-			else
-			{
-				glUniform1i(currentProgram->getUniformLocation(u_hasDiffuseTexture), 0);
+	renderSubMesh(renderPacket.getNode(), renderPacket.getInstanceNode(), renderPacket.getSubMeshIndex(), renderPacket.getLod(), renderPacket.getTime(), renderPacket.getAnimStackIndex(), renderPacket.getAnimLayerIndex(), renderPacket.isTransparent());
 
-				glActiveTexture(GL_TEXTURE0);
-				glBindTexture(GL_TEXTURE_2D, 0);
-				glUniform1i(currentProgram->getUniformLocation(u_diffuseTexture), 0);
-			}
-			glUniform4fv(currentProgram->getUniformLocation(u_diffuseColor), 1, currentDiffuse);
+	if (isWireframe())
+	{
+		glPolygonMode(GL_FRONT_AND_BACK, GL_FILL);
+	}
+}
 
-			if (currentSurfaceMaterial->getSpecularTextureName() != 0)
-			{
-				glUniform1i(currentProgram->getUniformLocation(u_hasSpecularTexture), 1);
+void ModelEntity::renderPacketInstanced(const RenderPacket& renderPacket, InstanceBuffer& instanceBuffer) const
+{
+	renderSubMesh(renderPacket.getNode(), renderPacket.getInstanceNode(), renderPacket.getSubMeshIndex(), renderPacket.getLod(), renderPacket.getTime(), renderPacket.getAnimStackIndex(), renderPacket.getAnimLayerIndex(), renderPacket.isTransparent(), &instanceBuffer);
+}
 
-				glActiveTexture(GL_TEXTURE1);
-				glBindTexture(GL_TEXTURE_2D, currentSurfaceMaterial->getSpecularTextureName());
-				glUniform1i(currentProgram->getUniformLocation(u_specularTexture), 1);
-			}
-			else
-			{
-				glUniform1i(currentProgram->getUniformLocation(u_hasSpecularTexture), 0);
+uint64_t ModelEntity::getInstanceGroup() const
+{
+	uint32_t bits[3] = { writeBrightColor ? 1u : 0u, 0, 0 };
 
-				glActiveTexture(GL_TEXTURE1);
-				glBindTexture(GL_TEXTURE_2D, 0);
-				glUniform1i(currentProgram->getUniformLocation(u_specularTexture), 0);
-			}
-			glUniform4fv(currentProgram->getUniformLocation(u_specularColor), 1, currentSpecular);
-			glUniform1f(currentProgram->getUniformLocation(u_shininess), currentShininess);
+	memcpy(&bits[1], &brightColorLimit, sizeof(float));
+	memcpy(&bits[2], &refractiveIndex, sizeof(float));
 
-			glUniform1f(currentProgram->getUniformLocation(u_transparency), currentTransparency);
+	// FNV-1a over the entity state used by the shader. Zero is reserved for not instanceable.
+	uint64_t hash = 14695981039346656037ull;
+	for (int32_t i = 0; i < 3; i++)
+	{
+		hash ^= bits[i];
+		hash *= 1099511628211ull;
+	}
 
-			if (currentSurfaceMaterial->getNormalMapTextureName() != 0)
-			{
-				glUniform1i(currentProgram->getUniformLocation(u_hasNormalMapTexture), 1);
+	return hash ? hash : 1;
+}
 
-				glActiveTexture(GL_TEXTURE2);
-				glBindTexture(GL_TEXTURE_2D, currentSurfaceMaterial->getNormalMapTextureName());
-				glUniform1i(currentProgram->getUniformLocation(u_normalMapTexture), 2);
-				glActiveTexture(GL_TEXTURE0);
-			}
-			else
-			{
-				glUniform1i(currentProgram->getUniformLocation(u_hasNormalMapTexture), 0);
+void ModelEntity::renderSubMesh(const Node& node, const InstanceNode& instanceNode, uint32_t subMeshIndex, uint32_t lod, float time, int32_t animStackIndex, int32_t animLayerIndex, bool finalTransparent, InstanceBuffer* instanceBuffer) const
+{
+	SubMeshSP currentSubMesh = node.getMesh()->getSubMeshAt(subMeshIndex);
+	SurfaceMaterialSP currentSurfaceMaterial;
+	VAOSP currentVAO;
+	ProgramSP currentProgram;
 
-				glActiveTexture(GL_TEXTURE2);
-				glBindTexture(GL_TEXTURE_2D, 0);
-				glUniform1i(currentProgram->getUniformLocation(u_normalMapTexture), 2);
-				glActiveTexture(GL_TEXTURE0);
-			}
+	const std::vector<std::shared_ptr<AnimationStack> >& allAnimStacks = node.getAllAnimStacks();
 
-			glUniform1i(currentProgram->getUniformLocation(u_convertDirectX), currentSurfaceMaterial->isConvertDirectX());
+	currentSurfaceMaterial = node.getMesh()->getSurfaceMaterialAt(subMeshIndex);
 
-			glUniform4fv(currentProgram->getUniformLocation(u_reflectionColor), 1, currentReflection);
-			glUniform4fv(currentProgram->getUniformLocation(u_refractionColor), 1, currentRefraction);
+	// Only rebuilds, if the material has been changed.
+	currentSurfaceMaterial->updateUniformBlock();
 
-			float environmentRefractiveIndex = refractiveIndex;
+	GLuint currentMaterialBuffer = currentSurfaceMaterial->getUniformBuffer()->getUniformBufferName();
 
-			if (environmentRefractiveIndex != RI_NOTHING)
-			{
-				float materialRefractiveIndex = currentSurfaceMaterial->getRefractiveIndex();
+	if (animStackIndex >= 0 && animLayerIndex >= 0 && static_cast<decltype(allAnimStacks.size())>(animStackIndex) < allAnimStacks.size() && animLayerIndex < allAnimStacks[animStackIndex]->getAnimationLayersCount())
+	{
+		// Animate values depending on time
+		const AnimationLayerSP& animLayer = allAnimStacks[animStackIndex]->getAnimationLayer(animLayerIndex);
 
-				float eta = environmentRefractiveIndex / materialRefractiveIndex;
+		GLfloat animatedBlock[SurfaceMaterial::UNIFORM_BLOCK_FLOATS];
+		memcpy(animatedBlock, currentSurfaceMaterial->getUniformBlock(), sizeof(animatedBlock));
 
-				float reflectanceNormalIncidence = ((environmentRefractiveIndex - materialRefractiveIndex) * (environmentRefractiveIndex - materialRefractiveIndex)) / ((environmentRefractiveIndex + materialRefractiveIndex) * (environmentRefractiveIndex + materialRefractiveIndex));
+		bool animated = false;
 
-				glUniform1f(currentProgram->getUniformLocation(u_eta), eta);
-				glUniform1f(currentProgram->getUniformLocation(u_reflectanceNormalIncidence), reflectanceNormalIncidence);
+		for (enum AnimationLayer::eCHANNELS_RGBA i = AnimationLayer::R; i <= AnimationLayer::A;
+				i = static_cast<enum AnimationLayer::eCHANNELS_RGBA>(i + 1))
+		{
+			if (animLayer->hasEmissiveColorValue(i))
+			{
+				animatedBlock[SurfaceMaterial::EMISSIVE_OFFSET + i] = animLayer->getEmissiveColorValue(i, time);
+				animated = true;
 			}
-			else
+			if (animLayer->hasAmbientColorValue(i))
 			{
-				glUniform1f(currentProgram->getUniformLocation(u_eta), 0.0f);
-				glUniform1f(currentProgram->getUniformLocation(u_reflectanceNormalIncidence), 0.0f);
+				animatedBlock[SurfaceMaterial::AMBIENT_OFFSET + i] = animLayer->getAmbientColorValue(i, time);
+				animated = true;
 			}
-
-			if (SkyManager::getInstance()->hasActiveSky())
+			if (animLayer->hasDiffuseColorValue(i))
 			{
-				glUniform1i(currentProgram->getUniformLocation(u_hasCubeMapTexture), 1);
-
-				SkySP activeSky = SkyManager::getInstance()->getActiveSky();
-
-				glActiveTexture(GL_TEXTURE3);
-				glBindTexture(GL_TEXTURE_CUBE_MAP, activeSky->getSkyTextureName());
-				glUniform1i(currentProgram->getUniformLocation(u_cubemap), 3);
-				glActiveTexture(GL_TEXTURE0);
+				animatedBlock[SurfaceMaterial::DIFFUSE_OFFSET + i] = animLayer->getDiffuseColorValue(i, time);
+				animated = true;
 			}
-			else
+			if (animLayer->hasSpecularColorValue(i))
 			{
-				glUniform1i(currentProgram->getUniformLocation(u_hasCubeMapTexture), 0);
-
-				glActiveTexture(GL_TEXTURE3);
-				glBindTexture(GL_TEXTURE_CUBE_MAP, 0);
-				glUniform1i(currentProgram->getUniformLocation(u_cubemap), 3);
-				glActiveTexture(GL_TEXTURE0);
+				animatedBlock[SurfaceMaterial::SPECULAR_OFFSET + i] = animLayer->getSpecularColorValue(i, time);
+				animated = true;
 			}
-
-			// Only allow dynamic cube map, if also a sky cube map is available
-			if (Entity::getDynamicCubeMaps() && currentSurfaceMaterial->getDynamicCubeMapTextureName() != 0 && SkyManager::getInstance()->hasActiveSky())
+			if (animLayer->hasReflectionColorValue(i))
 			{
-				glUniform1i(currentProgram->getUniformLocation(u_hasDynamicCubeMapTexture), 1);
-				glActiveTexture(GL_TEXTURE4);
-				glBindTexture(GL_TEXTURE_CUBE_MAP, currentSurfaceMaterial->getDynamicCubeMapTextureName());
-				glUniform1i(currentProgram->getUniformLocation(u_dynamicCubeMapTexture), 4);
-				glActiveTexture(GL_TEXTURE0);
+				animatedBlock[SurfaceMaterial::REFLECTION_OFFSET + i] = animLayer->getReflectionColorValue(i, time);
+				animated = true;
 			}
-			else
+			if (animLayer->hasRefractionColorValue(i))
 			{
-				glUniform1i(currentProgram->getUniformLocation(u_hasDynamicCubeMapTexture), 0);
-				glActiveTexture(GL_TEXTURE4);
-				glBindTexture(GL_TEXTURE_CUBE_MAP, 0);
-				glUniform1i(currentProgram->getUniformLocation(u_dynamicCubeMapTexture), 4);
-				glActiveTexture(GL_TEXTURE0);
+				animatedBlock[SurfaceMaterial::REFRACTION_OFFSET + i] = animLayer->getRefractionColorValue(i, time);
+				animated = true;
 			}
+		}
+
+		if (animLayer->hasShininessValue(AnimationLayer::S))
+		{
+			animatedBlock[SurfaceMaterial::SHININESS_OFFSET] = animLayer->getShininessValue(AnimationLayer::S, time);
+			animated = true;
+		}
+		if (animLayer->hasTransparencyValue(AnimationLayer::S))
+		{
+			animatedBlock[SurfaceMaterial::TRANSPARENCY_OFFSET] = animLayer->getTransparencyValue(AnimationLayer::S, time);
+			animated = true;
+		}
 
-			if (!Entity::getDynamicCubeMaps())
+		// The shared material block must not be modified, so animated values go into an own block of this entity.
+		if (animated)
+		{
+			if (!animatedMaterialBuffer.get())
 			{
-				glUniformMatrix4fv(currentProgram->getUniformLocation(u_cubeMapViewMatrix), 6, GL_FALSE, Entity::getCubeMapViewMatrices()[0].getM());
-				glUniformMatrix4fv(currentProgram->getUniformLocation(u_cubeMapProjectionMatrix), 1, GL_FALSE, Entity::getCubeMapProjectionMatrix().getM());
+				animatedMaterialBuffer = UniformBufferSP(new UniformBuffer(SurfaceMaterial::UNIFORM_BLOCK_FLOATS * sizeof(GLfloat)));
 			}
+			animatedMaterialBuffer->update(animatedBlock);
 
-			// Skinning
-			if (node.getMesh()->hasSkinning())
-			{
-				glUniform1i(currentProgram->getUniformLocation(u_hasSkinning), 1);
+			currentMaterialBuffer = animatedMaterialBuffer->getUniformBufferName();
+		}
+	}
 
-				glUniformMatrix4fv(currentProgram->getUniformLocation(u_bindMatrix), model->getNumberJoints(), GL_FALSE, bindMatrices[0].getM());
-				glUniformMatrix3fv(currentProgram->getUniformLocation(u_bindNormalMatrix), model->getNumberJoints(), GL_TRUE, bindNormalMatrices[0].getM());
+	currentVAO = currentSubMesh->getVAOByProgramType(getCurrentProgramType());
 
-				glUniformMatrix4fv(currentProgram->getUniformLocation(u_inverseBindMatrix), model->getNumberJoints(), GL_FALSE, inverseBindMatrices[0].getM());
-				glUniformMatrix3fv(currentProgram->getUniformLocation(u_inverseBindNormalMatrix), model->getNumberJoints(), GL_TRUE, inverseBindNormalMatrices[0].getM());
-			}
-			else
-			{
-				glUniform1i(currentProgram->getUniformLocation(u_hasSkinning), 0);
+	currentProgram = currentVAO->getProgram();
 
-				glUniformMatrix4fv(currentProgram->getUniformLocation(u_bindMatrix), model->getNumberJoints(), GL_FALSE, Matrix4x4().getM());
-				glUniformMatrix3fv(currentProgram->getUniformLocation(u_bindNormalMatrix), model->getNumberJoints(), GL_TRUE, Matrix3x3().getM());
+	if (RenderStateCache::getInstance()->useProgram(currentProgram))
+	{
+		// Constant per program
+		currentProgram->setUniformBlockBinding(u_materialBlock, MATERIAL_BLOCK_BINDING);
+
+		glUniform1i(currentProgram->getUniformLocation(u_diffuseTexture), 0);
+		glUniform1i(currentProgram->getUniformLocation(u_specularTexture), 1);
+		glUniform1i(currentProgram->getUniformLocation(u_normalMapTexture), 2);
+		glUniform1i(currentProgram->getUniformLocation(u_cubemap), 3);
+		glUniform1i(currentProgram->getUniformLocation(u_dynamicCubeMapTexture), 4);
+		glUniform1i(currentProgram->getUniformLocation(u_diffusePackedTexture), PACKED_TEXTURE_UNIT + SurfaceMaterial::PACKED_DIFFUSE);
+		glUniform1i(currentProgram->getUniformLocation(u_specularPackedTexture), PACKED_TEXTURE_UNIT + SurfaceMaterial::PACKED_SPECULAR);
+		glUniform1i(currentProgram->getUniformLocation(u_normalMapPackedTexture), PACKED_TEXTURE_UNIT + SurfaceMaterial::PACKED_NORMAL_MAP);
+	}
 
-				glUniformMatrix4fv(currentProgram->getUniformLocation(u_inverseBindMatrix), model->getNumberJoints(), GL_FALSE, Matrix4x4().getM());
-				glUniformMatrix3fv(currentProgram->getUniformLocation(u_inverseBindNormalMatrix), model->getNumberJoints(), GL_TRUE, Matrix3x3().getM());
-			}
+	glUniformMatrix4fv(currentProgram->getUniformLocation(u_modelMatrix), 1, GL_FALSE, instanceNode.getModelMatrix().getM());
 
-			// Write bright color
-			glUniform1i(currentProgram->getUniformLocation(u_writeBrightColor), writeBrightColor);
-			glUniform1f(currentProgram->getUniformLocation(u_brightColorLimit), brightColorLimit);
+	// We have the inverse and transpose by setting the matrix
+	glUniformMatrix3fv(currentProgram->getUniformLocation(u_normalModelMatrix), 1, GL_TRUE, instanceNode.getNormalModelMatrix().getM());
 
-			if (finalTransparent)
-			{
-				glEnable(GL_BLEND);
-				glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
-			}
+	RenderStateCache::getInstance()->bindVertexArray(currentVAO->getVAOName());
 
-			glDrawElements(GL_TRIANGLES, currentSubMesh->getTriangleCount() * 3, GL_UNSIGNED_INT, reinterpret_cast<const GLvoid *>(currentSubMesh->getIndicesOffset() * sizeof(uint32_t)));
+	glUniform1i(currentProgram->getUniformLocation(u_hasInstancing), instanceBuffer != nullptr);
+	glUniform1i(currentProgram->getUniformLocation(u_hasOctahedralNormals), node.getMesh()->isPacked());
 
-			if (finalTransparent)
-			{
-				glDisable(GL_BLEND);
-			}
+	RenderStateCache::getInstance()->bindUniformBuffer(MATERIAL_BLOCK_BINDING, currentMaterialBuffer);
 
-			if (currentSurfaceMaterial->getDiffuseTextureName() != 0)
-			{
-				glActiveTexture(GL_TEXTURE0);
-				glBindTexture(GL_TEXTURE_2D, 0);
-			}
+	currentSurfaceMaterial->getTextureBindingSet().bind();
 
-			if (currentSurfaceMaterial->getSpecularTextureName() != 0)
-			{
-				glActiveTexture(GL_TEXTURE1);
-				glBindTexture(GL_TEXTURE_2D, 0);
-			}
+	glUniform1i(currentProgram->getUniformLocation(u_hasDiffuseTexture), currentSurfaceMaterial->getDiffuseTextureName() != 0);
+	glUniform1i(currentProgram->getUniformLocation(u_hasSpecularTexture), currentSurfaceMaterial->getSpecularTextureName() != 0);
+	glUniform1i(currentProgram->getUniformLocation(u_hasNormalMapTexture), currentSurfaceMaterial->getNormalMapTextureName() != 0);
 
-			if (currentSurfaceMaterial->getNormalMapTextureName() != 0)
-			{
-				glActiveTexture(GL_TEXTURE2);
-				glBindTexture(GL_TEXTURE_2D, 0);
-			}
+	glUniform1iv(currentProgram->getUniformLocation(u_packedLayer), SurfaceMaterial::PACKED_TEXTURES, currentSurfaceMaterial->getPackedLayers());
+	glUniform4fv(currentProgram->getUniformLocation(u_packedRegion), SurfaceMaterial::PACKED_TEXTURES, currentSurfaceMaterial->getPackedRegions());
 
-			if (SkyManager::getInstance()->hasActiveSky())
-			{
-				glActiveTexture(GL_TEXTURE3);
-				glBindTexture(GL_TEXTURE_CUBE_MAP, 0);
-			}
+	glUniform1i(currentProgram->getUniformLocation(u_convertDirectX), currentSurfaceMaterial->isConvertDirectX());
 
-			if (currentSurfaceMaterial->getDynamicCubeMapTexture() != 0)
-			{
-				glActiveTexture(GL_TEXTURE4);
-				glBindTexture(GL_TEXTURE_CUBE_MAP, 0);
-			}
+	float environmentRefractiveIndex = refractiveIndex;
 
-			glActiveTexture(GL_TEXTURE0);
+	if (environmentRefractiveIndex != RI_NOTHING)
+	{
+		float materialRefractiveIndex = currentSurfaceMaterial->getRefractiveIndex();
 
-			currentVAO->unbind();
-		}
+		float eta = environmentRefractiveIndex / materialRefractiveIndex;
+
+		float reflectanceNormalIncidence = ((environmentRefractiveIndex - materialRefractiveIndex) * (environmentRefractiveIndex - materialRefractiveIndex)) / ((environmentRefractiveIndex + materialRefractiveIndex) * (environmentRefractiveIndex + materialRefractiveIndex));
+
+		glUniform1f(currentProgram->getUniformLocation(u_eta), eta);
+		glUniform1f(currentProgram->getUniformLocation(u_reflectanceNormalIncidence), reflectanceNormalIncidence);
+	}
+	else
+	{
+		glUniform1f(currentProgram->getUniformLocation(u_eta), 0.0f);
+		glUniform1f(currentProgram->getUniformLocation(u_reflectanceNormalIncidence), 0.0f);
 	}
 
-	if (isWireframe())
+	if (SkyManager::getInstance()->hasActiveSky())
 	{
-		glPolygonMode(GL_FRONT_AND_BACK, GL_FILL);
+		glUniform1i(currentProgram->getUniformLocation(u_hasCubeMapTexture), 1);
+
+		SkySP activeSky = SkyManager::getInstance()->getActiveSky();
+
+		RenderStateCache::getInstance()->bindTexture(GL_TEXTURE3, GL_TEXTURE_CUBE_MAP, activeSky->getSkyTextureName());
+	}
+	else
+	{
+		glUniform1i(currentProgram->getUniformLocation(u_hasCubeMapTexture), 0);
+
+		RenderStateCache::getInstance()->bindTexture(GL_TEXTURE3, GL_TEXTURE_CUBE_MAP, 0);
+	}
+
+	// Only allow dynamic cube map, if also a sky cube map is available
+	if (Entity::getDynamicCubeMaps() && currentSurfaceMaterial->getDynamicCubeMapTextureName() != 0 && SkyManager::getInstance()->hasActiveSky())
+	{
+		glUniform1i(currentProgram->getUniformLocation(u_hasDynamicCubeMapTexture), 1);
+		RenderStateCache::getInstance()->bindTexture(GL_TEXTURE4, GL_TEXTURE_CUBE_MAP, currentSurfaceMaterial->getDynamicCubeMapTextureName());
+	}
+	else
+	{
+		glUniform1i(currentProgram->getUniformLocation(u_hasDynamicCubeMapTexture), 0);
+		RenderStateCache::getInstance()->bindTexture(GL_TEXTURE4, GL_TEXTURE_CUBE_MAP, 0);
+	}
+
+	if (!Entity::getDynamicCubeMaps())
+	{
+		glUniformMatrix4fv(currentProgram->getUniformLocation(u_cubeMapViewMatrix), 6, GL_FALSE, Entity::getCubeMapViewMatrices()[0].getM());
+		glUniformMatrix4fv(currentProgram->getUniformLocation(u_cubeMapProjectionMatrix), 1, GL_FALSE, Entity::getCubeMapProjectionMatrix().getM());
+		glUniform1i(currentProgram->getUniformLocation(u_cubeMapFaceMask), Entity::getCubeMapFaceMask());
+	}
+
+	// Skinning
+	if (node.getMesh()->hasSkinning())
+	{
+		glUniform1i(currentProgram->getUniformLocation(u_hasSkinning), 1);
+
+		glUniformMatrix4fv(currentProgram->getUniformLocation(u_bindMatrix), model->getNumberJoints(), GL_FALSE, bindMatrices[0].getM());
+		glUniformMatrix3fv(currentProgram->getUniformLocation(u_bindNormalMatrix), model->getNumberJoints(), GL_TRUE, bindNormalMatrices[0].getM());
+
+		glUniformMatrix4fv(currentProgram->getUniformLocation(u_inverseBindMatrix), model->getNumberJoints(), GL_FALSE, inverseBindMatrices[0].getM());
+		glUniformMatrix3fv(currentProgram->getUniformLocation(u_inverseBindNormalMatrix), model->getNumberJoints(), GL_TRUE, inverseBindNormalMatrices[0].getM());
+	}
+	else
+	{
+		glUniform1i(currentProgram->getUniformLocation(u_hasSkinning), 0);
+
+		glUniformMatrix4fv(currentProgram->getUniformLocation(u_bindMatrix), model->getNumberJoints(), GL_FALSE, Matrix4x4().getM());
+		glUniformMatrix3fv(currentProgram->getUniformLocation(u_bindNormalMatrix), model->getNumberJoints(), GL_TRUE, Matrix3x3().getM());
+
+		glUniformMatrix4fv(currentProgram->getUniformLocation(u_inverseBindMatrix), model->getNumberJoints(), GL_FALSE, Matrix4x4().getM());
+		glUniformMatrix3fv(currentProgram->getUniformLocation(u_inverseBindNormalMatrix), model->getNumberJoints(), GL_TRUE, Matrix3x3().getM());
+	}
+
+	// Write bright color
+	glUniform1i(currentProgram->getUniformLocation(u_writeBrightColor), writeBrightColor);
+	glUniform1f(currentProgram->getUniformLocation(u_brightColorLimit), brightColorLimit);
+
+	if (finalTransparent)
+	{
+		glEnable(GL_BLEND);
+		glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+	}
+
+	if (instanceBuffer)
+	{
+		GLint instanceLocation = currentProgram->getAttribLocation(a_instanceModelMatrix);
+
+		instanceBuffer->upload();
+		instanceBuffer->enable(instanceLocation);
+
+		RenderStateCache::getInstance()->drawElementsInstanced(GL_TRIANGLES, currentSubMesh->getTriangleCount(lod) * 3, node.getMesh()->getIndexType(), reinterpret_cast<const GLvoid *>(currentSubMesh->getIndicesOffset(lod) * node.getMesh()->getIndexSize()), static_cast<GLsizei>(instanceBuffer->getNumberInstances()));
+
+		instanceBuffer->disable(instanceLocation);
+	}
+	else
+	{
+		RenderStateCache::getInstance()->drawElements(GL_TRIANGLES, currentSubMesh->getTriangleCount(lod) * 3, node.getMesh()->getIndexType(), reinterpret_cast<const GLvoid *>(currentSubMesh->getIndicesOffset(lod) * node.getMesh()->getIndexSize()));
+	}
+
+	if (finalTransparent)
+	{
+		glDisable(GL_BLEND);
 	}
 }
 
@@ -596,7 +671,7 @@ bool ModelEntity::setOrthographicCameraCascadedShadowMap(const string& lightName
 
 		if (instanceNode->getNode()->getName().compare(lightName) == 0)
 		{
-			orthographicCameraCascadedShadowMap2D->getOrthographicCamera(section)->adjustToFrustum(camera->getViewFrustum(), section, instanceNode->getPosition(), instanceNode->getRotation() * baseRotation);
+			orthographicCameraCascadedShadowMap2D->adjustToFrustum(camera->getViewFrustum(), section, instanceNode->getRotation() * baseRotation);
 
 			ProgramManagerProxy::setCameraByType(GeneralEntity::currentProgramType, orthographicCameraCascadedShadowMap2D->getOrthographicCamera(section), Point4(), Quaternion(), false);
 
@@ -653,6 +728,16 @@ void ModelEntity::setAmbientLightColor(const Color& ambientLightColor)
 	this->ambientLightColor = ambientLightColor;
 }
 
+float ModelEntity::getLodThreshold() const
+{
+	return lodThreshold;
+}
+
+void ModelEntity::setLodThreshold(float lodThreshold)
+{
+	this->lodThreshold = glusMathMaxf(lodThreshold, 0.0f);
+}
+
 const Matrix4x4& ModelEntity::getInverseBindMatrix(int32_t index) const
 {
 	return inverseBindMatrices[index];
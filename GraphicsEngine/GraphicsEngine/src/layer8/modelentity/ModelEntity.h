@@ -12,11 +12,14 @@
 
 #include "../../UsedLibs.h"
 
+#include "../../layer1/shader/InstanceBuffer.h"
+#include "../../layer1/shader/UniformBuffer.h"
 #include "../../layer4/shadow/OrthographicCameraCascadedShadowMap2D.h"
 #include "../../layer4/shadow/OrthographicCameraShadowMap2D.h"
 #include "../../layer5/environment/DynamicEnvironment.h"
 #include "../../layer5/node/InstanceNode.h"
 #include "../../layer5/node/NodeOwner.h"
+#include "../../layer5/render/RenderPacket.h"
 #include "../../layer6/model/Model.h"
 #include "../../layer7/entity/GeneralEntity.h"
 
@@ -48,6 +51,14 @@ private:
 
 	Color ambientLightColor;
 
+	float lodThreshold;
+
+	mutable UniformBufferSP animatedMaterialBuffer;
+
+	void renderSubMesh(const Node& node, const InstanceNode& instanceNode, std::uint32_t subMeshIndex, std::uint32_t lod, float time, std::int32_t animStackIndex, std::int32_t animLayerIndex, bool finalTransparent, InstanceBuffer* instanceBuffer = nullptr) const;
+
+	std::uint64_t getInstanceGroup() const;
+
 public:
 
     virtual const std::string& getCurrentProgramType() const;
@@ -75,6 +86,10 @@ public:
 
     virtual void renderNode(const Node& node, const InstanceNode& instanceNode, float time, std::int32_t animStackIndex, std::int32_t animLayerIndex) const;
 
+    virtual void renderPacket(const RenderPacket& renderPacket) const;
+
+    virtual void renderPacketInstanced(const RenderPacket& renderPacket, InstanceBuffer& instanceBuffer) const;
+
     virtual void addLightNode(const InstanceNodeSP& lightNode);
 
     virtual void addCameraNode(const InstanceNodeSP& cameraNode);
@@ -101,6 +116,13 @@ public:
 
 	void setAmbientLightColor(const Color& ambientLightColor);
 
+	float getLodThreshold() const;
+
+	/**
+	 * Allowed geometric error of a level of detail per unit distance to the camera. Zero always renders the full resolution.
+	 */
+	void setLodThreshold(float lodThreshold);
+
 	//
 
 	const Matrix4x4& getInverseBindMatrix(int32_t index) const;
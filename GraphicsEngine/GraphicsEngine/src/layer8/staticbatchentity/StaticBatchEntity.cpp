@@ -0,0 +1,254 @@
+/*
+ * StaticBatchEntity.cpp
+ *
+ *  Created on: 19.10.2026
+ *      Author: nopper
+ */
+
+#include "../../layer1/shader/RenderStateCache.h"
+#include "../../layer1/shader/Variables.h"
+#include "../../layer2/debug/DebugDraw.h"
+#include "../../layer2/environment/Sky.h"
+#include "../../layer2/environment/SkyManager.h"
+
+#include "StaticBatchEntity.h"
+
+using namespace std;
+
+StaticBatchEntity::StaticBatchEntity(const string& name, const vector<StaticBatchSP>& allStaticBatches) :
+		GeneralEntity(name, 1.0f, 1.0f, 1.0f), allStaticBatches(allStaticBatches), transparent(false)
+{
+	Point4 minimum;
+	Point4 maximum;
+
+	auto walker = allStaticBatches.begin();
+	while (walker != allStaticBatches.end())
+	{
+		for (int32_t i = 0; i < 3; i++)
+		{
+			if (walker == allStaticBatches.begin())
+			{
+				minimum[i] = (*walker)->getMinimum().getP()[i];
+				maximum[i] = (*walker)->getMaximum().getP()[i];
+			}
+			else
+			{
+				minimum[i] = glusMathMinf(minimum[i], (*walker)->getMinimum().getP()[i]);
+				maximum[i] = glusMathMaxf(maximum[i], (*walker)->getMaximum().getP()[i]);
+			}
+		}
+
+		walker++;
+	}
+
+	Point4 center = minimum + (maximum - minimum) * 0.5f;
+
+	setBoundingSphere(BoundingSphere(center, center.distance(maximum)));
+
+	setUpdateable(false);
+}
+
+StaticBatchEntity::~StaticBatchEntity()
+{
+	allStaticBatches.clear();
+}
+
+void StaticBatchEntity::updateBoundingSphereCenter(bool /*force*/)
+{
+	// Nothing to do, as the batches are already in world space and the bounding sphere is calculated once.
+}
+
+void StaticBatchEntity::update()
+{
+	// Nothing to do
+}
+
+void StaticBatchEntity::renderStaticBatch(const StaticBatch& staticBatch) const
+{
+	const SurfaceMaterialSP& surfaceMaterial = staticBatch.getSurfaceMaterial();
+
+	if (!staticBatch.containsVAOByProgramType(GeneralEntity::currentProgramType))
+	{
+		return;
+	}
+
+	ProgramSP currentProgram = staticBatch.getVAOByProgramType(GeneralEntity::currentProgramType)->getProgram();
+
+	if (RenderStateCache::getInstance()->useProgram(currentProgram))
+	{
+		// Constant per program
+		currentProgram->setUniformBlockBinding(u_materialBlock, MATERIAL_BLOCK_BINDING);
+
+		glUniform1i(currentProgram->getUniformLocation(u_diffuseTexture), 0);
+		glUniform1i(currentProgram->getUniformLocation(u_specularTexture), 1);
+		glUniform1i(currentProgram->getUniformLocation(u_normalMapTexture), 2);
+		glUniform1i(currentProgram->getUniformLocation(u_cubemap), 3);
+		glUniform1i(currentProgram->getUniformLocation(u_dynamicCubeMapTexture), 4);
+		glUniform1i(currentProgram->getUniformLocation(u_diffusePackedTexture), PACKED_TEXTURE_UNIT + SurfaceMaterial::PACKED_DIFFUSE);
+		glUniform1i(currentProgram->getUniformLocation(u_specularPackedTexture), PACKED_TEXTURE_UNIT + SurfaceMaterial::PACKED_SPECULAR);
+		glUniform1i(currentProgram->getUniformLocation(u_normalMapPackedTexture), PACKED_TEXTURE_UNIT + SurfaceMaterial::PACKED_NORMAL_MAP);
+	}
+
+	// Model matrices are sourced per draw.
+	glUniform1i(currentProgram->getUniformLocation(u_hasInstancing), 1);
+	glUniform1i(currentProgram->getUniformLocation(u_hasOctahedralNormals), 0);
+
+	surfaceMaterial->updateUniformBlock();
+
+	RenderStateCache::getInstance()->bindUniformBuffer(MATERIAL_BLOCK_BINDING, surfaceMaterial->getUniformBuffer()->getUniformBufferName());
+
+	surfaceMaterial->getTextureBindingSet().bind();
+
+	glUniform1i(currentProgram->getUniformLocation(u_hasDiffuseTexture), surfaceMaterial->getDiffuseTextureName() != 0);
+	glUniform1i(currentProgram->getUniformLocation(u_hasSpecularTexture), surfaceMaterial->getSpecularTextureName() != 0);
+	glUniform1i(currentProgram->getUniformLocation(u_hasNormalMapTexture), surfaceMaterial->getNormalMapTextureName() != 0);
+
+	glUniform1iv(currentProgram->getUniformLocation(u_packedLayer), SurfaceMaterial::PACKED_TEXTURES, surfaceMaterial->getPackedLayers());
+	glUniform4fv(currentProgram->getUniformLocation(u_packedRegion), SurfaceMaterial::PACKED_TEXTURES, surfaceMaterial->getPackedRegions());
+
+	glUniform1i(currentProgram->getUniformLocation(u_convertDirectX), surfaceMaterial->isConvertDirectX());
+
+	float environmentRefractiveIndex = refractiveIndex;
+
+	if (environmentRefractiveIndex != RI_NOTHING)
+	{
+		float materialRefractiveIndex = surfaceMaterial->getRefractiveIndex();
+
+		float eta = environmentRefractiveIndex / materialRefractiveIndex;
+
+		float reflectanceNormalIncidence = ((environmentRefractiveIndex - materialRefractiveIndex) * (environmentRefractiveIndex - materialRefractiveIndex)) / ((environmentRefractiveIndex + materialRefractiveIndex) * (environmentRefractiveIndex + materialRefractiveIndex));
+
+		glUniform1f(currentProgram->getUniformLocation(u_eta), eta);
+		glUniform1f(currentProgram->getUniformLocation(u_reflectanceNormalIncidence), reflectanceNormalIncidence);
+	}
+	else
+	{
+		glUniform1f(currentProgram->getUniformLocation(u_eta), 0.0f);
+		glUniform1f(currentProgram->getUniformLocation(u_reflectanceNormalIncidence), 0.0f);
+	}
+
+	if (SkyManager::getInstance()->hasActiveSky())
+	{
+		glUniform1i(currentProgram->getUniformLocation(u_hasCubeMapTexture), 1);
+
+		SkySP activeSky = SkyManager::getInstance()->getActiveSky();
+
+		RenderStateCache::getInstance()->bindTexture(GL_TEXTURE3, GL_TEXTURE_CUBE_MAP, activeSky->getSkyTextureName());
+	}
+	else
+	{
+		glUniform1i(currentProgram->getUniformLocation(u_hasCubeMapTexture), 0);
+
+		RenderStateCache::getInstance()->bindTexture(GL_TEXTURE3, GL_TEXTURE_CUBE_MAP, 0);
+	}
+
+	// Only allow dynamic cube map, if also a sky cube map is available
+	if (Entity::getDynamicCubeMaps() && surfaceMaterial->getDynamicCubeMapTextureName() != 0 && SkyManager::getInstance()->hasActiveSky())
+	{
+		glUniform1i(currentProgram->getUniformLocation(u_hasDynamicCubeMapTexture), 1);
+		RenderStateCache::getInstance()->bindTexture(GL_TEXTURE4, GL_TEXTURE_CUBE_MAP, surfaceMaterial->getDynamicCubeMapTextureName());
+	}
+	else
+	{
+		glUniform1i(currentProgram->getUniformLocation(u_hasDynamicCubeMapTexture), 0);
+		RenderStateCache::getInstance()->bindTexture(GL_TEXTURE4, GL_TEXTURE_CUBE_MAP, 0);
+	}
+
+	if (!Entity::getDynamicCubeMaps())
+	{
+		glUniformMatrix4fv(currentProgram->getUniformLocation(u_cubeMapViewMatrix), 6, GL_FALSE, Entity::getCubeMapViewMatrices()[0].getM());
+		glUniformMatrix4fv(currentProgram->getUniformLocation(u_cubeMapProjectionMatrix), 1, GL_FALSE, Entity::getCubeMapProjectionMatrix().getM());
+		glUniform1i(currentProgram->getUniformLocation(u_cubeMapFaceMask), Entity::getCubeMapFaceMask());
+	}
+
+	// No Skinning
+	glUniform1i(currentProgram->getUniformLocation(u_hasSkinning), 0);
+
+	// Write bright color
+	glUniform1i(currentProgram->getUniformLocation(u_writeBrightColor), writeBrightColor);
+	glUniform1f(currentProgram->getUniformLocation(u_brightColorLimit), brightColorLimit);
+
+	staticBatch.draw(GeneralEntity::currentProgramType);
+
+	surfaceMaterial->getTextureBindingSet().unbind();
+}
+
+void StaticBatchEntity::render() const
+{
+	enum RenderFilter renderFilter = Entity::getRenderFilter();
+
+	if ((transparent && renderFilter == RENDER_OPAQUE) || (!transparent && renderFilter == RENDER_TRANSPARENT))
+	{
+		return;
+	}
+
+	if (isWireframe())
+	{
+		glPolygonMode(GL_FRONT_AND_BACK, GL_LINE);
+	}
+
+	if (transparent)
+	{
+		glEnable(GL_BLEND);
+		glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+	}
+
+	auto walker = allStaticBatches.begin();
+	while (walker != allStaticBatches.end())
+	{
+		if ((*walker)->isUploaded())
+		{
+			renderStaticBatch(**walker);
+		}
+
+		walker++;
+	}
+
+	if (transparent)
+	{
+		glDisable(GL_BLEND);
+	}
+
+	if (!RenderStateCache::getInstance()->isBatching())
+	{
+		if (SkyManager::getInstance()->hasActiveSky())
+		{
+			RenderStateCache::getInstance()->bindTexture(GL_TEXTURE3, GL_TEXTURE_CUBE_MAP, 0);
+		}
+
+		RenderStateCache::getInstance()->bindTexture(GL_TEXTURE4, GL_TEXTURE_CUBE_MAP, 0);
+
+		glActiveTexture(GL_TEXTURE0);
+
+		RenderStateCache::getInstance()->bindVertexArray(0);
+	}
+
+	//
+
+	if (isWireframe())
+	{
+		glPolygonMode(GL_FRONT_AND_BACK, GL_FILL);
+	}
+
+	//
+
+	if (isDebug())
+	{
+		DebugDraw::drawer.draw(getBoundingSphere(), Color::RED, isDebugAsMesh());
+	}
+}
+
+const vector<StaticBatchSP>& StaticBatchEntity::getStaticBatches() const
+{
+	return allStaticBatches;
+}
+
+bool StaticBatchEntity::isTransparent() const
+{
+	return transparent;
+}
+
+void StaticBatchEntity::setTransparent(bool transparent)
+{
+	this->transparent = transparent;
+}
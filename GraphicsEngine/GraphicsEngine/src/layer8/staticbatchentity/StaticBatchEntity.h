@@ -0,0 +1,50 @@
+/*
+ * StaticBatchEntity.h
+ *
+ *  Created on: 19.10.2026
+ *      Author: nopper
+ */
+
+#ifndef STATICBATCHENTITY_H_
+#define STATICBATCHENTITY_H_
+
+#include "../../UsedLibs.h"
+
+#include "../../layer3/mesh/StaticBatch.h"
+#include "../../layer7/entity/GeneralEntity.h"
+
+/**
+ * Renders static geometry, which has been packed by the static batch builder. Each batch is drawn with one call.
+ * The sub meshes are already placed in world space, so the entity itself is not transformed.
+ */
+class StaticBatchEntity : public GeneralEntity
+{
+
+private:
+
+	std::vector<StaticBatchSP> allStaticBatches;
+
+	bool transparent;
+
+	void renderStaticBatch(const StaticBatch& staticBatch) const;
+
+public:
+
+	StaticBatchEntity(const std::string& name, const std::vector<StaticBatchSP>& allStaticBatches);
+	virtual ~StaticBatchEntity();
+
+	virtual void updateBoundingSphereCenter(bool force = false);
+	virtual void update();
+	virtual void render() const;
+
+	const std::vector<StaticBatchSP>& getStaticBatches() const;
+
+	bool isTransparent() const;
+
+	void setTransparent(bool transparent);
+
+};
+
+typedef std::shared_ptr<StaticBatchEntity> StaticBatchEntitySP;
+
+#endif /* STATICBATCHENTITY_H_ */
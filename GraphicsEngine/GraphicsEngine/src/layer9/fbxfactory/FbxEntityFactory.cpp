@@ -10,14 +10,12 @@
 #include "../../layer2/interpolation/ConstantInterpolator.h"
 #include "../../layer2/interpolation/CubicInterpolator.h"
 #include "../../layer2/interpolation/LinearInterpolator.h"
-#include "../../layer3/animation/AnimationLayer.h"
 #include "../../layer3/camera/OrthographicCamera.h"
 #include "../../layer3/camera/PerspectiveCamera.h"
 #include "../../layer3/light/DirectionalLight.h"
 #include "../../layer3/light/PointLight.h"
 #include "../../layer3/light/SpotLight.h"
 #include "../../layer6/model/ModelManager.h"
-#include "FbxSubMesh.h"
 
 #include "FbxEntityFactory.h"
 
@@ -26,7 +24,7 @@ using namespace std;
 const char* FbxEntityFactory::CHANNELS[] = { "X", "Y", "Z" };
 
 FbxEntityFactory::FbxEntityFactory() :
-		manager(0), ioSettings(0), geometryConverter(0), currentSurfaceMaterials(), allSurfaceMaterials(), allAnimationStacks(), allMeshes(), allCameras(), allLights(), currentNumberJoints(0), currentNumberAnimationStacks(0), currentEntityAnimated(false), currentEntitySkinned(false), anisotropic(false), doReset(true), minX(0.0f), maxX(0.0f), minY(0.0f), maxY(0.0f), minZ(0.0f), maxZ(0.0f), currentSurfaceMaterial(), loadCamera(false), loadLight(false), loadMesh(true)
+		manager(0), ioSettings(0), currentSurfaceMaterials(), allSurfaceMaterials(), allImportNodes(), allImportMeshes(), allImportMeshIndices(), allImportAnimationStacks(), allMeshes(), allCameras(), allLights(), currentNumberJoints(0), currentNumberAnimationStacks(0), currentEntityAnimated(false), currentEntitySkinned(false), anisotropic(false), doReset(true), minX(0.0f), maxX(0.0f), minY(0.0f), maxY(0.0f), minZ(0.0f), maxZ(0.0f), currentSurfaceMaterial(), loadCamera(false), loadLight(false), loadMesh(true), numberLods(1), lodReduction(0.5f), mergeStaticNodes(false), weldEpsilon(0.0f), packVertices(false), importConverter()
 {
 	// Create the FBX SDK manager
 	manager = FbxManager::Create();
@@ -34,21 +32,17 @@ FbxEntityFactory::FbxEntityFactory() :
 	// Create an IOSettings object.
 	ioSettings = FbxIOSettings::Create(manager, IOSROOT);
 	manager->SetIOSettings(ioSettings);
-
-	// Create a Geometry converter for triangulation
-	geometryConverter = new FbxGeometryConverter(manager);
 }
 
 FbxEntityFactory::~FbxEntityFactory()
 {
 	currentSurfaceMaterials.clear();
 	allSurfaceMaterials.clear();
-	allAnimationStacks.clear();
+	clearImportJobs();
 	allMeshes.clear();
 	allCameras.clear();
 	allLights.clear();
 
-	delete geometryConverter;
 	ioSettings->Destroy();
 	manager->Destroy();
 }
@@ -91,7 +85,7 @@ ModelEntitySP FbxEntityFactory::loadFbxFile(const string& name, const string& fi
 	currentNumberAnimationStacks = importer->GetAnimStackCount();
 	currentSurfaceMaterials.clear();
 	allSurfaceMaterials.clear();
-	allAnimationStacks.clear();
+	clearImportJobs();
 	allMeshes.clear();
 	allCameras.clear();
 	allLights.clear();
@@ -116,6 +110,16 @@ ModelEntitySP FbxEntityFactory::loadFbxFile(const string& name, const string& fi
 		return ModelEntitySP();
 	}
 
+	if (mergeStaticNodes)
+	{
+		nodeTreeFactory.mergeStaticNodes(numberLods, lodReduction);
+	}
+
+	if (packVertices)
+	{
+		nodeTreeFactory.packVertices();
+	}
+
 	float absMaxX = glusMathMaxf(fabs(maxX), fabs(minX));
 	float absMaxY = glusMathMaxf(fabs(maxY), fabs(minY));
 	float absMaxZ = glusMathMaxf(fabs(maxZ), fabs(minZ));
@@ -187,12 +191,29 @@ ModelEntitySP FbxEntityFactory::loadFbxSceneFile(const string& name, const strin
 	return result;
 }
 
-bool FbxEntityFactory::traverseScene(FbxScene* scene)
+void FbxEntityFactory::setLevelsOfDetail(uint32_t numberLods, float lodReduction)
 {
-	geometryConverter->Triangulate(scene, true);
+	this->numberLods = numberLods;
+	this->lodReduction = lodReduction;
+}
 
-	//
+void FbxEntityFactory::setMergeStaticNodes(bool mergeStaticNodes)
+{
+	this->mergeStaticNodes = mergeStaticNodes;
+}
 
+void FbxEntityFactory::setWeldEpsilon(float weldEpsilon)
+{
+	this->weldEpsilon = weldEpsilon;
+}
+
+void FbxEntityFactory::setPackVertices(bool packVertices)
+{
+	this->packVertices = packVertices;
+}
+
+bool FbxEntityFactory::traverseScene(FbxScene* scene)
+{
 	scene->FillAnimStackNameArray(animStackNameArray);
 
 	//
@@ -223,7 +244,12 @@ bool FbxEntityFactory::traverseScene(FbxScene* scene)
 
 	if (node)
 	{
-		traverseNode(node, nodeTreeFactory.getRootNode());
+		// Collect the nodes, meshes and animations. Polygons are triangulated later by the converter.
+		traverseNode(node, nodeTreeFactory.getRootNode().get() ? nodeTreeFactory.getRootNode()->getName() : "[NULL]");
+
+		importConverter.convert(allImportMeshes, allImportAnimationStacks);
+
+		createNodes();
 
 		if (nodeTreeFactory.getRootNode().get())
 		{
@@ -258,14 +284,7 @@ bool FbxEntityFactory::traverseScene(FbxScene* scene)
 				}
 				allSurfaceMaterials.clear();
 
-				auto walkerAnimationStack = allAnimationStacks.begin();
-				while (walkerAnimationStack != allAnimationStacks.end())
-				{
-					walkerAnimationStack->reset();
-
-					walkerAnimationStack++;
-				}
-				allAnimationStacks.clear();
+				clearImportJobs();
 
 				auto walkerMesh = allMeshes.begin();
 				while (walkerMesh != allMeshes.end())
@@ -294,15 +313,14 @@ bool FbxEntityFactory::traverseScene(FbxScene* scene)
 				}
 				allLights.clear();
 
-				traverseDeleteUserPointer(node);
-
 				return false;
 			}
 		}
 
 		postTraverseNode(node, nodeTreeFactory.getRootNode(), Matrix4x4());
 
-		traverseDeleteUserPointer(node);
+		// The converted data is owned by the meshes now.
+		clearImportJobs();
 	}
 
 	FbxArrayDelete(animStackNameArray);
@@ -504,9 +522,9 @@ FbxDouble3 FbxEntityFactory::processMaterialProperty(const FbxSurfaceMaterial *
 	return result;
 }
 
-void FbxEntityFactory::traverseNode(FbxNode* node, const NodeSP& parentNode)
+void FbxEntityFactory::traverseNode(FbxNode* node, const string& parentNodeName)
 {
-	NodeSP newParentNode = parentNode;
+	string newParentNodeName = parentNodeName;
 
 	FbxNodeAttribute::EType attributeType;
 
@@ -521,9 +539,7 @@ void FbxEntityFactory::traverseNode(FbxNode* node, const NodeSP& parentNode)
 
 	bool createNode = false;
 
-	MeshSP newMesh;
-	CameraSP newCamera;
-	LightSP newLight;
+	FbxImportNode importNode;
 
 	switch (attributeType)
 	{
@@ -556,9 +572,9 @@ void FbxEntityFactory::traverseNode(FbxNode* node, const NodeSP& parentNode)
 					}
 				}
 
-				newMesh = processMesh(node->GetMesh());
+				importNode.meshIndex = processMesh(node->GetMesh());
 
-				glusLogPrint(GLUS_LOG_INFO, "Created mesh in node: %s", node->GetName());
+				glusLogPrint(GLUS_LOG_INFO, "Collected mesh in node: %s", node->GetName());
 
 				createNode = true;
 			}
@@ -570,7 +586,7 @@ void FbxEntityFactory::traverseNode(FbxNode* node, const NodeSP& parentNode)
 		case FbxNodeAttribute::eCamera:
 			if (loadCamera)
 			{
-				newCamera = processCamera(node->GetCamera());
+				importNode.camera = processCamera(node->GetCamera());
 
 				glusLogPrint(GLUS_LOG_INFO, "Created camera in node: %s", node->GetName());
 
@@ -584,7 +600,7 @@ void FbxEntityFactory::traverseNode(FbxNode* node, const NodeSP& parentNode)
 		case FbxNodeAttribute::eLight:
 			if (loadLight)
 			{
-				newLight = processLight(node->GetLight());
+				importNode.light = processLight(node->GetLight());
 
 				glusLogPrint(GLUS_LOG_INFO, "Created light in node: %s", node->GetName());
 
@@ -617,571 +633,284 @@ void FbxEntityFactory::traverseNode(FbxNode* node, const NodeSP& parentNode)
 
 	if (createNode)
 	{
-		float translate[3] = { 0.0f, 0.0f, 0.0f };
-		float postRotate[3] = { 0.0f, 0.0f, 0.0f };
-		float rotate[3] = { 0.0f, 0.0f, 0.0f };
-		float preRotate[3] = { 0.0f, 0.0f, 0.0f };
-		float rotatePivot[3] = { 0.0f, 0.0f, 0.0f };
-		float rotateOffset[3] = { 0.0f, 0.0f, 0.0f };
-		float scale[3] = { 1.0f, 1.0f, 1.0f };
-		float scalePivot[3] = { 0.0f, 0.0f, 0.0f };
-		float scaleOffset[3] = { 0.0f, 0.0f, 0.0f };
-
-		float geoTranslate[3] = { 0.0f, 0.0f, 0.0f };
-		float geoRotate[3] = { 0.0f, 0.0f, 0.0f };
-		float geoScale[3] = { 1.0f, 1.0f, 1.0f };
+		importNode.name = node->GetName();
+		importNode.parentName = parentNodeName;
 
-		translate[0] = static_cast<float>(node->LclTranslation.Get()[0]);
-		translate[1] = static_cast<float>(node->LclTranslation.Get()[1]);
-		translate[2] = static_cast<float>(node->LclTranslation.Get()[2]);
+		importNode.translate[0] = static_cast<float>(node->LclTranslation.Get()[0]);
+		importNode.translate[1] = static_cast<float>(node->LclTranslation.Get()[1]);
+		importNode.translate[2] = static_cast<float>(node->LclTranslation.Get()[2]);
 
-		geoTranslate[0] = static_cast<float>(node->GeometricTranslation.Get()[0]);
-		geoTranslate[1] = static_cast<float>(node->GeometricTranslation.Get()[1]);
-		geoTranslate[2] = static_cast<float>(node->GeometricTranslation.Get()[2]);
+		importNode.geoTranslate[0] = static_cast<float>(node->GeometricTranslation.Get()[0]);
+		importNode.geoTranslate[1] = static_cast<float>(node->GeometricTranslation.Get()[1]);
+		importNode.geoTranslate[2] = static_cast<float>(node->GeometricTranslation.Get()[2]);
 
 		//
 
-		rotateOffset[0] = static_cast<float>(node->RotationOffset.Get()[0]);
-		rotateOffset[1] = static_cast<float>(node->RotationOffset.Get()[1]);
-		rotateOffset[2] = static_cast<float>(node->RotationOffset.Get()[2]);
+		importNode.rotateOffset[0] = static_cast<float>(node->RotationOffset.Get()[0]);
+		importNode.rotateOffset[1] = static_cast<float>(node->RotationOffset.Get()[1]);
+		importNode.rotateOffset[2] = static_cast<float>(node->RotationOffset.Get()[2]);
 
-		rotatePivot[0] = static_cast<float>(node->RotationPivot.Get()[0]);
-		rotatePivot[1] = static_cast<float>(node->RotationPivot.Get()[1]);
-		rotatePivot[2] = static_cast<float>(node->RotationPivot.Get()[2]);
+		importNode.rotatePivot[0] = static_cast<float>(node->RotationPivot.Get()[0]);
+		importNode.rotatePivot[1] = static_cast<float>(node->RotationPivot.Get()[1]);
+		importNode.rotatePivot[2] = static_cast<float>(node->RotationPivot.Get()[2]);
 
-		preRotate[0] = static_cast<float>(node->PreRotation.Get()[0]);
-		preRotate[1] = static_cast<float>(node->PreRotation.Get()[1]);
-		preRotate[2] = static_cast<float>(node->PreRotation.Get()[2]);
+		importNode.preRotate[0] = static_cast<float>(node->PreRotation.Get()[0]);
+		importNode.preRotate[1] = static_cast<float>(node->PreRotation.Get()[1]);
+		importNode.preRotate[2] = static_cast<float>(node->PreRotation.Get()[2]);
 
-		postRotate[0] = static_cast<float>(node->PostRotation.Get()[0]);
-		postRotate[1] = static_cast<float>(node->PostRotation.Get()[1]);
-		postRotate[2] = static_cast<float>(node->PostRotation.Get()[2]);
+		importNode.postRotate[0] = static_cast<float>(node->PostRotation.Get()[0]);
+		importNode.postRotate[1] = static_cast<float>(node->PostRotation.Get()[1]);
+		importNode.postRotate[2] = static_cast<float>(node->PostRotation.Get()[2]);
 
-		rotate[0] = static_cast<float>(node->LclRotation.Get()[0]);
-		rotate[1] = static_cast<float>(node->LclRotation.Get()[1]);
-		rotate[2] = static_cast<float>(node->LclRotation.Get()[2]);
+		importNode.rotate[0] = static_cast<float>(node->LclRotation.Get()[0]);
+		importNode.rotate[1] = static_cast<float>(node->LclRotation.Get()[1]);
+		importNode.rotate[2] = static_cast<float>(node->LclRotation.Get()[2]);
 
-		geoRotate[0] = static_cast<float>(node->GeometricRotation.Get()[0]);
-		geoRotate[1] = static_cast<float>(node->GeometricRotation.Get()[1]);
-		geoRotate[2] = static_cast<float>(node->GeometricRotation.Get()[2]);
+		importNode.geoRotate[0] = static_cast<float>(node->GeometricRotation.Get()[0]);
+		importNode.geoRotate[1] = static_cast<float>(node->GeometricRotation.Get()[1]);
+		importNode.geoRotate[2] = static_cast<float>(node->GeometricRotation.Get()[2]);
 
 		//
 
-		scaleOffset[0] = static_cast<float>(node->ScalingOffset.Get()[0]);
-		scaleOffset[1] = static_cast<float>(node->ScalingOffset.Get()[1]);
-		scaleOffset[2] = static_cast<float>(node->ScalingOffset.Get()[2]);
+		importNode.scaleOffset[0] = static_cast<float>(node->ScalingOffset.Get()[0]);
+		importNode.scaleOffset[1] = static_cast<float>(node->ScalingOffset.Get()[1]);
+		importNode.scaleOffset[2] = static_cast<float>(node->ScalingOffset.Get()[2]);
 
-		//scalePivot[0] = static_cast<float>(node->ScalingPivot.Get()[0]);
-		scalePivot[1] = static_cast<float>(node->ScalingPivot.Get()[1]);
-		scalePivot[2] = static_cast<float>(node->ScalingPivot.Get()[2]);
+		//importNode.scalePivot[0] = static_cast<float>(node->ScalingPivot.Get()[0]);
+		importNode.scalePivot[1] = static_cast<float>(node->ScalingPivot.Get()[1]);
+		importNode.scalePivot[2] = static_cast<float>(node->ScalingPivot.Get()[2]);
 
-		scale[0] = static_cast<float>(node->LclScaling.Get()[0]);
-		scale[1] = static_cast<float>(node->LclScaling.Get()[1]);
-		scale[2] = static_cast<float>(node->LclScaling.Get()[2]);
+		importNode.scale[0] = static_cast<float>(node->LclScaling.Get()[0]);
+		importNode.scale[1] = static_cast<float>(node->LclScaling.Get()[1]);
+		importNode.scale[2] = static_cast<float>(node->LclScaling.Get()[2]);
 
-		geoScale[0] = static_cast<float>(node->GeometricScaling.Get()[0]);
-		geoScale[1] = static_cast<float>(node->GeometricScaling.Get()[1]);
-		geoScale[2] = static_cast<float>(node->GeometricScaling.Get()[2]);
+		importNode.geoScale[0] = static_cast<float>(node->GeometricScaling.Get()[0]);
+		importNode.geoScale[1] = static_cast<float>(node->GeometricScaling.Get()[1]);
+		importNode.geoScale[2] = static_cast<float>(node->GeometricScaling.Get()[2]);
 
 		//
 
 		// Animation
-		vector<AnimationStackSP> allAnimationStacks;
-		AnimationStackSP currentAnimationStack;
+		int32_t animationStackIndex;
 		for (int32_t i = 0; i < currentNumberAnimationStacks; i++)
 		{
-			currentAnimationStack = processAnimation(node, i);
+			animationStackIndex = processAnimation(node, i);
 
-			if (currentAnimationStack.get())
+			if (animationStackIndex >= 0)
 			{
-				allAnimationStacks.push_back(currentAnimationStack);
+				importNode.animationStackIndices.push_back(animationStackIndex);
 			}
 		}
 
-		string parentNodeName = parentNode.get() ? parentNode->getName() : "[NULL]";
-
-		NodeSP newNode = nodeTreeFactory.createNode(node->GetName(), parentNodeName, translate, rotateOffset, rotatePivot, preRotate, rotate, postRotate, scaleOffset, scalePivot, scale, geoTranslate, geoRotate, geoScale, newMesh, newCamera, newLight, allAnimationStacks);
+		allImportNodes.push_back(importNode);
 
-		glusLogPrint(GLUS_LOG_INFO, "Created node: %s", node->GetName());
-
-		newParentNode = newNode;
+		newParentNodeName = importNode.name;
 	}
 
 	for (int i = 0; i < node->GetChildCount(); i++)
 	{
-		traverseNode(node->GetChild(i), newParentNode);
+		traverseNode(node->GetChild(i), newParentNodeName);
 	}
 }
 
-AnimationStackSP FbxEntityFactory::processAnimation(FbxNode* node, int32_t animStackIndex)
+int32_t FbxEntityFactory::processAnimation(FbxNode* node, int32_t animStackIndex)
 {
 	FbxAnimStack* animStack = node->GetScene()->FindMember<FbxAnimStack>(animStackNameArray[animStackIndex]->Buffer());
 
-	if (animStack)
+	if (!animStack)
 	{
-		string animStackName(animStack->GetName());
-
-		//
-
-		auto walker = allAnimationStacks.begin();
-		while (walker != allAnimationStacks.end())
-		{
-			if ((*walker)->getName().compare(animStackName) == 0)
-			{
-				glusLogPrint(GLUS_LOG_INFO, "Reused animation stack: %s", animStack->GetName());
-
-				return *walker;
-			}
-
-			walker++;
-		}
-
-		//
-		node->GetScene()->SetCurrentAnimationStack(animStack);
+		return -1;
+	}
 
-		float currentStartTime = static_cast<float>(animStack->ReferenceStart.Get().GetSecondDouble());
-		float currentStopTime = static_cast<float>(animStack->ReferenceStop.Get().GetSecondDouble());
+	node->GetScene()->SetCurrentAnimationStack(animStack);
 
-		currentEntityAnimated = true;
+	currentEntityAnimated = true;
 
-		AnimationStack* newAnimStack = new AnimationStack(animStackName, currentStartTime, currentStopTime);
+	ImportAnimationStackSP importAnimationStack = ImportAnimationStackSP(new ImportAnimationStack());
 
-		int32_t numberAnimationLayers = animStack->GetMemberCount();
+	importAnimationStack->name = animStack->GetName();
+	importAnimationStack->startTime = static_cast<float>(animStack->ReferenceStart.Get().GetSecondDouble());
+	importAnimationStack->stopTime = static_cast<float>(animStack->ReferenceStop.Get().GetSecondDouble());
 
-		FbxAnimLayer* animLayer = 0;
-		AnimationLayerSP newAnimLayer;
-		FbxAnimCurve* animCurve = 0;
-		enum AnimationLayer::eCHANNELS_XYZ currentChannel = AnimationLayer::X;
-		float time;
-		float value;
+	if (node->GetTranslationLimits().GetActive())
+	{
+		ImportAnimationLimits& limits = importAnimationStack->translationLimits;
 
-		bool minTranslation[3];
-		bool maxTranslation[3];
-		bool minRotation[3];
-		bool maxRotation[3];
-		bool minScaling[3];
-		bool maxScaling[3];
-		float limitedValue;
+		node->GetTranslationLimits().GetMinActive(limits.minActive[0], limits.minActive[1], limits.minActive[2]);
+		node->GetTranslationLimits().GetMaxActive(limits.maxActive[0], limits.maxActive[1], limits.maxActive[2]);
 
-		if (node->GetTranslationLimits().GetActive())
-		{
-			node->GetTranslationLimits().GetMinActive(minTranslation[0], minTranslation[1], minTranslation[2]);
-			node->GetTranslationLimits().GetMaxActive(maxTranslation[0], maxTranslation[1], maxTranslation[2]);
-		}
-		if (node->GetRotationLimits().GetActive())
+		for (int32_t k = 0; k < 3; k++)
 		{
-			node->GetRotationLimits().GetMinActive(minRotation[0], minRotation[1], minRotation[2]);
-			node->GetRotationLimits().GetMaxActive(maxRotation[0], maxRotation[1], maxRotation[2]);
-		}
-		if (node->GetScalingLimits().GetActive())
-		{
-			node->GetScalingLimits().GetMinActive(minScaling[0], minScaling[1], minScaling[2]);
-			node->GetScalingLimits().GetMaxActive(maxScaling[0], maxScaling[1], maxScaling[2]);
+			limits.minimum[k] = static_cast<float>(node->GetTranslationLimits().GetMin()[k]);
+			limits.maximum[k] = static_cast<float>(node->GetTranslationLimits().GetMax()[k]);
 		}
+	}
+	if (node->GetRotationLimits().GetActive())
+	{
+		ImportAnimationLimits& limits = importAnimationStack->rotationLimits;
+
+		node->GetRotationLimits().GetMinActive(limits.minActive[0], limits.minActive[1], limits.minActive[2]);
+		node->GetRotationLimits().GetMaxActive(limits.maxActive[0], limits.maxActive[1], limits.maxActive[2]);
 
-		for (int32_t i = 0; i < numberAnimationLayers; i++)
+		for (int32_t k = 0; k < 3; k++)
 		{
-			animLayer = static_cast<FbxAnimLayer*>(animStack->GetMember(i));
+			limits.minimum[k] = static_cast<float>(node->GetRotationLimits().GetMin()[k]);
+			limits.maximum[k] = static_cast<float>(node->GetRotationLimits().GetMax()[k]);
+		}
+	}
+	if (node->GetScalingLimits().GetActive())
+	{
+		ImportAnimationLimits& limits = importAnimationStack->scalingLimits;
 
-			newAnimLayer = AnimationLayerSP(new AnimationLayer());
+		node->GetScalingLimits().GetMinActive(limits.minActive[0], limits.minActive[1], limits.minActive[2]);
+		node->GetScalingLimits().GetMaxActive(limits.maxActive[0], limits.maxActive[1], limits.maxActive[2]);
 
-			for (int32_t k = 0; k < 3; k++)
-			{
-				// Translation
-				animCurve = node->LclTranslation.GetCurve(animLayer, CHANNELS[k]);
+		for (int32_t k = 0; k < 3; k++)
+		{
+			limits.minimum[k] = static_cast<float>(node->GetScalingLimits().GetMin()[k]);
+			limits.maximum[k] = static_cast<float>(node->GetScalingLimits().GetMax()[k]);
+		}
+	}
 
-				if (strcmp(CHANNELS[k], CHANNELS[0]) == 0)
-				{
-					currentChannel = AnimationLayer::X;
-				}
-				else if (strcmp(CHANNELS[k], CHANNELS[1]) == 0)
-				{
-					currentChannel = AnimationLayer::Y;
-				}
-				else if (strcmp(CHANNELS[k], CHANNELS[2]) == 0)
-				{
-					currentChannel = AnimationLayer::Z;
-				}
+	int32_t numberAnimationLayers = animStack->GetMemberCount();
 
-				if (animCurve && animCurve->KeyGetCount())
-				{
-					for (int32_t m = 0; m < animCurve->KeyGetCount(); m++)
-					{
-						time = static_cast<float>(animCurve->KeyGetTime(m).GetSecondDouble());
-
-						value = static_cast<float>(animCurve->KeyGetValue(m));
-
-						if (node->GetTranslationLimits().GetActive())
-						{
-							if (minTranslation[k])
-							{
-								limitedValue = static_cast<float>(node->GetTranslationLimits().GetMin()[k]);
-
-								if (limitedValue < value)
-								{
-									value = limitedValue;
-								}
-							}
-
-							if (maxTranslation[k])
-							{
-								limitedValue = static_cast<float>(node->GetTranslationLimits().GetMax()[k]);
-
-								if (limitedValue > value)
-								{
-									value = limitedValue;
-								}
-							}
-						}
-
-						switch (animCurve->KeyGetInterpolation(m))
-						{
-							case FbxAnimCurveDef::eInterpolationConstant:
-								newAnimLayer->addTranslationValue(currentChannel, time, value, ConstantInterpolator::interpolator);
-							break;
-							case FbxAnimCurveDef::eInterpolationLinear:
-								newAnimLayer->addTranslationValue(currentChannel, time, value, LinearInterpolator::interpolator);
-							break;
-							case FbxAnimCurveDef::eInterpolationCubic:
-								newAnimLayer->addTranslationValue(currentChannel, time, value, CubicInterpolator::interpolator);
-							break;
-						}
-					}
-				}
+	importAnimationStack->layers.resize(numberAnimationLayers);
 
-				// Rotation
-				animCurve = node->LclRotation.GetCurve(animLayer, CHANNELS[k]);
+	for (int32_t i = 0; i < numberAnimationLayers; i++)
+	{
+		FbxAnimLayer* animLayer = static_cast<FbxAnimLayer*>(animStack->GetMember(i));
 
-				if (animCurve && animCurve->KeyGetCount())
-				{
-					for (int32_t m = 0; m < animCurve->KeyGetCount(); m++)
-					{
-						time = static_cast<float>(animCurve->KeyGetTime(m).GetSecondDouble());
-
-						value = static_cast<float>(animCurve->KeyGetValue(m));
-
-						if (node->GetRotationLimits().GetActive())
-						{
-							if (minRotation[k])
-							{
-								limitedValue = static_cast<float>(node->GetRotationLimits().GetMin()[k]);
-
-								if (limitedValue < value)
-								{
-									value = limitedValue;
-								}
-							}
-
-							if (maxRotation[k])
-							{
-								limitedValue = static_cast<float>(node->GetRotationLimits().GetMax()[k]);
-
-								if (limitedValue > value)
-								{
-									value = limitedValue;
-								}
-							}
-						}
-
-						switch (animCurve->KeyGetInterpolation(m))
-						{
-							case FbxAnimCurveDef::eInterpolationConstant:
-								newAnimLayer->addRotationValue(currentChannel, time, value, ConstantInterpolator::interpolator);
-							break;
-							case FbxAnimCurveDef::eInterpolationLinear:
-								newAnimLayer->addRotationValue(currentChannel, time, value, LinearInterpolator::interpolator);
-							break;
-							case FbxAnimCurveDef::eInterpolationCubic:
-								newAnimLayer->addRotationValue(currentChannel, time, value, CubicInterpolator::interpolator);
-							break;
-						}
-					}
-				}
+		ImportAnimationLayer& importAnimationLayer = importAnimationStack->layers[i];
 
-				// Scaling
-				animCurve = node->LclScaling.GetCurve(animLayer, CHANNELS[k]);
+		for (int32_t k = 0; k < 3; k++)
+		{
+			processAnimationCurve(node->LclTranslation.GetCurve(animLayer, CHANNELS[k]), importAnimationLayer.translation[k]);
 
-				if (animCurve && animCurve->KeyGetCount())
-				{
-					for (int32_t m = 0; m < animCurve->KeyGetCount(); m++)
-					{
-						time = static_cast<float>(animCurve->KeyGetTime(m).GetSecondDouble());
-
-						value = static_cast<float>(animCurve->KeyGetValue(m));
-
-						if (node->GetScalingLimits().GetActive())
-						{
-							if (minScaling[k])
-							{
-								limitedValue = static_cast<float>(node->GetScalingLimits().GetMin()[k]);
-
-								if (limitedValue < value)
-								{
-									value = limitedValue;
-								}
-							}
-
-							if (maxScaling[k])
-							{
-								limitedValue = static_cast<float>(node->GetScalingLimits().GetMax()[k]);
-
-								if (limitedValue > value)
-								{
-									value = limitedValue;
-								}
-							}
-						}
-
-						switch (animCurve->KeyGetInterpolation(m))
-						{
-							case FbxAnimCurveDef::eInterpolationConstant:
-								newAnimLayer->addScalingValue(currentChannel, time, value, ConstantInterpolator::interpolator);
-							break;
-							case FbxAnimCurveDef::eInterpolationLinear:
-								newAnimLayer->addScalingValue(currentChannel, time, value, LinearInterpolator::interpolator);
-							break;
-							case FbxAnimCurveDef::eInterpolationCubic:
-								newAnimLayer->addScalingValue(currentChannel, time, value, CubicInterpolator::interpolator);
-							break;
-						}
-					}
-				}
-			}
+			processAnimationCurve(node->LclRotation.GetCurve(animLayer, CHANNELS[k]), importAnimationLayer.rotation[k]);
 
-			newAnimStack->addAnimationLayer(newAnimLayer);
+			processAnimationCurve(node->LclScaling.GetCurve(animLayer, CHANNELS[k]), importAnimationLayer.scaling[k]);
 		}
-
-		return AnimationStackSP(newAnimStack);
 	}
 
-	return AnimationStackSP();
+	allImportAnimationStacks.push_back(importAnimationStack);
+
+	return static_cast<int32_t>(allImportAnimationStacks.size()) - 1;
 }
 
-// See example in SceneCache.cxx
-MeshSP FbxEntityFactory::processMesh(FbxMesh* mesh)
+void FbxEntityFactory::processAnimationCurve(FbxAnimCurve* animCurve, ImportAnimationCurve& importAnimationCurve) const
 {
-	//
-
-	string meshName(mesh->GetName());
-
-	if (meshName.compare("") == 0)
+	if (!animCurve)
 	{
-		meshName = mesh->GetNode()->GetName();
+		return;
 	}
 
-	//
-
-	auto walkerMesh = allMeshes.begin();
-	while (walkerMesh != allMeshes.end())
+	for (int32_t m = 0; m < animCurve->KeyGetCount(); m++)
 	{
-		if ((*walkerMesh)->getName().compare(meshName) == 0)
-		{
-			glusLogPrint(GLUS_LOG_INFO, "Reused mesh: %s", meshName.c_str());
+		importAnimationCurve.times.push_back(static_cast<float>(animCurve->KeyGetTime(m).GetSecondDouble()));
 
-			return *walkerMesh;
-		}
+		importAnimationCurve.values.push_back(static_cast<float>(animCurve->KeyGetValue(m)));
 
-		walkerMesh++;
+		switch (animCurve->KeyGetInterpolation(m))
+		{
+			case FbxAnimCurveDef::eInterpolationConstant:
+				importAnimationCurve.interpolators.push_back(&ConstantInterpolator::interpolator);
+			break;
+			case FbxAnimCurveDef::eInterpolationLinear:
+				importAnimationCurve.interpolators.push_back(&LinearInterpolator::interpolator);
+			break;
+			case FbxAnimCurveDef::eInterpolationCubic:
+				importAnimationCurve.interpolators.push_back(&CubicInterpolator::interpolator);
+			break;
+			default:
+				importAnimationCurve.interpolators.push_back(nullptr);
+			break;
+		}
 	}
+}
 
-	//
-
-	map<int32_t, FbxSubMeshSP> currentFbxSubMeshes;
-
-	// Sub meshes
+// See example in SceneCache.cxx
+int32_t FbxEntityFactory::processMesh(FbxMesh* mesh)
+{
+	auto walkerMesh = allImportMeshIndices.find(mesh);
 
-	currentFbxSubMeshes[0] = FbxSubMeshSP(new FbxSubMesh());
-	currentFbxSubMeshes[0]->setTriangleCount(mesh->GetPolygonCount());
-	FbxLayerElementArrayTemplate<int32_t>* materialIndice = 0;
-	FbxGeometryElement::EMappingMode materialMappingMode = FbxGeometryElement::eNone;
-	if (mesh->GetElementMaterial())
+	if (walkerMesh != allImportMeshIndices.end())
 	{
-		materialIndice = &mesh->GetElementMaterial()->GetIndexArray();
+		glusLogPrint(GLUS_LOG_INFO, "Reused mesh: %s", allImportMeshes[walkerMesh->second]->name.c_str());
 
-		materialMappingMode = mesh->GetElementMaterial()->GetMappingMode();
-		if (materialIndice && materialMappingMode == FbxGeometryElement::eByPolygon)
-		{
-			currentFbxSubMeshes[0]->setTriangleCount(0);
-			// Count the triangles of each material
-			for (int32_t polygonIndex = 0; polygonIndex < mesh->GetPolygonCount(); ++polygonIndex)
-			{
-				const int32_t materialIndex = materialIndice->GetAt(polygonIndex);
+		return walkerMesh->second;
+	}
 
-				if (currentFbxSubMeshes[materialIndex].get() == 0)
-				{
-					currentFbxSubMeshes[materialIndex] = FbxSubMeshSP(new FbxSubMesh());
-				}
-				currentFbxSubMeshes[materialIndex]->increaseTriangleCount();
-			}
+	ImportMeshSP importMesh = ImportMeshSP(new ImportMesh());
 
-			// Calculate the offset for each sub mesh
-			uint32_t currentIndexOffset = 0;
-			for (uint32_t materialIndex = 0; materialIndex < currentFbxSubMeshes.size(); ++materialIndex)
-			{
-				currentFbxSubMeshes[materialIndex]->setIndicesOffset(currentIndexOffset);
+	importMesh->name = mesh->GetName();
 
-				currentIndexOffset += currentFbxSubMeshes[materialIndex]->getTriangleCount() * 3;
-			}
-		}
-	}
-	else
+	if (importMesh->name.compare("") == 0)
 	{
-		glusLogPrint(GLUS_LOG_WARNING, "Mesh '%s' has no material.", meshName.c_str());
+		importMesh->name = mesh->GetNode()->GetName();
 	}
 
-	bool allByControlPoint = true;
-	bool hasNormal = mesh->GetElementNormalCount() > 0;
-	bool hasTangent = mesh->GetElementTangentCount() > 0;
-	bool hasBinormal = mesh->GetElementBinormalCount() > 0;
-	bool hasUV = mesh->GetElementUVCount() > 0;
-	FbxGeometryElement::EMappingMode normalMappingMode = FbxGeometryElement::eNone;
-	FbxGeometryElement::EMappingMode tangentMappingMode = FbxGeometryElement::eNone;
-	FbxGeometryElement::EMappingMode binormalMappingMode = FbxGeometryElement::eNone;
-	FbxGeometryElement::EMappingMode uvMappingMode = FbxGeometryElement::eNone;
-	if (hasNormal)
+	importMesh->numberLods = numberLods;
+	importMesh->lodReduction = lodReduction;
+	importMesh->weldEpsilon = weldEpsilon;
+	importMesh->surfaceMaterials = currentSurfaceMaterials;
+
+	// Control points and polygons
+
+	const FbxVector4* controlPoints = mesh->GetControlPoints();
+
+	for (int32_t index = 0; index < mesh->GetControlPointsCount(); ++index)
 	{
-		normalMappingMode = mesh->GetElementNormal(0)->GetMappingMode();
-		if (normalMappingMode == FbxGeometryElement::eNone)
-		{
-			hasNormal = false;
-		}
-		if (hasNormal && normalMappingMode != FbxGeometryElement::eByControlPoint)
-		{
-			allByControlPoint = false;
-		}
+		importMesh->controlPoints.push_back(static_cast<float>(controlPoints[index][0]));
+		importMesh->controlPoints.push_back(static_cast<float>(controlPoints[index][1]));
+		importMesh->controlPoints.push_back(static_cast<float>(controlPoints[index][2]));
 	}
-	if (hasTangent)
+
+	int32_t polygonCount = mesh->GetPolygonCount();
+
+	for (int32_t polygonIndex = 0; polygonIndex < polygonCount; ++polygonIndex)
 	{
-		tangentMappingMode = mesh->GetElementTangent(0)->GetMappingMode();
-		if (tangentMappingMode == FbxGeometryElement::eNone)
-		{
-			hasTangent = false;
-		}
-		if (hasTangent && tangentMappingMode != FbxGeometryElement::eByControlPoint)
+		int32_t polygonSize = mesh->GetPolygonSize(polygonIndex);
+
+		importMesh->polygonSizes.push_back(polygonSize);
+
+		for (int32_t verticeIndex = 0; verticeIndex < polygonSize; ++verticeIndex)
 		{
-			allByControlPoint = false;
+			importMesh->polygonVertices.push_back(mesh->GetPolygonVertex(polygonIndex, verticeIndex));
 		}
 	}
-	if (hasBinormal)
+
+	// Sub meshes
+
+	if (mesh->GetElementMaterial())
 	{
-		binormalMappingMode = mesh->GetElementBinormal(0)->GetMappingMode();
-		if (binormalMappingMode == FbxGeometryElement::eNone)
-		{
-			hasBinormal = false;
-		}
-		if (hasBinormal && binormalMappingMode != FbxGeometryElement::eByControlPoint)
+		FbxLayerElementArrayTemplate<int32_t>& materialIndice = mesh->GetElementMaterial()->GetIndexArray();
+
+		if (mesh->GetElementMaterial()->GetMappingMode() == FbxGeometryElement::eByPolygon)
 		{
-			allByControlPoint = false;
+			for (int32_t polygonIndex = 0; polygonIndex < polygonCount; ++polygonIndex)
+			{
+				importMesh->polygonMaterials.push_back(materialIndice.GetAt(polygonIndex));
+			}
 		}
 	}
-	if (hasUV)
+	else
 	{
-		uvMappingMode = mesh->GetElementUV(0)->GetMappingMode();
-		if (uvMappingMode == FbxGeometryElement::eNone)
-		{
-			hasUV = false;
-		}
-		if (hasUV && uvMappingMode != FbxGeometryElement::eByControlPoint)
-		{
-			allByControlPoint = false;
-		}
+		glusLogPrint(GLUS_LOG_WARNING, "Mesh '%s' has no material.", importMesh->name.c_str());
 	}
 
-	// Vertices etc.
-
-	uint32_t polygonCount;
-	uint32_t numberVertices;
+	// Normals
 
-	float* vertices = 0;
-	float* normals = 0;
-	float* tangents = 0;
-	float* binormals = 0;
-	float* texCoords = 0;
-
-	uint32_t numberIndices;
-
-	uint32_t* indices = 0;
-	uint32_t* indicesToOrgIndices = 0;
-
-	polygonCount = mesh->GetPolygonCount();
-	numberVertices = mesh->GetControlPointsCount();
-	if (!allByControlPoint)
+	if (mesh->GetElementNormalCount() > 0 && mesh->GetElementNormal(0)->GetMappingMode() != FbxGeometryElement::eNone)
 	{
-		numberVertices = polygonCount * 3;
+		const FbxGeometryElementNormal* normalElement = mesh->GetElementNormal(0);
 
-		hasTangent = false;
-		hasBinormal = false;
-	}
+		FbxVector4 currentNormal;
 
-	vertices = new float[numberVertices * 4];
-	if (hasNormal)
-	{
-		normals = new float[numberVertices * 3];
-	}
-	if (hasTangent)
-	{
-		tangents = new float[numberVertices * 3];
-	}
-	if (hasBinormal)
-	{
-		binormals = new float[numberVertices * 3];
-	}
-	FbxStringList uvNames;
-	mesh->GetUVSetNames(uvNames);
-	const char * uvName = 0;
-	if (hasUV && uvNames.GetCount())
-	{
-		texCoords = new float[numberVertices * 2];
-		uvName = uvNames[0];
-	}
-	else
-	{
-		hasUV = false;
-	}
+		importMesh->normalsByControlPoint = normalElement->GetMappingMode() == FbxGeometryElement::eByControlPoint;
 
-	numberIndices = polygonCount * 3;
-	indices = new uint32_t[numberIndices];
-
-	// Populate the array with vertex attribute
-	const FbxVector4 * controlPoints = mesh->GetControlPoints();
-	FbxVector4 currentVertex;
-	FbxVector4 currentNormal;
-	FbxVector4 currentTangent;
-	FbxVector4 currentBinormal;
-	FbxVector2 currentUV;
-	if (allByControlPoint)
-	{
-		const FbxGeometryElementNormal* normalElement = 0;
-		const FbxGeometryElementTangent* tangentElement = 0;
-		const FbxGeometryElementBinormal* binormalElement = 0;
-		const FbxGeometryElementUV* uvElement = 0;
-		if (hasNormal)
+		if (importMesh->normalsByControlPoint)
 		{
-			normalElement = mesh->GetElementNormal(0);
-		}
-		if (hasTangent)
-		{
-			tangentElement = mesh->GetElementTangent(0);
-		}
-		if (hasBinormal)
-		{
-			binormalElement = mesh->GetElementBinormal(0);
-		}
-		if (hasUV)
-		{
-			uvElement = mesh->GetElementUV(0);
-		}
-		for (int32_t index = 0; index < mesh->GetControlPointsCount(); ++index)
-		{
-			// Save the vertex position.
-			currentVertex = controlPoints[index];
-			vertices[index * 4 + 0] = static_cast<float>(currentVertex[0]);
-			vertices[index * 4 + 1] = static_cast<float>(currentVertex[1]);
-			vertices[index * 4 + 2] = static_cast<float>(currentVertex[2]);
-			vertices[index * 4 + 3] = 1;
-
-			// Save the normal.
-			if (mesh->GetElementNormalCount() > 0)
+			for (int32_t index = 0; index < mesh->GetControlPointsCount(); ++index)
 			{
 				int32_t normalIndex = index;
 				if (normalElement->GetReferenceMode() != FbxGeometryElement::eDirect)
@@ -1189,41 +918,85 @@ MeshSP FbxEntityFactory::processMesh(FbxMesh* mesh)
 					normalIndex = normalElement->GetIndexArray().GetAt(index);
 				}
 				currentNormal = normalElement->GetDirectArray().GetAt(normalIndex);
-				normals[index * 3 + 0] = static_cast<float>(currentNormal[0]);
-				normals[index * 3 + 1] = static_cast<float>(currentNormal[1]);
-				normals[index * 3 + 2] = static_cast<float>(currentNormal[2]);
+				importMesh->inputNormals.push_back(static_cast<float>(currentNormal[0]));
+				importMesh->inputNormals.push_back(static_cast<float>(currentNormal[1]));
+				importMesh->inputNormals.push_back(static_cast<float>(currentNormal[2]));
 			}
-
-			// Save the tangent.
-			if (mesh->GetElementTangentCount() > 0)
+		}
+		else
+		{
+			for (int32_t polygonIndex = 0; polygonIndex < polygonCount; ++polygonIndex)
 			{
-				int32_t tangentIndex = index;
-				if (tangentElement->GetReferenceMode() != FbxGeometryElement::eDirect)
+				for (int32_t verticeIndex = 0; verticeIndex < mesh->GetPolygonSize(polygonIndex); ++verticeIndex)
 				{
-					tangentIndex = tangentElement->GetIndexArray().GetAt(index);
+					mesh->GetPolygonVertexNormal(polygonIndex, verticeIndex, currentNormal);
+					importMesh->inputNormals.push_back(static_cast<float>(currentNormal[0]));
+					importMesh->inputNormals.push_back(static_cast<float>(currentNormal[1]));
+					importMesh->inputNormals.push_back(static_cast<float>(currentNormal[2]));
 				}
-				currentTangent = tangentElement->GetDirectArray().GetAt(tangentIndex);
-				tangents[index * 3 + 0] = static_cast<float>(currentTangent[0]);
-				tangents[index * 3 + 1] = static_cast<float>(currentTangent[1]);
-				tangents[index * 3 + 2] = static_cast<float>(currentTangent[2]);
 			}
+		}
+	}
+
+	// Tangents and binormals are only taken, if given by control point. Otherwise, they are calculated.
+
+	if (mesh->GetElementTangentCount() > 0 && mesh->GetElementTangent(0)->GetMappingMode() == FbxGeometryElement::eByControlPoint)
+	{
+		const FbxGeometryElementTangent* tangentElement = mesh->GetElementTangent(0);
 
-			// Save the binormal.
-			if (mesh->GetElementBinormalCount() > 0)
+		FbxVector4 currentTangent;
+
+		for (int32_t index = 0; index < mesh->GetControlPointsCount(); ++index)
+		{
+			int32_t tangentIndex = index;
+			if (tangentElement->GetReferenceMode() != FbxGeometryElement::eDirect)
 			{
-				int32_t binormalIndex = index;
-				if (binormalElement->GetReferenceMode() != FbxGeometryElement::eDirect)
-				{
-					binormalIndex = binormalElement->GetIndexArray().GetAt(index);
-				}
-				currentBinormal = binormalElement->GetDirectArray().GetAt(binormalIndex);
-				binormals[index * 3 + 0] = static_cast<float>(currentBinormal[0]);
-				binormals[index * 3 + 1] = static_cast<float>(currentBinormal[1]);
-				binormals[index * 3 + 2] = static_cast<float>(currentBinormal[2]);
+				tangentIndex = tangentElement->GetIndexArray().GetAt(index);
 			}
+			currentTangent = tangentElement->GetDirectArray().GetAt(tangentIndex);
+			importMesh->inputTangents.push_back(static_cast<float>(currentTangent[0]));
+			importMesh->inputTangents.push_back(static_cast<float>(currentTangent[1]));
+			importMesh->inputTangents.push_back(static_cast<float>(currentTangent[2]));
+		}
+	}
+
+	if (mesh->GetElementBinormalCount() > 0 && mesh->GetElementBinormal(0)->GetMappingMode() == FbxGeometryElement::eByControlPoint)
+	{
+		const FbxGeometryElementBinormal* binormalElement = mesh->GetElementBinormal(0);
 
-			// Save the UV.
-			if (mesh->GetElementUVCount() > 0)
+		FbxVector4 currentBinormal;
+
+		for (int32_t index = 0; index < mesh->GetControlPointsCount(); ++index)
+		{
+			int32_t binormalIndex = index;
+			if (binormalElement->GetReferenceMode() != FbxGeometryElement::eDirect)
+			{
+				binormalIndex = binormalElement->GetIndexArray().GetAt(index);
+			}
+			currentBinormal = binormalElement->GetDirectArray().GetAt(binormalIndex);
+			importMesh->inputBitangents.push_back(static_cast<float>(currentBinormal[0]));
+			importMesh->inputBitangents.push_back(static_cast<float>(currentBinormal[1]));
+			importMesh->inputBitangents.push_back(static_cast<float>(currentBinormal[2]));
+		}
+	}
+
+	// Texture coordinates of the first set
+
+	FbxStringList uvNames;
+	mesh->GetUVSetNames(uvNames);
+
+	if (mesh->GetElementUVCount() > 0 && mesh->GetElementUV(0)->GetMappingMode() != FbxGeometryElement::eNone && uvNames.GetCount())
+	{
+		const FbxGeometryElementUV* uvElement = mesh->GetElementUV(0);
+		const char * uvName = uvNames[0];
+
+		FbxVector2 currentUV;
+
+		importMesh->texCoordsByControlPoint = uvElement->GetMappingMode() == FbxGeometryElement::eByControlPoint;
+
+		if (importMesh->texCoordsByControlPoint)
+		{
+			for (int32_t index = 0; index < mesh->GetControlPointsCount(); ++index)
 			{
 				int32_t uvIndex = index;
 				if (uvElement->GetReferenceMode() != FbxGeometryElement::eDirect)
@@ -1231,113 +1004,136 @@ MeshSP FbxEntityFactory::processMesh(FbxMesh* mesh)
 					uvIndex = uvElement->GetIndexArray().GetAt(index);
 				}
 				currentUV = uvElement->GetDirectArray().GetAt(uvIndex);
-				texCoords[index * 2 + 0] = static_cast<float>(currentUV[0]);
-				texCoords[index * 2 + 1] = static_cast<float>(currentUV[1]);
+				importMesh->inputTexCoords.push_back(static_cast<float>(currentUV[0]));
+				importMesh->inputTexCoords.push_back(static_cast<float>(currentUV[1]));
+			}
+		}
+		else
+		{
+			bool unmapped;
+
+			for (int32_t polygonIndex = 0; polygonIndex < polygonCount; ++polygonIndex)
+			{
+				for (int32_t verticeIndex = 0; verticeIndex < mesh->GetPolygonSize(polygonIndex); ++verticeIndex)
+				{
+					mesh->GetPolygonVertexUV(polygonIndex, verticeIndex, uvName, currentUV, unmapped);
+					importMesh->inputTexCoords.push_back(static_cast<float>(currentUV[0]));
+					importMesh->inputTexCoords.push_back(static_cast<float>(currentUV[1]));
+				}
 			}
 		}
 	}
 
-	if (!allByControlPoint)
-	{
-		indicesToOrgIndices = new uint32_t[numberIndices];
+	processSkin(mesh, *importMesh);
 
-		mesh->SetUserDataPtr(indicesToOrgIndices);
-	}
-	else
+	allImportMeshes.push_back(importMesh);
+
+	allImportMeshIndices[mesh] = static_cast<int32_t>(allImportMeshes.size()) - 1;
+
+	return allImportMeshIndices[mesh];
+}
+
+void FbxEntityFactory::processSkin(FbxMesh* mesh, ImportMesh& importMesh) const
+{
+	int32_t numberDeformers = mesh->GetDeformerCount(FbxDeformer::eSkin);
+
+	if (numberDeformers == 0 || numberDeformers > 1)
 	{
-		mesh->SetUserDataPtr(0);
+		if (numberDeformers > 1)
+		{
+			glusLogPrint(GLUS_LOG_ERROR, "Number of deformers not supported: %d", numberDeformers);
+		}
+
+		return;
 	}
 
-	// Populate the array with indices
-	uint32_t vertexCount = 0;
-	for (int32_t polygonIndex = 0; polygonIndex < mesh->GetPolygonCount(); ++polygonIndex)
+	FbxSkin* skinDeformer = (FbxSkin*)mesh->GetDeformer(0, FbxDeformer::eSkin);
+
+	int32_t numberClusters = skinDeformer->GetClusterCount();
+
+	for (int32_t clusterIndex = 0; clusterIndex < numberClusters; clusterIndex++)
 	{
-		int32_t materialIndex = 0;
-		if (materialIndice && materialMappingMode == FbxGeometryElement::eByPolygon)
+		FbxCluster* cluster = skinDeformer->GetCluster(clusterIndex);
+
+		FbxNode* linkNode = cluster->GetLink();
+
+		if (!linkNode)
 		{
-			materialIndex = materialIndice->GetAt(polygonIndex);
+			glusLogPrint(GLUS_LOG_WARNING, "No link node");
+
+			continue;
 		}
 
-		// Store indices with same material together
-		uint32_t indexOffset = currentFbxSubMeshes[materialIndex]->getIndicesOffset() + currentFbxSubMeshes[materialIndex]->getAndIncreaseStoredIndices();
+		ImportSkinCluster importSkinCluster;
+
+		importSkinCluster.jointName = linkNode->GetName();
+
+		int32_t numberIndices = cluster->GetControlPointIndicesCount();
 
-		for (int32_t verticeIndex = 0; verticeIndex < 3; ++verticeIndex)
+		for (int32_t indicesIndex = 0; indicesIndex < numberIndices; indicesIndex++)
 		{
-			const int controlPointIndex = mesh->GetPolygonVertex(polygonIndex, verticeIndex);
+			importSkinCluster.controlPointIndices.push_back(cluster->GetControlPointIndices()[indicesIndex]);
+			importSkinCluster.weights.push_back(static_cast<float>(cluster->GetControlPointWeights()[indicesIndex]));
+		}
 
-			if (allByControlPoint)
-			{
-				indices[indexOffset + verticeIndex] = static_cast<uint32_t>(controlPointIndex);
-			}
-			else
-			{
-				indices[indexOffset + verticeIndex] = vertexCount;
-				indicesToOrgIndices[indexOffset + verticeIndex] = static_cast<uint32_t>(controlPointIndex);
+		// Pose / Link Matrix
 
-				currentVertex = controlPoints[controlPointIndex];
-				vertices[vertexCount * 4 + 0] = static_cast<float>(currentVertex[0]);
-				vertices[vertexCount * 4 + 1] = static_cast<float>(currentVertex[1]);
-				vertices[vertexCount * 4 + 2] = static_cast<float>(currentVertex[2]);
-				vertices[vertexCount * 4 + 3] = 1.0f;
+		FbxAMatrix matrix;
 
-				if (hasNormal)
-				{
-					mesh->GetPolygonVertexNormal(polygonIndex, verticeIndex, currentNormal);
-					normals[vertexCount * 3 + 0] = static_cast<float>(currentNormal[0]);
-					normals[vertexCount * 3 + 1] = static_cast<float>(currentNormal[1]);
-					normals[vertexCount * 3 + 2] = static_cast<float>(currentNormal[2]);
-				}
+		cluster->GetTransformMatrix(matrix);
 
-				if (hasUV)
-				{
-					bool unmapped;
+		float tm[16] = { static_cast<float>(matrix.Get(0, 0)), static_cast<float>(matrix.Get(0, 1)), static_cast<float>(matrix.Get(0, 2)), static_cast<float>(matrix.Get(0, 3)), static_cast<float>(matrix.Get(1, 0)), static_cast<float>(matrix.Get(1, 1)), static_cast<float>(matrix.Get(1, 2)), static_cast<float>(matrix.Get(1, 3)), static_cast<float>(matrix.Get(2, 0)), static_cast<float>(matrix.Get(2, 1)), static_cast<float>(matrix.Get(2, 2)), static_cast<float>(matrix.Get(2, 3)), static_cast<float>(matrix.Get(3, 0)), static_cast<float>(matrix.Get(3, 1)), static_cast<float>(matrix.Get(3, 2)), static_cast<float>(matrix.Get(3, 3)) };
 
-					mesh->GetPolygonVertexUV(polygonIndex, verticeIndex, uvName, currentUV, unmapped);
-					texCoords[vertexCount * 2 + 0] = static_cast<float>(currentUV[0]);
-					texCoords[vertexCount * 2 + 1] = static_cast<float>(currentUV[1]);
-				}
-			}
-			vertexCount++;
-		}
-	}
+		Matrix4x4 transformMatrix(tm);
+		cluster->GetTransformLinkMatrix(matrix);
 
-	map<int32_t, SubMeshSP> currentSubMeshes;
+		float tlm[16] = { static_cast<float>(matrix.Get(0, 0)), static_cast<float>(matrix.Get(0, 1)), static_cast<float>(matrix.Get(0, 2)), static_cast<float>(matrix.Get(0, 3)), static_cast<float>(matrix.Get(1, 0)), static_cast<float>(matrix.Get(1, 1)), static_cast<float>(matrix.Get(1, 2)), static_cast<float>(matrix.Get(1, 3)), static_cast<float>(matrix.Get(2, 0)), static_cast<float>(matrix.Get(2, 1)), static_cast<float>(matrix.Get(2, 2)), static_cast<float>(matrix.Get(2, 3)), static_cast<float>(matrix.Get(3, 0)), static_cast<float>(matrix.Get(3, 1)), static_cast<float>(matrix.Get(3, 2)), static_cast<float>(matrix.Get(3, 3)) };
 
-	auto walker = currentFbxSubMeshes.begin();
+		Matrix4x4 transformLinkMatrix(tlm);
 
-	while (walker != currentFbxSubMeshes.end())
-	{
-		currentSubMeshes[walker->first] = SubMeshSP(new SubMesh(walker->second->getIndicesOffset(), walker->second->getTriangleCount()));
+		//
 
-		walker->second.reset();
-		walker++;
+		Matrix4x4 inverseTransformLinkMatrix = transformLinkMatrix;
+		inverseTransformLinkMatrix.inverseRigidBody();
+
+		importSkinCluster.inverseBindMatrix = inverseTransformLinkMatrix * transformMatrix;
+
+		importMesh.skinClusters.push_back(importSkinCluster);
 	}
-	currentFbxSubMeshes.clear();
+}
 
-	// Create tangents and bitangents when not already created
-	if (!tangents)
+void FbxEntityFactory::createNodes()
+{
+	allMeshes.clear();
+
+	for (auto& currentImportMesh : allImportMeshes)
 	{
-		GLUSshape meshShape;
-		meshShape.mode = GL_TRIANGLES;
-		meshShape.numberVertices = numberVertices;
-		meshShape.vertices = vertices;
-		meshShape.normals = normals;
-		meshShape.bitangents = binormals;
-		meshShape.tangents = tangents;
-		meshShape.texCoords = texCoords;
-		meshShape.numberIndices = numberIndices;
-		meshShape.indices = indices;
-		meshShape.allAttributes = 0;
+		allMeshes.push_back(importConverter.createMesh(*currentImportMesh));
+	}
 
-		glusShapeCalculateTangentBitangentf(&meshShape);
+	for (auto& currentImportNode : allImportNodes)
+	{
+		MeshSP newMesh;
 
-		binormals = meshShape.bitangents;
-		tangents = meshShape.tangents;
-	}
+		if (currentImportNode.meshIndex >= 0)
+		{
+			newMesh = allMeshes[currentImportNode.meshIndex];
+		}
 
-	glusLogPrint(GLUS_LOG_INFO, "Created mesh: %s", meshName.c_str());
+		vector<AnimationStackSP> allAnimationStacks;
 
-	return MeshSP(new Mesh(meshName, numberVertices, vertices, normals, binormals, tangents, texCoords, numberIndices, indices, currentSubMeshes, currentSurfaceMaterials));
+		for (auto animationStackIndex : currentImportNode.animationStackIndices)
+		{
+			if (allImportAnimationStacks[animationStackIndex]->animationStack.get())
+			{
+				allAnimationStacks.push_back(allImportAnimationStacks[animationStackIndex]->animationStack);
+			}
+		}
+
+		nodeTreeFactory.createNode(currentImportNode.name, currentImportNode.parentName, currentImportNode.translate, currentImportNode.rotateOffset, currentImportNode.rotatePivot, currentImportNode.preRotate, currentImportNode.rotate, currentImportNode.postRotate, currentImportNode.scaleOffset, currentImportNode.scalePivot, currentImportNode.scale, currentImportNode.geoTranslate, currentImportNode.geoRotate, currentImportNode.geoScale, newMesh, currentImportNode.camera, currentImportNode.light, allAnimationStacks);
+
+		glusLogPrint(GLUS_LOG_INFO, "Created node: %s", currentImportNode.name.c_str());
+	}
 }
 
 LightSP FbxEntityFactory::processLight(FbxLight* light)
@@ -1623,10 +1419,14 @@ void FbxEntityFactory::postTraverseNode(FbxNode* node, const NodeSP& nodeGE, con
 
 				matrix = newParentMatrix * nodeGE->getGeometricTransformMatrix();
 
-				// Update the min max for the final bounding sphere
-				processMinMax(nodeGE->getMesh()->getVertices(), nodeGE->getMesh()->getNumberVertices(), matrix);
+				// The mesh is missing, if the conversion failed.
+				if (nodeGE->getMesh().get())
+				{
+					// Update the min max for the final bounding sphere
+					processMinMax(nodeGE->getMesh()->getVertices(), nodeGE->getMesh()->getNumberVertices(), matrix);
 
-				postProcessMesh(node->GetMesh(), nodeGE->getMesh());
+					postProcessMesh(node->GetMesh(), nodeGE->getMesh());
+				}
 			}
 		break;
 
@@ -1749,299 +1549,46 @@ void FbxEntityFactory::processMinMax(const float* vertices, int32_t numberVertic
 
 void FbxEntityFactory::postProcessMesh(FbxMesh* mesh, const MeshSP& currentMesh)
 {
-	if (!currentMesh.get())
-	{
-		return;
-	}
+	auto walkerMesh = allImportMeshIndices.find(mesh);
 
-	float* allBoneIndices0 = new float[4 * currentMesh->getNumberVertices()];
-
-	if (!allBoneIndices0)
+	if (!currentMesh.get() || walkerMesh == allImportMeshIndices.end())
 	{
-		glusLogPrint(GLUS_LOG_ERROR, "Out of memory");
-
 		return;
 	}
 
-	float* allBoneIndices1 = new float[4 * currentMesh->getNumberVertices()];
+	ImportMesh& importMesh = *allImportMeshes[walkerMesh->second];
 
-	if (!allBoneIndices1)
+	// No skin or already added by another instance.
+	if (!importMesh.boneCounters)
 	{
-		glusLogPrint(GLUS_LOG_ERROR, "Out of memory");
-
-		delete[] allBoneIndices0;
-
 		return;
 	}
 
-	float* allBoneWeights0 = new float[4 * currentMesh->getNumberVertices()];
+	vector<int32_t> jointIndices;
 
-	if (!allBoneWeights0)
+	for (auto& currentCluster : importMesh.skinClusters)
 	{
-		glusLogPrint(GLUS_LOG_ERROR, "Out of memory");
-
-		delete[] allBoneIndices0;
-
-		delete[] allBoneIndices1;
-
-		return;
-	}
-
-	float* allBoneWeights1 = new float[4 * currentMesh->getNumberVertices()];
+		int32_t boneIndex = nodeTreeFactory.getIndex(currentCluster.jointName);
 
-	if (!allBoneWeights1)
-	{
-		glusLogPrint(GLUS_LOG_ERROR, "Out of memory");
-
-		delete[] allBoneIndices0;
-
-		delete[] allBoneIndices1;
-
-		delete[] allBoneWeights0;
-
-		return;
-	}
-
-	float* allBoneCounters = new float[currentMesh->getNumberVertices()];
-
-	if (!allBoneCounters)
-	{
-		glusLogPrint(GLUS_LOG_ERROR, "Out of memory");
-
-		delete[] allBoneIndices0;
-
-		delete[] allBoneIndices1;
-
-		delete[] allBoneWeights0;
-
-		delete[] allBoneWeights0;
-
-		return;
-	}
-
-	for (uint32_t i = 0; i < 4 * currentMesh->getNumberVertices(); i++)
-	{
-		allBoneIndices0[i] = 0.0f;
-		allBoneIndices1[i] = 0.0f;
-		allBoneWeights0[i] = 0.0f;
-		allBoneWeights1[i] = 0.0f;
-	}
-
-	for (uint32_t i = 0; i < currentMesh->getNumberVertices(); i++)
-	{
-		allBoneCounters[i] = 0.0f;
-	}
-
-	//
-
-	int32_t numberDeformers = mesh->GetDeformerCount(FbxDeformer::eSkin);
-
-	if (numberDeformers == 0 || numberDeformers > 1)
-	{
-		if (numberDeformers > 1)
+		if (boneIndex == -1)
 		{
-			glusLogPrint(GLUS_LOG_ERROR, "Number of deformers not supported: %d", numberDeformers);
+			glusLogPrint(GLUS_LOG_WARNING, "No bone found: %s", currentCluster.jointName.c_str());
 		}
-
-		delete[] allBoneIndices0;
-		delete[] allBoneIndices1;
-
-		delete[] allBoneWeights0;
-		delete[] allBoneWeights1;
-
-		delete[] allBoneCounters;
-
-		return;
-	}
-
-	for (int32_t deformerIndex = 0; deformerIndex < numberDeformers; deformerIndex++)
-	{
-		FbxSkin* skinDeformer = (FbxSkin*)mesh->GetDeformer(deformerIndex, FbxDeformer::eSkin);
-
-		int32_t numberClusters = skinDeformer->GetClusterCount();
-
-		for (int32_t clusterIndex = 0; clusterIndex < numberClusters; clusterIndex++)
+		else
 		{
-			FbxCluster* cluster = skinDeformer->GetCluster(clusterIndex);
-
-			FbxNode* linkNode = cluster->GetLink();
-
-			if (!linkNode)
-			{
-				glusLogPrint(GLUS_LOG_WARNING, "No link node");
-
-				continue;
-			}
-
-			int32_t boneIndex = nodeTreeFactory.getIndex(linkNode->GetName());
-
-			if (boneIndex == -1)
-			{
-				glusLogPrint(GLUS_LOG_WARNING, "No bone found: %s", linkNode->GetName());
-
-				continue;
-			}
-
-			int32_t numberIndices = cluster->GetControlPointIndicesCount();
-
-			for (int32_t indicesIndex = 0; indicesIndex < numberIndices; indicesIndex++)
-			{
-				int32_t controlPointIndex = cluster->GetControlPointIndices()[indicesIndex];
-
-				if (controlPointIndex < 0)
-				{
-					continue;
-				}
-
-				if (mesh->GetUserDataPtr())
-				{
-					uint32_t* indicesToOrgIndices = static_cast<uint32_t*>(mesh->GetUserDataPtr());
-
-					for (uint32_t newIndex = 0; newIndex < currentMesh->getNumberIndices(); newIndex++)
-					{
-						if (indicesToOrgIndices[newIndex] != static_cast<uint32_t>(controlPointIndex))
-						{
-							continue;
-						}
-
-						int32_t mappedControlPointIndex = newIndex;
-
-						if (static_cast<int32_t>(allBoneCounters[mappedControlPointIndex]) + 1 == MAX_SKIN_INDICES)
-						{
-							glusLogPrint(GLUS_LOG_ERROR, "Too many indices: %d", (static_cast<int32_t>(allBoneCounters[mappedControlPointIndex]) + 1));
-
-							delete[] allBoneIndices0;
-							delete[] allBoneIndices1;
-
-							delete[] allBoneWeights0;
-							delete[] allBoneWeights1;
-
-							delete[] allBoneCounters;
-
-							return;
-						}
-
-						double boneWeight = cluster->GetControlPointWeights()[indicesIndex];
-
-						int32_t offset = static_cast<int32_t>(allBoneCounters[mappedControlPointIndex]);
-
-						if (static_cast<int32_t>(allBoneCounters[mappedControlPointIndex]) < 4)
-						{
-							allBoneIndices0[4 * mappedControlPointIndex + offset] = static_cast<float>(boneIndex);
-							allBoneWeights0[4 * mappedControlPointIndex + offset] = static_cast<float>(boneWeight);
-						}
-						else
-						{
-							allBoneIndices1[4 * mappedControlPointIndex + offset] = static_cast<float>(boneIndex);
-							allBoneWeights1[4 * mappedControlPointIndex + offset] = static_cast<float>(boneWeight);
-						}
-
-						allBoneCounters[mappedControlPointIndex] += 1.0f;
-					}
-				}
-				else
-				{
-					if (static_cast<int32_t>(allBoneCounters[controlPointIndex]) + 1 == MAX_SKIN_INDICES)
-					{
-						glusLogPrint(GLUS_LOG_ERROR, "Too many indices: %d", (static_cast<int32_t>(allBoneCounters[controlPointIndex]) + 1));
-
-						delete[] allBoneIndices0;
-
-						delete[] allBoneIndices1;
-
-						delete[] allBoneWeights0;
-
-						delete[] allBoneWeights1;
-
-						delete[] allBoneCounters;
-
-						return;
-					}
-
-					double boneWeight = cluster->GetControlPointWeights()[indicesIndex];
-
-					int32_t offset = static_cast<int32_t>(allBoneCounters[controlPointIndex]);
-
-					if (static_cast<int32_t>(allBoneCounters[controlPointIndex]) < 4)
-					{
-						allBoneIndices0[4 * controlPointIndex + offset] = static_cast<float>(boneIndex);
-						allBoneWeights0[4 * controlPointIndex + offset] = static_cast<float>(boneWeight);
-					}
-					else
-					{
-						allBoneIndices1[4 * controlPointIndex + offset] = static_cast<float>(boneIndex);
-						allBoneWeights1[4 * controlPointIndex + offset] = static_cast<float>(boneWeight);
-					}
-
-					allBoneCounters[controlPointIndex] += 1.0f;
-				}
-			}
-
-			// Pose / Link Matrix
-
-			FbxAMatrix matrix;
-
-
-			cluster->GetTransformMatrix(matrix);
-
-			float tm[16] = { static_cast<float>(matrix.Get(0, 0)), static_cast<float>(matrix.Get(0, 1)), static_cast<float>(matrix.Get(0, 2)), static_cast<float>(matrix.Get(0, 3)), static_cast<float>(matrix.Get(1, 0)), static_cast<float>(matrix.Get(1, 1)), static_cast<float>(matrix.Get(1, 2)), static_cast<float>(matrix.Get(1, 3)), static_cast<float>(matrix.Get(2, 0)), static_cast<float>(matrix.Get(2, 1)), static_cast<float>(matrix.Get(2, 2)), static_cast<float>(matrix.Get(2, 3)), static_cast<float>(matrix.Get(3, 0)), static_cast<float>(matrix.Get(3, 1)), static_cast<float>(matrix.Get(3, 2)), static_cast<float>(matrix.Get(3, 3)) };
-
-			Matrix4x4 transformMatrix(tm);
-			cluster->GetTransformLinkMatrix(matrix);
-
-			float tlm[16] = { static_cast<float>(matrix.Get(0, 0)), static_cast<float>(matrix.Get(0, 1)), static_cast<float>(matrix.Get(0, 2)), static_cast<float>(matrix.Get(0, 3)), static_cast<float>(matrix.Get(1, 0)), static_cast<float>(matrix.Get(1, 1)), static_cast<float>(matrix.Get(1, 2)), static_cast<float>(matrix.Get(1, 3)), static_cast<float>(matrix.Get(2, 0)), static_cast<float>(matrix.Get(2, 1)), static_cast<float>(matrix.Get(2, 2)), static_cast<float>(matrix.Get(2, 3)), static_cast<float>(matrix.Get(3, 0)), static_cast<float>(matrix.Get(3, 1)), static_cast<float>(matrix.Get(3, 2)), static_cast<float>(matrix.Get(3, 3)) };
-
-			Matrix4x4 transformLinkMatrix(tlm);
-
-			//
-
-			Matrix4x4 inverseTransformLinkMatrix = transformLinkMatrix;
-			inverseTransformLinkMatrix.inverseRigidBody();
-
-			nodeTreeFactory.setInverseBindMatrix(linkNode->GetName(), inverseTransformLinkMatrix * transformMatrix);
+			nodeTreeFactory.setInverseBindMatrix(currentCluster.jointName, currentCluster.inverseBindMatrix);
 		}
+
+		jointIndices.push_back(boneIndex);
 	}
 
-	currentMesh->addSkinningData(allBoneIndices0, allBoneIndices1, allBoneWeights0, allBoneWeights1, allBoneCounters);
+	importConverter.addSkinningData(importMesh, jointIndices, currentMesh);
 }
 
-void FbxEntityFactory::traverseDeleteUserPointer(FbxNode* node)
+void FbxEntityFactory::clearImportJobs()
 {
-	FbxNodeAttribute::EType attributeType;
-
-	if (node->GetNodeAttribute())
-	{
-		attributeType = node->GetNodeAttribute()->GetAttributeType();
-	}
-	else
-	{
-		attributeType = FbxNodeAttribute::eNull;
-	}
-
-	switch (attributeType)
-	{
-		case FbxNodeAttribute::eMesh:
-		{
-			FbxMesh* mesh = node->GetMesh();
-
-			if (mesh && mesh->GetUserDataPtr())
-			{
-				uint32_t* indicesToOrgIndices = static_cast<uint32_t*>(mesh->GetUserDataPtr());
-
-				delete[] indicesToOrgIndices;
-
-				mesh->SetUserDataPtr(0);
-			}
-		}
-		break;
-
-		default:
-			// Do nothing
-		break;
-	};
-
-	for (int i = 0; i < node->GetChildCount(); i++)
-	{
-		traverseDeleteUserPointer(node->GetChild(i));
-	}
+	allImportNodes.clear();
+	allImportMeshes.clear();
+	allImportMeshIndices.clear();
+	allImportAnimationStacks.clear();
 }
@@ -16,12 +16,71 @@
 #include "../../layer2/material/SurfaceMaterial.h"
 #include "../../layer3/animation/AnimationStack.h"
 #include "../../layer3/camera/Camera.h"
+#include "../../layer3/import/ImportConverter.h"
 #include "../../layer3/light/Light.h"
 #include "../../layer3/mesh/Mesh.h"
 #include "../../layer5/node/Node.h"
 #include "../../layer5/node/NodeTreeFactory.h"
 #include "../../layer8/modelentity/ModelEntity.h"
 
+/**
+ * Node found by the walk over the scene. The mesh and the animation stacks are referenced by their job index, as they are
+ * created after the conversion.
+ */
+struct FbxImportNode
+{
+	std::string name;
+
+	std::string parentName;
+
+	float translate[3];
+	float rotateOffset[3];
+	float rotatePivot[3];
+	float preRotate[3];
+	float rotate[3];
+	float postRotate[3];
+	float scaleOffset[3];
+	float scalePivot[3];
+	float scale[3];
+	float geoTranslate[3];
+	float geoRotate[3];
+	float geoScale[3];
+
+	// Minus one, if the node has no mesh.
+	std::int32_t meshIndex;
+
+	CameraSP camera;
+
+	LightSP light;
+
+	std::vector<std::int32_t> animationStackIndices;
+
+	FbxImportNode() :
+		name(), parentName(), meshIndex(-1), camera(), light(), animationStackIndices()
+	{
+		for (std::int32_t i = 0; i < 3; i++)
+		{
+			translate[i] = 0.0f;
+			rotateOffset[i] = 0.0f;
+			rotatePivot[i] = 0.0f;
+			preRotate[i] = 0.0f;
+			rotate[i] = 0.0f;
+			postRotate[i] = 0.0f;
+			scaleOffset[i] = 0.0f;
+			scalePivot[i] = 0.0f;
+			scale[i] = 1.0f;
+			geoTranslate[i] = 0.0f;
+			geoRotate[i] = 0.0f;
+			geoScale[i] = 1.0f;
+		}
+	}
+};
+
+/**
+ * Imports in two phases. A serial walk over the scene collects the nodes, meshes and animation curves, as the FBX SDK is
+ * not thread safe. The meshes and animation stacks are then converted on the worker threads and merged into the node tree
+ * in the order of the walk.
+ */
 class FbxEntityFactory
 {
 
@@ -31,14 +90,16 @@ private:
 
 	FbxManager* manager;
 	FbxIOSettings* ioSettings;
-	FbxGeometryConverter* geometryConverter;
 	FbxArray<FbxString*> animStackNameArray;
 
 	NodeTreeFactory nodeTreeFactory;
 
 	std::map<std::int32_t, SurfaceMaterialSP> currentSurfaceMaterials;
 	std::vector<SurfaceMaterialSP> allSurfaceMaterials;
-	std::vector<AnimationStackSP> allAnimationStacks;
+	std::vector<FbxImportNode> allImportNodes;
+	std::vector<ImportMeshSP> allImportMeshes;
+	std::map<FbxMesh*, std::int32_t> allImportMeshIndices;
+	std::vector<ImportAnimationStackSP> allImportAnimationStacks;
 	std::vector<MeshSP> allMeshes;
 	std::vector<CameraSP> allCameras;
 	std::vector<LightSP> allLights;
@@ -61,6 +122,18 @@ private:
 
 	bool loadMesh;
 
+	std::uint32_t numberLods;
+
+	float lodReduction;
+
+	bool mergeStaticNodes;
+
+	float weldEpsilon;
+
+	bool packVertices;
+
+	ImportConverter importConverter;
+
 private:
 
 	bool traverseScene(FbxScene* scene);
@@ -71,11 +144,26 @@ private:
 
 	FbxDouble3 processMaterialProperty(const FbxSurfaceMaterial* Material, const char* propertyName, const char* factorPropertyName, const FbxDouble3& defaultColor, Texture2DSP& texture) const;
 
-	void traverseNode(FbxNode* node, const NodeSP& parentNode);
+	void traverseNode(FbxNode* node, const std::string& parentNodeName);
+
+	/**
+	 * @return The index of the animation job or minus one.
+	 */
+	std::int32_t processAnimation(FbxNode* node, std::int32_t animStackIndex);
 
-	AnimationStackSP processAnimation(FbxNode* node, std::int32_t animStackIndex);
+	void processAnimationCurve(FbxAnimCurve* animCurve, ImportAnimationCurve& importAnimationCurve) const;
 
-	MeshSP processMesh(FbxMesh* mesh);
+	/**
+	 * @return The index of the mesh job. Nodes instancing the same mesh share one job.
+	 */
+	std::int32_t processMesh(FbxMesh* mesh);
+
+	void processSkin(FbxMesh* mesh, ImportMesh& importMesh) const;
+
+	/**
+	 * Creates the converted meshes and the nodes in the order of the walk.
+	 */
+	void createNodes();
 
 	LightSP processLight(FbxLight* light);
 
@@ -89,7 +177,7 @@ private:
 
 	void postProcessMesh(FbxMesh* mesh, const MeshSP& currentMesh);
 
-	void traverseDeleteUserPointer(FbxNode* node);
+	void clearImportJobs();
 
 	ModelEntitySP loadFbxFile(const std::string& name, const std::string& filename, float scale, bool globalAnisotropic, const SurfaceMaterialSP& overwriteSurfaceMaterial);
 
@@ -102,6 +190,28 @@ public:
 
 	ModelEntitySP loadFbxSceneFile(const std::string& name, const std::string& filename, float scale, bool globalAnisotropic = false);
 
+	/**
+	 * Creates for each imported mesh the given number of levels of detail. One disables the simplification.
+	 */
+	void setLevelsOfDetail(std::uint32_t numberLods, float lodReduction);
+
+	/**
+	 * Merges static, not animated child nodes into their parent node to reduce the number of draws. Disabled by default.
+	 */
+	void setMergeStaticNodes(bool mergeStaticNodes);
+
+	/**
+	 * Merges vertices of an imported mesh, whose attributes all differ by at most the epsilon. Zero by default, which only
+	 * merges identical vertices. Negative disables the welding.
+	 */
+	void setWeldEpsilon(float weldEpsilon);
+
+	/**
+	 * Packs the vertices of each imported mesh into one interleaved and quantized buffer, which saves memory and bandwidth.
+	 * Done after merging the static nodes. Disabled by default.
+	 */
+	void setPackVertices(bool packVertices);
+
 };
 
 #endif /* FBXENTITYFACTORY_H_ */
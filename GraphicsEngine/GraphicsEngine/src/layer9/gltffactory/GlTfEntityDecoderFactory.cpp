@@ -9,15 +9,17 @@
 #include "../../layer2/interpolation/ConstantInterpolator.h"
 #include "../../layer2/interpolation/CubicInterpolator.h"
 #include "../../layer2/interpolation/LinearInterpolator.h"
-#include "../../layer1/texture/Texture2DManager.h"
+#include "../../layer1/texture/TextureUploadManager.h"
 #include "../../layer3/mesh/Mesh.h"
+#include "../../layer3/mesh/MeshFactory.h"
+#include "../../layer6/model/ModelManager.h"
 
 #include "GlTfEntityDecoderFactory.h"
 
 using namespace std;
 
 GlTfEntityDecoderFactory::GlTfEntityDecoderFactory() :
-		doReset(true), minX(0.0f), maxX(0.0f), minY(0.0f), maxY(0.0f), minZ(0.0f), maxZ(0.0f), nodeTreeFactory(), animated(false), skinned(false)
+		doReset(true), minX(0.0f), maxX(0.0f), minY(0.0f), maxY(0.0f), minZ(0.0f), maxZ(0.0f), nodeTreeFactory(), animated(false), skinned(false), numberLods(1), lodReduction(0.5f), mergeStaticNodes(false), weldEpsilon(0.0f), packVertices(false), allDependencyFilenames()
 {
 }
 
@@ -80,6 +82,8 @@ bool GlTfEntityDecoderFactory::decodeBuffers(const JSONobjectSP& jsonGlTf, const
 
 		allBuffers[currentKey->getValue()] = binaryfile;
 
+		allDependencyFilenames.push_back(folderName + currentUri->getValue());
+
 		//
 
 		currentValue = currentBuffer->getValue(byteLengthString);
@@ -351,9 +355,6 @@ bool GlTfEntityDecoderFactory::decodeImages(const JSONobjectSP& jsonGlTf, const
 
 	JSONstringSP uriString = JSONstringSP(new JSONstring("uri"));
 
-	GLUStgaimage tgaimage;
-	GLUShdrimage hdrimage;
-
 	string extension;
 
 	for (auto& currentKey : imagesObject->getAllKeys())
@@ -388,32 +389,12 @@ bool GlTfEntityDecoderFactory::decodeImages(const JSONobjectSP& jsonGlTf, const
 
 		transform(extension.begin(), extension.end(), extension.begin(), ::tolower);
 
-		if (extension == "tga")
-		{
-			glusLogPrint(GLUS_LOG_INFO, "Loading image '%s'", (folderName + currentUri->getValue()).c_str());
-
-			if (!glusImageLoadTga((GLUSchar*)(folderName + currentUri->getValue()).c_str(), &tgaimage))
-			{
-				return false;
-			}
-
-			allTgaImages[currentKey->getValue()] = tgaimage;
-		}
-		else if (extension == "hdr")
-		{
-			glusLogPrint(GLUS_LOG_INFO, "Loading image '%s'", (folderName + currentUri->getValue()).c_str());
-
-			if (!glusImageLoadHdr((GLUSchar*)(folderName + currentUri->getValue()).c_str(), &hdrimage))
-			{
-				return false;
-			}
-
-			allHdrImages[currentKey->getValue()] = hdrimage;
-		}
-		else
+		if (extension != "tga" && extension != "hdr")
 		{
 			return false;
 		}
+
+		allImageFilenames[currentKey->getValue()] = folderName + currentUri->getValue();
 	}
 
 	return true;
@@ -562,10 +543,6 @@ bool GlTfEntityDecoderFactory::decodeTextures(const JSONobjectSP& jsonGlTf)
 			return false;
 		}
 
-		JSONnumberSP currentFormat = dynamic_pointer_cast<JSONnumber>(currentValue);
-
-		GLenum format = (GLenum)currentFormat->getIntegerValue();
-
 		//
 
 		currentValue = currentTexture->getValue(internalFormatString);
@@ -622,10 +599,6 @@ bool GlTfEntityDecoderFactory::decodeTextures(const JSONobjectSP& jsonGlTf)
 			return false;
 		}
 
-		JSONnumberSP currentType = dynamic_pointer_cast<JSONnumber>(currentValue);
-
-		GLenum type = (GLenum)currentType->getIntegerValue();
-
 		//
 
 		currentValue = currentTexture->getValue(sourceString);
@@ -637,39 +610,15 @@ bool GlTfEntityDecoderFactory::decodeTextures(const JSONobjectSP& jsonGlTf)
 		JSONstringSP currentSource = dynamic_pointer_cast<JSONstring>(currentValue);
 
 
-		Texture2DSP texture2D;
-
-		uint32_t sizeOfData;
-
-		if (allHdrImages.find(currentSource->getValue()) != allHdrImages.end())
+		if (allImageFilenames.find(currentSource->getValue()) == allImageFilenames.end())
 		{
-			const GLUShdrimage& hdrImage = allHdrImages[currentSource->getValue()];
-
-			sizeOfData = 3 * sizeof(GLfloat) * hdrImage.width * hdrImage.height;
-
-			texture2D = Texture2DManager::getInstance()->createTexture(currentKey->getValue(), internalFormat, hdrImage.width, hdrImage.height, format, type, (const uint8_t*)hdrImage.data, sizeOfData, true, sampler->getMinFilter(), sampler->getMagFilter(), sampler->getWrapS(), sampler->getWrapT(), 1.0f);
+			return false;
 		}
-		else if (allTgaImages.find(currentSource->getValue()) != allTgaImages.end())
-		{
-			const GLUStgaimage& tgaImage = allTgaImages[currentSource->getValue()];
 
-			sizeOfData = sizeof(GLubyte) * tgaImage.width * tgaImage.height;
+		bool sRGB = internalFormat == GL_SRGB8 || internalFormat == GL_SRGB8_ALPHA8;
 
-			if (tgaImage.format == GL_RGB)
-			{
-				sizeOfData *= 3;
-			}
-			else if (tgaImage.format == GL_RGBA)
-			{
-				sizeOfData *= 4;
-			}
-
-			texture2D = Texture2DManager::getInstance()->createTexture(currentKey->getValue(), internalFormat, tgaImage.width, tgaImage.height, format, type, (const uint8_t*)tgaImage.data, sizeOfData, true, sampler->getMinFilter(), sampler->getMagFilter(), sampler->getWrapS(), sampler->getWrapT(), 1.0f);
-		}
-		else
-		{
-			return false;
-		}
+		// Shared with other models using the same image.
+		Texture2DSP texture2D = TextureUploadManager::getInstance()->loadTexture2D(allImageFilenames[currentSource->getValue()], sRGB, MipFilterBox, TextureCompressionNone, true, sampler->getMinFilter(), sampler->getMagFilter(), sampler->getWrapS(), sampler->getWrapT(), 1.0f);
 
 		allTextures2D[currentKey->getValue()] = texture2D;
 	}
@@ -2016,6 +1965,12 @@ ModelEntitySP GlTfEntityDecoderFactory::loadGlTfModelFile(const string& identifi
 
 	string completeFilename = folderName + fileName;
 
+	// Check, if we have filename in cache
+	if (ModelManager::getInstance()->containsModelByKey(completeFilename))
+	{
+		return ModelEntitySP(new ModelEntity(identifier, ModelManager::getInstance()->getModelByKey(completeFilename), scale, scale, scale));
+	}
+
 	if (!glusFileLoadText((const GLUSchar*)completeFilename.c_str(), &textfile))
 	{
 		glusLogPrint(GLUS_LOG_ERROR, "Could not load '%s'", completeFilename.c_str());
@@ -2281,6 +2236,16 @@ ModelEntitySP GlTfEntityDecoderFactory::loadGlTfModelFile(const string& identifi
 
 	numberJoints = nodeTreeFactory.createIndex();
 
+	if (mergeStaticNodes)
+	{
+		nodeTreeFactory.mergeStaticNodes(numberLods, lodReduction);
+	}
+
+	if (packVertices)
+	{
+		nodeTreeFactory.packVertices();
+	}
+
 	// Set inverse bind matrices of nodes.
 
 	for (auto& currentSkinPair : allSkins)
@@ -2313,6 +2278,7 @@ ModelEntitySP GlTfEntityDecoderFactory::loadGlTfModelFile(const string& identifi
 	// Create the model.
 
 	ModelSP model = ModelSP(new Model(boundingSphere, rootNode, numberJoints, animated, skinned));
+	ModelManager::getInstance()->setModel(completeFilename, model, allDependencyFilenames);
 
 	// Create the model entity.
 
@@ -2331,6 +2297,27 @@ ModelEntitySP GlTfEntityDecoderFactory::loadGlTfModelFile(const string& identifi
 	return result;
 }
 
+void GlTfEntityDecoderFactory::setLevelsOfDetail(uint32_t numberLods, float lodReduction)
+{
+	this->numberLods = numberLods;
+	this->lodReduction = lodReduction;
+}
+
+void GlTfEntityDecoderFactory::setMergeStaticNodes(bool mergeStaticNodes)
+{
+	this->mergeStaticNodes = mergeStaticNodes;
+}
+
+void GlTfEntityDecoderFactory::setWeldEpsilon(float weldEpsilon)
+{
+	this->weldEpsilon = weldEpsilon;
+}
+
+void GlTfEntityDecoderFactory::setPackVertices(bool packVertices)
+{
+	this->packVertices = packVertices;
+}
+
 void GlTfEntityDecoderFactory::processMinMax(const float* vertices, int32_t numberVertices, const Matrix4x4& matrix)
 {
 	GLfloat vertex[4];
@@ -2506,8 +2493,22 @@ NodeSP GlTfEntityDecoderFactory::buildNode(const NodeSP& parentNode, const GlTfN
 			index++;
 		}
 
+		MeshFactory meshFactory;
+
+		if (weldEpsilon >= 0.0f)
+		{
+			numberVertices = meshFactory.weldVertices(name, numberVertices, vertices, normals, bitangents, tangents, texCoords, boneIndices0, boneIndices1, boneWeights0, boneWeights1, boneCounters, numberIndices, indices, weldEpsilon);
+		}
+
+		meshFactory.optimizeMesh(name, numberVertices, vertices, normals, bitangents, tangents, texCoords, boneIndices0, boneIndices1, boneWeights0, boneWeights1, boneCounters, numberIndices, indices, subMeshes, true, true);
+
 		mesh = MeshSP(new Mesh(name, numberVertices, vertices, normals, bitangents, tangents, texCoords, numberIndices, indices, subMeshes, surfaceMaterials));
 
+		if (numberLods > 1)
+		{
+			mesh->generateLods(numberLods, lodReduction);
+		}
+
 		if (boneIndices0 && boneIndices1 && boneWeights0 && boneWeights1 && boneCounters)
 		{
 			mesh->addSkinningData(boneIndices0, boneIndices1, boneWeights0, boneWeights1, boneCounters);
@@ -2663,18 +2664,9 @@ void GlTfEntityDecoderFactory::cleanUp()
 
 	allAccessors.clear();
 
+	allDependencyFilenames.clear();
 
-	for (auto& currentTgaImage : allTgaImages)
-	{
-		glusImageDestroyTga(&currentTgaImage.second);
-	}
-	allTgaImages.clear();
-
-	for (auto& currentHdrImage : allHdrImages)
-	{
-		glusImageDestroyHdr(&currentHdrImage.second);
-	}
-	allHdrImages.clear();
+	allImageFilenames.clear();
 
 	allSamplers.clear();
 
@@ -45,12 +45,22 @@ private:
 
 	bool skinned;
 
+	std::uint32_t numberLods;
+
+	float lodReduction;
+
+	bool mergeStaticNodes;
+
+	float weldEpsilon;
+
+	bool packVertices;
+
 	std::map<std::string, GLUSbinaryfile> allBuffers;
 	std::map<std::string, GlTfBufferViewSP> allBufferViews;
 	std::map<std::string, GlTfAccessorSP> allAccessors;
 
-	std::map<std::string, GLUStgaimage> allTgaImages;
-	std::map<std::string, GLUShdrimage> allHdrImages;
+	// Decoded by the texture upload manager, so only the filenames are stored.
+	std::map<std::string, std::string> allImageFilenames;
 	std::map<std::string, GlTfSamplerSP> allSamplers;
 	std::map<std::string, Texture2DSP> allTextures2D;
 
@@ -64,6 +74,10 @@ private:
 
 	std::map<std::string, GlTfAnimationSP> allAnimations;
 
+	// Buffer files of the current model, so it is imported again, if one of them changes. Images are reloaded by the
+	// texture managers.
+	std::vector<std::string> allDependencyFilenames;
+
 	bool decodeBuffers(const JSONobjectSP& jsonGlTf, const std::string& folderName);
 	bool decodeBufferViews(const JSONobjectSP& jsonGlTf);
 	bool decodeAccessors(const JSONobjectSP& jsonGlTf);
@@ -121,6 +135,28 @@ public:
 
 	ModelEntitySP loadGlTfModelFile(const std::string& identifier, const std::string& fileName, const std::string& folderName, float scale);
 
+	/**
+	 * Creates for each imported mesh the given number of levels of detail. One disables the simplification.
+	 */
+	void setLevelsOfDetail(std::uint32_t numberLods, float lodReduction);
+
+	/**
+	 * Merges static, not animated child nodes into their parent node to reduce the number of draws. Disabled by default.
+	 */
+	void setMergeStaticNodes(bool mergeStaticNodes);
+
+	/**
+	 * Merges vertices of an imported mesh, whose attributes all differ by at most the epsilon. Zero by default, which only
+	 * merges identical vertices. Negative disables the welding.
+	 */
+	void setWeldEpsilon(float weldEpsilon);
+
+	/**
+	 * Packs the vertices of each imported mesh into one interleaved and quantized buffer, which saves memory and bandwidth.
+	 * Done after merging the static nodes. Disabled by default.
+	 */
+	void setPackVertices(bool packVertices);
+
 };
 
 #endif /* GLTFENTITYDECODERFACTORY_H_ */
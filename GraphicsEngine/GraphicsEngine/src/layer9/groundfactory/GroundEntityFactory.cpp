@@ -48,3 +48,58 @@ GroundEntitySP GroundEntityFactory::createGroundEntity(const string& name, float
 
 	return GroundEntitySP(new GroundEntity(name, ground, surfaceMaterial, scaleX, scaleY, scaleZ));
 }
+
+GroundEntitySP GroundEntityFactory::createTerrainEntity(const string& name, float scaleX, float scaleY, float scaleZ, const SurfaceMaterialSP& surfaceMaterial, uint32_t gridSize) const
+{
+	GroundFactory groundFactory;
+
+	if (GroundManager::getInstance()->containsGroundByKey(name))
+	{
+		glusLogPrint(GLUS_LOG_ERROR, "Ground '%s' already exists!", name.c_str());
+
+		return GroundEntitySP();
+	}
+
+	// All terrains with the same grid size share the tile.
+	string tileKey = "TerrainTile_" + to_string(gridSize);
+
+	GroundSP ground;
+
+	if (GroundManager::getInstance()->containsGroundByKey(tileKey))
+	{
+		ground = GroundManager::getInstance()->getGroundByKey(tileKey);
+	}
+	else
+	{
+		ground = groundFactory.createTerrainTile(gridSize);
+
+		if (!ground.get())
+		{
+			return GroundEntitySP();
+		}
+
+		GroundManager::getInstance()->setGround(tileKey, ground);
+	}
+
+	GroundManager::getInstance()->setGround(name, ground);
+
+	// Enough levels, that the finest tiles have two cells per unit like a ground entity.
+	float maxScale = glusMathMaxf(scaleX, scaleY);
+
+	int32_t levels = 1;
+
+	while (static_cast<float>(gridSize) * static_cast<float>(1 << (levels - 1)) < 2.0f * maxScale && levels < 16)
+	{
+		levels++;
+	}
+
+	float finestTileSize = maxScale / static_cast<float>(1 << (levels - 1));
+
+	TerrainQuadtreeSP terrainQuadtree = TerrainQuadtreeSP(new TerrainQuadtree(levels, gridSize, finestTileSize * 4.0f));
+
+	GroundEntitySP groundEntity = GroundEntitySP(new GroundEntity(name, ground, surfaceMaterial, scaleX, scaleY, scaleZ));
+
+	groundEntity->setTerrainQuadtree(terrainQuadtree);
+
+	return groundEntity;
+}
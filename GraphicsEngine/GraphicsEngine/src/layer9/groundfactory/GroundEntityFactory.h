@@ -23,6 +23,14 @@ public:
 
 	GroundEntitySP createGroundEntity(const std::string& name, float scaleX, float scaleY, float scaleZ, const SurfaceMaterialSP& surfaceMaterial) const;
 
+	/**
+	 * Creates a ground, which is drawn as tiles with distance dependent level of detail. Close to the eye, the grid has
+	 * the same resolution as the one of a ground entity.
+	 *
+	 * @param gridSize Number of grid cells per side of a tile. Has to be even.
+	 */
+	GroundEntitySP createTerrainEntity(const std::string& name, float scaleX, float scaleY, float scaleZ, const SurfaceMaterialSP& surfaceMaterial, std::uint32_t gridSize = 32) const;
+
 };
 
 #endif /* GROUNDENTITYFACTORY_H_ */